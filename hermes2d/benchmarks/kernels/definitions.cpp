@@ -0,0 +1,601 @@
+#include "definitions.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+MeshSharedPtr create_benchmark_mesh(int size, ElementMode2D mode, unsigned int seed)
+{
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> shift(-0.2, 0.2);
+  double h = 2. / size;
+
+  int nv = (size + 1) * (size + 1);
+  double2* verts = new double2[nv];
+  for (int j = 0; j <= size; j++)
+  {
+    for (int i = 0; i <= size; i++)
+    {
+      double2& vertex = verts[j * (size + 1) + i];
+      vertex[0] = -1. + i * h;
+      vertex[1] = -1. + j * h;
+      if (i > 0 && i < size && j > 0 && j < size)
+      {
+        vertex[0] += shift(generator) * h;
+        vertex[1] += shift(generator) * h;
+      }
+    }
+  }
+
+  int nt = (mode == HERMES_MODE_TRIANGLE) ? 2 * size * size : 0;
+  int nq = (mode == HERMES_MODE_QUAD) ? size * size : 0;
+  int3* tris = new int3[std::max(nt, 1)];
+  int4* quads = new int4[std::max(nq, 1)];
+  std::string* tri_markers = new std::string[std::max(nt, 1)];
+  std::string* quad_markers = new std::string[std::max(nq, 1)];
+  for (int j = 0; j < size; j++)
+  {
+    for (int i = 0; i < size; i++)
+    {
+      int v0 = j * (size + 1) + i, v1 = v0 + 1, v2 = v1 + size + 1, v3 = v0 + size + 1;
+      int cell = j * size + i;
+      if (mode == HERMES_MODE_TRIANGLE)
+      {
+        tris[2 * cell][0] = v0; tris[2 * cell][1] = v1; tris[2 * cell][2] = v2;
+        tris[2 * cell + 1][0] = v0; tris[2 * cell + 1][1] = v2; tris[2 * cell + 1][2] = v3;
+        tri_markers[2 * cell] = tri_markers[2 * cell + 1] = "Domain";
+      }
+      else
+      {
+        quads[cell][0] = v0; quads[cell][1] = v1; quads[cell][2] = v2; quads[cell][3] = v3;
+        quad_markers[cell] = "Domain";
+      }
+    }
+  }
+
+  // Boundary edges - bottom, right, top, left.
+  int nm = 4 * size;
+  int2* mark = new int2[nm];
+  std::string* boundary_markers = new std::string[nm];
+  for (int i = 0; i < size; i++)
+  {
+    mark[i][0] = i; mark[i][1] = i + 1;
+    mark[size + i][0] = i * (size + 1) + size; mark[size + i][1] = (i + 1) * (size + 1) + size;
+    mark[2 * size + i][0] = size * (size + 1) + i; mark[2 * size + i][1] = size * (size + 1) + i + 1;
+    mark[3 * size + i][0] = i * (size + 1); mark[3 * size + i][1] = (i + 1) * (size + 1);
+  }
+  for (int i = 0; i < nm; i++)
+    boundary_markers[i] = "Boundary";
+
+  MeshSharedPtr mesh(new Mesh);
+  mesh->create(nv, verts, nt, tris, tri_markers, nq, quads, quad_markers, nm, mark, boundary_markers);
+
+  delete[] verts;
+  delete[] tris;
+  delete[] quads;
+  delete[] tri_markers;
+  delete[] quad_markers;
+  delete[] mark;
+  delete[] boundary_markers;
+
+  return mesh;
+}
+
+void refine_randomly(MeshSharedPtr mesh, int refinement_count, unsigned int seed)
+{
+  std::vector<int> ids;
+  Element* e;
+  for_all_active_elements(e, mesh)
+    ids.push_back(e->id);
+
+  std::mt19937 generator(seed);
+  std::shuffle(ids.begin(), ids.end(), generator);
+  for (int i = 0; i < refinement_count && i < (int)ids.size(); i++)
+    mesh->refine_element_id(ids[i]);
+}
+
+KernelBenchmark::KernelBenchmark(const char* name, bool parallel, bool uses_order) : name(name), parallel(parallel), uses_order(uses_order), operations(0.)
+{
+}
+
+KernelBenchmark::~KernelBenchmark()
+{
+}
+
+void KernelBenchmark::init(BenchmarkCase& benchmark_case)
+{
+}
+
+void KernelBenchmark::prepare(BenchmarkCase& benchmark_case)
+{
+}
+
+void KernelBenchmark::free()
+{
+}
+
+/// Static slicing of count items among the threads - the same as in the assembling.
+static void thread_range(int count, int threads, int thread_number, int& start, int& end)
+{
+  start = (count / threads) * thread_number;
+  end = (count / threads) * (thread_number + 1);
+  if (thread_number == threads - 1)
+    end = count;
+}
+
+/// Shape function values & derivatives straight from the shapeset (shape_table) at the quadrature points of all elements.
+class ShapesetEvaluation : public KernelBenchmark
+{
+public:
+  ShapesetEvaluation() : KernelBenchmark("shapeset_eval", true, true)
+  {
+  }
+
+  double run(BenchmarkCase& c)
+  {
+    Shapeset* shapeset = c.space->get_shapeset();
+    double3* points = g_quad_2d_std.get_points(c.quad_order, c.mode);
+    unsigned char np = g_quad_2d_std.get_num_points(c.quad_order, c.mode);
+
+    double checksum = 0., evaluations = 0.;
+#pragma omp parallel num_threads(c.threads)
+    {
+      int start, end;
+      thread_range(c.assembly_lists.size(), c.threads, omp_get_thread_num(), start, end);
+
+      double thread_checksum = 0., thread_evaluations = 0.;
+      for (int i = start; i < end; i++)
+      {
+        const AsmList<double>& al = c.assembly_lists[i];
+        for (unsigned short j = 0; j < al.cnt; j++)
+        {
+          for (unsigned char k = 0; k < np; k++)
+          {
+            thread_checksum += shapeset->get_fn_value(al.idx[j], points[k][0], points[k][1], 0, c.mode);
+            thread_checksum += shapeset->get_dx_value(al.idx[j], points[k][0], points[k][1], 0, c.mode);
+            thread_checksum += shapeset->get_dy_value(al.idx[j], points[k][0], points[k][1], 0, c.mode);
+          }
+        }
+        thread_evaluations += 3. * al.cnt * np;
+      }
+
+#pragma omp atomic
+      checksum += thread_checksum;
+#pragma omp atomic
+      evaluations += thread_evaluations;
+    }
+
+    this->operations = evaluations;
+    return checksum;
+  }
+};
+
+/// Filling of the PrecalcShapesetAssembling tables - all shape functions of the order, the tables are evicted before every run.
+class PrecalcTableFill : public KernelBenchmark
+{
+public:
+  PrecalcTableFill() : KernelBenchmark("precalc_fill", true, true)
+  {
+  }
+
+  void init(BenchmarkCase& c)
+  {
+    Shapeset* shapeset = c.space->get_shapeset();
+    this->indices.clear();
+    for (int index = 0; index <= shapeset->get_max_index(c.mode); index++)
+    {
+      int order = shapeset->get_order(index, c.mode);
+      if (c.mode == HERMES_MODE_QUAD)
+        order = std::max(H2D_GET_H_ORDER(order), H2D_GET_V_ORDER(order));
+      if (order <= c.order)
+        this->indices.push_back(index);
+    }
+
+    for (int i = 0; i < c.threads; i++)
+    {
+      this->pss.push_back(new PrecalcShapesetAssembling(shapeset));
+      this->pss.back()->set_active_element(c.elements.front());
+    }
+  }
+
+  void prepare(BenchmarkCase& c)
+  {
+    // Evict the tables through the memory limits.
+    size_t limit = HermesCommonApi.get_memory_limit(memoryPrecalcTables);
+    HermesCommonApi.set_memory_limit(memoryPrecalcTables, 1);
+    HermesCommonApi.enforce_memory_limits();
+    HermesCommonApi.set_memory_limit(memoryPrecalcTables, limit);
+  }
+
+  double run(BenchmarkCase& c)
+  {
+    double checksum = 0.;
+#pragma omp parallel num_threads(c.threads)
+    {
+      int thread_number = omp_get_thread_num();
+      int start, end;
+      thread_range(this->indices.size(), c.threads, thread_number, start, end);
+
+      double thread_checksum = 0.;
+      for (int i = start; i < end; i++)
+      {
+        this->pss[thread_number]->set_active_shape(this->indices[i]);
+        this->pss[thread_number]->set_quad_order(c.quad_order);
+        thread_checksum += this->pss[thread_number]->get_fn_values()[0] + this->pss[thread_number]->get_dx_values()[0];
+      }
+
+#pragma omp atomic
+      checksum += thread_checksum;
+    }
+
+    this->operations = (double)this->indices.size() * g_quad_2d_std.get_num_points(c.quad_order, c.mode);
+    return checksum;
+  }
+
+  void free()
+  {
+    for (unsigned int i = 0; i < this->pss.size(); i++)
+      delete this->pss[i];
+    this->pss.clear();
+  }
+
+private:
+  std::vector<int> indices;
+  std::vector<PrecalcShapesetAssembling*> pss;
+};
+
+/// Inverse reference map & jacobian at the quadrature points of all elements.
+class RefMapJacobian : public KernelBenchmark
+{
+public:
+  RefMapJacobian() : KernelBenchmark("refmap_jacobian", true, true)
+  {
+  }
+
+  double run(BenchmarkCase& c)
+  {
+    double checksum = 0.;
+#pragma omp parallel num_threads(c.threads)
+    {
+      int start, end;
+      thread_range(c.elements.size(), c.threads, omp_get_thread_num(), start, end);
+
+      RefMap refmap;
+      refmap.set_quad_2d(&g_quad_2d_std);
+      double thread_checksum = 0.;
+      for (int i = start; i < end; i++)
+      {
+        refmap.set_active_element(c.elements[i]);
+        if (refmap.is_jacobian_const())
+          thread_checksum += refmap.get_const_jacobian();
+        else
+        {
+          double2x2* inv_ref_map = refmap.get_inv_ref_map(c.quad_order);
+          double* jacobian = refmap.get_jacobian(c.quad_order);
+          thread_checksum += inv_ref_map[0][0][0] + jacobian[0];
+        }
+      }
+
+#pragma omp atomic
+      checksum += thread_checksum;
+    }
+
+    this->operations = (double)c.elements.size() * g_quad_2d_std.get_num_points(c.quad_order, c.mode);
+    return checksum;
+  }
+};
+
+/// Solution values & derivatives (monomial coefficients, Horner scheme) at the quadrature points of all elements.
+class SolutionEvaluation : public KernelBenchmark
+{
+public:
+  SolutionEvaluation() : KernelBenchmark("solution_get_fn", true, true)
+  {
+  }
+
+  void init(BenchmarkCase& c)
+  {
+    std::mt19937 generator(c.seed);
+    std::uniform_real_distribution<double> value(-1., 1.);
+    std::vector<double> coeff_vec(c.space->get_num_dofs());
+    for (unsigned int i = 0; i < coeff_vec.size(); i++)
+      coeff_vec[i] = value(generator);
+
+    for (int i = 0; i < c.threads; i++)
+    {
+      Solution<double>* sln = new Solution<double>(c.mesh);
+      Solution<double>::vector_to_solution(&coeff_vec[0], c.space, sln);
+      sln->set_quad_2d(&g_quad_2d_std);
+      this->slns.push_back(sln);
+    }
+  }
+
+  double run(BenchmarkCase& c)
+  {
+    double checksum = 0.;
+#pragma omp parallel num_threads(c.threads)
+    {
+      int thread_number = omp_get_thread_num();
+      int start, end;
+      thread_range(c.elements.size(), c.threads, thread_number, start, end);
+
+      Solution<double>* sln = this->slns[thread_number];
+      double thread_checksum = 0.;
+      for (int i = start; i < end; i++)
+      {
+        sln->set_active_element(c.elements[i]);
+        sln->set_quad_order(c.quad_order, H2D_FN_DEFAULT);
+        thread_checksum += sln->get_fn_values()[0] + sln->get_dx_values()[0] + sln->get_dy_values()[0];
+      }
+
+#pragma omp atomic
+      checksum += thread_checksum;
+    }
+
+    this->operations = (double)c.elements.size() * g_quad_2d_std.get_num_points(c.quad_order, c.mode);
+    return checksum;
+  }
+
+  void free()
+  {
+    for (unsigned int i = 0; i < this->slns.size(); i++)
+      delete this->slns[i];
+    this->slns.clear();
+  }
+
+private:
+  std::vector<Solution<double>*> slns;
+};
+
+/// Insertion of local (element) matrices into a CSCMatrix.
+/// The elements are dealt round-robin to the threads, so that neighboring elements (sharing DOFs) are added concurrently.
+class MatrixAdd : public KernelBenchmark
+{
+public:
+  MatrixAdd() : KernelBenchmark("csc_matrix_add", true, true), matrix(nullptr)
+  {
+  }
+
+  void init(BenchmarkCase& c)
+  {
+    this->matrix = new CSCMatrix<double>;
+    this->matrix->prealloc(c.space->get_num_dofs());
+    this->local_size = 0;
+    for (unsigned int i = 0; i < c.assembly_lists.size(); i++)
+    {
+      const AsmList<double>& al = c.assembly_lists[i];
+      for (unsigned short j = 0; j < al.cnt; j++)
+        for (unsigned short k = 0; k < al.cnt; k++)
+          this->matrix->pre_add_ij(al.dof[j], al.dof[k]);
+      this->local_size = std::max(this->local_size, (int)al.cnt);
+    }
+    this->matrix->alloc();
+
+    this->local_matrix.resize(this->local_size * this->local_size);
+    for (int j = 0; j < this->local_size; j++)
+      for (int k = 0; k < this->local_size; k++)
+        this->local_matrix[j * this->local_size + k] = 1. / (1. + j + k);
+  }
+
+  void prepare(BenchmarkCase& c)
+  {
+    this->matrix->zero();
+  }
+
+  double run(BenchmarkCase& c)
+  {
+    // Through the interface, as in the assembling.
+    SparseMatrix<double>* sparse_matrix = this->matrix;
+    double entries = 0.;
+#pragma omp parallel num_threads(c.threads)
+    {
+      double thread_entries = 0.;
+      for (int i = omp_get_thread_num(); i < (int)c.assembly_lists.size(); i += c.threads)
+      {
+        AsmList<double>& al = c.assembly_lists[i];
+        sparse_matrix->add(al.cnt, al.cnt, &this->local_matrix[0], al.dof, al.dof, this->local_size);
+        thread_entries += al.cnt * al.cnt;
+      }
+
+#pragma omp atomic
+      entries += thread_entries;
+    }
+
+    this->operations = entries;
+    return this->matrix->get_Ax()[0];
+  }
+
+  void free()
+  {
+    delete this->matrix;
+    this->matrix = nullptr;
+  }
+
+private:
+  CSCMatrix<double>* matrix;
+  int local_size;
+  std::vector<double> local_matrix;
+};
+
+/// Multi-mesh traversal (union mesh) of two differently refined meshes.
+class TraverseStates : public KernelBenchmark
+{
+public:
+  TraverseStates() : KernelBenchmark("traverse_get_states", false, false), states(nullptr), num_states(0)
+  {
+  }
+
+  void prepare(BenchmarkCase& c)
+  {
+    this->free();
+  }
+
+  double run(BenchmarkCase& c)
+  {
+    std::vector<MeshSharedPtr> meshes;
+    meshes.push_back(c.union_meshes[0]);
+    meshes.push_back(c.union_meshes[1]);
+
+    Traverse trav(2);
+    this->states = trav.get_states(meshes, this->num_states);
+
+    this->operations = this->num_states;
+    return this->num_states;
+  }
+
+  void free()
+  {
+    if (!this->states)
+      return;
+    for (unsigned int i = 0; i < this->num_states; i++)
+      delete this->states[i];
+    free_with_check(this->states);
+    this->num_states = 0;
+  }
+
+private:
+  Traverse::State** states;
+  unsigned int num_states;
+};
+
+/// Node lookups in the hash tables of a refined mesh - every node by its parents, and the midpoint vertex of every edge (hit or miss).
+class HashTableLookup : public KernelBenchmark
+{
+public:
+  HashTableLookup() : KernelBenchmark("hash_table_lookup", true, false)
+  {
+  }
+
+  void init(BenchmarkCase& c)
+  {
+    this->mesh = c.union_meshes[0];
+    this->keys.clear();
+    Node* n;
+    for_all_nodes(n, this->mesh)
+    {
+      if (n->p1 < 0 || n->p2 < 0)
+        continue;
+      Key key = { n->p1, n->p2, n->type == HERMES_TYPE_VERTEX };
+      this->keys.push_back(key);
+    }
+  }
+
+  double run(BenchmarkCase& c)
+  {
+    double checksum = 0., lookups = 0.;
+#pragma omp parallel num_threads(c.threads)
+    {
+      int start, end;
+      thread_range(this->keys.size(), c.threads, omp_get_thread_num(), start, end);
+
+      double thread_checksum = 0., thread_lookups = 0.;
+      for (int i = start; i < end; i++)
+      {
+        const Key& key = this->keys[i];
+        Node* node = key.vertex ? this->mesh->peek_vertex_node(key.p1, key.p2) : this->mesh->peek_edge_node(key.p1, key.p2);
+        thread_checksum += node->id;
+        thread_lookups++;
+
+        if (!key.vertex)
+        {
+          Node* midpoint = this->mesh->peek_vertex_node(key.p1, key.p2);
+          if (midpoint)
+            thread_checksum += midpoint->id;
+          thread_lookups++;
+        }
+      }
+
+#pragma omp atomic
+      checksum += thread_checksum;
+#pragma omp atomic
+      lookups += thread_lookups;
+    }
+
+    this->operations = lookups;
+    return checksum;
+  }
+
+  void free()
+  {
+    this->mesh.reset();
+  }
+
+private:
+  struct Key
+  {
+    int p1, p2;
+    bool vertex;
+  };
+
+  MeshSharedPtr mesh;
+  std::vector<Key> keys;
+};
+
+std::vector<KernelBenchmark*> create_kernel_benchmarks()
+{
+  std::vector<KernelBenchmark*> benchmarks;
+  benchmarks.push_back(new ShapesetEvaluation);
+  benchmarks.push_back(new PrecalcTableFill);
+  benchmarks.push_back(new RefMapJacobian);
+  benchmarks.push_back(new SolutionEvaluation);
+  benchmarks.push_back(new MatrixAdd);
+  benchmarks.push_back(new TraverseStates);
+  benchmarks.push_back(new HashTableLookup);
+  return benchmarks;
+}
+
+BenchmarkResult run_kernel_benchmark(KernelBenchmark* benchmark, BenchmarkCase& benchmark_case, int size, int repetitions)
+{
+  typedef std::chrono::steady_clock Clock;
+
+  BenchmarkResult result;
+  result.kernel = benchmark->name;
+  result.mode = (benchmark_case.mode == HERMES_MODE_TRIANGLE) ? "triangle" : "quad";
+  result.order = benchmark->uses_order ? benchmark_case.order : 0;
+  result.quad_order = benchmark->uses_order ? benchmark_case.quad_order : 0;
+  result.threads = benchmark_case.threads;
+  result.size = size;
+  result.repetitions = repetitions;
+
+  benchmark->init(benchmark_case);
+
+  // Warm-up.
+  benchmark->prepare(benchmark_case);
+  result.checksum = benchmark->run(benchmark_case);
+
+  std::vector<double> times;
+  for (int i = 0; i < repetitions; i++)
+  {
+    benchmark->prepare(benchmark_case);
+    Clock::time_point start = Clock::now();
+    benchmark->run(benchmark_case);
+    times.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+  }
+
+  benchmark->free();
+
+  std::sort(times.begin(), times.end());
+  result.time_min = times.front();
+  result.time_median = (times.size() % 2) ? times[times.size() / 2] : 0.5 * (times[times.size() / 2 - 1] + times[times.size() / 2]);
+  result.operations = benchmark->operations;
+
+  return result;
+}
+
+void write_benchmark_results(std::ostream& out, const std::vector<BenchmarkResult>& results, int size, unsigned int seed)
+{
+  char line[1024];
+  out << "{\n  \"benchmark\": \"hermes2d-kernels\",\n";
+  out << "  \"size\": " << size << ",\n  \"seed\": " << seed << ",\n  \"max_threads\": " << omp_get_max_threads() << ",\n";
+  out << "  \"results\": [\n";
+  for (unsigned int i = 0; i < results.size(); i++)
+  {
+    const BenchmarkResult& r = results[i];
+    sprintf(line, "    {\"kernel\": \"%s\", \"mode\": \"%s\", \"order\": %d, \"quad_order\": %d, \"threads\": %d, \"size\": %d, \"repetitions\": %d, "
+      "\"time_min\": %.9g, \"time_median\": %.9g, \"operations\": %.0f, \"ns_per_operation\": %.6g, \"checksum\": %.15g}%s\n",
+      r.kernel.c_str(), r.mode.c_str(), r.order, r.quad_order, r.threads, r.size, r.repetitions,
+      r.time_min, r.time_median, r.operations, r.operations > 0. ? 1e9 * r.time_min / r.operations : 0., r.checksum,
+      (i + 1 < results.size()) ? "," : "");
+    out << line;
+  }
+  out << "  ]\n}\n";
+}
@@ -0,0 +1,84 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+using namespace Hermes::Algebra;
+
+/// Synthetic mesh of the square (-1, 1)^2 with size x size quads (or 2 x size x size triangles).
+/// The interior vertices are moved randomly by up to 20% of the element size (generator seeded by seed),
+/// so that the quads are not parallelograms and the reference mappings are not constant.
+MeshSharedPtr create_benchmark_mesh(int size, ElementMode2D mode, unsigned int seed);
+
+/// Refines refinement_count randomly chosen active elements of mesh (generator seeded by seed).
+void refine_randomly(MeshSharedPtr mesh, int refinement_count, unsigned int seed);
+
+/// Everything a kernel benchmark runs on - one (mode, order, threads) combination.
+struct BenchmarkCase
+{
+  ElementMode2D mode;
+  /// Polynomial order of the space.
+  int order;
+  /// Quadrature order (limited by limit_order()).
+  int quad_order;
+  int threads;
+  unsigned int seed;
+
+  MeshSharedPtr mesh;
+  SpaceSharedPtr<double> space;
+  /// Active elements of mesh.
+  std::vector<Element*> elements;
+  /// Assembly lists of elements.
+  std::vector<AsmList<double> > assembly_lists;
+  /// Two differently refined copies of mesh - for the multi-mesh traversal.
+  MeshSharedPtr union_meshes[2];
+};
+
+/// One benchmarked kernel.
+/// For every case, init() is called once, then (for every repetition) prepare() - not timed - and run() - timed.
+class KernelBenchmark
+{
+public:
+  KernelBenchmark(const char* name, bool parallel, bool uses_order);
+  virtual ~KernelBenchmark();
+
+  /// Kernel name (in the output & on the command line).
+  const char* name;
+  /// If the kernel uses the threads of the case (otherwise it is run with one thread only).
+  bool parallel;
+  /// If the kernel depends on the order of the case (otherwise it is run for the first order only).
+  bool uses_order;
+
+  virtual void init(BenchmarkCase& benchmark_case);
+  virtual void prepare(BenchmarkCase& benchmark_case);
+  /// \return A checksum of the calculated values (compared across runs, and it keeps the compiler from skipping the work).
+  virtual double run(BenchmarkCase& benchmark_case) = 0;
+  virtual void free();
+
+  /// Number of basic operations (evaluations, lookups, ...) of one run().
+  double operations;
+};
+
+/// Creates all kernel benchmarks.
+std::vector<KernelBenchmark*> create_kernel_benchmarks();
+
+/// Result of one (kernel, case).
+struct BenchmarkResult
+{
+  std::string kernel;
+  std::string mode;
+  int order;
+  int quad_order;
+  int threads;
+  int size;
+  int repetitions;
+  double time_min;
+  double time_median;
+  double operations;
+  double checksum;
+};
+
+/// Runs a kernel benchmark on a case - one warm-up run and repetitions timed runs.
+BenchmarkResult run_kernel_benchmark(KernelBenchmark* benchmark, BenchmarkCase& benchmark_case, int size, int repetitions);
+
+/// Writes the results as JSON.
+void write_benchmark_results(std::ostream& out, const std::vector<BenchmarkResult>& results, int size, unsigned int seed);
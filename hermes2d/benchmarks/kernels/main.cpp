@@ -0,0 +1,176 @@
+#include "definitions.h"
+#include <fstream>
+
+// Microbenchmarks of the kernels dominating the assembling profiles:
+// - shapeset_eval         shape function values & derivatives from the shapeset at the quadrature points of all elements,
+// - precalc_fill          filling of the PrecalcShapesetAssembling tables of one order,
+// - refmap_jacobian       RefMap inverse reference map & jacobian of all elements,
+// - solution_get_fn       Solution values & derivatives (Horner scheme) of all elements,
+// - csc_matrix_add        insertion of local matrices of all elements into a CSCMatrix, neighboring elements concurrently,
+// - traverse_get_states   Traverse::get_states() on the union of two differently refined meshes,
+// - hash_table_lookup     node lookups in the mesh hash tables.
+//
+// The meshes (and the coefficient vectors) are synthetic, generated from the seed, so the runs are reproducible.
+// Every kernel is run once for warm-up and then timed repetition-times, the minimum and the median are reported.
+// The results are written as JSON (to the standard output, or to the file given by --output).
+//
+// Usage:
+// benchmark-kernels [--kernels shapeset_eval,precalc_fill,...] [--modes quad,triangle] [--orders 1,2,4,8]
+//                   [--threads 1,2,4] [--size 32] [--repetitions 5] [--seed 1] [--output results.json]
+
+static std::vector<std::string> split_list(const std::string& list)
+{
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ','))
+  {
+    if (!item.empty())
+      items.push_back(item);
+  }
+  return items;
+}
+
+static std::vector<int> split_int_list(const std::string& list)
+{
+  std::vector<int> items;
+  std::vector<std::string> strings = split_list(list);
+  for (unsigned int i = 0; i < strings.size(); i++)
+    items.push_back(atoi(strings[i].c_str()));
+  return items;
+}
+
+int main(int argc, char* argv[])
+{
+  std::vector<std::string> kernels;
+  std::vector<std::string> modes = split_list("quad,triangle");
+  std::vector<int> orders = split_int_list("1,2,4,8");
+  std::vector<int> threads = split_int_list("1,2,4");
+  int size = 32;
+  int repetitions = 5;
+  unsigned int seed = 1;
+  std::string output;
+
+  for (int i = 1; i < argc; i++)
+  {
+    std::string arg = argv[i];
+    if (i + 1 == argc)
+    {
+      std::cerr << "Missing value of " << arg << std::endl;
+      return -1;
+    }
+    std::string value = argv[++i];
+    if (arg == "--kernels")
+      kernels = split_list(value);
+    else if (arg == "--modes")
+      modes = split_list(value);
+    else if (arg == "--orders")
+      orders = split_int_list(value);
+    else if (arg == "--threads")
+      threads = split_int_list(value);
+    else if (arg == "--size")
+      size = atoi(value.c_str());
+    else if (arg == "--repetitions")
+      repetitions = atoi(value.c_str());
+    else if (arg == "--seed")
+      seed = atoi(value.c_str());
+    else if (arg == "--output")
+      output = value;
+    else
+    {
+      std::cerr << "Unknown option " << arg << std::endl;
+      return -1;
+    }
+  }
+
+  if (size < 1 || repetitions < 1 || orders.empty() || threads.empty())
+  {
+    std::cerr << "Invalid parameters." << std::endl;
+    return -1;
+  }
+
+  std::vector<KernelBenchmark*> benchmarks = create_kernel_benchmarks();
+  std::vector<BenchmarkResult> results;
+
+  try
+  {
+    for (unsigned int mode_i = 0; mode_i < modes.size(); mode_i++)
+    {
+      BenchmarkCase benchmark_case;
+      benchmark_case.mode = (modes[mode_i] == "triangle") ? HERMES_MODE_TRIANGLE : HERMES_MODE_QUAD;
+      benchmark_case.seed = seed;
+      benchmark_case.mesh = create_benchmark_mesh(size, benchmark_case.mode, seed);
+      for (int i = 0; i < 2; i++)
+      {
+        benchmark_case.union_meshes[i] = MeshSharedPtr(new Mesh);
+        benchmark_case.union_meshes[i]->copy(benchmark_case.mesh);
+        refine_randomly(benchmark_case.union_meshes[i], size * size / 4, seed + i + 1);
+        refine_randomly(benchmark_case.union_meshes[i], size * size / 4, seed + i + 3);
+      }
+
+      Element* e;
+      benchmark_case.elements.clear();
+      for_all_active_elements(e, benchmark_case.mesh)
+        benchmark_case.elements.push_back(e);
+
+      for (unsigned int order_i = 0; order_i < orders.size(); order_i++)
+      {
+        benchmark_case.order = orders[order_i];
+        benchmark_case.quad_order = 2 * orders[order_i];
+        limit_order_nowarn(benchmark_case.quad_order, benchmark_case.mode);
+
+        benchmark_case.space = SpaceSharedPtr<double>(new H1Space<double>(benchmark_case.mesh, benchmark_case.order));
+        benchmark_case.assembly_lists.resize(benchmark_case.elements.size());
+        for (unsigned int i = 0; i < benchmark_case.elements.size(); i++)
+          benchmark_case.space->get_element_assembly_list(benchmark_case.elements[i], &benchmark_case.assembly_lists[i]);
+
+        for (unsigned int benchmark_i = 0; benchmark_i < benchmarks.size(); benchmark_i++)
+        {
+          KernelBenchmark* benchmark = benchmarks[benchmark_i];
+          if (!kernels.empty() && std::find(kernels.begin(), kernels.end(), std::string(benchmark->name)) == kernels.end())
+            continue;
+          if (!benchmark->uses_order && order_i > 0)
+            continue;
+
+          for (unsigned int threads_i = 0; threads_i < threads.size(); threads_i++)
+          {
+            benchmark_case.threads = benchmark->parallel ? threads[threads_i] : 1;
+            if (!benchmark->parallel && threads_i > 0)
+              break;
+
+            results.push_back(run_kernel_benchmark(benchmark, benchmark_case, size, repetitions));
+            if (!output.empty())
+            {
+              const BenchmarkResult& r = results.back();
+              std::cout << r.kernel << " " << r.mode << " order " << r.order << " threads " << r.threads
+                << ": " << r.time_min << " s (median " << r.time_median << " s)" << std::endl;
+            }
+          }
+        }
+      }
+    }
+  }
+  catch (std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return -1;
+  }
+
+  for (unsigned int i = 0; i < benchmarks.size(); i++)
+    delete benchmarks[i];
+
+  if (output.empty())
+    write_benchmark_results(std::cout, results, size, seed);
+  else
+  {
+    std::ofstream out(output.c_str());
+    if (!out.good())
+    {
+      std::cerr << "Cannot write " << output << std::endl;
+      return -1;
+    }
+    write_benchmark_results(out, results, size, seed);
+  }
+
+  return 0;
+}
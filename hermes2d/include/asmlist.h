@@ -33,6 +33,8 @@ namespace Hermes
     class HERMES_API AsmList
     {
     public:
+      HERMES_POOL_ALLOCATED
+
       /// Constructor.
       AsmList();
 
@@ -0,0 +1,62 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __H2D_ASSEMBLY_KERNELS_H
+#define __H2D_ASSEMBLY_KERNELS_H
+
+#include "../forms.h"
+#include "../quadrature/quad.h"
+
+/// The largest number of quadrature points with specialized kernels.
+/// Covers the mass and diffusion forms up to p = 6 on triangles (order 12: 33 points) and quads (order 13: 7 x 7 points),
+/// with a reserve for the quads of p = 7.
+#define H2D_ASSEMBLY_KERNEL_MAX_POINTS 64
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    /// Assembly kernels class
+    /// \brief Registry of the specialized matrix form kernels.
+    ///
+    /// A kernel is a form integral (AssemblyKernelType) instantiated for a fixed number of quadrature points,
+    /// so that the compiler can unroll and vectorize the loop over the points.
+    /// The number of points is given by the element mode and the volumetric order (and the quadrature), so the kernels
+    /// are selected once per state (DiscreteProblemThreadAssembler::init_assembling_one_state()) and used
+    /// for the forms announcing the integral by MatrixFormVol::get_assembly_kernel().
+    /// The kernels work with the values of the (scalar) shape functions, i.e. the same for H1 and L2 spaces.
+    /// Anything else (other forms, more points) takes the generic path - MatrixFormVol::value().
+    class HERMES_API AssemblyKernels
+    {
+    public:
+      /// The kernel - the integral of (basis function, test function) without the coefficient.
+      typedef double(*MatrixKernel)(const double* jacobian_x_weights, const Func<double>* u, const Func<double>* v);
+
+      /// The kernel of the type for the number of quadrature points, nullptr if there is none.
+      static MatrixKernel get_matrix_kernel(AssemblyKernelType type, int num_points);
+
+      /// The kernel of the type for the element mode and the volumetric order, nullptr if there is none.
+      static MatrixKernel get_matrix_kernel(AssemblyKernelType type, ElementMode2D mode, int order, Quad2D* quad);
+
+    private:
+      AssemblyKernels();
+      static const AssemblyKernels& get_instance();
+
+      /// kernels[type][num_points], nullptr for 0 points.
+      MatrixKernel kernels[HERMES_KERNEL_COUNT][H2D_ASSEMBLY_KERNEL_MAX_POINTS + 1];
+    };
+  }
+}
+#endif
@@ -0,0 +1,76 @@
+/// This file is part of Hermes2D.
+///
+/// Hermes2D is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 2 of the License, or
+/// (at your option) any later version.
+///
+/// Hermes2D is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY;without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with Hermes2D. If not, see <http:///www.gnu.org/licenses/>.
+
+#ifndef __H2D_ASSEMBLY_STATISTICS_H
+#define __H2D_ASSEMBLY_STATISTICS_H
+
+#include "hermes_common.h"
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    /// \brief Counters of assembling, of one thread or the totals of all threads.
+    /// Volumetric, surface and DG (inner edge) forms of all weak formulation variants are counted.
+    struct HERMES_API AssemblyCounters
+    {
+      AssemblyCounters();
+
+      /// Adds the counters of other (the time is added as well).
+      void add(const AssemblyCounters& other);
+
+      /// Traversed states.
+      unsigned int states;
+      /// Histogram of the volumetric integration orders: states_per_order[order] states were integrated with the order.
+      std::vector<unsigned int> states_per_order;
+      /// Form evaluations - (basis function, test function) pairs of the matrix forms and test functions of the vector forms.
+      unsigned long long form_evaluations;
+      /// Form evaluations done by the specialized kernels (AssemblyKernels), included in form_evaluations.
+      unsigned long long kernel_evaluations;
+      /// Quadrature points of all form evaluations.
+      unsigned long long quadrature_points;
+      /// Entries added to the matrix (local matrix entries with both DOFs not Dirichlet).
+      unsigned long long inserted_nonzeros;
+      /// Shape function value lookups (PrecalcShapesetAssembling) found in the common tables / calculated.
+      unsigned long long precalc_hits, precalc_misses;
+      /// Wall time [s].
+      double time;
+    };
+
+    /// \brief Statistics of the last DiscreteProblem::assemble() call, see DiscreteProblem::get_assembly_statistics().
+    /// The totals (inherited members) are the sums over the threads, except for the time, which is the wall time of the whole assemble().
+    /// The time of a thread is the time of its slice of the states - the states are split into equal contiguous slices,
+    /// so that the differences between the threads show the load imbalance of the slicing.
+    class HERMES_API AssemblyStatistics : public AssemblyCounters
+    {
+    public:
+      AssemblyStatistics();
+
+      /// Per-thread counters.
+      std::vector<AssemblyCounters> threads;
+      /// Structural nonzeros of the matrix (0 if no matrix was assembled).
+      unsigned long long structural_nonzeros;
+
+      /// The longest thread time over the average thread time (1 is a perfect balance, 0 if not available).
+      double get_load_imbalance() const;
+      /// Ratio of the found shape function value lookups (0 if there were none).
+      double get_precalc_hit_rate() const;
+
+      /// Prints the totals and the per-thread counters.
+      void dump(FILE* out = stdout) const;
+    };
+  }
+}
+#endif
@@ -26,6 +26,7 @@
 #include "mixins2d.h"
 #include "multimesh_dg_neighbor_tree.h"
 #include "discrete_problem/discrete_problem_selective_assembler.h"
+#include "discrete_problem/assembly_statistics.h"
 
 namespace Hermes
 {
@@ -40,7 +41,8 @@ namespace Hermes
     {
     public:
       /// Constructor copying data from DiscreteProblemThreadAssembler.
-      DiscreteProblemDGAssembler(DiscreteProblemThreadAssembler<Scalar>* threadAssembler, const std::vector<SpaceSharedPtr<Scalar> > spaces, std::vector<MeshSharedPtr>& meshes);
+      /// \param[in] visited_lock Lock shared by all DG assemblers of one DiscreteProblem (guards Element::visited).
+      DiscreteProblemDGAssembler(DiscreteProblemThreadAssembler<Scalar>* threadAssembler, const std::vector<SpaceSharedPtr<Scalar> > spaces, std::vector<MeshSharedPtr>& meshes, omp_lock_t* visited_lock);
 
       /// Destructor.
       ~DiscreteProblemDGAssembler();
@@ -86,6 +88,8 @@ namespace Hermes
 
       PrecalcShapesetAssembling** pss;
       RefMap** refmaps;
+      /// The quadrature of the DiscreteProblemThreadAssembler.
+      Quad2D* quad_2d;
       Solution<Scalar>** u_ext;
       AsmList<Scalar>* als;
       std::vector<Transformable *> fns;
@@ -104,6 +108,15 @@ namespace Hermes
       const std::vector<SpaceSharedPtr<Scalar> > spaces;
       const std::vector<MeshSharedPtr>& meshes;
 
+      /// Owned by the DiscreteProblem.
+      omp_lock_t* visited_lock;
+
+      /// Per-state temporaries - the arena of the DiscreteProblemThreadAssembler, reset after each state.
+      MemoryArena* arena;
+
+      /// Counters of the DiscreteProblemThreadAssembler.
+      AssemblyCounters* statistics;
+
       template<typename T> friend class DiscreteProblem;
       template<typename T> friend class DiscreteProblemIntegrationOrderCalculator;
 
@@ -0,0 +1,242 @@
+/// This file is part of Hermes2D.
+///
+/// Hermes2D is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 2 of the License, or
+/// (at your option) any later version.
+///
+/// Hermes2D is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY;without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with Hermes2D. If not, see <http:///www.gnu.org/licenses/>.
+
+#ifndef __H2D_DISCRETE_PROBLEM_DG_MATRIX_FREE_H
+#define __H2D_DISCRETE_PROBLEM_DG_MATRIX_FREE_H
+
+#include "hermes_common.h"
+#include "forms.h"
+#include "weakform/weakform.h"
+#include "function/function.h"
+#include "neighbor_search.h"
+#include "exceptions.h"
+#include "mixins2d.h"
+#include "space/space.h"
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    /// Matrix-free evaluation of DG weak forms on L2 spaces.
+    ///
+    /// Intended for explicit time stepping and Krylov methods, where only the action of the discrete operator is needed.
+    /// Geometry, shape function values and assembly lists of all element interiors, boundary edges and both sides
+    /// of all inner edges are precomputed once per mesh / space state, the evaluation itself then only loops over
+    /// these tables and calls the forms - no SparseMatrix, AsmList, Func or DiscontinuousFunc is created.
+    ///
+    /// Element interiors and boundary edges are evaluated in parallel over elements (L2 DOFs are element-local).
+    /// DG matrix forms write into the DOFs of both elements of an edge, therefore each inner edge is owned by exactly one
+    /// of its two sides and the owned edges are colored so that no two edges of one color share an element. The colors
+    /// are then processed one after another, each of them in parallel.
+    ///
+    /// Limitations: all spaces have to be L2 spaces on the same mesh, external functions have to be defined on that mesh
+    /// and must be set for the whole WeakForm (not per form), UExtFunctions and Runge-Kutta are not supported.
+    template<typename Scalar>
+    class HERMES_API DiscreteProblemDGMatrixFree :
+      public Hermes::Mixins::Loggable,
+      public Hermes::Mixins::TimeMeasurable,
+      public Hermes::Hermes2D::Mixins::Parallel
+    {
+    public:
+      /// Constructor for multiple components / equations.
+      DiscreteProblemDGMatrixFree(WeakFormSharedPtr<Scalar> wf, std::vector<SpaceSharedPtr<Scalar> > spaces);
+      /// Constructor for one equation.
+      DiscreteProblemDGMatrixFree(WeakFormSharedPtr<Scalar> wf, SpaceSharedPtr<Scalar> space);
+      /// Destructor.
+      virtual ~DiscreteProblemDGMatrixFree();
+
+      /// Residual - all vector forms (volumetric, surface, DG) evaluated with the previous iteration given by coeff_vec.
+      /// This is the same vector DiscreteProblem::assemble(coeff_vec, rhs) produces.
+      /// \param[in] coeff_vec Coefficient vector of the previous iteration, nullptr stands for zero.
+      /// \param[out] residual Array of length get_num_dofs(), overwritten.
+      void assemble_residual(Scalar* coeff_vec, Scalar* residual);
+
+      /// Action of the matrix (Jacobian) forms: result = J(coeff_vec) * direction.
+      /// For a linear problem, this is the product of the stiffness matrix with direction.
+      /// \param[in] coeff_vec Coefficient vector of the previous iteration, nullptr stands for zero.
+      /// \param[in] direction The vector the operator is applied to.
+      /// \param[out] result Array of length get_num_dofs(), overwritten.
+      void apply_jacobian(Scalar* coeff_vec, Scalar* direction, Scalar* result);
+
+      /// Rebuilds the precomputed tables if any of the spaces (or their meshes) changed since the last call.
+      /// Called automatically by assemble_residual() and apply_jacobian().
+      void update();
+
+      /// The integration order is 2 * (polynomial degree) + increase (+ the reference mapping order),
+      /// unless the weak form has a global integration order set. Default: 1.
+      void set_integration_order_increase(unsigned short increase);
+
+      /// The quadrature, see DiscreteProblem::set_quadrature(). Default: g_quad_2d_std.
+      void set_quadrature(Quad2D* quadrature);
+      /// The collocated mode, see DiscreteProblem::set_collocated_quadrature(). Default: false.
+      void set_collocated_quadrature(bool to_set);
+
+      /// Number of DOFs (length of the vectors) of the operator.
+      int get_num_dofs() const;
+
+      /// Number of colors of the inner edge groups.
+      unsigned int get_num_edge_colors() const;
+
+      /// set time information for time-dependent problems.
+      void set_time(double time);
+      void set_time_step(double time_step);
+
+    protected:
+      /// Integration data of one domain - an element interior, a boundary edge, or one side of an inner edge.
+      /// Everything is stored in flat arrays, shape functions in the order [space][basis function][point].
+      struct IntegrationDomain
+      {
+        /// The element (the central one for inner edges).
+        unsigned int element_index;
+        /// The other element of an inner edge.
+        unsigned int neighbor_index;
+        /// Local edge number (not used for element interiors).
+        unsigned char isurf;
+        /// Number of integration points.
+        unsigned char np;
+        /// Quadrature (edge) order on the central and on the neighbor element.
+        int order, neighbor_order;
+        /// Markers.
+        int elem_marker, edge_marker;
+        /// Orientation of the edge w.r.t. the neighbor (the neighbor values are already stored reversed).
+        bool orientation;
+        /// Orientation of the edge w.r.t. the global normal.
+        bool edge_orientation;
+        /// True iff DG matrix forms on this edge are evaluated from this side.
+        bool owned;
+        /// Coordinates, normals, tangents and jacobian x weights.
+        std::vector<double> x, y, nx, ny, tx, ty, jacobian_x_weights;
+        /// Shape function values, derivatives - central element, offsets per space.
+        std::vector<double> val, dx, dy;
+        unsigned int offset[H2D_MAX_COMPONENTS];
+        /// Shape function values, derivatives - neighbor element, offsets per space.
+        std::vector<double> val_neighbor, dx_neighbor, dy_neighbor;
+        unsigned int offset_neighbor[H2D_MAX_COMPONENTS];
+        /// Sub-element transformations (for external functions on inner edges).
+        typename NeighborSearch<Scalar>::Transformations central_transformations, neighbor_transformations;
+      };
+
+      /// Assembly data of one element.
+      struct ElementData
+      {
+        Element* e;
+        /// Assembly lists - offsets to dofs / coefs, per space.
+        unsigned short cnt[H2D_MAX_COMPONENTS];
+        unsigned int al_offset[H2D_MAX_COMPONENTS];
+        /// Index of the interior domain.
+        unsigned int volume;
+        /// Indices of boundary edges and of inner edge sides (central side = this element).
+        std::vector<unsigned int> boundary_edges, inner_edges;
+      };
+
+      /// Preallocated per-thread evaluation data.
+      struct ThreadData
+      {
+        WeakFormSharedPtr<Scalar> wf;
+        GeomVol<double> geometry;
+        GeomSurf<double> geometry_surface;
+        Element* elements[H2D_MAX_COMPONENTS];
+
+        /// Test / basis functions and (parts of) the argument of the operator.
+        Func<double>* fn;
+        Func<double>* fn_neighbor;
+        Func<double>* argument;
+        Func<double>* argument_neighbor;
+        DiscontinuousFunc<double>* dg_fn;
+        DiscontinuousFunc<double>* dg_fn_neighbor;
+        DiscontinuousFunc<double>* dg_argument;
+        DiscontinuousFunc<double>* dg_argument_neighbor;
+
+        /// Previous iteration & external functions.
+        Func<Scalar>* u_ext[H2D_MAX_COMPONENTS];
+        Func<Scalar>* u_ext_neighbor[H2D_MAX_COMPONENTS];
+        DiscontinuousFunc<Scalar>* dg_u_ext[H2D_MAX_COMPONENTS];
+        std::vector<Func<Scalar>*> ext, ext_neighbor;
+        std::vector<DiscontinuousFunc<Scalar>*> dg_ext;
+      };
+
+      /// (Re)builds all tables.
+      void init_tables();
+      void free_tables();
+      void init_threads();
+      void free_threads();
+
+      /// Fills one integration domain - interior, if isurf == -1, boundary edge otherwise.
+      void init_domain(IntegrationDomain& domain, unsigned int element_index, int isurf, PrecalcShapeset** pss, RefMap* refmap, Func<double>* fn);
+      /// Fills one side of an inner edge, the active segment of ns.
+      void init_inner_edge(IntegrationDomain& domain, unsigned int element_index, unsigned char isurf, NeighborSearch<Scalar>& ns, unsigned int segment, PrecalcShapeset** pss, RefMap* refmap, Func<double>* fn);
+      /// Groups the owned inner edges into colors.
+      void color_inner_edges();
+
+      /// Volume and surface integration order of an element.
+      int calc_order(Element* e, RefMap* refmap);
+      /// Markers.
+      bool form_to_be_assembled(Form<Scalar>* form, int marker, bool surface);
+
+      /// Loads geometry & previous iteration & external functions of a domain into the thread data.
+      void load_domain(ThreadData* td, IntegrationDomain& domain, Scalar* coeff_vec, bool surface);
+      void load_inner_edge(ThreadData* td, IntegrationDomain& domain, Scalar* coeff_vec);
+
+      /// Matrix form (volumetric / surface) applied to direction.
+      template<typename MatrixFormType, typename GeomType>
+      void evaluate_matrix_form(ThreadData* td, MatrixFormType* form, IntegrationDomain& domain, ElementData& data, GeomType* geometry, double factor, Scalar* direction, Scalar* target);
+      /// Vector form (volumetric / surface).
+      template<typename VectorFormType, typename GeomType>
+      void evaluate_vector_form(ThreadData* td, VectorFormType* form, IntegrationDomain& domain, ElementData& data, GeomType* geometry, double factor, Scalar* target);
+
+      /// Element-wise part - interior and boundary edges (and DG vector forms, those only touch the element).
+      void evaluate_element(ThreadData* td, unsigned int element_i, Scalar* coeff_vec, Scalar* direction, Scalar* target);
+      /// Edge-wise part - DG matrix forms.
+      void evaluate_inner_edge(ThreadData* td, unsigned int domain_i, Scalar* coeff_vec, Scalar* direction, Scalar* target);
+
+      /// Runs evaluate_element over all elements and evaluate_inner_edge over all owned inner edges.
+      void evaluate(Scalar* coeff_vec, Scalar* direction, Scalar* target);
+
+      /// State querying helpers.
+      inline std::string getClassName() const { return "DiscreteProblemDGMatrixFree"; }
+
+      WeakFormSharedPtr<Scalar> wf;
+      std::vector<SpaceSharedPtr<Scalar> > spaces;
+      unsigned short spaces_size;
+      MeshSharedPtr mesh;
+      int ndof;
+
+      /// Mesh / space states the tables belong to.
+      int mesh_seq;
+      std::vector<int> space_seqs;
+
+      unsigned short order_increase;
+
+      /// See set_quadrature(), set_collocated_quadrature().
+      Quad2D* quadrature;
+      bool collocated_quadrature;
+      /// The quadrature used - the selected one, with the Gauss-Lobatto rules on quadrilaterals in the collocated mode.
+      Quad2D* quad_2d;
+
+      std::vector<ElementData> elements;
+      /// Element id -> index to elements.
+      std::vector<int> element_indices;
+      /// Assembly lists of all elements.
+      std::vector<int> dofs;
+      std::vector<Scalar> coefs;
+      std::vector<IntegrationDomain> domains;
+      /// Owned inner edges (indices to domains), grouped by colors.
+      std::vector<std::vector<unsigned int> > edge_colors;
+
+      ThreadData** thread_data;
+    };
+  }
+}
+#endif
@@ -23,6 +23,7 @@
 #include "mixins2d.h"
 #include "discrete_problem_helpers.h"
 #include "discrete_problem_thread_assembler.h"
+#include "mesh/mesh_partition.h"
 
 namespace Hermes
 {
@@ -83,6 +84,22 @@ namespace Hermes
       /// Without the matrix.
       bool assemble(Vector<Scalar>* rhs);
 
+      /// Parameter sweep assembling.
+      /// Assembles K weak formulation variants (e.g. the same forms with different material parameters) in one traversal:
+      /// geometry, assembly lists, shape function values and the previous iterations (and the external functions, if the variants
+      /// use the same ones) are calculated once per element and shared by all variants, the sparse structure is calculated once
+      /// and shared by all matrices (see CSMatrix::alloc_with_structure()).
+      /// The first variant becomes the weak formulation of this instance, all variants must have the same structure
+      /// (number of equations, forms and their blocks / symmetry, numbers of external functions), DG forms are not supported.
+      /// The integration order on an element is the maximum of the orders of all variants.
+      /// \param[in] wfs K weak formulation variants.
+      /// \param[in] mats K matrices of the same CS type (CSC / CSR), or empty for assembling the vectors only.
+      /// \param[in] rhss K vectors, or empty for assembling the matrices only.
+      bool assemble(Scalar*& coeff_vec, std::vector<WeakFormSharedPtr<Scalar> > wfs, std::vector<SparseMatrix<Scalar>*> mats, std::vector<Vector<Scalar>*> rhss = std::vector<Vector<Scalar>*>());
+      /// Parameter sweep assembling.
+      /// Light version passing nullptr for the coefficient vector.
+      bool assemble(std::vector<WeakFormSharedPtr<Scalar> > wfs, std::vector<SparseMatrix<Scalar>*> mats, std::vector<Vector<Scalar>*> rhss = std::vector<Vector<Scalar>*>());
+
       /// set time information for time-dependent problems.
       void set_time(double time);
       void set_time_step(double time_step);
@@ -97,6 +114,11 @@ namespace Hermes
       /// Get all spaces as a std::vector.
       std::vector<SpaceSharedPtr<Scalar> > get_spaces();
 
+      /// Sets the number of threads this instance assembles with (default: the global HermesCommonApi numThreads value).
+      /// Independent instances (not sharing meshes, spaces or weak forms) can assemble concurrently, each with its own
+      /// number of threads - e.g. from a user thread pool, with num_threads = 1 per instance.
+      void set_num_threads(int num_threads);
+
       /// Experimental.
       typedef void(*reassembled_states_reuse_linear_system_fn)(Traverse::State**& states, unsigned int& num_states, SparseMatrix<Scalar>* mat, Vector<Scalar>* rhs, Vector<Scalar>* dirichlet_lift_rhs, Scalar*& coeff_vec);
       void set_reassembled_states_reuse_linear_system_fn(reassembled_states_reuse_linear_system_fn fn) {
@@ -112,6 +134,57 @@ namespace Hermes
         }
       }
 
+      /// Collocated (spectral element) mode: on quadrilaterals, the Gauss-Lobatto rules of g_quad_2d_lobatto with p + 1 points
+      /// per direction are used (p being the highest order of the element over all spaces), regardless of the integrands.
+      /// With L2ShapesetGLLNodal, the quadrature points are the nodes of the basis and the mass matrix is diagonal,
+      /// so that explicit time stepping does not need a mass matrix solve. Other forms are integrated exactly for degrees up to 2p - 1.
+      /// Triangles use the rules of the quadrature selected by set_quadrature() (non-collocated) in both modes.
+      void set_collocated_quadrature(bool to_set);
+
+      /// Selects the quadrature (default g_quad_2d_std), e.g. g_quad_2d_symmetric (fewer points on triangles).
+      /// It is set to the reference mappings, the precalculated shapesets and all the external functions, and
+      /// the integration orders are limited by its maximum orders. In the collocated mode, its rules are used on triangles.
+      void set_quadrature(Quad2D* quadrature);
+      Quad2D* get_quadrature() const;
+
+      /// Integration order calibration.
+      /// On (at most) samples_per_marker elements per element marker, the values of every volumetric form are compared
+      /// for the orders k and k + 2, and the smallest k where they agree within the relative tolerance (in the l2 norm
+      /// of all the local values) is taken. The highest such k over the samples of a marker is set as the integration order
+      /// cap of the form in that area (Form::set_integration_order_cap()), so that forms with a pessimistic ord() (rational
+      /// or nonlinear integrands) are not integrated with the order table cap. The other settings of the form (the fixed order, the offset)
+      /// stay as they were in that area.
+      /// Existing caps limit the search, use Form::reset_integration_order_control() to calibrate from scratch.
+      /// The calibration is only valid for the current spaces (element orders), it should be repeated after adaptivity steps.
+      /// \param[in] coeff_vec The previous iteration for nonlinear problems (nullptr means zero).
+      void calibrate_integration_orders(double tolerance = 1e-8, Scalar* coeff_vec = nullptr, unsigned short samples_per_marker = 4);
+
+      /// Static meshes: the quadrature geometry of elements (physical coordinates, tangents and normals, jacobian x weights)
+      /// is kept between assemblings (Newton iterations, time steps) in a GeometryStore, instead of being recalculated.
+      /// The store is emptied automatically whenever a mesh changes (seq). Costs memory proportional to the number
+      /// of elements times the number of quadrature points.
+      void set_geometry_store(bool to_set);
+
+      /// Specialized assembly kernels (AssemblyKernels) for the matrix forms announcing their integral
+      /// (MatrixFormVol::get_assembly_kernel()), instantiated for fixed numbers of quadrature points. On by default,
+      /// the results are the same as with the generic path (MatrixFormVol::value()).
+      void set_specialized_kernels(bool to_set);
+      /// The store (nullptr if not used) - for its statistics.
+      const GeometryStore* get_geometry_store() const;
+
+      /// Distributed (MPI) assembling: the domain is partitioned (MeshPartition) by the active elements of mesh among the MPI ranks,
+      /// every rank assembles only the traversal states in its part - into a matrix with the sparse structure of these states only.
+      /// The right-hand side is summed over the ranks (all ranks have the whole vector), the matrix stays distributed, to be summed by the solver:
+      /// only MUMPS (the distributed assembled matrix input) is supported. All ranks have to have the same meshes and spaces, and call assemble() together.
+      /// DG forms are not supported. An empty mesh turns the distributed assembling off.
+      void set_mesh_partition(MeshSharedPtr mesh);
+      /// The partition (nullptr if the assembling is not distributed).
+      const MeshPartition* get_mesh_partition() const;
+
+      /// Statistics of the last assemble() call - states, integration orders, form evaluations, quadrature points,
+      /// inserted vs. structural nonzeros, shape function table hits and misses, and the times of the threads.
+      const AssemblyStatistics& get_assembly_statistics() const;
+
       /// See Hermes::Mixins::Loggable.
       virtual void set_verbose_output(bool to_set);
 
@@ -120,6 +193,13 @@ namespace Hermes
       void init_assembling(Traverse::State**& states, unsigned int& num_states, std::vector<MeshSharedPtr>& meshes);
       void deinit_assembling(Traverse::State** states, unsigned  int num_states);
 
+      /// Parameter sweep - checks that the variants can share the assembling.
+      void check_weak_formulation_variants(std::vector<WeakFormSharedPtr<Scalar> >& wfs, std::vector<SparseMatrix<Scalar>*>& mats, std::vector<Vector<Scalar>*>& rhss);
+      /// Parameter sweep - copies the sparse structure of the current matrix to the matrices of the variants.
+      void prepare_sparse_structure_variants();
+      /// Parameter sweep - releases the variants.
+      void free_weak_formulation_variants();
+
       /// RungeKutta helpers.
       void set_RK(int original_spaces_count, bool force_diagonal_blocks = nullptr, Table* block_weights = nullptr);
 
@@ -137,9 +217,40 @@ namespace Hermes
       /// Dirichlet lift rhs part.
       Vector<Scalar>* dirichlet_lift_rhs;
 
+      /// Parameter sweep - variants 1, ..., K-1 (variant 0 is this->wf) and their matrices, vectors and Dirichlet lift rhs parts.
+      /// Only non-empty during assemble(wfs, mats, rhss).
+      std::vector<WeakFormSharedPtr<Scalar> > wf_variants;
+      std::vector<SparseMatrix<Scalar>*> mat_variants;
+      std::vector<Vector<Scalar>*> rhs_variants;
+      std::vector<Vector<Scalar>*> dirichlet_lift_rhs_variants;
+
       /// Internal.
       bool nonlinear, add_dirichlet_lift, use_direct_for_Dirichlet_lift;
 
+      /// See set_quadrature().
+      Quad2D* quadrature;
+
+      /// See set_collocated_quadrature().
+      bool collocated_quadrature;
+
+      /// See set_specialized_kernels().
+      bool specialized_kernels;
+
+      /// See set_geometry_store().
+      GeometryStore* geometry_store;
+
+      /// See get_assembly_statistics().
+      AssemblyStatistics assembly_statistics;
+
+      /// See set_mesh_partition().
+      MeshPartition* mesh_partition;
+      /// Distributed assembling - keeps the states of this rank only (the others are deleted).
+      void select_owned_states(Traverse::State** states, unsigned int& num_states);
+      /// Distributed assembling - marks the matrix as the part of this rank / checks it is not distributed.
+      void set_matrix_distributed(SparseMatrix<Scalar>* mat);
+      /// Distributed assembling - sums the vector over the ranks.
+      void sum_distributed_vector(Vector<Scalar>* vec);
+
       /// DiscreteProblemMatrixVector methods.
       bool set_matrix(SparseMatrix<Scalar>* mat);
       bool set_rhs(Vector<Scalar>* rhs);
@@ -151,6 +262,9 @@ namespace Hermes
       /// Select the right things to assemble
       DiscreteProblemSelectiveAssembler<Scalar> selectiveAssembler;
 
+      /// Guards Element::visited in DG assembling - per instance, so that independent instances do not wait for each other.
+      omp_lock_t DG_visited_lock;
+
       template<typename T> friend class Solver;
       template<typename T> friend class LinearSolver;
       template<typename T, typename S> friend class AdaptSolver;
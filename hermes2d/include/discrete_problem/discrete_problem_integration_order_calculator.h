@@ -42,8 +42,9 @@ namespace Hermes
     private:
       DiscreteProblemIntegrationOrderCalculator(DiscreteProblemSelectiveAssembler<Scalar>* selectiveAssembler);
 
-      /// Adjusts order to refmaps.
-      void adjust_order_to_refmaps(Form<Scalar> *form, int& order, Hermes::Ord* o, RefMap** current_refmaps);
+      /// Adjusts order to refmaps and applies the integration order control of the form.
+      /// \param[in] marker Internal element (boundary for surface forms) marker, -1 for DG forms (default control only).
+      void adjust_order_to_refmaps(Form<Scalar> *form, int& order, Hermes::Ord* o, RefMap** current_refmaps, int marker = -1);
 
       /// Matrix volumetric forms - calculate the integration order.
       template<typename MatrixFormType>
@@ -58,17 +59,13 @@ namespace Hermes
 
       /// \ingroup Helper methods inside {calc_order_*, assemble_*}
       /// Calculates orders for previous nonlinear iterations.
+      /// The array lives in the arena, i.e. until the end of the state.
       Func<Hermes::Ord>** init_u_ext_orders();
-      /// \ingroup Helper methods inside {calc_order_*, assemble_*}
-      /// Cleans up after init_u_ext_orders.
-      void deinit_u_ext_orders(Func<Hermes::Ord>** u_ext_func);
 
       /// \ingroup Helper methods inside {calc_order_*, assemble_*}
       /// Calculates orders for external functions.
+      /// The array lives in the arena, i.e. until the end of the state.
       Func<Hermes::Ord>** init_ext_orders(std::vector<MeshFunctionSharedPtr<Scalar> >& ext, std::vector<UExtFunctionSharedPtr<Scalar> >& u_ext_fns, Func<Hermes::Ord>** u_ext_func);
-      /// \ingroup Helper methods inside {calc_order_*, assemble_*}
-      /// Cleans up after init_ext_orders.
-      void deinit_ext_orders(Func<Hermes::Ord>** ext_func);
 
       /// Calculates integration order for DG matrix forms.
       int calc_order_dg_matrix_form(const std::vector<SpaceSharedPtr<Scalar> > spaces, Traverse::State* state, MatrixFormDG<Scalar>* mfDG, RefMap** current_refmaps, Solution<Scalar>** current_u_ext, bool neighbor_supp_u, bool neighbor_supp_v, NeighborSearch<Scalar>** neighbor_searches);
@@ -83,10 +80,6 @@ namespace Hermes
       DiscontinuousFunc<Hermes::Ord>** init_ext_fns_ord(std::vector<MeshFunctionSharedPtr<Scalar> > &ext,
         NeighborSearch<Scalar>** neighbor_searches);
 
-      /// Deinitialize orders of external functions for DG forms.
-      template<typename FormType>
-      void deinit_ext_fns_ord(Form<Scalar> *form, FormType** oi, FormType** oext);
-
       /// For selective assembling.
       DiscreteProblemSelectiveAssembler<Scalar>* selectiveAssembler;
 
@@ -96,6 +89,9 @@ namespace Hermes
       Func<Hermes::Ord>** u_ext_orders;
       Traverse::State* current_state;
 
+      /// Per-state temporaries - the arena of the owning DiscreteProblemThreadAssembler, reset after each state.
+      MemoryArena* arena;
+
       template<typename T> friend class DiscreteProblem;
       template<typename T> friend class DiscreteProblemThreadAssembler;
     };
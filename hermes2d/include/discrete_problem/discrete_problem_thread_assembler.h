@@ -22,6 +22,9 @@
 #include "discrete_problem_helpers.h"
 #include "discrete_problem_integration_order_calculator.h"
 #include "discrete_problem_selective_assembler.h"
+#include "geometry_store.h"
+#include "assembly_statistics.h"
+#include "assembly_kernels.h"
 
 namespace Hermes
 {
@@ -48,6 +51,9 @@ namespace Hermes
       void init_spaces(const std::vector<SpaceSharedPtr<Scalar> > spaces);
       /// Initialization of the weak formulation.
       void set_weak_formulation(WeakFormSharedPtr<Scalar> wf);
+      /// Initialization of the weak formulation variants (parameter sweep), assembled together with this->wf.
+      /// \param[in] wf The primary weak formulation (passed to set_weak_formulation()), for detecting shared external functions.
+      void set_weak_formulation_variants(WeakFormSharedPtr<Scalar> wf, const std::vector<WeakFormSharedPtr<Scalar> >& wfs);
       /// Initialization of previous iterations for non-linear solvers.
       void init_u_ext(const std::vector<SpaceSharedPtr<Scalar> > spaces, Solution<Scalar>** u_ext_sln);
 
@@ -60,6 +66,9 @@ namespace Hermes
       /// Func Memory Pool
       pj_pool_t *FuncMemoryPool;
       void init_funcs_memory_pool();
+      /// Per-state temporaries (of this class, DiscreteProblemDGAssembler and DiscreteProblemIntegrationOrderCalculator).
+      /// Reset in deinit_assembling_one_state().
+      MemoryArena arena;
 
       /// De-initialize Func storages.
       void deinit_funcs();
@@ -78,24 +87,50 @@ namespace Hermes
       void init_assembling_one_state(const std::vector<SpaceSharedPtr<Scalar> >& spaces, Traverse::State* current_state);
       /// Assemble the state.
       void assemble_one_state();
+      /// Assemble the state for this->wf and all weak formulation variants (instead of assemble_one_state()), reusing geometry,
+      /// assembly lists, basis functions initialized by init_assembling_one_state() and the values of the previous iterations.
+      /// \param[in] mats, rhss, dirichlet_lift_rhss Per-variant targets (entries may be nullptr), without the ones of this->wf.
+      void assemble_one_state_variants(SparseMatrix<Scalar>** mats, Vector<Scalar>** rhss, Vector<Scalar>** dirichlet_lift_rhss);
+      /// Volumetric forms of this->wf, on the state with the u_ext, ext values initialized.
+      void assemble_volume_forms();
+      /// Surface forms of this->wf on the edge isurf, with the u_ext, ext values initialized.
+      void assemble_surface_forms(unsigned char isurf);
+      /// Sets this->wf and the targets of the variant variant_i (0 - the primary one) for assemble_one_state_variants().
+      void select_variant(unsigned short variant_i, WeakFormSharedPtr<Scalar> wf_primary, SparseMatrix<Scalar>* mat_primary, Vector<Scalar>* rhs_primary,
+        Vector<Scalar>* dirichlet_lift_rhs_primary, SparseMatrix<Scalar>** mats, Vector<Scalar>** rhss, Vector<Scalar>** dirichlet_lift_rhss);
       /// Matrix volumetric forms - assemble the form.
       template<typename MatrixFormType, typename Geom>
       void assemble_matrix_form(MatrixFormType* form, int order, Func<double>** base_fns, Func<double>** test_fns,
         AsmList<Scalar>* current_als_i, AsmList<Scalar>* current_als_j, int n_quadrature_points, Geom* geometry, double* jacobian_x_weights);
+      /// Matrix forms - whether the value of the (basis function j, test function i) pair is needed for the current targets
+      /// (not for the Dirichlet rows, reusable DOFs, the lower triangle of symmetric forms, the matrix when assembling just the rhs).
+      bool pair_to_be_evaluated(MatrixForm<Scalar>* form, bool sym, AsmList<Scalar>* current_als_i, unsigned int i, AsmList<Scalar>* current_als_j, unsigned int j) const;
+      /// Matrix forms - batched evaluation of the pairs set in batch_pairs into batch_values (MatrixFormVol::value_batch()), false if not supported.
+      bool evaluate_batch(MatrixFormVol<Scalar>* form, int n_quadrature_points, double* jacobian_x_weights, Func<Scalar>** u_ext, Func<double>** base_fns, unsigned int base_count,
+        Func<double>** test_fns, unsigned int test_count, GeomVol<double>* geometry, Func<Scalar>** ext);
+      bool evaluate_batch(MatrixFormSurf<Scalar>* form, int n_quadrature_points, double* jacobian_x_weights, Func<Scalar>** u_ext, Func<double>** base_fns, unsigned int base_count,
+        Func<double>** test_fns, unsigned int test_count, GeomSurf<double>* geometry, Func<Scalar>** ext);
       /// Vector volumetric forms - assemble the form.
       template<typename VectorFormType, typename Geom>
       void assemble_vector_form(VectorFormType* form, int order, Func<double>** test_fns, AsmList<Scalar>* current_als,
         int n_quadrature_points, Geom* geometry, double* jacobian_x_weights);
+      /// Integration order calibration (see DiscreteProblem::calibrate_integration_orders()) on the state initialized by init_assembling_one_state().
+      /// \param[out] calibrated_orders Per volumetric form (mfvol first, then vfvol) the smallest order whose values agree with the values
+      /// of order + 2 within the relative tolerance, -1 for forms not assembled on the state.
+      void calibrate_one_state(double tolerance, int* calibrated_orders);
+      /// Values of all volumetric forms (all basis function pairs) with the given order, for calibrate_one_state().
+      void calc_volumetric_form_values(int order, std::vector<std::vector<Scalar> >& values);
       /// De-initialization of 1 state assembly
       void deinit_assembling_one_state();
 
-      /// De-initialization.
+      /// De-initialization - collects the shape function table lookups into the statistics.
       void deinit_assembling();
 
       /// Free space-related data.
       void free_spaces();
       /// Free weak formulation data.
       void free_weak_formulation();
+      void free_weak_formulation_variants();
       /// Free nonlinearities-related data.
       void free_u_ext();
 
@@ -105,9 +140,31 @@ namespace Hermes
       PrecalcShapesetAssembling** pss;
       RefMap** refmaps;
       RefMap* rep_refmap;
+
+      /// The quadrature used - the selected one, with the Gauss-Lobatto rules on quadrilaterals in the collocated mode.
+      Quad2D* quad_2d;
+      /// The selected quadrature, see DiscreteProblem::set_quadrature().
+      Quad2D* quadrature;
+      void set_quadrature(Quad2D* quadrature);
+      /// Collocated mode, see DiscreteProblem::set_collocated_quadrature().
+      bool collocated_quadrature;
+      void set_collocated_quadrature(bool to_set);
+      /// Sets quad_2d from the selected quadrature and the collocated mode, also to the reference mappings.
+      void update_quad_2d();
+      /// See DiscreteProblem::set_specialized_kernels().
+      bool specialized_kernels;
+      /// The specialized kernels for the mode and order of the current state (nullptr - the generic path), per AssemblyKernelType.
+      AssemblyKernels::MatrixKernel state_kernels[HERMES_KERNEL_COUNT];
+      /// Geometry store (owned by DiscreteProblem), nullptr means recalculating the geometry.
+      GeometryStore* geometry_store;
       Solution<Scalar>** u_ext;
       std::vector<Transformable *> fns;
 
+      /// Parameter sweep - clones of the weak formulation variants.
+      std::vector<WeakFormSharedPtr<Scalar> > wf_variants;
+      /// Parameter sweep - all variants have the external functions (wf->ext, wf->u_ext_fn) of the primary weak formulation.
+      bool variants_share_ext;
+
       /// For selective reassembling.
       DiscreteProblemSelectiveAssembler<Scalar>* selectiveAssembler;
 
@@ -115,6 +172,9 @@ namespace Hermes
       Traverse::State* current_state;
       /// Current local matrix.
       Scalar local_stiffness_matrix[H2D_MAX_LOCAL_BASIS_SIZE * H2D_MAX_LOCAL_BASIS_SIZE * 4];
+      /// Pairs to be evaluated and form values of the batched evaluation, see evaluate_batch().
+      bool batch_pairs[H2D_MAX_LOCAL_BASIS_SIZE * H2D_MAX_LOCAL_BASIS_SIZE];
+      Scalar batch_values[H2D_MAX_LOCAL_BASIS_SIZE * H2D_MAX_LOCAL_BASIS_SIZE];
 
       /// Integration orders for the currently assembled state.
       /// - calculator
@@ -148,6 +208,9 @@ namespace Hermes
       unsigned short spaces_size;
       bool nonlinear, add_dirichlet_lift;
 
+      /// Counters of the current assembling (reset in init_assembling()), see DiscreteProblem::get_assembly_statistics().
+      AssemblyCounters statistics;
+
       friend class DiscreteProblem < Scalar > ;
       friend class DiscreteProblemDGAssembler < Scalar > ;
 
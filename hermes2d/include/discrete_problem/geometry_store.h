@@ -0,0 +1,110 @@
+/// This file is part of Hermes2D.
+///
+/// Hermes2D is free software: you can redistribute it and/or modify
+/// it under the terms of the GNU General Public License as published by
+/// the Free Software Foundation, either version 2 of the License, or
+/// (at your option) any later version.
+///
+/// Hermes2D is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY;without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with Hermes2D. If not, see <http:///www.gnu.org/licenses/>.
+
+#ifndef __H2D_GEOMETRY_STORE_H
+#define __H2D_GEOMETRY_STORE_H
+
+#include "../forms.h"
+#include "../mesh/refmap.h"
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    /// Geometry store class
+    /// \brief Stores the quadrature geometry of elements (physical coordinates, tangents and normals, jacobian x weights)
+    /// so that repeated assembling on a static mesh (Newton iterations, time steps) does not recalculate it.
+    ///
+    /// The records are keyed by (element, sub-element transform, quadrature, order, edge), calculated on first use
+    /// by the assembling threads, and all dropped in validate() when any of the meshes changed (seq).
+    /// The store is split into shards with separate locks so that the threads do not contend for one lock.
+    /// The records are accounted in the memory accounting (memoryRefMapCaches) - when over the limit, nothing more is stored,
+    /// and enforce_memory_limits() drops the records.
+    class HERMES_API GeometryStore
+    {
+    public:
+      GeometryStore();
+      ~GeometryStore();
+
+      /// Drops all records if the meshes are not the ones (or their seq is not the one) of the previous call.
+      /// Not thread-safe, to be called before the parallel assembling.
+      void validate(const std::vector<MeshSharedPtr>& meshes);
+
+      /// Drops all records.
+      void clear();
+
+      /// The same as init_geometry_points_allocated(), with the store.
+      unsigned char get_volume_geometry(RefMap* rep_reference_mapping, int order, GeomVol<double>& geometry, double* jacobian_x_weights);
+
+      /// The same as init_surface_geometry_points_allocated(), with the store.
+      unsigned char get_surface_geometry(RefMap* rep_reference_mapping, int& order, unsigned char isurf, int marker, GeomSurf<double>& geometry, double* jacobian_x_weights);
+
+      /// Number of records.
+      unsigned int get_num_records() const;
+      /// Memory used by the record data in bytes.
+      size_t get_size() const;
+
+    private:
+      struct Key
+      {
+        Key(Element* element, uint64_t sub_idx, unsigned char quad_id, int order, char isurf);
+        bool operator<(const Key& other) const;
+
+        Element* element;
+        uint64_t sub_idx;
+        unsigned char quad_id;
+        int order;
+        /// -1 for the volumetric geometry.
+        char isurf;
+      };
+
+      struct Record
+      {
+        unsigned char np;
+        /// Edge quadrature order (surface records).
+        int edge_order;
+        bool orientation;
+        /// Volumetric: x, y, jacobian x weights.
+        /// Surface: x, y, tx, ty, jacobian x weights.
+        double* data;
+      };
+
+      static const unsigned short shard_count = 64;
+
+      struct Shard
+      {
+        std::map<Key, Record> records;
+        omp_lock_t lock;
+      };
+
+      Shard shards[shard_count];
+
+      Shard& get_shard(const Key& key);
+
+      /// Inserts (if not inserted by another thread meanwhile) - data is taken over / deleted.
+      void insert(Shard& shard, const Key& key, Record& record);
+
+      /// Memory evictor (HermesCommonApi).
+      static void evict(void* store);
+
+      /// Bytes of all records.
+      long long size;
+
+      /// Meshes & their seqs from the last validate().
+      std::vector<std::pair<Mesh*, unsigned> > mesh_seqs;
+    };
+  }
+}
+#endif
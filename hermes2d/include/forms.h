@@ -214,6 +214,8 @@ namespace Hermes
     class HERMES_API Func < double >
     {
     public:
+      HERMES_POOL_ALLOCATED
+
       /// Constructor.
       Func();
       /// Constructor.
@@ -265,6 +267,8 @@ namespace Hermes
     class HERMES_API Func < std::complex<double> >
     {
     public:
+      HERMES_POOL_ALLOCATED
+
       /// Constructor.
       Func();
       /// Constructor.
@@ -354,8 +358,10 @@ namespace Hermes
       /// \param[in]  fn                  Function defined either on the central or the neighbor element.
       /// \param[in]  support_on_neighbor True if \c fn is defined on the neighbor element, false if on the central element.
       /// \param[in]  reverse             Same meaning as \c reverse_neighbor_side.
+      /// \param[in]  arena               If set, \c fn is expected to live in the arena as well as this instance; the reversed
+      ///                                 neighbor values are then allocated in the arena and nothing is freed in free().
       ///
-      DiscontinuousFunc(Func<T>* fn, bool support_on_neighbor, bool reverse = false);
+      DiscontinuousFunc(Func<T>* fn, bool support_on_neighbor, bool reverse = false, MemoryArena* arena = nullptr);
 
       /// Two-component constructor.
       ///
@@ -376,6 +382,10 @@ namespace Hermes
       ///< (when retrieving values on an edge that is oriented differently in both elements).
       /// Zero value used for the zero-extension.
       static T zero;
+
+    private:
+      /// All data are owned by a MemoryArena.
+      bool arena_allocated;
     };
 
     template<>
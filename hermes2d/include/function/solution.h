@@ -149,6 +149,9 @@ namespace Hermes
 
       virtual MeshFunction<Scalar>* clone() const;
 
+      /// Category of the coefficient tables in the memory accounting (HermesCommonApi), default memorySolutionTables.
+      void set_memory_category(HermesMemoryCategory category);
+
       void set_type(SolutionType type) { sln_type = type; };
 
       virtual void free();
@@ -196,6 +199,12 @@ namespace Hermes
 
       void init_dxdy_buffer();
 
+      /// Memory accounting of the coefficient tables.
+      HermesMemoryCategory memory_category;
+      long long memory_accounted;
+      /// Reports the change of the size of the coefficient tables.
+      void update_memory_accounting();
+
       /// Internal, checks the compliance of the passed space type and owned space type.
       void check_space_type_compliance(const char* space_type_to_check) const;
 
@@ -122,6 +122,7 @@ namespace Hermes
       template<typename T> friend class DiscontinuousFunc;
       template<typename T> friend class DiscreteProblem;
       template<typename T> friend class DiscreteProblemDGAssembler;
+      template<typename T> friend class DiscreteProblemDGMatrixFree;
       template<typename T> friend class DiscreteProblemThreadAssembler;
       template<typename T> friend class NeighborSearch;
       friend class CurvMap;
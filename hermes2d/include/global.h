@@ -138,7 +138,8 @@ namespace Hermes
       HERMES_L2_LEGENDRE = 1,
       HERMES_L2_TAYLOR = 2,
       HERMES_HDIV_LEGENDRE = 3,
-      HERMES_HCURL_GRADLEG = 4
+      HERMES_HCURL_GRADLEG = 4,
+      HERMES_L2_GLL_NODAL = 5
     };
 
     const char* spaceTypeToString(SpaceType spaceType);
@@ -160,6 +161,15 @@ namespace Hermes
       HERMES_SYM = 1
     };
 
+    /// Specialized assembly kernel of a matrix volumetric form, see MatrixFormVol::get_assembly_kernel() and AssemblyKernels.
+    enum AssemblyKernelType
+    {
+      HERMES_KERNEL_NONE = -1,      // The generic path - MatrixFormVol::value().
+      HERMES_KERNEL_MASS = 0,       // \int u v.
+      HERMES_KERNEL_DIFFUSION = 1,  // \int \nabla u \cdot \nabla v.
+      HERMES_KERNEL_COUNT = 2
+    };
+
     /// Linearizer can store data in an effective way depending on the purpose.
     /// - whether it is an OpenGL (Hermes views, Agros2d) or a file export (VTK, Tecplot)
     enum LinearizerOutputType
@@ -24,6 +24,7 @@
 #include "solver/picard_solver.h"
 #include "solver/linear_solver.h"
 #include "solver/nox_solver.h"
+#include "solver/keff_eigenvalue_solver.h"
 
 #include "boundary_conditions/essential_boundary_conditions.h"
 
@@ -55,9 +56,11 @@
 
 #include "mesh/refmap.h"
 #include "mesh/traverse.h"
+#include "mesh/mesh_partition.h"
 
 #include "weakform/weakform.h"
 #include "discrete_problem/discrete_problem.h"
+#include "discrete_problem/dg/discrete_problem_dg_matrix_free.h"
 #include "forms.h"
 
 #include "function/exact_solution.h"
@@ -103,6 +106,7 @@
 #include "weakform_library/weakforms_elasticity.h"
 #include "weakform_library/integrals_h1.h"
 #include "weakform_library/weakforms_h1.h"
+#include "weakform_library/weakforms_expressions.h"
 #include "weakform_library/weakforms_hcurl.h"
 #include "weakform_library/weakforms_maxwell.h"
 #include "weakform_library/weakforms_neutronics.h"
@@ -127,8 +127,12 @@ namespace Hermes
       /// Calculates the diameter.
       void calc_diameter();
 
+      /// Calculates (and stores) the center of gravity.
+      void calc_center();
+
       /// Returns the center of gravity.
-      void get_center(double& x, double& y);
+      /// Read-only - uses the stored value if calc_center() was called (see Mesh::precompute_element_geometry()).
+      void get_center(double& x, double& y) const;
 
       /// vertex node pointers
       Node* vn[H2D_MAX_NUMBER_VERTICES];
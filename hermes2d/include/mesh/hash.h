@@ -95,6 +95,9 @@ namespace Hermes
       /// Removes an edge node with parent id's p1 and p2.
       void remove_edge_node(int id);
 
+      /// Reports the change of the size of the node array and the hash tables to the memory accounting (HermesCommonApi).
+      void update_memory_accounting();
+
       // Internal members
     private:
 
@@ -105,6 +108,9 @@ namespace Hermes
 
       int mask;
 
+      /// Bytes reported to the memory accounting.
+      long long memory_accounted;
+
       inline int hash(int p1, int p2) const { return (984120265 * p1 + 125965121 * p2) & mask; }
 
       /// Searches a list of hash synonyms given the first list item.
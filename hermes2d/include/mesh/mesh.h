@@ -33,6 +33,8 @@ namespace Hermes
     struct MItem;
     struct Rect;
     extern HERMES_API unsigned g_mesh_seq;
+    /// Returns a new mesh seq number - thread-safe, meshes may be created / refined concurrently.
+    HERMES_API unsigned next_mesh_seq();
 
     namespace RefinementSelectors
     {
@@ -143,6 +145,11 @@ namespace Hermes
 
       /// For internal use.
       unsigned get_seq() const;
+
+      /// Calculates the per-element geometric data (inverse reference map order, center)
+      /// of all used elements in parallel. Does nothing if already done for the current seq.
+      /// Called before traversing (and thus before parallel assembling), after that all the data are only read.
+      void precompute_element_geometry();
 #pragma endregion
 
 #pragma region refinements
@@ -319,6 +326,9 @@ namespace Hermes
 
       unsigned seq;
 
+      /// The seq the element geometry was precomputed for, -1 if not yet.
+      int element_geometry_seq;
+
       /// For internal use.
       void initial_single_check();
 
@@ -0,0 +1,75 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __H2D_MESH_PARTITION_H
+#define __H2D_MESH_PARTITION_H
+
+#include "mesh_util.h"
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    /// \brief Partition of the domain among the MPI ranks, for the distributed assembling (DiscreteProblem::set_mesh_partition()).
+    /// The active elements of a mesh are split into parts of (almost) equal numbers of elements by recursive coordinate bisection
+    /// of the element centers. The cuts are kept, so that any element of any mesh over the same domain (refinements, other
+    /// meshes of a multi-mesh problem) is assigned to the part its center falls into - the assignment of a traversal state does
+    /// not depend on which of the meshes its representative element comes from.
+    ///
+    /// Every rank has the whole mesh and computes the same partition, no communication is needed.
+    class HERMES_API MeshPartition
+    {
+    public:
+      /// \param[in] mesh The active elements of this mesh are partitioned.
+      /// \param[in] num_parts Number of the parts, the number of the MPI ranks by default.
+      /// \param[in] part The part of this process, the MPI rank by default.
+      MeshPartition(MeshSharedPtr mesh, int num_parts = MpiCommunication::get_size(), int part = MpiCommunication::get_rank());
+
+      int get_num_parts() const;
+      int get_part() const;
+
+      /// The part containing the point.
+      int get_owner(double x, double y) const;
+      /// The part containing the center of the element.
+      int get_owner(Element* e) const;
+      /// Whether the center of the element is in the part of this process.
+      bool is_owned(Element* e) const;
+
+      /// Numbers of the partitioned elements in the parts.
+      const std::vector<unsigned int>& get_part_sizes() const;
+
+    private:
+      /// A node of the bisection tree - a cut, or a leaf (a part).
+      struct Node
+      {
+        /// Part of a leaf, -1 for a cut.
+        int part;
+        /// Cut: 0 - x, 1 - y, the coordinate at which the cut is, the subtrees below and above it.
+        unsigned char axis;
+        double value;
+        int below, above;
+      };
+
+      /// Bisects the points [first, last) into num_parts parts starting with first_part.
+      /// \return The index of the node.
+      int bisect(std::vector<std::pair<double, double> >& points, unsigned int first, unsigned int last, int first_part, int num_parts);
+
+      std::vector<Node> nodes;
+      std::vector<unsigned int> part_sizes;
+      int num_parts, part;
+    };
+  }
+}
+#endif
@@ -17,6 +17,7 @@
 #define __H2D_LIMIT_ORDER_H
 
 #include "../global.h"
+#include "quad.h"
 namespace Hermes
 {
   namespace Hermes2D
@@ -31,6 +32,11 @@ namespace Hermes
     extern HERMES_API void update_limit_table(ElementMode2D mode);
     extern HERMES_API void limit_order(int& o, ElementMode2D mode);
     extern HERMES_API void limit_order_nowarn(int& o, ElementMode2D mode);
+
+    /// Variants for other quadratures than g_quad_2d_std (e.g. g_quad_2d_symmetric), the order is
+    /// limited by the safe maximum order of quad.
+    extern HERMES_API void limit_order(int& o, ElementMode2D mode, Quad2D* quad);
+    extern HERMES_API void limit_order_nowarn(int& o, ElementMode2D mode, Quad2D* quad);
   }
 }
 #endif
\ No newline at end of file
@@ -38,11 +38,16 @@ namespace Hermes
 #define g_max_quad 24
     // Maximum integration order for global quadrature, for triangles.
 #define g_max_tri 20
+    // Maximum integration order for the fully symmetric triangle quadrature (Quad2DSymmetric).
+#define g_max_tri_symmetric 30
+    // Maximum integration order for the Gauss-Lobatto quadrature (Quad1DLobatto, Quad2DLobatto), 13 points per direction.
+#define g_max_quad_lobatto 23
 
     // Maximum number of integration points.
 #define H2D_MAX_INTEGRATION_POINTS_COUNT_TRI 79
+#define H2D_MAX_INTEGRATION_POINTS_COUNT_TRI_SYMMETRIC 177
 #define H2D_MAX_INTEGRATION_POINTS_COUNT_QUAD 169
-#define H2D_MAX_INTEGRATION_POINTS_COUNT 169
+#define H2D_MAX_INTEGRATION_POINTS_COUNT 177
 
     /// Quad1D is a base class for all 1D quadrature points.
     ///
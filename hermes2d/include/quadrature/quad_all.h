@@ -32,6 +32,15 @@ namespace Hermes
             virtual void dummy_fn() {}
     };
 
+    /// 1D Gauss-Lobatto quadrature points on the standard reference domain (-1,1), including the end points.
+    /// The rule for the order o has o / 2 + 2 points and is exact for polynomials of degree 2 * (o / 2) + 1.
+    class HERMES_API Quad1DLobatto : public Quad1D
+    {
+    public: Quad1DLobatto();
+
+            virtual void dummy_fn() {}
+    };
+
     /// 2D quadrature points on the standard reference domains (-1,1)^2
     class HERMES_API Quad2DStd : public Quad2D
     {
@@ -45,8 +54,61 @@ namespace Hermes
              virtual void dummy_fn() {}
     };
 
+    /// 2D quadrature points, fully symmetric (invariant under all symmetries of the triangle) rules on triangles
+    /// with positive weights and all points inside the element, up to the order g_max_tri_symmetric.
+    /// The rules were computed by solving the moment equations of the orthonormal (Dubiner) basis for
+    /// the orbit parameters and weights, the number of points is the smallest one found for each order.
+    /// On quadrilaterals, the tensor-product Gauss rules of Quad2DStd are used.
+    /// To use it, pass it to set_quad_2d() and use the limit_order() variants taking the quadrature.
+    class HERMES_API Quad2DSymmetric : public Quad2D
+    {
+    public:  Quad2DSymmetric();
+             ~Quad2DSymmetric();
+             virtual unsigned char get_id()
+             {
+               return 3;
+             };
+    };
+
+    /// 2D quadrature points, tensor-product Gauss-Lobatto rules on quadrilaterals, up to the order g_max_quad_lobatto.
+    /// The points of the rule for the order 2p - 1 are the nodes of L2ShapesetGLLNodal of the order p, so that
+    /// the mass matrix of that shapeset is diagonal (see DiscreteProblem::set_collocated_quadrature()).
+    /// The edge rules are Gauss-Lobatto as well, on triangles the rules of Quad2DStd are used.
+    class HERMES_API Quad2DLobatto : public Quad2D
+    {
+    public:  Quad2DLobatto();
+             ~Quad2DLobatto();
+             virtual unsigned char get_id()
+             {
+               return 4;
+             };
+    };
+
+    /// 2D quadrature points taken from two quadratures - the rules on triangles from one, and the rules on
+    /// quadrilaterals from the other. The tables are not copied, both quadratures have to outlive this one.
+    /// Used by the collocated mode (Gauss-Lobatto on quadrilaterals) with a quadrature selected by
+    /// DiscreteProblem::set_quadrature() for triangles.
+    class HERMES_API Quad2DComposite : public Quad2D
+    {
+    public:  Quad2DComposite(Quad2D* quad_tri, Quad2D* quad_quad);
+             ~Quad2DComposite();
+             /// A shared instance for the pair, created on the first call and kept until the program ends
+             /// (functions and reference mappings identify the quadratures by their addresses).
+             static Quad2D* get(Quad2D* quad_tri, Quad2D* quad_quad);
+             /// Unique for each pair of the (base) quadratures: (triangle id << 4) | quadrilateral id.
+             virtual unsigned char get_id()
+             {
+               return id;
+             };
+    protected:
+      unsigned char id;
+    };
+
     extern HERMES_API Quad1DStd g_quad_1d_std;
     extern HERMES_API Quad2DStd g_quad_2d_std;
+    extern HERMES_API Quad2DSymmetric g_quad_2d_symmetric;
+    extern HERMES_API Quad1DLobatto g_quad_1d_lobatto;
+    extern HERMES_API Quad2DLobatto g_quad_2d_lobatto;
 
     //// linearization "quadrature" ////////////////////////////////////////////////////////////////////
 
@@ -18,6 +18,7 @@
 
 #include "../function/function.h"
 #include "../shapeset/shapeset.h"
+#include <atomic>
 
 namespace Hermes
 {
@@ -84,12 +85,15 @@ namespace Hermes
       template<typename T> friend class DiscontinuousFunc;
       template<typename T> friend class DiscreteProblem;
       template<typename T> friend class DiscreteProblemDGAssembler;
+      template<typename T> friend class DiscreteProblemDGMatrixFree;
       template<typename T> friend class DiscreteProblemThreadAssembler;
       template<typename T> friend class NeighborSearch;
       friend class CurvMap;
     };
 
     /// \brief PrecalcShapesetAssembling common storage.
+    /// The value tables of an order are allocated on first use, and accounted in the memory accounting (memoryPrecalcTables)
+    /// - when over the limit, no more orders are allocated (the values are calculated instead), and enforce_memory_limits() evicts the tables.
     class HERMES_API PrecalcShapesetAssemblingStorage
     {
     public:
@@ -99,9 +103,29 @@ namespace Hermes
       unsigned short max_index[2];
       unsigned short ref_count;
 
+      /// Frees all value tables, they are calculated again on demand.
+      /// Not thread-safe, not to be called while any PrecalcShapesetAssembling uses the storage
+      /// (see Hermes::Api::enforce_memory_limits()).
+      void evict();
+
     private:
+      /// Allocates the value tables of one order (if not allocated yet, and the memory limit allows).
+      /// \return If the tables are available.
+      bool prepare_order(ElementMode2D mode, unsigned short order, unsigned char np);
+
+      /// Memory evictor (HermesCommonApi).
+      static void evict_storage(void* storage);
+
       double*** PrecalculatedValues[H2D_NUM_MODES][H2D_NUM_FUNCTION_VALUES];
+      /// Per mode & order: the tables of PrecalculatedValues, published (release) by prepare_order() once all of them
+      /// are set up, nullptr if not prepared. Read with acquire, so that the other threads see the complete tables.
+      std::atomic<double**>* prepared_tables[H2D_NUM_MODES];
       bool** PrecalculatedInfo[H2D_NUM_MODES];
+      /// Number of orders per mode.
+      unsigned short g_max[H2D_NUM_MODES];
+      /// Number of points of the allocated value tables per mode & order.
+      unsigned char* allocated_np[H2D_NUM_MODES];
+      bool evictor_registered;
       friend class PrecalcShapesetAssembling;
     };
 
@@ -153,11 +177,19 @@ namespace Hermes
 
       const double* get_values(int component, unsigned short item) const;
 
+      /// Lookups of the values (set_quad_order() calls) found in the common tables / calculated, since the creation or reset_table_statistics().
+      unsigned long long get_table_hits() const;
+      unsigned long long get_table_misses() const;
+      void reset_table_statistics();
+
     private:
       virtual void precalculate(unsigned short order, unsigned short mask);
 
       PrecalcShapesetAssemblingStorage* storage;
 
+      /// See get_table_hits().
+      unsigned long long table_hits, table_misses;
+
       bool attempt_to_reuse(unsigned short order) const;
       bool reuse_possible() const;
     };
@@ -17,6 +17,12 @@
 #define __H2D_SHAPESET_H
 
 #include "../global.h"
+
+/// Constrained edge combinations are cached in chunks, the chunks are never reallocated
+/// (so that the cache can be read without locking). 64 chunks of 1024 cover the whole unsigned short index range.
+#define H2D_COMB_TABLE_CHUNK_SIZE 1024
+#define H2D_COMB_TABLE_CHUNKS 64
+
 namespace Hermes
 {
   namespace Hermes2D
@@ -52,7 +58,7 @@ namespace Hermes
 #define H2D_MAX_LOCAL_BASIS_SIZE_QUAD 308
 #define H2D_MAX_LOCAL_BASIS_SIZE_TRI 164
 #define H2D_MAX_LOCAL_BASIS_SIZE 308
-#define H2D_NUM_SHAPESETS 5
+#define H2D_NUM_SHAPESETS 6
 #endif
 
     /// Should be exactly the same as is the count of enum ShapesetType
@@ -189,8 +195,7 @@ namespace Hermes
       unsigned short ebias;
       ///< first edge function.
 
-      double** comb_table;
-      unsigned short table_size;
+      double*** comb_table;
       /**    numbering of edge intervals: (the variable 'part')
       -+-        -+-         -+-
       |          |        13 |
@@ -58,6 +58,31 @@ namespace Hermes
       static const unsigned short max_index[H2D_NUM_MODES];
     };
 
+    /// L2 nodal shapeset - tensor products of the Lagrange polynomials on the Gauss-Lobatto(-Legendre) points.
+    /// An element of the order p has (p + 1)^2 functions, each of them equal to one at one of the points of the
+    /// Gauss-Lobatto rule of the order 2p - 1 of Quad2DLobatto and zero at the others. With that rule (see
+    /// DiscreteProblem::set_collocated_quadrature()), the mass matrix is diagonal - spectral element mass lumping.
+    /// Only isotropic orders on quadrilaterals; on triangles, the same (tensor-product) functions are used.
+    class HERMES_API L2ShapesetGLLNodal : public Shapeset
+    {
+    public:
+      L2ShapesetGLLNodal();
+      virtual Shapeset* clone() { return new L2ShapesetGLLNodal(*this); };
+      virtual SpaceType get_space_type() const { return HERMES_L2_SPACE; }
+      virtual unsigned short get_max_index(ElementMode2D mode) const;
+      virtual unsigned char get_id() const { return HERMES_L2_GLL_NODAL; }
+
+      /// Returns a complete set of indices of bubble functions for an element of the given order.
+      /// Reimplemented because the functions of different orders are not hierarchical and only isotropic orders are supported.
+      short* get_bubble_indices(unsigned short order, ElementMode2D mode) const;
+
+      /// Returns the number of bubble functions for an element of the given order.
+      /// Reimplemented because the functions of different orders are not hierarchical and only isotropic orders are supported.
+      virtual unsigned short get_num_bubbles(unsigned short order, ElementMode2D mode) const;
+
+      static const unsigned short max_index[H2D_NUM_MODES];
+    };
+
     /// This is the default shapeset typedef
     typedef L2ShapesetLegendre L2Shapeset;
   }
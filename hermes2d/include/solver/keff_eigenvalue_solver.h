@@ -0,0 +1,148 @@
+// This file is part of Hermes2D
+//
+// Copyright (c) 2009 hp-FEM group at the University of Nevada, Reno (UNR).
+// Email: hpfem-group@unr.edu, home page: http://www.hpfem.org/.
+//
+// Hermes2D is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation; either version 2 of the License,
+// or (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+/*! \file keff_eigenvalue_solver.h
+\brief k-eigenvalue (criticality) solver.
+*/
+#ifndef __H2D_KEFF_EIGENVALUE_SOLVER_H_
+#define __H2D_KEFF_EIGENVALUE_SOLVER_H_
+
+#include "discrete_problem/discrete_problem.h"
+#include "global.h"
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    /// Solver of the k-eigenvalue problem L phi = 1/k F phi (multigroup neutron diffusion: L the loss operator,
+    /// F the fission operator, see WeakFormsNeutronics::Multigroup::CompleteWeakForms::Diffusion::DefaultWeakFormLossOperator
+    /// and DefaultWeakFormFissionOperator), for the fundamental mode (the largest k).<br>
+    /// Both operators are assembled once (in the first solve() and after set_spaces()), the outer (power) iterations
+    /// only do a substitution with the factorization of L, computed once and reused by the direct solver, and a product with F.
+    /// The iterations can be accelerated by:<br>
+    /// - the Wielandt shift (set_wielandt_shift()): the factorized operator is L - F / k_s, with k_s above k,
+    /// which lowers the dominance ratio of the iteration from k_1 / k_0 to (1/k_0 - 1/k_s) / (1/k_1 - 1/k_s),<br>
+    /// - the Chebyshev extrapolation of the iterates (set_chebyshev_acceleration()), with the dominance ratio estimated
+    /// from the free (plain) iterations.<br>
+    /// Typical usage:<br>
+    /// KeffEigenvalueSolver solver(loss_wf, fission_wf, spaces);<br>
+    /// solver.set_wielandt_shift(1.2);<br>
+    /// solver.solve();<br>
+    /// Solution<double>::vector_to_solutions(solver.get_sln_vector(), spaces, slns);<br>
+    /// double keff = solver.get_keff();<br>
+    /// Real problems only, the operators have to be in a compressed sparse (CSC / CSR) format for the Wielandt shift.
+    class HERMES_API KeffEigenvalueSolver :
+      public virtual Hermes::Mixins::TimeMeasurable,
+      public Hermes::Mixins::Loggable
+    {
+    public:
+      KeffEigenvalueSolver(WeakFormSharedPtr<double> loss_wf, WeakFormSharedPtr<double> fission_wf, SpaceSharedPtr<double> space);
+      KeffEigenvalueSolver(WeakFormSharedPtr<double> loss_wf, WeakFormSharedPtr<double> fission_wf, std::vector<SpaceSharedPtr<double> > spaces);
+      virtual ~KeffEigenvalueSolver();
+
+      /// Solve.
+      /// \param[in] coeff_vec The initial guess (nullptr means all coefficients equal to one).
+      void solve(double* coeff_vec = nullptr);
+
+      /// Solve.
+      /// \param[in] initial_guess Solutions to start from (which are projected to obtain the initial coefficient vector).
+      void solve(std::vector<MeshFunctionSharedPtr<double> > initial_guess);
+
+      /// Convergence: the relative change of k and the relative change (max norm) of the fission source
+      /// between two outer iterations.
+      void set_tolerance(double keff_tolerance, double source_tolerance);
+      void set_max_allowed_iterations(int max_allowed_iterations);
+
+      /// The initial guess of k (default 1.0).
+      void set_initial_keff(double initial_keff);
+
+      /// The Wielandt shift k_s (0.0 - default - switches the shift off). It has to be above k (but not much above,
+      /// for the shift to be effective), otherwise the iteration converges to a wrong mode, or not at all.
+      /// Changing the shift requires a new factorization.
+      void set_wielandt_shift(double keff_shift);
+
+      /// Chebyshev extrapolation in cycles of cycle_length iterations, after free_iterations plain iterations.
+      /// \param[in] dominance_ratio The dominance ratio of the (shifted) iteration, 0.0 means the estimate from the free iterations.
+      /// A cycle that does not decrease the change of the fission source restarts the free iterations (and the estimate).
+      void set_chebyshev_acceleration(bool to_set, double dominance_ratio = 0.0, int free_iterations = 6, int cycle_length = 6);
+
+      /// Sets new spaces, the operators are assembled again in the next solve().
+      void set_spaces(std::vector<SpaceSharedPtr<double> > spaces);
+
+      /// Number of threads used for assembling the operators, see DiscreteProblem::set_num_threads().
+      void set_num_threads(int num_threads);
+
+      /// The eigenvalue.
+      double get_keff() const;
+
+      /// The eigenvector, normalized to a unit (l2) norm of its fission source F phi.
+      double* get_sln_vector();
+
+      /// Number of outer iterations of the last solve().
+      int get_num_iters() const;
+
+      /// The last estimate of the dominance ratio from the free iterations (0.0 if there were not enough of them).
+      double get_dominance_ratio_estimate() const;
+
+      /// The solver of the factorized operator - for its statistics (factorizations, solves).
+      Hermes::Solvers::LinearMatrixSolver<double>* get_linear_matrix_solver();
+
+    protected:
+      void init();
+
+      /// Assembles L and F.
+      void assemble_operators();
+
+      /// Creates the factorized operator (L, or L - F / k_s) and its solver, if not done already.
+      void prepare_factorization();
+
+      /// Operators.
+      DiscreteProblem<double>* loss_dp;
+      DiscreteProblem<double>* fission_dp;
+      SparseMatrix<double>* loss_matrix;
+      SparseMatrix<double>* fission_matrix;
+      /// L - F / k_s (nullptr without the Wielandt shift).
+      SparseMatrix<double>* shifted_matrix;
+      Vector<double>* rhs;
+      bool operators_assembled;
+      int problem_size;
+
+      /// Solver of the factorized operator, and the shift it has been created for.
+      Hermes::Solvers::LinearMatrixSolver<double>* linear_matrix_solver;
+      double factorized_keff_shift;
+
+      /// Settings.
+      double keff_tolerance;
+      double source_tolerance;
+      int max_allowed_iterations;
+      double initial_keff;
+      double keff_shift;
+      bool chebyshev_acceleration;
+      double chebyshev_dominance_ratio;
+      int chebyshev_free_iterations;
+      int chebyshev_cycle_length;
+
+      /// Results.
+      double keff;
+      double* sln_vector;
+      int num_iters;
+      double dominance_ratio_estimate;
+    };
+  }
+}
+#endif
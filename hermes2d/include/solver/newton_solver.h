@@ -104,6 +104,9 @@ namespace Hermes
       virtual bool assemble_jacobian(bool store_previous_jacobian);
       /// \return Information if the jacobian structure was reused.
       virtual bool assemble(bool store_previous_jacobian, bool store_previous_residual);
+      /// The residual can be assembled into another vector - see NonlinearMatrixSolver::set_task_overlap().
+      virtual bool supports_task_overlap() const;
+      virtual void assemble_residual_into(Hermes::Algebra::Vector<Scalar>* residual);
 
       /// Initialization - called at the beginning of solving.
       virtual void init_solving(Scalar* coeff_vec);
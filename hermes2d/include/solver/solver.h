@@ -80,6 +80,13 @@ namespace Hermes
       /// DiscreteProblemWeakForm helper.
       virtual void set_weak_formulation(WeakFormSharedPtr<Scalar> wf);
 
+      /// Number of threads used for assembling by this solver, see DiscreteProblem::set_num_threads().
+      void set_num_threads(int num_threads);
+
+      /// Statistics of the last assembling, see DiscreteProblem::get_assembly_statistics().
+      /// The statistics of the linear solves are in get_linear_matrix_solver()->get_statistics().
+      const AssemblyStatistics& get_assembly_statistics() const;
+
     protected:
       virtual bool isOkay() const;
 
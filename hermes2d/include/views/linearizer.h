@@ -62,6 +62,25 @@ namespace Hermes
         void save_solution_vtk(MeshFunctionSharedPtr<double> sln, const char* filename, const char* quantity_name, bool mode_3D = true, int item = H2D_FN_VAL_0);
         /// Save multiple MeshFunctions (Solutions, Filters) in VTK format.
         void save_solution_vtk(std::vector<MeshFunctionSharedPtr<double> > slns, std::vector<int> items, const char* filename, const char* quantity_name, bool mode_3D = true);
+        /// Save a MeshFunction (Solution, Filter) in the VTK XML format (.vtu).
+        /// The data are written in binary (appended section) directly from the linearized data, without any formatting.
+        /// \param[in] compress Compress the data by zlib, only available if Hermes is built WITH_ZLIB.
+        void save_solution_vtu(MeshFunctionSharedPtr<double> sln, const char* filename, const char* quantity_name, bool mode_3D = true, int item = H2D_FN_VAL_0, bool compress = false);
+        /// Save multiple MeshFunctions (Solutions, Filters) in the VTK XML format (.vtu).
+        void save_solution_vtu(std::vector<MeshFunctionSharedPtr<double> > slns, std::vector<int> items, const char* filename, const char* quantity_name, bool mode_3D = true, bool compress = false);
+        /// Save a MeshFunction (Solution, Filter) in the parallel VTK XML format (.pvtu).
+        /// Every thread writes the data it linearized to its own piece (filename without the extension + "_<thread>.vtu"),
+        /// the file filename only references the pieces.
+        void save_solution_pvtu(MeshFunctionSharedPtr<double> sln, const char* filename, const char* quantity_name, bool mode_3D = true, int item = H2D_FN_VAL_0, bool compress = false);
+        /// Save multiple MeshFunctions (Solutions, Filters) in the parallel VTK XML format (.pvtu).
+        void save_solution_pvtu(std::vector<MeshFunctionSharedPtr<double> > slns, std::vector<int> items, const char* filename, const char* quantity_name, bool mode_3D = true, bool compress = false);
+        /// Save a time step of a MeshFunction (Solution, Filter) to the .pvd time series filename.
+        /// The step is saved to filename without the extension + "_<step>.vtu", in 2D (the values are not used as the z-coordinate).
+        /// The topology is frozen (see set_frozen_topology()) and the geometry of the steps is only encoded once per topology.
+        /// Calling this with a different filename starts a new series.
+        void save_solution_pvd_step(MeshFunctionSharedPtr<double> sln, const char* filename, const char* quantity_name, double time, int item = H2D_FN_VAL_0, bool compress = false);
+        /// Save a time step of multiple MeshFunctions (Solutions, Filters) to the .pvd time series filename.
+        void save_solution_pvd_step(std::vector<MeshFunctionSharedPtr<double> > slns, std::vector<int> items, const char* filename, const char* quantity_name, double time, bool compress = false);
         /// Save a MeshFunction (Solution, Filter) in Tecplot format.
         void save_solution_tecplot(MeshFunctionSharedPtr<double> sln, const char* filename, const char* quantity_name, int item = H2D_FN_VAL_0);
         /// Save multiple MeshFunctions (Solutions, Filters) in Tecplot format.
@@ -72,6 +91,18 @@ namespace Hermes
         /// \param[in] criterion The instance of the criterion - see the class LinearizerCriterion for details (method split_decision() for the adaptive criterion, process_[triangle|quad] for the fixed one).
         void set_criterion(LinearizerCriterion criterion);
 
+        /// Freeze the linearized topology (only for FileExport).
+        /// The first processing records the refinement and the vertices, the following ones - as long as the meshes (seq),
+        /// the element orders of the solutions and the items stay the same - only re-evaluate the values in the recorded vertices.
+        /// Setting the criterion or the curvature epsilon records the topology again.
+        /// The vertex coordinates are frozen as well, i.e. the displacement is not re-evaluated.
+        void set_frozen_topology(bool frozen_topology = true);
+
+        /// Merge the vertices shared by the data of more threads (only for FileExport, default: true).
+        /// Without merging, vertices on the boundaries of the thread partitions are duplicated in the output.
+        /// Not used for the .pvtu output, whose pieces have to be independent.
+        void set_vertex_merging(bool vertex_merging = true);
+
         /// Set the displacement, i.e. set two functions that will deform the domain for visualization, in the x-direction, and the y-direction.
         void set_displacement(MeshFunctionSharedPtr<double> xdisp, MeshFunctionSharedPtr<double> ydisp, double dmult = 1.0);
 
@@ -163,6 +194,38 @@ namespace Hermes
 
         void init(MeshFunctionSharedPtr<double>* sln, int* item);
 
+        /// Writes the data of the thread linearizers [thread_from, thread_to) as one .vtu file.
+        /// \param[in] use_pvd_geometry Take the geometry arrays from (or store them to) pvd_geometry.
+        void save_vtu_piece(const char* filename, const char* quantity_name, bool mode_3D, bool compress, int thread_from, int thread_to, bool use_pvd_geometry = false);
+
+        /// Vertex merging.
+        bool vertex_merging;
+        /// Merges vertices of the thread linearizers, the result is the vertex data distributed over the threads as before,
+        /// without duplicates and with global (merged) triangle indices.
+        void merge_thread_vertices();
+
+        /// Frozen topology.
+        bool frozen_topology;
+        /// The thread linearizers hold a recorded topology.
+        bool topology_recorded;
+        /// The current processing reuses the recorded topology.
+        bool topology_reused;
+        /// What the recorded topology belongs to.
+        std::vector<unsigned> frozen_mesh_seqs;
+        std::vector<std::vector<int> > frozen_elem_orders;
+        int frozen_item[LinearizerDataDimensions::dimension];
+        bool frozen_vertex_merging;
+        /// Returns true if the recorded topology can be used for sln, item, otherwise stores sln, item as the owner of the topology to be recorded.
+        bool use_frozen_topology(MeshFunctionSharedPtr<double>* sln, int* item);
+
+        /// The current .pvd time series - file, (time, step file) pairs.
+        std::string pvd_filename;
+        std::vector<std::pair<double, std::string> > pvd_steps;
+        /// Appended section of the geometry arrays (points, connectivity, offsets, types) of the current topology, and their sizes.
+        std::vector<unsigned char> pvd_geometry;
+        size_t pvd_geometry_sizes[4];
+        bool pvd_geometry_compressed;
+
         std::vector<MeshSharedPtr> meshes;
 
         /// Standard and curvature epsilon.
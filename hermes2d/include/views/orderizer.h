@@ -18,6 +18,7 @@
 
 #include "../space/space.h"
 #include "global.h"
+#include "../mixins2d.h"
 #ifndef NOGLUT
 #include <pthread.h>
 #endif
@@ -33,7 +34,10 @@ namespace Hermes
       /// Like the Linearizer, but generates a triangular mesh showing polynomial
       /// orders in a space, hence the funky name.
       ///
-      class HERMES_API Orderizer
+      /// The elements are processed in parallel - the output of every element is a fixed (reference) tessellation,
+      /// so the output sizes are known before, and every element writes to its own part of the output arrays.
+      class HERMES_API Orderizer :
+        public Hermes::Hermes2D::Mixins::Parallel
       {
       public:
 
@@ -85,11 +89,9 @@ namespace Hermes
         int2* edges;
         /// edge_markers: edge markers, ordering equal to edges
         int* edge_markers;
-        void add_edge(int iv1, int iv2, int marker);
 
-        /// Reallocation at the beginning of process_*.
-        /// Specific for Linearizer
-        void reallocate(MeshSharedPtr mesh);
+        /// Reallocation at the beginning of process_*, to (at least) the given sizes.
+        void reallocate(int num_vertices, int num_triangles, int num_edges, int num_labels);
 
         char  buffer[1000];
         char* labels[11][11];
@@ -111,13 +113,7 @@ namespace Hermes
         /// Size of arrays of vertices, triangles and edges
         int vertex_size, triangle_size, edges_size;
 
-        void add_triangle(int iv0, int iv1, int iv2, int marker);
-
         static void calc_aabb(double* x, double* y, int stride, int num, double* min_x, double* max_x, double* min_y, double* max_y);
-
-        int add_vertex();
-
-        void make_vert(int & index, double x, double y, double val);
       };
     }
   }
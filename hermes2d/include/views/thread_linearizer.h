@@ -53,13 +53,23 @@ namespace Hermes
         void init_linearizer_data(LinearizerMultidimensional<LinearizerDataDimensions>* linearizer);
 
         /// Initialize arrays, clone functions etc for this run of processing.
-        void init_processing(MeshFunctionSharedPtr<double>* sln, LinearizerMultidimensional<LinearizerDataDimensions>* linearizer);
+        /// \param[in] reuse_topology Keep the data of the previous run (see reprocess_state()).
+        void init_processing(MeshFunctionSharedPtr<double>* sln, LinearizerMultidimensional<LinearizerDataDimensions>* linearizer, bool reuse_topology = false);
         /// Deinitialize the temporary data for this run of processing.
         void deinit_processing();
 
         /// Completely process the state current_state
         void process_state(Traverse::State* current_state);
 
+        /// Re-evaluate the values of the vertices of the state current_state only, using the frozen topology.
+        /// The states have to come in the same order as when the topology was recorded.
+        void reprocess_state(Traverse::State* current_state);
+        /// Recursive part of reprocess_state().
+        void reprocess_triangle(int level);
+        void reprocess_quad(int level);
+        /// Store the values at the point point_index of the current integration rule to the next frozen vertex.
+        void set_frozen_vertex_values(const double** values, unsigned short point_index);
+
         /// Return the hash value of the couple of vertices with indices p1, p2.
         int hash(int p1, int p2);
         /// Return the index of the vertex between vertices with indices p1, p2.
@@ -166,6 +176,27 @@ namespace Hermes
         /// Standard and curvature epsilon.
         double curvature_epsilon;
 
+        /// Frozen topology - record frozen_splits, frozen_vertices during processing.
+        bool record_topology;
+        /// Split decisions in the order of processing.
+        std::vector<unsigned char> frozen_splits;
+        /// Vertex indices returned by get_vertex() in the order of processing.
+        std::vector<int> frozen_vertices;
+        /// Positions in frozen_splits, frozen_vertices when reprocessing.
+        unsigned int frozen_split_position, frozen_vertex_position;
+
+        /// Merging of the vertices of all threads (see LinearizerMultidimensional::merge_thread_vertices()).
+        /// Calculates vertex_keys, uses info => has to be called before deinit_processing().
+        void calc_vertex_keys();
+        /// The vertex with index vertex_index is the same as vertex (position, values).
+        bool same_vertex(int vertex_index, const typename LinearizerDataDimensions::vertex_t& vertex) const;
+        /// Thread-independent keys of the vertices, built from the mesh node ids of the vertices they were created from.
+        std::vector<unsigned long long> vertex_keys;
+        /// (thread, vertex) representing the vertex in the merged data.
+        std::vector<std::pair<int, int> > vertex_representatives;
+        /// Indices of the vertices in the merged data.
+        std::vector<int> merged_vertex_indices;
+
         friend class LinearizerMultidimensional < LinearizerDataDimensions > ;
       };
     }
@@ -27,6 +27,7 @@ namespace Hermes
     template<typename Scalar> class DiscreteProblem;
     template<typename Scalar> class DiscreteProblemSelectiveAssembler;
     template<typename Scalar> class DiscreteProblemIntegrationOrderCalculator;
+    template<typename Scalar> class DiscreteProblemDGMatrixFree;
     template<typename Scalar> class RungeKutta;
     template<typename Scalar> class Space;
     template<typename Scalar> class MeshFunction;
@@ -243,6 +244,7 @@ namespace Hermes
       friend class DiscreteProblemThreadAssembler < Scalar > ;
       friend class DiscreteProblemIntegrationOrderCalculator < Scalar > ;
       friend class DiscreteProblemSelectiveAssembler < Scalar > ;
+      friend class DiscreteProblemDGMatrixFree < Scalar > ;
       friend class RungeKutta < Scalar > ;
       friend class OGProjection < Scalar > ;
       friend class Hermes::Preconditioners::Precond < Scalar > ;
@@ -297,6 +299,32 @@ namespace Hermes
       /// scaling factor
       void setScalingFactor(double scalingFactor);
 
+      /// Integration order control.
+      /// The order calculated from ord() (incl. the increase due to the reference mapping) is
+      /// - replaced by 'order' (if set, i.e. >= 0),
+      /// - shifted by 'offset' (may be negative),
+      /// - capped by 'cap' (if set, i.e. >= 0),
+      /// in this sequence, and only then limited by the order table (see set_order_limit_table()).
+      /// The element is still integrated with the highest order over all its forms, so the control only lowers the
+      /// order of an element if all forms on it agree. WeakForm::set_global_integration_order() takes precedence.
+      struct IntegrationOrderControl
+      {
+        IntegrationOrderControl();
+        int order;
+        int offset;
+        int cap;
+      };
+      /// Fixed integration order.
+      /// \param[in] area Element marker (boundary marker for surface forms) where the setting applies, HERMES_ANY for the default.
+      /// A marker-specific setting replaces the default one completely. DG forms only use the default.
+      void set_integration_order(int order, std::string area = HERMES_ANY);
+      /// Integration order offset, see set_integration_order() for 'area'.
+      void set_integration_order_offset(int offset, std::string area = HERMES_ANY);
+      /// Integration order cap, see set_integration_order() for 'area'.
+      void set_integration_order_cap(int cap, std::string area = HERMES_ANY);
+      /// Back to the automatic integration order everywhere.
+      void reset_integration_order_control();
+
       unsigned int i;
 
     protected:
@@ -328,6 +356,16 @@ namespace Hermes
       std::vector<MeshFunctionSharedPtr<Scalar> > ext;
       std::vector<UExtFunctionSharedPtr<Scalar> > u_ext_fn;
 
+      /// Integration order control - the default (HERMES_ANY) and the marker-specific settings.
+      IntegrationOrderControl integration_order_control;
+      std::map<std::string, IntegrationOrderControl> integration_order_controls;
+
+      /// Internal - integration_order_controls with internal markers, filled anew with every assembling.
+      std::map<int, IntegrationOrderControl> integration_order_controls_internal;
+
+      /// Apply the integration order control for the (internal) marker to the calculated order.
+      void adjust_integration_order(int& order, int marker) const;
+
       double get_current_stage_time() const;
 
       WeakForm<Scalar>* wf;
@@ -348,6 +386,7 @@ namespace Hermes
       friend class DiscreteProblemIntegrationOrderCalculator < Scalar > ;
       friend class DiscreteProblemSelectiveAssembler < Scalar > ;
       friend class DiscreteProblemThreadAssembler < Scalar > ;
+      friend class DiscreteProblemDGMatrixFree < Scalar > ;
     };
 
     /// \brief Abstract, base class for matrix form - i.e. a single integral in the bilinear form on the left hand side of the variational formulation of a (system of) PDE.<br>
@@ -390,6 +429,18 @@ namespace Hermes
         GeomVol<Hermes::Ord> *e, Func<Ord> **ext) const;
 
       virtual MatrixFormVol* clone() const;
+
+      /// The specialized assembly kernel (see AssemblyKernels) this form can be evaluated with.
+      /// If not HERMES_KERNEL_NONE, value() equals coefficient * (the kernel integral) on every element.
+      /// Returns HERMES_KERNEL_NONE - the generic path with value() - by default.
+      virtual AssemblyKernelType get_assembly_kernel(Scalar& coefficient) const;
+
+      /// Batched evaluation - the values of the (basis function, test function) pairs of the element at once,
+      /// values[i * stride + j] = value(n, wt, u_ext, u[j], v[i], e, ext) for the pairs with pairs[i * stride + j] set
+      /// (the others are not used), so that whatever does not depend on the pair (coefficients in the quadrature points) is evaluated once per element.
+      /// The assembler uses it instead of value() when it returns true. Returns false (not supported) by default.
+      virtual bool value_batch(int n, double *wt, Func<Scalar> **u_ext, Func<double> **u, unsigned int u_count, Func<double> **v, unsigned int v_count,
+        GeomVol<double> *e, Func<Scalar> **ext, const bool* pairs, Scalar* values, unsigned int stride) const;
     };
 
     /// \brief Abstract, base class for matrix Surface form - i.e. MatrixForm, where the integration is with respect to 1D-Lebesgue measure (element domain-boundary edges).
@@ -0,0 +1,714 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef __H2D_WEAKFORMS_EXPRESSIONS_H
+#define __H2D_WEAKFORMS_EXPRESSIONS_H
+
+#include "../weakform/weakform.h"
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    /* Weak forms written as expressions of the integrand, e.g.
+
+      TrialFunction u;
+      TestFunction v;
+      add_matrix_form(make_matrix_form_vol<double>(0, 0, grad(u) * grad(v) * coefficient(k) + u * v));
+      add_vector_form(make_vector_form_vol<double>(0, coefficient(f) * v));
+      add_matrix_form_DG(make_matrix_form_DG<double>(0, 0, -avg(grad(u)) * normal() * jump(v) + sigma * jump(u) * jump(v)));
+      add_vector_form_DG(make_vector_form_DG<double>(0, coefficient(g) * grad(v) * normal()));
+
+      The expression (expression templates) is compiled into the quadrature loop of the form - value() and ord() are generated,
+      the integration order is the one of the integrand (the same expression evaluated with Hermes::Ord).
+      Coefficients (Hermes2DFunction) are evaluated once per element in the quadrature points, not per (basis function, test function) pair,
+      and the matrix volumetric forms evaluate all the pairs of the element at once (MatrixFormVol::value_batch()).
+
+      Scalar expressions: u, v (values), coefficient(k), x(), y(), constants (double), jump(u), avg(u) (interface forms),
+      combined by +, - and *. Vector expressions: grad(u), grad(v), normal() (surface and interface forms), avg(grad(u)), jump(grad(u)),
+      multiplied by scalars; vector * vector is the dot product.
+      In the interface forms, jump(u) = u(central) - u(neighbor), avg(u) = (u(central) + u(neighbor)) / 2, normal() is the normal of the central element,
+      plain u, v are not allowed in the interface matrix forms. In the interface vector forms, v is the test function of the central element
+      (plain v, grad(v)).
+      The coefficient functions are not owned by the forms.
+    */
+    namespace WeakFormsExpressions
+    {
+#pragma region contexts
+      /// Type of the values of the expressions - Scalar for the values, Ord for the integration order.
+      template<typename Real, typename Scalar>
+      struct ExpressionValue
+      {
+        typedef Scalar type;
+      };
+
+      template<typename Scalar>
+      struct ExpressionValue < Hermes::Ord, Scalar >
+      {
+        typedef Hermes::Ord type;
+      };
+
+      /// What the expressions are evaluated with in a quadrature point.
+      /// Function is Func or DiscontinuousFunc (interface forms), Geometry is GeomVol, GeomSurf or InterfaceGeom.
+      template<typename RealType, typename Scalar, typename FunctionType, typename GeometryType>
+      struct ExpressionContext
+      {
+        typedef RealType Real;
+        typedef FunctionType Function;
+        typedef GeometryType Geometry;
+        typedef typename ExpressionValue<Real, Scalar>::type Value;
+
+        ExpressionContext(Function* u, Function* v, Geometry* e, const Value* coefficient_values, int n) :
+          u(u), v(v), e(e), coefficient_values(coefficient_values), n(n)
+        {
+        }
+
+        Function* u;
+        Function* v;
+        Geometry* e;
+        /// Coefficients in the quadrature points - coefficient_values[slot * n + i], nullptr for the integration order.
+        const Value* coefficient_values;
+        int n;
+      };
+
+      /// Value of a coefficient in a quadrature point - the precalculated one, or the order of the function.
+      template<typename Real>
+      struct CoefficientValue
+      {
+        template<typename Context, typename Scalar>
+        static typename Context::Value get(const Context& c, int slot, Hermes2DFunction<Scalar>* function, int i)
+        {
+          return c.coefficient_values[slot * c.n + i];
+        }
+      };
+
+      template<>
+      struct CoefficientValue < Hermes::Ord >
+      {
+        template<typename Context, typename Scalar>
+        static Hermes::Ord get(const Context& c, int slot, Hermes2DFunction<Scalar>* function, int i)
+        {
+          return function->value(c.e->x[i], c.e->y[i]);
+        }
+      };
+#pragma endregion
+
+#pragma region expressions
+      /// Scalar-valued expressions:
+      /// template<typename Context> typename Context::Value value(const Context& c, int i) const;
+      /// template<typename Scalar> void register_coefficients(std::vector<Hermes2DFunction<Scalar>*>& coefficients);
+      template<typename Derived>
+      struct ScalarExpression
+      {
+        const Derived& derived() const { return static_cast<const Derived&>(*this); }
+      };
+
+      /// Vector-valued expressions:
+      /// template<typename Context> void value(const Context& c, int i, typename Context::Value& x, typename Context::Value& y) const;
+      /// template<typename Scalar> void register_coefficients(std::vector<Hermes2DFunction<Scalar>*>& coefficients);
+      template<typename Derived>
+      struct VectorExpression
+      {
+        const Derived& derived() const { return static_cast<const Derived&>(*this); }
+      };
+
+      /// Expressions without coefficients.
+      struct CoefficientFree
+      {
+        template<typename Scalar>
+        void register_coefficients(std::vector<Hermes2DFunction<Scalar>*>& coefficients) {}
+      };
+
+      /// The basis function u.
+      struct TrialFunction : public ScalarExpression<TrialFunction>, public CoefficientFree
+      {
+        template<typename Context>
+        static typename Context::Function* function(const Context& c) { return c.u; }
+
+        template<typename Context>
+        typename Context::Value value(const Context& c, int i) const { return typename Context::Value(c.u->val[i]); }
+      };
+
+      /// The test function v.
+      struct TestFunction : public ScalarExpression<TestFunction>, public CoefficientFree
+      {
+        template<typename Context>
+        static typename Context::Function* function(const Context& c) { return c.v; }
+
+        template<typename Context>
+        typename Context::Value value(const Context& c, int i) const { return typename Context::Value(c.v->val[i]); }
+      };
+
+      /// Constant.
+      struct Constant : public ScalarExpression<Constant>, public CoefficientFree
+      {
+        Constant(double constant) : constant(constant) {}
+        double constant;
+
+        template<typename Context>
+        typename Context::Value value(const Context& c, int i) const { return typename Context::Value(constant); }
+      };
+
+      /// Physical coordinates.
+      struct CoordinateX : public ScalarExpression<CoordinateX>, public CoefficientFree
+      {
+        template<typename Context>
+        typename Context::Value value(const Context& c, int i) const { return typename Context::Value(c.e->x[i]); }
+      };
+
+      struct CoordinateY : public ScalarExpression<CoordinateY>, public CoefficientFree
+      {
+        template<typename Context>
+        typename Context::Value value(const Context& c, int i) const { return typename Context::Value(c.e->y[i]); }
+      };
+
+      /// Coefficient k(x, y), evaluated once per element in the quadrature points.
+      template<typename Scalar>
+      struct Coefficient : public ScalarExpression < Coefficient<Scalar> >
+      {
+        Coefficient(Hermes2DFunction<Scalar>* function) : function(function), slot(-1) {}
+        Hermes2DFunction<Scalar>* function;
+        /// Index in the coefficients of the form (the same function shares the slot).
+        int slot;
+
+        void register_coefficients(std::vector<Hermes2DFunction<Scalar>*>& coefficients)
+        {
+          for (slot = 0; slot < (int)coefficients.size(); slot++)
+            if (coefficients[slot] == function)
+              return;
+          coefficients.push_back(function);
+        }
+
+        template<typename Context>
+        typename Context::Value value(const Context& c, int i) const { return CoefficientValue<typename Context::Real>::get(c, slot, function, i); }
+      };
+
+      template<typename Left, typename Right>
+      struct Sum : public ScalarExpression < Sum<Left, Right> >
+      {
+        Sum(const Left& left, const Right& right) : left(left), right(right) {}
+        Left left;
+        Right right;
+
+        template<typename Scalar>
+        void register_coefficients(std::vector<Hermes2DFunction<Scalar>*>& coefficients) { left.register_coefficients(coefficients); right.register_coefficients(coefficients); }
+
+        template<typename Context>
+        typename Context::Value value(const Context& c, int i) const { return left.value(c, i) + right.value(c, i); }
+      };
+
+      template<typename Left, typename Right>
+      struct Difference : public ScalarExpression < Difference<Left, Right> >
+      {
+        Difference(const Left& left, const Right& right) : left(left), right(right) {}
+        Left left;
+        Right right;
+
+        template<typename Scalar>
+        void register_coefficients(std::vector<Hermes2DFunction<Scalar>*>& coefficients) { left.register_coefficients(coefficients); right.register_coefficients(coefficients); }
+
+        template<typename Context>
+        typename Context::Value value(const Context& c, int i) const { return left.value(c, i) - right.value(c, i); }
+      };
+
+      template<typename Left, typename Right>
+      struct Product : public ScalarExpression < Product<Left, Right> >
+      {
+        Product(const Left& left, const Right& right) : left(left), right(right) {}
+        Left left;
+        Right right;
+
+        template<typename Scalar>
+        void register_coefficients(std::vector<Hermes2DFunction<Scalar>*>& coefficients) { left.register_coefficients(coefficients); right.register_coefficients(coefficients); }
+
+        template<typename Context>
+        typename Context::Value value(const Context& c, int i) const { return left.value(c, i) * right.value(c, i); }
+      };
+
+      template<typename Operand>
+      struct Negation : public ScalarExpression < Negation<Operand> >
+      {
+        Negation(const Operand& operand) : operand(operand) {}
+        Operand operand;
+
+        template<typename Scalar>
+        void register_coefficients(std::vector<Hermes2DFunction<Scalar>*>& coefficients) { operand.register_coefficients(coefficients); }
+
+        template<typename Context>
+        typename Context::Value value(const Context& c, int i) const { return -operand.value(c, i); }
+      };
+
+      /// Gradient of the basis / test function.
+      template<typename Function>
+      struct Gradient : public VectorExpression < Gradient<Function> >, public CoefficientFree
+      {
+        template<typename Context>
+        void value(const Context& c, int i, typename Context::Value& x, typename Context::Value& y) const
+        {
+          x = typename Context::Value(Function::function(c)->dx[i]);
+          y = typename Context::Value(Function::function(c)->dy[i]);
+        }
+      };
+
+      /// Normal of the edge (surface and interface forms).
+      struct Normal : public VectorExpression<Normal>, public CoefficientFree
+      {
+        template<typename Context>
+        void value(const Context& c, int i, typename Context::Value& x, typename Context::Value& y) const
+        {
+          x = typename Context::Value(c.e->nx[i]);
+          y = typename Context::Value(c.e->ny[i]);
+        }
+      };
+
+      template<typename ScalarOperand, typename VectorOperand>
+      struct ScaledVector : public VectorExpression < ScaledVector<ScalarOperand, VectorOperand> >
+      {
+        ScaledVector(const ScalarOperand& scalar, const VectorOperand& vector) : scalar(scalar), vector(vector) {}
+        ScalarOperand scalar;
+        VectorOperand vector;
+
+        template<typename Scalar>
+        void register_coefficients(std::vector<Hermes2DFunction<Scalar>*>& coefficients) { scalar.register_coefficients(coefficients); vector.register_coefficients(coefficients); }
+
+        template<typename Context>
+        void value(const Context& c, int i, typename Context::Value& x, typename Context::Value& y) const
+        {
+          typename Context::Value factor = scalar.value(c, i);
+          vector.value(c, i, x, y);
+          x = factor * x;
+          y = factor * y;
+        }
+      };
+
+      template<typename Left, typename Right>
+      struct DotProduct : public ScalarExpression < DotProduct<Left, Right> >
+      {
+        DotProduct(const Left& left, const Right& right) : left(left), right(right) {}
+        Left left;
+        Right right;
+
+        template<typename Scalar>
+        void register_coefficients(std::vector<Hermes2DFunction<Scalar>*>& coefficients) { left.register_coefficients(coefficients); right.register_coefficients(coefficients); }
+
+        template<typename Context>
+        typename Context::Value value(const Context& c, int i) const
+        {
+          typename Context::Value left_x, left_y, right_x, right_y;
+          left.value(c, i, left_x, left_y);
+          right.value(c, i, right_x, right_y);
+          return left_x * right_x + left_y * right_y;
+        }
+      };
+
+      /// Interface forms - the central / neighbor element's values of a function (zero on the side out of its support).
+      template<typename Context, typename DiscontinuousFunction>
+      void side_values(const Context& c, DiscontinuousFunction* f, int i, bool gradient, typename Context::Value* central, typename Context::Value* neighbor)
+      {
+        typedef typename Context::Value Value;
+        if (f->fn_central)
+        {
+          central[0] = gradient ? Value(f->dx[i]) : Value(f->val[i]);
+          central[1] = gradient ? Value(f->dy[i]) : Value(0);
+        }
+        else
+          central[0] = central[1] = Value(0);
+
+        if (f->fn_neighbor)
+        {
+          neighbor[0] = gradient ? Value(f->dx_neighbor[i]) : Value(f->val_neighbor[i]);
+          neighbor[1] = gradient ? Value(f->dy_neighbor[i]) : Value(0);
+        }
+        else
+          neighbor[0] = neighbor[1] = Value(0);
+      }
+
+      template<typename Function>
+      struct Jump : public ScalarExpression < Jump<Function> >, public CoefficientFree
+      {
+        template<typename Context>
+        typename Context::Value value(const Context& c, int i) const
+        {
+          typename Context::Value central[2], neighbor[2];
+          side_values(c, Function::function(c), i, false, central, neighbor);
+          return central[0] - neighbor[0];
+        }
+      };
+
+      template<typename Function>
+      struct Average : public ScalarExpression < Average<Function> >, public CoefficientFree
+      {
+        template<typename Context>
+        typename Context::Value value(const Context& c, int i) const
+        {
+          typename Context::Value central[2], neighbor[2];
+          side_values(c, Function::function(c), i, false, central, neighbor);
+          return 0.5 * (central[0] + neighbor[0]);
+        }
+      };
+
+      template<typename Function>
+      struct GradientJump : public VectorExpression < GradientJump<Function> >, public CoefficientFree
+      {
+        template<typename Context>
+        void value(const Context& c, int i, typename Context::Value& x, typename Context::Value& y) const
+        {
+          typename Context::Value central[2], neighbor[2];
+          side_values(c, Function::function(c), i, true, central, neighbor);
+          x = central[0] - neighbor[0];
+          y = central[1] - neighbor[1];
+        }
+      };
+
+      template<typename Function>
+      struct GradientAverage : public VectorExpression < GradientAverage<Function> >, public CoefficientFree
+      {
+        template<typename Context>
+        void value(const Context& c, int i, typename Context::Value& x, typename Context::Value& y) const
+        {
+          typename Context::Value central[2], neighbor[2];
+          side_values(c, Function::function(c), i, true, central, neighbor);
+          x = 0.5 * (central[0] + neighbor[0]);
+          y = 0.5 * (central[1] + neighbor[1]);
+        }
+      };
+#pragma endregion
+
+#pragma region building blocks
+      inline Gradient<TrialFunction> grad(const TrialFunction&) { return Gradient<TrialFunction>(); }
+      inline Gradient<TestFunction> grad(const TestFunction&) { return Gradient<TestFunction>(); }
+      inline Normal normal() { return Normal(); }
+      inline CoordinateX x() { return CoordinateX(); }
+      inline CoordinateY y() { return CoordinateY(); }
+
+      template<typename Scalar>
+      Coefficient<Scalar> coefficient(Hermes2DFunction<Scalar>* function) { return Coefficient<Scalar>(function); }
+
+      inline Jump<TrialFunction> jump(const TrialFunction&) { return Jump<TrialFunction>(); }
+      inline Jump<TestFunction> jump(const TestFunction&) { return Jump<TestFunction>(); }
+      inline Average<TrialFunction> avg(const TrialFunction&) { return Average<TrialFunction>(); }
+      inline Average<TestFunction> avg(const TestFunction&) { return Average<TestFunction>(); }
+      template<typename Function>
+      GradientJump<Function> jump(const Gradient<Function>&) { return GradientJump<Function>(); }
+      template<typename Function>
+      GradientAverage<Function> avg(const Gradient<Function>&) { return GradientAverage<Function>(); }
+
+      template<typename Left, typename Right>
+      Sum<Left, Right> operator+(const ScalarExpression<Left>& left, const ScalarExpression<Right>& right) { return Sum<Left, Right>(left.derived(), right.derived()); }
+      template<typename Left, typename Right>
+      Difference<Left, Right> operator-(const ScalarExpression<Left>& left, const ScalarExpression<Right>& right) { return Difference<Left, Right>(left.derived(), right.derived()); }
+      template<typename Left, typename Right>
+      Product<Left, Right> operator*(const ScalarExpression<Left>& left, const ScalarExpression<Right>& right) { return Product<Left, Right>(left.derived(), right.derived()); }
+      template<typename Operand>
+      Negation<Operand> operator-(const ScalarExpression<Operand>& operand) { return Negation<Operand>(operand.derived()); }
+
+      template<typename Right>
+      Product<Constant, Right> operator*(double left, const ScalarExpression<Right>& right) { return Product<Constant, Right>(Constant(left), right.derived()); }
+      template<typename Left>
+      Product<Left, Constant> operator*(const ScalarExpression<Left>& left, double right) { return Product<Left, Constant>(left.derived(), Constant(right)); }
+
+      template<typename Left, typename Right>
+      ScaledVector<Left, Right> operator*(const ScalarExpression<Left>& left, const VectorExpression<Right>& right) { return ScaledVector<Left, Right>(left.derived(), right.derived()); }
+      template<typename Left, typename Right>
+      ScaledVector<Right, Left> operator*(const VectorExpression<Left>& left, const ScalarExpression<Right>& right) { return ScaledVector<Right, Left>(right.derived(), left.derived()); }
+      template<typename Right>
+      ScaledVector<Constant, Right> operator*(double left, const VectorExpression<Right>& right) { return ScaledVector<Constant, Right>(Constant(left), right.derived()); }
+      template<typename Operand>
+      ScaledVector<Constant, Operand> operator-(const VectorExpression<Operand>& operand) { return ScaledVector<Constant, Operand>(Constant(-1.), operand.derived()); }
+
+      template<typename Left, typename Right>
+      DotProduct<Left, Right> operator*(const VectorExpression<Left>& left, const VectorExpression<Right>& right) { return DotProduct<Left, Right>(left.derived(), right.derived()); }
+#pragma endregion
+
+#pragma region integration
+      /// The quadrature sum of the expression.
+      template<typename Expression, typename Context>
+      typename Context::Value integrate(const Expression& expression, int n, double* wt, const Context& c)
+      {
+        typename Context::Value result = typename Context::Value(0);
+        for (int i = 0; i < n; i++)
+          result += wt[i] * expression.value(c, i);
+        return result;
+      }
+
+      /// The coefficients in the quadrature points, values[slot * n + i].
+      template<typename Scalar, typename Geometry>
+      void evaluate_coefficients(const std::vector<Hermes2DFunction<Scalar>*>& coefficients, int n, Geometry* e, std::vector<Scalar>& values)
+      {
+        values.resize(coefficients.size() * n);
+        for (unsigned int slot = 0; slot < coefficients.size(); slot++)
+          for (int i = 0; i < n; i++)
+            values[slot * n + i] = coefficients[slot]->value(e->x[i], e->y[i]);
+      }
+
+      /// Shared part of the forms - the expression and its coefficients.
+      template<typename Scalar, typename Expression>
+      class ExpressionFormData
+      {
+      protected:
+        ExpressionFormData(const Expression& expression) : expression(expression)
+        {
+          this->expression.register_coefficients(this->coefficients);
+        }
+
+        Expression expression;
+        std::vector<Hermes2DFunction<Scalar>*> coefficients;
+        /// Per-thread (the forms are cloned for the assembling threads).
+        mutable std::vector<Scalar> coefficient_values;
+      };
+#pragma endregion
+
+#pragma region forms
+      template<typename Scalar, typename Expression>
+      class ExpressionMatrixFormVol : public MatrixFormVol<Scalar>, public ExpressionFormData < Scalar, Expression >
+      {
+      public:
+        ExpressionMatrixFormVol(unsigned int i, unsigned int j, const Expression& expression, std::string area = HERMES_ANY, SymFlag sym = HERMES_NONSYM) :
+          MatrixFormVol<Scalar>(i, j), ExpressionFormData<Scalar, Expression>(expression)
+        {
+          this->set_area(area);
+          this->setSymFlag(sym);
+        }
+
+        virtual Scalar value(int n, double *wt, Func<Scalar> **u_ext, Func<double> *u, Func<double> *v,
+          GeomVol<double> *e, Func<Scalar> **ext) const
+        {
+          evaluate_coefficients(this->coefficients, n, e, this->coefficient_values);
+          ExpressionContext<double, Scalar, Func<double>, GeomVol<double> > c(u, v, e, this->coefficient_values.data(), n);
+          return integrate(this->expression, n, wt, c);
+        }
+
+        virtual Hermes::Ord ord(int n, double *wt, Func<Hermes::Ord> **u_ext, Func<Hermes::Ord> *u, Func<Hermes::Ord> *v,
+          GeomVol<Hermes::Ord> *e, Func<Ord> **ext) const
+        {
+          ExpressionContext<Hermes::Ord, Scalar, Func<Hermes::Ord>, GeomVol<Hermes::Ord> > c(u, v, e, nullptr, n);
+          return integrate(this->expression, n, wt, c);
+        }
+
+        virtual bool value_batch(int n, double *wt, Func<Scalar> **u_ext, Func<double> **u, unsigned int u_count, Func<double> **v, unsigned int v_count,
+          GeomVol<double> *e, Func<Scalar> **ext, const bool* pairs, Scalar* values, unsigned int stride) const
+        {
+          evaluate_coefficients(this->coefficients, n, e, this->coefficient_values);
+          ExpressionContext<double, Scalar, Func<double>, GeomVol<double> > c(nullptr, nullptr, e, this->coefficient_values.data(), n);
+          for (unsigned int i = 0; i < v_count; i++)
+          {
+            c.v = v[i];
+            for (unsigned int j = 0; j < u_count; j++)
+            {
+              if (!pairs[i * stride + j])
+                continue;
+              c.u = u[j];
+              values[i * stride + j] = integrate(this->expression, n, wt, c);
+            }
+          }
+          return true;
+        }
+
+        virtual MatrixFormVol<Scalar>* clone() const
+        {
+          return new ExpressionMatrixFormVol<Scalar, Expression>(*this);
+        }
+      };
+
+      template<typename Scalar, typename Expression>
+      class ExpressionMatrixFormSurf : public MatrixFormSurf<Scalar>, public ExpressionFormData < Scalar, Expression >
+      {
+      public:
+        ExpressionMatrixFormSurf(unsigned int i, unsigned int j, const Expression& expression, std::string area = HERMES_ANY) :
+          MatrixFormSurf<Scalar>(i, j), ExpressionFormData<Scalar, Expression>(expression)
+        {
+          this->set_area(area);
+        }
+
+        virtual Scalar value(int n, double *wt, Func<Scalar> **u_ext, Func<double> *u, Func<double> *v,
+          GeomSurf<double> *e, Func<Scalar> **ext) const
+        {
+          evaluate_coefficients(this->coefficients, n, e, this->coefficient_values);
+          ExpressionContext<double, Scalar, Func<double>, GeomSurf<double> > c(u, v, e, this->coefficient_values.data(), n);
+          return integrate(this->expression, n, wt, c);
+        }
+
+        virtual Hermes::Ord ord(int n, double *wt, Func<Hermes::Ord> **u_ext, Func<Hermes::Ord> *u, Func<Hermes::Ord> *v,
+          GeomSurf<Hermes::Ord> *e, Func<Ord> **ext) const
+        {
+          ExpressionContext<Hermes::Ord, Scalar, Func<Hermes::Ord>, GeomSurf<Hermes::Ord> > c(u, v, e, nullptr, n);
+          return integrate(this->expression, n, wt, c);
+        }
+
+        virtual MatrixFormSurf<Scalar>* clone() const
+        {
+          return new ExpressionMatrixFormSurf<Scalar, Expression>(*this);
+        }
+      };
+
+      template<typename Scalar, typename Expression>
+      class ExpressionMatrixFormDG : public MatrixFormDG<Scalar>, public ExpressionFormData < Scalar, Expression >
+      {
+      public:
+        ExpressionMatrixFormDG(unsigned int i, unsigned int j, const Expression& expression) :
+          MatrixFormDG<Scalar>(i, j), ExpressionFormData<Scalar, Expression>(expression)
+        {
+        }
+
+        virtual Scalar value(int n, double *wt, DiscontinuousFunc<Scalar> **u_ext, DiscontinuousFunc<double> *u, DiscontinuousFunc<double> *v,
+          InterfaceGeom<double> *e, DiscontinuousFunc<Scalar> **ext) const
+        {
+          evaluate_coefficients(this->coefficients, n, e, this->coefficient_values);
+          ExpressionContext<double, Scalar, DiscontinuousFunc<double>, InterfaceGeom<double> > c(u, v, e, this->coefficient_values.data(), n);
+          return integrate(this->expression, n, wt, c);
+        }
+
+        virtual Hermes::Ord ord(int n, double *wt, DiscontinuousFunc<Hermes::Ord> **u_ext, DiscontinuousFunc<Hermes::Ord> *u, DiscontinuousFunc<Hermes::Ord> *v,
+          InterfaceGeom<Hermes::Ord> *e, DiscontinuousFunc<Ord> **ext) const
+        {
+          ExpressionContext<Hermes::Ord, Scalar, DiscontinuousFunc<Hermes::Ord>, InterfaceGeom<Hermes::Ord> > c(u, v, e, nullptr, n);
+          return integrate(this->expression, n, wt, c);
+        }
+
+        virtual MatrixFormDG<Scalar>* clone() const
+        {
+          return new ExpressionMatrixFormDG<Scalar, Expression>(*this);
+        }
+      };
+
+      template<typename Scalar, typename Expression>
+      class ExpressionVectorFormVol : public VectorFormVol<Scalar>, public ExpressionFormData < Scalar, Expression >
+      {
+      public:
+        ExpressionVectorFormVol(unsigned int i, const Expression& expression, std::string area = HERMES_ANY) :
+          VectorFormVol<Scalar>(i), ExpressionFormData<Scalar, Expression>(expression)
+        {
+          this->set_area(area);
+        }
+
+        virtual Scalar value(int n, double *wt, Func<Scalar> **u_ext, Func<double> *v, GeomVol<double> *e, Func<Scalar> **ext) const
+        {
+          evaluate_coefficients(this->coefficients, n, e, this->coefficient_values);
+          ExpressionContext<double, Scalar, Func<double>, GeomVol<double> > c(nullptr, v, e, this->coefficient_values.data(), n);
+          return integrate(this->expression, n, wt, c);
+        }
+
+        virtual Hermes::Ord ord(int n, double *wt, Func<Hermes::Ord> **u_ext, Func<Hermes::Ord> *v, GeomVol<Hermes::Ord> *e, Func<Ord> **ext) const
+        {
+          ExpressionContext<Hermes::Ord, Scalar, Func<Hermes::Ord>, GeomVol<Hermes::Ord> > c(nullptr, v, e, nullptr, n);
+          return integrate(this->expression, n, wt, c);
+        }
+
+        virtual VectorFormVol<Scalar>* clone() const
+        {
+          return new ExpressionVectorFormVol<Scalar, Expression>(*this);
+        }
+      };
+
+      template<typename Scalar, typename Expression>
+      class ExpressionVectorFormSurf : public VectorFormSurf<Scalar>, public ExpressionFormData < Scalar, Expression >
+      {
+      public:
+        ExpressionVectorFormSurf(unsigned int i, const Expression& expression, std::string area = HERMES_ANY) :
+          VectorFormSurf<Scalar>(i), ExpressionFormData<Scalar, Expression>(expression)
+        {
+          this->set_area(area);
+        }
+
+        virtual Scalar value(int n, double *wt, Func<Scalar> **u_ext, Func<double> *v, GeomSurf<double> *e, Func<Scalar> **ext) const
+        {
+          evaluate_coefficients(this->coefficients, n, e, this->coefficient_values);
+          ExpressionContext<double, Scalar, Func<double>, GeomSurf<double> > c(nullptr, v, e, this->coefficient_values.data(), n);
+          return integrate(this->expression, n, wt, c);
+        }
+
+        virtual Hermes::Ord ord(int n, double *wt, Func<Hermes::Ord> **u_ext, Func<Hermes::Ord> *v, GeomSurf<Hermes::Ord> *e, Func<Ord> **ext) const
+        {
+          ExpressionContext<Hermes::Ord, Scalar, Func<Hermes::Ord>, GeomSurf<Hermes::Ord> > c(nullptr, v, e, nullptr, n);
+          return integrate(this->expression, n, wt, c);
+        }
+
+        virtual VectorFormSurf<Scalar>* clone() const
+        {
+          return new ExpressionVectorFormSurf<Scalar, Expression>(*this);
+        }
+      };
+
+      template<typename Scalar, typename Expression>
+      class ExpressionVectorFormDG : public VectorFormDG<Scalar>, public ExpressionFormData < Scalar, Expression >
+      {
+      public:
+        ExpressionVectorFormDG(unsigned int i, const Expression& expression) :
+          VectorFormDG<Scalar>(i), ExpressionFormData<Scalar, Expression>(expression)
+        {
+        }
+
+        virtual Scalar value(int n, double *wt, DiscontinuousFunc<Scalar> **u_ext, Func<double> *v, InterfaceGeom<double> *e,
+          DiscontinuousFunc<Scalar> **ext) const
+        {
+          evaluate_coefficients(this->coefficients, n, e, this->coefficient_values);
+          ExpressionContext<double, Scalar, Func<double>, InterfaceGeom<double> > c(nullptr, v, e, this->coefficient_values.data(), n);
+          return integrate(this->expression, n, wt, c);
+        }
+
+        virtual Hermes::Ord ord(int n, double *wt, DiscontinuousFunc<Hermes::Ord> **u_ext, Func<Hermes::Ord> *v, InterfaceGeom<Hermes::Ord> *e,
+          DiscontinuousFunc<Ord> **ext) const
+        {
+          ExpressionContext<Hermes::Ord, Scalar, Func<Hermes::Ord>, InterfaceGeom<Hermes::Ord> > c(nullptr, v, e, nullptr, n);
+          return integrate(this->expression, n, wt, c);
+        }
+
+        virtual VectorFormDG<Scalar>* clone() const
+        {
+          return new ExpressionVectorFormDG<Scalar, Expression>(*this);
+        }
+      };
+
+      /// Form factories deducing the expression type.
+      template<typename Scalar, typename Expression>
+      MatrixFormVol<Scalar>* make_matrix_form_vol(unsigned int i, unsigned int j, const ScalarExpression<Expression>& expression, std::string area = HERMES_ANY, SymFlag sym = HERMES_NONSYM)
+      {
+        return new ExpressionMatrixFormVol<Scalar, Expression>(i, j, expression.derived(), area, sym);
+      }
+
+      template<typename Scalar, typename Expression>
+      MatrixFormSurf<Scalar>* make_matrix_form_surf(unsigned int i, unsigned int j, const ScalarExpression<Expression>& expression, std::string area = HERMES_ANY)
+      {
+        return new ExpressionMatrixFormSurf<Scalar, Expression>(i, j, expression.derived(), area);
+      }
+
+      template<typename Scalar, typename Expression>
+      MatrixFormDG<Scalar>* make_matrix_form_DG(unsigned int i, unsigned int j, const ScalarExpression<Expression>& expression)
+      {
+        return new ExpressionMatrixFormDG<Scalar, Expression>(i, j, expression.derived());
+      }
+
+      template<typename Scalar, typename Expression>
+      VectorFormVol<Scalar>* make_vector_form_vol(unsigned int i, const ScalarExpression<Expression>& expression, std::string area = HERMES_ANY)
+      {
+        return new ExpressionVectorFormVol<Scalar, Expression>(i, expression.derived(), area);
+      }
+
+      template<typename Scalar, typename Expression>
+      VectorFormSurf<Scalar>* make_vector_form_surf(unsigned int i, const ScalarExpression<Expression>& expression, std::string area = HERMES_ANY)
+      {
+        return new ExpressionVectorFormSurf<Scalar, Expression>(i, expression.derived(), area);
+      }
+
+      template<typename Scalar, typename Expression>
+      VectorFormDG<Scalar>* make_vector_form_DG(unsigned int i, const ScalarExpression<Expression>& expression)
+      {
+        return new ExpressionVectorFormDG<Scalar, Expression>(i, expression.derived());
+      }
+#pragma endregion
+    }
+  }
+}
+#endif
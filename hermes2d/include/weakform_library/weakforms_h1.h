@@ -52,6 +52,9 @@ namespace Hermes
 
         virtual MatrixFormVol<Scalar>* clone() const;
 
+        /// Planar forms with a constant coefficient (exact type only, descendants may override value()).
+        virtual AssemblyKernelType get_assembly_kernel(Scalar& coefficient) const;
+
       private:
 
         Hermes2DFunction<Scalar>* coeff;
@@ -111,6 +114,9 @@ namespace Hermes
 
         virtual MatrixFormVol<Scalar>* clone() const;
 
+        /// Planar forms (exact type only, descendants may override value()).
+        virtual AssemblyKernelType get_assembly_kernel(Scalar& coefficient) const;
+
       private:
         Hermes1DFunction<Scalar>* coeff;
         bool own_coeff;
@@ -833,6 +833,43 @@ namespace Hermes
                 unsigned int gto, gfrom;
               };
 
+              /// The fission operator F of the k-eigenvalue problem L phi = 1/k F phi (the Jacobian with the opposite sign),
+              /// see CompleteWeakForms::Diffusion::DefaultWeakFormFissionOperator.
+              template<typename Scalar>
+              class HERMES_API Production : public Jacobian < Scalar >
+              {
+              public:
+
+                Production(unsigned int gto, unsigned int gfrom,
+                  const MaterialPropertyMaps& matprop, GeomType geom_type = HERMES_PLANAR)
+                  : Jacobian<Scalar>(gto, gfrom, matprop, geom_type)
+                {};
+
+                Production(unsigned int gto, unsigned int gfrom, std::string area,
+                  const MaterialPropertyMaps& matprop, GeomType geom_type = HERMES_PLANAR)
+                  : Jacobian<Scalar>(gto, gfrom, area, matprop, geom_type)
+                {};
+
+                Production(unsigned int gto, unsigned int gfrom,
+                  const MaterialPropertyMaps& matprop, MeshSharedPtr mesh, GeomType geom_type = HERMES_PLANAR)
+                  : Jacobian<Scalar>(gto, gfrom, matprop, mesh, geom_type)
+                {};
+
+                Production(unsigned int gto, unsigned int gfrom, std::string area,
+                  const MaterialPropertyMaps& matprop, MeshSharedPtr mesh, GeomType geom_type = HERMES_PLANAR)
+                  : Jacobian<Scalar>(gto, gfrom, area, matprop, mesh, geom_type)
+                {};
+
+                virtual Scalar value(int n, double *wt, Func<Scalar> *u_ext[], Func<double> *u,
+                  Func<double> *v, GeomVol<double> *e, Func<Scalar> **ext) const {
+                  return this->template matrix_form<double, Scalar>(n, wt, u_ext, u, v, e, ext);
+                }
+
+                virtual MatrixFormVol<Scalar>* clone() const {
+                  return new Production(*this);
+                }
+              };
+
               template<typename Scalar>
               class HERMES_API OuterIterationForm : public VectorFormVol<Scalar>, protected GenericForm
               {
@@ -1204,6 +1241,9 @@ namespace Hermes
                 GeomType geom_type = HERMES_PLANAR);
             };
 
+            /// Plain power (source) iteration: every outer iteration assembles and solves the whole system with the fission
+            /// source of the previous iterates (update_keff()). For many outer iterations, use KeffEigenvalueSolver
+            /// with DefaultWeakFormLossOperator and DefaultWeakFormFissionOperator instead.
             template<typename Scalar>
             class HERMES_API DefaultWeakFormSourceIteration : public WeakForm < Scalar >
             {
@@ -1221,6 +1261,25 @@ namespace Hermes
               /// get over it.
               double get_keff() { return 0.0; };
             };
+
+            /// The loss operator L (diffusion, removal and scattering) of the k-eigenvalue problem L phi = 1/k F phi,
+            /// for KeffEigenvalueSolver. Boundary conditions (e.g. VacuumBoundaryCondition::Jacobian) are to be added by the user.
+            template<typename Scalar>
+            class HERMES_API DefaultWeakFormLossOperator : public WeakForm < Scalar >
+            {
+            public:
+              DefaultWeakFormLossOperator(const MaterialPropertyMaps& matprop, MeshSharedPtr mesh,
+                GeomType geom_type = HERMES_PLANAR);
+            };
+
+            /// The fission operator F of the k-eigenvalue problem L phi = 1/k F phi, for KeffEigenvalueSolver.
+            template<typename Scalar>
+            class HERMES_API DefaultWeakFormFissionOperator : public WeakForm < Scalar >
+            {
+            public:
+              DefaultWeakFormFissionOperator(const MaterialPropertyMaps& matprop, MeshSharedPtr mesh,
+                GeomType geom_type = HERMES_PLANAR);
+            };
           }
         }
 
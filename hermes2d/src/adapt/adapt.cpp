@@ -256,6 +256,7 @@ namespace Hermes
     template<typename Scalar>
     bool Adapt<Scalar>::adapt(std::vector<RefinementSelectors::Selector<Scalar> *> refinement_selectors)
     {
+      HERMES_PROFILE_REGION("Adapt::adapt");
       // Initialize.
       MeshSharedPtr meshes[H2D_MAX_COMPONENTS];
       ElementToRefine** element_refinement_location[H2D_MAX_COMPONENTS];
@@ -295,6 +296,7 @@ namespace Hermes
       // Parallel section
 #pragma omp parallel num_threads(this->num_threads_used)
       {
+        HERMES_PROFILE_REGION("Adapt::select_refinements");
         int thread_number = omp_get_thread_num();
         int start = (attempted_element_refinements_count / this->num_threads_used) * thread_number;
         int end = (attempted_element_refinements_count / this->num_threads_used) * (thread_number + 1);
@@ -304,7 +306,12 @@ namespace Hermes
         // rslns cloning.
         std::vector<MeshFunctionSharedPtr<Scalar> > current_rslns;
         for (unsigned int i = 0; i < this->num; i++)
+        {
           current_rslns.push_back(rslns[i]->clone());
+          Solution<Scalar>* cloned_solution = dynamic_cast<Solution<Scalar>*>(current_rslns[i].get());
+          if (cloned_solution)
+            cloned_solution->set_memory_category(memoryAdaptClones);
+        }
 
         for (int id_to_refine = start; id_to_refine < end; id_to_refine++)
         {
@@ -640,6 +647,7 @@ namespace Hermes
     template<typename Scalar>
     void Adapt<Scalar>::apply_refinements(ElementToRefine* elems_to_refine, int num_elem_to_process)
     {
+      HERMES_PROFILE_REGION("Adapt::apply_refinements");
       for (int i = 0; i < num_elem_to_process; i++)
         apply_refinement(elems_to_refine[i]);
     }
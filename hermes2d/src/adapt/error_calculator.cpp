@@ -153,6 +153,7 @@ namespace Hermes
     template<typename Scalar>
     void ErrorCalculator<Scalar>::calculate_errors(std::vector<MeshFunctionSharedPtr<Scalar> > coarse_solutions_, std::vector<MeshFunctionSharedPtr<Scalar> > fine_solutions_, bool sort_and_store)
     {
+      HERMES_PROFILE_REGION("ErrorCalculator::calculate_errors");
       this->coarse_solutions = coarse_solutions_;
       this->fine_solutions = fine_solutions_;
       this->component_count = this->coarse_solutions.size();
@@ -181,6 +182,7 @@ namespace Hermes
         if (thread_number == this->num_threads_used - 1)
           end = num_states;
 
+        HERMES_PROFILE_REGION("ErrorCalculator::evaluate_states");
         try
         {
           // Create a calculator for this thread.
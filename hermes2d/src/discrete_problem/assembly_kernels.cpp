@@ -0,0 +1,89 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "discrete_problem/assembly_kernels.h"
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    // The sums run in the order of the generic forms (DefaultMatrixFormVol, DefaultMatrixFormDiffusion),
+    // so that the results are the same.
+    template<int num_points>
+    static double mass_kernel(const double* jacobian_x_weights, const Func<double>* u, const Func<double>* v)
+    {
+      double result = 0.;
+      for (int i = 0; i < num_points; i++)
+        result += jacobian_x_weights[i] * u->val[i] * v->val[i];
+      return result;
+    }
+
+    template<int num_points>
+    static double diffusion_kernel(const double* jacobian_x_weights, const Func<double>* u, const Func<double>* v)
+    {
+      double result = 0.;
+      for (int i = 0; i < num_points; i++)
+        result += jacobian_x_weights[i] * (u->dx[i] * v->dx[i] + u->dy[i] * v->dy[i]);
+      return result;
+    }
+
+    // Instantiates the kernels for num_points, num_points - 1, ..., 1.
+    template<int num_points>
+    struct AssemblyKernelsFill
+    {
+      static void fill(AssemblyKernels::MatrixKernel kernels[HERMES_KERNEL_COUNT][H2D_ASSEMBLY_KERNEL_MAX_POINTS + 1])
+      {
+        kernels[HERMES_KERNEL_MASS][num_points] = &mass_kernel<num_points>;
+        kernels[HERMES_KERNEL_DIFFUSION][num_points] = &diffusion_kernel<num_points>;
+        AssemblyKernelsFill<num_points - 1>::fill(kernels);
+      }
+    };
+
+    template<>
+    struct AssemblyKernelsFill<0>
+    {
+      static void fill(AssemblyKernels::MatrixKernel kernels[HERMES_KERNEL_COUNT][H2D_ASSEMBLY_KERNEL_MAX_POINTS + 1])
+      {
+        for (int type = 0; type < HERMES_KERNEL_COUNT; type++)
+          kernels[type][0] = nullptr;
+      }
+    };
+
+    AssemblyKernels::AssemblyKernels()
+    {
+      AssemblyKernelsFill<H2D_ASSEMBLY_KERNEL_MAX_POINTS>::fill(this->kernels);
+    }
+
+    const AssemblyKernels& AssemblyKernels::get_instance()
+    {
+      static AssemblyKernels instance;
+      return instance;
+    }
+
+    AssemblyKernels::MatrixKernel AssemblyKernels::get_matrix_kernel(AssemblyKernelType type, int num_points)
+    {
+      if (type == HERMES_KERNEL_NONE || num_points <= 0 || num_points > H2D_ASSEMBLY_KERNEL_MAX_POINTS)
+        return nullptr;
+      return get_instance().kernels[type][num_points];
+    }
+
+    AssemblyKernels::MatrixKernel AssemblyKernels::get_matrix_kernel(AssemblyKernelType type, ElementMode2D mode, int order, Quad2D* quad)
+    {
+      if (order < 0 || order > quad->get_max_order(mode))
+        return nullptr;
+      return get_matrix_kernel(type, quad->get_num_points(order, mode));
+    }
+  }
+}
@@ -0,0 +1,86 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "discrete_problem/assembly_statistics.h"
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    AssemblyCounters::AssemblyCounters() : states(0), form_evaluations(0), kernel_evaluations(0), quadrature_points(0), inserted_nonzeros(0), precalc_hits(0), precalc_misses(0), time(0.)
+    {
+    }
+
+    void AssemblyCounters::add(const AssemblyCounters& other)
+    {
+      this->states += other.states;
+      if (this->states_per_order.size() < other.states_per_order.size())
+        this->states_per_order.resize(other.states_per_order.size(), 0);
+      for (unsigned int order = 0; order < other.states_per_order.size(); order++)
+        this->states_per_order[order] += other.states_per_order[order];
+      this->form_evaluations += other.form_evaluations;
+      this->kernel_evaluations += other.kernel_evaluations;
+      this->quadrature_points += other.quadrature_points;
+      this->inserted_nonzeros += other.inserted_nonzeros;
+      this->precalc_hits += other.precalc_hits;
+      this->precalc_misses += other.precalc_misses;
+      this->time += other.time;
+    }
+
+    AssemblyStatistics::AssemblyStatistics() : structural_nonzeros(0)
+    {
+    }
+
+    double AssemblyStatistics::get_load_imbalance() const
+    {
+      double max_time = 0., sum_time = 0.;
+      for (unsigned int thread_i = 0; thread_i < this->threads.size(); thread_i++)
+      {
+        max_time = std::max(max_time, this->threads[thread_i].time);
+        sum_time += this->threads[thread_i].time;
+      }
+      if (sum_time <= 0.)
+        return 0.;
+      return max_time / (sum_time / this->threads.size());
+    }
+
+    double AssemblyStatistics::get_precalc_hit_rate() const
+    {
+      unsigned long long lookups = this->precalc_hits + this->precalc_misses;
+      return lookups > 0 ? (double)this->precalc_hits / (double)lookups : 0.;
+    }
+
+    void AssemblyStatistics::dump(FILE* out) const
+    {
+      fprintf(out, "Assembling: %u states, %llu form evaluations, %llu quadrature points, %.3f s.\n", this->states, this->form_evaluations, this->quadrature_points, this->time);
+      fprintf(out, "\tSpecialized kernels: %llu form evaluations.\n", this->kernel_evaluations);
+      fprintf(out, "\tMatrix: %llu inserted entries, %llu structural nonzeros.\n", this->inserted_nonzeros, this->structural_nonzeros);
+      fprintf(out, "\tPrecalculated shape function tables: %llu hits, %llu misses (%.1f%% hits).\n", this->precalc_hits, this->precalc_misses, 100. * this->get_precalc_hit_rate());
+
+      fprintf(out, "\tStates per integration order:");
+      for (unsigned int order = 0; order < this->states_per_order.size(); order++)
+        if (this->states_per_order[order] > 0)
+          fprintf(out, " %u: %u", order, this->states_per_order[order]);
+      fprintf(out, "\n");
+
+      fprintf(out, "\tThreads (load imbalance %.2f):\n", this->get_load_imbalance());
+      for (unsigned int thread_i = 0; thread_i < this->threads.size(); thread_i++)
+      {
+        const AssemblyCounters& thread = this->threads[thread_i];
+        fprintf(out, "\t\tthread %u: %u states, %llu form evaluations, %llu quadrature points, %.3f s.\n", thread_i, thread.states, thread.form_evaluations, thread.quadrature_points, thread.time);
+      }
+    }
+  }
+}
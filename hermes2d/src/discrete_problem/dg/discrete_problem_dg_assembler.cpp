@@ -31,9 +31,10 @@ namespace Hermes
     unsigned int DiscreteProblemDGAssembler<Scalar>::dg_order = 20;
 
     template<typename Scalar>
-    DiscreteProblemDGAssembler<Scalar>::DiscreteProblemDGAssembler(DiscreteProblemThreadAssembler<Scalar>* threadAssembler, const std::vector<SpaceSharedPtr<Scalar> > spaces, std::vector<MeshSharedPtr>& meshes)
+    DiscreteProblemDGAssembler<Scalar>::DiscreteProblemDGAssembler(DiscreteProblemThreadAssembler<Scalar>* threadAssembler, const std::vector<SpaceSharedPtr<Scalar> > spaces, std::vector<MeshSharedPtr>& meshes, omp_lock_t* visited_lock)
       : pss(threadAssembler->pss),
       refmaps(threadAssembler->refmaps),
+      quad_2d(threadAssembler->quad_2d),
       u_ext(threadAssembler->u_ext),
       fns(threadAssembler->fns),
       wf(threadAssembler->wf),
@@ -44,7 +45,10 @@ namespace Hermes
       current_state(nullptr),
       selectiveAssembler(threadAssembler->selectiveAssembler),
       spaces(spaces),
-      meshes(meshes)
+      meshes(meshes),
+      visited_lock(visited_lock),
+      arena(&threadAssembler->arena),
+      statistics(&threadAssembler->statistics)
     {
       this->DG_matrix_forms_present = false;
       this->DG_vector_forms_present = false;
@@ -97,18 +101,18 @@ namespace Hermes
     {
       this->current_state = current_state_;
 
-      this->neighbor_searches = new NeighborSearch<Scalar>**[this->current_state->rep->nvert];
+      this->neighbor_searches = arena->allocate_array<NeighborSearch<Scalar>**>(this->current_state->rep->nvert);
       for (int i = 0; i < this->current_state->rep->nvert; i++)
-        this->neighbor_searches[i] = new NeighborSearch<Scalar>*[this->current_state->num];
-      this->num_neighbors = new unsigned int[this->current_state->rep->nvert];
-      processed = new bool*[current_state->rep->nvert];
+        this->neighbor_searches[i] = arena->allocate_array<NeighborSearch<Scalar>*>(this->current_state->num);
+      this->num_neighbors = arena->calloc_array<unsigned int>(this->current_state->rep->nvert);
+      processed = arena->calloc_array<bool*>(current_state->rep->nvert);
 
       if (DG_matrix_forms_present)
       {
         for (unsigned int i = 0; i < spaces_size; i++)
         {
-          npss[i]->set_quad_2d(&g_quad_2d_std);
-          nrefmaps[i]->set_quad_2d(&g_quad_2d_std);
+          npss[i]->set_quad_2d(this->quad_2d);
+          nrefmaps[i]->set_quad_2d(this->quad_2d);
         }
       }
     }
@@ -116,7 +120,10 @@ namespace Hermes
     template<typename Scalar>
     void DiscreteProblemDGAssembler<Scalar>::assemble_one_state()
     {
-#pragma omp critical (DG)
+      // Marking elements as visited and deciding which edges were already processed has to be atomic w.r.t. the other threads
+      // of this problem instance (they share the meshes). Independent instances do not share meshes and have their own lock.
+      omp_set_lock(this->visited_lock);
+      try
       {
         for (unsigned int i = 0; i < current_state->num; i++)
           current_state->e[i]->visited = true;
@@ -157,19 +164,20 @@ namespace Hermes
             processed[current_state->isurf] = nullptr;
         }
       }
+      catch (...)
+      {
+        omp_unset_lock(this->visited_lock);
+        throw;
+      }
+      omp_unset_lock(this->visited_lock);
     }
 
     template<typename Scalar>
     void DiscreteProblemDGAssembler<Scalar>::deinit_assembling_one_state()
     {
+      // The arrays themselves live in the arena, the processed flags come from MultimeshDGNeighborTree.
       for (int i = 0; i < this->current_state->rep->nvert; i++)
-      {
-        free_with_check(neighbor_searches[i]);
         free_with_check(processed[i]);
-      }
-      free_with_check(neighbor_searches);
-      free_with_check(num_neighbors);
-      free_with_check(processed);
     }
 
     template<typename Scalar>
@@ -225,12 +233,13 @@ namespace Hermes
 
       /***/
       // The computation takes place here.
-      typename NeighborSearch<Scalar>::ExtendedShapeset** ext_asmlist = new typename NeighborSearch<Scalar>::ExtendedShapeset*[this->spaces_size];
+      // All temporaries are allocated in the arena.
+      typename NeighborSearch<Scalar>::ExtendedShapeset** ext_asmlist = arena->allocate_array<typename NeighborSearch<Scalar>::ExtendedShapeset*>(this->spaces_size);
       int n_quadrature_points;
-      GeomSurf<double>* geometry = malloc_with_check<GeomSurf<double>>(this->spaces_size);
-      double** jacobian_x_weights = malloc_with_check<double*>(this->spaces_size);
-      InterfaceGeom<double>** e = malloc_with_check<InterfaceGeom<double>*>(this->spaces_size);
-      DiscontinuousFunc<double>*** testFunctions = malloc_with_check<DiscontinuousFunc<double>**>(this->spaces_size);
+      GeomSurf<double>* geometry = arena->allocate_array<GeomSurf<double> >(this->spaces_size);
+      double** jacobian_x_weights = arena->allocate_array<double*>(this->spaces_size);
+      InterfaceGeom<double>** e = arena->allocate_array<InterfaceGeom<double>*>(this->spaces_size);
+      DiscontinuousFunc<double>*** testFunctions = arena->allocate_array<DiscontinuousFunc<double>**>(this->spaces_size);
 
       // Create the extended shapeset on the union of the central element and its current neighbor.
       int order = DiscreteProblemDGAssembler<Scalar>::dg_order;
@@ -241,29 +250,33 @@ namespace Hermes
           continue;
         current_neighbor_searches[i]->set_quad_order(order);
         order_base = order;
-        jacobian_x_weights[i] = new double[refmaps[i]->get_quad_2d()->get_num_points(order_base, current_state->e[i]->get_mode())];
+        jacobian_x_weights[i] = arena->allocate_array<double>(refmaps[i]->get_quad_2d()->get_num_points(order_base, current_state->e[i]->get_mode()));
+        new (&geometry[i]) GeomSurf<double>();
         n_quadrature_points = init_surface_geometry_points_allocated(refmaps, this->spaces_size, order_base, current_state->isurf, current_state->rep->marker, geometry[i], jacobian_x_weights[i]);
-        e[i] = new InterfaceGeom<double>(&geometry[i], current_neighbor_searches[i]->central_el, current_neighbor_searches[i]->neighb_el);
+        e[i] = arena->create<InterfaceGeom<double> >(&geometry[i], current_neighbor_searches[i]->central_el, current_neighbor_searches[i]->neighb_el);
 
         if (current_mat && DG_matrix_forms_present && !edge_processed)
         {
           ext_asmlist[i] = current_neighbor_searches[i]->create_extended_asmlist(spaces[i], &als[i]);
-          testFunctions[i] = malloc_with_check<DiscontinuousFunc<double>*>(ext_asmlist[i]->cnt);
+          testFunctions[i] = arena->allocate_array<DiscontinuousFunc<double>*>(ext_asmlist[i]->cnt);
           for (int func_i = 0; func_i < ext_asmlist[i]->cnt; func_i++)
           {
             if (ext_asmlist[i]->dof[func_i] < 0)
               continue;
 
             // Choose the correct shapeset for the test function.
+            Func<double>* fn = arena->create<Func<double> >();
             if (ext_asmlist[i]->has_support_on_neighbor(func_i))
             {
               npss[i]->set_active_shape(ext_asmlist[i]->neighbor_al->idx[func_i - ext_asmlist[i]->central_al->cnt]);
-              testFunctions[i][func_i] = new DiscontinuousFunc<double>(init_fn(npss[i], nrefmaps[i], current_neighbor_searches[i]->get_quad_eo(true)), true, current_neighbor_searches[i]->neighbor_edge.orientation);
+              init_fn_preallocated(fn, npss[i], nrefmaps[i], current_neighbor_searches[i]->get_quad_eo(true));
+              testFunctions[i][func_i] = arena->create<DiscontinuousFunc<double> >(fn, true, (bool)current_neighbor_searches[i]->neighbor_edge.orientation, arena);
             }
             else
             {
               pss[i]->set_active_shape(ext_asmlist[i]->central_al->idx[func_i]);
-              testFunctions[i][func_i] = new DiscontinuousFunc<double>(init_fn(pss[i], refmaps[i], current_neighbor_searches[i]->get_quad_eo(false)), false, current_neighbor_searches[i]->neighbor_edge.orientation);
+              init_fn_preallocated(fn, pss[i], refmaps[i], current_neighbor_searches[i]->get_quad_eo(false));
+              testFunctions[i][func_i] = arena->create<DiscontinuousFunc<double> >(fn, false, (bool)current_neighbor_searches[i]->neighbor_edge.orientation, arena);
             }
           }
         }
@@ -271,7 +284,7 @@ namespace Hermes
 
       DiscontinuousFunc<Scalar>** ext = init_ext_fns(wf->ext, current_neighbor_searches, order);
 
-      DiscontinuousFunc<Scalar>** u_ext_func = malloc_with_check<DiscontinuousFunc<Scalar>*>(this->spaces_size);
+      DiscontinuousFunc<Scalar>** u_ext_func = arena->allocate_array<DiscontinuousFunc<Scalar>*>(this->spaces_size);
       if (this->nonlinear)
       {
         if (u_ext)
@@ -307,6 +320,7 @@ namespace Hermes
           typename NeighborSearch<Scalar>::ExtendedShapeset* ext_asmlist_u = ext_asmlist[n];
           typename NeighborSearch<Scalar>::ExtendedShapeset* ext_asmlist_v = ext_asmlist[m];
 
+          unsigned int evaluated_pairs = 0;
           for (int i = 0; i < ext_asmlist_v->cnt; i++)
           {
             if (ext_asmlist_v->dof[i] < 0)
@@ -323,6 +337,7 @@ namespace Hermes
                 DiscontinuousFunc<double>* v = testFunctions[m][i];
 
                 Scalar res = mfs->value(n_quadrature_points, jacobian_x_weights[n], u_ext_func, u, v, e[n], ext) * mfs->scaling_factor;
+                evaluated_pairs++;
 
                 support_neigh_u = ext_asmlist_u->has_support_on_neighbor(j);
 
@@ -334,25 +349,16 @@ namespace Hermes
             }
           }
 
+          this->statistics->form_evaluations += evaluated_pairs;
+          this->statistics->quadrature_points += (unsigned long long)evaluated_pairs * n_quadrature_points;
+
           current_mat->add(ext_asmlist_v->cnt, ext_asmlist_u->cnt, this->local_stiffness_matrix, ext_asmlist_v->dof, ext_asmlist_u->dof, H2D_MAX_LOCAL_BASIS_SIZE * 2);
         }
 
         for (int i = 0; i < this->spaces_size; i++)
-        {
-          for (int func_i = 0; func_i < ext_asmlist[i]->cnt; func_i++)
-          {
-            if (ext_asmlist[i]->dof[func_i] < 0)
-              continue;
-            delete testFunctions[i][func_i];
-          }
           delete ext_asmlist[i];
-          free_with_check(testFunctions[i]);
-        }
       }
 
-      free_with_check(testFunctions);
-      free_with_check(ext_asmlist);
-      
       if (current_rhs && DG_vector_forms_present)
       {
         for (unsigned int ww = 0; ww < wf->vfDG.size(); ww++)
@@ -375,10 +381,12 @@ namespace Hermes
               continue;
             pss[n]->set_active_shape(als[n].idx[dof_i]);
 
-            Func<double>* v = init_fn(pss[n], refmaps[n], current_neighbor_searches_v->get_quad_eo());
+            Func<double>* v = arena->create<Func<double> >();
+            init_fn_preallocated(v, pss[n], refmaps[n], current_neighbor_searches_v->get_quad_eo());
 
             current_rhs->add(als[n].dof[dof_i], 0.5 * vfs->value(n_quadrature_points, jacobian_x_weights[n], u_ext_func, v, e[n], ext) * vfs->scaling_factor * als[n].coef[dof_i]);
-            delete v;
+            this->statistics->form_evaluations++;
+            this->statistics->quadrature_points += n_quadrature_points;
           }
         }
       }
@@ -389,7 +397,6 @@ namespace Hermes
         {
           delete ext[i];
         }
-        delete[] ext;
       }
 
       if (this->nonlinear)
@@ -404,20 +411,6 @@ namespace Hermes
         }
       }
 
-      delete[] u_ext_func;
-
-      for (int i = 0; i < this->spaces_size; i++)
-      {
-        if (this->spaces[i]->get_type() != HERMES_L2_SPACE)
-          continue;
-        delete[] jacobian_x_weights[i];
-        delete e[i];
-      }
-
-      free_with_check(geometry);
-      free_with_check(jacobian_x_weights);
-      free_with_check(e);
-
       // This is just cleaning after ourselves.
       // Clear the transformations from the RefMaps and all functions.
       for (unsigned int fns_i = 0; fns_i < current_state->num; fns_i++)
@@ -439,7 +432,7 @@ namespace Hermes
     DiscontinuousFunc<Scalar>** DiscreteProblemDGAssembler<Scalar>::init_ext_fns(std::vector<MeshFunctionSharedPtr<Scalar> > ext,
       NeighborSearch<Scalar>** current_neighbor_searches, int order)
     {
-      DiscontinuousFunc<Scalar>** ext_fns = new DiscontinuousFunc<Scalar>*[ext.size()];
+      DiscontinuousFunc<Scalar>** ext_fns = arena->allocate_array<DiscontinuousFunc<Scalar>*>(ext.size());
       for (unsigned int j = 0; j < ext.size(); j++)
       {
         NeighborSearch<Scalar>* ns = get_neighbor_search_ext(this->wf, current_neighbor_searches, j);
@@ -469,6 +462,8 @@ namespace Hermes
         {
           NeighborSearch<Scalar>* ns = new NeighborSearch<Scalar>(current_state->e[i], this->meshes[i]);
           ns->original_central_el_transform = current_state->sub_idx[i];
+          // The edge points have to be those of the refmaps and shapesets.
+          ns->quad = this->quad_2d;
           current_neighbor_searches[i] = ns;
           if (current_neighbor_searches[i]->set_active_edge_multimesh(current_state->isurf) && (i >= this->spaces_size || spaces[i]->get_type() == HERMES_L2_SPACE))
             DG_intra = true;
@@ -0,0 +1,1071 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "discrete_problem/dg/discrete_problem_dg_matrix_free.h"
+#include "discrete_problem/discrete_problem_helpers.h"
+#include "quadrature/limit_order.h"
+#include "shapeset/precalc.h"
+#include "mesh/refmap.h"
+#include "mesh/mesh_util.h"
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    /// The operator is linear in the basis function argument, which is always real (Func<double>).
+    /// A complex argument is therefore applied as (real part) + i * (imaginary part).
+    template<typename Scalar>
+    struct ScalarParts
+    {
+    };
+
+    template<>
+    struct ScalarParts < double >
+    {
+      static const unsigned char count = 1;
+      static double get(const double& value, unsigned char part) { return value; }
+      static double unit(unsigned char part) { return 1.; }
+    };
+
+    template<>
+    struct ScalarParts < std::complex<double> >
+    {
+      static const unsigned char count = 2;
+      static double get(const std::complex<double>& value, unsigned char part) { return part ? value.imag() : value.real(); }
+      static std::complex<double> unit(unsigned char part) { return part ? std::complex<double>(0., 1.) : std::complex<double>(1., 0.); }
+    };
+
+    /// Copies precomputed shape function values into a (preallocated) Func.
+    static void load_shape_function(Func<double>* fn, unsigned char np, const double* val, const double* dx, const double* dy)
+    {
+      fn->np = np;
+      memcpy(fn->val, val, np * sizeof(double));
+      memcpy(fn->dx, dx, np * sizeof(double));
+      memcpy(fn->dy, dy, np * sizeof(double));
+    }
+
+    /// Sum of coefs * vector[dofs] * shape functions - one part (real / imaginary) of it.
+    template<typename Scalar>
+    static void combine_shape_functions_part(Func<double>* fn, unsigned char np, unsigned short cnt, const int* dofs, const Scalar* coefs, const Scalar* vector, unsigned char part,
+      const double* val, const double* dx, const double* dy)
+    {
+      fn->np = np;
+      memset(fn->val, 0, np * sizeof(double));
+      memset(fn->dx, 0, np * sizeof(double));
+      memset(fn->dy, 0, np * sizeof(double));
+      for (unsigned short a = 0; a < cnt; a++)
+      {
+        if (dofs[a] < 0)
+          continue;
+        double c = ScalarParts<Scalar>::get(coefs[a] * vector[dofs[a]], part);
+        if (c == 0.)
+          continue;
+        const double* val_a = val + a * np, *dx_a = dx + a * np, *dy_a = dy + a * np;
+        for (unsigned char k = 0; k < np; k++)
+        {
+          fn->val[k] += c * val_a[k];
+          fn->dx[k] += c * dx_a[k];
+          fn->dy[k] += c * dy_a[k];
+        }
+      }
+    }
+
+    /// Sum of coefs * vector[dofs] * shape functions.
+    template<typename Scalar>
+    static void combine_shape_functions(Func<Scalar>* fn, unsigned char np, unsigned short cnt, const int* dofs, const Scalar* coefs, const Scalar* vector,
+      const double* val, const double* dx, const double* dy)
+    {
+      fn->np = np;
+      for (unsigned char k = 0; k < np; k++)
+        fn->val[k] = fn->dx[k] = fn->dy[k] = 0.;
+      if (!vector)
+        return;
+      for (unsigned short a = 0; a < cnt; a++)
+      {
+        if (dofs[a] < 0)
+          continue;
+        Scalar c = coefs[a] * vector[dofs[a]];
+        const double* val_a = val + a * np, *dx_a = dx + a * np, *dy_a = dy + a * np;
+        for (unsigned char k = 0; k < np; k++)
+        {
+          fn->val[k] += c * val_a[k];
+          fn->dx[k] += c * dx_a[k];
+          fn->dy[k] += c * dy_a[k];
+        }
+      }
+    }
+
+    /// Reverses the order of integration points (neighbor side of an inner edge with opposite orientation).
+    template<typename Scalar>
+    static void reverse_points(Func<Scalar>* fn)
+    {
+      std::reverse(fn->val, fn->val + fn->np);
+      std::reverse(fn->dx, fn->dx + fn->np);
+      std::reverse(fn->dy, fn->dy + fn->np);
+    }
+
+    template<typename Scalar>
+    DiscreteProblemDGMatrixFree<Scalar>::DiscreteProblemDGMatrixFree(WeakFormSharedPtr<Scalar> wf, std::vector<SpaceSharedPtr<Scalar> > spaces)
+      : wf(wf), spaces(spaces), spaces_size(spaces.size()), ndof(0), mesh_seq(-1), order_increase(1),
+      quadrature(&g_quad_2d_std), collocated_quadrature(false), quad_2d(&g_quad_2d_std), thread_data(nullptr)
+    {
+      this->init_threads();
+    }
+
+    template<typename Scalar>
+    DiscreteProblemDGMatrixFree<Scalar>::DiscreteProblemDGMatrixFree(WeakFormSharedPtr<Scalar> wf, SpaceSharedPtr<Scalar> space)
+      : wf(wf), spaces_size(1), ndof(0), mesh_seq(-1), order_increase(1),
+      quadrature(&g_quad_2d_std), collocated_quadrature(false), quad_2d(&g_quad_2d_std), thread_data(nullptr)
+    {
+      this->spaces.push_back(space);
+      this->init_threads();
+    }
+
+    template<typename Scalar>
+    DiscreteProblemDGMatrixFree<Scalar>::~DiscreteProblemDGMatrixFree()
+    {
+      this->free_threads();
+      this->free_tables();
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::set_integration_order_increase(unsigned short increase)
+    {
+      this->order_increase = increase;
+      // Force rebuilding of the tables.
+      this->mesh_seq = -1;
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::set_quadrature(Quad2D* quadrature)
+    {
+      if (!quadrature)
+        throw Exceptions::NullException(1);
+      this->quadrature = quadrature;
+      this->set_collocated_quadrature(this->collocated_quadrature);
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::set_collocated_quadrature(bool to_set)
+    {
+      this->collocated_quadrature = to_set;
+      // The same rules as DiscreteProblemThreadAssembler::update_quad_2d().
+      if (!to_set)
+        this->quad_2d = this->quadrature;
+      else if (this->quadrature == &g_quad_2d_std)
+        this->quad_2d = &g_quad_2d_lobatto;
+      else
+        this->quad_2d = Quad2DComposite::get(this->quadrature, &g_quad_2d_lobatto);
+      // Force rebuilding of the tables.
+      this->mesh_seq = -1;
+    }
+
+    template<typename Scalar>
+    int DiscreteProblemDGMatrixFree<Scalar>::get_num_dofs() const
+    {
+      return Space<Scalar>::get_num_dofs(this->spaces);
+    }
+
+    template<typename Scalar>
+    unsigned int DiscreteProblemDGMatrixFree<Scalar>::get_num_edge_colors() const
+    {
+      return this->edge_colors.size();
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::set_time(double time)
+    {
+      this->wf->set_current_time(time);
+      for (int i = 0; i < this->num_threads_used; i++)
+        this->thread_data[i]->wf->set_current_time(time);
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::set_time_step(double time_step)
+    {
+      this->wf->set_current_time_step(time_step);
+      for (int i = 0; i < this->num_threads_used; i++)
+        this->thread_data[i]->wf->set_current_time_step(time_step);
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::init_threads()
+    {
+      if (this->spaces_size == 0 || this->spaces_size > H2D_MAX_COMPONENTS)
+        throw Exceptions::ValueException("spaces", this->spaces_size, H2D_MAX_COMPONENTS);
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+      {
+        if (this->spaces[i]->get_type() != HERMES_L2_SPACE)
+          throw Exceptions::Exception("DiscreteProblemDGMatrixFree: space %i is not an L2 space.", i);
+        if (this->spaces[i]->get_mesh()->get_seq() != this->spaces[0]->get_mesh()->get_seq())
+          throw Exceptions::Exception("DiscreteProblemDGMatrixFree: all spaces have to be defined on the same mesh.");
+      }
+      if (!this->wf->u_ext_fn.empty())
+        throw Exceptions::Exception("DiscreteProblemDGMatrixFree: UExtFunctions are not supported.");
+      for (unsigned int i = 0; i < this->wf->ext.size(); i++)
+        if (this->wf->ext[i]->get_mesh()->get_seq() != this->spaces[0]->get_mesh()->get_seq())
+          throw Exceptions::Exception("DiscreteProblemDGMatrixFree: external functions have to be defined on the mesh of the spaces.");
+      for (unsigned int i = 0; i < this->wf->get_forms().size(); i++)
+        if (!this->wf->get_forms()[i]->ext.empty() || !this->wf->get_forms()[i]->u_ext_fn.empty())
+          throw Exceptions::Exception("DiscreteProblemDGMatrixFree: form-specific external functions are not supported.");
+
+      this->thread_data = malloc_with_check<ThreadData*>(this->num_threads_used);
+      for (int thread_i = 0; thread_i < this->num_threads_used; thread_i++)
+      {
+        ThreadData* td = new ThreadData;
+        td->wf = WeakFormSharedPtr<Scalar>(this->wf->clone());
+        td->wf->cloneMembers(this->wf);
+        td->wf->processFormMarkers(this->spaces);
+
+        td->fn = preallocate_fn<double>();
+        td->fn_neighbor = preallocate_fn<double>();
+        td->argument = preallocate_fn<double>();
+        td->argument_neighbor = preallocate_fn<double>();
+        td->fn->nc = td->fn_neighbor->nc = td->argument->nc = td->argument_neighbor->nc = 1;
+        td->dg_fn = new DiscontinuousFunc<double>(td->fn, false);
+        td->dg_fn_neighbor = new DiscontinuousFunc<double>(td->fn_neighbor, true);
+        td->dg_argument = new DiscontinuousFunc<double>(td->argument, false);
+        td->dg_argument_neighbor = new DiscontinuousFunc<double>(td->argument_neighbor, true);
+
+        for (unsigned short i = 0; i < this->spaces_size; i++)
+        {
+          td->u_ext[i] = preallocate_fn<Scalar>();
+          td->u_ext_neighbor[i] = preallocate_fn<Scalar>();
+          td->u_ext[i]->nc = td->u_ext_neighbor[i]->nc = 1;
+          td->dg_u_ext[i] = new DiscontinuousFunc<Scalar>(td->u_ext[i], td->u_ext_neighbor[i]);
+        }
+
+        for (unsigned int i = 0; i < td->wf->ext.size(); i++)
+        {
+          td->ext.push_back(preallocate_fn<Scalar>());
+          td->ext_neighbor.push_back(preallocate_fn<Scalar>());
+          td->ext[i]->nc = td->ext_neighbor[i]->nc = td->wf->ext[i]->get_num_components();
+          td->dg_ext.push_back(new DiscontinuousFunc<Scalar>(td->ext[i], td->ext_neighbor[i]));
+        }
+
+        this->thread_data[thread_i] = td;
+      }
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::free_threads()
+    {
+      if (!this->thread_data)
+        return;
+
+      for (int thread_i = 0; thread_i < this->num_threads_used; thread_i++)
+      {
+        ThreadData* td = this->thread_data[thread_i];
+
+        // The discontinuous functions only wrap the preallocated functions, those are deleted separately.
+        DiscontinuousFunc<double>* dg_fns[4] = { td->dg_fn, td->dg_fn_neighbor, td->dg_argument, td->dg_argument_neighbor };
+        for (int i = 0; i < 4; i++)
+        {
+          dg_fns[i]->fn_central = dg_fns[i]->fn_neighbor = nullptr;
+          delete dg_fns[i];
+        }
+        delete td->fn;
+        delete td->fn_neighbor;
+        delete td->argument;
+        delete td->argument_neighbor;
+
+        for (unsigned short i = 0; i < this->spaces_size; i++)
+        {
+          td->dg_u_ext[i]->fn_central = td->dg_u_ext[i]->fn_neighbor = nullptr;
+          delete td->dg_u_ext[i];
+          delete td->u_ext[i];
+          delete td->u_ext_neighbor[i];
+        }
+
+        for (unsigned int i = 0; i < td->dg_ext.size(); i++)
+        {
+          td->dg_ext[i]->fn_central = td->dg_ext[i]->fn_neighbor = nullptr;
+          delete td->dg_ext[i];
+          delete td->ext[i];
+          delete td->ext_neighbor[i];
+        }
+
+        delete td;
+      }
+      free_with_check(this->thread_data);
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::free_tables()
+    {
+      this->elements.clear();
+      this->element_indices.clear();
+      this->dofs.clear();
+      this->coefs.clear();
+      this->domains.clear();
+      this->edge_colors.clear();
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::update()
+    {
+      bool changed = this->mesh_seq != (int)this->spaces[0]->get_mesh()->get_seq() || this->space_seqs.size() != this->spaces_size;
+      for (unsigned short i = 0; i < this->spaces_size && !changed; i++)
+        if (this->space_seqs[i] != this->spaces[i]->get_seq())
+          changed = true;
+
+      if (changed)
+        this->init_tables();
+    }
+
+    template<typename Scalar>
+    int DiscreteProblemDGMatrixFree<Scalar>::calc_order(Element* e, RefMap* refmap)
+    {
+      if (this->wf->global_integration_order_set)
+        return this->wf->global_integration_order;
+
+      int max_order = 0;
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+      {
+        int order = this->spaces[i]->get_element_order(e->id);
+        max_order = std::max(max_order, std::max(H2D_GET_H_ORDER(order), H2D_GET_V_ORDER(order)));
+      }
+
+      // Collocated mode - the Gauss-Lobatto rule with p + 1 points per direction, see DiscreteProblem::set_collocated_quadrature().
+      if (this->collocated_quadrature && e->get_mode() == HERMES_MODE_QUAD)
+        return std::min(std::max(2 * max_order - 1, 0), (int)g_max_quad_lobatto);
+
+      int order = refmap->get_inv_ref_order() + 2 * max_order + this->order_increase;
+      limit_order_nowarn(order, e->get_mode(), this->quad_2d);
+      return order;
+    }
+
+    template<typename Scalar>
+    bool DiscreteProblemDGMatrixFree<Scalar>::form_to_be_assembled(Form<Scalar>* form, int marker, bool surface)
+    {
+      if (fabs(form->scaling_factor) < Hermes::HermesSqrtEpsilon)
+        return false;
+
+      if (surface && marker == 0)
+        return false;
+
+      if (form->assembleEverywhere)
+        return true;
+
+      for (unsigned int ss = 0; ss < form->areas_internal.size(); ss++)
+        if (form->areas_internal[ss] == marker)
+          return true;
+
+      return false;
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::init_tables()
+    {
+      this->free_tables();
+
+      this->mesh = this->spaces[0]->get_mesh();
+      this->mesh_seq = this->mesh->get_seq();
+      this->space_seqs.clear();
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+        this->space_seqs.push_back(this->spaces[i]->get_seq());
+      this->ndof = Space<Scalar>::get_num_dofs(this->spaces);
+
+      // Assembly lists.
+      AsmList<Scalar> al;
+      this->element_indices.resize(this->mesh->get_max_element_id(), -1);
+      Element* e;
+      for_all_active_elements(e, this->mesh)
+      {
+        ElementData data;
+        data.e = e;
+        for (unsigned short i = 0; i < this->spaces_size; i++)
+        {
+          this->spaces[i]->get_element_assembly_list(e, &al);
+          data.cnt[i] = al.cnt;
+          data.al_offset[i] = this->dofs.size();
+          this->dofs.insert(this->dofs.end(), al.dof, al.dof + al.cnt);
+          this->coefs.insert(this->coefs.end(), al.coef, al.coef + al.cnt);
+        }
+        this->element_indices[e->id] = this->elements.size();
+        this->elements.push_back(data);
+      }
+
+      // Integration domains.
+      PrecalcShapeset** pss = malloc_with_check<PrecalcShapeset*>(this->spaces_size);
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+      {
+        pss[i] = new PrecalcShapeset(this->spaces[i]->get_shapeset());
+        pss[i]->set_quad_2d(this->quad_2d);
+      }
+      RefMap refmap;
+      refmap.set_quad_2d(this->quad_2d);
+      for (int thread_i = 0; thread_i < this->num_threads_used; thread_i++)
+      {
+        for (unsigned int i = 0; i < this->thread_data[thread_i]->wf->ext.size(); i++)
+          this->thread_data[thread_i]->wf->ext[i]->set_quad_2d(this->quad_2d);
+      }
+      Func<double>* fn = preallocate_fn<double>();
+
+      bool surface_forms = !this->wf->mfsurf.empty() || !this->wf->vfsurf.empty();
+      bool DG_forms = !this->wf->mfDG.empty() || !this->wf->vfDG.empty();
+
+      for (unsigned int element_i = 0; element_i < this->elements.size(); element_i++)
+      {
+        e = this->elements[element_i].e;
+
+        this->elements[element_i].volume = this->domains.size();
+        this->domains.push_back(IntegrationDomain());
+        this->init_domain(this->domains.back(), element_i, -1, pss, &refmap, fn);
+
+        for (unsigned char isurf = 0; isurf < e->get_nvert(); isurf++)
+        {
+          if (e->en[isurf]->bnd)
+          {
+            if (!surface_forms)
+              continue;
+            this->elements[element_i].boundary_edges.push_back(this->domains.size());
+            this->domains.push_back(IntegrationDomain());
+            this->init_domain(this->domains.back(), element_i, isurf, pss, &refmap, fn);
+          }
+          else
+          {
+            if (!DG_forms)
+              continue;
+            NeighborSearch<Scalar> ns(e, this->mesh);
+            ns.quad = this->quad_2d;
+            ns.set_active_edge(isurf);
+            for (int segment = 0; segment < ns.get_num_neighbors(); segment++)
+            {
+              this->elements[element_i].inner_edges.push_back(this->domains.size());
+              this->domains.push_back(IntegrationDomain());
+              this->init_inner_edge(this->domains.back(), element_i, isurf, ns, segment, pss, &refmap, fn);
+            }
+          }
+        }
+      }
+
+      delete fn;
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+        delete pss[i];
+      free_with_check(pss);
+
+      this->color_inner_edges();
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::init_domain(IntegrationDomain& domain, unsigned int element_index, int isurf, PrecalcShapeset** pss, RefMap* refmap, Func<double>* fn)
+    {
+      Element* e = this->elements[element_index].e;
+      refmap->set_active_element(e);
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+        pss[i]->set_active_element(e);
+
+      domain.element_index = domain.neighbor_index = element_index;
+      domain.orientation = domain.owned = domain.edge_orientation = false;
+      domain.elem_marker = e->marker;
+
+      int order = this->calc_order(e, refmap);
+      double jacobian_x_weights[H2D_MAX_INTEGRATION_POINTS_COUNT];
+      if (isurf == -1)
+      {
+        GeomVol<double> geometry;
+        domain.isurf = 0;
+        domain.edge_marker = 0;
+        domain.np = init_geometry_points_allocated(refmap, order, geometry, jacobian_x_weights);
+        domain.x.assign(geometry.x, geometry.x + domain.np);
+        domain.y.assign(geometry.y, geometry.y + domain.np);
+      }
+      else
+      {
+        GeomSurf<double> geometry;
+        domain.isurf = isurf;
+        domain.np = init_surface_geometry_points_allocated(refmap, order, isurf, e->marker, geometry, jacobian_x_weights);
+        domain.edge_marker = geometry.edge_marker;
+        domain.edge_orientation = geometry.orientation;
+        domain.x.assign(geometry.x, geometry.x + domain.np);
+        domain.y.assign(geometry.y, geometry.y + domain.np);
+        domain.nx.assign(geometry.nx, geometry.nx + domain.np);
+        domain.ny.assign(geometry.ny, geometry.ny + domain.np);
+        domain.tx.assign(geometry.tx, geometry.tx + domain.np);
+        domain.ty.assign(geometry.ty, geometry.ty + domain.np);
+      }
+      domain.order = domain.neighbor_order = order;
+      domain.jacobian_x_weights.assign(jacobian_x_weights, jacobian_x_weights + domain.np);
+
+      AsmList<Scalar> al;
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+      {
+        domain.offset[i] = domain.val.size();
+        this->spaces[i]->get_element_assembly_list(e, &al);
+        for (unsigned short a = 0; a < al.cnt; a++)
+        {
+          pss[i]->set_active_shape(al.idx[a]);
+          init_fn_preallocated(fn, pss[i], refmap, order);
+          domain.val.insert(domain.val.end(), fn->val, fn->val + domain.np);
+          domain.dx.insert(domain.dx.end(), fn->dx, fn->dx + domain.np);
+          domain.dy.insert(domain.dy.end(), fn->dy, fn->dy + domain.np);
+        }
+      }
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::init_inner_edge(IntegrationDomain& domain, unsigned int element_index, unsigned char isurf, NeighborSearch<Scalar>& ns, unsigned int segment, PrecalcShapeset** pss, RefMap* refmap, Func<double>* fn)
+    {
+      ns.set_active_segment(segment);
+      Element* e = this->elements[element_index].e;
+      Element* neighbor = ns.get_neighb_el();
+      typename NeighborSearch<Scalar>::NeighborEdgeInfo neighbor_edge = ns.get_neighbor_edge();
+
+      domain.element_index = element_index;
+      domain.neighbor_index = this->element_indices[neighbor->id];
+      domain.isurf = isurf;
+      domain.elem_marker = e->marker;
+      domain.orientation = neighbor_edge.orientation;
+
+      domain.central_transformations.reset();
+      if (segment < ns.central_transformations_alloc_size && ns.central_transformations[segment])
+        domain.central_transformations.copy_from(ns.central_transformations[segment]);
+      domain.neighbor_transformations.reset();
+      if (segment < ns.neighbor_transformations_alloc_size && ns.neighbor_transformations[segment])
+        domain.neighbor_transformations.copy_from(ns.neighbor_transformations[segment]);
+
+      // The edge is owned by the smaller element, or by the one with the lower id if both are of the same size.
+      if (domain.central_transformations.num_levels > 0)
+        domain.owned = false;
+      else if (domain.neighbor_transformations.num_levels > 0)
+        domain.owned = true;
+      else
+        domain.owned = e->id < neighbor->id;
+
+      // Edge integration order - the same way as the DG assembler uses it (limited by the maximum orders of the quadrature only).
+      int order;
+      if (this->wf->global_integration_order_set)
+        order = this->wf->global_integration_order;
+      else
+      {
+        int max_order = 0;
+        for (unsigned short i = 0; i < this->spaces_size; i++)
+        {
+          int order_e = this->spaces[i]->get_element_order(e->id);
+          int order_n = this->spaces[i]->get_element_order(neighbor->id);
+          max_order = std::max(max_order, std::max(std::max(H2D_GET_H_ORDER(order_e), H2D_GET_V_ORDER(order_e)), std::max(H2D_GET_H_ORDER(order_n), H2D_GET_V_ORDER(order_n))));
+        }
+        refmap->set_active_element(neighbor);
+        int inv_ref_order = refmap->get_inv_ref_order();
+        refmap->set_active_element(e);
+        inv_ref_order = std::max(inv_ref_order, refmap->get_inv_ref_order());
+        order = std::min(inv_ref_order + 2 * max_order + this->order_increase, (int)std::min(this->quad_2d->get_max_order(e->get_mode()), this->quad_2d->get_max_order(neighbor->get_mode())));
+      }
+      ns.set_quad_order(order);
+      domain.order = ns.get_quad_eo(false);
+      domain.neighbor_order = ns.get_quad_eo(true);
+
+      AsmList<Scalar> al;
+
+      // Central side.
+      refmap->set_active_element(e);
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+      {
+        pss[i]->set_active_element(e);
+        domain.central_transformations.apply_on(pss[i]);
+      }
+      refmap->force_transform(pss[0]->get_transform(), pss[0]->get_ctm());
+
+      GeomSurf<double> geometry;
+      double jacobian_x_weights[H2D_MAX_INTEGRATION_POINTS_COUNT];
+      int order_local = order;
+      domain.np = init_surface_geometry_points_allocated(refmap, order_local, isurf, e->marker, geometry, jacobian_x_weights);
+      domain.edge_marker = geometry.edge_marker;
+      domain.edge_orientation = geometry.orientation;
+      domain.x.assign(geometry.x, geometry.x + domain.np);
+      domain.y.assign(geometry.y, geometry.y + domain.np);
+      domain.nx.assign(geometry.nx, geometry.nx + domain.np);
+      domain.ny.assign(geometry.ny, geometry.ny + domain.np);
+      domain.tx.assign(geometry.tx, geometry.tx + domain.np);
+      domain.ty.assign(geometry.ty, geometry.ty + domain.np);
+      domain.jacobian_x_weights.assign(jacobian_x_weights, jacobian_x_weights + domain.np);
+
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+      {
+        domain.offset[i] = domain.val.size();
+        this->spaces[i]->get_element_assembly_list(e, &al);
+        for (unsigned short a = 0; a < al.cnt; a++)
+        {
+          pss[i]->set_active_shape(al.idx[a]);
+          init_fn_preallocated(fn, pss[i], refmap, domain.order);
+          domain.val.insert(domain.val.end(), fn->val, fn->val + domain.np);
+          domain.dx.insert(domain.dx.end(), fn->dx, fn->dx + domain.np);
+          domain.dy.insert(domain.dy.end(), fn->dy, fn->dy + domain.np);
+        }
+      }
+
+      // Neighbor side.
+      refmap->set_active_element(neighbor);
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+      {
+        pss[i]->set_active_element(neighbor);
+        domain.neighbor_transformations.apply_on(pss[i]);
+      }
+      refmap->force_transform(pss[0]->get_transform(), pss[0]->get_ctm());
+
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+      {
+        domain.offset_neighbor[i] = domain.val_neighbor.size();
+        this->spaces[i]->get_element_assembly_list(neighbor, &al);
+        for (unsigned short a = 0; a < al.cnt; a++)
+        {
+          pss[i]->set_active_shape(al.idx[a]);
+          init_fn_preallocated(fn, pss[i], refmap, domain.neighbor_order);
+          if (domain.orientation)
+          {
+            fn->np = domain.np;
+            reverse_points(fn);
+          }
+          domain.val_neighbor.insert(domain.val_neighbor.end(), fn->val, fn->val + domain.np);
+          domain.dx_neighbor.insert(domain.dx_neighbor.end(), fn->dx, fn->dx + domain.np);
+          domain.dy_neighbor.insert(domain.dy_neighbor.end(), fn->dy, fn->dy + domain.np);
+        }
+      }
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::color_inner_edges()
+    {
+      this->edge_colors.clear();
+      if (this->wf->mfDG.empty())
+        return;
+
+      // Greedy coloring: an edge gets the first color none of its two elements is used in yet.
+      std::vector<std::vector<bool> > elements_used;
+      for (unsigned int domain_i = 0; domain_i < this->domains.size(); domain_i++)
+      {
+        IntegrationDomain& domain = this->domains[domain_i];
+        if (!domain.owned)
+          continue;
+
+        unsigned int color = 0;
+        for (; color < this->edge_colors.size(); color++)
+          if (!elements_used[color][domain.element_index] && !elements_used[color][domain.neighbor_index])
+            break;
+
+        if (color == this->edge_colors.size())
+        {
+          this->edge_colors.push_back(std::vector<unsigned int>());
+          elements_used.push_back(std::vector<bool>(this->elements.size(), false));
+        }
+
+        this->edge_colors[color].push_back(domain_i);
+        elements_used[color][domain.element_index] = elements_used[color][domain.neighbor_index] = true;
+      }
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::load_domain(ThreadData* td, IntegrationDomain& domain, Scalar* coeff_vec, bool surface)
+    {
+      unsigned char np = domain.np;
+      ElementData& data = this->elements[domain.element_index];
+
+      if (surface)
+      {
+        memcpy(td->geometry_surface.x, &domain.x[0], np * sizeof(double));
+        memcpy(td->geometry_surface.y, &domain.y[0], np * sizeof(double));
+        memcpy(td->geometry_surface.nx, &domain.nx[0], np * sizeof(double));
+        memcpy(td->geometry_surface.ny, &domain.ny[0], np * sizeof(double));
+        memcpy(td->geometry_surface.tx, &domain.tx[0], np * sizeof(double));
+        memcpy(td->geometry_surface.ty, &domain.ty[0], np * sizeof(double));
+        td->geometry_surface.elem_marker = domain.elem_marker;
+        td->geometry_surface.edge_marker = domain.edge_marker;
+        td->geometry_surface.isurf = domain.isurf;
+        td->geometry_surface.orientation = domain.edge_orientation;
+      }
+      else
+      {
+        memcpy(td->geometry.x, &domain.x[0], np * sizeof(double));
+        memcpy(td->geometry.y, &domain.y[0], np * sizeof(double));
+        td->geometry.elem_marker = domain.elem_marker;
+        td->geometry.id = data.e->id;
+      }
+
+      // Previous iteration.
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+      {
+        combine_shape_functions(td->u_ext[i], np, data.cnt[i], &this->dofs[data.al_offset[i]], &this->coefs[data.al_offset[i]], coeff_vec,
+          &domain.val[domain.offset[i]], &domain.dx[domain.offset[i]], &domain.dy[domain.offset[i]]);
+      }
+
+      // External functions.
+      for (unsigned int i = 0; i < td->ext.size(); i++)
+      {
+        MeshFunction<Scalar>* ext = td->wf->ext[i].get();
+        ext->set_active_element(data.e);
+        init_fn_preallocated(td->ext[i], ext, domain.order);
+      }
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::load_inner_edge(ThreadData* td, IntegrationDomain& domain, Scalar* coeff_vec)
+    {
+      unsigned char np = domain.np;
+      ElementData& data = this->elements[domain.element_index];
+      ElementData& neighbor_data = this->elements[domain.neighbor_index];
+
+      this->load_domain(td, domain, coeff_vec, true);
+
+      // Previous iteration - neighbor side.
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+      {
+        combine_shape_functions(td->u_ext_neighbor[i], np, neighbor_data.cnt[i], &this->dofs[neighbor_data.al_offset[i]], &this->coefs[neighbor_data.al_offset[i]], coeff_vec,
+          &domain.val_neighbor[domain.offset_neighbor[i]], &domain.dx_neighbor[domain.offset_neighbor[i]], &domain.dy_neighbor[domain.offset_neighbor[i]]);
+        td->dg_u_ext[i]->np = np;
+      }
+
+      // External functions - both sides, with the transformations to the common edge segment.
+      for (unsigned int i = 0; i < td->ext.size(); i++)
+      {
+        MeshFunction<Scalar>* ext = td->wf->ext[i].get();
+        ext->set_active_element(data.e);
+        domain.central_transformations.apply_on(ext);
+        init_fn_preallocated(td->ext[i], ext, domain.order);
+
+        ext->set_active_element(neighbor_data.e);
+        domain.neighbor_transformations.apply_on(ext);
+        init_fn_preallocated(td->ext_neighbor[i], ext, domain.neighbor_order);
+        if (domain.orientation)
+          reverse_points(td->ext_neighbor[i]);
+        td->dg_ext[i]->np = np;
+      }
+    }
+
+    template<typename Scalar>
+    template<typename MatrixFormType, typename GeomType>
+    void DiscreteProblemDGMatrixFree<Scalar>::evaluate_matrix_form(ThreadData* td, MatrixFormType* form, IntegrationDomain& domain, ElementData& data, GeomType* geometry, double factor, Scalar* direction, Scalar* target)
+    {
+      unsigned char np = domain.np;
+      double* wt = &domain.jacobian_x_weights[0];
+      Func<Scalar>** ext = td->ext.empty() ? nullptr : &td->ext[0];
+
+      unsigned int i = form->i, j = form->j;
+      const int* dofs_i = &this->dofs[data.al_offset[i]], *dofs_j = &this->dofs[data.al_offset[j]];
+      const Scalar* coefs_i = &this->coefs[data.al_offset[i]], *coefs_j = &this->coefs[data.al_offset[j]];
+      bool tra = (i != j) && (form->sym != 0);
+
+      for (unsigned char part = 0; part < ScalarParts<Scalar>::count; part++)
+      {
+        Scalar coefficient = ScalarParts<Scalar>::unit(part) * form->scaling_factor * factor;
+
+        // Block (i, j): the argument restricted to the space j, tested by the basis of the space i.
+        combine_shape_functions_part(td->argument, np, data.cnt[j], dofs_j, coefs_j, direction, part,
+          &domain.val[domain.offset[j]], &domain.dx[domain.offset[j]], &domain.dy[domain.offset[j]]);
+        for (unsigned short a = 0; a < data.cnt[i]; a++)
+        {
+          if (dofs_i[a] < 0)
+            continue;
+          unsigned int fn_offset = domain.offset[i] + a * np;
+          load_shape_function(td->fn, np, &domain.val[fn_offset], &domain.dx[fn_offset], &domain.dy[fn_offset]);
+          target[dofs_i[a]] += coefficient * coefs_i[a] * form->value(np, wt, td->u_ext, td->argument, td->fn, geometry, ext);
+        }
+
+        // (Anti-)symmetric block (j, i).
+        if (tra)
+        {
+          combine_shape_functions_part(td->argument, np, data.cnt[i], dofs_i, coefs_i, direction, part,
+            &domain.val[domain.offset[i]], &domain.dx[domain.offset[i]], &domain.dy[domain.offset[i]]);
+          for (unsigned short b = 0; b < data.cnt[j]; b++)
+          {
+            if (dofs_j[b] < 0)
+              continue;
+            unsigned int fn_offset = domain.offset[j] + b * np;
+            load_shape_function(td->fn, np, &domain.val[fn_offset], &domain.dx[fn_offset], &domain.dy[fn_offset]);
+            target[dofs_j[b]] += (double)form->sym * coefficient * coefs_j[b] * form->value(np, wt, td->u_ext, td->fn, td->argument, geometry, ext);
+          }
+        }
+      }
+    }
+
+    template<typename Scalar>
+    template<typename VectorFormType, typename GeomType>
+    void DiscreteProblemDGMatrixFree<Scalar>::evaluate_vector_form(ThreadData* td, VectorFormType* form, IntegrationDomain& domain, ElementData& data, GeomType* geometry, double factor, Scalar* target)
+    {
+      unsigned char np = domain.np;
+      double* wt = &domain.jacobian_x_weights[0];
+      Func<Scalar>** ext = td->ext.empty() ? nullptr : &td->ext[0];
+
+      unsigned int i = form->i;
+      const int* dofs_i = &this->dofs[data.al_offset[i]];
+      const Scalar* coefs_i = &this->coefs[data.al_offset[i]];
+
+      for (unsigned short a = 0; a < data.cnt[i]; a++)
+      {
+        if (dofs_i[a] < 0)
+          continue;
+        unsigned int fn_offset = domain.offset[i] + a * np;
+        load_shape_function(td->fn, np, &domain.val[fn_offset], &domain.dx[fn_offset], &domain.dy[fn_offset]);
+        target[dofs_i[a]] += factor * form->value(np, wt, td->u_ext, td->fn, geometry, ext) * form->scaling_factor * coefs_i[a];
+      }
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::evaluate_element(ThreadData* td, unsigned int element_i, Scalar* coeff_vec, Scalar* direction, Scalar* target)
+    {
+      ElementData& data = this->elements[element_i];
+      WeakForm<Scalar>* wf = td->wf.get();
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+        td->elements[i] = data.e;
+
+      // Interior.
+      IntegrationDomain& volume = this->domains[data.volume];
+      wf->set_active_state(td->elements);
+      this->load_domain(td, volume, coeff_vec, false);
+      if (direction)
+      {
+        for (unsigned short form_i = 0; form_i < wf->mfvol.size(); form_i++)
+          if (this->form_to_be_assembled(wf->mfvol[form_i], data.e->marker, false))
+            this->evaluate_matrix_form(td, wf->mfvol[form_i], volume, data, &td->geometry, 1.0, direction, target);
+      }
+      else
+      {
+        for (unsigned short form_i = 0; form_i < wf->vfvol.size(); form_i++)
+          if (this->form_to_be_assembled(wf->vfvol[form_i], data.e->marker, false))
+            this->evaluate_vector_form(td, wf->vfvol[form_i], volume, data, &td->geometry, 1.0, target);
+      }
+
+      // Boundary edges.
+      for (unsigned int edge_i = 0; edge_i < data.boundary_edges.size(); edge_i++)
+      {
+        IntegrationDomain& edge = this->domains[data.boundary_edges[edge_i]];
+        int marker = data.e->en[edge.isurf]->marker;
+        wf->set_active_edge_state(td->elements, edge.isurf);
+        this->load_domain(td, edge, coeff_vec, true);
+        if (direction)
+        {
+          for (unsigned short form_i = 0; form_i < wf->mfsurf.size(); form_i++)
+            if (this->form_to_be_assembled(wf->mfsurf[form_i], marker, true))
+              this->evaluate_matrix_form(td, wf->mfsurf[form_i], edge, data, &td->geometry_surface, 0.5, direction, target);
+        }
+        else
+        {
+          for (unsigned short form_i = 0; form_i < wf->vfsurf.size(); form_i++)
+            if (this->form_to_be_assembled(wf->vfsurf[form_i], marker, true))
+              this->evaluate_vector_form(td, wf->vfsurf[form_i], edge, data, &td->geometry_surface, 0.5, target);
+        }
+      }
+
+      // DG vector forms - evaluated from every side of every inner edge, they only touch the central element.
+      if (direction || wf->vfDG.empty())
+        return;
+
+      DiscontinuousFunc<Scalar>** ext = td->dg_ext.empty() ? nullptr : &td->dg_ext[0];
+      for (unsigned int edge_i = 0; edge_i < data.inner_edges.size(); edge_i++)
+      {
+        IntegrationDomain& edge = this->domains[data.inner_edges[edge_i]];
+        unsigned char np = edge.np;
+        double* wt = &edge.jacobian_x_weights[0];
+
+        wf->set_active_DG_state(td->elements, edge.isurf);
+        this->load_inner_edge(td, edge, coeff_vec);
+        InterfaceGeom<double> geometry(&td->geometry_surface, data.e, this->elements[edge.neighbor_index].e);
+
+        for (unsigned short form_i = 0; form_i < wf->vfDG.size(); form_i++)
+        {
+          VectorFormDG<Scalar>* form = wf->vfDG[form_i];
+          if (form->areas[0] != H2D_DG_INNER_EDGE || fabs(form->scaling_factor) < Hermes::HermesSqrtEpsilon)
+            continue;
+
+          unsigned int i = form->i;
+          const int* dofs_i = &this->dofs[data.al_offset[i]];
+          const Scalar* coefs_i = &this->coefs[data.al_offset[i]];
+          for (unsigned short a = 0; a < data.cnt[i]; a++)
+          {
+            if (dofs_i[a] < 0)
+              continue;
+            unsigned int fn_offset = edge.offset[i] + a * np;
+            load_shape_function(td->fn, np, &edge.val[fn_offset], &edge.dx[fn_offset], &edge.dy[fn_offset]);
+            target[dofs_i[a]] += 0.5 * form->value(np, wt, td->dg_u_ext, td->fn, &geometry, ext) * form->scaling_factor * coefs_i[a];
+          }
+        }
+      }
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::evaluate_inner_edge(ThreadData* td, unsigned int domain_i, Scalar* coeff_vec, Scalar* direction, Scalar* target)
+    {
+      IntegrationDomain& edge = this->domains[domain_i];
+      ElementData& data = this->elements[edge.element_index];
+      ElementData& neighbor_data = this->elements[edge.neighbor_index];
+      WeakForm<Scalar>* wf = td->wf.get();
+      for (unsigned short i = 0; i < this->spaces_size; i++)
+        td->elements[i] = data.e;
+
+      unsigned char np = edge.np;
+      double* wt = &edge.jacobian_x_weights[0];
+      DiscontinuousFunc<Scalar>** ext = td->dg_ext.empty() ? nullptr : &td->dg_ext[0];
+
+      wf->set_active_DG_state(td->elements, edge.isurf);
+      this->load_inner_edge(td, edge, coeff_vec);
+      InterfaceGeom<double> geometry(&td->geometry_surface, data.e, neighbor_data.e);
+      td->dg_fn->np = td->dg_fn_neighbor->np = td->dg_argument->np = td->dg_argument_neighbor->np = np;
+
+      for (unsigned short form_i = 0; form_i < wf->mfDG.size(); form_i++)
+      {
+        MatrixFormDG<Scalar>* form = wf->mfDG[form_i];
+        if (fabs(form->scaling_factor) < Hermes::HermesSqrtEpsilon)
+          continue;
+
+        unsigned int m = form->i, n = form->j;
+        for (unsigned char part = 0; part < ScalarParts<Scalar>::count; part++)
+        {
+          Scalar coefficient = 0.5 * ScalarParts<Scalar>::unit(part) * form->scaling_factor;
+
+          // The argument on both sides, each of them extended by zero to the other element - the forms
+          // distinguish the side of the support by fn_central / fn_neighbor.
+          combine_shape_functions_part(td->argument, np, data.cnt[n], &this->dofs[data.al_offset[n]], &this->coefs[data.al_offset[n]], direction, part,
+            &edge.val[edge.offset[n]], &edge.dx[edge.offset[n]], &edge.dy[edge.offset[n]]);
+          combine_shape_functions_part(td->argument_neighbor, np, neighbor_data.cnt[n], &this->dofs[neighbor_data.al_offset[n]], &this->coefs[neighbor_data.al_offset[n]], direction, part,
+            &edge.val_neighbor[edge.offset_neighbor[n]], &edge.dx_neighbor[edge.offset_neighbor[n]], &edge.dy_neighbor[edge.offset_neighbor[n]]);
+
+          // Test functions on the central element.
+          const int* dofs_m = &this->dofs[data.al_offset[m]];
+          const Scalar* coefs_m = &this->coefs[data.al_offset[m]];
+          for (unsigned short a = 0; a < data.cnt[m]; a++)
+          {
+            if (dofs_m[a] < 0)
+              continue;
+            unsigned int fn_offset = edge.offset[m] + a * np;
+            load_shape_function(td->fn, np, &edge.val[fn_offset], &edge.dx[fn_offset], &edge.dy[fn_offset]);
+            Scalar value = form->value(np, wt, td->dg_u_ext, td->dg_argument, td->dg_fn, &geometry, ext)
+              + form->value(np, wt, td->dg_u_ext, td->dg_argument_neighbor, td->dg_fn, &geometry, ext);
+            target[dofs_m[a]] += coefficient * coefs_m[a] * value;
+          }
+
+          // Test functions on the neighbor element.
+          dofs_m = &this->dofs[neighbor_data.al_offset[m]];
+          coefs_m = &this->coefs[neighbor_data.al_offset[m]];
+          for (unsigned short a = 0; a < neighbor_data.cnt[m]; a++)
+          {
+            if (dofs_m[a] < 0)
+              continue;
+            unsigned int fn_offset = edge.offset_neighbor[m] + a * np;
+            load_shape_function(td->fn_neighbor, np, &edge.val_neighbor[fn_offset], &edge.dx_neighbor[fn_offset], &edge.dy_neighbor[fn_offset]);
+            Scalar value = form->value(np, wt, td->dg_u_ext, td->dg_argument, td->dg_fn_neighbor, &geometry, ext)
+              + form->value(np, wt, td->dg_u_ext, td->dg_argument_neighbor, td->dg_fn_neighbor, &geometry, ext);
+            target[dofs_m[a]] += coefficient * coefs_m[a] * value;
+          }
+        }
+      }
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::evaluate(Scalar* coeff_vec, Scalar* direction, Scalar* target)
+    {
+      this->update();
+      memset(target, 0, this->ndof * sizeof(Scalar));
+      this->exceptionMessageCaughtInParallelBlock.clear();
+
+      int num_elements = this->elements.size();
+      bool DG_matrix_forms = direction && !this->wf->mfDG.empty();
+
+#pragma omp parallel num_threads(this->num_threads_used)
+      {
+        int thread_number = omp_get_thread_num();
+        ThreadData* td = this->thread_data[thread_number];
+
+        // Elements - DOFs are element-local, no conflicts.
+        int start = (num_elements / this->num_threads_used) * thread_number;
+        int end = (num_elements / this->num_threads_used) * (thread_number + 1);
+        if (thread_number == this->num_threads_used - 1)
+          end = num_elements;
+
+        try
+        {
+          for (int element_i = start; element_i < end; element_i++)
+          {
+            // Exception already thrown -> exit the loop.
+            if (!this->exceptionMessageCaughtInParallelBlock.empty())
+              break;
+            this->evaluate_element(td, element_i, coeff_vec, direction, target);
+          }
+        }
+        catch (Hermes::Exceptions::Exception& e)
+        {
+#pragma omp critical (exceptionMessageCaughtInParallelBlock)
+          this->exceptionMessageCaughtInParallelBlock = e.info();
+        }
+        catch (std::exception& e)
+        {
+#pragma omp critical (exceptionMessageCaughtInParallelBlock)
+          this->exceptionMessageCaughtInParallelBlock = e.what();
+        }
+
+        // Inner edges - one color after another, edges of one color do not share elements.
+        if (DG_matrix_forms)
+        {
+          for (unsigned int color = 0; color < this->edge_colors.size(); color++)
+          {
+#pragma omp barrier
+            std::vector<unsigned int>& edges = this->edge_colors[color];
+            int num_edges = edges.size();
+            start = (num_edges / this->num_threads_used) * thread_number;
+            end = (num_edges / this->num_threads_used) * (thread_number + 1);
+            if (thread_number == this->num_threads_used - 1)
+              end = num_edges;
+
+            try
+            {
+              for (int edge_i = start; edge_i < end; edge_i++)
+              {
+                if (!this->exceptionMessageCaughtInParallelBlock.empty())
+                  break;
+                this->evaluate_inner_edge(td, edges[edge_i], coeff_vec, direction, target);
+              }
+            }
+            catch (Hermes::Exceptions::Exception& e)
+            {
+#pragma omp critical (exceptionMessageCaughtInParallelBlock)
+              this->exceptionMessageCaughtInParallelBlock = e.info();
+            }
+            catch (std::exception& e)
+            {
+#pragma omp critical (exceptionMessageCaughtInParallelBlock)
+              this->exceptionMessageCaughtInParallelBlock = e.what();
+            }
+          }
+        }
+      }
+
+      if (!this->exceptionMessageCaughtInParallelBlock.empty())
+        throw Hermes::Exceptions::Exception(this->exceptionMessageCaughtInParallelBlock.c_str());
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::assemble_residual(Scalar* coeff_vec, Scalar* residual)
+    {
+      this->tick();
+      this->evaluate(coeff_vec, nullptr, residual);
+      this->tick();
+      this->info("DiscreteProblemDGMatrixFree: residual evaluated in %s.", this->last_str().c_str());
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemDGMatrixFree<Scalar>::apply_jacobian(Scalar* coeff_vec, Scalar* direction, Scalar* result)
+    {
+      if (!direction)
+        throw Exceptions::NullException(2);
+
+      this->tick();
+      this->evaluate(coeff_vec, direction, result);
+      this->tick();
+      this->info("DiscreteProblemDGMatrixFree: operator applied in %s.", this->last_str().c_str());
+    }
+
+    template class HERMES_API DiscreteProblemDGMatrixFree < double > ;
+    template class HERMES_API DiscreteProblemDGMatrixFree < std::complex<double> > ;
+  }
+}
@@ -54,10 +54,16 @@ namespace Hermes
     void DiscreteProblem<Scalar>::init(bool to_set, bool dirichlet_lift_accordingly, bool use_direct_for_Dirichlet_lift)
     {
       this->reassembled_states_reuse_linear_system = nullptr;
+      this->quadrature = &g_quad_2d_std;
+      this->collocated_quadrature = false;
+      this->specialized_kernels = true;
+      this->geometry_store = nullptr;
+      this->mesh_partition = nullptr;
 
       this->spaces_size = this->spaces.size();
 
       this->nonlinear = !to_set;
+      this->use_direct_for_Dirichlet_lift = use_direct_for_Dirichlet_lift;
       if (dirichlet_lift_accordingly)
         this->add_dirichlet_lift = !this->nonlinear;
       else
@@ -73,6 +79,8 @@ namespace Hermes
       this->threadAssembler = new DiscreteProblemThreadAssembler<Scalar>*[this->num_threads_used];
       for (int i = 0; i < this->num_threads_used; i++)
         this->threadAssembler[i] = new DiscreteProblemThreadAssembler<Scalar>(&this->selectiveAssembler, this->nonlinear);
+
+      omp_init_lock(&this->DG_visited_lock);
     }
 
     template<typename Scalar>
@@ -82,8 +90,16 @@ namespace Hermes
         delete this->threadAssembler[i];
       delete[] this->threadAssembler;
 
+      omp_destroy_lock(&this->DG_visited_lock);
+
       if (this->dirichlet_lift_rhs)
         delete this->dirichlet_lift_rhs;
+
+      if (this->geometry_store)
+        delete this->geometry_store;
+
+      if (this->mesh_partition)
+        delete this->mesh_partition;
     }
 
     template<typename Scalar>
@@ -132,6 +148,160 @@ namespace Hermes
       return this->spaces;
     }
 
+    template<typename Scalar>
+    void DiscreteProblem<Scalar>::set_num_threads(int num_threads)
+    {
+      if (num_threads < 1 || num_threads > 255)
+        throw Exceptions::ValueException("num_threads", num_threads, 1, 255);
+      if (num_threads == this->num_threads_used)
+        return;
+
+      for (int i = 0; i < this->num_threads_used; i++)
+        delete this->threadAssembler[i];
+      delete[] this->threadAssembler;
+
+      this->num_threads_used = num_threads;
+      this->threadAssembler = new DiscreteProblemThreadAssembler<Scalar>*[this->num_threads_used];
+      for (int i = 0; i < this->num_threads_used; i++)
+      {
+        this->threadAssembler[i] = new DiscreteProblemThreadAssembler<Scalar>(&this->selectiveAssembler, this->nonlinear);
+        if (this->spaces_size > 0)
+          this->threadAssembler[i]->init_spaces(this->spaces);
+        if (this->rungeKutta)
+          this->threadAssembler[i]->set_RK(this->RK_original_spaces_count, this->force_diagonal_blocks, this->block_weights);
+        this->threadAssembler[i]->set_matrix(this->current_mat);
+        this->threadAssembler[i]->set_rhs(this->current_rhs);
+        this->threadAssembler[i]->dirichlet_lift_rhs = this->dirichlet_lift_rhs;
+        this->threadAssembler[i]->set_quadrature(this->quadrature);
+        this->threadAssembler[i]->set_collocated_quadrature(this->collocated_quadrature);
+        this->threadAssembler[i]->specialized_kernels = this->specialized_kernels;
+        this->threadAssembler[i]->geometry_store = this->geometry_store;
+      }
+    }
+
+    template<typename Scalar>
+    void DiscreteProblem<Scalar>::set_quadrature(Quad2D* quadrature)
+    {
+      if (!quadrature)
+        throw Exceptions::NullException(1);
+      this->quadrature = quadrature;
+      for (int i = 0; i < this->num_threads_used; i++)
+        this->threadAssembler[i]->set_quadrature(quadrature);
+    }
+
+    template<typename Scalar>
+    Quad2D* DiscreteProblem<Scalar>::get_quadrature() const
+    {
+      return this->quadrature;
+    }
+
+    template<typename Scalar>
+    void DiscreteProblem<Scalar>::set_collocated_quadrature(bool to_set)
+    {
+      this->collocated_quadrature = to_set;
+      for (int i = 0; i < this->num_threads_used; i++)
+        this->threadAssembler[i]->set_collocated_quadrature(to_set);
+    }
+
+    template<typename Scalar>
+    void DiscreteProblem<Scalar>::set_specialized_kernels(bool to_set)
+    {
+      this->specialized_kernels = to_set;
+      for (int i = 0; i < this->num_threads_used; i++)
+        this->threadAssembler[i]->specialized_kernels = to_set;
+    }
+
+    template<typename Scalar>
+    void DiscreteProblem<Scalar>::set_geometry_store(bool to_set)
+    {
+      if (to_set && !this->geometry_store)
+        this->geometry_store = new GeometryStore();
+      if (!to_set && this->geometry_store)
+      {
+        delete this->geometry_store;
+        this->geometry_store = nullptr;
+      }
+
+      for (int i = 0; i < this->num_threads_used; i++)
+        this->threadAssembler[i]->geometry_store = this->geometry_store;
+    }
+
+    template<typename Scalar>
+    const GeometryStore* DiscreteProblem<Scalar>::get_geometry_store() const
+    {
+      return this->geometry_store;
+    }
+
+    template<typename Scalar>
+    void DiscreteProblem<Scalar>::set_mesh_partition(MeshSharedPtr mesh)
+    {
+      if (this->mesh_partition)
+        delete this->mesh_partition;
+      this->mesh_partition = mesh ? new MeshPartition(mesh) : nullptr;
+
+      // The sparse structure is the one of the states of this rank.
+      this->invalidate_matrix();
+    }
+
+    template<typename Scalar>
+    const MeshPartition* DiscreteProblem<Scalar>::get_mesh_partition() const
+    {
+      return this->mesh_partition;
+    }
+
+    template<typename Scalar>
+    void DiscreteProblem<Scalar>::select_owned_states(Traverse::State** states, unsigned int& num_states)
+    {
+      unsigned int num_owned_states = 0;
+      for (unsigned int state_i = 0; state_i < num_states; state_i++)
+      {
+        if (this->mesh_partition->is_owned(states[state_i]->rep))
+          states[num_owned_states++] = states[state_i];
+        else
+          delete states[state_i];
+      }
+      num_states = num_owned_states;
+    }
+
+    template<typename Scalar>
+    void DiscreteProblem<Scalar>::set_matrix_distributed(SparseMatrix<Scalar>* mat)
+    {
+      if (!mat)
+        return;
+
+#ifdef WITH_MUMPS
+      MumpsMatrix<Scalar>* mumps_mat = dynamic_cast<MumpsMatrix<Scalar>*>(mat);
+      if (mumps_mat)
+      {
+        mumps_mat->set_distributed(this->mesh_partition != nullptr);
+        return;
+      }
+#endif
+
+      if (this->mesh_partition)
+        throw Exceptions::Exception("DiscreteProblem: the distributed assembling (set_mesh_partition()) needs the MUMPS matrix solver.");
+    }
+
+    template<typename Scalar>
+    void DiscreteProblem<Scalar>::sum_distributed_vector(Vector<Scalar>* vec)
+    {
+      if (!vec)
+        return;
+
+      unsigned int size = vec->get_size();
+      Scalar* values = malloc_with_check<Scalar>(size);
+      vec->extract(values);
+      MpiCommunication::sum(values, size);
+      vec->set_vector(values);
+      free_with_check(values);
+    }
+
+    template<typename Scalar>
+    const AssemblyStatistics& DiscreteProblem<Scalar>::get_assembly_statistics() const
+    {
+      return this->assembly_statistics;
+    }
+
     template<typename Scalar>
     void DiscreteProblem<Scalar>::set_RK(int original_spaces_count, bool force_diagonal_blocks_, Table* block_weights_)
     {
@@ -248,6 +418,7 @@ namespace Hermes
     template<typename Scalar>
     void DiscreteProblem<Scalar>::init_assembling(Traverse::State**& states, unsigned int& num_states, std::vector<MeshSharedPtr>& meshes)
     {
+      HERMES_PROFILE_REGION("DiscreteProblem::init_assembling");
       // Vector of meshes.
       for (unsigned int space_i = 0; space_i < spaces.size(); space_i++)
         meshes.push_back(spaces[space_i]->get_mesh());
@@ -264,16 +435,35 @@ namespace Hermes
           meshes.push_back(spaces[space_i]->get_mesh());
       }
 
+      // Parameter sweep - external functions of the variants, in the same order as in DiscreteProblemThreadAssembler::init_assembling().
+      for (unsigned short variant_i = 0; variant_i < this->wf_variants.size(); variant_i++)
+      {
+        WeakFormSharedPtr<Scalar> wf_variant = this->wf_variants[variant_i];
+        for (unsigned int ext_i = 0; ext_i < wf_variant->ext.size(); ext_i++)
+          meshes.push_back(wf_variant->ext[ext_i]->get_mesh());
+        for (unsigned int form_i = 0; form_i < wf_variant->get_forms().size(); form_i++)
+          for (unsigned int ext_i = 0; ext_i < wf_variant->get_forms()[form_i]->ext.size(); ext_i++)
+            if (wf_variant->get_forms()[form_i]->ext[ext_i])
+              meshes.push_back(wf_variant->get_forms()[form_i]->ext[ext_i]->get_mesh());
+      }
+
       // Important.
       // This must be here, because the weakforms may have changed since set_weak_formulation (where the following calls
       // used to be in development). And since the following clones the passed WeakForm, this has to be called
       // only after the weak forms are ready for calculation.
       for (unsigned char i = 0; i < this->num_threads_used; i++)
+      {
         this->threadAssembler[i]->set_weak_formulation(this->wf);
+        this->threadAssembler[i]->set_weak_formulation_variants(this->wf, this->wf_variants);
+      }
 
       Traverse trav(this->spaces_size);
       states = trav.get_states(meshes, num_states);
 
+      // The stored geometry is only valid for unchanged meshes.
+      if (this->geometry_store)
+        this->geometry_store->validate(meshes);
+
       // Init the caught parallel exception message.
       this->exceptionMessageCaughtInParallelBlock.clear();
 
@@ -282,24 +472,39 @@ namespace Hermes
       {
         unsigned int ndof = Space<Scalar>::get_num_dofs(spaces);
         this->dirichlet_lift_rhs->alloc(ndof);
+        for (unsigned short variant_i = 0; variant_i < this->dirichlet_lift_rhs_variants.size(); variant_i++)
+          if (this->dirichlet_lift_rhs_variants[variant_i])
+            this->dirichlet_lift_rhs_variants[variant_i]->alloc(ndof);
       }
     }
 
     template<typename Scalar>
     bool DiscreteProblem<Scalar>::assemble(Scalar*& coeff_vec, SparseMatrix<Scalar>* mat, Vector<Scalar>* rhs)
     {
+      HERMES_PROFILE_REGION("DiscreteProblem::assemble");
       // Check.
       this->check();
       this->tick();
+      Hermes::Mixins::TimeMeasurable assembly_time;
+      this->assembly_statistics = AssemblyStatistics();
 
       // Set the matrices.
       bool result = this->set_matrix(mat) && this->set_rhs(rhs);
 
+      // Distributed assembling.
+      if (this->mesh_partition && this->wf->is_DG())
+        throw Exceptions::Exception("DiscreteProblem: DG forms can not be assembled distributed (set_mesh_partition()).");
+      this->set_matrix_distributed(this->current_mat);
+      for (unsigned short variant_i = 0; variant_i < this->wf_variants.size(); variant_i++)
+        this->set_matrix_distributed(this->mat_variants[variant_i]);
+
       // Initialize states && previous iterations.
       unsigned int num_states;
       Traverse::State** states;
       std::vector<MeshSharedPtr> meshes;
       this->init_assembling(states, num_states, meshes);
+      if (this->mesh_partition)
+        this->select_owned_states(states, num_states);
       this->tick();
       this->info("\tDiscreteProblem: Initialization: %s.", this->last_str().c_str());
       this->tick();
@@ -311,8 +516,13 @@ namespace Hermes
         this->tick();
         this->info("\tDiscreteProblem: Prepare sparse structure: %s.", this->last_str().c_str());
 
+        // Parameter sweep - all matrices share the structure.
+        bool assemble_variants = !this->wf_variants.empty();
+        if (assemble_variants)
+          this->prepare_sparse_structure_variants();
+
         // The following does not make much sense to do just for rhs)
-        if (this->current_mat && this->reassembled_states_reuse_linear_system)
+        if (this->current_mat && this->reassembled_states_reuse_linear_system && !assemble_variants)
           this->reassembled_states_reuse_linear_system(states, num_states, this->current_mat, this->current_rhs, this->dirichlet_lift_rhs, coeff_vec);
 
         Solution<Scalar>** u_ext_sln = nullptr;
@@ -333,21 +543,26 @@ namespace Hermes
           // Is this a DG assembling.
           bool is_DG = this->wf->is_DG();
 
+          // The shared caches (precalculated shapesets, geometry store) must not be evicted during the assembling.
+          // No exception leaves the parallel block.
+          HermesCommonApi.begin_cache_use();
 #pragma omp parallel num_threads(this->num_threads_used)
           {
+            HERMES_PROFILE_REGION("DiscreteProblem::assemble_states");
             int thread_number = omp_get_thread_num();
             int start = (num_states / this->num_threads_used) * thread_number;
             int end = (num_states / this->num_threads_used) * (thread_number + 1);
             if (thread_number == this->num_threads_used - 1)
               end = num_states;
 
+            Hermes::Mixins::TimeMeasurable thread_time;
             try
             {
               this->threadAssembler[thread_number]->init_assembling(u_ext_sln, spaces, this->add_dirichlet_lift);
 
               DiscreteProblemDGAssembler<Scalar>* dgAssembler;
               if (is_DG)
-                dgAssembler = new DiscreteProblemDGAssembler<Scalar>(this->threadAssembler[thread_number], this->spaces, meshes);
+                dgAssembler = new DiscreteProblemDGAssembler<Scalar>(this->threadAssembler[thread_number], this->spaces, meshes, &this->DG_visited_lock);
 
               for (int state_i = start; state_i < end; state_i++)
               {
@@ -359,7 +574,10 @@ namespace Hermes
 
                 this->threadAssembler[thread_number]->init_assembling_one_state(spaces, current_state);
 
-                this->threadAssembler[thread_number]->assemble_one_state();
+                if (assemble_variants)
+                  this->threadAssembler[thread_number]->assemble_one_state_variants(&this->mat_variants[0], &this->rhs_variants[0], &this->dirichlet_lift_rhs_variants[0]);
+                else
+                  this->threadAssembler[thread_number]->assemble_one_state();
 
                 if (is_DG)
                 {
@@ -385,6 +603,14 @@ namespace Hermes
 #pragma omp critical (exceptionMessageCaughtInParallelBlock)
               this->exceptionMessageCaughtInParallelBlock = e.what();
             }
+            this->threadAssembler[thread_number]->statistics.time = thread_time.tick().last();
+          }
+          HermesCommonApi.end_cache_use();
+
+          for (int i = 0; i < this->num_threads_used; i++)
+          {
+            this->assembly_statistics.threads.push_back(this->threadAssembler[i]->statistics);
+            this->assembly_statistics.add(this->threadAssembler[i]->statistics);
           }
         }
 
@@ -399,6 +625,7 @@ namespace Hermes
       this->tick();
 
       // Deinitialize states && previous iterations.
+      HERMES_PROFILE_REGION("DiscreteProblem::finish");
       this->deinit_assembling(states, num_states);
 
       // Finish the algebraic structures for solving.
@@ -406,10 +633,34 @@ namespace Hermes
         this->current_mat->finish();
       if (this->current_rhs)
         this->current_rhs->finish();
+      for (unsigned short variant_i = 0; variant_i < this->wf_variants.size(); variant_i++)
+      {
+        if (this->mat_variants[variant_i])
+          this->mat_variants[variant_i]->finish();
+        if (this->rhs_variants[variant_i])
+          this->rhs_variants[variant_i]->finish();
+      }
+
+      if (this->current_mat)
+        this->assembly_statistics.structural_nonzeros = this->current_mat->get_nnz();
 
       if (!this->exceptionMessageCaughtInParallelBlock.empty())
         throw Hermes::Exceptions::Exception(this->exceptionMessageCaughtInParallelBlock.c_str());
 
+      // Distributed assembling - the vectors are summed here, the matrices by the solver.
+      if (this->mesh_partition)
+      {
+        this->sum_distributed_vector(this->current_rhs);
+        if (this->add_dirichlet_lift)
+          this->sum_distributed_vector(this->dirichlet_lift_rhs);
+        for (unsigned short variant_i = 0; variant_i < this->wf_variants.size(); variant_i++)
+        {
+          this->sum_distributed_vector(this->rhs_variants[variant_i]);
+          if (this->add_dirichlet_lift)
+            this->sum_distributed_vector(this->dirichlet_lift_rhs_variants[variant_i]);
+        }
+      }
+
       Element* e;
       for (unsigned int space_i = 0; space_i < spaces.size(); space_i++)
       {
@@ -423,9 +674,118 @@ namespace Hermes
       this->tick();
       this->info("\tDiscreteProblem: De-initialization: %s.", this->last_str().c_str());
 
+      this->assembly_statistics.time = assembly_time.tick().last();
+      this->info("\tDiscreteProblem: %u states, %llu form evaluations, %llu quadrature points, thread load imbalance %.2f.", this->assembly_statistics.states,
+        this->assembly_statistics.form_evaluations, this->assembly_statistics.quadrature_points, this->assembly_statistics.get_load_imbalance());
+
       return result;
     }
 
+    template<typename Scalar>
+    void DiscreteProblem<Scalar>::calibrate_integration_orders(double tolerance, Scalar* coeff_vec, unsigned short samples_per_marker)
+    {
+      this->check();
+
+      unsigned int num_states;
+      Traverse::State** states;
+      std::vector<MeshSharedPtr> meshes;
+      this->init_assembling(states, num_states, meshes);
+
+      // Sample states, evenly spread over the states of every element marker.
+      std::map<int, std::vector<unsigned int> > marker_states;
+      for (unsigned int state_i = 0; state_i < num_states; state_i++)
+        marker_states[states[state_i]->rep->marker].push_back(state_i);
+
+      Solution<Scalar>** u_ext_sln = nullptr;
+      if (this->nonlinear && coeff_vec)
+      {
+        u_ext_sln = new Solution<Scalar>*[spaces_size];
+        int first_dof = 0;
+        for (int i = 0; i < this->spaces_size; i++)
+        {
+          u_ext_sln[i] = new Solution<Scalar>(spaces[i]->get_mesh());
+          Solution<Scalar>::vector_to_solution(coeff_vec, spaces[i], u_ext_sln[i], !this->rungeKutta, first_dof);
+          first_dof += spaces[i]->get_num_dofs();
+        }
+      }
+
+      // Per volumetric form (mfvol first, then vfvol) and marker the highest calibrated order over the samples.
+      unsigned short mfvol_size = this->wf->mfvol.size();
+      unsigned short forms_count = mfvol_size + this->wf->vfvol.size();
+      std::vector<std::map<int, int> > calibrated_orders(forms_count);
+      std::vector<int> state_orders(forms_count);
+
+      // Serial - this is a handful of elements.
+      DiscreteProblemThreadAssembler<Scalar>* assembler = this->threadAssembler[0];
+      try
+      {
+        assembler->init_assembling(u_ext_sln, spaces, false);
+        for (std::map<int, std::vector<unsigned int> >::iterator it = marker_states.begin(); it != marker_states.end(); ++it)
+        {
+          unsigned int step = std::max<unsigned int>(1, it->second.size() / std::max<unsigned short>(1, samples_per_marker));
+          for (unsigned int sample_i = 0; sample_i < it->second.size(); sample_i += step)
+          {
+            assembler->init_assembling_one_state(spaces, states[it->second[sample_i]]);
+            assembler->calibrate_one_state(tolerance, &state_orders[0]);
+            assembler->deinit_assembling_one_state();
+
+            for (unsigned short form_i = 0; form_i < forms_count; form_i++)
+            {
+              if (state_orders[form_i] < 0)
+                continue;
+              std::map<int, int>::iterator found = calibrated_orders[form_i].find(it->first);
+              if (found == calibrated_orders[form_i].end())
+                calibrated_orders[form_i][it->first] = state_orders[form_i];
+              else if (found->second < state_orders[form_i])
+                found->second = state_orders[form_i];
+            }
+          }
+        }
+        assembler->deinit_assembling();
+      }
+      catch (...)
+      {
+        for (unsigned int i = 0; i < num_states; i++)
+          delete states[i];
+        free_with_check(states);
+        if (u_ext_sln)
+        {
+          for (int i = 0; i < this->spaces_size; i++)
+            delete u_ext_sln[i];
+          delete[] u_ext_sln;
+        }
+        throw;
+      }
+
+      for (unsigned int i = 0; i < num_states; i++)
+        delete states[i];
+      free_with_check(states);
+      if (u_ext_sln)
+      {
+        for (int i = 0; i < this->spaces_size; i++)
+          delete u_ext_sln[i];
+        delete[] u_ext_sln;
+      }
+
+      // Store the caps in the forms of this->wf (the assemblers work with clones).
+      for (unsigned short form_i = 0; form_i < forms_count; form_i++)
+      {
+        Form<Scalar>* form = form_i < mfvol_size ? (Form<Scalar>*)this->wf->mfvol[form_i] : (Form<Scalar>*)this->wf->vfvol[form_i - mfvol_size];
+        for (std::map<int, int>::iterator it = calibrated_orders[form_i].begin(); it != calibrated_orders[form_i].end(); ++it)
+        {
+          Mesh::MarkersConversion::StringValid marker = spaces[form->i]->get_mesh()->get_element_markers_conversion().get_user_marker(it->first);
+          if (!marker.valid)
+            continue;
+          // A marker-specific setting replaces the default one - a new one starts as the default, so that only the cap changes.
+          if (form->integration_order_controls.find(marker.marker) == form->integration_order_controls.end())
+            form->integration_order_controls[marker.marker] = form->integration_order_control;
+          form->set_integration_order_cap(it->second, marker.marker);
+          this->info("\tDiscreteProblem: Integration order of the %s form %i in the area '%s' calibrated to %i.", form_i < mfvol_size ? "matrix" : "vector",
+            form_i < mfvol_size ? form_i : form_i - mfvol_size, marker.marker.c_str(), it->second);
+        }
+      }
+    }
+
     template<typename Scalar>
     void DiscreteProblem<Scalar>::deinit_assembling(Traverse::State** states, unsigned int num_states)
     {
@@ -436,6 +796,138 @@ namespace Hermes
       // Very important.
       if (this->add_dirichlet_lift && this->current_rhs)
         this->current_rhs->add_vector(this->dirichlet_lift_rhs);
+      for (unsigned short variant_i = 0; variant_i < this->wf_variants.size(); variant_i++)
+        if (this->dirichlet_lift_rhs_variants[variant_i])
+          this->rhs_variants[variant_i]->add_vector(this->dirichlet_lift_rhs_variants[variant_i]);
+    }
+
+    template<typename Scalar>
+    bool DiscreteProblem<Scalar>::assemble(std::vector<WeakFormSharedPtr<Scalar> > wfs, std::vector<SparseMatrix<Scalar>*> mats, std::vector<Vector<Scalar>*> rhss)
+    {
+      Scalar* coeff_vec = nullptr;
+      return assemble(coeff_vec, wfs, mats, rhss);
+    }
+
+    template<typename Scalar>
+    bool DiscreteProblem<Scalar>::assemble(Scalar*& coeff_vec, std::vector<WeakFormSharedPtr<Scalar> > wfs, std::vector<SparseMatrix<Scalar>*> mats, std::vector<Vector<Scalar>*> rhss)
+    {
+      this->check_weak_formulation_variants(wfs, mats, rhss);
+
+      // The first variant is the primary one - it drives the sparse structure and the state traversal.
+      if (this->wf != wfs[0])
+        this->set_weak_formulation(wfs[0]);
+
+      for (unsigned short variant_i = 1; variant_i < wfs.size(); variant_i++)
+      {
+        this->wf_variants.push_back(wfs[variant_i]);
+        this->mat_variants.push_back(mats.empty() ? nullptr : mats[variant_i]);
+        this->rhs_variants.push_back(rhss.empty() ? nullptr : rhss[variant_i]);
+        if (this->add_dirichlet_lift && !rhss.empty())
+          this->dirichlet_lift_rhs_variants.push_back(create_vector<Scalar>(this->use_direct_for_Dirichlet_lift));
+        else
+          this->dirichlet_lift_rhs_variants.push_back(nullptr);
+      }
+
+      bool result;
+      try
+      {
+        result = this->assemble(coeff_vec, mats.empty() ? nullptr : mats[0], rhss.empty() ? nullptr : rhss[0]);
+      }
+      catch (...)
+      {
+        this->free_weak_formulation_variants();
+        throw;
+      }
+
+      this->free_weak_formulation_variants();
+      return result;
+    }
+
+    template<typename Scalar>
+    void DiscreteProblem<Scalar>::check_weak_formulation_variants(std::vector<WeakFormSharedPtr<Scalar> >& wfs, std::vector<SparseMatrix<Scalar>*>& mats, std::vector<Vector<Scalar>*>& rhss)
+    {
+      if (wfs.empty())
+        throw Exceptions::ValueException("wfs.size()", 0, 1);
+      if (mats.empty() && rhss.empty())
+        throw Exceptions::Exception("Parameter sweep assembling: neither matrices nor vectors to assemble.");
+      if (!mats.empty())
+        Helpers::check_length(mats, wfs.size());
+      if (!rhss.empty())
+        Helpers::check_length(rhss, wfs.size());
+
+      for (unsigned short variant_i = 0; variant_i < mats.size(); variant_i++)
+      {
+        if (!mats[variant_i])
+          throw Exceptions::NullException(2, variant_i);
+        // The structure is copied as CS arrays.
+        if (!dynamic_cast<CSMatrix<Scalar>*>(mats[variant_i]))
+          throw Exceptions::Exception("Parameter sweep assembling: the matrices have to be CS (CSC / CSR) matrices.");
+        if ((dynamic_cast<CSCMatrix<Scalar>*>(mats[variant_i]) == nullptr) != (dynamic_cast<CSCMatrix<Scalar>*>(mats[0]) == nullptr))
+          throw Exceptions::Exception("Parameter sweep assembling: all matrices have to be of the same orientation (CSC / CSR).");
+      }
+      for (unsigned short variant_i = 0; variant_i < rhss.size(); variant_i++)
+        if (!rhss[variant_i])
+          throw Exceptions::NullException(3, variant_i);
+
+      for (unsigned short variant_i = 0; variant_i < wfs.size(); variant_i++)
+      {
+        if (!wfs[variant_i])
+          throw Exceptions::NullException(1, variant_i);
+        if (wfs[variant_i]->is_DG())
+          throw Exceptions::Exception("Parameter sweep assembling does not support DG forms.");
+
+        // The variants share one sparse structure and the Func storages of the thread assemblers.
+        WeakFormSharedPtr<Scalar> wf = wfs[0], wf_variant = wfs[variant_i];
+        bool compatible = wf->get_neq() == wf_variant->get_neq()
+          && wf->ext.size() == wf_variant->ext.size()
+          && wf->u_ext_fn.size() == wf_variant->u_ext_fn.size()
+          && wf->mfvol.size() == wf_variant->mfvol.size()
+          && wf->mfsurf.size() == wf_variant->mfsurf.size()
+          && wf->vfvol.size() == wf_variant->vfvol.size()
+          && wf->vfsurf.size() == wf_variant->vfsurf.size();
+
+        for (unsigned short form_i = 0; compatible && form_i < wf->mfvol.size(); form_i++)
+          compatible = wf->mfvol[form_i]->i == wf_variant->mfvol[form_i]->i && wf->mfvol[form_i]->j == wf_variant->mfvol[form_i]->j && wf->mfvol[form_i]->sym == wf_variant->mfvol[form_i]->sym;
+        for (unsigned short form_i = 0; compatible && form_i < wf->mfsurf.size(); form_i++)
+          compatible = wf->mfsurf[form_i]->i == wf_variant->mfsurf[form_i]->i && wf->mfsurf[form_i]->j == wf_variant->mfsurf[form_i]->j;
+
+        std::vector<Form<Scalar>*> forms = wf->get_forms(), forms_variant = wf_variant->get_forms();
+        for (unsigned short form_i = 0; compatible && form_i < forms.size(); form_i++)
+          compatible = forms[form_i]->i == forms_variant[form_i]->i && forms[form_i]->ext.size() == forms_variant[form_i]->ext.size() && forms[form_i]->u_ext_fn.size() == forms_variant[form_i]->u_ext_fn.size();
+
+        if (!compatible)
+          throw Exceptions::Exception("Parameter sweep assembling: weak formulation variant %i does not have the structure of the first one.", variant_i);
+      }
+    }
+
+    template<typename Scalar>
+    void DiscreteProblem<Scalar>::prepare_sparse_structure_variants()
+    {
+      int ndof = Space<Scalar>::get_num_dofs(this->spaces);
+
+      for (unsigned short variant_i = 0; variant_i < this->wf_variants.size(); variant_i++)
+      {
+        if (this->mat_variants[variant_i])
+          dynamic_cast<CSMatrix<Scalar>*>(this->mat_variants[variant_i])->alloc_with_structure(dynamic_cast<CSMatrix<Scalar>*>(this->current_mat));
+        if (this->rhs_variants[variant_i])
+          this->rhs_variants[variant_i]->alloc(ndof);
+      }
+    }
+
+    template<typename Scalar>
+    void DiscreteProblem<Scalar>::free_weak_formulation_variants()
+    {
+      for (unsigned short variant_i = 0; variant_i < this->dirichlet_lift_rhs_variants.size(); variant_i++)
+        if (this->dirichlet_lift_rhs_variants[variant_i])
+          delete this->dirichlet_lift_rhs_variants[variant_i];
+
+      this->wf_variants.clear();
+      this->mat_variants.clear();
+      this->rhs_variants.clear();
+      this->dirichlet_lift_rhs_variants.clear();
+
+      for (int i = 0; i < this->num_threads_used; i++)
+        this->threadAssembler[i]->free_weak_formulation_variants();
     }
 
     template class HERMES_API DiscreteProblem < double > ;
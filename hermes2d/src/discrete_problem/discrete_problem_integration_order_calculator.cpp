@@ -73,7 +73,8 @@ namespace Hermes
     DiscreteProblemIntegrationOrderCalculator<Scalar>::DiscreteProblemIntegrationOrderCalculator(DiscreteProblemSelectiveAssembler<Scalar>* selectiveAssembler) :
       selectiveAssembler(selectiveAssembler),
       current_state(nullptr),
-      u_ext(nullptr)
+      u_ext(nullptr),
+      arena(nullptr)
     {
     }
 
@@ -150,21 +151,9 @@ namespace Hermes
             if (order < orderTemp)
               order = orderTemp;
           }
-
-          // deinit - u_ext_func
-          this->deinit_u_ext_orders(u_ext_funcSurf);
-
-          // deinit - ext
-          this->deinit_ext_orders(ext_funcSurf);
         }
       }
 
-      // deinit - u_ext_func
-      this->deinit_u_ext_orders(u_ext_func);
-
-      // deinit - ext
-      this->deinit_ext_orders(ext_func);
-
       return order;
     }
 
@@ -206,16 +195,19 @@ namespace Hermes
 
       // Total order of the vector form.
       Hermes::Ord o;
+      int marker;
       if (dynamic_cast<MatrixFormVol<Scalar>*>(form))
+      {
         o = (dynamic_cast<MatrixFormVol<Scalar>*>(form))->ord(1, &wt_order, u_ext, ou, ov, &geom_order_vol, local_ext);
+        marker = current_state->rep->marker;
+      }
       else
+      {
         o = (dynamic_cast<MatrixFormSurf<Scalar>*>(form))->ord(1, &wt_order, u_ext, ou, ov, &geom_order_surf, local_ext);
+        marker = current_state->rep->en[current_state->isurf]->marker;
+      }
 
-      adjust_order_to_refmaps(form, order, &o, current_refmaps);
-
-      // Cleanup.
-      if (form->ext.size() > 0)
-        this->deinit_ext_orders(local_ext);
+      adjust_order_to_refmaps(form, order, &o, current_refmaps, marker);
 
       return order;
     }
@@ -248,16 +240,19 @@ namespace Hermes
 
       // Total order of the vector form.
       Hermes::Ord o;
+      int marker;
       if (dynamic_cast<VectorFormVol<Scalar>*>(form))
+      {
         o = (dynamic_cast<VectorFormVol<Scalar>*>(form))->ord(1, &wt_order, u_ext, ov, &geom_order_vol, local_ext);
+        marker = current_state->rep->marker;
+      }
       else
+      {
         o = (dynamic_cast<VectorFormSurf<Scalar>*>(form))->ord(1, &wt_order, u_ext, ov, &geom_order_surf, local_ext);
+        marker = current_state->rep->en[current_state->isurf]->marker;
+      }
 
-      adjust_order_to_refmaps(form, order, &o, current_refmaps);
-
-      // Cleanup.
-      if (form->ext.size() > 0)
-        this->deinit_ext_orders(local_ext);
+      adjust_order_to_refmaps(form, order, &o, current_refmaps, marker);
 
       return order;
     }
@@ -269,7 +264,7 @@ namespace Hermes
       bool surface_form = (this->current_state->isurf > -1);
       if (this->u_ext)
       {
-        u_ext_func = new Func<Hermes::Ord>*[this->selectiveAssembler->spaces_size];
+        u_ext_func = this->arena->template allocate_array<Func<Hermes::Ord>*>(this->selectiveAssembler->spaces_size);
 
         for (int i = 0; i < this->selectiveAssembler->spaces_size; i++)
         {
@@ -290,12 +285,6 @@ namespace Hermes
       return u_ext_func;
     }
 
-    template<typename Scalar>
-    void DiscreteProblemIntegrationOrderCalculator<Scalar>::deinit_u_ext_orders(Func<Hermes::Ord>** u_ext_func)
-    {
-      free_with_check(u_ext_func);
-    }
-
     template<typename Scalar>
     Func<Hermes::Ord>** DiscreteProblemIntegrationOrderCalculator<Scalar>::init_ext_orders(std::vector<MeshFunctionSharedPtr<Scalar> >& ext, std::vector<UExtFunctionSharedPtr<Scalar> >& u_ext_fns, Func<Hermes::Ord>** u_ext_func)
     {
@@ -308,7 +297,7 @@ namespace Hermes
 
       if (ext_size > 0 || u_ext_fns_size > 0)
       {
-        ext_func = malloc_with_check<Func<Hermes::Ord>*>(ext_size + u_ext_fns_size);
+        ext_func = this->arena->template allocate_array<Func<Hermes::Ord>*>(ext_size + u_ext_fns_size);
         for (unsigned short ext_i = 0; ext_i < ext.size(); ext_i++)
         {
           if (ext[ext_i])
@@ -343,19 +332,15 @@ namespace Hermes
     }
 
     template<typename Scalar>
-    void DiscreteProblemIntegrationOrderCalculator<Scalar>::deinit_ext_orders(Func<Hermes::Ord>** ext_func)
-    {
-      free_with_check(ext_func);
-    }
-
-    template<typename Scalar>
-    void DiscreteProblemIntegrationOrderCalculator<Scalar>::adjust_order_to_refmaps(Form<Scalar> *form, int& order, Hermes::Ord* o, RefMap** current_refmaps)
+    void DiscreteProblemIntegrationOrderCalculator<Scalar>::adjust_order_to_refmaps(Form<Scalar> *form, int& order, Hermes::Ord* o, RefMap** current_refmaps, int marker)
     {
       // Increase due to reference map.
       int coordinate = form->i;
       order = current_refmaps[coordinate]->get_inv_ref_order();
       order += o->get_order();
-      limit_order(order, current_refmaps[coordinate]->get_active_element()->get_mode());
+      // Per-form (per-marker) control.
+      form->adjust_integration_order(order, marker);
+      limit_order(order, current_refmaps[coordinate]->get_active_element()->get_mode(), current_refmaps[coordinate]->get_quad_2d());
     }
 
     template<typename Scalar>
@@ -364,43 +349,20 @@ namespace Hermes
       int inc = (fu->get_num_components() == 2) ? 1 : 0;
       int central_order = fu->get_edge_fn_order(ns->active_edge) + inc;
       int neighbor_order = fu->get_edge_fn_order(ns->neighbor_edge.local_num_of_edge) + inc;
-      return new DiscontinuousFunc<Ord>(&func_order[central_order], &func_order[neighbor_order]);
+      return this->arena->template create<DiscontinuousFunc<Ord> >(&func_order[central_order], &func_order[neighbor_order]);
     }
 
     template<typename Scalar>
     DiscontinuousFunc<Hermes::Ord>** DiscreteProblemIntegrationOrderCalculator<Scalar>::init_ext_fns_ord(std::vector<MeshFunctionSharedPtr<Scalar> > &ext,
       NeighborSearch<Scalar>** neighbor_searches)
     {
-      DiscontinuousFunc<Ord>** fake_ext_fns = new DiscontinuousFunc<Ord>*[ext.size()];
+      DiscontinuousFunc<Ord>** fake_ext_fns = this->arena->template allocate_array<DiscontinuousFunc<Ord>*>(ext.size());
       for (unsigned int j = 0; j < ext.size(); j++)
         fake_ext_fns[j] = init_ext_fn_ord(DiscreteProblemDGAssembler<Scalar>::get_neighbor_search_ext(this->selectiveAssembler->get_weak_formulation(), neighbor_searches, j), ext[j]);
 
       return fake_ext_fns;
     }
 
-    template<typename Scalar>
-    template<typename FormType>
-    void DiscreteProblemIntegrationOrderCalculator<Scalar>::deinit_ext_fns_ord(Form<Scalar> *form, FormType** oi, FormType** oext)
-    {
-      unsigned int prev_size = oi ? (this->rungeKutta ? this->RK_original_spaces_count : form->wf->get_neq() - form->u_ext_offset) : 0;
-
-      if (oi)
-      {
-        for (int i = 0; i < prev_size; i++)
-          delete oi[i];
-        delete[] oi;
-      }
-
-      int ext_size = form->ext.size() ? form->ext.size() : form->wf->ext.size();
-      int u_ext_fn_size = form->u_ext_fn.size() ? form->u_ext_fn.size() : form->wf->u_ext_fn.size();
-      if (oext)
-      {
-        for (int i = 0; i < ext_size + u_ext_fn_size; i++)
-          delete oext[i];
-        delete[] oext;
-      }
-    }
-
     template<typename Scalar>
     int DiscreteProblemIntegrationOrderCalculator<Scalar>::calc_order_dg_matrix_form(const std::vector<SpaceSharedPtr<Scalar> > spaces, Traverse::State* current_state, MatrixFormDG<Scalar>* mfDG, RefMap** current_refmaps, Solution<Scalar>** current_u_ext, bool neighbor_supp_u, bool neighbor_supp_v, NeighborSearch<Scalar>** neighbor_searches)
     {
@@ -411,14 +373,14 @@ namespace Hermes
       // Order to return.
       int order = 0;
 
-      DiscontinuousFunc<Hermes::Ord>** u_ext_ord = current_u_ext == nullptr ? nullptr : new DiscontinuousFunc<Hermes::Ord>*[this->rungeKutta ? this->RK_original_spaces_count : mfDG->wf->get_neq() - mfDG->u_ext_offset];
+      DiscontinuousFunc<Hermes::Ord>** u_ext_ord = current_u_ext == nullptr ? nullptr : this->arena->template allocate_array<DiscontinuousFunc<Hermes::Ord>*>(prev_size);
 
       if (current_u_ext)
         for (unsigned short i = 0; i < prev_size; i++)
           if (current_u_ext[i + mfDG->u_ext_offset])
             u_ext_ord[i] = init_ext_fn_ord(nbs_u, current_u_ext[i + mfDG->u_ext_offset]);
           else
-            u_ext_ord[i] = new DiscontinuousFunc<Ord>(&func_order[0], false, false);
+            u_ext_ord[i] = this->arena->template create<DiscontinuousFunc<Ord> >(&func_order[0], false, false);
 
       // Order of additional external functions.
       DiscontinuousFunc<Ord>** ext_ord = nullptr;
@@ -439,8 +401,8 @@ namespace Hermes
         max_order_j = H2D_GET_H_ORDER(max_order_j);
 
       // Order of shape functions.
-      DiscontinuousFunc<Ord>* ou = new DiscontinuousFunc<Ord>(&func_order[max_order_j], neighbor_supp_u);
-      DiscontinuousFunc<Ord>* ov = new DiscontinuousFunc<Ord>(&func_order[max_order_i], neighbor_supp_v);
+      DiscontinuousFunc<Ord>* ou = this->arena->template create<DiscontinuousFunc<Ord> >(&func_order[max_order_j], neighbor_supp_u);
+      DiscontinuousFunc<Ord>* ov = this->arena->template create<DiscontinuousFunc<Ord> >(&func_order[max_order_i], neighbor_supp_v);
 
       // Order of geometric attributes (eg. for multiplication of a solution with coordinates, normals, etc.).
 
@@ -449,12 +411,6 @@ namespace Hermes
 
       adjust_order_to_refmaps(mfDG, order, &o, current_refmaps);
 
-      // Cleanup.
-      deinit_ext_fns_ord(mfDG, u_ext_ord, ext_ord);
-
-      delete ou;
-      delete ov;
-
       return order;
     }
 
@@ -468,14 +424,14 @@ namespace Hermes
       // Order to return.
       int order = 0;
 
-      DiscontinuousFunc<Hermes::Ord>** u_ext_ord = current_u_ext == nullptr ? nullptr : new DiscontinuousFunc<Hermes::Ord>*[this->rungeKutta ? this->RK_original_spaces_count : vfDG->wf->get_neq() - vfDG->u_ext_offset];
+      DiscontinuousFunc<Hermes::Ord>** u_ext_ord = current_u_ext == nullptr ? nullptr : this->arena->template allocate_array<DiscontinuousFunc<Hermes::Ord>*>(prev_size);
 
       if (current_u_ext)
         for (unsigned short i = 0; i < prev_size; i++)
           if (current_u_ext[i + vfDG->u_ext_offset])
             u_ext_ord[i] = init_ext_fn_ord(nbs_u, current_u_ext[i + vfDG->u_ext_offset]);
           else
-            u_ext_ord[i] = new DiscontinuousFunc<Ord>(&func_order[0], false, false);
+            u_ext_ord[i] = this->arena->template create<DiscontinuousFunc<Ord> >(&func_order[0], false, false);
 
       // Order of additional external functions.
       DiscontinuousFunc<Ord>** ext_ord = nullptr;
@@ -491,17 +447,13 @@ namespace Hermes
         max_order_i = H2D_GET_H_ORDER(max_order_i);
 
       // Order of shape functions.
-      DiscontinuousFunc<Ord>* ov = new DiscontinuousFunc<Ord>(&func_order[max_order_i], neighbor_supp_v);
+      DiscontinuousFunc<Ord>* ov = this->arena->template create<DiscontinuousFunc<Ord> >(&func_order[max_order_i], neighbor_supp_v);
 
       // Total order of the matrix form.
       Ord o = vfDG->ord(1, &wt_order, u_ext_ord, ov, &geom_order_interface, ext_ord);
 
       adjust_order_to_refmaps(vfDG, order, &o, current_refmaps);
 
-      // Cleanup.
-      deinit_ext_fns_ord(vfDG, u_ext_ord, ext_ord);
-      delete ov;
-
       return order;
     }
 
@@ -41,6 +41,7 @@ namespace Hermes
     template<typename Scalar>
     bool DiscreteProblemSelectiveAssembler<Scalar>::prepare_sparse_structure(SparseMatrix<Scalar>* mat, Vector<Scalar>* rhs, std::vector<SpaceSharedPtr<Scalar> > spaces, Traverse::State**& states, unsigned int& num_states)
     {
+      HERMES_PROFILE_REGION("DiscreteProblem::sparse_structure");
       int ndof = Space<Scalar>::get_num_dofs(spaces);
 
       if (matrix_structure_reusable && mat && mat == this->previous_mat)
@@ -19,6 +19,7 @@
 #include "function/solution.h"
 #include "weakform/weakform.h"
 #include "function/exact_solution.h"
+#include "quadrature/limit_order.h"
 
 namespace Hermes
 {
@@ -26,13 +27,15 @@ namespace Hermes
   {
     template<typename Scalar>
     DiscreteProblemThreadAssembler<Scalar>::DiscreteProblemThreadAssembler(DiscreteProblemSelectiveAssembler<Scalar>* selectiveAssembler, bool nonlinear) :
-      pss(nullptr), refmaps(nullptr), u_ext(nullptr),
+      pss(nullptr), refmaps(nullptr), u_ext(nullptr), quad_2d(&g_quad_2d_std), quadrature(&g_quad_2d_std), collocated_quadrature(false), specialized_kernels(true), geometry_store(nullptr), variants_share_ext(true),
       selectiveAssembler(selectiveAssembler), integrationOrderCalculator(selectiveAssembler),
       ext_funcs(nullptr), ext_funcs_allocated_size(0), ext_funcs_local(nullptr), ext_funcs_local_allocated_size(0),
       funcs_wf_initialized(false), funcs_space_initialized(false), spaces_size(0), nonlinear(nonlinear), reusable_DOFs(nullptr), reusable_Dirichlet(nullptr)
     {
       // Init the memory pool - if PJLIB is linked, it will do the magic, if not, it will initialize the pointer to null.
       this->init_funcs_memory_pool();
+
+      this->integrationOrderCalculator.arena = &this->arena;
     }
 
     template<typename Scalar>
@@ -65,7 +68,39 @@ namespace Hermes
       {
         pss[j] = new PrecalcShapesetAssembling(spaces[j]->shapeset);
         refmaps[j] = new RefMap();
-        refmaps[j]->set_quad_2d(&g_quad_2d_std);
+        refmaps[j]->set_quad_2d(this->quad_2d);
+      }
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemThreadAssembler<Scalar>::set_quadrature(Quad2D* quadrature)
+    {
+      this->quadrature = quadrature;
+      this->update_quad_2d();
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemThreadAssembler<Scalar>::set_collocated_quadrature(bool to_set)
+    {
+      this->collocated_quadrature = to_set;
+      this->update_quad_2d();
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemThreadAssembler<Scalar>::update_quad_2d()
+    {
+      // The collocated mode replaces the rules on quadrilaterals only, g_quad_2d_lobatto has the ones of g_quad_2d_std on triangles.
+      if (!this->collocated_quadrature)
+        this->quad_2d = this->quadrature;
+      else if (this->quadrature == &g_quad_2d_std)
+        this->quad_2d = &g_quad_2d_lobatto;
+      else
+        this->quad_2d = Quad2DComposite::get(this->quadrature, &g_quad_2d_lobatto);
+
+      if (this->refmaps)
+      {
+        for (unsigned int j = 0; j < spaces_size; j++)
+          refmaps[j]->set_quad_2d(this->quad_2d);
       }
     }
 
@@ -79,6 +114,27 @@ namespace Hermes
       this->init_funcs_wf();
     }
 
+    template<typename Scalar>
+    void DiscreteProblemThreadAssembler<Scalar>::set_weak_formulation_variants(WeakFormSharedPtr<Scalar> wf, const std::vector<WeakFormSharedPtr<Scalar> >& wfs)
+    {
+      this->free_weak_formulation_variants();
+      this->variants_share_ext = true;
+      for (unsigned short variant_i = 0; variant_i < wfs.size(); variant_i++)
+      {
+        WeakFormSharedPtr<Scalar> wf_variant(wfs[variant_i]->clone());
+        wf_variant->cloneMembers(wfs[variant_i]);
+        this->wf_variants.push_back(wf_variant);
+
+        // The same numbers of the functions are ensured by DiscreteProblem::check_weak_formulation_variants().
+        for (unsigned int ext_i = 0; ext_i < wf->ext.size(); ext_i++)
+          if (wfs[variant_i]->ext[ext_i].get() != wf->ext[ext_i].get())
+            this->variants_share_ext = false;
+        for (unsigned int ext_i = 0; ext_i < wf->u_ext_fn.size(); ext_i++)
+          if (wfs[variant_i]->u_ext_fn[ext_i].get() != wf->u_ext_fn[ext_i].get())
+            this->variants_share_ext = false;
+      }
+    }
+
     template<typename Scalar>
     void DiscreteProblemThreadAssembler<Scalar>::init_u_ext(const std::vector<SpaceSharedPtr<Scalar> > spaces, Solution<Scalar>** u_ext_sln)
     {
@@ -112,19 +168,24 @@ namespace Hermes
       // Basic settings.
       this->add_dirichlet_lift = add_dirichlet_lift_;
 
+      // Statistics.
+      this->statistics = AssemblyCounters();
+      for (unsigned j = 0; j < this->spaces_size; j++)
+        pss[j]->reset_table_statistics();
+
       // Transformables setup.
       fns.clear();
       // - precalc shapesets.
       for (unsigned j = 0; j < this->spaces_size; j++)
       {
         fns.push_back(pss[j]);
-        pss[j]->set_quad_2d(&g_quad_2d_std);
+        pss[j]->set_quad_2d(this->quad_2d);
       }
       // - wf->ext.
       for (unsigned j = 0; j < this->wf->ext.size(); j++)
       {
         fns.push_back(this->wf->ext[j].get());
-        this->wf->ext[j]->set_quad_2d(&g_quad_2d_std);
+        this->wf->ext[j]->set_quad_2d(this->quad_2d);
       }
       // - forms->ext.
       for (unsigned int form_i = 0; form_i < this->wf->get_forms().size(); form_i++)
@@ -135,7 +196,7 @@ namespace Hermes
           if (form->ext[ext_i])
           {
             fns.push_back(form->ext[ext_i].get());
-            form->ext[ext_i]->set_quad_2d(&g_quad_2d_std);
+            form->ext[ext_i]->set_quad_2d(this->quad_2d);
           }
         }
       }
@@ -146,12 +207,36 @@ namespace Hermes
         for (unsigned j = 0; j < this->wf->get_neq(); j++)
         {
           fns.push_back(u_ext[j]);
-          u_ext[j]->set_quad_2d(&g_quad_2d_std);
+          u_ext[j]->set_quad_2d(this->quad_2d);
+        }
+      }
+      // - weak formulation variants - wf->ext, forms->ext.
+      for (unsigned short variant_i = 0; variant_i < this->wf_variants.size(); variant_i++)
+      {
+        WeakFormSharedPtr<Scalar> wf_variant = this->wf_variants[variant_i];
+        for (unsigned j = 0; j < wf_variant->ext.size(); j++)
+        {
+          fns.push_back(wf_variant->ext[j].get());
+          wf_variant->ext[j]->set_quad_2d(this->quad_2d);
+        }
+        for (unsigned int form_i = 0; form_i < wf_variant->get_forms().size(); form_i++)
+        {
+          Form<Scalar>* form = wf_variant->get_forms()[form_i];
+          for (unsigned int ext_i = 0; ext_i < form->ext.size(); ext_i++)
+          {
+            if (form->ext[ext_i])
+            {
+              fns.push_back(form->ext[ext_i].get());
+              form->ext[ext_i]->set_quad_2d(this->quad_2d);
+            }
+          }
         }
       }
 
       // Process markers.
       this->wf->processFormMarkers(spaces);
+      for (unsigned short variant_i = 0; variant_i < this->wf_variants.size(); variant_i++)
+        this->wf_variants[variant_i]->processFormMarkers(spaces);
     }
 
     template<typename Scalar>
@@ -370,7 +455,37 @@ namespace Hermes
       }
 
       // Volumetric integration order.
-      this->order = this->integrationOrderCalculator.calculate_order(spaces, this->refmaps, this->wf);
+      {
+        HERMES_PROFILE_REGION("DiscreteProblemThreadAssembler::integration_order");
+        this->order = this->integrationOrderCalculator.calculate_order(spaces, this->refmaps, this->wf);
+        // - the variants share the quadrature, take the highest order.
+        for (unsigned short variant_i = 0; variant_i < this->wf_variants.size(); variant_i++)
+        {
+          int variant_order = this->integrationOrderCalculator.calculate_order(spaces, this->refmaps, this->wf_variants[variant_i]);
+          if (variant_order > this->order)
+            this->order = variant_order;
+        }
+      }
+
+      // Collocated mode - the Gauss-Lobatto rule with p + 1 points per direction, p being the highest order of the element,
+      // regardless of the integrand (under-integration of the mass-type forms, that is what makes their matrices diagonal).
+      if (this->collocated_quadrature && current_state->rep->get_mode() == HERMES_MODE_QUAD)
+      {
+        int max_order = 0;
+        for (unsigned short space_i = 0; space_i < this->spaces_size; space_i++)
+        {
+          if (!current_state->e[space_i])
+            continue;
+          int element_order = spaces[space_i]->get_element_order(current_state->e[space_i]->id);
+          max_order = std::max(max_order, std::max(H2D_GET_H_ORDER(element_order), H2D_GET_V_ORDER(element_order)));
+        }
+        this->order = std::min(std::max(2 * max_order - 1, 0), (int)g_max_quad_lobatto);
+      }
+
+      this->statistics.states++;
+      if (this->order >= (int)this->statistics.states_per_order.size())
+        this->statistics.states_per_order.resize(this->order + 1, 0);
+      this->statistics.states_per_order[this->order]++;
 
       // Init the variables (funcs, geometry, ...)
       this->init_calculation_variables();
@@ -379,6 +494,7 @@ namespace Hermes
     template<typename Scalar>
     void DiscreteProblemThreadAssembler<Scalar>::init_calculation_variables()
     {
+      HERMES_PROFILE_REGION("DiscreteProblemThreadAssembler::precalculation");
       for (unsigned short space_i = 0; space_i < this->spaces_size; space_i++)
       {
         if (current_state->e[space_i] == nullptr)
@@ -391,7 +507,19 @@ namespace Hermes
         }
       }
 
-      this->n_quadrature_points = init_geometry_points_allocated(this->rep_refmap, this->order, this->geometry, this->jacobian_x_weights);
+      if (this->geometry_store)
+        this->n_quadrature_points = this->geometry_store->get_volume_geometry(this->rep_refmap, this->order, this->geometry, this->jacobian_x_weights);
+      else
+        this->n_quadrature_points = init_geometry_points_allocated(this->rep_refmap, this->order, this->geometry, this->jacobian_x_weights);
+
+      // Specialized kernels - selected here once for all the forms of the state.
+      for (int kernel_type = 0; kernel_type < HERMES_KERNEL_COUNT; kernel_type++)
+      {
+        if (this->specialized_kernels)
+          this->state_kernels[kernel_type] = AssemblyKernels::get_matrix_kernel((AssemblyKernelType)kernel_type, current_state->rep->get_mode(), this->order, this->quad_2d);
+        else
+          this->state_kernels[kernel_type] = nullptr;
+      }
 
       if (current_state->isBnd && (this->wf->mfsurf.size() > 0 || this->wf->vfsurf.size() > 0))
       {
@@ -402,7 +530,10 @@ namespace Hermes
           if (!current_state->bnd[edge_i])
             continue;
 
-          this->n_quadrature_pointsSurface[edge_i] = init_surface_geometry_points_allocated(this->rep_refmap, this->order, edge_i, current_state->rep->marker, this->geometrySurface[edge_i], this->jacobian_x_weightsSurface[edge_i]);
+          if (this->geometry_store)
+            this->n_quadrature_pointsSurface[edge_i] = this->geometry_store->get_surface_geometry(this->rep_refmap, this->order, edge_i, current_state->rep->marker, this->geometrySurface[edge_i], this->jacobian_x_weightsSurface[edge_i]);
+          else
+            this->n_quadrature_pointsSurface[edge_i] = init_surface_geometry_points_allocated(this->rep_refmap, this->order, edge_i, current_state->rep->marker, this->geometrySurface[edge_i], this->jacobian_x_weightsSurface[edge_i]);
           this->orderSurface[edge_i] = this->order;
           this->order = order_local;
 
@@ -474,12 +605,42 @@ namespace Hermes
     template<typename Scalar>
     void DiscreteProblemThreadAssembler<Scalar>::assemble_one_state()
     {
+      HERMES_PROFILE_REGION("DiscreteProblemThreadAssembler::forms");
       // init - u_ext_func
       this->init_u_ext_values(this->order);
 
       // init - ext
       this->init_ext_values(this->ext_funcs, this->wf->ext, this->wf->u_ext_fn, this->order, this->u_ext_funcs, &this->geometry);
 
+      this->assemble_volume_forms();
+
+      // Assemble surface integrals now: loop through surfaces of the element.
+      if (current_state->isBnd && (this->wf->mfsurf.size() > 0 || this->wf->vfsurf.size() > 0))
+      {
+        for (unsigned char isurf = 0; isurf < current_state->rep->nvert; isurf++)
+        {
+          if (!current_state->bnd[isurf])
+            continue;
+
+          current_state->isurf = isurf;
+
+          // Edge-wise parameters for WeakForm.
+          this->wf->set_active_edge_state(current_state->e, isurf);
+
+          // init - u_ext_func
+          this->init_u_ext_values(this->orderSurface[isurf]);
+
+          // init - ext
+          this->init_ext_values(this->ext_funcs, this->wf->ext, this->wf->u_ext_fn, this->orderSurface[isurf], this->u_ext_funcs, &this->geometrySurface[isurf]);
+
+          this->assemble_surface_forms(isurf);
+        }
+      }
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemThreadAssembler<Scalar>::assemble_volume_forms()
+    {
       if (this->current_mat || this->add_dirichlet_lift)
       {
         for (unsigned short current_mfvol_i = 0; current_mfvol_i < this->wf->mfvol.size(); current_mfvol_i++)
@@ -505,56 +666,127 @@ namespace Hermes
           this->assemble_vector_form(this->wf->vfvol[current_vfvol_i], order, funcs[form_i], &als[form_i], n_quadrature_points, &geometry, jacobian_x_weights);
         }
       }
+    }
 
-      // Assemble surface integrals now: loop through surfaces of the element.
-      if (current_state->isBnd && (this->wf->mfsurf.size() > 0 || this->wf->vfsurf.size() > 0))
+    template<typename Scalar>
+    void DiscreteProblemThreadAssembler<Scalar>::assemble_surface_forms(unsigned char isurf)
+    {
+      if (this->current_mat || this->add_dirichlet_lift)
       {
-        for (unsigned char isurf = 0; isurf < current_state->rep->nvert; isurf++)
+        for (unsigned short current_mfsurf_i = 0; current_mfsurf_i < this->wf->mfsurf.size(); current_mfsurf_i++)
         {
-          if (!current_state->bnd[isurf])
+          if (!selectiveAssembler->form_to_be_assembled(this->wf->mfsurf[current_mfsurf_i], current_state))
             continue;
 
-          current_state->isurf = isurf;
+          int form_i = this->wf->mfsurf[current_mfsurf_i]->i;
+          int form_j = this->wf->mfsurf[current_mfsurf_i]->j;
 
-          // Edge-wise parameters for WeakForm.
-          this->wf->set_active_edge_state(current_state->e, isurf);
+          this->assemble_matrix_form(this->wf->mfsurf[current_mfsurf_i], orderSurface[isurf], funcsSurface[isurf][form_j], funcsSurface[isurf][form_i],
+            &alsSurface[isurf][form_i], &alsSurface[isurf][form_j], n_quadrature_pointsSurface[isurf], &geometrySurface[isurf], jacobian_x_weightsSurface[isurf]);
+        }
+      }
 
-          // init - u_ext_func
-          this->init_u_ext_values(this->orderSurface[isurf]);
+      if (this->current_rhs)
+      {
+        for (unsigned short current_vfsurf_i = 0; current_vfsurf_i < this->wf->vfsurf.size(); current_vfsurf_i++)
+        {
+          if (!selectiveAssembler->form_to_be_assembled(this->wf->vfsurf[current_vfsurf_i], current_state))
+            continue;
 
-          // init - ext
-          this->init_ext_values(this->ext_funcs, this->wf->ext, this->wf->u_ext_fn, this->orderSurface[isurf], this->u_ext_funcs, &this->geometrySurface[isurf]);
+          int form_i = this->wf->vfsurf[current_vfsurf_i]->i;
 
-          if (this->current_mat || this->add_dirichlet_lift)
-          {
-            for (unsigned short current_mfsurf_i = 0; current_mfsurf_i < this->wf->mfsurf.size(); current_mfsurf_i++)
-            {
-              if (!selectiveAssembler->form_to_be_assembled(this->wf->mfsurf[current_mfsurf_i], current_state))
-                continue;
+          this->assemble_vector_form(this->wf->vfsurf[current_vfsurf_i], orderSurface[isurf], funcsSurface[isurf][form_i], &alsSurface[isurf][form_i],
+            n_quadrature_pointsSurface[isurf], &geometrySurface[isurf], jacobian_x_weightsSurface[isurf]);
+        }
+      }
+    }
 
-              int form_i = this->wf->mfsurf[current_mfsurf_i]->i;
-              int form_j = this->wf->mfsurf[current_mfsurf_i]->j;
+    template<typename Scalar>
+    void DiscreteProblemThreadAssembler<Scalar>::select_variant(unsigned short variant_i, WeakFormSharedPtr<Scalar> wf_primary, SparseMatrix<Scalar>* mat_primary, Vector<Scalar>* rhs_primary,
+      Vector<Scalar>* dirichlet_lift_rhs_primary, SparseMatrix<Scalar>** mats, Vector<Scalar>** rhss, Vector<Scalar>** dirichlet_lift_rhss)
+    {
+      if (variant_i == 0)
+      {
+        this->wf = wf_primary;
+        this->current_mat = mat_primary;
+        this->current_rhs = rhs_primary;
+        this->dirichlet_lift_rhs = dirichlet_lift_rhs_primary;
+      }
+      else
+      {
+        this->wf = this->wf_variants[variant_i - 1];
+        this->current_mat = mats[variant_i - 1];
+        this->current_rhs = rhss[variant_i - 1];
+        this->dirichlet_lift_rhs = dirichlet_lift_rhss[variant_i - 1];
+      }
+    }
 
-              this->assemble_matrix_form(this->wf->mfsurf[current_mfsurf_i], orderSurface[isurf], funcsSurface[isurf][form_j], funcsSurface[isurf][form_i],
-                &alsSurface[isurf][form_i], &alsSurface[isurf][form_j], n_quadrature_pointsSurface[isurf], &geometrySurface[isurf], jacobian_x_weightsSurface[isurf]);
-            }
+    template<typename Scalar>
+    void DiscreteProblemThreadAssembler<Scalar>::assemble_one_state_variants(SparseMatrix<Scalar>** mats, Vector<Scalar>** rhss, Vector<Scalar>** dirichlet_lift_rhss)
+    {
+      HERMES_PROFILE_REGION("DiscreteProblemThreadAssembler::forms");
+      // Store the primary weak formulation & targets.
+      WeakFormSharedPtr<Scalar> wf_primary = this->wf;
+      SparseMatrix<Scalar>* mat_primary = this->current_mat;
+      Vector<Scalar>* rhs_primary = this->current_rhs;
+      Vector<Scalar>* dirichlet_lift_rhs_primary = this->dirichlet_lift_rhs;
+      unsigned short variants_count = this->wf_variants.size() + 1;
+
+      // The previous iterations are the same for all variants, so are the external functions if the variants share them
+      // (variants_share_ext) - their values are calculated once per volume / surface, only the variant's own are recalculated.
+      // Runge-Kutta adds the external functions to u_ext values, these are then recalculated too.
+      try
+      {
+        this->init_u_ext_values(this->order);
+        this->init_ext_values(this->ext_funcs, this->wf->ext, this->wf->u_ext_fn, this->order, this->u_ext_funcs, &this->geometry);
+        for (unsigned short variant_i = 0; variant_i < variants_count; variant_i++)
+        {
+          this->select_variant(variant_i, wf_primary, mat_primary, rhs_primary, dirichlet_lift_rhs_primary, mats, rhss, dirichlet_lift_rhss);
+          if (variant_i > 0 && !this->variants_share_ext)
+          {
+            if (this->rungeKutta)
+              this->init_u_ext_values(this->order);
+            this->init_ext_values(this->ext_funcs, this->wf->ext, this->wf->u_ext_fn, this->order, this->u_ext_funcs, &this->geometry);
           }
+          this->assemble_volume_forms();
+        }
 
-          if (this->current_rhs)
+        // The variants have the same surface forms (see DiscreteProblem::check_weak_formulation_variants()).
+        if (current_state->isBnd && (wf_primary->mfsurf.size() > 0 || wf_primary->vfsurf.size() > 0))
+        {
+          for (unsigned char isurf = 0; isurf < current_state->rep->nvert; isurf++)
           {
-            for (unsigned short current_vfsurf_i = 0; current_vfsurf_i < this->wf->vfsurf.size(); current_vfsurf_i++)
+            if (!current_state->bnd[isurf])
+              continue;
+
+            current_state->isurf = isurf;
+
+            this->init_u_ext_values(this->orderSurface[isurf]);
+            for (unsigned short variant_i = 0; variant_i < variants_count; variant_i++)
             {
-              if (!selectiveAssembler->form_to_be_assembled(this->wf->vfsurf[current_vfsurf_i], current_state))
-                continue;
+              this->select_variant(variant_i, wf_primary, mat_primary, rhs_primary, dirichlet_lift_rhs_primary, mats, rhss, dirichlet_lift_rhss);
 
-              int form_i = this->wf->vfsurf[current_vfsurf_i]->i;
+              // Edge-wise parameters for WeakForm.
+              this->wf->set_active_edge_state(current_state->e, isurf);
 
-              this->assemble_vector_form(this->wf->vfsurf[current_vfsurf_i], orderSurface[isurf], funcsSurface[isurf][form_i], &alsSurface[isurf][form_i],
-                n_quadrature_pointsSurface[isurf], &geometrySurface[isurf], jacobian_x_weightsSurface[isurf]);
+              if (variant_i == 0 || !this->variants_share_ext)
+              {
+                if (variant_i > 0 && this->rungeKutta)
+                  this->init_u_ext_values(this->orderSurface[isurf]);
+                this->init_ext_values(this->ext_funcs, this->wf->ext, this->wf->u_ext_fn, this->orderSurface[isurf], this->u_ext_funcs, &this->geometrySurface[isurf]);
+              }
+              this->assemble_surface_forms(isurf);
             }
           }
         }
       }
+      catch (...)
+      {
+        this->select_variant(0, wf_primary, mat_primary, rhs_primary, dirichlet_lift_rhs_primary, mats, rhss, dirichlet_lift_rhss);
+        throw;
+      }
+
+      this->select_variant(0, wf_primary, mat_primary, rhs_primary, dirichlet_lift_rhs_primary, mats, rhss, dirichlet_lift_rhss);
     }
 
     template<typename Scalar>
@@ -582,15 +814,46 @@ namespace Hermes
       if (this->rungeKutta)
         u_ext_local += form->u_ext_offset;
 
+      // Specialized kernel of the form on this state (volumetric forms only).
+      AssemblyKernels::MatrixKernel kernel = nullptr;
+      Scalar kernel_coefficient = 0.;
+      MatrixFormVol<Scalar>* form_vol = dynamic_cast<MatrixFormVol<Scalar>*>(form);
+      if (form_vol)
+      {
+        AssemblyKernelType kernel_type = form_vol->get_assembly_kernel(kernel_coefficient);
+        if (kernel_type != HERMES_KERNEL_NONE)
+          kernel = this->state_kernels[kernel_type];
+      }
+
+      // Otherwise the batched evaluation of the needed pairs, if the form supports it.
+      bool batched = false;
+      if (!kernel)
+      {
+        unsigned int needed_pairs = 0;
+        for (unsigned int i = 0; i < current_als_i->cnt; i++)
+        {
+          for (unsigned int j = 0; j < current_als_j->cnt; j++)
+          {
+            bool needed = this->pair_to_be_evaluated(form, sym, current_als_i, i, current_als_j, j);
+            this->batch_pairs[i * H2D_MAX_LOCAL_BASIS_SIZE + j] = needed;
+            if (needed)
+              needed_pairs++;
+          }
+        }
+        if (needed_pairs > 0)
+          batched = this->evaluate_batch(form, n_quadrature_points, jacobian_x_weights, u_ext_local, base_fns, current_als_j->cnt,
+          test_fns, current_als_i->cnt, geometry, ext_local);
+      }
+
+      // Evaluated (basis function, test function) pairs - the work for the profiler.
+      unsigned int evaluated_pairs = 0;
+
       // Actual form-specific calculation.
       for (unsigned int i = 0; i < current_als_i->cnt; i++)
       {
         if (current_als_i->dof[i] < 0 || std::abs(current_als_i->coef[i]) < Hermes::HermesSqrtEpsilon)
           continue;
 
-        if ((!tra || surface_form) && current_als_i->dof[i] < 0)
-          continue;
-
         for (unsigned int j = 0; j < current_als_j->cnt; j++)
         {
           if (current_als_j->dof[j] >= 0 && this->reusable_DOFs && *this->reusable_DOFs)
@@ -608,26 +871,22 @@ namespace Hermes
             }
           }
 
-          if (current_als_j->dof[j] < 0 && this->reusable_Dirichlet && *this->reusable_Dirichlet && (*this->reusable_Dirichlet)[form->j])
-          {
-            continue;
-          }
-
-          // Skip symmetric values that do not contribute to Dirichlet lift.
-          if (sym && j < i && current_als_j->dof[j] >= 0)
-            continue;
-
-          // Skip anything that does not contribute to Dirichlet in the case of just rhs assembling.
-          if (current_als_j->dof[j] >= 0 && !this->current_mat)
-            continue;
-
-          if (std::abs(current_als_j->coef[j]) < Hermes::HermesEpsilon)
+          if (!this->pair_to_be_evaluated(form, sym, current_als_i, i, current_als_j, j))
             continue;
 
           Func<double>* u = base_fns[j];
           Func<double>* v = test_fns[i];
 
-          Scalar val = block_scaling_coefficient * form->value(n_quadrature_points, jacobian_x_weights, u_ext_local, u, v, geometry, ext_local) * form->scaling_factor * current_als_j->coef[j] * current_als_i->coef[i];
+          Scalar form_value;
+          if (kernel)
+            form_value = kernel(jacobian_x_weights, u, v) * kernel_coefficient;
+          else if (batched)
+            form_value = this->batch_values[i * H2D_MAX_LOCAL_BASIS_SIZE + j];
+          else
+            form_value = form->value(n_quadrature_points, jacobian_x_weights, u_ext_local, u, v, geometry, ext_local);
+
+          Scalar val = block_scaling_coefficient * form_value * form->scaling_factor * current_als_j->coef[j] * current_als_i->coef[i];
+          evaluated_pairs++;
 
           if (current_als_j->dof[j] >= 0)
           {
@@ -651,10 +910,29 @@ namespace Hermes
         }
       }
 
+      HERMES_PROFILE_WORK((double)evaluated_pairs * n_quadrature_points);
+      this->statistics.form_evaluations += evaluated_pairs;
+      if (kernel)
+        this->statistics.kernel_evaluations += evaluated_pairs;
+      this->statistics.quadrature_points += (unsigned long long)evaluated_pairs * n_quadrature_points;
+
       // Insert the local stiffness matrix into the global one.
+      HERMES_PROFILE_REGION("DiscreteProblemThreadAssembler::scatter");
       if (this->current_mat)
+      {
         this->current_mat->add(current_als_i->cnt, current_als_j->cnt, local_stiffness_matrix, current_als_i->dof, current_als_j->dof, H2D_MAX_LOCAL_BASIS_SIZE);
 
+        // Entries with Dirichlet DOFs are skipped by add().
+        unsigned int rows = 0, cols = 0;
+        for (unsigned int i = 0; i < current_als_i->cnt; i++)
+          if (current_als_i->dof[i] >= 0)
+            rows++;
+        for (unsigned int j = 0; j < current_als_j->cnt; j++)
+          if (current_als_j->dof[j] >= 0)
+            cols++;
+        this->statistics.inserted_nonzeros += (unsigned long long)rows * cols * (tra ? 2 : 1);
+      }
+
       // Insert also the off-diagonal (anti-)symmetric block, if required.
       if (tra)
       {
@@ -685,6 +963,55 @@ namespace Hermes
       }
     }
 
+    template<typename Scalar>
+    bool DiscreteProblemThreadAssembler<Scalar>::pair_to_be_evaluated(MatrixForm<Scalar>* form, bool sym, AsmList<Scalar>* current_als_i, unsigned int i,
+      AsmList<Scalar>* current_als_j, unsigned int j) const
+    {
+      if (current_als_i->dof[i] < 0 || std::abs(current_als_i->coef[i]) < Hermes::HermesSqrtEpsilon)
+        return false;
+
+      if (current_als_j->dof[j] >= 0)
+      {
+        // Reused part of the matrix.
+        if (this->reusable_DOFs && *this->reusable_DOFs && (*this->reusable_DOFs)[current_als_j->dof[j]] && (*this->reusable_DOFs)[current_als_i->dof[i]])
+          return false;
+
+        // Symmetric values that do not contribute to Dirichlet lift.
+        if (sym && j < i)
+          return false;
+
+        // Anything that does not contribute to Dirichlet in the case of just rhs assembling.
+        if (!this->current_mat)
+          return false;
+      }
+      else
+      {
+        if (this->reusable_Dirichlet && *this->reusable_Dirichlet && (*this->reusable_Dirichlet)[form->j])
+          return false;
+
+        // Dirichlet values only go to the lift.
+        if (!(this->add_dirichlet_lift && this->current_rhs))
+          return false;
+      }
+
+      return std::abs(current_als_j->coef[j]) >= Hermes::HermesEpsilon;
+    }
+
+    template<typename Scalar>
+    bool DiscreteProblemThreadAssembler<Scalar>::evaluate_batch(MatrixFormVol<Scalar>* form, int n_quadrature_points, double* jacobian_x_weights, Func<Scalar>** u_ext,
+      Func<double>** base_fns, unsigned int base_count, Func<double>** test_fns, unsigned int test_count, GeomVol<double>* geometry, Func<Scalar>** ext)
+    {
+      return form->value_batch(n_quadrature_points, jacobian_x_weights, u_ext, base_fns, base_count, test_fns, test_count, geometry, ext,
+        this->batch_pairs, this->batch_values, H2D_MAX_LOCAL_BASIS_SIZE);
+    }
+
+    template<typename Scalar>
+    bool DiscreteProblemThreadAssembler<Scalar>::evaluate_batch(MatrixFormSurf<Scalar>* form, int n_quadrature_points, double* jacobian_x_weights, Func<Scalar>** u_ext,
+      Func<double>** base_fns, unsigned int base_count, Func<double>** test_fns, unsigned int test_count, GeomSurf<double>* geometry, Func<Scalar>** ext)
+    {
+      return false;
+    }
+
     template<typename Scalar>
     template<typename VectorFormType, typename Geom>
     void DiscreteProblemThreadAssembler<Scalar>::assemble_vector_form(VectorFormType* form, int order, Func<double>** test_fns,
@@ -705,6 +1032,9 @@ namespace Hermes
       if (this->rungeKutta)
         u_ext_local += form->u_ext_offset;
 
+      // Evaluated test functions - the work for the profiler.
+      unsigned int evaluated_functions = 0;
+
       // Actual form-specific calculation.
       for (unsigned int i = 0; i < current_als_i->cnt; i++)
       {
@@ -730,18 +1060,151 @@ namespace Hermes
           val = form->value(n_quadrature_points, jacobian_x_weights, u_ext_local, v, geometry, ext_local) * form->scaling_factor * current_als_i->coef[i];
 
         this->current_rhs->add(current_als_i->dof[i], val);
+        evaluated_functions++;
+      }
+
+      HERMES_PROFILE_WORK((double)evaluated_functions * n_quadrature_points);
+      this->statistics.form_evaluations += evaluated_functions;
+      this->statistics.quadrature_points += (unsigned long long)evaluated_functions * n_quadrature_points;
+    }
+
+    template<typename Scalar>
+    void DiscreteProblemThreadAssembler<Scalar>::calc_volumetric_form_values(int order, std::vector<std::vector<Scalar> >& values)
+    {
+      this->order = order;
+      this->init_calculation_variables();
+      this->init_u_ext_values(order);
+      this->init_ext_values(this->ext_funcs, this->wf->ext, this->wf->u_ext_fn, order, this->u_ext_funcs, &this->geometry);
+
+      unsigned short mfvol_size = this->wf->mfvol.size();
+      values.resize(mfvol_size + this->wf->vfvol.size());
+
+      for (unsigned short current_mfvol_i = 0; current_mfvol_i < mfvol_size; current_mfvol_i++)
+      {
+        MatrixFormVol<Scalar>* form = this->wf->mfvol[current_mfvol_i];
+        values[current_mfvol_i].clear();
+        if (!selectiveAssembler->form_to_be_assembled(form, current_state))
+          continue;
+
+        Func<Scalar>** ext_local = this->ext_funcs;
+        if (form->ext.size() > 0 || form->u_ext_fn.size() > 0)
+        {
+          this->init_ext_values(this->ext_funcs_local, form->ext, (form->u_ext_fn.size() > 0 ? form->u_ext_fn : this->wf->u_ext_fn), order, this->u_ext_funcs, &this->geometry);
+          ext_local = this->ext_funcs_local;
+        }
+        Func<Scalar>** u_ext_local = this->u_ext_funcs;
+        if (this->rungeKutta)
+          u_ext_local += form->u_ext_offset;
+
+        for (unsigned int i = 0; i < als[form->i].cnt; i++)
+          for (unsigned int j = 0; j < als[form->j].cnt; j++)
+            values[current_mfvol_i].push_back(form->value(n_quadrature_points, jacobian_x_weights, u_ext_local, funcs[form->j][j], funcs[form->i][i], &geometry, ext_local));
+      }
+
+      for (unsigned short current_vfvol_i = 0; current_vfvol_i < this->wf->vfvol.size(); current_vfvol_i++)
+      {
+        VectorFormVol<Scalar>* form = this->wf->vfvol[current_vfvol_i];
+        values[mfvol_size + current_vfvol_i].clear();
+        if (!selectiveAssembler->form_to_be_assembled(form, current_state))
+          continue;
+
+        Func<Scalar>** ext_local = this->ext_funcs;
+        if (form->ext.size() > 0 || form->u_ext_fn.size() > 0)
+        {
+          this->init_ext_values(this->ext_funcs_local, form->ext, (form->u_ext_fn.size() > 0 ? form->u_ext_fn : this->wf->u_ext_fn), order, this->u_ext_funcs, &this->geometry);
+          ext_local = this->ext_funcs_local;
+        }
+        Func<Scalar>** u_ext_local = this->u_ext_funcs;
+        if (this->rungeKutta)
+          u_ext_local += form->u_ext_offset;
+
+        for (unsigned int i = 0; i < als[form->i].cnt; i++)
+          values[mfvol_size + current_vfvol_i].push_back(form->value(n_quadrature_points, jacobian_x_weights, u_ext_local, funcs[form->i][i], &geometry, ext_local));
       }
     }
 
+    template<typename Scalar>
+    void DiscreteProblemThreadAssembler<Scalar>::calibrate_one_state(double tolerance, int* calibrated_orders)
+    {
+      int calculated_order = this->order;
+      ElementMode2D mode = current_state->rep->get_mode();
+      unsigned short forms_count = this->wf->mfvol.size() + this->wf->vfvol.size();
+
+      // Values for the (limited) orders, calculated on demand.
+      std::map<int, std::vector<std::vector<Scalar> > > values;
+
+      std::vector<bool> done(forms_count, false);
+      unsigned short done_count = 0;
+      this->calc_volumetric_form_values(calculated_order, values[calculated_order]);
+      for (unsigned short form_i = 0; form_i < forms_count; form_i++)
+      {
+        calibrated_orders[form_i] = values[calculated_order][form_i].empty() ? -1 : calculated_order;
+        if (values[calculated_order][form_i].empty())
+        {
+          done[form_i] = true;
+          done_count++;
+        }
+      }
+
+      for (int candidate = 0; candidate < calculated_order && done_count < forms_count; candidate++)
+      {
+        int order_k = candidate, order_k_2 = candidate + 2;
+        limit_order_nowarn(order_k, mode, this->quad_2d);
+        limit_order_nowarn(order_k_2, mode, this->quad_2d);
+        // Beyond the highest order of the rules, nothing to compare with.
+        if (order_k >= calculated_order || order_k_2 == order_k)
+          break;
+
+        if (values.find(order_k) == values.end())
+          this->calc_volumetric_form_values(order_k, values[order_k]);
+        if (values.find(order_k_2) == values.end())
+          this->calc_volumetric_form_values(order_k_2, values[order_k_2]);
+
+        for (unsigned short form_i = 0; form_i < forms_count; form_i++)
+        {
+          if (done[form_i])
+            continue;
+
+          std::vector<Scalar>& values_k = values[order_k][form_i];
+          std::vector<Scalar>& values_k_2 = values[order_k_2][form_i];
+          double difference = 0., norm = 0.;
+          for (unsigned int value_i = 0; value_i < values_k.size(); value_i++)
+          {
+            difference += std::abs(values_k[value_i] - values_k_2[value_i]) * std::abs(values_k[value_i] - values_k_2[value_i]);
+            norm += std::abs(values_k_2[value_i]) * std::abs(values_k_2[value_i]);
+          }
+
+          if (difference <= tolerance * tolerance * norm)
+          {
+            calibrated_orders[form_i] = order_k;
+            done[form_i] = true;
+            done_count++;
+          }
+        }
+      }
+
+      // Back to the calculated order.
+      this->order = calculated_order;
+      this->init_calculation_variables();
+    }
+
     template<typename Scalar>
     void DiscreteProblemThreadAssembler<Scalar>::deinit_assembling_one_state()
     {
       this->deinit_calculation_variables();
+
+      // Everything allocated for this state (incl. DG and order calculation) is released at once.
+      this->arena.reset();
     }
 
     template<typename Scalar>
     void DiscreteProblemThreadAssembler<Scalar>::deinit_assembling()
     {
+      for (unsigned short space_i = 0; space_i < this->spaces_size; space_i++)
+      {
+        this->statistics.precalc_hits += pss[space_i]->get_table_hits();
+        this->statistics.precalc_misses += pss[space_i]->get_table_misses();
+      }
     }
 
     template<typename Scalar>
@@ -750,6 +1213,7 @@ namespace Hermes
       this->deinit_funcs();
       this->free_spaces();
       this->free_weak_formulation();
+      this->free_weak_formulation_variants();
       this->free_u_ext();
 
       free_with_check(ext_funcs, true);
@@ -778,6 +1242,14 @@ namespace Hermes
         this->wf->free_ext();
     }
 
+    template<typename Scalar>
+    void DiscreteProblemThreadAssembler<Scalar>::free_weak_formulation_variants()
+    {
+      for (unsigned short variant_i = 0; variant_i < this->wf_variants.size(); variant_i++)
+        this->wf_variants[variant_i]->free_ext();
+      this->wf_variants.clear();
+    }
+
     template<typename Scalar>
     void DiscreteProblemThreadAssembler<Scalar>::free_u_ext()
     {
@@ -0,0 +1,224 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "discrete_problem/geometry_store.h"
+#include "discrete_problem/discrete_problem_helpers.h"
+#include "mesh/mesh.h"
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    GeometryStore::Key::Key(Element* element, uint64_t sub_idx, unsigned char quad_id, int order, char isurf) :
+      element(element), sub_idx(sub_idx), quad_id(quad_id), order(order), isurf(isurf)
+    {
+    }
+
+    bool GeometryStore::Key::operator<(const Key& other) const
+    {
+      if (element != other.element)
+        return std::less<Element*>()(element, other.element);
+      if (sub_idx != other.sub_idx)
+        return sub_idx < other.sub_idx;
+      if (quad_id != other.quad_id)
+        return quad_id < other.quad_id;
+      if (order != other.order)
+        return order < other.order;
+      return isurf < other.isurf;
+    }
+
+    GeometryStore::GeometryStore() : size(0)
+    {
+      for (unsigned short i = 0; i < shard_count; i++)
+        omp_init_lock(&shards[i].lock);
+      HermesCommonApi.register_memory_evictor(memoryRefMapCaches, &GeometryStore::evict, this);
+    }
+
+    GeometryStore::~GeometryStore()
+    {
+      HermesCommonApi.unregister_memory_evictor(memoryRefMapCaches, this);
+      this->clear();
+      for (unsigned short i = 0; i < shard_count; i++)
+        omp_destroy_lock(&shards[i].lock);
+    }
+
+    void GeometryStore::clear()
+    {
+      for (unsigned short i = 0; i < shard_count; i++)
+      {
+        for (std::map<Key, Record>::iterator it = shards[i].records.begin(); it != shards[i].records.end(); ++it)
+          delete[] it->second.data;
+        shards[i].records.clear();
+      }
+      HermesCommonApi.account_memory(memoryRefMapCaches, -this->size);
+      this->size = 0;
+    }
+
+    void GeometryStore::evict(void* store)
+    {
+      ((GeometryStore*)store)->clear();
+    }
+
+    void GeometryStore::validate(const std::vector<MeshSharedPtr>& meshes)
+    {
+      bool valid = (meshes.size() == this->mesh_seqs.size());
+      for (unsigned short i = 0; valid && i < meshes.size(); i++)
+        valid = (meshes[i].get() == this->mesh_seqs[i].first && meshes[i]->get_seq() == this->mesh_seqs[i].second);
+
+      if (valid)
+        return;
+
+      this->clear();
+      this->mesh_seqs.clear();
+      for (unsigned short i = 0; i < meshes.size(); i++)
+        this->mesh_seqs.push_back(std::pair<Mesh*, unsigned>(meshes[i].get(), meshes[i]->get_seq()));
+    }
+
+    GeometryStore::Shard& GeometryStore::get_shard(const Key& key)
+    {
+      // Elements of a mesh are stored in an array - neighboring elements go to different shards.
+      size_t hash = (size_t)key.element / sizeof(Element) + (size_t)key.sub_idx * 31 + key.order * 7 + key.isurf;
+      return this->shards[hash % shard_count];
+    }
+
+    void GeometryStore::insert(Shard& shard, const Key& key, Record& record)
+    {
+      long long record_size = (key.isurf < 0 ? 3 : 5) * record.np * sizeof(double);
+      bool inserted = false;
+      omp_set_lock(&shard.lock);
+      if (shard.records.find(key) == shard.records.end())
+      {
+        shard.records.insert(std::pair<Key, Record>(key, record));
+        inserted = true;
+      }
+      else
+        delete[] record.data;
+      omp_unset_lock(&shard.lock);
+
+      if (inserted)
+      {
+#pragma omp atomic
+        this->size += record_size;
+        HermesCommonApi.account_memory(memoryRefMapCaches, record_size);
+      }
+    }
+
+    unsigned char GeometryStore::get_volume_geometry(RefMap* rep_reference_mapping, int order, GeomVol<double>& geometry, double* jacobian_x_weights)
+    {
+      Element* e = rep_reference_mapping->get_active_element();
+      Key key(e, rep_reference_mapping->get_transform(), rep_reference_mapping->get_quad_2d()->get_id(), order, -1);
+      Shard& shard = this->get_shard(key);
+
+      omp_set_lock(&shard.lock);
+      std::map<Key, Record>::iterator it = shard.records.find(key);
+      if (it != shard.records.end())
+      {
+        unsigned char np = it->second.np;
+        memcpy(geometry.x, it->second.data, np * sizeof(double));
+        memcpy(geometry.y, it->second.data + np, np * sizeof(double));
+        memcpy(jacobian_x_weights, it->second.data + 2 * np, np * sizeof(double));
+        omp_unset_lock(&shard.lock);
+
+        geometry.id = e->id;
+        geometry.elem_marker = e->marker;
+        return np;
+      }
+      omp_unset_lock(&shard.lock);
+
+      // Over the memory limit - only calculate.
+      if (HermesCommonApi.memory_limit_exceeded(memoryRefMapCaches))
+        return init_geometry_points_allocated(rep_reference_mapping, order, geometry, jacobian_x_weights);
+
+      // Not stored yet - calculate (outside of the lock) and store.
+      Record record;
+      record.np = init_geometry_points_allocated(rep_reference_mapping, order, geometry, jacobian_x_weights);
+      record.edge_order = order;
+      record.orientation = false;
+      record.data = new double[3 * record.np];
+      memcpy(record.data, geometry.x, record.np * sizeof(double));
+      memcpy(record.data + record.np, geometry.y, record.np * sizeof(double));
+      memcpy(record.data + 2 * record.np, jacobian_x_weights, record.np * sizeof(double));
+      this->insert(shard, key, record);
+
+      return record.np;
+    }
+
+    unsigned char GeometryStore::get_surface_geometry(RefMap* rep_reference_mapping, int& order, unsigned char isurf, int marker, GeomSurf<double>& geometry, double* jacobian_x_weights)
+    {
+      Element* e = rep_reference_mapping->get_active_element();
+      Key key(e, rep_reference_mapping->get_transform(), rep_reference_mapping->get_quad_2d()->get_id(), order, isurf);
+      Shard& shard = this->get_shard(key);
+
+      omp_set_lock(&shard.lock);
+      std::map<Key, Record>::iterator it = shard.records.find(key);
+      if (it != shard.records.end())
+      {
+        unsigned char np = it->second.np;
+        double* data = it->second.data;
+        memcpy(geometry.x, data, np * sizeof(double));
+        memcpy(geometry.y, data + np, np * sizeof(double));
+        memcpy(geometry.tx, data + 2 * np, np * sizeof(double));
+        memcpy(geometry.ty, data + 3 * np, np * sizeof(double));
+        memcpy(jacobian_x_weights, data + 4 * np, np * sizeof(double));
+        order = it->second.edge_order;
+        geometry.orientation = it->second.orientation;
+        omp_unset_lock(&shard.lock);
+
+        for (unsigned char i = 0; i < np; i++)
+        {
+          geometry.nx[i] = geometry.ty[i];
+          geometry.ny[i] = -geometry.tx[i];
+        }
+        geometry.edge_marker = marker;
+        geometry.elem_marker = e->marker;
+        geometry.isurf = isurf;
+        return np;
+      }
+      omp_unset_lock(&shard.lock);
+
+      // Over the memory limit - only calculate.
+      if (HermesCommonApi.memory_limit_exceeded(memoryRefMapCaches))
+        return init_surface_geometry_points_allocated(rep_reference_mapping, order, isurf, marker, geometry, jacobian_x_weights);
+
+      // Not stored yet - calculate (outside of the lock) and store.
+      Record record;
+      record.np = init_surface_geometry_points_allocated(rep_reference_mapping, order, isurf, marker, geometry, jacobian_x_weights);
+      record.edge_order = order;
+      record.orientation = geometry.orientation;
+      record.data = new double[5 * record.np];
+      memcpy(record.data, geometry.x, record.np * sizeof(double));
+      memcpy(record.data + record.np, geometry.y, record.np * sizeof(double));
+      memcpy(record.data + 2 * record.np, geometry.tx, record.np * sizeof(double));
+      memcpy(record.data + 3 * record.np, geometry.ty, record.np * sizeof(double));
+      memcpy(record.data + 4 * record.np, jacobian_x_weights, record.np * sizeof(double));
+      this->insert(shard, key, record);
+
+      return record.np;
+    }
+
+    unsigned int GeometryStore::get_num_records() const
+    {
+      unsigned int count = 0;
+      for (unsigned short i = 0; i < shard_count; i++)
+        count += shards[i].records.size();
+      return count;
+    }
+
+    size_t GeometryStore::get_size() const
+    {
+      return (size_t)this->size;
+    }
+  }
+}
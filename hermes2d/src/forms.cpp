@@ -189,8 +189,8 @@ namespace Hermes
     }
 
     template<typename T>
-    DiscontinuousFunc<T>::DiscontinuousFunc(Func<T>* fn, bool support_on_neighbor, bool reverse) :
-      Func<T>(fn->np, fn->nc), fn_central(nullptr), fn_neighbor(nullptr), reverse_neighbor_side(reverse)
+    DiscontinuousFunc<T>::DiscontinuousFunc(Func<T>* fn, bool support_on_neighbor, bool reverse, MemoryArena* arena) :
+      Func<T>(fn->np, fn->nc), fn_central(nullptr), fn_neighbor(nullptr), reverse_neighbor_side(reverse), arena_allocated(arena != nullptr)
     {
       if (fn == nullptr)
         throw Hermes::Exceptions::Exception("Invalid arguments to DiscontinuousFunc constructor.");
@@ -199,9 +199,18 @@ namespace Hermes
         fn_neighbor = fn;
         if (reverse_neighbor_side)
         {
-          this->val_neighbor = malloc_with_check<DiscontinuousFunc<T>, T>(this->np, this);
-          this->dx_neighbor = malloc_with_check<DiscontinuousFunc<T>, T>(this->np, this);
-          this->dy_neighbor = malloc_with_check<DiscontinuousFunc<T>, T>(this->np, this);
+          if (arena)
+          {
+            this->val_neighbor = arena->allocate_array<T>(this->np);
+            this->dx_neighbor = arena->allocate_array<T>(this->np);
+            this->dy_neighbor = arena->allocate_array<T>(this->np);
+          }
+          else
+          {
+            this->val_neighbor = pool_malloc_with_check<T>(this->np);
+            this->dx_neighbor = pool_malloc_with_check<T>(this->np);
+            this->dy_neighbor = pool_malloc_with_check<T>(this->np);
+          }
           for (int i = 0; i < this->np; i++)
           {
             this->val_neighbor[i] = fn->val[this->np - i - 1];
@@ -230,13 +239,13 @@ namespace Hermes
 
     template<typename T>
     DiscontinuousFunc<T>::DiscontinuousFunc(Func<T>* fn_c, Func<T>* fn_n, bool reverse) :
-      Func<T>(fn_c->np, fn_c->nc), fn_central(fn_c), fn_neighbor(fn_n), reverse_neighbor_side(reverse)
+      Func<T>(fn_c->np, fn_c->nc), fn_central(fn_c), fn_neighbor(fn_n), reverse_neighbor_side(reverse), arena_allocated(false)
     {
       if (reverse_neighbor_side)
       {
-        this->val_neighbor = malloc_with_check<DiscontinuousFunc<T>, T>(this->np, this);
-        this->dx_neighbor = malloc_with_check<DiscontinuousFunc<T>, T>(this->np, this);
-        this->dy_neighbor = malloc_with_check<DiscontinuousFunc<T>, T>(this->np, this);
+        this->val_neighbor = pool_malloc_with_check<T>(this->np);
+        this->dx_neighbor = pool_malloc_with_check<T>(this->np);
+        this->dy_neighbor = pool_malloc_with_check<T>(this->np);
         for (int i = 0; i < this->np; i++)
         {
           this->val_neighbor[i] = fn_neighbor->val[this->np - i - 1];
@@ -314,6 +323,13 @@ namespace Hermes
     template<typename T>
     void DiscontinuousFunc<T>::free()
     {
+      // Released with the arena.
+      if (arena_allocated)
+      {
+        fn_central = fn_neighbor = nullptr;
+        return;
+      }
+
       if (fn_central != nullptr)
       {
         delete fn_central;
@@ -323,9 +339,9 @@ namespace Hermes
       {
         if (reverse_neighbor_side)
         {
-          free_with_check(this->val_neighbor);
-          free_with_check(this->dx_neighbor);
-          free_with_check(this->dy_neighbor);
+          pool_free_with_check(this->val_neighbor);
+          pool_free_with_check(this->dx_neighbor);
+          pool_free_with_check(this->dy_neighbor);
         }
         delete fn_neighbor;
         fn_neighbor = nullptr;
@@ -103,6 +103,8 @@ namespace Hermes
       dxdy_buffer = nullptr;
       num_coeffs = num_elems = 0;
       num_dofs = -1;
+      memory_category = memorySolutionTables;
+      memory_accounted = 0;
 
       this->set_quad_2d(&g_quad_2d_std);
     }
@@ -235,6 +237,34 @@ namespace Hermes
         free_with_check(elem_coeffs[i]);
 
       space_type = HERMES_INVALID_SPACE;
+      this->update_memory_accounting();
+    }
+
+    template<typename Scalar>
+    void Solution<Scalar>::update_memory_accounting()
+    {
+      long long bytes = 0;
+      if (mono_coeffs)
+        bytes += num_coeffs * sizeof(Scalar);
+      if (elem_orders)
+        bytes += num_elems * sizeof(int) * (1 + this->num_components);
+      if (dxdy_buffer)
+        bytes += this->num_components * 5 * 121 * sizeof(Scalar);
+      if (bytes != memory_accounted)
+      {
+        HermesCommonApi.account_memory(memory_category, bytes - memory_accounted);
+        memory_accounted = bytes;
+      }
+    }
+
+    template<typename Scalar>
+    void Solution<Scalar>::set_memory_category(HermesMemoryCategory category)
+    {
+      if (category == memory_category)
+        return;
+      HermesCommonApi.account_memory(memory_category, -memory_accounted);
+      HermesCommonApi.account_memory(category, memory_accounted);
+      memory_category = category;
     }
 
     template<typename Scalar>
@@ -693,6 +723,7 @@ namespace Hermes
     {
       free_with_check(dxdy_buffer);
       dxdy_buffer = malloc_with_check<Solution<Scalar>, Scalar>(this->num_components * 5 * 121, this);
+      this->update_memory_accounting();
     }
 
     template<typename Scalar>
@@ -234,41 +234,46 @@ namespace Hermes
       }
     }
 
-    void Element::get_center(double& x, double& y)
+    void Element::calc_center()
     {
-      if (!this->center_set)
+      this->x_center = this->vn[0]->x + this->vn[1]->x + this->vn[2]->x;
+      this->y_center = this->vn[0]->y + this->vn[1]->y + this->vn[2]->y;
+      if (this->is_quad())
       {
-#pragma omp critical
-        {
-          if (!this->center_set)
-          {
-            // x - coordinate
-            this->x_center = this->vn[0]->x + this->vn[1]->x + this->vn[2]->x;
-            this->y_center = this->vn[0]->y + this->vn[1]->y + this->vn[2]->y;
-            if (this->is_quad())
-            {
-              this->x_center += this->vn[3]->x;
-              this->x_center = this->x_center / 4.0;
-              this->y_center += this->vn[3]->y;
-              this->y_center = this->y_center / 4.0;
-            }
-            else
-            {
-              this->x_center = this->x_center / 3.0;
-              this->y_center = this->y_center / 3.0;
-            }
-            x = this->x_center;
-            y = this->y_center;
-            this->center_set = true;
-          }
-        }
+        this->x_center = (this->x_center + this->vn[3]->x) / 4.0;
+        this->y_center = (this->y_center + this->vn[3]->y) / 4.0;
       }
       else
+      {
+        this->x_center = this->x_center / 3.0;
+        this->y_center = this->y_center / 3.0;
+      }
+      this->center_set = true;
+    }
+
+    void Element::get_center(double& x, double& y) const
+    {
+      if (this->center_set)
       {
         x = this->x_center;
         y = this->y_center;
         return;
       }
+
+      // Not precomputed (Mesh::precompute_element_geometry()) - calculate without caching, so that
+      // concurrent readers never write into the element.
+      x = this->vn[0]->x + this->vn[1]->x + this->vn[2]->x;
+      y = this->vn[0]->y + this->vn[1]->y + this->vn[2]->y;
+      if (this->is_quad())
+      {
+        x = (x + this->vn[3]->x) / 4.0;
+        y = (y + this->vn[3]->y) / 4.0;
+      }
+      else
+      {
+        x = x / 3.0;
+        y = y / 3.0;
+      }
     }
 
     void Element::calc_diameter()
@@ -21,7 +21,7 @@ namespace Hermes
 {
   namespace Hermes2D
   {
-    HashTable::HashTable()
+    HashTable::HashTable() : memory_accounted(0)
     {
       v_table = nullptr; e_table = nullptr;
     }
@@ -44,6 +44,7 @@ namespace Hermes
 
       memset(v_table, 0, size * sizeof(Node*));
       memset(e_table, 0, size * sizeof(Node*));
+      this->update_memory_accounting();
     }
 
     void HashTable::copy_list(Node** ptr, Node* node)
@@ -85,6 +86,7 @@ namespace Hermes
         copy_list(v_table + i, ht->v_table[i]);
         copy_list(e_table + i, ht->e_table[i]);
       }
+      this->update_memory_accounting();
     }
 
     void HashTable::rebuild()
@@ -125,6 +127,20 @@ namespace Hermes
         delete[] e_table;
         e_table = nullptr;
       }
+      this->update_memory_accounting();
+    }
+
+    void HashTable::update_memory_accounting()
+    {
+      // Nodes are allocated in pages.
+      long long bytes = (long long)((nodes.get_size() + HERMES_PAGE_MASK) & ~HERMES_PAGE_MASK) * sizeof(Node);
+      if (v_table != nullptr)
+        bytes += 2 * (long long)(mask + 1) * sizeof(Node*);
+      if (bytes != this->memory_accounted)
+      {
+        HermesCommonApi.account_memory(memoryMeshHashTables, bytes - this->memory_accounted);
+        this->memory_accounted = bytes;
+      }
     }
 
     inline Node* HashTable::search_list(Node* node, int p1, int p2) const
@@ -149,6 +165,7 @@ namespace Hermes
 
       // not found - create a new_ one
       Node* newnode = nodes.add();
+      this->update_memory_accounting();
 
       // initialize the new_ Node
       newnode->type = HERMES_TYPE_VERTEX;
@@ -177,6 +194,7 @@ namespace Hermes
 
       // not found - create a new_ one
       Node* newnode = nodes.add();
+      this->update_memory_accounting();
 
       // initialize the new_ node
       newnode->type = HERMES_TYPE_EDGE;
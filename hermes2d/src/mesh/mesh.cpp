@@ -27,11 +27,19 @@ namespace Hermes
   namespace Hermes2D
   {
     unsigned g_mesh_seq = 0;
+
+    unsigned next_mesh_seq()
+    {
+      unsigned seq;
+#pragma omp atomic capture
+      seq = g_mesh_seq++;
+      return seq;
+    }
     static const int H2D_DG_INNER_EDGE_INT = -54125631;
     static const std::string H2D_DG_INNER_EDGE = "-54125631";
 
-    Mesh::Mesh() : HashTable(), meshHashGrid(nullptr), nbase(0), nactive(0), ntopvert(0), ninitial(0), seq(g_mesh_seq++),
-      bounding_box_calculated(0)
+    Mesh::Mesh() : HashTable(), meshHashGrid(nullptr), nbase(0), nactive(0), ntopvert(0), ninitial(0), seq(next_mesh_seq()),
+      element_geometry_seq(-1), bounding_box_calculated(0)
     {
     }
 
@@ -156,7 +164,7 @@ namespace Hermes
       }
 
       nbase = nactive = ninitial = nt + nq;
-      seq = g_mesh_seq++;
+      seq = next_mesh_seq();
     }
 
     int Mesh::get_num_elements() const
@@ -308,6 +316,46 @@ namespace Hermes
       this->seq = seq;
     }
 
+    void Mesh::precompute_element_geometry()
+    {
+      // The check is under the lock as well - the pass may be running from another (concurrently assembled) problem.
+#pragma omp critical (element_geometry_precomputation)
+      {
+        if (this->element_geometry_seq != (int)this->seq)
+        {
+          int num_threads_used = HermesCommonApi.get_integral_param_value(numThreads);
+          int max_element_id = this->get_max_element_id();
+
+#pragma omp parallel num_threads(num_threads_used)
+          {
+            int thread_number = omp_get_thread_num();
+            int start = (max_element_id / num_threads_used) * thread_number;
+            int end = (max_element_id / num_threads_used) * (thread_number + 1);
+            if (thread_number == num_threads_used - 1)
+              end = max_element_id;
+
+            for (int id = start; id < end; id++)
+            {
+              Element* e = this->get_element_fast(id);
+              if (!e->used)
+                continue;
+
+              // Refined elements inherit iro_cache from their parents, base elements not created
+              // by a mesh reader (e.g. Mesh::create()) may still miss it.
+              if (!e->parent && e->iro_cache == 0 && !e->has_const_ref_map())
+                RefMap::set_element_iro_cache(e);
+
+              // The area and the diameter are calculated when the element is created (and the area may be
+              // the precise one of a curved element, see MarkerArea), only the center is missing.
+              e->calc_center();
+            }
+          }
+
+          this->element_geometry_seq = this->seq;
+        }
+      }
+    }
+
     Element* Mesh::get_element_fast(int id) const
     {
       return &(elements[id]);
@@ -734,7 +782,7 @@ namespace Hermes
         if (e->sons[i])
           e->sons[i]->iro_cache = e->iro_cache;
 
-      this->seq = g_mesh_seq++;
+      this->seq = next_mesh_seq();
     }
 
     void Mesh::refine_element_id(int id, int refinement)
@@ -989,7 +1037,7 @@ namespace Hermes
           unrefine_element_id(e->sons[i]->id);
 
       unrefine_element_internal(e);
-      seq = g_mesh_seq++;
+      seq = next_mesh_seq();
     }
 
     void Mesh::unrefine_all_elements(bool keep_initial_refinements)
@@ -1244,7 +1292,7 @@ namespace Hermes
 
       nbase = nactive = ninitial = mesh->nbase;
       ntopvert = mesh->ntopvert;
-      seq = g_mesh_seq++;
+      seq = next_mesh_seq();
     }
 
     void Mesh::free()
@@ -1270,6 +1318,7 @@ namespace Hermes
       this->element_markers_conversion.conversion_table_inverse.clear();
       this->refinements.clear();
       this->seq = -1;
+      this->element_geometry_seq = -1;
 
       for (std::map<int, MarkerArea*>::iterator p = marker_areas.begin(); p != marker_areas.end(); p++)
         delete p->second;
@@ -1400,7 +1449,7 @@ namespace Hermes
 
       nbase = nactive = ninitial = mesh->nactive;
       ntopvert = mesh->ntopvert = get_num_nodes();
-      seq = g_mesh_seq++;
+      seq = next_mesh_seq();
     }
 
     void Mesh::convert_quads_to_triangles()
@@ -1699,7 +1748,7 @@ namespace Hermes
       else
         refine_quad_to_quads(e);
 
-      seq = g_mesh_seq++;
+      seq = next_mesh_seq();
     }
 
     void Mesh::refine_quad_to_triangles(Element* e)
@@ -1874,7 +1923,7 @@ namespace Hermes
       else
         refine_quad_to_triangles(e);
 
-      seq = g_mesh_seq++;
+      seq = next_mesh_seq();
     }
 
     void Mesh::convert_element_to_base_id(int id)
@@ -1889,7 +1938,7 @@ namespace Hermes
         // FIXME:
         convert_quads_to_base(e);
 
-      seq = g_mesh_seq++;
+      seq = next_mesh_seq();
     }
 
     Mesh::MarkersConversion::MarkersConversion() : min_marker_unused(1)
@@ -0,0 +1,155 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "mesh_partition.h"
+#include "mesh.h"
+#include <algorithm>
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    namespace
+    {
+      struct PointCoordinateLess
+      {
+        PointCoordinateLess(unsigned char axis) : axis(axis) {}
+        bool operator()(const std::pair<double, double>& a, const std::pair<double, double>& b) const
+        {
+          return axis == 0 ? (a.first < b.first || (a.first == b.first && a.second < b.second)) : (a.second < b.second || (a.second == b.second && a.first < b.first));
+        }
+        unsigned char axis;
+      };
+    }
+
+    MeshPartition::MeshPartition(MeshSharedPtr mesh, int num_parts, int part) : num_parts(num_parts), part(part)
+    {
+      if (num_parts < 1)
+        throw Exceptions::ValueException("num_parts", num_parts, 1);
+      if (part < 0 || part >= num_parts)
+        throw Exceptions::ValueException("part", part, 0, num_parts - 1);
+
+      std::vector<std::pair<double, double> > points;
+      Element* e;
+      for_all_active_elements(e, mesh)
+      {
+        std::pair<double, double> point;
+        e->get_center(point.first, point.second);
+        points.push_back(point);
+      }
+
+      this->part_sizes.resize(num_parts, 0);
+      this->bisect(points, 0, points.size(), 0, num_parts);
+    }
+
+    int MeshPartition::bisect(std::vector<std::pair<double, double> >& points, unsigned int first, unsigned int last, int first_part, int num_parts_to_split)
+    {
+      int node_i = this->nodes.size();
+      this->nodes.push_back(Node());
+
+      if (num_parts_to_split == 1)
+      {
+        this->nodes[node_i].part = first_part;
+        this->part_sizes[first_part] = last - first;
+        return node_i;
+      }
+
+      if (last - first < (unsigned int)num_parts_to_split)
+        throw Exceptions::Exception("MeshPartition: %u elements can not be split into %i parts, refine the mesh.", last - first, num_parts_to_split);
+
+      // Cut the longer side of the bounding box.
+      double min_x = points[first].first, max_x = min_x, min_y = points[first].second, max_y = min_y;
+      for (unsigned int i = first + 1; i < last; i++)
+      {
+        min_x = std::min(min_x, points[i].first);
+        max_x = std::max(max_x, points[i].first);
+        min_y = std::min(min_y, points[i].second);
+        max_y = std::max(max_y, points[i].second);
+      }
+      unsigned char preferred_axis = (max_x - min_x >= max_y - min_y) ? 0 : 1;
+
+      // The points are split in the ratio of the numbers of the parts below and above. The cut is in the middle between
+      // the neighboring coordinates, the points with the coordinate of the cut (aligned centers) all go above.
+      int parts_below = num_parts_to_split / 2;
+      unsigned int target_middle = first + (unsigned int)(((unsigned long long)(last - first) * parts_below) / num_parts_to_split);
+      unsigned char axis;
+      double value;
+      unsigned int middle = first;
+      for (unsigned char axis_i = 0; axis_i < 2 && (middle == first || middle == last); axis_i++)
+      {
+        axis = axis_i == 0 ? preferred_axis : 1 - preferred_axis;
+        std::sort(points.begin() + first, points.begin() + last, PointCoordinateLess(axis));
+        double below_value = axis == 0 ? points[target_middle - 1].first : points[target_middle - 1].second;
+        double above_value = axis == 0 ? points[target_middle].first : points[target_middle].second;
+        value = (below_value + above_value) / 2.;
+
+        middle = target_middle;
+        while (middle > first && (axis == 0 ? points[middle - 1].first : points[middle - 1].second) >= value)
+          middle--;
+        while (middle < last && (axis == 0 ? points[middle].first : points[middle].second) < value)
+          middle++;
+      }
+      if (middle == first || middle == last)
+        throw Exceptions::Exception("MeshPartition: elements with identical centers can not be split.");
+
+      this->nodes[node_i].part = -1;
+      this->nodes[node_i].axis = axis;
+      this->nodes[node_i].value = value;
+      int below = this->bisect(points, first, middle, first_part, parts_below);
+      int above = this->bisect(points, middle, last, first_part + parts_below, num_parts_to_split - parts_below);
+      this->nodes[node_i].below = below;
+      this->nodes[node_i].above = above;
+      return node_i;
+    }
+
+    int MeshPartition::get_num_parts() const
+    {
+      return this->num_parts;
+    }
+
+    int MeshPartition::get_part() const
+    {
+      return this->part;
+    }
+
+    int MeshPartition::get_owner(double x, double y) const
+    {
+      int node_i = 0;
+      while (this->nodes[node_i].part == -1)
+      {
+        const Node& node = this->nodes[node_i];
+        node_i = ((node.axis == 0 ? x : y) < node.value) ? node.below : node.above;
+      }
+      return this->nodes[node_i].part;
+    }
+
+    int MeshPartition::get_owner(Element* e) const
+    {
+      double x, y;
+      e->get_center(x, y);
+      return this->get_owner(x, y);
+    }
+
+    bool MeshPartition::is_owned(Element* e) const
+    {
+      return this->get_owner(e) == this->part;
+    }
+
+    const std::vector<unsigned int>& MeshPartition::get_part_sizes() const
+    {
+      return this->part_sizes;
+    }
+  }
+}
@@ -364,7 +364,7 @@ namespace Hermes
 			}
 			mesh->ninitial = mesh->elements.get_num_items();
 
-			mesh->seq = g_mesh_seq++;
+			mesh->seq = next_mesh_seq();
 			if (HermesCommonApi.get_integral_param_value(checkMeshesOnLoad))
 				mesh->initial_single_check();
 		}
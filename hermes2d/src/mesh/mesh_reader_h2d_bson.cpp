@@ -1051,7 +1051,7 @@ namespace Hermes
 
           delete[] elements_existing;
         }
-        meshes[subdomains_i]->seq = g_mesh_seq++;
+        meshes[subdomains_i]->seq = next_mesh_seq();
         if (HermesCommonApi.get_integral_param_value(checkMeshesOnLoad))
           meshes[subdomains_i]->initial_single_check();
       }
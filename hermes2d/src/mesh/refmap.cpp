@@ -127,12 +127,10 @@ namespace Hermes
 #endif
         return;
       }
-#pragma omp critical (element_iro_cache_setting)
-      {
-        RefMap rm;
-        rm.set_active_element(element);
-        element->iro_cache = rm.calc_inv_ref_order();
-      }
+      // Only the element itself is written, calls for distinct elements can run concurrently.
+      RefMap rm;
+      rm.set_active_element(element);
+      element->iro_cache = rm.calc_inv_ref_order();
     }
 
     void RefMap::reinit_storage()
@@ -299,6 +299,11 @@ namespace Hermes
       // This will be returned.
       int count = 0, predictedCount = 0;
       this->num = meshes_count;
+
+      // All the per-element geometry is calculated here, so that the (parallel) users of the states only read it.
+      for (int i = 0; i < meshes_count; i++)
+        meshes[i]->precompute_element_geometry();
+
       for (int i = 0; i < meshes_count; i++)
         if (meshes[i]->get_num_active_elements() > predictedCount)
           predictedCount = meshes[i]->get_num_active_elements();
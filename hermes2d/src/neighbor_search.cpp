@@ -91,7 +91,7 @@ namespace Hermes
       n_neighbors = ns.n_neighbors;
       neighborhood_type = ns.neighborhood_type;
       original_central_el_transform = ns.original_central_el_transform;
-      quad = (&g_quad_2d_std);
+      quad = ns.quad;
       active_edge = ns.active_edge;
     }
 
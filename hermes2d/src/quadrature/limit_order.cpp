@@ -9,10 +9,10 @@ namespace Hermes
     static unsigned short default_order_table_tri[] =
     {
       0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
-      17, 18, 19, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
-      20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
-      20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20,
-      20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20
+      17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30,
+      30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+      30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30,
+      30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30
     };
 
 #ifdef EXTREME_QUAD
@@ -80,9 +80,19 @@ namespace Hermes
 
     HERMES_API void limit_order(int& o, ElementMode2D mode)
     {
-      if (o >= g_quad_2d_std.get_safe_max_order(mode))
+      limit_order(o, mode, &g_quad_2d_std);
+    }
+
+    HERMES_API void limit_order_nowarn(int& o, ElementMode2D mode)
+    {
+      limit_order_nowarn(o, mode, &g_quad_2d_std);
+    }
+
+    HERMES_API void limit_order(int& o, ElementMode2D mode, Quad2D* quad)
+    {
+      if (o >= quad->get_safe_max_order(mode))
       {
-        o = g_quad_2d_std.get_safe_max_order(mode);
+        o = quad->get_safe_max_order(mode);
         warn_order();
       }
       if (mode == HERMES_MODE_TRIANGLE)
@@ -91,14 +101,14 @@ namespace Hermes
         o = g_order_table_quad[o];
     }
 
-    HERMES_API void limit_order_nowarn(int& o, ElementMode2D mode)
+    HERMES_API void limit_order_nowarn(int& o, ElementMode2D mode, Quad2D* quad)
     {
-      if (o > g_quad_2d_std.get_safe_max_order(mode))
-        o = g_quad_2d_std.get_safe_max_order(mode);
+      if (o > quad->get_safe_max_order(mode))
+        o = quad->get_safe_max_order(mode);
       if (mode == HERMES_MODE_TRIANGLE)
         o = g_order_table_tri[o];
       else
         o = g_order_table_quad[o];
     }
   }
-}
\ No newline at end of file
+}
@@ -1662,6 +1662,200 @@ namespace Hermes
       max_order = g_max_quad;
     }
 
+    //// 1D Gauss-Lobatto quadrature tables ////////////////////////////////////////////////////////////
+
+    // n points including the end points of the interval, exact for polynomials of degree 2n - 3.
+    static double2 lobatto_pts_0_1_1d[] =
+    {
+      { -1.0, 1.0 },
+      { 1.0, 1.0 }
+    };
+
+    static double2 lobatto_pts_2_3_1d[] =
+    {
+      { -1.0, 0.3333333333333333 },
+      { 0.0, 1.3333333333333333 },
+      { 1.0, 0.3333333333333333 }
+    };
+
+    static double2 lobatto_pts_4_5_1d[] =
+    {
+      { -1.0, 0.1666666666666667 },
+      { -0.4472135954999579, 0.8333333333333334 },
+      { 0.4472135954999579, 0.8333333333333334 },
+      { 1.0, 0.1666666666666667 }
+    };
+
+    static double2 lobatto_pts_6_7_1d[] =
+    {
+      { -1.0, 0.1000000000000000 },
+      { -0.6546536707079772, 0.5444444444444444 },
+      { 0.0, 0.7111111111111111 },
+      { 0.6546536707079772, 0.5444444444444444 },
+      { 1.0, 0.1000000000000000 }
+    };
+
+    static double2 lobatto_pts_8_9_1d[] =
+    {
+      { -1.0, 0.0666666666666667 },
+      { -0.7650553239294647, 0.3784749562978470 },
+      { -0.2852315164806451, 0.5548583770354863 },
+      { 0.2852315164806451, 0.5548583770354863 },
+      { 0.7650553239294647, 0.3784749562978470 },
+      { 1.0, 0.0666666666666667 }
+    };
+
+    static double2 lobatto_pts_10_11_1d[] =
+    {
+      { -1.0, 0.0476190476190476 },
+      { -0.8302238962785670, 0.2768260473615660 },
+      { -0.4688487934707142, 0.4317453812098626 },
+      { 0.0, 0.4876190476190476 },
+      { 0.4688487934707142, 0.4317453812098626 },
+      { 0.8302238962785670, 0.2768260473615660 },
+      { 1.0, 0.0476190476190476 }
+    };
+
+    static double2 lobatto_pts_12_13_1d[] =
+    {
+      { -1.0, 0.0357142857142857 },
+      { -0.8717401485096066, 0.2107042271435060 },
+      { -0.5917001814331423, 0.3411226924835044 },
+      { -0.2092992179024789, 0.4124587946587039 },
+      { 0.2092992179024789, 0.4124587946587039 },
+      { 0.5917001814331423, 0.3411226924835044 },
+      { 0.8717401485096066, 0.2107042271435060 },
+      { 1.0, 0.0357142857142857 }
+    };
+
+    static double2 lobatto_pts_14_15_1d[] =
+    {
+      { -1.0, 0.0277777777777778 },
+      { -0.8997579954114602, 0.1654953615608055 },
+      { -0.6771862795107377, 0.2745387125001617 },
+      { -0.3631174638261782, 0.3464285109730463 },
+      { 0.0, 0.3715192743764172 },
+      { 0.3631174638261782, 0.3464285109730463 },
+      { 0.6771862795107377, 0.2745387125001617 },
+      { 0.8997579954114602, 0.1654953615608055 },
+      { 1.0, 0.0277777777777778 }
+    };
+
+    static double2 lobatto_pts_16_17_1d[] =
+    {
+      { -1.0, 0.0222222222222222 },
+      { -0.9195339081664589, 0.1333059908510701 },
+      { -0.7387738651055050, 0.2248893420631264 },
+      { -0.4779249498104445, 0.2920426836796838 },
+      { -0.1652789576663870, 0.3275397611838974 },
+      { 0.1652789576663870, 0.3275397611838974 },
+      { 0.4779249498104445, 0.2920426836796838 },
+      { 0.7387738651055050, 0.2248893420631264 },
+      { 0.9195339081664589, 0.1333059908510701 },
+      { 1.0, 0.0222222222222222 }
+    };
+
+    static double2 lobatto_pts_18_19_1d[] =
+    {
+      { -1.0, 0.0181818181818182 },
+      { -0.9340014304080592, 0.1096122732669949 },
+      { -0.7844834736631444, 0.1871698817803052 },
+      { -0.5652353269962050, 0.2480481042640283 },
+      { -0.2957581355869394, 0.2868791247790081 },
+      { 0.0, 0.3002175954556907 },
+      { 0.2957581355869394, 0.2868791247790081 },
+      { 0.5652353269962050, 0.2480481042640283 },
+      { 0.7844834736631444, 0.1871698817803052 },
+      { 0.9340014304080592, 0.1096122732669949 },
+      { 1.0, 0.0181818181818182 }
+    };
+
+    static double2 lobatto_pts_20_21_1d[] =
+    {
+      { -1.0, 0.0151515151515152 },
+      { -0.9448992722228822, 0.0916845174131961 },
+      { -0.8192793216440066, 0.1579747055643701 },
+      { -0.6328761530318607, 0.2125084177610211 },
+      { -0.3995309409653489, 0.2512756031992013 },
+      { -0.1365529328549276, 0.2714052409106962 },
+      { 0.1365529328549276, 0.2714052409106962 },
+      { 0.3995309409653489, 0.2512756031992013 },
+      { 0.6328761530318607, 0.2125084177610211 },
+      { 0.8192793216440066, 0.1579747055643701 },
+      { 0.9448992722228822, 0.0916845174131961 },
+      { 1.0, 0.0151515151515152 }
+    };
+
+    static double2 lobatto_pts_22_23_1d[] =
+    {
+      { -1.0, 0.0128205128205128 },
+      { -0.9533098466421639, 0.0778016867468189 },
+      { -0.8463475646518723, 0.1349819266896083 },
+      { -0.6861884690817575, 0.1836468652035501 },
+      { -0.4829098210913362, 0.2207677935661101 },
+      { -0.2492869301062400, 0.2440157903066764 },
+      { 0.0, 0.2519308493334467 },
+      { 0.2492869301062400, 0.2440157903066764 },
+      { 0.4829098210913362, 0.2207677935661101 },
+      { 0.6861884690817575, 0.1836468652035501 },
+      { 0.8463475646518723, 0.1349819266896083 },
+      { 0.9533098466421639, 0.0778016867468189 },
+      { 1.0, 0.0128205128205128 }
+    };
+
+    static double2* lobatto_tables_1d[] =
+    {
+      lobatto_pts_0_1_1d, lobatto_pts_0_1_1d,
+      lobatto_pts_2_3_1d, lobatto_pts_2_3_1d,
+      lobatto_pts_4_5_1d, lobatto_pts_4_5_1d,
+      lobatto_pts_6_7_1d, lobatto_pts_6_7_1d,
+      lobatto_pts_8_9_1d, lobatto_pts_8_9_1d,
+      lobatto_pts_10_11_1d, lobatto_pts_10_11_1d,
+      lobatto_pts_12_13_1d, lobatto_pts_12_13_1d,
+      lobatto_pts_14_15_1d, lobatto_pts_14_15_1d,
+      lobatto_pts_16_17_1d, lobatto_pts_16_17_1d,
+      lobatto_pts_18_19_1d, lobatto_pts_18_19_1d,
+      lobatto_pts_20_21_1d, lobatto_pts_20_21_1d,
+      lobatto_pts_22_23_1d, lobatto_pts_22_23_1d
+    };
+
+    static unsigned char lobatto_np_1d[] =
+    {
+      sizeof(lobatto_pts_0_1_1d) / sizeof(double2),
+      sizeof(lobatto_pts_0_1_1d) / sizeof(double2),
+      sizeof(lobatto_pts_2_3_1d) / sizeof(double2),
+      sizeof(lobatto_pts_2_3_1d) / sizeof(double2),
+      sizeof(lobatto_pts_4_5_1d) / sizeof(double2),
+      sizeof(lobatto_pts_4_5_1d) / sizeof(double2),
+      sizeof(lobatto_pts_6_7_1d) / sizeof(double2),
+      sizeof(lobatto_pts_6_7_1d) / sizeof(double2),
+      sizeof(lobatto_pts_8_9_1d) / sizeof(double2),
+      sizeof(lobatto_pts_8_9_1d) / sizeof(double2),
+      sizeof(lobatto_pts_10_11_1d) / sizeof(double2),
+      sizeof(lobatto_pts_10_11_1d) / sizeof(double2),
+      sizeof(lobatto_pts_12_13_1d) / sizeof(double2),
+      sizeof(lobatto_pts_12_13_1d) / sizeof(double2),
+      sizeof(lobatto_pts_14_15_1d) / sizeof(double2),
+      sizeof(lobatto_pts_14_15_1d) / sizeof(double2),
+      sizeof(lobatto_pts_16_17_1d) / sizeof(double2),
+      sizeof(lobatto_pts_16_17_1d) / sizeof(double2),
+      sizeof(lobatto_pts_18_19_1d) / sizeof(double2),
+      sizeof(lobatto_pts_18_19_1d) / sizeof(double2),
+      sizeof(lobatto_pts_20_21_1d) / sizeof(double2),
+      sizeof(lobatto_pts_20_21_1d) / sizeof(double2),
+      sizeof(lobatto_pts_22_23_1d) / sizeof(double2),
+      sizeof(lobatto_pts_22_23_1d) / sizeof(double2)
+    };
+
+    Quad1DLobatto::Quad1DLobatto()
+    {
+      tables = lobatto_tables_1d;
+      np = lobatto_np_1d;
+      ref_vert[0] = -1.0;
+      ref_vert[1] = 1.0;
+      max_order = g_max_quad_lobatto;
+    }
+
     //// 2D quadrature tables (triangle) ///////////////////////////////////////////////////////////////
 
     static double3 std_pts_0_2d_tri[] =
@@ -2422,18 +2616,18 @@ namespace Hermes
 
     ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-    static double3* make_quad_table(int order, unsigned char& np)
+    static double3* make_quad_table(int order, unsigned char& np, double2** tables_1d = std_tables_1d, unsigned char* np_1d = std_np_1d)
     {
       // points on a quad are calculated as a simple cartesian
       // product of 1D quadrature points...
 
-      np = Hermes::sqr(std_np_1d[order]);
+      np = Hermes::sqr(np_1d[order]);
       double3* result = malloc_with_check<double3>(np);
-      double2* table = std_tables_1d[order];
+      double2* table = tables_1d[order];
 
-      for (int i = 0, n = 0; i < std_np_1d[order]; i++)
+      for (int i = 0, n = 0; i < np_1d[order]; i++)
       {
-        for (int j = 0; j < std_np_1d[order]; j++, n++)
+        for (int j = 0; j < np_1d[order]; j++, n++)
         {
           result[n][0] = table[i][0];
           result[n][1] = table[j][0];
@@ -2444,11 +2638,11 @@ namespace Hermes
       return result;
     }
 
-    static double3* make_edge_table(double2& v1, double2& v2, unsigned char& np, unsigned short order)
+    static double3* make_edge_table(double2& v1, double2& v2, unsigned char& np, unsigned short order, double2** tables_1d = std_tables_1d, unsigned char* np_1d = std_np_1d)
     {
-      np = std_np_1d[order];
+      np = np_1d[order];
       double3* result = malloc_with_check<double3>(np);
-      double2* table = std_tables_1d[order];
+      double2* table = tables_1d[order];
 
       for (unsigned char i = 0; i < np; i++)
       {
@@ -2553,10 +2747,154 @@ namespace Hermes
       }
     }
 
+    //// 2D Gauss-Lobatto quadrature ///////////////////////////////////////////////////////////////////
+
+    static double3* lobatto_tables_2d_quad[g_max_quad_lobatto + 1 + 4 * g_max_quad_lobatto + 4];
+    static unsigned char lobatto_np_2d_quad[g_max_quad_lobatto + 1 + 4 * g_max_quad_lobatto + 4];
+
+    static double3** lobatto_tables_2d[2] =
+    {
+      std_tables_2d_tri,
+      lobatto_tables_2d_quad
+    };
+
+    static unsigned char* lobatto_np_2d[2] =
+    {
+      std_np_2d_tri,
+      lobatto_np_2d_quad
+    };
+
+    Quad2DLobatto::Quad2DLobatto()
+    {
+      ref_vert[0][0][0] = -1.0;
+      ref_vert[0][0][1] = -1.0;
+      ref_vert[0][1][0] = 1.0;
+      ref_vert[0][1][1] = -1.0;
+      ref_vert[0][2][0] = -1.0;
+      ref_vert[0][2][1] = 1.0;
+
+      ref_vert[1][0][0] = -1.0;
+      ref_vert[1][0][1] = -1.0;
+      ref_vert[1][1][0] = 1.0;
+      ref_vert[1][1][1] = -1.0;
+      ref_vert[1][2][0] = 1.0;
+      ref_vert[1][2][1] = 1.0;
+      ref_vert[1][3][0] = -1.0;
+      ref_vert[1][3][1] = 1.0;
+
+      // Triangles share the (edge) tables of Quad2DStd, which are filled in by g_quad_2d_std.
+      max_order[0] = g_max_tri;   safe_max_order[0] = g_max_tri - 1;
+      max_order[1] = g_max_quad_lobatto;  safe_max_order[1] = g_max_quad_lobatto;
+
+      num_tables[0] = max_order[0] + 1 + 3 * max_order[0] + 3;
+      num_tables[1] = max_order[1] + 1 + 4 * max_order[1] + 4;
+
+      unsigned short i, j, k, l;
+      for (i = 0; i <= max_order[1]; i++)
+      {
+        lobatto_tables_2d_quad[i] = make_quad_table(i, lobatto_np_2d_quad[i], lobatto_tables_1d, lobatto_np_1d);
+        for (j = 0; j < 4; j++)
+        {
+          k = max_order[1] + 1 + 4 * i + j;
+          l = j < 3 ? j + 1 : 0;
+          lobatto_tables_2d_quad[k] = make_edge_table(ref_vert[1][j], ref_vert[1][l], lobatto_np_2d_quad[k], i, lobatto_tables_1d, lobatto_np_1d);
+        }
+      }
+
+      tables = lobatto_tables_2d;
+      np = lobatto_np_2d;
+    }
+
+    Quad2DLobatto::~Quad2DLobatto()
+    {
+      unsigned short i, j, k;
+      for (i = 0; i <= max_order[1]; i++)
+      {
+        free_with_check(lobatto_tables_2d_quad[i]);
+        for (j = 0; j < 4; j++)
+        {
+          k = max_order[1] + 1 + 4 * i + j;
+          free_with_check(lobatto_tables_2d_quad[k]);
+        }
+      }
+    }
+
+    Quad2DComposite::Quad2DComposite(Quad2D* quad_tri, Quad2D* quad_quad)
+    {
+      Quad2D* quads[H2D_NUM_MODES] = { quad_tri, quad_quad };
+      this->id = (unsigned char)((quad_tri->get_id() << 4) | quad_quad->get_id());
+
+      tables = malloc_with_check<double3**>(H2D_NUM_MODES);
+      np = malloc_with_check<unsigned char*>(H2D_NUM_MODES);
+      for (int mode = 0; mode < H2D_NUM_MODES; mode++)
+      {
+        ElementMode2D element_mode = (ElementMode2D)mode;
+        max_order[mode] = quads[mode]->get_max_order(element_mode);
+        safe_max_order[mode] = quads[mode]->get_safe_max_order(element_mode);
+        num_tables[mode] = quads[mode]->get_num_tables(element_mode);
+
+        for (int i = 0; i < (mode == HERMES_MODE_TRIANGLE ? 3 : 4); i++)
+        {
+          ref_vert[mode][i][0] = quads[mode]->get_ref_vertex(i, element_mode)[0][0];
+          ref_vert[mode][i][1] = quads[mode]->get_ref_vertex(i, element_mode)[0][1];
+        }
+
+        tables[mode] = malloc_with_check<double3*>(num_tables[mode]);
+        np[mode] = malloc_with_check<unsigned char>(num_tables[mode]);
+        for (unsigned short i = 0; i < num_tables[mode]; i++)
+        {
+          tables[mode][i] = quads[mode]->get_points(i, element_mode);
+          np[mode][i] = quads[mode]->get_num_points(i, element_mode);
+        }
+      }
+    }
+
+    Quad2DComposite::~Quad2DComposite()
+    {
+      for (int mode = 0; mode < H2D_NUM_MODES; mode++)
+      {
+        free_with_check(tables[mode]);
+        free_with_check(np[mode]);
+      }
+      free_with_check(tables);
+      free_with_check(np);
+    }
+
+    /// The shared instances of Quad2DComposite::get().
+    class Quad2DCompositeInstances
+    {
+    public:
+      ~Quad2DCompositeInstances()
+      {
+        for (std::map<std::pair<Quad2D*, Quad2D*>, Quad2DComposite*>::iterator it = instances.begin(); it != instances.end(); it++)
+          delete it->second;
+      }
+      std::map<std::pair<Quad2D*, Quad2D*>, Quad2DComposite*> instances;
+    };
+
+    Quad2D* Quad2DComposite::get(Quad2D* quad_tri, Quad2D* quad_quad)
+    {
+      if (quad_tri == quad_quad)
+        return quad_tri;
+
+      static Quad2DCompositeInstances composite_instances;
+      Quad2D* quad;
+#pragma omp critical (Quad2DComposite_get)
+      {
+        Quad2DComposite*& instance = composite_instances.instances[std::make_pair(quad_tri, quad_quad)];
+        if (!instance)
+          instance = new Quad2DComposite(quad_tri, quad_quad);
+        quad = instance;
+      }
+      return quad;
+    }
+
     //// global standard 1d and 2d quadrature //////////////////////////////////////////////////////////
     // ... for use in any module
 
     Quad2DLin g_quad_lin;
+    HERMES_API Quad1DLobatto g_quad_1d_lobatto;
+    HERMES_API Quad2DLobatto g_quad_2d_lobatto;
 
     Quad2DLin::Quad2DLin()
     {
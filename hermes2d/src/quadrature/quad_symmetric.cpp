@@ -0,0 +1,785 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "global.h"
+#include "quad_all.h"
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    /// Types of orbits of a point under the symmetries of the triangle.
+    enum SymmetricOrbitType
+    {
+      /// The centroid, 1 point.
+      H2D_ORBIT_S3 = 0,
+      /// (a, a, 1 - 2a), 3 points.
+      H2D_ORBIT_S21 = 1,
+      /// (a, b, 1 - a - b), 6 points.
+      H2D_ORBIT_S111 = 2
+    };
+
+    /// One orbit of a fully symmetric rule - the barycentric coordinates of the generating point
+    /// (a, b, 1 - a - b) and the weight of every point of the orbit (the weights sum up to 2,
+    /// the area of the reference triangle).
+    struct SymmetricOrbit
+    {
+      SymmetricOrbitType type;
+      double a, b, w;
+    };
+
+    //// 2D quadrature tables (triangle), orbits ///////////////////////////////////////////////////////
+
+    static SymmetricOrbit sym_orbits_1_2d_tri[] =
+    {
+      { H2D_ORBIT_S3, 1.0 / 3, 1.0 / 3, 2.0000000000000000e+00 }
+    };
+
+    static SymmetricOrbit sym_orbits_2_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 1.6666666666666669e-01, 1.6666666666666669e-01, 6.6666666666666674e-01 }
+    };
+
+    static SymmetricOrbit sym_orbits_3_2d_tri[] =
+    {
+      { H2D_ORBIT_S111, 1.0903900907287722e-01, 2.3193336855303059e-01, 3.3333333333333337e-01 }
+    };
+
+    static SymmetricOrbit sym_orbits_4_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 9.1576213509770715e-02, 9.1576213509770715e-02, 2.1990348731064380e-01 },
+      { H2D_ORBIT_S21, 4.4594849091596489e-01, 4.4594849091596489e-01, 4.4676317935602305e-01 }
+    };
+
+    static SymmetricOrbit sym_orbits_5_2d_tri[] =
+    {
+      { H2D_ORBIT_S3, 1.0 / 3, 1.0 / 3, 4.5000000000000001e-01 },
+      { H2D_ORBIT_S21, 1.0128650732345634e-01, 1.0128650732345634e-01, 2.5187836108965439e-01 },
+      { H2D_ORBIT_S21, 4.7014206410511511e-01, 4.7014206410511511e-01, 2.6478830557701238e-01 }
+    };
+
+    static SymmetricOrbit sym_orbits_6_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 6.3089014491502213e-02, 6.3089014491502213e-02, 1.0168981274041368e-01 },
+      { H2D_ORBIT_S21, 2.4928674517091043e-01, 2.4928674517091043e-01, 2.3357255145275879e-01 },
+      { H2D_ORBIT_S111, 5.3145049844816945e-02, 3.1035245103378439e-01, 1.6570215123674720e-01 }
+    };
+
+    static SymmetricOrbit sym_orbits_7_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 6.4930513159164913e-02, 6.4930513159164913e-02, 1.0615560358046483e-01 },
+      { H2D_ORBIT_S111, 4.3863471792372481e-02, 3.1355918438493152e-01, 1.3854936415883379e-01 },
+      { H2D_ORBIT_S111, 1.9838447668150672e-01, 2.8457558424917029e-01, 1.4170616738426714e-01 }
+    };
+
+    static SymmetricOrbit sym_orbits_8_2d_tri[] =
+    {
+      { H2D_ORBIT_S3, 1.0 / 3, 1.0 / 3, 2.8863121535557429e-01 },
+      { H2D_ORBIT_S21, 5.0547228317031012e-02, 5.0547228317031012e-02, 6.4916995246396186e-02 },
+      { H2D_ORBIT_S21, 1.7056930775176024e-01, 1.7056930775176024e-01, 2.0643474106943657e-01 },
+      { H2D_ORBIT_S21, 4.5929258829272318e-01, 4.5929258829272318e-01, 1.9018326853456927e-01 },
+      { H2D_ORBIT_S111, 8.3947774099576034e-03, 2.6311282963463811e-01, 5.4460628348869992e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_9_2d_tri[] =
+    {
+      { H2D_ORBIT_S3, 1.0 / 3, 1.0 / 3, 1.9427159256559767e-01 },
+      { H2D_ORBIT_S21, 4.4729513394452705e-02, 4.4729513394452705e-02, 5.1155351317396063e-02 },
+      { H2D_ORBIT_S21, 1.8820353561903275e-01, 1.8820353561903275e-01, 1.5929547785442055e-01 },
+      { H2D_ORBIT_S21, 4.3708959149293664e-01, 4.3708959149293664e-01, 1.5565508200954861e-01 },
+      { H2D_ORBIT_S21, 4.8968251919873762e-01, 4.8968251919873762e-01, 6.2669400454278129e-02 },
+      { H2D_ORBIT_S111, 3.6838412054736251e-02, 2.2196298916076571e-01, 8.6567078754578766e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_10_2d_tri[] =
+    {
+      { H2D_ORBIT_S3, 1.0 / 3, 1.0 / 3, 1.5978900948247937e-01 },
+      { H2D_ORBIT_S21, 2.3308867510000161e-02, 2.3308867510000161e-02, 1.6447637380928384e-02 },
+      { H2D_ORBIT_S21, 4.2508621060209056e-01, 4.2508621060209056e-01, 1.4224760446475471e-01 },
+      { H2D_ORBIT_S111, 2.9946031954170872e-02, 3.5874014186443148e-01, 7.4719712468610575e-02 },
+      { H2D_ORBIT_S111, 3.5632559587503443e-02, 1.4329537042686716e-01, 6.1773313769127994e-02 },
+      { H2D_ORBIT_S111, 1.4792562620953448e-01, 2.2376697357697301e-01, 9.0861184592340064e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_11_2d_tri[] =
+    {
+      { H2D_ORBIT_S3, 1.0 / 3, 1.0 / 3, 1.6721401606615582e-01 },
+      { H2D_ORBIT_S21, 2.9915452918742615e-02, 2.9915452918742615e-02, 2.3013380805556601e-02 },
+      { H2D_ORBIT_S21, 1.0866335467432195e-01, 1.0866335467432195e-01, 7.8727900336276913e-02 },
+      { H2D_ORBIT_S21, 2.1256867593906850e-01, 2.1256867593906850e-01, 1.3819667214265532e-01 },
+      { H2D_ORBIT_S21, 4.3772766458135559e-01, 4.3772766458135559e-01, 1.3049296926201784e-01 },
+      { H2D_ORBIT_S21, 4.9724222376929883e-01, 4.9724222376929883e-01, 2.9005712259555755e-02 },
+      { H2D_ORBIT_S111, 1.1589591208655103e-02, 1.5507097340216985e-01, 2.5310813493715355e-02 },
+      { H2D_ORBIT_S111, 4.6926395247537327e-02, 3.0063048613373400e-01, 8.0435199758894169e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_12_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 2.1317350453210385e-02, 2.1317350453210385e-02, 1.2332522103118047e-02 },
+      { H2D_ORBIT_S21, 1.2757614554158589e-01, 1.2757614554158589e-01, 6.9592225861417847e-02 },
+      { H2D_ORBIT_S21, 2.7121038501211592e-01, 2.7121038501211592e-01, 1.2571644843577021e-01 },
+      { H2D_ORBIT_S21, 4.3972439229446031e-01, 4.3972439229446031e-01, 8.7385089076076838e-02 },
+      { H2D_ORBIT_S21, 4.8821738977380486e-01, 4.8821738977380486e-01, 5.1462132880910678e-02 },
+      { H2D_ORBIT_S111, 2.2838332222257021e-02, 2.8132558098993959e-01, 4.4713546404606896e-02 },
+      { H2D_ORBIT_S111, 2.5734050548330206e-02, 1.1625191590759722e-01, 3.4632462217317778e-02 },
+      { H2D_ORBIT_S111, 1.1534349453469800e-01, 2.7571326968551418e-01, 8.0743115532761894e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_13_2d_tri[] =
+    {
+      { H2D_ORBIT_S3, 1.0 / 3, 1.0 / 3, 1.3592007317366323e-01 },
+      { H2D_ORBIT_S21, 2.1509681108843173e-02, 2.1509681108843173e-02, 1.2104674207078355e-02 },
+      { H2D_ORBIT_S21, 2.2137228629183295e-01, 2.2137228629183295e-01, 1.1655697023839996e-01 },
+      { H2D_ORBIT_S21, 4.2694141425980042e-01, 4.2694141425980042e-01, 1.1120393506090670e-01 },
+      { H2D_ORBIT_S21, 4.8907694645253935e-01, 4.8907694645253935e-01, 4.7988803857789475e-02 },
+      { H2D_ORBIT_S111, 5.1263891023823893e-03, 2.7251581777342970e-01, 1.9181362007086523e-02 },
+      { H2D_ORBIT_S111, 2.4370186901093840e-02, 1.1092204280346352e-01, 2.9930802210331356e-02 },
+      { H2D_ORBIT_S111, 6.8012243554206708e-02, 3.0844176089211767e-01, 6.9282552281696747e-02 },
+      { H2D_ORBIT_S111, 8.7895483032197408e-02, 1.6359740106785045e-01, 4.8358079623187590e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_14_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 1.9390961248701051e-02, 1.9390961248701051e-02, 9.8468072048001620e-03 },
+      { H2D_ORBIT_S21, 6.1799883090872622e-02, 6.1799883090872622e-02, 2.8867399339553363e-02 },
+      { H2D_ORBIT_S21, 1.7720553241254347e-01, 1.7720553241254347e-01, 8.4325177473986032e-02 },
+      { H2D_ORBIT_S21, 2.7347752830883865e-01, 2.7347752830883865e-01, 1.0354820901458314e-01 },
+      { H2D_ORBIT_S21, 4.1764471934045388e-01, 4.1764471934045388e-01, 6.5576707088250655e-02 },
+      { H2D_ORBIT_S21, 4.8896391036217862e-01, 4.8896391036217862e-01, 4.3767162738857779e-02 },
+      { H2D_ORBIT_S111, 1.2683309328720459e-03, 1.1897449769695685e-01, 1.0020457677001353e-02 },
+      { H2D_ORBIT_S111, 1.4646950055654400e-02, 2.9837288213625768e-01, 2.8872616227067684e-02 },
+      { H2D_ORBIT_S111, 5.7124757403647974e-02, 1.7226668782135562e-01, 4.9331506425127354e-02 },
+      { H2D_ORBIT_S111, 9.2916249356971806e-02, 3.3686145979634508e-01, 7.7143021574121395e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_15_2d_tri[] =
+    {
+      { H2D_ORBIT_S3, 1.0 / 3, 1.0 / 3, 9.9109522972142303e-02 },
+      { H2D_ORBIT_S21, 1.8789501810770104e-02, 1.8789501810770104e-02, 8.9943075848701575e-03 },
+      { H2D_ORBIT_S21, 7.9031013655541646e-02, 7.9031013655541646e-02, 3.6973577209323122e-02 },
+      { H2D_ORBIT_S21, 4.0886316907744108e-01, 4.0886316907744108e-01, 7.6045526907722358e-02 },
+      { H2D_ORBIT_S21, 4.9250168823249674e-01, 4.9250168823249674e-01, 2.6821032760025669e-02 },
+      { H2D_ORBIT_S111, 1.2563596287784990e-02, 9.2290158424266119e-02, 1.2883746581037863e-02 },
+      { H2D_ORBIT_S111, 1.5082654870922751e-02, 3.2515745241110783e-01, 2.3498949297027897e-02 },
+      { H2D_ORBIT_S111, 2.1594628433980249e-02, 1.9495514589281163e-01, 2.4723234434311289e-02 },
+      { H2D_ORBIT_S111, 7.7663767064308109e-02, 3.6883948374857539e-01, 6.2520855120315230e-02 },
+      { H2D_ORBIT_S111, 9.8765911355712110e-02, 2.0250549804829998e-01, 6.0349290291092546e-02 },
+      { H2D_ORBIT_S111, 1.9412620368774625e-01, 2.6709528567005231e-01, 5.8421781549887586e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_16_2d_tri[] =
+    {
+      { H2D_ORBIT_S3, 1.0 / 3, 1.0 / 3, 9.0672330023640307e-02 },
+      { H2D_ORBIT_S21, 1.2425572001444054e-02, 1.2425572001444054e-02, 4.3403798536198962e-03 },
+      { H2D_ORBIT_S21, 8.5402539407933215e-02, 8.5402539407933215e-02, 3.3617224285927463e-02 },
+      { H2D_ORBIT_S21, 4.5669426695387461e-01, 4.5669426695387461e-01, 5.1990860909353481e-02 },
+      { H2D_ORBIT_S21, 4.9174838341891591e-01, 4.9174838341891591e-01, 2.8901109350169457e-02 },
+      { H2D_ORBIT_S111, 1.4160772533794762e-02, 3.2454003524021802e-01, 2.3342344674493733e-02 },
+      { H2D_ORBIT_S111, 1.4539694958941836e-02, 1.7807138906021469e-01, 1.8964525758721682e-02 },
+      { H2D_ORBIT_S111, 1.6623223223705786e-02, 7.1270046159486247e-02, 1.4227445616378865e-02 },
+      { H2D_ORBIT_S111, 7.1278762832147805e-02, 1.9037793160178629e-01, 3.6516474220193773e-02 },
+      { H2D_ORBIT_S111, 7.4295478991330655e-02, 3.2374950270039099e-01, 4.6607897753192414e-02 },
+      { H2D_ORBIT_S111, 1.5341553679414691e-01, 2.0622099278664210e-01, 3.8919936640166831e-02 },
+      { H2D_ORBIT_S111, 1.9177327270918182e-01, 3.2315912848634387e-01, 8.0217866466710863e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_17_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 7.0311169611369531e-02, 7.0311169611369531e-02, 2.5235377156306686e-02 },
+      { H2D_ORBIT_S21, 1.6970943096730493e-01, 1.6970943096730493e-01, 4.6744917733833775e-02 },
+      { H2D_ORBIT_S21, 2.8661252432964462e-01, 2.8661252432964462e-01, 7.3289986747575073e-02 },
+      { H2D_ORBIT_S21, 4.1719510152416933e-01, 4.1719510152416933e-01, 5.9330233494098432e-02 },
+      { H2D_ORBIT_S21, 4.6460596554534145e-01, 4.6460596554534145e-01, 4.8812262559019562e-02 },
+      { H2D_ORBIT_S21, 4.9299908483602467e-01, 4.9299908483602467e-01, 2.2429463259874750e-02 },
+      { H2D_ORBIT_S111, 1.2143616665049943e-02, 2.1090996331740275e-02, 3.6070094195309248e-03 },
+      { H2D_ORBIT_S111, 1.2764128457657424e-02, 3.3817448834951036e-01, 1.9806649576783440e-02 },
+      { H2D_ORBIT_S111, 1.3708002381358386e-02, 8.5724970564892450e-02, 1.2714893915054344e-02 },
+      { H2D_ORBIT_S111, 1.4372542103585179e-02, 1.9636670248163557e-01, 1.8833688405694108e-02 },
+      { H2D_ORBIT_S111, 6.7367644878250199e-02, 3.1052672399296183e-01, 4.5265998359426338e-02 },
+      { H2D_ORBIT_S111, 7.3699441088488665e-02, 1.7146140925303924e-01, 3.9074585111017121e-02 },
+      { H2D_ORBIT_S111, 1.6123546505462782e-01, 2.8706486657252928e-01, 5.6109388070472901e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_18_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 1.2602417958148987e-02, 1.2602417958148987e-02, 4.1579640153090285e-03 },
+      { H2D_ORBIT_S21, 6.3747327887491309e-02, 6.3747327887491309e-02, 1.9888103510783378e-02 },
+      { H2D_ORBIT_S21, 1.3934907834267324e-01, 1.3934907834267324e-01, 3.5376526933080493e-02 },
+      { H2D_ORBIT_S21, 2.4819095239852609e-01, 2.4819095239852609e-01, 5.6884186887225539e-02 },
+      { H2D_ORBIT_S21, 3.7428444044429149e-01, 3.7428444044429149e-01, 6.1783293253155472e-02 },
+      { H2D_ORBIT_S111, 1.1372382860449781e-02, 2.7817064579761525e-01, 1.5545304532686342e-02 },
+      { H2D_ORBIT_S111, 1.1388737567138022e-02, 1.5649025239079237e-01, 1.2547448886126042e-02 },
+      { H2D_ORBIT_S111, 1.1618079190989792e-02, 4.1983567794408266e-01, 1.7514502856107440e-02 },
+      { H2D_ORBIT_S111, 1.2347247274805030e-02, 6.5474104729957822e-02, 9.1894110921238795e-03 },
+      { H2D_ORBIT_S111, 5.8793960991559119e-02, 1.5181841566000001e-01, 2.6928764715790966e-02 },
+      { H2D_ORBIT_S111, 5.8824020359308879e-02, 2.6779328442001249e-01, 3.2976896044455951e-02 },
+      { H2D_ORBIT_S111, 6.0029330951462262e-02, 4.0057370579130369e-01, 3.6621907187030699e-02 },
+      { H2D_ORBIT_S111, 1.3965253349995577e-01, 2.4404636655374567e-01, 4.3794372604785359e-02 },
+      { H2D_ORBIT_S111, 1.4233863717400475e-01, 3.6486436625245311e-01, 4.9169688114449682e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_19_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 4.0434609986941823e-02, 4.0434609986941823e-02, 1.3499220588335432e-02 },
+      { H2D_ORBIT_S21, 8.7297887217022196e-02, 8.7297887217022196e-02, 1.6402016423518063e-02 },
+      { H2D_ORBIT_S21, 2.3002865854508703e-01, 2.3002865854508703e-01, 4.4470225643035120e-02 },
+      { H2D_ORBIT_S21, 4.2755365020011538e-01, 4.2755365020011538e-01, 5.3038672974268133e-02 },
+      { H2D_ORBIT_S21, 4.9410758479374300e-01, 4.9410758479374300e-01, 1.8364415600329326e-02 },
+      { H2D_ORBIT_S111, 2.6777540856154991e-03, 2.5124265326116588e-02, 2.5296655394012667e-03 },
+      { H2D_ORBIT_S111, 1.0974486897951639e-02, 2.0760951722253165e-01, 1.4014242076457935e-02 },
+      { H2D_ORBIT_S111, 1.0994737874385180e-02, 9.7827198205484717e-02, 1.0223724990677790e-02 },
+      { H2D_ORBIT_S111, 1.1554874489755129e-02, 3.4404009731829743e-01, 1.7185210267776117e-02 },
+      { H2D_ORBIT_S111, 5.3485774385522107e-02, 1.4074443047995447e-01, 2.2604118515198873e-02 },
+      { H2D_ORBIT_S111, 5.7808779539971600e-02, 2.5772947874966118e-01, 3.3194425367223473e-02 },
+      { H2D_ORBIT_S111, 6.0612492331481596e-02, 3.9635644263528469e-01, 3.9031838177070226e-02 },
+      { H2D_ORBIT_S111, 1.2620114078456440e-01, 1.8307455689046093e-01, 3.3327626699687571e-02 },
+      { H2D_ORBIT_S111, 1.3999742049362013e-01, 2.9765324836367058e-01, 4.7428663687779066e-02 },
+      { H2D_ORBIT_S111, 2.5140295134618518e-01, 3.3235281808200950e-01, 4.0906542397318016e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_20_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 6.3813072045705108e-03, 6.3813072045705108e-03, 1.3478149280204174e-03 },
+      { H2D_ORBIT_S21, 5.9169556606370646e-02, 5.9169556606370646e-02, 1.7671979441403383e-02 },
+      { H2D_ORBIT_S21, 1.3758670182905372e-01, 1.3758670182905372e-01, 3.5562913680356856e-02 },
+      { H2D_ORBIT_S21, 2.1815948521733244e-01, 2.1815948521733244e-01, 4.5925589497196828e-02 },
+      { H2D_ORBIT_S21, 3.5518511077693421e-01, 3.5518511077693421e-01, 2.4886161402279117e-02 },
+      { H2D_ORBIT_S21, 4.7233877127183710e-01, 4.7233877127183710e-01, 2.7287727607918630e-02 },
+      { H2D_ORBIT_S21, 4.9462584635472701e-01, 4.9462584635472701e-01, 1.5869421048465074e-02 },
+      { H2D_ORBIT_S111, 9.6911626357058800e-03, 2.2123574168472440e-01, 1.1835269102553433e-02 },
+      { H2D_ORBIT_S111, 9.7665601578270454e-03, 3.5208265891923179e-01, 1.3947803037879800e-02 },
+      { H2D_ORBIT_S111, 1.0814568317182183e-02, 4.3746667531572095e-02, 6.1640714483658099e-03 },
+      { H2D_ORBIT_S111, 1.1717390654112786e-02, 1.1659603859793423e-01, 1.0697036827708518e-02 },
+      { H2D_ORBIT_S111, 4.9027626291279956e-02, 2.4278108938317602e-01, 2.4103721677908151e-02 },
+      { H2D_ORBIT_S111, 5.1897377288612483e-02, 3.5826402346744252e-01, 2.7621390989200103e-02 },
+      { H2D_ORBIT_S111, 5.8476129577037399e-02, 1.4118839415205736e-01, 2.4172902139897624e-02 },
+      { H2D_ORBIT_S111, 1.1927861502080511e-01, 2.4774885197249727e-01, 4.0426880418523298e-02 },
+      { H2D_ORBIT_S111, 1.2698227329290190e-01, 3.7063597560751466e-01, 4.4521626388425814e-02 },
+      { H2D_ORBIT_S111, 2.1913095075142530e-01, 3.2864920549135940e-01, 4.5566827500050651e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_21_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 1.0893013358569374e-02, 1.0893013358569374e-02, 3.1011484974004739e-03 },
+      { H2D_ORBIT_S21, 5.0337895108084077e-02, 5.0337895108084077e-02, 1.2820799935592172e-02 },
+      { H2D_ORBIT_S21, 1.1283949088338779e-01, 1.1283949088338779e-01, 2.5681940020668315e-02 },
+      { H2D_ORBIT_S21, 2.9658003895958679e-01, 2.9658003895958679e-01, 4.7023132833033339e-02 },
+      { H2D_ORBIT_S21, 4.4710158828033919e-01, 4.4710158828033919e-01, 3.8100830140317850e-02 },
+      { H2D_ORBIT_S21, 4.9584891395359720e-01, 4.9584891395359720e-01, 1.1625701432846563e-02 },
+      { H2D_ORBIT_S111, 8.8590083870855561e-03, 3.6113681637767775e-01, 1.1824587542508199e-02 },
+      { H2D_ORBIT_S111, 9.0630240161507850e-03, 1.3468864255795804e-01, 8.5139570452122948e-03 },
+      { H2D_ORBIT_S111, 9.5008632657351422e-03, 5.6548602192997191e-02, 6.1235929627292711e-03 },
+      { H2D_ORBIT_S111, 9.9805947657709785e-03, 2.3788247245737934e-01, 1.1645551599182931e-02 },
+      { H2D_ORBIT_S111, 4.3917665761799118e-02, 4.2544492091288572e-01, 2.0761671195966527e-02 },
+      { H2D_ORBIT_S111, 4.6565040360970103e-02, 1.2138148775002176e-01, 1.7297858884374948e-02 },
+      { H2D_ORBIT_S111, 4.7404819924808994e-02, 3.1872362247964642e-01, 2.2337697808943010e-02 },
+      { H2D_ORBIT_S111, 5.1869063299424055e-02, 2.1285435724848950e-01, 2.3159279939813208e-02 },
+      { H2D_ORBIT_S111, 1.1067870403805991e-01, 3.2087812454325504e-01, 3.6503450597213570e-02 },
+      { H2D_ORBIT_S111, 1.2260010613088010e-01, 2.0504644544666509e-01, 3.4563572140614604e-02 },
+      { H2D_ORBIT_S111, 1.9361161032848920e-01, 3.4763416974563910e-01, 4.2539009717950153e-02 },
+      { H2D_ORBIT_S111, 1.9764801861853187e-01, 2.4393072115395784e-01, 2.8886327468895284e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_22_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 3.2665948554702423e-02, 3.2665948554702423e-02, 8.2403718328020147e-03 },
+      { H2D_ORBIT_S21, 7.1281932435953613e-02, 7.1281932435953613e-02, 1.5639249389428404e-02 },
+      { H2D_ORBIT_S21, 2.5408878859057588e-01, 2.5408878859057588e-01, 4.6788890616362440e-02 },
+      { H2D_ORBIT_S21, 4.2103036334256139e-01, 4.2103036334256139e-01, 3.9305926641519287e-02 },
+      { H2D_ORBIT_S21, 4.8786991265064750e-01, 4.8786991265064750e-01, 2.1343679160851212e-02 },
+      { H2D_ORBIT_S111, 1.4725138864824536e-03, 4.2102632777896193e-01, 4.9607451499940692e-03 },
+      { H2D_ORBIT_S111, 2.7394416940264999e-03, 1.9274776117508725e-02, 1.5988395734601076e-03 },
+      { H2D_ORBIT_S111, 5.3523251703050190e-03, 2.7756834832001492e-01, 7.2363790290356101e-03 },
+      { H2D_ORBIT_S111, 5.6382165666241995e-03, 1.6253049059636390e-01, 6.2822246607337710e-03 },
+      { H2D_ORBIT_S111, 8.6147233221965484e-03, 7.4194353017304301e-02, 6.0844552042023719e-03 },
+      { H2D_ORBIT_S111, 2.6682657327840191e-02, 3.5136180717449222e-01, 2.0503737913627761e-02 },
+      { H2D_ORBIT_S111, 3.3271226725488379e-02, 2.1817376826500728e-01, 1.8882107876324262e-02 },
+      { H2D_ORBIT_S111, 3.4692108548592455e-02, 1.2028100675079360e-01, 1.3545235465577008e-02 },
+      { H2D_ORBIT_S111, 7.8268216376777708e-02, 3.9790370567308486e-01, 3.3793619084582491e-02 },
+      { H2D_ORBIT_S111, 7.9881852435253767e-02, 2.7355989366507644e-01, 3.0811576964852701e-02 },
+      { H2D_ORBIT_S111, 9.1537368868698926e-02, 1.5609414630514060e-01, 2.8115502132814035e-02 },
+      { H2D_ORBIT_S111, 1.5379522832673961e-01, 2.1180226513908942e-01, 3.0537187305265657e-02 },
+      { H2D_ORBIT_S111, 1.5726294540639074e-01, 3.1339303999468493e-01, 3.8688491517012341e-02 },
+      { H2D_ORBIT_S111, 2.5851112590660813e-01, 3.5991937341411750e-01, 2.6634172635369522e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_23_2d_tri[] =
+    {
+      { H2D_ORBIT_S3, 1.0 / 3, 1.0 / 3, 2.0000003985917308e-02 },
+      { H2D_ORBIT_S21, 9.0708461292935468e-03, 9.0708461292935468e-03, 2.1552312797929801e-03 },
+      { H2D_ORBIT_S21, 4.6031937042113051e-02, 4.6031937042113051e-02, 1.0525292831566476e-02 },
+      { H2D_ORBIT_S21, 1.0425644874796840e-01, 1.0425644874796840e-01, 2.1451195724532180e-02 },
+      { H2D_ORBIT_S21, 3.7255584592616409e-01, 3.7255584592616409e-01, 3.5536156158260820e-02 },
+      { H2D_ORBIT_S111, 4.5716625491284413e-03, 2.0472171388548754e-01, 5.0707188481273497e-03 },
+      { H2D_ORBIT_S111, 7.2746455127079418e-03, 4.3409175484605467e-01, 9.2336590872089987e-03 },
+      { H2D_ORBIT_S111, 8.0642055745934263e-03, 3.1314702454805177e-01, 9.5733370999187151e-03 },
+      { H2D_ORBIT_S111, 8.2340609961196135e-03, 1.1354989294180443e-01, 6.6830019292163203e-03 },
+      { H2D_ORBIT_S111, 8.8545436723868106e-03, 4.7217729856384623e-02, 4.7773392352657923e-03 },
+      { H2D_ORBIT_S111, 2.8502752684165369e-02, 2.0036185000940709e-01, 1.4279137991152305e-02 },
+      { H2D_ORBIT_S111, 3.7980438765965796e-02, 4.2061434848621548e-01, 2.0440714606606566e-02 },
+      { H2D_ORBIT_S111, 4.1786389392999779e-02, 3.0279820165339238e-01, 2.0693665848424816e-02 },
+      { H2D_ORBIT_S111, 4.3032419369016486e-02, 1.1049929883448716e-01, 1.4803172048198936e-02 },
+      { H2D_ORBIT_S111, 7.7107861927049978e-02, 1.9168684152931015e-01, 2.2559658264020038e-02 },
+      { H2D_ORBIT_S111, 9.1642619864408498e-02, 3.9854410897572268e-01, 2.8525701926428993e-02 },
+      { H2D_ORBIT_S111, 9.9193926089678808e-02, 2.8762227118664618e-01, 2.8338685907254951e-02 },
+      { H2D_ORBIT_S111, 1.4047286149548480e-01, 1.8288760907095877e-01, 2.0040674565627584e-02 },
+      { H2D_ORBIT_S111, 1.6544861304205824e-01, 3.6307443858375932e-01, 3.5410910893481258e-02 },
+      { H2D_ORBIT_S111, 1.7577839068124582e-01, 2.5416767649424710e-01, 3.2107644891355980e-02 },
+      { H2D_ORBIT_S111, 2.4625958552603436e-01, 2.8713915832584047e-01, 2.2628038196315658e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_24_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 5.4325249565069242e-03, 5.4325249565069242e-03, 8.9182068107143523e-04 },
+      { H2D_ORBIT_S21, 9.2931943769697989e-02, 9.2931943769697989e-02, 1.9637319673440110e-02 },
+      { H2D_ORBIT_S21, 3.6711547950241769e-01, 3.6711547950241769e-01, 4.2691169905892001e-02 },
+      { H2D_ORBIT_S21, 4.8050542690346121e-01, 4.8050542690346121e-01, 2.0970538136378072e-02 },
+      { H2D_ORBIT_S21, 4.9626626495725584e-01, 4.9626626495725584e-01, 8.6591231809066069e-03 },
+      { H2D_ORBIT_S111, 6.5165146651661758e-03, 9.1267028586500459e-02, 4.8154498917081304e-03 },
+      { H2D_ORBIT_S111, 7.4090467838898938e-03, 2.7359300815210763e-01, 8.0562028172570712e-03 },
+      { H2D_ORBIT_S111, 7.5085791960176219e-03, 3.8334790598687479e-01, 8.6174212728113517e-03 },
+      { H2D_ORBIT_S111, 8.3443366051087833e-03, 3.4073919332199096e-02, 3.5913796023200975e-03 },
+      { H2D_ORBIT_S111, 8.4507604488681404e-03, 1.7352458584320993e-01, 7.9716912610862077e-03 },
+      { H2D_ORBIT_S111, 3.5450601368767008e-02, 5.5465013695209980e-02, 6.0514696938991745e-03 },
+      { H2D_ORBIT_S111, 3.6512509816144324e-02, 1.0782443882261569e-01, 1.0655038204874524e-02 },
+      { H2D_ORBIT_S111, 3.8392599844849350e-02, 2.5646159853782757e-01, 1.6362198505249347e-02 },
+      { H2D_ORBIT_S111, 3.9017981598473979e-02, 3.6236842777898182e-01, 1.9876957803970446e-02 },
+      { H2D_ORBIT_S111, 4.6038267657313198e-02, 1.7395703060162385e-01, 1.4798875575225552e-02 },
+      { H2D_ORBIT_S111, 9.2497805948891398e-02, 2.7730511982922629e-01, 2.8370134051644829e-02 },
+      { H2D_ORBIT_S111, 9.3975430302765367e-02, 3.9307622259975195e-01, 3.1398574716823738e-02 },
+      { H2D_ORBIT_S111, 1.0508479091596439e-01, 1.7528134896298084e-01, 2.6336498504815727e-02 },
+      { H2D_ORBIT_S111, 1.6418060309813526e-01, 2.7935497290239591e-01, 2.8978951958005175e-02 },
+      { H2D_ORBIT_S111, 1.6974498805863120e-01, 3.7051599074894465e-01, 3.0609957079411894e-02 },
+      { H2D_ORBIT_S111, 1.7597299065508945e-01, 1.9868632174288467e-01, 1.7036463246952405e-02 },
+      { H2D_ORBIT_S111, 2.4339591511211131e-01, 2.7945198870815835e-01, 2.3381083358433627e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_25_2d_tri[] =
+    {
+      { H2D_ORBIT_S3, 1.0 / 3, 1.0 / 3, 4.4750962549061080e-02 },
+      { H2D_ORBIT_S21, 7.0956288729023638e-03, 7.0956288729023638e-03, 1.3186590092508291e-03 },
+      { H2D_ORBIT_S21, 3.9634463682723671e-02, 3.9634463682723671e-02, 8.0517537438190203e-03 },
+      { H2D_ORBIT_S21, 8.0721351741302308e-02, 8.0721351741302308e-02, 1.2305742042513343e-02 },
+      { H2D_ORBIT_S21, 1.4776556808109528e-01, 1.4776556808109528e-01, 2.4576582429314035e-02 },
+      { H2D_ORBIT_S21, 2.0026107078221927e-01, 2.0026107078221927e-01, 2.8534567606874194e-02 },
+      { H2D_ORBIT_S21, 2.6534046561802965e-01, 2.6534046561802965e-01, 3.4866303406026318e-02 },
+      { H2D_ORBIT_S21, 4.6174427802695750e-01, 4.6174427802695750e-01, 2.5645153903027545e-02 },
+      { H2D_ORBIT_S21, 4.9683721215473142e-01, 4.9683721215473142e-01, 8.0688628618851583e-03 },
+      { H2D_ORBIT_S111, 2.4439233201910271e-03, 1.6190909149227198e-01, 3.0284873543063922e-03 },
+      { H2D_ORBIT_S111, 6.1270002702084499e-03, 3.7319042993819901e-01, 7.6269720871807540e-03 },
+      { H2D_ORBIT_S111, 7.2362117520336422e-03, 8.8958188578407399e-02, 4.5507625070364162e-03 },
+      { H2D_ORBIT_S111, 7.5230440898630254e-03, 3.6976147266408424e-02, 3.1918883986738226e-03 },
+      { H2D_ORBIT_S111, 7.8271949615827292e-03, 2.5927067541321808e-01, 8.3829838063236347e-03 },
+      { H2D_ORBIT_S111, 2.3628007632337106e-02, 1.7083654579698246e-01, 1.1290545413332244e-02 },
+      { H2D_ORBIT_S111, 3.2389449320410005e-02, 4.2247752681927409e-01, 1.7347087353060911e-02 },
+      { H2D_ORBIT_S111, 3.4176894525041503e-02, 9.7842208373720638e-02, 9.9190481768508740e-03 },
+      { H2D_ORBIT_S111, 3.4553284030605660e-02, 3.1259525041348235e-01, 1.5484580439092793e-02 },
+      { H2D_ORBIT_S111, 5.0044414603405217e-02, 2.2981385655384814e-01, 1.5984949301451105e-02 },
+      { H2D_ORBIT_S111, 7.7466135175938394e-02, 1.4822586650348368e-01, 1.9221345462497031e-02 },
+      { H2D_ORBIT_S111, 8.2765879660026853e-02, 3.4219123974482218e-01, 2.7034619350014642e-02 },
+      { H2D_ORBIT_S111, 1.0757977201206752e-01, 2.3730748898954865e-01, 2.7310130042722345e-02 },
+      { H2D_ORBIT_S111, 1.4186029156281635e-01, 3.8205489075949950e-01, 2.7438355012365651e-02 },
+      { H2D_ORBIT_S111, 1.6776035792545335e-01, 2.8813498967320861e-01, 2.9847416793201215e-02 },
+      { H2D_ORBIT_S111, 2.2579952693918234e-01, 3.5383678442184091e-01, 2.6531855575691370e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_26_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 4.5211207821389387e-03, 4.5211207821389387e-03, 5.5919269904531027e-04 },
+      { H2D_ORBIT_S21, 6.2668633776577373e-02, 6.2668633776577373e-02, 1.0388059122391945e-02 },
+      { H2D_ORBIT_S21, 9.9332166797971133e-02, 9.9332166797971133e-02, 1.5982277933789268e-02 },
+      { H2D_ORBIT_S21, 1.9242325294267590e-01, 1.9242325294267590e-01, 3.1217903907035459e-02 },
+      { H2D_ORBIT_S21, 2.4434207353171758e-01, 2.4434207353171758e-01, 1.8142236532029034e-02 },
+      { H2D_ORBIT_S21, 4.0391559695124452e-01, 4.0391559695124452e-01, 3.3719006910869362e-02 },
+      { H2D_ORBIT_S21, 4.7089361922411060e-01, 4.7089361922411060e-01, 2.3687579755664358e-02 },
+      { H2D_ORBIT_S21, 4.9819116672780545e-01, 4.9819116672780545e-01, 4.7633258836921825e-03 },
+      { H2D_ORBIT_S111, 1.5382548675931837e-03, 3.7411257823656130e-01, 3.3850508700464469e-03 },
+      { H2D_ORBIT_S111, 1.6705583307128288e-03, 2.5051516450841732e-01, 3.1370420878827784e-03 },
+      { H2D_ORBIT_S111, 3.8377721987619298e-03, 7.5829460656409706e-02, 2.6779355198117737e-03 },
+      { H2D_ORBIT_S111, 5.8708830219210955e-03, 2.5908865350122393e-02, 1.9379257822596471e-03 },
+      { H2D_ORBIT_S111, 5.9989481823865586e-03, 1.4895545317810766e-01, 5.0055715552194567e-03 },
+      { H2D_ORBIT_S111, 1.8926663903100601e-02, 3.0961227083518195e-01, 1.2958905020274674e-02 },
+      { H2D_ORBIT_S111, 2.0689028090860803e-02, 4.2435929784824811e-01, 1.4064951493017742e-02 },
+      { H2D_ORBIT_S111, 2.0772584926149314e-02, 2.0726554885729867e-01, 1.0546599357493195e-02 },
+      { H2D_ORBIT_S111, 2.2193860431305213e-02, 4.6161574312513574e-02, 4.5399862754704140e-03 },
+      { H2D_ORBIT_S111, 2.6340009098265872e-02, 1.0139867173770377e-01, 8.6928827238315631e-03 },
+      { H2D_ORBIT_S111, 5.2903992651411991e-02, 1.4988723780571733e-01, 1.5062390085472019e-02 },
+      { H2D_ORBIT_S111, 5.9644014786452752e-02, 2.4449994227357999e-01, 2.0202863711232047e-02 },
+      { H2D_ORBIT_S111, 6.0246578159091957e-02, 3.4956589519262921e-01, 2.3063066543512496e-02 },
+      { H2D_ORBIT_S111, 1.1194350533629119e-01, 1.7600378231547950e-01, 2.3786085873559296e-02 },
+      { H2D_ORBIT_S111, 1.1709631358292623e-01, 3.8479080147286554e-01, 3.0493299014631700e-02 },
+      { H2D_ORBIT_S111, 1.2232528445902671e-01, 2.7205922763315171e-01, 2.9572054798439738e-02 },
+      { H2D_ORBIT_S111, 1.9239495689503339e-01, 3.0310432489319633e-01, 3.0494713779318620e-02 },
+      { H2D_ORBIT_S111, 2.7507292666932748e-01, 3.2284582156795372e-01, 2.4482217469601369e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_27_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 6.7788206818299654e-03, 6.7788206818299654e-03, 1.2203311208356495e-03 },
+      { H2D_ORBIT_S21, 2.5712160131217288e-02, 2.5712160131217288e-02, 3.5694680434581474e-03 },
+      { H2D_ORBIT_S21, 7.1162002882819819e-02, 7.1162002882819819e-02, 1.1428230718979221e-02 },
+      { H2D_ORBIT_S21, 1.0757627448113480e-01, 1.0757627448113480e-01, 1.5344619161797916e-02 },
+      { H2D_ORBIT_S21, 2.6024517286839211e-01, 2.6024517286839211e-01, 3.1712118837509268e-02 },
+      { H2D_ORBIT_S21, 3.9118694278368649e-01, 3.9118694278368649e-01, 3.2045370864100364e-02 },
+      { H2D_ORBIT_S21, 4.3749899839130657e-01, 4.3749899839130657e-01, 3.0021986355941912e-02 },
+      { H2D_ORBIT_S21, 4.9957629836007655e-01, 4.9957629836007655e-01, 2.9380665070097849e-03 },
+      { H2D_ORBIT_S111, 2.2157892771575800e-03, 2.4952122671306967e-01, 3.1483597276189502e-03 },
+      { H2D_ORBIT_S111, 3.7399149283867624e-03, 3.7346535793591862e-01, 4.4528043439514726e-03 },
+      { H2D_ORBIT_S111, 4.4467402910578482e-03, 3.7538672342859028e-02, 2.0486918078721490e-03 },
+      { H2D_ORBIT_S111, 5.8695769266901244e-03, 9.1498488393054037e-02, 3.7871325296924920e-03 },
+      { H2D_ORBIT_S111, 7.0080324762017056e-03, 1.6170811335573096e-01, 5.5416847947497528e-03 },
+      { H2D_ORBIT_S111, 1.5380107581673080e-02, 3.0387427522924054e-01, 8.7813606655076665e-03 },
+      { H2D_ORBIT_S111, 1.8623283312438909e-02, 4.3516740095921308e-01, 1.2520428822986214e-02 },
+      { H2D_ORBIT_S111, 2.6573365321616430e-02, 2.1620112891003329e-01, 1.2129325283659514e-02 },
+      { H2D_ORBIT_S111, 2.7451785565467433e-02, 6.4560733035646356e-02, 6.3318619757428939e-03 },
+      { H2D_ORBIT_S111, 3.4848524440079937e-02, 1.2485281442871440e-01, 1.1158063386005701e-02 },
+      { H2D_ORBIT_S111, 4.3682188994971283e-02, 3.3744360511652366e-01, 1.6832038644667476e-02 },
+      { H2D_ORBIT_S111, 5.7910405067585533e-02, 4.3094051618255336e-01, 1.6645342873500550e-02 },
+      { H2D_ORBIT_S111, 6.5981455814895437e-02, 2.4829133819922800e-01, 1.7936575739540325e-02 },
+      { H2D_ORBIT_S111, 6.9462003525032762e-02, 1.6311706904009579e-01, 1.5083613001469280e-02 },
+      { H2D_ORBIT_S111, 9.7464299193058601e-02, 3.5490105408664258e-01, 2.1892254675742642e-02 },
+      { H2D_ORBIT_S111, 1.1425938327391676e-01, 2.7376089556575373e-01, 1.9261172428734312e-02 },
+      { H2D_ORBIT_S111, 1.2739419494015305e-01, 1.8356532620548957e-01, 2.1873806774583601e-02 },
+      { H2D_ORBIT_S111, 1.7541989524905230e-01, 3.2851349065065338e-01, 3.0863337254411691e-02 },
+      { H2D_ORBIT_S111, 1.7896358973634530e-01, 2.3518988861176615e-01, 2.3649435053839266e-02 },
+      { H2D_ORBIT_S111, 2.9049536228693190e-01, 3.1994211399803518e-01, 1.5255947744241237e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_28_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 5.6562264223584107e-03, 5.6562264223584107e-03, 8.6463354072308411e-04 },
+      { H2D_ORBIT_S21, 1.9712700027594340e-02, 1.9712700027594340e-02, 2.2558047808646561e-03 },
+      { H2D_ORBIT_S21, 6.5068856615370985e-02, 6.5068856615370985e-02, 1.0562958512304906e-02 },
+      { H2D_ORBIT_S21, 1.1904383161495372e-01, 1.1904383161495372e-01, 1.3965158579956023e-02 },
+      { H2D_ORBIT_S21, 3.9692645591927472e-01, 3.9692645591927472e-01, 3.1500446083091639e-02 },
+      { H2D_ORBIT_S21, 4.3495272240512167e-01, 4.3495272240512167e-01, 2.1226535177766927e-02 },
+      { H2D_ORBIT_S21, 4.8459645025380421e-01, 4.8459645025380421e-01, 1.4709528118890224e-02 },
+      { H2D_ORBIT_S111, 3.5187473672879423e-03, 3.3942105987434149e-02, 1.5251670878678241e-03 },
+      { H2D_ORBIT_S111, 4.7519782976444313e-03, 8.4305927333419337e-02, 2.9737263913407184e-03 },
+      { H2D_ORBIT_S111, 5.7299923578492196e-03, 2.3838955710163912e-01, 5.4358000713753910e-03 },
+      { H2D_ORBIT_S111, 5.7893242015847292e-03, 1.5325679699738132e-01, 4.5710945539330109e-03 },
+      { H2D_ORBIT_S111, 5.8058694018287282e-03, 3.3680824204858728e-01, 6.1314672785403729e-03 },
+      { H2D_ORBIT_S111, 5.9190242162487569e-03, 4.4272337668656320e-01, 6.5552555277436468e-03 },
+      { H2D_ORBIT_S111, 2.3612514253065490e-02, 5.4100805982127312e-02, 5.3271901468304982e-03 },
+      { H2D_ORBIT_S111, 2.7839920081932829e-02, 1.1042305864413758e-01, 8.4540143881784973e-03 },
+      { H2D_ORBIT_S111, 2.9783951660273322e-02, 2.7773878327795004e-01, 1.2718001680615541e-02 },
+      { H2D_ORBIT_S111, 3.0289065239044705e-02, 1.8767503444554282e-01, 1.1437003462948993e-02 },
+      { H2D_ORBIT_S111, 3.0798173977098428e-02, 3.7821225484289339e-01, 1.4519828836133911e-02 },
+      { H2D_ORBIT_S111, 6.7650779161314650e-02, 1.2673260962432323e-01, 1.2765659572092492e-02 },
+      { H2D_ORBIT_S111, 7.0817622311892314e-02, 2.8039770107803558e-01, 1.5910830863689867e-02 },
+      { H2D_ORBIT_S111, 7.3558812286799724e-02, 4.2807896155237690e-01, 1.4098978979806415e-02 },
+      { H2D_ORBIT_S111, 7.3704987747294060e-02, 2.0040979805943571e-01, 1.6103031920665648e-02 },
+      { H2D_ORBIT_S111, 7.6074980375607129e-02, 3.5734262638859421e-01, 1.6209138017936570e-02 },
+      { H2D_ORBIT_S111, 1.2859933507719856e-01, 2.6817076988692157e-01, 2.1490731167873017e-02 },
+      { H2D_ORBIT_S111, 1.3108625628457821e-01, 1.8595594621275419e-01, 1.8998749559279236e-02 },
+      { H2D_ORBIT_S111, 1.3934484315427942e-01, 3.4853500472369825e-01, 2.4042785710001610e-02 },
+      { H2D_ORBIT_S111, 1.8882231751523337e-01, 2.2436064584620777e-01, 1.6698515487989628e-02 },
+      { H2D_ORBIT_S111, 2.1418117109601253e-01, 2.9461073666330373e-01, 3.0420456230243587e-02 },
+      { H2D_ORBIT_S111, 2.8425873703833654e-01, 3.1945912201629212e-01, 1.9403374001448176e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_29_2d_tri[] =
+    {
+      { H2D_ORBIT_S3, 1.0 / 3, 1.0 / 3, 3.0320129525745563e-02 },
+      { H2D_ORBIT_S21, 6.0575135212626871e-03, 6.0575135212626871e-03, 9.6143477121198072e-04 },
+      { H2D_ORBIT_S21, 2.8210961023644465e-02, 2.8210961023644465e-02, 4.1081799397873963e-03 },
+      { H2D_ORBIT_S21, 6.7167282559452757e-02, 6.7167282559452757e-02, 9.5888633121720603e-03 },
+      { H2D_ORBIT_S21, 3.7730954179514842e-01, 3.7730954179514842e-01, 2.2377744759883210e-02 },
+      { H2D_ORBIT_S21, 4.7262208688211144e-01, 4.7262208688211144e-01, 1.7339180794547195e-02 },
+      { H2D_ORBIT_S21, 4.8955431336668753e-01, 4.8955431336668753e-01, 9.7060124930963814e-03 },
+      { H2D_ORBIT_S111, 3.8365897876405726e-03, 1.9611322188179545e-01, 2.7298938200451335e-03 },
+      { H2D_ORBIT_S111, 4.2348056296779915e-03, 4.4536392407834641e-01, 4.4551669867923570e-03 },
+      { H2D_ORBIT_S111, 5.1575664130588689e-03, 7.5370179207478460e-02, 2.7262969769960275e-03 },
+      { H2D_ORBIT_S111, 5.2924746794423974e-03, 3.1589567996402508e-02, 1.9164733242171160e-03 },
+      { H2D_ORBIT_S111, 5.3692983673520800e-03, 2.6743265433890190e-01, 4.2257467235438826e-03 },
+      { H2D_ORBIT_S111, 5.5133571020421490e-03, 3.5023329687856697e-01, 4.9973496982795790e-03 },
+      { H2D_ORBIT_S111, 6.3238133444867804e-03, 1.3223720915187720e-01, 3.9716927059557979e-03 },
+      { H2D_ORBIT_S111, 2.3174372966959594e-02, 2.0078217764375880e-01, 8.8966084163498264e-03 },
+      { H2D_ORBIT_S111, 2.6508665581109314e-02, 3.8775403459604008e-01, 1.2213994890123493e-02 },
+      { H2D_ORBIT_S111, 2.7160398016106327e-02, 6.9197395211221077e-02, 6.1453878052012230e-03 },
+      { H2D_ORBIT_S111, 2.8707423983615137e-02, 2.8761678583268796e-01, 1.2005166564971205e-02 },
+      { H2D_ORBIT_S111, 3.1996878979227011e-02, 1.2668204246549405e-01, 9.3477781452366779e-03 },
+      { H2D_ORBIT_S111, 5.9751431289696649e-02, 1.9802925536927926e-01, 1.4559848811136124e-02 },
+      { H2D_ORBIT_S111, 6.5059009416305949e-02, 3.6958791839635097e-01, 1.6804731954473958e-02 },
+      { H2D_ORBIT_S111, 6.7605095017223338e-02, 2.8312609741220918e-01, 1.5384565766295839e-02 },
+      { H2D_ORBIT_S111, 7.5750864754887764e-02, 1.2418687792444086e-01, 1.3208261407068529e-02 },
+      { H2D_ORBIT_S111, 1.0795281356036117e-01, 4.0361335644154267e-01, 2.0002025384185825e-02 },
+      { H2D_ORBIT_S111, 1.0811891602234817e-01, 2.2416982110200151e-01, 1.5150738905761801e-02 },
+      { H2D_ORBIT_S111, 1.1874407413441609e-01, 1.5728532346872684e-01, 1.3936134767794732e-02 },
+      { H2D_ORBIT_S111, 1.2415257881085193e-01, 3.0455438380731203e-01, 2.3514230124778379e-02 },
+      { H2D_ORBIT_S111, 1.6407591692150644e-01, 2.1022485933135326e-01, 1.7755096207652924e-02 },
+      { H2D_ORBIT_S111, 1.7270545536499846e-01, 3.6676855184581286e-01, 2.6202473794508348e-02 },
+      { H2D_ORBIT_S111, 1.9883128758297558e-01, 2.6856208640881790e-01, 2.5471885274692692e-02 },
+      { H2D_ORBIT_S111, 2.5314072128749687e-01, 3.0587562349179098e-01, 2.0617721920965257e-02 }
+    };
+
+    static SymmetricOrbit sym_orbits_30_2d_tri[] =
+    {
+      { H2D_ORBIT_S21, 4.8543020030667634e-03, 4.8543020030667634e-03, 6.3694082743882558e-04 },
+      { H2D_ORBIT_S21, 1.9216582609177104e-02, 1.9216582609177104e-02, 1.7464072416861845e-03 },
+      { H2D_ORBIT_S21, 5.9057039185639308e-02, 5.9057039185639308e-02, 8.0221678835427253e-03 },
+      { H2D_ORBIT_S21, 1.9982301642811146e-01, 1.9982301642811146e-01, 2.4159752563261954e-02 },
+      { H2D_ORBIT_S21, 3.0533216345299202e-01, 3.0533216345299202e-01, 2.7058392065860998e-02 },
+      { H2D_ORBIT_S21, 4.1175322822792038e-01, 4.1175322822792038e-01, 9.4022061131804856e-03 },
+      { H2D_ORBIT_S21, 4.5247038830837050e-01, 4.5247038830837050e-01, 2.2200864011681219e-02 },
+      { H2D_ORBIT_S21, 4.8005112514949511e-01, 4.8005112514949511e-01, 8.1140744148850193e-03 },
+      { H2D_ORBIT_S21, 4.9891718107510730e-01, 4.9891718107510730e-01, 2.9220541553446121e-03 },
+      { H2D_ORBIT_S111, 2.1896575813027397e-03, 3.8752591087518046e-01, 2.8141979444328471e-03 },
+      { H2D_ORBIT_S111, 3.9780637013003767e-03, 2.7448673082416067e-02, 1.2934805209587007e-03 },
+      { H2D_ORBIT_S111, 4.1484485230237145e-03, 2.8298605576101649e-01, 3.8795922063266171e-03 },
+      { H2D_ORBIT_S111, 4.4131440785153417e-03, 6.8755822375640555e-02, 2.3030926939464499e-03 },
+      { H2D_ORBIT_S111, 5.2185529425233801e-03, 1.2720273544079563e-01, 3.5244966415912127e-03 },
+      { H2D_ORBIT_S111, 5.6460552397729329e-03, 1.9925912428460943e-01, 4.4954759394017080e-03 },
+      { H2D_ORBIT_S111, 1.5566093030126071e-02, 3.3775010234755681e-01, 7.0734779400996855e-03 },
+      { H2D_ORBIT_S111, 1.5885364508312162e-02, 4.3748720832230398e-01, 9.1932833512348277e-03 },
+      { H2D_ORBIT_S111, 2.2561907594574507e-02, 4.8540274192298047e-02, 4.0127601903296260e-03 },
+      { H2D_ORBIT_S111, 2.5617929845102867e-02, 9.5992114829517500e-02, 6.6685302047319378e-03 },
+      { H2D_ORBIT_S111, 2.6656336608618401e-02, 2.4579566346016493e-01, 1.0985486227395643e-02 },
+      { H2D_ORBIT_S111, 2.8848879251392848e-02, 1.6163109607643061e-01, 9.5664424723966527e-03 },
+      { H2D_ORBIT_S111, 4.0039187242282746e-02, 3.4396336241003977e-01, 1.1127564213777759e-02 },
+      { H2D_ORBIT_S111, 5.1975404585153318e-02, 4.1427436528892020e-01, 1.2418946118100144e-02 },
+      { H2D_ORBIT_S111, 6.2831991351252059e-02, 2.7419846985011398e-01, 1.4033374330222731e-02 },
+      { H2D_ORBIT_S111, 6.5234168719122063e-02, 1.1309974870038904e-01, 1.1788460815645430e-02 },
+      { H2D_ORBIT_S111, 6.7264964161021068e-02, 1.9072178517866661e-01, 1.5329934048441593e-02 },
+      { H2D_ORBIT_S111, 9.2476279739331924e-02, 3.4941667488232442e-01, 2.0501038356232949e-02 },
+      { H2D_ORBIT_S111, 1.0709901874055180e-01, 1.3589705573888070e-01, 9.8200868027381247e-03 },
+      { H2D_ORBIT_S111, 1.0856537729909832e-01, 2.5639853233970011e-01, 1.5156233801539401e-02 },
+      { H2D_ORBIT_S111, 1.2998607989130209e-01, 1.8891209383258215e-01, 1.7887933974794750e-02 },
+      { H2D_ORBIT_S111, 1.5018229688075080e-01, 3.6976655716402496e-01, 2.3107861555171277e-02 },
+      { H2D_ORBIT_S111, 1.5619238417951492e-01, 2.8089056923130068e-01, 2.1151066604741996e-02 },
+      { H2D_ORBIT_S111, 2.2249860736265453e-01, 2.8030558573257996e-01, 2.2099861271313068e-02 },
+      { H2D_ORBIT_S111, 2.2857472406959162e-01, 3.4866934456301207e-01, 2.0969225469327380e-02 }
+    };
+    static SymmetricOrbit* sym_orbits_2d_tri[g_max_tri_symmetric + 1] =
+    {
+      sym_orbits_1_2d_tri,
+      sym_orbits_1_2d_tri,
+      sym_orbits_2_2d_tri,
+      sym_orbits_3_2d_tri,
+      sym_orbits_4_2d_tri,
+      sym_orbits_5_2d_tri,
+      sym_orbits_6_2d_tri,
+      sym_orbits_7_2d_tri,
+      sym_orbits_8_2d_tri,
+      sym_orbits_9_2d_tri,
+      sym_orbits_10_2d_tri,
+      sym_orbits_11_2d_tri,
+      sym_orbits_12_2d_tri,
+      sym_orbits_13_2d_tri,
+      sym_orbits_14_2d_tri,
+      sym_orbits_15_2d_tri,
+      sym_orbits_16_2d_tri,
+      sym_orbits_17_2d_tri,
+      sym_orbits_18_2d_tri,
+      sym_orbits_19_2d_tri,
+      sym_orbits_20_2d_tri,
+      sym_orbits_21_2d_tri,
+      sym_orbits_22_2d_tri,
+      sym_orbits_23_2d_tri,
+      sym_orbits_24_2d_tri,
+      sym_orbits_25_2d_tri,
+      sym_orbits_26_2d_tri,
+      sym_orbits_27_2d_tri,
+      sym_orbits_28_2d_tri,
+      sym_orbits_29_2d_tri,
+      sym_orbits_30_2d_tri
+    };
+
+    static unsigned char sym_num_orbits_2d_tri[g_max_tri_symmetric + 1] =
+    {
+      sizeof(sym_orbits_1_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_1_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_2_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_3_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_4_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_5_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_6_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_7_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_8_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_9_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_10_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_11_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_12_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_13_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_14_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_15_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_16_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_17_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_18_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_19_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_20_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_21_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_22_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_23_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_24_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_25_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_26_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_27_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_28_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_29_2d_tri) / sizeof(SymmetricOrbit),
+      sizeof(sym_orbits_30_2d_tri) / sizeof(SymmetricOrbit)
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+
+    static double3* make_symmetric_tri_table(int order, unsigned char& np)
+    {
+      static const unsigned char orbit_sizes[3] = { 1, 3, 6 };
+
+      SymmetricOrbit* orbits = sym_orbits_2d_tri[order];
+      np = 0;
+      for (unsigned char i = 0; i < sym_num_orbits_2d_tri[order]; i++)
+        np += orbit_sizes[orbits[i].type];
+
+      double3* result = malloc_with_check<double3>(np);
+      unsigned char n = 0;
+      for (unsigned char i = 0; i < sym_num_orbits_2d_tri[order]; i++)
+      {
+        double a = orbits[i].a, b = orbits[i].b, c = 1.0 - a - b;
+        // Permutations of the barycentric coordinates (l0, l1, l2) as (l1, l2), the point on the reference
+        // triangle is (-1 + 2 * l1, -1 + 2 * l2). For S21 (a == b), the first three are the distinct ones,
+        // for S3 the first one.
+        double2 perms[6] = { { a, b }, { b, c }, { c, a }, { b, a }, { c, b }, { a, c } };
+        for (unsigned char j = 0; j < orbit_sizes[orbits[i].type]; j++, n++)
+        {
+          result[n][0] = -1.0 + 2.0 * perms[j][0];
+          result[n][1] = -1.0 + 2.0 * perms[j][1];
+          result[n][2] = orbits[i].w;
+        }
+      }
+
+      return result;
+    }
+
+    static double3* make_symmetric_quad_table(Quad1D& quad_1d, int order, unsigned char& np)
+    {
+      // points on a quad are calculated as a simple cartesian
+      // product of 1D quadrature points...
+
+      unsigned char np_1d = quad_1d.get_num_points(order);
+      np = np_1d * np_1d;
+      double3* result = malloc_with_check<double3>(np);
+      double2* table = quad_1d.get_points(order);
+
+      for (int i = 0, n = 0; i < np_1d; i++)
+      {
+        for (int j = 0; j < np_1d; j++, n++)
+        {
+          result[n][0] = table[i][0];
+          result[n][1] = table[j][0];
+          result[n][2] = table[i][1] * table[j][1];
+        }
+      }
+
+      return result;
+    }
+
+    static double3* make_symmetric_edge_table(Quad1D& quad_1d, double2& v1, double2& v2, unsigned char& np, unsigned short order)
+    {
+      np = quad_1d.get_num_points(order);
+      double3* result = malloc_with_check<double3>(np);
+      double2* table = quad_1d.get_points(order);
+
+      for (unsigned char i = 0; i < np; i++)
+      {
+        double s = (table[i][0] + 1.0) * 0.5;
+        double t = 1.0 - s;
+        result[i][0] = v1[0] * t + v2[0] * s;
+        result[i][1] = v1[1] * t + v2[1] * s;
+        result[i][2] = table[i][1];
+      }
+
+      return result;
+    }
+
+    Quad2DSymmetric::Quad2DSymmetric()
+    {
+      ref_vert[0][0][0] = -1.0;
+      ref_vert[0][0][1] = -1.0;
+      ref_vert[0][1][0] = 1.0;
+      ref_vert[0][1][1] = -1.0;
+      ref_vert[0][2][0] = -1.0;
+      ref_vert[0][2][1] = 1.0;
+
+      ref_vert[1][0][0] = -1.0;
+      ref_vert[1][0][1] = -1.0;
+      ref_vert[1][1][0] = 1.0;
+      ref_vert[1][1][1] = -1.0;
+      ref_vert[1][2][0] = 1.0;
+      ref_vert[1][2][1] = 1.0;
+      ref_vert[1][3][0] = -1.0;
+      ref_vert[1][3][1] = 1.0;
+
+      // All points are inside the element, all weights are positive.
+      max_order[0] = g_max_tri_symmetric;  safe_max_order[0] = g_max_tri_symmetric;
+      max_order[1] = g_max_quad;  safe_max_order[1] = g_max_quad;
+
+      num_tables[0] = max_order[0] + 1 + 3 * max_order[0] + 3;
+      num_tables[1] = max_order[1] + 1 + 4 * max_order[1] + 4;
+
+      tables = malloc_with_check<double3**>(H2D_NUM_MODES);
+      np = malloc_with_check<unsigned char*>(H2D_NUM_MODES);
+      for (int mode = 0; mode < H2D_NUM_MODES; mode++)
+      {
+        tables[mode] = malloc_with_check<double3*>(num_tables[mode]);
+        np[mode] = malloc_with_check<unsigned char>(num_tables[mode]);
+      }
+
+      // The 1D Gauss tables are only pointers to static data, a local instance avoids depending
+      // on the initialization order of g_quad_1d_std.
+      Quad1DStd quad_1d;
+
+      // create triangle and quad tables and edge tables
+      unsigned short i, j, k, l;
+
+      for (i = 0; i <= max_order[0]; i++)
+      {
+        tables[0][i] = make_symmetric_tri_table(i, np[0][i]);
+        for (j = 0; j < 3; j++)
+        {
+          k = max_order[0] + 1 + 3 * i + j;
+          l = j < 2 ? j + 1 : 0;
+          tables[0][k] = make_symmetric_edge_table(quad_1d, ref_vert[0][j], ref_vert[0][l], np[0][k], i);
+        }
+      }
+
+      for (i = 0; i <= max_order[1]; i++)
+      {
+        tables[1][i] = make_symmetric_quad_table(quad_1d, i, np[1][i]);
+        for (j = 0; j < 4; j++)
+        {
+          k = max_order[1] + 1 + 4 * i + j;
+          l = j < 3 ? j + 1 : 0;
+          tables[1][k] = make_symmetric_edge_table(quad_1d, ref_vert[1][j], ref_vert[1][l], np[1][k], i);
+        }
+      }
+    }
+
+    Quad2DSymmetric::~Quad2DSymmetric()
+    {
+      for (int mode = 0; mode < H2D_NUM_MODES; mode++)
+      {
+        for (unsigned short i = 0; i < num_tables[mode]; i++)
+          free_with_check(tables[mode][i]);
+        free_with_check(tables[mode]);
+        free_with_check(np[mode]);
+      }
+      free_with_check(tables);
+      free_with_check(np);
+    }
+
+    HERMES_API Quad2DSymmetric g_quad_2d_symmetric;
+  }
+}
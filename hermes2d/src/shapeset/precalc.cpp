@@ -155,11 +155,12 @@ namespace Hermes
 #ifdef HERMES_FOR_AGROS
     static PrecalcShapesetAssemblingStorage* PrecalcShapesetAssemblingTables[H2D_NUM_SHAPESETS] = { nullptr, nullptr };
 #else
-    static PrecalcShapesetAssemblingStorage* PrecalcShapesetAssemblingTables[H2D_NUM_SHAPESETS] = { nullptr, nullptr, nullptr, nullptr, nullptr };
+    static PrecalcShapesetAssemblingStorage* PrecalcShapesetAssemblingTables[H2D_NUM_SHAPESETS] = { nullptr, nullptr, nullptr, nullptr, nullptr, nullptr };
 #endif
 
 #ifndef HERMES_FOR_AGROS
-    static PrecalcShapesetAssemblingInternal temp[H2D_NUM_SHAPESETS] = { PrecalcShapesetAssemblingInternal(new HcurlShapesetGradLeg), PrecalcShapesetAssemblingInternal(new HdivShapesetLegendre), PrecalcShapesetAssemblingInternal(new L2ShapesetLegendre), PrecalcShapesetAssemblingInternal(new L2ShapesetTaylor), PrecalcShapesetAssemblingInternal(new H1ShapesetJacobi) };
+    // L2ShapesetGLLNodal is not listed - it is meant for Quad2DLobatto, whose values are never reused, so its storage is only created on first use.
+    static PrecalcShapesetAssemblingInternal temp[] = { PrecalcShapesetAssemblingInternal(new HcurlShapesetGradLeg), PrecalcShapesetAssemblingInternal(new HdivShapesetLegendre), PrecalcShapesetAssemblingInternal(new L2ShapesetLegendre), PrecalcShapesetAssemblingInternal(new L2ShapesetTaylor), PrecalcShapesetAssemblingInternal(new H1ShapesetJacobi) };
 #endif
 
     PrecalcShapesetAssemblingInternal::PrecalcShapesetAssemblingInternal(Shapeset* shapeset) : PrecalcShapesetAssembling(shapeset)
@@ -172,27 +173,25 @@ namespace Hermes
       delete this->shapeset;
     }
 
-    PrecalcShapesetAssembling::PrecalcShapesetAssembling(Shapeset* shapeset) : PrecalcShapeset(shapeset), storage(nullptr)
+    PrecalcShapesetAssembling::PrecalcShapesetAssembling(Shapeset* shapeset) : PrecalcShapeset(shapeset), storage(nullptr), table_hits(0), table_misses(0)
     {
-      if (PrecalcShapesetAssemblingTables[(int)shapeset->get_id()])
-      {
-        this->storage = PrecalcShapesetAssemblingTables[(int)shapeset->get_id()];
-        this->storage->ref_count++;
-      }
-      if (!this->storage)
-      {
 #pragma omp critical (pss_table_creation)
+      {
+        if (PrecalcShapesetAssemblingTables[(int)shapeset->get_id()])
+          this->storage = PrecalcShapesetAssemblingTables[(int)shapeset->get_id()];
+        else
         {
           this->storage = new PrecalcShapesetAssemblingStorage(this->shapeset);
-          this->storage->ref_count++;
           PrecalcShapesetAssemblingTables[(int)shapeset->get_id()] = storage;
         }
+        this->storage->ref_count++;
       }
     }
 
-    PrecalcShapesetAssembling::PrecalcShapesetAssembling(const PrecalcShapesetAssembling& other) : PrecalcShapeset(other.shapeset)
+    PrecalcShapesetAssembling::PrecalcShapesetAssembling(const PrecalcShapesetAssembling& other) : PrecalcShapeset(other.shapeset), table_hits(0), table_misses(0)
     {
       this->storage = other.storage;
+#pragma omp critical (pss_table_creation)
       this->storage->ref_count++;
     }
 
@@ -266,12 +265,31 @@ namespace Hermes
         return Function<double>::get_values(component, item);
     }
 
+    unsigned long long PrecalcShapesetAssembling::get_table_hits() const
+    {
+      return this->table_hits;
+    }
+
+    unsigned long long PrecalcShapesetAssembling::get_table_misses() const
+    {
+      return this->table_misses;
+    }
+
+    void PrecalcShapesetAssembling::reset_table_statistics()
+    {
+      this->table_hits = this->table_misses = 0;
+    }
+
     void PrecalcShapesetAssembling::precalculate(unsigned short order_, unsigned short mask)
     {
       if (this->attempt_to_reuse(order_))
+      {
+        this->table_hits++;
         return;
+      }
       else
       {
+        this->table_misses++;
         Function<double>::precalculate(order_, mask);
 
         unsigned char np = this->quads[cur_quad]->get_num_points(order_, this->element->get_mode());
@@ -283,44 +301,45 @@ namespace Hermes
 
         if (this->num_components == 1)
         {
-          if (this->reuse_possible())
+          if (this->reuse_possible() && this->storage->prepare_order(mode, order_, np))
           {
-#pragma omp critical (precalculatingPSS)
-                    {
-                      double* valuePointer;
-                      if (mode == HERMES_MODE_TRIANGLE)
-                      {
-                        valuePointer = this->storage->PrecalculatedValues[HERMES_MODE_TRIANGLE][0][order_][index];
-                        for (short i = 0; i < np; i++)
-                          valuePointer[i] = shapeset->get_fn_value_0_tri(index, pt[i][0], pt[i][1]);
-
-                        valuePointer = this->storage->PrecalculatedValues[HERMES_MODE_TRIANGLE][1][order_][index];
-                        for (short i = 0; i < np; i++)
-                          valuePointer[i] = shapeset->get_dx_value_0_tri(index, pt[i][0], pt[i][1]);
-
-                        valuePointer = this->storage->PrecalculatedValues[HERMES_MODE_TRIANGLE][2][order_][index];
-                        for (short i = 0; i < np; i++)
-                          valuePointer[i] = shapeset->get_dy_value_0_tri(index, pt[i][0], pt[i][1]);
-
-                        this->storage->PrecalculatedInfo[HERMES_MODE_TRIANGLE][order_][index] = true;
-                      }
-                      else
-                      {
-                        valuePointer = this->storage->PrecalculatedValues[HERMES_MODE_QUAD][0][order_][index];
-                        for (short i = 0; i < np; i++)
-                          valuePointer[i] = shapeset->get_fn_value_0_quad(index, pt[i][0], pt[i][1]);
-
-                        valuePointer = this->storage->PrecalculatedValues[HERMES_MODE_QUAD][1][order_][index];
-                        for (short i = 0; i < np; i++)
-                          valuePointer[i] = shapeset->get_dx_value_0_quad(index, pt[i][0], pt[i][1]);
-
-                        valuePointer = this->storage->PrecalculatedValues[HERMES_MODE_QUAD][2][order_][index];
-                        for (short i = 0; i < np; i++)
-                          valuePointer[i] = shapeset->get_dy_value_0_quad(index, pt[i][0], pt[i][1]);
-
-                        this->storage->PrecalculatedInfo[HERMES_MODE_QUAD][order_][index] = true;
-                      }
-                    }
+            // No lock here: the values are deterministic, so concurrent writers of the same entry (from this or another
+            // problem instance sharing the storage) write identical numbers. The flag is only raised after the values are flushed.
+            double* valuePointer;
+            if (mode == HERMES_MODE_TRIANGLE)
+            {
+              valuePointer = this->storage->PrecalculatedValues[HERMES_MODE_TRIANGLE][0][order_][index];
+              for (short i = 0; i < np; i++)
+                valuePointer[i] = shapeset->get_fn_value_0_tri(index, pt[i][0], pt[i][1]);
+
+              valuePointer = this->storage->PrecalculatedValues[HERMES_MODE_TRIANGLE][1][order_][index];
+              for (short i = 0; i < np; i++)
+                valuePointer[i] = shapeset->get_dx_value_0_tri(index, pt[i][0], pt[i][1]);
+
+              valuePointer = this->storage->PrecalculatedValues[HERMES_MODE_TRIANGLE][2][order_][index];
+              for (short i = 0; i < np; i++)
+                valuePointer[i] = shapeset->get_dy_value_0_tri(index, pt[i][0], pt[i][1]);
+
+#pragma omp flush
+              this->storage->PrecalculatedInfo[HERMES_MODE_TRIANGLE][order_][index] = true;
+            }
+            else
+            {
+              valuePointer = this->storage->PrecalculatedValues[HERMES_MODE_QUAD][0][order_][index];
+              for (short i = 0; i < np; i++)
+                valuePointer[i] = shapeset->get_fn_value_0_quad(index, pt[i][0], pt[i][1]);
+
+              valuePointer = this->storage->PrecalculatedValues[HERMES_MODE_QUAD][1][order_][index];
+              for (short i = 0; i < np; i++)
+                valuePointer[i] = shapeset->get_dx_value_0_quad(index, pt[i][0], pt[i][1]);
+
+              valuePointer = this->storage->PrecalculatedValues[HERMES_MODE_QUAD][2][order_][index];
+              for (short i = 0; i < np; i++)
+                valuePointer[i] = shapeset->get_dy_value_0_quad(index, pt[i][0], pt[i][1]);
+
+#pragma omp flush
+              this->storage->PrecalculatedInfo[HERMES_MODE_QUAD][order_][index] = true;
+            }
           }
           else
           {
@@ -393,73 +412,115 @@ namespace Hermes
       }
     }
 
-    PrecalcShapesetAssemblingStorage::PrecalcShapesetAssemblingStorage(Shapeset* shapeset) : shapeset_id(shapeset->get_id()), ref_count(0)
+    PrecalcShapesetAssemblingStorage::PrecalcShapesetAssemblingStorage(Shapeset* shapeset) : shapeset_id(shapeset->get_id()), ref_count(0), evictor_registered(false)
     {
       this->max_index[0] = shapeset->get_max_index(HERMES_MODE_TRIANGLE);
       this->max_index[1] = shapeset->get_max_index(HERMES_MODE_QUAD);
 
+      this->g_max[HERMES_MODE_TRIANGLE] = g_max_tri + 1 + 3 * g_max_tri + 3;
+      this->g_max[HERMES_MODE_QUAD] = g_max_quad + 1 + 4 * g_max_quad + 4;
+
       for (int i = 0; i < H2D_NUM_MODES; i++)
       {
-        unsigned short g_max, np;
-        if (i == HERMES_MODE_TRIANGLE)
-        {
-          g_max = g_max_tri + 1 + 3 * g_max_tri + 3;
-          np = H2D_MAX_INTEGRATION_POINTS_COUNT_TRI;
-        }
-        else
-        {
-          g_max = g_max_quad + 1 + 4 * g_max_quad + 4;
-          np = H2D_MAX_INTEGRATION_POINTS_COUNT_QUAD;
-        }
-
         unsigned short local_base_size = this->max_index[i] + 1;
 
-        this->PrecalculatedInfo[i] = malloc_with_check<bool*>(g_max);
+        // The tables themselves are allocated in prepare_order().
+        this->PrecalculatedInfo[i] = malloc_with_check<bool*>(g_max[i]);
+        for (int k = 0; k < g_max[i]; k++)
+          this->PrecalculatedInfo[i][k] = calloc_with_check<bool>(local_base_size);
+        for (int j = 0; j < H2D_NUM_FUNCTION_VALUES; j++)
+          this->PrecalculatedValues[i][j] = calloc_with_check<double**>(g_max[i]);
+        this->prepared_tables[i] = new std::atomic<double**>[g_max[i]];
+        for (int k = 0; k < g_max[i]; k++)
+          this->prepared_tables[i][k].store(nullptr, std::memory_order_relaxed);
+        this->allocated_np[i] = calloc_with_check<unsigned char>(g_max[i]);
+      }
+    }
+
+    PrecalcShapesetAssemblingStorage::~PrecalcShapesetAssemblingStorage()
+    {
+      if (this->evictor_registered)
+        HermesCommonApi.unregister_memory_evictor(memoryPrecalcTables, this);
+      this->evict();
 
+      for (int i = 0; i < H2D_NUM_MODES; i++)
+      {
+        for (int k = 0; k < g_max[i]; k++)
+          free_with_check(this->PrecalculatedInfo[i][k]);
+        free_with_check(this->PrecalculatedInfo[i]);
         for (int j = 0; j < H2D_NUM_FUNCTION_VALUES; j++)
-        {
-          this->PrecalculatedValues[i][j] = malloc_with_check<double**>(g_max);
+          free_with_check(this->PrecalculatedValues[i][j]);
+        delete[] this->prepared_tables[i];
+        free_with_check(this->allocated_np[i]);
+      }
+    }
 
-          for (int k = 0; k < g_max; k++)
+    bool PrecalcShapesetAssemblingStorage::prepare_order(ElementMode2D mode, unsigned short order, unsigned char np)
+    {
+      if (this->prepared_tables[mode][order].load(std::memory_order_acquire))
+        return true;
+
+      bool prepared = true;
+#pragma omp critical (pss_table_creation)
+      {
+        if (!this->prepared_tables[mode][order].load(std::memory_order_relaxed))
+        {
+          if (HermesCommonApi.memory_limit_exceeded(memoryPrecalcTables))
+            prepared = false;
+          else
           {
-            this->PrecalculatedValues[i][j][k] = malloc_with_check<double*>(local_base_size);
-            if (j == 0)
-              this->PrecalculatedInfo[i][k] = calloc_with_check<bool>(local_base_size);
+            unsigned short local_base_size = this->max_index[mode] + 1;
 
-            for (int l = 0; l < local_base_size; l++)
-              this->PrecalculatedValues[i][j][k][l] = malloc_with_check<double>(np);
+            // One block for the values, dx, dy of all shape functions.
+            double* block = malloc_with_check<double>(3 * local_base_size * np);
+            for (int j = 0; j < 3; j++)
+            {
+              double** tables = malloc_with_check<double*>(local_base_size);
+              for (int l = 0; l < local_base_size; l++)
+                tables[l] = block + (j * local_base_size + l) * np;
+              this->PrecalculatedValues[mode][j][order] = tables;
+            }
+            this->allocated_np[mode][order] = np;
+            this->prepared_tables[mode][order].store(this->PrecalculatedValues[mode][2][order], std::memory_order_release);
+
+            HermesCommonApi.account_memory(memoryPrecalcTables, 3 * local_base_size * (np * sizeof(double) + sizeof(double*)));
+            if (!this->evictor_registered)
+            {
+              HermesCommonApi.register_memory_evictor(memoryPrecalcTables, &PrecalcShapesetAssemblingStorage::evict_storage, this);
+              this->evictor_registered = true;
+            }
           }
         }
       }
+
+      return prepared;
     }
 
-    PrecalcShapesetAssemblingStorage::~PrecalcShapesetAssemblingStorage()
+    void PrecalcShapesetAssemblingStorage::evict()
     {
       for (int i = 0; i < H2D_NUM_MODES; i++)
       {
-        unsigned short g_max;
-        if (i == HERMES_MODE_TRIANGLE)
-          g_max = g_max_tri + 1 + 3 * g_max_tri + 3;
-        else
-          g_max = g_max_quad + 1 + 4 * g_max_quad + 4;
-
         unsigned short local_base_size = this->max_index[i] + 1;
-
-        for (int j = 0; j < H2D_NUM_FUNCTION_VALUES; j++)
+        for (int k = 0; k < g_max[i]; k++)
         {
-          for (int k = 0; k < g_max; k++)
-          {
-            for (int l = 0; l < local_base_size; l++)
-              free_with_check(this->PrecalculatedValues[i][j][k][l]);
+          if (!this->prepared_tables[i][k].load(std::memory_order_relaxed))
+            continue;
+          this->prepared_tables[i][k].store(nullptr, std::memory_order_relaxed);
+
+          memset(this->PrecalculatedInfo[i][k], 0, local_base_size * sizeof(bool));
+          free_with_check(this->PrecalculatedValues[i][0][k][0]);
+          for (int j = 0; j < 3; j++)
             free_with_check(this->PrecalculatedValues[i][j][k]);
-            if (j == 0)
-              free_with_check(this->PrecalculatedInfo[i][k]);
-          }
 
-          free_with_check(this->PrecalculatedValues[i][j]);
-          free_with_check(this->PrecalculatedInfo[i][j]);
+          HermesCommonApi.account_memory(memoryPrecalcTables, -(long long)(3 * local_base_size * (this->allocated_np[i][k] * sizeof(double) + sizeof(double*))));
+          this->allocated_np[i][k] = 0;
         }
       }
     }
+
+    void PrecalcShapesetAssemblingStorage::evict_storage(void* storage)
+    {
+      ((PrecalcShapesetAssemblingStorage*)storage)->evict();
+    }
   }
 }
@@ -103,58 +103,44 @@ namespace Hermes
     {
       unsigned short index = 2 * ((max_order + 1 - ebias)*part + (order - ebias)) + ori;
 
-      // allocate/reallocate the array if necessary
-      if (!this->comb_table)
-      {
-#pragma omp critical
-        {
-          if (!this->comb_table)
-          {
-            table_size = 1024;
-            while (table_size <= index)
-              table_size *= 2;
-            comb_table = calloc_with_check<double*>(table_size, true);
-          }
-        }
-      }
-      else if (index >= table_size)
-      {
-#pragma omp critical
-        {
-          // adjust table_size to accommodate the required depth
-          unsigned short old_size = table_size;
-          while (index >= table_size)
-            table_size *= 2;
-
-          // reallocate the table
-          comb_table = realloc_with_check<double*>(comb_table, table_size);
-          memset(comb_table + old_size, 0, (table_size - old_size) * sizeof(double*));
-        }
-      }
+      unsigned short chunk = index / H2D_COMB_TABLE_CHUNK_SIZE, chunk_index = index % H2D_COMB_TABLE_CHUNK_SIZE;
 
-      // do we have the required linear combination yet?
-      if (!comb_table[index])
+      // Entries are only ever added (never moved), so the lookup itself does not need to lock.
+      // Only the (rare) calculation of a missing combination does.
+      if (!this->comb_table || !this->comb_table[chunk] || !this->comb_table[chunk][chunk_index])
       {
-#pragma omp critical
+#pragma omp critical (constrained_edge_combination)
         {
-          if (!comb_table[index])
+          if (!this->comb_table)
+            this->comb_table = calloc_with_check<double**>(H2D_COMB_TABLE_CHUNKS, true);
+          if (!this->comb_table[chunk])
+            this->comb_table[chunk] = calloc_with_check<double*>(H2D_COMB_TABLE_CHUNK_SIZE, true);
+          if (!this->comb_table[chunk][chunk_index])
           {
-            // no, calculate it
-            comb_table[index] = calculate_constrained_edge_combination(order, part, ori, mode);
+            double* combination = calculate_constrained_edge_combination(order, part, ori, mode);
+            // Publish the pointer only after the values are visible to other threads.
+#pragma omp flush
+            this->comb_table[chunk][chunk_index] = combination;
           }
         }
       }
 
       nitems = order + 1 - ebias;
-      return comb_table[index];
+      return this->comb_table[chunk][chunk_index];
     }
 
     void Shapeset::free_constrained_edge_combinations()
     {
       if (comb_table)
       {
-        for (int i = 0; i < table_size; i++)
-          free_with_check(comb_table[i]);
+        for (int i = 0; i < H2D_COMB_TABLE_CHUNKS; i++)
+        {
+          if (!comb_table[i])
+            continue;
+          for (int j = 0; j < H2D_COMB_TABLE_CHUNK_SIZE; j++)
+            free_with_check(comb_table[i][j]);
+          free_with_check(comb_table[i], true);
+        }
 
         free_with_check(comb_table, true);
       }
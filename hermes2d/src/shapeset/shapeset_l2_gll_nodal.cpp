@@ -0,0 +1,399 @@
+// This file is part of Hermes2D.
+//
+// Hermes2D is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 2 of the License, or
+// (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "global.h"
+#include "shapeset.h"
+#include "shapeset_common.h"
+#include "shapeset_l2_all.h"
+#include "quad_all.h"
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    /// Value (derivative = 0) or the first or second derivative of the i-th Lagrange polynomial of the degree p
+    /// on the p + 1 Gauss-Lobatto points (the points of the rule of the order 2p - 1 of g_quad_1d_lobatto).
+    static double gll_lagrange(unsigned short p, unsigned short i, double x, unsigned short derivative)
+    {
+      if (p == 0)
+        return derivative ? 0.0 : 1.0;
+
+      double2* pts = g_quad_1d_lobatto.get_points(2 * p - 1);
+      double xi = pts[i][0];
+
+      if (derivative == 0)
+      {
+        double result = 1.0;
+        for (unsigned short k = 0; k <= p; k++)
+          if (k != i)
+            result *= (x - pts[k][0]) / (xi - pts[k][0]);
+        return result;
+      }
+
+      // Sum over the factors (pairs of factors for the second derivative) that are differentiated.
+      double result = 0.0;
+      for (unsigned short m = 0; m <= p; m++)
+      {
+        if (m == i)
+          continue;
+        if (derivative == 1)
+        {
+          double term = 1.0 / (xi - pts[m][0]);
+          for (unsigned short k = 0; k <= p; k++)
+            if (k != i && k != m)
+              term *= (x - pts[k][0]) / (xi - pts[k][0]);
+          result += term;
+        }
+        else
+        {
+          for (unsigned short n = 0; n <= p; n++)
+          {
+            if (n == i || n == m)
+              continue;
+            double term = 1.0 / ((xi - pts[m][0]) * (xi - pts[n][0]));
+            for (unsigned short k = 0; k <= p; k++)
+              if (k != i && k != m && k != n)
+                term *= (x - pts[k][0]) / (xi - pts[k][0]);
+            result += term;
+          }
+        }
+      }
+      return result;
+    }
+
+    /// The shape function with the nodes (I, J) of the order P, DX-th derivative in x, DY-th derivative in y.
+    template<unsigned short P, unsigned short I, unsigned short J, unsigned short DX, unsigned short DY>
+    static double gll_nodal_function(double x, double y)
+    {
+      return gll_lagrange(P, I, x, DX) * gll_lagrange(P, J, y, DY);
+    }
+
+    // Functions of the order p have the indices p(p+1)(2p+1)/6 + i(p+1) + j, i (j) being the node in x (y).
+#define GLL_NODAL_FUNCTIONS_0(DX, DY) \
+  gll_nodal_function<0, 0, 0, DX, DY>
+
+#define GLL_NODAL_FUNCTIONS_1(DX, DY) \
+  gll_nodal_function<1, 0, 0, DX, DY>, gll_nodal_function<1, 0, 1, DX, DY>, \
+  gll_nodal_function<1, 1, 0, DX, DY>, gll_nodal_function<1, 1, 1, DX, DY>
+
+#define GLL_NODAL_FUNCTIONS_2(DX, DY) \
+  gll_nodal_function<2, 0, 0, DX, DY>, gll_nodal_function<2, 0, 1, DX, DY>, gll_nodal_function<2, 0, 2, DX, DY>, \
+  gll_nodal_function<2, 1, 0, DX, DY>, gll_nodal_function<2, 1, 1, DX, DY>, gll_nodal_function<2, 1, 2, DX, DY>, \
+  gll_nodal_function<2, 2, 0, DX, DY>, gll_nodal_function<2, 2, 1, DX, DY>, gll_nodal_function<2, 2, 2, DX, DY>
+
+#define GLL_NODAL_FUNCTIONS_3(DX, DY) \
+  gll_nodal_function<3, 0, 0, DX, DY>, gll_nodal_function<3, 0, 1, DX, DY>, gll_nodal_function<3, 0, 2, DX, DY>, gll_nodal_function<3, 0, 3, DX, DY>, \
+  gll_nodal_function<3, 1, 0, DX, DY>, gll_nodal_function<3, 1, 1, DX, DY>, gll_nodal_function<3, 1, 2, DX, DY>, gll_nodal_function<3, 1, 3, DX, DY>, \
+  gll_nodal_function<3, 2, 0, DX, DY>, gll_nodal_function<3, 2, 1, DX, DY>, gll_nodal_function<3, 2, 2, DX, DY>, gll_nodal_function<3, 2, 3, DX, DY>, \
+  gll_nodal_function<3, 3, 0, DX, DY>, gll_nodal_function<3, 3, 1, DX, DY>, gll_nodal_function<3, 3, 2, DX, DY>, gll_nodal_function<3, 3, 3, DX, DY>
+
+#define GLL_NODAL_FUNCTIONS_4(DX, DY) \
+  gll_nodal_function<4, 0, 0, DX, DY>, gll_nodal_function<4, 0, 1, DX, DY>, gll_nodal_function<4, 0, 2, DX, DY>, gll_nodal_function<4, 0, 3, DX, DY>, gll_nodal_function<4, 0, 4, DX, DY>, \
+  gll_nodal_function<4, 1, 0, DX, DY>, gll_nodal_function<4, 1, 1, DX, DY>, gll_nodal_function<4, 1, 2, DX, DY>, gll_nodal_function<4, 1, 3, DX, DY>, gll_nodal_function<4, 1, 4, DX, DY>, \
+  gll_nodal_function<4, 2, 0, DX, DY>, gll_nodal_function<4, 2, 1, DX, DY>, gll_nodal_function<4, 2, 2, DX, DY>, gll_nodal_function<4, 2, 3, DX, DY>, gll_nodal_function<4, 2, 4, DX, DY>, \
+  gll_nodal_function<4, 3, 0, DX, DY>, gll_nodal_function<4, 3, 1, DX, DY>, gll_nodal_function<4, 3, 2, DX, DY>, gll_nodal_function<4, 3, 3, DX, DY>, gll_nodal_function<4, 3, 4, DX, DY>, \
+  gll_nodal_function<4, 4, 0, DX, DY>, gll_nodal_function<4, 4, 1, DX, DY>, gll_nodal_function<4, 4, 2, DX, DY>, gll_nodal_function<4, 4, 3, DX, DY>, gll_nodal_function<4, 4, 4, DX, DY>
+
+#define GLL_NODAL_FUNCTIONS_5(DX, DY) \
+  gll_nodal_function<5, 0, 0, DX, DY>, gll_nodal_function<5, 0, 1, DX, DY>, gll_nodal_function<5, 0, 2, DX, DY>, gll_nodal_function<5, 0, 3, DX, DY>, gll_nodal_function<5, 0, 4, DX, DY>, gll_nodal_function<5, 0, 5, DX, DY>, \
+  gll_nodal_function<5, 1, 0, DX, DY>, gll_nodal_function<5, 1, 1, DX, DY>, gll_nodal_function<5, 1, 2, DX, DY>, gll_nodal_function<5, 1, 3, DX, DY>, gll_nodal_function<5, 1, 4, DX, DY>, gll_nodal_function<5, 1, 5, DX, DY>, \
+  gll_nodal_function<5, 2, 0, DX, DY>, gll_nodal_function<5, 2, 1, DX, DY>, gll_nodal_function<5, 2, 2, DX, DY>, gll_nodal_function<5, 2, 3, DX, DY>, gll_nodal_function<5, 2, 4, DX, DY>, gll_nodal_function<5, 2, 5, DX, DY>, \
+  gll_nodal_function<5, 3, 0, DX, DY>, gll_nodal_function<5, 3, 1, DX, DY>, gll_nodal_function<5, 3, 2, DX, DY>, gll_nodal_function<5, 3, 3, DX, DY>, gll_nodal_function<5, 3, 4, DX, DY>, gll_nodal_function<5, 3, 5, DX, DY>, \
+  gll_nodal_function<5, 4, 0, DX, DY>, gll_nodal_function<5, 4, 1, DX, DY>, gll_nodal_function<5, 4, 2, DX, DY>, gll_nodal_function<5, 4, 3, DX, DY>, gll_nodal_function<5, 4, 4, DX, DY>, gll_nodal_function<5, 4, 5, DX, DY>, \
+  gll_nodal_function<5, 5, 0, DX, DY>, gll_nodal_function<5, 5, 1, DX, DY>, gll_nodal_function<5, 5, 2, DX, DY>, gll_nodal_function<5, 5, 3, DX, DY>, gll_nodal_function<5, 5, 4, DX, DY>, gll_nodal_function<5, 5, 5, DX, DY>
+
+#define GLL_NODAL_FUNCTIONS_6(DX, DY) \
+  gll_nodal_function<6, 0, 0, DX, DY>, gll_nodal_function<6, 0, 1, DX, DY>, gll_nodal_function<6, 0, 2, DX, DY>, gll_nodal_function<6, 0, 3, DX, DY>, gll_nodal_function<6, 0, 4, DX, DY>, gll_nodal_function<6, 0, 5, DX, DY>, gll_nodal_function<6, 0, 6, DX, DY>, \
+  gll_nodal_function<6, 1, 0, DX, DY>, gll_nodal_function<6, 1, 1, DX, DY>, gll_nodal_function<6, 1, 2, DX, DY>, gll_nodal_function<6, 1, 3, DX, DY>, gll_nodal_function<6, 1, 4, DX, DY>, gll_nodal_function<6, 1, 5, DX, DY>, gll_nodal_function<6, 1, 6, DX, DY>, \
+  gll_nodal_function<6, 2, 0, DX, DY>, gll_nodal_function<6, 2, 1, DX, DY>, gll_nodal_function<6, 2, 2, DX, DY>, gll_nodal_function<6, 2, 3, DX, DY>, gll_nodal_function<6, 2, 4, DX, DY>, gll_nodal_function<6, 2, 5, DX, DY>, gll_nodal_function<6, 2, 6, DX, DY>, \
+  gll_nodal_function<6, 3, 0, DX, DY>, gll_nodal_function<6, 3, 1, DX, DY>, gll_nodal_function<6, 3, 2, DX, DY>, gll_nodal_function<6, 3, 3, DX, DY>, gll_nodal_function<6, 3, 4, DX, DY>, gll_nodal_function<6, 3, 5, DX, DY>, gll_nodal_function<6, 3, 6, DX, DY>, \
+  gll_nodal_function<6, 4, 0, DX, DY>, gll_nodal_function<6, 4, 1, DX, DY>, gll_nodal_function<6, 4, 2, DX, DY>, gll_nodal_function<6, 4, 3, DX, DY>, gll_nodal_function<6, 4, 4, DX, DY>, gll_nodal_function<6, 4, 5, DX, DY>, gll_nodal_function<6, 4, 6, DX, DY>, \
+  gll_nodal_function<6, 5, 0, DX, DY>, gll_nodal_function<6, 5, 1, DX, DY>, gll_nodal_function<6, 5, 2, DX, DY>, gll_nodal_function<6, 5, 3, DX, DY>, gll_nodal_function<6, 5, 4, DX, DY>, gll_nodal_function<6, 5, 5, DX, DY>, gll_nodal_function<6, 5, 6, DX, DY>, \
+  gll_nodal_function<6, 6, 0, DX, DY>, gll_nodal_function<6, 6, 1, DX, DY>, gll_nodal_function<6, 6, 2, DX, DY>, gll_nodal_function<6, 6, 3, DX, DY>, gll_nodal_function<6, 6, 4, DX, DY>, gll_nodal_function<6, 6, 5, DX, DY>, gll_nodal_function<6, 6, 6, DX, DY>
+
+#define GLL_NODAL_FUNCTIONS_7(DX, DY) \
+  gll_nodal_function<7, 0, 0, DX, DY>, gll_nodal_function<7, 0, 1, DX, DY>, gll_nodal_function<7, 0, 2, DX, DY>, gll_nodal_function<7, 0, 3, DX, DY>, gll_nodal_function<7, 0, 4, DX, DY>, gll_nodal_function<7, 0, 5, DX, DY>, gll_nodal_function<7, 0, 6, DX, DY>, gll_nodal_function<7, 0, 7, DX, DY>, \
+  gll_nodal_function<7, 1, 0, DX, DY>, gll_nodal_function<7, 1, 1, DX, DY>, gll_nodal_function<7, 1, 2, DX, DY>, gll_nodal_function<7, 1, 3, DX, DY>, gll_nodal_function<7, 1, 4, DX, DY>, gll_nodal_function<7, 1, 5, DX, DY>, gll_nodal_function<7, 1, 6, DX, DY>, gll_nodal_function<7, 1, 7, DX, DY>, \
+  gll_nodal_function<7, 2, 0, DX, DY>, gll_nodal_function<7, 2, 1, DX, DY>, gll_nodal_function<7, 2, 2, DX, DY>, gll_nodal_function<7, 2, 3, DX, DY>, gll_nodal_function<7, 2, 4, DX, DY>, gll_nodal_function<7, 2, 5, DX, DY>, gll_nodal_function<7, 2, 6, DX, DY>, gll_nodal_function<7, 2, 7, DX, DY>, \
+  gll_nodal_function<7, 3, 0, DX, DY>, gll_nodal_function<7, 3, 1, DX, DY>, gll_nodal_function<7, 3, 2, DX, DY>, gll_nodal_function<7, 3, 3, DX, DY>, gll_nodal_function<7, 3, 4, DX, DY>, gll_nodal_function<7, 3, 5, DX, DY>, gll_nodal_function<7, 3, 6, DX, DY>, gll_nodal_function<7, 3, 7, DX, DY>, \
+  gll_nodal_function<7, 4, 0, DX, DY>, gll_nodal_function<7, 4, 1, DX, DY>, gll_nodal_function<7, 4, 2, DX, DY>, gll_nodal_function<7, 4, 3, DX, DY>, gll_nodal_function<7, 4, 4, DX, DY>, gll_nodal_function<7, 4, 5, DX, DY>, gll_nodal_function<7, 4, 6, DX, DY>, gll_nodal_function<7, 4, 7, DX, DY>, \
+  gll_nodal_function<7, 5, 0, DX, DY>, gll_nodal_function<7, 5, 1, DX, DY>, gll_nodal_function<7, 5, 2, DX, DY>, gll_nodal_function<7, 5, 3, DX, DY>, gll_nodal_function<7, 5, 4, DX, DY>, gll_nodal_function<7, 5, 5, DX, DY>, gll_nodal_function<7, 5, 6, DX, DY>, gll_nodal_function<7, 5, 7, DX, DY>, \
+  gll_nodal_function<7, 6, 0, DX, DY>, gll_nodal_function<7, 6, 1, DX, DY>, gll_nodal_function<7, 6, 2, DX, DY>, gll_nodal_function<7, 6, 3, DX, DY>, gll_nodal_function<7, 6, 4, DX, DY>, gll_nodal_function<7, 6, 5, DX, DY>, gll_nodal_function<7, 6, 6, DX, DY>, gll_nodal_function<7, 6, 7, DX, DY>, \
+  gll_nodal_function<7, 7, 0, DX, DY>, gll_nodal_function<7, 7, 1, DX, DY>, gll_nodal_function<7, 7, 2, DX, DY>, gll_nodal_function<7, 7, 3, DX, DY>, gll_nodal_function<7, 7, 4, DX, DY>, gll_nodal_function<7, 7, 5, DX, DY>, gll_nodal_function<7, 7, 6, DX, DY>, gll_nodal_function<7, 7, 7, DX, DY>
+
+#define GLL_NODAL_FUNCTIONS_8(DX, DY) \
+  gll_nodal_function<8, 0, 0, DX, DY>, gll_nodal_function<8, 0, 1, DX, DY>, gll_nodal_function<8, 0, 2, DX, DY>, gll_nodal_function<8, 0, 3, DX, DY>, gll_nodal_function<8, 0, 4, DX, DY>, gll_nodal_function<8, 0, 5, DX, DY>, gll_nodal_function<8, 0, 6, DX, DY>, gll_nodal_function<8, 0, 7, DX, DY>, gll_nodal_function<8, 0, 8, DX, DY>, \
+  gll_nodal_function<8, 1, 0, DX, DY>, gll_nodal_function<8, 1, 1, DX, DY>, gll_nodal_function<8, 1, 2, DX, DY>, gll_nodal_function<8, 1, 3, DX, DY>, gll_nodal_function<8, 1, 4, DX, DY>, gll_nodal_function<8, 1, 5, DX, DY>, gll_nodal_function<8, 1, 6, DX, DY>, gll_nodal_function<8, 1, 7, DX, DY>, gll_nodal_function<8, 1, 8, DX, DY>, \
+  gll_nodal_function<8, 2, 0, DX, DY>, gll_nodal_function<8, 2, 1, DX, DY>, gll_nodal_function<8, 2, 2, DX, DY>, gll_nodal_function<8, 2, 3, DX, DY>, gll_nodal_function<8, 2, 4, DX, DY>, gll_nodal_function<8, 2, 5, DX, DY>, gll_nodal_function<8, 2, 6, DX, DY>, gll_nodal_function<8, 2, 7, DX, DY>, gll_nodal_function<8, 2, 8, DX, DY>, \
+  gll_nodal_function<8, 3, 0, DX, DY>, gll_nodal_function<8, 3, 1, DX, DY>, gll_nodal_function<8, 3, 2, DX, DY>, gll_nodal_function<8, 3, 3, DX, DY>, gll_nodal_function<8, 3, 4, DX, DY>, gll_nodal_function<8, 3, 5, DX, DY>, gll_nodal_function<8, 3, 6, DX, DY>, gll_nodal_function<8, 3, 7, DX, DY>, gll_nodal_function<8, 3, 8, DX, DY>, \
+  gll_nodal_function<8, 4, 0, DX, DY>, gll_nodal_function<8, 4, 1, DX, DY>, gll_nodal_function<8, 4, 2, DX, DY>, gll_nodal_function<8, 4, 3, DX, DY>, gll_nodal_function<8, 4, 4, DX, DY>, gll_nodal_function<8, 4, 5, DX, DY>, gll_nodal_function<8, 4, 6, DX, DY>, gll_nodal_function<8, 4, 7, DX, DY>, gll_nodal_function<8, 4, 8, DX, DY>, \
+  gll_nodal_function<8, 5, 0, DX, DY>, gll_nodal_function<8, 5, 1, DX, DY>, gll_nodal_function<8, 5, 2, DX, DY>, gll_nodal_function<8, 5, 3, DX, DY>, gll_nodal_function<8, 5, 4, DX, DY>, gll_nodal_function<8, 5, 5, DX, DY>, gll_nodal_function<8, 5, 6, DX, DY>, gll_nodal_function<8, 5, 7, DX, DY>, gll_nodal_function<8, 5, 8, DX, DY>, \
+  gll_nodal_function<8, 6, 0, DX, DY>, gll_nodal_function<8, 6, 1, DX, DY>, gll_nodal_function<8, 6, 2, DX, DY>, gll_nodal_function<8, 6, 3, DX, DY>, gll_nodal_function<8, 6, 4, DX, DY>, gll_nodal_function<8, 6, 5, DX, DY>, gll_nodal_function<8, 6, 6, DX, DY>, gll_nodal_function<8, 6, 7, DX, DY>, gll_nodal_function<8, 6, 8, DX, DY>, \
+  gll_nodal_function<8, 7, 0, DX, DY>, gll_nodal_function<8, 7, 1, DX, DY>, gll_nodal_function<8, 7, 2, DX, DY>, gll_nodal_function<8, 7, 3, DX, DY>, gll_nodal_function<8, 7, 4, DX, DY>, gll_nodal_function<8, 7, 5, DX, DY>, gll_nodal_function<8, 7, 6, DX, DY>, gll_nodal_function<8, 7, 7, DX, DY>, gll_nodal_function<8, 7, 8, DX, DY>, \
+  gll_nodal_function<8, 8, 0, DX, DY>, gll_nodal_function<8, 8, 1, DX, DY>, gll_nodal_function<8, 8, 2, DX, DY>, gll_nodal_function<8, 8, 3, DX, DY>, gll_nodal_function<8, 8, 4, DX, DY>, gll_nodal_function<8, 8, 5, DX, DY>, gll_nodal_function<8, 8, 6, DX, DY>, gll_nodal_function<8, 8, 7, DX, DY>, gll_nodal_function<8, 8, 8, DX, DY>
+
+#define GLL_NODAL_FUNCTIONS_9(DX, DY) \
+  gll_nodal_function<9, 0, 0, DX, DY>, gll_nodal_function<9, 0, 1, DX, DY>, gll_nodal_function<9, 0, 2, DX, DY>, gll_nodal_function<9, 0, 3, DX, DY>, gll_nodal_function<9, 0, 4, DX, DY>, gll_nodal_function<9, 0, 5, DX, DY>, gll_nodal_function<9, 0, 6, DX, DY>, gll_nodal_function<9, 0, 7, DX, DY>, gll_nodal_function<9, 0, 8, DX, DY>, gll_nodal_function<9, 0, 9, DX, DY>, \
+  gll_nodal_function<9, 1, 0, DX, DY>, gll_nodal_function<9, 1, 1, DX, DY>, gll_nodal_function<9, 1, 2, DX, DY>, gll_nodal_function<9, 1, 3, DX, DY>, gll_nodal_function<9, 1, 4, DX, DY>, gll_nodal_function<9, 1, 5, DX, DY>, gll_nodal_function<9, 1, 6, DX, DY>, gll_nodal_function<9, 1, 7, DX, DY>, gll_nodal_function<9, 1, 8, DX, DY>, gll_nodal_function<9, 1, 9, DX, DY>, \
+  gll_nodal_function<9, 2, 0, DX, DY>, gll_nodal_function<9, 2, 1, DX, DY>, gll_nodal_function<9, 2, 2, DX, DY>, gll_nodal_function<9, 2, 3, DX, DY>, gll_nodal_function<9, 2, 4, DX, DY>, gll_nodal_function<9, 2, 5, DX, DY>, gll_nodal_function<9, 2, 6, DX, DY>, gll_nodal_function<9, 2, 7, DX, DY>, gll_nodal_function<9, 2, 8, DX, DY>, gll_nodal_function<9, 2, 9, DX, DY>, \
+  gll_nodal_function<9, 3, 0, DX, DY>, gll_nodal_function<9, 3, 1, DX, DY>, gll_nodal_function<9, 3, 2, DX, DY>, gll_nodal_function<9, 3, 3, DX, DY>, gll_nodal_function<9, 3, 4, DX, DY>, gll_nodal_function<9, 3, 5, DX, DY>, gll_nodal_function<9, 3, 6, DX, DY>, gll_nodal_function<9, 3, 7, DX, DY>, gll_nodal_function<9, 3, 8, DX, DY>, gll_nodal_function<9, 3, 9, DX, DY>, \
+  gll_nodal_function<9, 4, 0, DX, DY>, gll_nodal_function<9, 4, 1, DX, DY>, gll_nodal_function<9, 4, 2, DX, DY>, gll_nodal_function<9, 4, 3, DX, DY>, gll_nodal_function<9, 4, 4, DX, DY>, gll_nodal_function<9, 4, 5, DX, DY>, gll_nodal_function<9, 4, 6, DX, DY>, gll_nodal_function<9, 4, 7, DX, DY>, gll_nodal_function<9, 4, 8, DX, DY>, gll_nodal_function<9, 4, 9, DX, DY>, \
+  gll_nodal_function<9, 5, 0, DX, DY>, gll_nodal_function<9, 5, 1, DX, DY>, gll_nodal_function<9, 5, 2, DX, DY>, gll_nodal_function<9, 5, 3, DX, DY>, gll_nodal_function<9, 5, 4, DX, DY>, gll_nodal_function<9, 5, 5, DX, DY>, gll_nodal_function<9, 5, 6, DX, DY>, gll_nodal_function<9, 5, 7, DX, DY>, gll_nodal_function<9, 5, 8, DX, DY>, gll_nodal_function<9, 5, 9, DX, DY>, \
+  gll_nodal_function<9, 6, 0, DX, DY>, gll_nodal_function<9, 6, 1, DX, DY>, gll_nodal_function<9, 6, 2, DX, DY>, gll_nodal_function<9, 6, 3, DX, DY>, gll_nodal_function<9, 6, 4, DX, DY>, gll_nodal_function<9, 6, 5, DX, DY>, gll_nodal_function<9, 6, 6, DX, DY>, gll_nodal_function<9, 6, 7, DX, DY>, gll_nodal_function<9, 6, 8, DX, DY>, gll_nodal_function<9, 6, 9, DX, DY>, \
+  gll_nodal_function<9, 7, 0, DX, DY>, gll_nodal_function<9, 7, 1, DX, DY>, gll_nodal_function<9, 7, 2, DX, DY>, gll_nodal_function<9, 7, 3, DX, DY>, gll_nodal_function<9, 7, 4, DX, DY>, gll_nodal_function<9, 7, 5, DX, DY>, gll_nodal_function<9, 7, 6, DX, DY>, gll_nodal_function<9, 7, 7, DX, DY>, gll_nodal_function<9, 7, 8, DX, DY>, gll_nodal_function<9, 7, 9, DX, DY>, \
+  gll_nodal_function<9, 8, 0, DX, DY>, gll_nodal_function<9, 8, 1, DX, DY>, gll_nodal_function<9, 8, 2, DX, DY>, gll_nodal_function<9, 8, 3, DX, DY>, gll_nodal_function<9, 8, 4, DX, DY>, gll_nodal_function<9, 8, 5, DX, DY>, gll_nodal_function<9, 8, 6, DX, DY>, gll_nodal_function<9, 8, 7, DX, DY>, gll_nodal_function<9, 8, 8, DX, DY>, gll_nodal_function<9, 8, 9, DX, DY>, \
+  gll_nodal_function<9, 9, 0, DX, DY>, gll_nodal_function<9, 9, 1, DX, DY>, gll_nodal_function<9, 9, 2, DX, DY>, gll_nodal_function<9, 9, 3, DX, DY>, gll_nodal_function<9, 9, 4, DX, DY>, gll_nodal_function<9, 9, 5, DX, DY>, gll_nodal_function<9, 9, 6, DX, DY>, gll_nodal_function<9, 9, 7, DX, DY>, gll_nodal_function<9, 9, 8, DX, DY>, gll_nodal_function<9, 9, 9, DX, DY>
+
+#define GLL_NODAL_FUNCTIONS_10(DX, DY) \
+  gll_nodal_function<10, 0, 0, DX, DY>, gll_nodal_function<10, 0, 1, DX, DY>, gll_nodal_function<10, 0, 2, DX, DY>, gll_nodal_function<10, 0, 3, DX, DY>, gll_nodal_function<10, 0, 4, DX, DY>, gll_nodal_function<10, 0, 5, DX, DY>, gll_nodal_function<10, 0, 6, DX, DY>, gll_nodal_function<10, 0, 7, DX, DY>, gll_nodal_function<10, 0, 8, DX, DY>, gll_nodal_function<10, 0, 9, DX, DY>, gll_nodal_function<10, 0, 10, DX, DY>, \
+  gll_nodal_function<10, 1, 0, DX, DY>, gll_nodal_function<10, 1, 1, DX, DY>, gll_nodal_function<10, 1, 2, DX, DY>, gll_nodal_function<10, 1, 3, DX, DY>, gll_nodal_function<10, 1, 4, DX, DY>, gll_nodal_function<10, 1, 5, DX, DY>, gll_nodal_function<10, 1, 6, DX, DY>, gll_nodal_function<10, 1, 7, DX, DY>, gll_nodal_function<10, 1, 8, DX, DY>, gll_nodal_function<10, 1, 9, DX, DY>, gll_nodal_function<10, 1, 10, DX, DY>, \
+  gll_nodal_function<10, 2, 0, DX, DY>, gll_nodal_function<10, 2, 1, DX, DY>, gll_nodal_function<10, 2, 2, DX, DY>, gll_nodal_function<10, 2, 3, DX, DY>, gll_nodal_function<10, 2, 4, DX, DY>, gll_nodal_function<10, 2, 5, DX, DY>, gll_nodal_function<10, 2, 6, DX, DY>, gll_nodal_function<10, 2, 7, DX, DY>, gll_nodal_function<10, 2, 8, DX, DY>, gll_nodal_function<10, 2, 9, DX, DY>, gll_nodal_function<10, 2, 10, DX, DY>, \
+  gll_nodal_function<10, 3, 0, DX, DY>, gll_nodal_function<10, 3, 1, DX, DY>, gll_nodal_function<10, 3, 2, DX, DY>, gll_nodal_function<10, 3, 3, DX, DY>, gll_nodal_function<10, 3, 4, DX, DY>, gll_nodal_function<10, 3, 5, DX, DY>, gll_nodal_function<10, 3, 6, DX, DY>, gll_nodal_function<10, 3, 7, DX, DY>, gll_nodal_function<10, 3, 8, DX, DY>, gll_nodal_function<10, 3, 9, DX, DY>, gll_nodal_function<10, 3, 10, DX, DY>, \
+  gll_nodal_function<10, 4, 0, DX, DY>, gll_nodal_function<10, 4, 1, DX, DY>, gll_nodal_function<10, 4, 2, DX, DY>, gll_nodal_function<10, 4, 3, DX, DY>, gll_nodal_function<10, 4, 4, DX, DY>, gll_nodal_function<10, 4, 5, DX, DY>, gll_nodal_function<10, 4, 6, DX, DY>, gll_nodal_function<10, 4, 7, DX, DY>, gll_nodal_function<10, 4, 8, DX, DY>, gll_nodal_function<10, 4, 9, DX, DY>, gll_nodal_function<10, 4, 10, DX, DY>, \
+  gll_nodal_function<10, 5, 0, DX, DY>, gll_nodal_function<10, 5, 1, DX, DY>, gll_nodal_function<10, 5, 2, DX, DY>, gll_nodal_function<10, 5, 3, DX, DY>, gll_nodal_function<10, 5, 4, DX, DY>, gll_nodal_function<10, 5, 5, DX, DY>, gll_nodal_function<10, 5, 6, DX, DY>, gll_nodal_function<10, 5, 7, DX, DY>, gll_nodal_function<10, 5, 8, DX, DY>, gll_nodal_function<10, 5, 9, DX, DY>, gll_nodal_function<10, 5, 10, DX, DY>, \
+  gll_nodal_function<10, 6, 0, DX, DY>, gll_nodal_function<10, 6, 1, DX, DY>, gll_nodal_function<10, 6, 2, DX, DY>, gll_nodal_function<10, 6, 3, DX, DY>, gll_nodal_function<10, 6, 4, DX, DY>, gll_nodal_function<10, 6, 5, DX, DY>, gll_nodal_function<10, 6, 6, DX, DY>, gll_nodal_function<10, 6, 7, DX, DY>, gll_nodal_function<10, 6, 8, DX, DY>, gll_nodal_function<10, 6, 9, DX, DY>, gll_nodal_function<10, 6, 10, DX, DY>, \
+  gll_nodal_function<10, 7, 0, DX, DY>, gll_nodal_function<10, 7, 1, DX, DY>, gll_nodal_function<10, 7, 2, DX, DY>, gll_nodal_function<10, 7, 3, DX, DY>, gll_nodal_function<10, 7, 4, DX, DY>, gll_nodal_function<10, 7, 5, DX, DY>, gll_nodal_function<10, 7, 6, DX, DY>, gll_nodal_function<10, 7, 7, DX, DY>, gll_nodal_function<10, 7, 8, DX, DY>, gll_nodal_function<10, 7, 9, DX, DY>, gll_nodal_function<10, 7, 10, DX, DY>, \
+  gll_nodal_function<10, 8, 0, DX, DY>, gll_nodal_function<10, 8, 1, DX, DY>, gll_nodal_function<10, 8, 2, DX, DY>, gll_nodal_function<10, 8, 3, DX, DY>, gll_nodal_function<10, 8, 4, DX, DY>, gll_nodal_function<10, 8, 5, DX, DY>, gll_nodal_function<10, 8, 6, DX, DY>, gll_nodal_function<10, 8, 7, DX, DY>, gll_nodal_function<10, 8, 8, DX, DY>, gll_nodal_function<10, 8, 9, DX, DY>, gll_nodal_function<10, 8, 10, DX, DY>, \
+  gll_nodal_function<10, 9, 0, DX, DY>, gll_nodal_function<10, 9, 1, DX, DY>, gll_nodal_function<10, 9, 2, DX, DY>, gll_nodal_function<10, 9, 3, DX, DY>, gll_nodal_function<10, 9, 4, DX, DY>, gll_nodal_function<10, 9, 5, DX, DY>, gll_nodal_function<10, 9, 6, DX, DY>, gll_nodal_function<10, 9, 7, DX, DY>, gll_nodal_function<10, 9, 8, DX, DY>, gll_nodal_function<10, 9, 9, DX, DY>, gll_nodal_function<10, 9, 10, DX, DY>, \
+  gll_nodal_function<10, 10, 0, DX, DY>, gll_nodal_function<10, 10, 1, DX, DY>, gll_nodal_function<10, 10, 2, DX, DY>, gll_nodal_function<10, 10, 3, DX, DY>, gll_nodal_function<10, 10, 4, DX, DY>, gll_nodal_function<10, 10, 5, DX, DY>, gll_nodal_function<10, 10, 6, DX, DY>, gll_nodal_function<10, 10, 7, DX, DY>, gll_nodal_function<10, 10, 8, DX, DY>, gll_nodal_function<10, 10, 9, DX, DY>, gll_nodal_function<10, 10, 10, DX, DY>
+
+#define GLL_NODAL_FUNCTIONS(DX, DY) \
+  GLL_NODAL_FUNCTIONS_0(DX, DY), \
+  GLL_NODAL_FUNCTIONS_1(DX, DY), \
+  GLL_NODAL_FUNCTIONS_2(DX, DY), \
+  GLL_NODAL_FUNCTIONS_3(DX, DY), \
+  GLL_NODAL_FUNCTIONS_4(DX, DY), \
+  GLL_NODAL_FUNCTIONS_5(DX, DY), \
+  GLL_NODAL_FUNCTIONS_6(DX, DY), \
+  GLL_NODAL_FUNCTIONS_7(DX, DY), \
+  GLL_NODAL_FUNCTIONS_8(DX, DY), \
+  GLL_NODAL_FUNCTIONS_9(DX, DY), \
+  GLL_NODAL_FUNCTIONS_10(DX, DY)
+
+    static Shapeset::shape_fn_t gll_nodal_fn[] = { GLL_NODAL_FUNCTIONS(0, 0) };
+    static Shapeset::shape_fn_t gll_nodal_dx[] = { GLL_NODAL_FUNCTIONS(1, 0) };
+    static Shapeset::shape_fn_t gll_nodal_dy[] = { GLL_NODAL_FUNCTIONS(0, 1) };
+    static Shapeset::shape_fn_t gll_nodal_dxx[] = { GLL_NODAL_FUNCTIONS(2, 0) };
+    static Shapeset::shape_fn_t gll_nodal_dyy[] = { GLL_NODAL_FUNCTIONS(0, 2) };
+    static Shapeset::shape_fn_t gll_nodal_dxy[] = { GLL_NODAL_FUNCTIONS(1, 1) };
+
+    static Shapeset::shape_fn_t* gll_nodal_mode_fn[1] = { gll_nodal_fn };
+    static Shapeset::shape_fn_t* gll_nodal_mode_dx[1] = { gll_nodal_dx };
+    static Shapeset::shape_fn_t* gll_nodal_mode_dy[1] = { gll_nodal_dy };
+    static Shapeset::shape_fn_t* gll_nodal_mode_dxx[1] = { gll_nodal_dxx };
+    static Shapeset::shape_fn_t* gll_nodal_mode_dyy[1] = { gll_nodal_dyy };
+    static Shapeset::shape_fn_t* gll_nodal_mode_dxy[1] = { gll_nodal_dxy };
+
+    static short gll_nodal_b_0[] = { 0 };
+    static short gll_nodal_b_1[] = { 1, 2, 3, 4 };
+    static short gll_nodal_b_2[] = { 5, 6, 7, 8, 9, 10, 11, 12, 13 };
+    static short gll_nodal_b_3[] = { 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29 };
+    static short gll_nodal_b_4[] = { 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54 };
+    static short gll_nodal_b_5[] = { 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90 };
+    static short gll_nodal_b_6[] = { 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 138, 139 };
+    static short gll_nodal_b_7[] = { 140, 141, 142, 143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203 };
+    static short gll_nodal_b_8[] = { 204, 205, 206, 207, 208, 209, 210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223, 224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239, 240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254, 255, 256, 257, 258, 259, 260, 261, 262, 263, 264, 265, 266, 267, 268, 269, 270, 271, 272, 273, 274, 275, 276, 277, 278, 279, 280, 281, 282, 283, 284 };
+    static short gll_nodal_b_9[] = { 285, 286, 287, 288, 289, 290, 291, 292, 293, 294, 295, 296, 297, 298, 299, 300, 301, 302, 303, 304, 305, 306, 307, 308, 309, 310, 311, 312, 313, 314, 315, 316, 317, 318, 319, 320, 321, 322, 323, 324, 325, 326, 327, 328, 329, 330, 331, 332, 333, 334, 335, 336, 337, 338, 339, 340, 341, 342, 343, 344, 345, 346, 347, 348, 349, 350, 351, 352, 353, 354, 355, 356, 357, 358, 359, 360, 361, 362, 363, 364, 365, 366, 367, 368, 369, 370, 371, 372, 373, 374, 375, 376, 377, 378, 379, 380, 381, 382, 383, 384 };
+    static short gll_nodal_b_10[] = { 385, 386, 387, 388, 389, 390, 391, 392, 393, 394, 395, 396, 397, 398, 399, 400, 401, 402, 403, 404, 405, 406, 407, 408, 409, 410, 411, 412, 413, 414, 415, 416, 417, 418, 419, 420, 421, 422, 423, 424, 425, 426, 427, 428, 429, 430, 431, 432, 433, 434, 435, 436, 437, 438, 439, 440, 441, 442, 443, 444, 445, 446, 447, 448, 449, 450, 451, 452, 453, 454, 455, 456, 457, 458, 459, 460, 461, 462, 463, 464, 465, 466, 467, 468, 469, 470, 471, 472, 473, 474, 475, 476, 477, 478, 479, 480, 481, 482, 483, 484, 485, 486, 487, 488, 489, 490, 491, 492, 493, 494, 495, 496, 497, 498, 499, 500, 501, 502, 503, 504, 505 };
+
+    static short* gll_nodal_mode_bubble_indices[11] =
+    {
+      gll_nodal_b_0, gll_nodal_b_1, gll_nodal_b_2, gll_nodal_b_3, gll_nodal_b_4, gll_nodal_b_5, gll_nodal_b_6, gll_nodal_b_7, gll_nodal_b_8, gll_nodal_b_9, gll_nodal_b_10
+    };
+
+    static unsigned short gll_nodal_mode_bubble_count[11] = { 1, 4, 9, 16, 25, 36, 49, 64, 81, 100, 121 };
+
+    static short gll_nodal_mode_vertex_indices[4] = { -1, -1, -1, -1 };
+
+    static short gll_nodal_edge_indices_0[22] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+    static short gll_nodal_edge_indices_1[22] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+    static short gll_nodal_edge_indices_2[22] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+    static short gll_nodal_edge_indices_3[22] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+
+    static short* gll_nodal_mode_edge_indices[4] =
+    {
+      gll_nodal_edge_indices_0,
+      gll_nodal_edge_indices_1,
+      gll_nodal_edge_indices_2,
+      gll_nodal_edge_indices_3
+    };
+
+    // On triangles, the functions of the order p are polynomials of the degree 2p.
+    static unsigned short gll_nodal_tri_index_to_order[] =
+    {
+      0,
+      2, 2, 2, 2,
+      4, 4, 4, 4, 4, 4, 4, 4, 4,
+      6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+      8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+      10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10,
+      12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+      14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+      16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+      18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18, 18,
+      20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20, 20
+    };
+
+#define oo H2D_MAKE_QUAD_ORDER
+
+    static unsigned short gll_nodal_quad_index_to_order[] =
+    {
+      oo(0, 0),
+      oo(1, 1), oo(1, 1), oo(1, 1), oo(1, 1),
+      oo(2, 2), oo(2, 2), oo(2, 2), oo(2, 2), oo(2, 2), oo(2, 2), oo(2, 2), oo(2, 2), oo(2, 2),
+      oo(3, 3), oo(3, 3), oo(3, 3), oo(3, 3), oo(3, 3), oo(3, 3), oo(3, 3), oo(3, 3), oo(3, 3), oo(3, 3), oo(3, 3), oo(3, 3), oo(3, 3), oo(3, 3), oo(3, 3), oo(3, 3),
+      oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4), oo(4, 4),
+      oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5), oo(5, 5),
+      oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6), oo(6, 6),
+      oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7), oo(7, 7),
+      oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8), oo(8, 8),
+      oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9), oo(9, 9),
+      oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10), oo(10, 10)
+    };
+
+#undef oo
+
+    static Shapeset::shape_fn_t** gll_nodal_shape_fn_table_fn[2] =
+    {
+      gll_nodal_mode_fn,
+      gll_nodal_mode_fn
+    };
+
+    static Shapeset::shape_fn_t** gll_nodal_shape_fn_table_dx[2] =
+    {
+      gll_nodal_mode_dx,
+      gll_nodal_mode_dx
+    };
+
+    static Shapeset::shape_fn_t** gll_nodal_shape_fn_table_dy[2] =
+    {
+      gll_nodal_mode_dy,
+      gll_nodal_mode_dy
+    };
+
+    static Shapeset::shape_fn_t** gll_nodal_shape_fn_table_dxx[2] =
+    {
+      gll_nodal_mode_dxx,
+      gll_nodal_mode_dxx
+    };
+
+    static Shapeset::shape_fn_t** gll_nodal_shape_fn_table_dyy[2] =
+    {
+      gll_nodal_mode_dyy,
+      gll_nodal_mode_dyy
+    };
+
+    static Shapeset::shape_fn_t** gll_nodal_shape_fn_table_dxy[2] =
+    {
+      gll_nodal_mode_dxy,
+      gll_nodal_mode_dxy
+    };
+
+    static short* gll_nodal_vertex_indices[2] =
+    {
+      gll_nodal_mode_vertex_indices,
+      gll_nodal_mode_vertex_indices
+    };
+
+    static short** gll_nodal_edge_indices[2] =
+    {
+      gll_nodal_mode_edge_indices,
+      gll_nodal_mode_edge_indices
+    };
+
+    static short** gll_nodal_bubble_indices[2] =
+    {
+      gll_nodal_mode_bubble_indices,
+      gll_nodal_mode_bubble_indices
+    };
+
+    static unsigned short* gll_nodal_bubble_count[2] =
+    {
+      gll_nodal_mode_bubble_count,
+      gll_nodal_mode_bubble_count
+    };
+
+    static unsigned short* gll_nodal_index_to_order[2] =
+    {
+      gll_nodal_tri_index_to_order,
+      gll_nodal_quad_index_to_order
+    };
+
+    L2ShapesetGLLNodal::L2ShapesetGLLNodal()
+    {
+      shape_table[0] = gll_nodal_shape_fn_table_fn;
+      shape_table[1] = gll_nodal_shape_fn_table_dx;
+      shape_table[2] = gll_nodal_shape_fn_table_dy;
+      shape_table[3] = gll_nodal_shape_fn_table_dxx;
+      shape_table[4] = gll_nodal_shape_fn_table_dyy;
+      shape_table[5] = gll_nodal_shape_fn_table_dxy;
+
+      vertex_indices = gll_nodal_vertex_indices;
+      edge_indices = gll_nodal_edge_indices;
+      bubble_indices = gll_nodal_bubble_indices;
+      bubble_count = gll_nodal_bubble_count;
+      index_to_order = gll_nodal_index_to_order;
+
+      ref_vert[0][0][0] = -1.0;
+      ref_vert[0][0][1] = -1.0;
+      ref_vert[0][1][0] = 1.0;
+      ref_vert[0][1][1] = -1.0;
+      ref_vert[0][2][0] = -1.0;
+      ref_vert[0][2][1] = 1.0;
+
+      ref_vert[1][0][0] = -1.0;
+      ref_vert[1][0][1] = -1.0;
+      ref_vert[1][1][0] = 1.0;
+      ref_vert[1][1][1] = -1.0;
+      ref_vert[1][2][0] = 1.0;
+      ref_vert[1][2][1] = 1.0;
+      ref_vert[1][3][0] = -1.0;
+      ref_vert[1][3][1] = 1.0;
+
+      max_order = 10;
+      min_order = 0;
+      num_components = 1;
+
+      ebias = 2;
+
+      comb_table = nullptr;
+    }
+
+    short* L2ShapesetGLLNodal::get_bubble_indices(unsigned short order, ElementMode2D mode) const
+    {
+      if (mode == HERMES_MODE_QUAD)
+      {
+        assert(H2D_GET_V_ORDER(order) == H2D_GET_H_ORDER(order));
+        return bubble_indices[mode][H2D_GET_V_ORDER(order)];
+      }
+      else
+        return Shapeset::get_bubble_indices(order, mode);
+    }
+
+    unsigned short L2ShapesetGLLNodal::get_num_bubbles(unsigned short order, ElementMode2D mode) const
+    {
+      if (mode == HERMES_MODE_QUAD)
+      {
+        assert(H2D_GET_V_ORDER(order) == H2D_GET_H_ORDER(order));
+        return bubble_count[mode][H2D_GET_V_ORDER(order)];
+      }
+      else
+        return Shapeset::get_num_bubbles(order, mode);
+    }
+
+    const unsigned short L2ShapesetGLLNodal::max_index[2] = { 505, 505 };
+    unsigned short L2ShapesetGLLNodal::get_max_index(ElementMode2D mode) const { return max_index[mode]; }
+  }
+}
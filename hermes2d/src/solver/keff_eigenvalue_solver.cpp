@@ -0,0 +1,463 @@
+// This file is part of Hermes2D
+//
+// Copyright (c) 2009 hp-FEM group at the University of Nevada, Reno (UNR).
+// Email: hpfem-group@unr.edu, home page: http://www.hpfem.org/.
+//
+// Hermes2D is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation; either version 2 of the License,
+// or (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+/*! \file keff_eigenvalue_solver.cpp
+\brief k-eigenvalue (criticality) solver.
+*/
+#include "solver/keff_eigenvalue_solver.h"
+#include "projections/ogprojection.h"
+
+using namespace Hermes::Algebra;
+using namespace Hermes::Solvers;
+
+namespace Hermes
+{
+  namespace Hermes2D
+  {
+    /// Below this dominance ratio, the Chebyshev extrapolation does not pay off.
+    static const double H2D_CHEBYSHEV_MIN_DOMINANCE_RATIO = 0.3;
+    /// The extrapolation polynomials need the dominance ratio strictly below one.
+    static const double H2D_CHEBYSHEV_MAX_DOMINANCE_RATIO = 0.995;
+
+    static double l2_norm(const double* vec, int size)
+    {
+      double result = 0.;
+      for (int i = 0; i < size; i++)
+        result += vec[i] * vec[i];
+      return std::sqrt(result);
+    }
+
+    static double dot_product(const double* vec_1, const double* vec_2, int size)
+    {
+      double result = 0.;
+      for (int i = 0; i < size; i++)
+        result += vec_1[i] * vec_2[i];
+      return result;
+    }
+
+    static void scale(double* vec, double factor, int size)
+    {
+      for (int i = 0; i < size; i++)
+        vec[i] *= factor;
+    }
+
+    /// target = a + factor * b, the sparse structure of target being the union of the structures of a and b.
+    static void add_cs_matrices(SparseMatrix<double>* a, SparseMatrix<double>* b, double factor, SparseMatrix<double>* target)
+    {
+      CSMatrix<double>* matrices[2] = { dynamic_cast<CSMatrix<double>*>(a), dynamic_cast<CSMatrix<double>*>(b) };
+      if (!matrices[0] || !matrices[1])
+        throw Exceptions::Exception("KeffEigenvalueSolver: the Wielandt shift needs the operators in a compressed sparse (CSC / CSR) format.");
+      double factors[2] = { 1., factor };
+
+      // Ap runs over the columns for CSC, over the rows for CSR.
+      bool row_major = dynamic_cast<CSRMatrix<double>*>(a) != nullptr;
+      unsigned int size = a->get_size();
+
+      target->prealloc(size);
+      for (int m = 0; m < 2; m++)
+      {
+        int* Ap = matrices[m]->get_Ap();
+        int* Ai = matrices[m]->get_Ai();
+        for (unsigned int i = 0; i < size; i++)
+        for (int k = Ap[i]; k < Ap[i + 1]; k++)
+        {
+          if (row_major)
+            target->pre_add_ij(i, Ai[k]);
+          else
+            target->pre_add_ij(Ai[k], i);
+        }
+      }
+      target->alloc();
+
+      for (int m = 0; m < 2; m++)
+      {
+        int* Ap = matrices[m]->get_Ap();
+        int* Ai = matrices[m]->get_Ai();
+        double* Ax = matrices[m]->get_Ax();
+        for (unsigned int i = 0; i < size; i++)
+        for (int k = Ap[i]; k < Ap[i + 1]; k++)
+        {
+          if (row_major)
+            target->add(i, Ai[k], factors[m] * Ax[k]);
+          else
+            target->add(Ai[k], i, factors[m] * Ax[k]);
+        }
+      }
+      target->finish();
+    }
+
+    KeffEigenvalueSolver::KeffEigenvalueSolver(WeakFormSharedPtr<double> loss_wf, WeakFormSharedPtr<double> fission_wf, SpaceSharedPtr<double> space)
+      : loss_dp(new DiscreteProblem<double>(loss_wf, space, true)), fission_dp(new DiscreteProblem<double>(fission_wf, space, true))
+    {
+      this->init();
+    }
+
+    KeffEigenvalueSolver::KeffEigenvalueSolver(WeakFormSharedPtr<double> loss_wf, WeakFormSharedPtr<double> fission_wf, std::vector<SpaceSharedPtr<double> > spaces)
+      : loss_dp(new DiscreteProblem<double>(loss_wf, spaces, true)), fission_dp(new DiscreteProblem<double>(fission_wf, spaces, true))
+    {
+      this->init();
+    }
+
+    void KeffEigenvalueSolver::init()
+    {
+      this->loss_matrix = create_matrix<double>(true);
+      this->fission_matrix = create_matrix<double>(true);
+      this->shifted_matrix = nullptr;
+      this->rhs = create_vector<double>(true);
+      this->operators_assembled = false;
+      this->problem_size = 0;
+
+      this->linear_matrix_solver = nullptr;
+      this->factorized_keff_shift = 0.;
+
+      this->keff_tolerance = 1e-6;
+      this->source_tolerance = 1e-5;
+      this->max_allowed_iterations = 1000;
+      this->initial_keff = 1.;
+      this->keff_shift = 0.;
+      this->chebyshev_acceleration = false;
+      this->chebyshev_dominance_ratio = 0.;
+      this->chebyshev_free_iterations = 6;
+      this->chebyshev_cycle_length = 6;
+
+      this->keff = 0.;
+      this->sln_vector = nullptr;
+      this->num_iters = 0;
+      this->dominance_ratio_estimate = 0.;
+    }
+
+    KeffEigenvalueSolver::~KeffEigenvalueSolver()
+    {
+      delete this->linear_matrix_solver;
+      delete this->loss_matrix;
+      delete this->fission_matrix;
+      delete this->shifted_matrix;
+      delete this->rhs;
+      delete this->loss_dp;
+      delete this->fission_dp;
+      delete[] this->sln_vector;
+    }
+
+    void KeffEigenvalueSolver::set_tolerance(double keff_tolerance, double source_tolerance)
+    {
+      if (keff_tolerance <= 0.)
+        throw Exceptions::ValueException("keff_tolerance", keff_tolerance, 0.0);
+      if (source_tolerance <= 0.)
+        throw Exceptions::ValueException("source_tolerance", source_tolerance, 0.0);
+      this->keff_tolerance = keff_tolerance;
+      this->source_tolerance = source_tolerance;
+    }
+
+    void KeffEigenvalueSolver::set_max_allowed_iterations(int max_allowed_iterations)
+    {
+      if (max_allowed_iterations < 1)
+        throw Exceptions::ValueException("max_allowed_iterations", max_allowed_iterations, 1);
+      this->max_allowed_iterations = max_allowed_iterations;
+    }
+
+    void KeffEigenvalueSolver::set_initial_keff(double initial_keff)
+    {
+      if (initial_keff <= 0.)
+        throw Exceptions::ValueException("initial_keff", initial_keff, 0.0);
+      this->initial_keff = initial_keff;
+    }
+
+    void KeffEigenvalueSolver::set_wielandt_shift(double keff_shift)
+    {
+      if (keff_shift < 0.)
+        throw Exceptions::ValueException("keff_shift", keff_shift, 0.0);
+      this->keff_shift = keff_shift;
+    }
+
+    void KeffEigenvalueSolver::set_chebyshev_acceleration(bool to_set, double dominance_ratio, int free_iterations, int cycle_length)
+    {
+      if (dominance_ratio < 0. || dominance_ratio >= 1.)
+        throw Exceptions::ValueException("dominance_ratio", dominance_ratio, 0.0, 1.0);
+      if (free_iterations < 2)
+        throw Exceptions::ValueException("free_iterations", free_iterations, 2);
+      if (cycle_length < 1)
+        throw Exceptions::ValueException("cycle_length", cycle_length, 1);
+      this->chebyshev_acceleration = to_set;
+      this->chebyshev_dominance_ratio = dominance_ratio;
+      this->chebyshev_free_iterations = free_iterations;
+      this->chebyshev_cycle_length = cycle_length;
+    }
+
+    void KeffEigenvalueSolver::set_spaces(std::vector<SpaceSharedPtr<double> > spaces)
+    {
+      this->loss_dp->set_spaces(spaces);
+      this->fission_dp->set_spaces(spaces);
+      this->operators_assembled = false;
+    }
+
+    void KeffEigenvalueSolver::set_num_threads(int num_threads)
+    {
+      this->loss_dp->set_num_threads(num_threads);
+      this->fission_dp->set_num_threads(num_threads);
+    }
+
+    double KeffEigenvalueSolver::get_keff() const
+    {
+      return this->keff;
+    }
+
+    double* KeffEigenvalueSolver::get_sln_vector()
+    {
+      return this->sln_vector;
+    }
+
+    int KeffEigenvalueSolver::get_num_iters() const
+    {
+      return this->num_iters;
+    }
+
+    double KeffEigenvalueSolver::get_dominance_ratio_estimate() const
+    {
+      return this->dominance_ratio_estimate;
+    }
+
+    LinearMatrixSolver<double>* KeffEigenvalueSolver::get_linear_matrix_solver()
+    {
+      return this->linear_matrix_solver;
+    }
+
+    void KeffEigenvalueSolver::assemble_operators()
+    {
+      this->tick();
+
+      // Extremely important.
+      Space<double>::assign_dofs(this->loss_dp->get_spaces());
+      this->problem_size = Space<double>::get_num_dofs(this->loss_dp->get_spaces());
+
+      this->loss_dp->assemble(this->loss_matrix);
+      this->fission_dp->assemble(this->fission_matrix);
+      this->rhs->alloc(this->problem_size);
+
+      this->operators_assembled = true;
+      delete this->linear_matrix_solver;
+      this->linear_matrix_solver = nullptr;
+
+      this->tick();
+      this->info("\tKeffEigenvalueSolver: operators assembled in %s.", this->last_str().c_str());
+    }
+
+    void KeffEigenvalueSolver::prepare_factorization()
+    {
+      if (this->linear_matrix_solver && this->factorized_keff_shift == this->keff_shift)
+        return;
+
+      SparseMatrix<double>* matrix = this->loss_matrix;
+      delete this->shifted_matrix;
+      this->shifted_matrix = nullptr;
+      if (this->keff_shift > 0.)
+      {
+        this->shifted_matrix = create_matrix<double>(true);
+        add_cs_matrices(this->loss_matrix, this->fission_matrix, -1. / this->keff_shift, this->shifted_matrix);
+        matrix = this->shifted_matrix;
+      }
+
+      // The factorization is done in the first solve of this solver and reused in all the others.
+      delete this->linear_matrix_solver;
+      this->linear_matrix_solver = create_linear_solver<double>(matrix, this->rhs, true);
+      this->linear_matrix_solver->set_reuse_scheme(HERMES_CREATE_STRUCTURE_FROM_SCRATCH);
+      this->factorized_keff_shift = this->keff_shift;
+    }
+
+    void KeffEigenvalueSolver::solve(std::vector<MeshFunctionSharedPtr<double> > initial_guess)
+    {
+      double* coeff_vec = new double[Space<double>::get_num_dofs(this->loss_dp->get_spaces())];
+      OGProjection<double>::project_global(this->loss_dp->get_spaces(), initial_guess, coeff_vec);
+      this->solve(coeff_vec);
+      delete[] coeff_vec;
+    }
+
+    void KeffEigenvalueSolver::solve(double* coeff_vec)
+    {
+      HERMES_PROFILE_REGION("KeffEigenvalueSolver::solve");
+
+      if (!this->operators_assembled)
+        this->assemble_operators();
+      this->prepare_factorization();
+
+      this->tick();
+
+      int ndof = this->problem_size;
+      // The current iterate, the previous one (for the Chebyshev extrapolation), the new one, and their fission sources.
+      // Held in vectors so that nothing leaks when the substitution or the convergence check throws; sln_vector is only
+      // replaced at the end (coeff_vec may also be the previous sln_vector).
+      std::vector<double> phi_storage(ndof, 1.), phi_previous_storage(ndof), psi_storage(ndof), source_storage(ndof), new_source_storage(ndof);
+      double* phi = &phi_storage[0];
+      double* phi_previous = &phi_previous_storage[0];
+      double* psi = &psi_storage[0];
+      double* source = &source_storage[0];
+      double* new_source = &new_source_storage[0];
+
+      if (coeff_vec)
+        memcpy(phi, coeff_vec, ndof * sizeof(double));
+
+      // All iterates are normalized to a unit norm of their fission sources.
+      this->fission_matrix->multiply_with_vector(phi, source, true);
+      double source_norm = l2_norm(source, ndof);
+      if (source_norm == 0.)
+        throw Exceptions::Exception("KeffEigenvalueSolver: the initial guess has no fission source.");
+      scale(phi, 1. / source_norm, ndof);
+      scale(source, 1. / source_norm, ndof);
+
+      // The iteration is the power iteration of (L - shift F)^-1 F, the eigenvalue of which is mu = 1 / (1 / k - shift).
+      double shift = this->keff_shift > 0. ? 1. / this->keff_shift : 0.;
+      this->keff = this->initial_keff;
+      this->dominance_ratio_estimate = 0.;
+
+      // Chebyshev extrapolation state: the step in the current cycle (-1 during free iterations).
+      int chebyshev_step = -1, free_iterations_left = this->chebyshev_free_iterations;
+      double chebyshev_ratio = 0., chebyshev_gamma = 0., cycle_start_change = 0., previous_change = 0.;
+      bool use_given_dominance_ratio = this->chebyshev_dominance_ratio > 0.;
+
+      bool converged = false;
+      for (this->num_iters = 1; this->num_iters <= this->max_allowed_iterations; this->num_iters++)
+      {
+        // Substitution with the factorized operator.
+        this->rhs->set_vector(source);
+        this->linear_matrix_solver->solve();
+        memcpy(psi, this->linear_matrix_solver->get_sln_vector(), ndof * sizeof(double));
+        this->linear_matrix_solver->set_reuse_scheme(HERMES_REUSE_MATRIX_STRUCTURE_COMPLETELY);
+
+        // Rayleigh quotient with the fission sources.
+        this->fission_matrix->multiply_with_vector(psi, new_source, true);
+        double mu = dot_product(new_source, new_source, ndof) / dot_product(new_source, source, ndof);
+        double new_keff = 1. / (shift + 1. / mu);
+
+        source_norm = l2_norm(new_source, ndof);
+        scale(psi, 1. / source_norm, ndof);
+        scale(new_source, 1. / source_norm, ndof);
+
+        if (chebyshev_step >= 0)
+        {
+          // phi_{p+1} = phi_p + alpha_p (psi - phi_p) + beta_p (phi_p - phi_{p-1}), with the coefficients of the shifted
+          // and scaled Chebyshev polynomials on [0, dominance ratio].
+          double alpha, beta;
+          if (chebyshev_step == 0)
+          {
+            alpha = 2. / (2. - chebyshev_ratio);
+            beta = 0.;
+          }
+          else
+          {
+            alpha = 4. / chebyshev_ratio * std::cosh(chebyshev_step * chebyshev_gamma) / std::cosh((chebyshev_step + 1) * chebyshev_gamma);
+            beta = std::cosh((chebyshev_step - 1) * chebyshev_gamma) / std::cosh((chebyshev_step + 1) * chebyshev_gamma);
+          }
+
+          for (int i = 0; i < ndof; i++)
+          {
+            double extrapolated = phi[i] + alpha * (psi[i] - phi[i]) + beta * (phi[i] - phi_previous[i]);
+            phi_previous[i] = phi[i];
+            psi[i] = extrapolated;
+          }
+
+          this->fission_matrix->multiply_with_vector(psi, new_source, true);
+          source_norm = l2_norm(new_source, ndof);
+          scale(psi, 1. / source_norm, ndof);
+          scale(new_source, 1. / source_norm, ndof);
+          chebyshev_step++;
+        }
+        else
+          memcpy(phi_previous, phi, ndof * sizeof(double));
+
+        double keff_change = std::abs(new_keff - this->keff) / new_keff;
+        double source_change = 0., source_max = 0., source_change_l2 = 0.;
+        for (int i = 0; i < ndof; i++)
+        {
+          double difference = new_source[i] - source[i];
+          source_change = std::max(source_change, std::abs(difference));
+          source_max = std::max(source_max, std::abs(new_source[i]));
+          source_change_l2 += difference * difference;
+        }
+        source_change /= source_max;
+        source_change_l2 = std::sqrt(source_change_l2);
+
+        std::swap(phi, psi);
+        std::swap(source, new_source);
+        this->keff = new_keff;
+
+        this->info("\tKeffEigenvalueSolver: iteration %d, k_eff = %.10f, relative change of k_eff %g, of the fission source %g.",
+          this->num_iters, this->keff, keff_change, source_change);
+
+        if (keff_change < this->keff_tolerance && source_change < this->source_tolerance)
+        {
+          converged = true;
+          break;
+        }
+
+        if (this->chebyshev_acceleration)
+        {
+          if (chebyshev_step < 0)
+          {
+            // Free iteration - the fission source changes decrease by the dominance ratio.
+            if (previous_change > 0.)
+              this->dominance_ratio_estimate = source_change_l2 / previous_change;
+            if (--free_iterations_left <= 0)
+            {
+              chebyshev_ratio = use_given_dominance_ratio ? this->chebyshev_dominance_ratio : this->dominance_ratio_estimate;
+              if (chebyshev_ratio > H2D_CHEBYSHEV_MIN_DOMINANCE_RATIO)
+              {
+                chebyshev_ratio = std::min(chebyshev_ratio, H2D_CHEBYSHEV_MAX_DOMINANCE_RATIO);
+                chebyshev_gamma = std::log(2. / chebyshev_ratio - 1. + std::sqrt((2. / chebyshev_ratio - 1.) * (2. / chebyshev_ratio - 1.) - 1.));
+                chebyshev_step = 0;
+                cycle_start_change = source_change_l2;
+              }
+              else
+                free_iterations_left = this->chebyshev_free_iterations;
+            }
+          }
+          else if (chebyshev_step == this->chebyshev_cycle_length)
+          {
+            if (source_change_l2 < cycle_start_change)
+            {
+              chebyshev_step = 0;
+              cycle_start_change = source_change_l2;
+            }
+            else
+            {
+              // The cycle did not help - the dominance ratio is wrong, estimate it again.
+              this->info("\tKeffEigenvalueSolver: Chebyshev cycle with the dominance ratio %g failed, restarting the free iterations.", chebyshev_ratio);
+              chebyshev_step = -1;
+              free_iterations_left = this->chebyshev_free_iterations;
+              use_given_dominance_ratio = false;
+              source_change_l2 = 0.;
+            }
+          }
+        }
+
+        previous_change = source_change_l2;
+      }
+
+      double* new_sln_vector = new double[ndof];
+      delete[] this->sln_vector;
+      this->sln_vector = new_sln_vector;
+      memcpy(this->sln_vector, phi, ndof * sizeof(double));
+
+      this->tick();
+
+      if (!converged)
+        throw Exceptions::Exception("KeffEigenvalueSolver: not converged in %i iterations, k_eff = %g.", this->max_allowed_iterations, this->keff);
+
+      this->info("\tKeffEigenvalueSolver: k_eff = %.10f in %d iterations, %s.", this->keff, this->num_iters, this->last_str().c_str());
+      this->warn_if(this->keff_shift > 0. && this->keff >= this->keff_shift, "KeffEigenvalueSolver: the Wielandt shift %g is not above k_eff = %g, the iteration may have converged to a wrong mode.", this->keff_shift, this->keff);
+    }
+  }
+}
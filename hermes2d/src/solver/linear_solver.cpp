@@ -95,6 +95,7 @@ namespace Hermes
     template<typename Scalar>
     void LinearSolver<Scalar>::solve(Scalar* coeff_vec)
     {
+      HERMES_PROFILE_REGION("LinearSolver::solve");
       this->check();
 
       this->on_initialization();
@@ -61,6 +61,7 @@ namespace Hermes
     template<typename Scalar>
     void NewtonSolver<Scalar>::solve(Scalar* coeff_vec)
     {
+      HERMES_PROFILE_REGION("NewtonSolver::solve");
       NewtonMatrixSolver<Scalar>::solve(coeff_vec);
     }
 
@@ -85,6 +86,20 @@ namespace Hermes
       this->get_residual()->change_sign();
     }
 
+    template<typename Scalar>
+    bool NewtonSolver<Scalar>::supports_task_overlap() const
+    {
+      return true;
+    }
+
+    template<typename Scalar>
+    void NewtonSolver<Scalar>::assemble_residual_into(Vector<Scalar>* residual)
+    {
+      this->dp->assemble(this->sln_vector, residual);
+      this->process_vector_output(residual, this->get_current_iteration_number());
+      residual->change_sign();
+    }
+
     template<typename Scalar>
     bool NewtonSolver<Scalar>::assemble_jacobian(bool store_previous_jacobian)
     {
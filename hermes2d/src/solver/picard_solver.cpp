@@ -61,6 +61,7 @@ namespace Hermes
     template<typename Scalar>
     void PicardSolver<Scalar>::solve(Scalar* coeff_vec)
     {
+      HERMES_PROFILE_REGION("PicardSolver::solve");
       PicardMatrixSolver<Scalar>::solve(coeff_vec);
     }
 
@@ -131,6 +131,18 @@ namespace Hermes
       return this->dp->get_spaces();
     }
 
+    template<typename Scalar>
+    void Solver<Scalar>::set_num_threads(int num_threads)
+    {
+      this->dp->set_num_threads(num_threads);
+    }
+
+    template<typename Scalar>
+    const AssemblyStatistics& Solver<Scalar>::get_assembly_statistics() const
+    {
+      return this->dp->get_assembly_statistics();
+    }
+
     template class HERMES_API Solver < double > ;
     template class HERMES_API Solver < std::complex<double> > ;
   }
@@ -81,6 +81,15 @@ namespace Hermes
 
     unsigned g_space_seq = 0;
 
+    /// Thread-safe - spaces may be created / refined concurrently.
+    static unsigned next_space_seq()
+    {
+      unsigned seq;
+#pragma omp atomic capture
+      seq = g_space_seq++;
+      return seq;
+    }
+
     template<typename Scalar>
     void Space<Scalar>::init()
     {
@@ -88,7 +97,7 @@ namespace Hermes
       this->edata = nullptr;
       this->nsize = esize = 0;
       this->mesh_seq = -1;
-      this->seq = g_space_seq++;
+      this->seq = next_space_seq();
       this->seq_assigned = -1;
       this->ndof = 0;
       this->proj_mat = nullptr;
@@ -263,7 +272,7 @@ namespace Hermes
         this->set_element_order_internal(e->id, space->get_element_order(e->id));
       }
 
-      this->seq = g_space_seq++;
+      this->seq = next_space_seq();
 
       for_all_active_elements(e, this->mesh)
       {
@@ -338,7 +347,7 @@ namespace Hermes
           order = H2D_MAKE_QUAD_ORDER(order, order);
 
       edata[id].order = order;
-      seq = g_space_seq++;
+      seq = next_space_seq();
     }
 
     template<typename Scalar>
@@ -415,7 +424,7 @@ namespace Hermes
             ed->order = quad_order;
         }
       }
-      seq = g_space_seq++;
+      seq = next_space_seq();
     }
 
     template<typename Scalar>
@@ -728,7 +737,7 @@ namespace Hermes
     template<typename Scalar>
     void Space<Scalar>::ReferenceSpaceCreator::finish_construction(SpaceSharedPtr<Scalar> ref_space)
     {
-      ref_space->seq = g_space_seq++;
+      ref_space->seq = next_space_seq();
 
       Element *e;
       for_all_active_elements(e, coarse_space->get_mesh())
@@ -816,7 +825,7 @@ namespace Hermes
       free();
       this->mesh = mesh;
       this->mesh_seq = mesh->get_seq();
-      seq = g_space_seq++;
+      seq = next_space_seq();
     }
 
     template<typename Scalar>
@@ -1324,7 +1333,7 @@ namespace Hermes
           space->edata[parsed_xml_space->element_data().at(elem_data_i).e_id()].changed_in_last_adaptation = parsed_xml_space->element_data().at(elem_data_i).chgd();
         }
 
-        space->seq = g_space_seq++;
+        space->seq = next_space_seq();
 
         space->assign_dofs();
 
@@ -1363,7 +1372,7 @@ namespace Hermes
           this->edata[parsed_xml_space->element_data().at(elem_data_i).e_id()].changed_in_last_adaptation = parsed_xml_space->element_data().at(elem_data_i).chgd();
         }
 
-        this->seq = g_space_seq++;
+        this->seq = next_space_seq();
 
         this->assign_dofs();
       }
@@ -1449,7 +1458,7 @@ namespace Hermes
       bson_destroy(&br);
       free_with_check(datar);
 
-      space->seq = g_space_seq++;
+      space->seq = next_space_seq();
 
       space->assign_dofs();
 
@@ -1522,7 +1531,7 @@ namespace Hermes
       bson_destroy(&br);
       free_with_check(datar);
 
-      this->seq = g_space_seq++;
+      this->seq = next_space_seq();
 
       this->assign_dofs();
     }
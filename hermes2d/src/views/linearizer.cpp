@@ -19,12 +19,176 @@
 #include "exact_solution.h"
 #include "api2d.h"
 
+#ifdef WITH_ZLIB
+#include <zlib.h>
+#endif
+
+/// Size of the (uncompressed) blocks of zlib-compressed VTU data arrays.
+#define H2D_VTU_ZLIB_BLOCK_SIZE 1048576
+
 namespace Hermes
 {
   namespace Hermes2D
   {
     namespace Views
     {
+      /// Internal - one data array of a .vtu file, stored in the appended section.
+      /// The data may consist of more buffers (e.g. one per thread linearizer), these are written one after another.
+      struct VTUDataArray
+      {
+        VTUDataArray(const char* name, const char* type, int components) : name(name), type(type), components(components), size(0)
+        {
+        }
+
+        void add_part(const void* data, size_t part_size)
+        {
+          if (part_size > 0)
+            parts.push_back(std::pair<const char*, size_t>((const char*)data, part_size));
+          size += part_size;
+        }
+
+        const char* name;
+        const char* type;
+        int components;
+        std::vector<std::pair<const char*, size_t> > parts;
+        /// Total (uncompressed) size in bytes.
+        size_t size;
+        /// Compressed data, including the block header.
+        std::vector<unsigned char> encoded;
+      };
+
+      /// Internal - a vertex of a thread linearizer in the merging of vertices.
+      struct LinearizerMergeEntry
+      {
+        LinearizerMergeEntry(unsigned long long key, int thread, int index) : key(key), thread(thread), index(index)
+        {
+        }
+
+        bool operator<(const LinearizerMergeEntry& other) const
+        {
+          if (key != other.key)
+            return key < other.key;
+          if (thread != other.thread)
+            return thread < other.thread;
+          return index < other.index;
+        }
+
+        unsigned long long key;
+        int thread, index;
+      };
+
+      static const char* vtu_byte_order()
+      {
+        const unsigned short one = 1;
+        return *((const unsigned char*)&one) == 1 ? "LittleEndian" : "BigEndian";
+      }
+
+      static const char* vtu_type_name(float*) { return "Float32"; }
+      static const char* vtu_type_name(double*) { return "Float64"; }
+
+      /// Compresses the array in the layout of vtkZLibDataCompressor.
+      /// Header: [number of blocks, block size, size of the last (partial) block, compressed sizes of the blocks], then the blocks.
+      static void vtu_compress(VTUDataArray& array)
+      {
+#ifdef WITH_ZLIB
+        // The blocks may span more parts, gather them first.
+        std::vector<char> gathered;
+        const char* data;
+        if (array.parts.size() == 1)
+          data = array.parts[0].first;
+        else
+        {
+          gathered.resize(array.size);
+          size_t position = 0;
+          for (size_t i = 0; i < array.parts.size(); i++)
+          {
+            memcpy(&gathered[position], array.parts[i].first, array.parts[i].second);
+            position += array.parts[i].second;
+          }
+          data = gathered.empty() ? nullptr : &gathered[0];
+        }
+
+        unsigned long long num_blocks = (array.size + H2D_VTU_ZLIB_BLOCK_SIZE - 1) / H2D_VTU_ZLIB_BLOCK_SIZE;
+        std::vector<unsigned long long> header(3 + num_blocks);
+        header[0] = num_blocks;
+        header[1] = H2D_VTU_ZLIB_BLOCK_SIZE;
+        header[2] = array.size % H2D_VTU_ZLIB_BLOCK_SIZE;
+
+        size_t header_size = header.size() * sizeof(unsigned long long);
+        array.encoded.resize(header_size + num_blocks * compressBound(H2D_VTU_ZLIB_BLOCK_SIZE));
+        size_t position = header_size;
+        for (size_t block = 0; block < num_blocks; block++)
+        {
+          size_t block_size = std::min((size_t)H2D_VTU_ZLIB_BLOCK_SIZE, (size_t)(array.size - block * H2D_VTU_ZLIB_BLOCK_SIZE));
+          uLongf compressed_size = array.encoded.size() - position;
+          if (compress2(&array.encoded[position], &compressed_size, (const Bytef*)data + block * H2D_VTU_ZLIB_BLOCK_SIZE, block_size, Z_DEFAULT_COMPRESSION) != Z_OK)
+            throw Exceptions::Exception("zlib compression of the VTU array %s failed.", array.name);
+          header[3 + block] = compressed_size;
+          position += compressed_size;
+        }
+        array.encoded.resize(position);
+        memcpy(&array.encoded[0], &header[0], header_size);
+#else
+        throw Exceptions::Exception("Compressed VTU output requires Hermes built WITH_ZLIB.");
+#endif
+      }
+
+      /// Size of the array in the appended section.
+      static size_t vtu_appended_size(const VTUDataArray& array, bool compress)
+      {
+        return compress ? array.encoded.size() : sizeof(unsigned long long) + array.size;
+      }
+
+      /// Writes the array to the appended section.
+      static void vtu_write_appended(FILE* f, const VTUDataArray& array, bool compress)
+      {
+        if (compress)
+        {
+          if (!array.encoded.empty())
+            fwrite(&array.encoded[0], 1, array.encoded.size(), f);
+        }
+        else
+        {
+          unsigned long long size = array.size;
+          fwrite(&size, sizeof(unsigned long long), 1, f);
+          for (size_t i = 0; i < array.parts.size(); i++)
+            fwrite(array.parts[i].first, 1, array.parts[i].second, f);
+        }
+      }
+
+      /// Appends the array (as written to the appended section) to buffer.
+      static void vtu_append(std::vector<unsigned char>& buffer, const VTUDataArray& array, bool compress)
+      {
+        if (compress)
+          buffer.insert(buffer.end(), array.encoded.begin(), array.encoded.end());
+        else
+        {
+          unsigned long long size = array.size;
+          buffer.insert(buffer.end(), (const unsigned char*)&size, (const unsigned char*)&size + sizeof(unsigned long long));
+          for (size_t i = 0; i < array.parts.size(); i++)
+            buffer.insert(buffer.end(), (const unsigned char*)array.parts[i].first, (const unsigned char*)array.parts[i].first + array.parts[i].second);
+        }
+      }
+
+      /// Splits filename to the name without extension and the same relative to the directory of filename.
+      static void vtu_base_names(const char* filename, const char* extension, std::string& base_name, std::string& base_name_relative)
+      {
+        base_name = filename;
+        size_t extension_length = strlen(extension);
+        if (base_name.size() > extension_length && base_name.compare(base_name.size() - extension_length, extension_length, extension) == 0)
+          base_name.erase(base_name.size() - extension_length);
+        size_t directory_end = base_name.find_last_of("/\\");
+        base_name_relative = directory_end == std::string::npos ? base_name : base_name.substr(directory_end + 1);
+      }
+
+      static void vtu_write_data_array_header(FILE* f, const VTUDataArray& array, bool with_name, size_t offset)
+      {
+        fprintf(f, "        <DataArray type=\"%s\"", array.type);
+        if (with_name)
+          fprintf(f, " Name=\"%s\"", array.name);
+        fprintf(f, " NumberOfComponents=\"%d\" format=\"appended\" offset=\"%llu\"/>\n", array.components, (unsigned long long)offset);
+      }
+
       LinearizerCriterion::LinearizerCriterion(bool adaptive) : adaptive(adaptive)
       {
       }
@@ -41,7 +205,8 @@ namespace Hermes
 
       template<typename LinearizerDataDimensions>
       LinearizerMultidimensional<LinearizerDataDimensions>::LinearizerMultidimensional(LinearizerOutputType linearizerOutputType) :
-        states(nullptr), num_states(0), dmult(1.0), curvature_epsilon(1e-5), linearizerOutputType(linearizerOutputType), criterion(LinearizerCriterionFixed(1))
+        states(nullptr), num_states(0), dmult(1.0), curvature_epsilon(1e-5), linearizerOutputType(linearizerOutputType), criterion(LinearizerCriterionFixed(1)),
+        vertex_merging(true), frozen_topology(false), topology_recorded(false), topology_reused(false), pvd_geometry_compressed(false)
       {
         xdisp = nullptr;
         user_xdisp = false;
@@ -68,12 +233,63 @@ namespace Hermes
       void LinearizerMultidimensional<LinearizerDataDimensions>::set_criterion(LinearizerCriterion criterion)
       {
         this->criterion = criterion;
+        // The recorded topology has been refined with the previous setting.
+        this->topology_recorded = false;
       }
 
       template<typename LinearizerDataDimensions>
       void LinearizerMultidimensional<LinearizerDataDimensions>::set_curvature_epsilon(double curvature_epsilon)
       {
         this->curvature_epsilon = curvature_epsilon;
+        // The recorded topology has been refined with the previous setting.
+        this->topology_recorded = false;
+      }
+
+      template<typename LinearizerDataDimensions>
+      void LinearizerMultidimensional<LinearizerDataDimensions>::set_vertex_merging(bool vertex_merging)
+      {
+        this->vertex_merging = vertex_merging;
+      }
+
+      template<typename LinearizerDataDimensions>
+      void LinearizerMultidimensional<LinearizerDataDimensions>::set_frozen_topology(bool frozen_topology)
+      {
+        if (frozen_topology && this->linearizerOutputType != FileExport)
+          throw Exceptions::Exception("The topology can only be frozen in a LinearizerMultidimensional used for file export.");
+        this->frozen_topology = frozen_topology;
+        this->topology_recorded = false;
+      }
+
+      template<typename LinearizerDataDimensions>
+      bool LinearizerMultidimensional<LinearizerDataDimensions>::use_frozen_topology(MeshFunctionSharedPtr<double>* sln, int* item_)
+      {
+        std::vector<unsigned> mesh_seqs;
+        for (unsigned short i = 0; i < this->meshes.size(); i++)
+          mesh_seqs.push_back(this->meshes[i]->get_seq());
+
+        // Element orders - a changed order on the same mesh changes the refinement.
+        std::vector<std::vector<int> > elem_orders(LinearizerDataDimensions::dimension);
+        for (int k = 0; k < LinearizerDataDimensions::dimension; k++)
+        {
+          Solution<double>* solution = dynamic_cast<Solution<double>*>(sln[k].get());
+          if (solution && solution->get_type() == HERMES_SLN && solution->elem_orders)
+            elem_orders[k].assign(solution->elem_orders, solution->elem_orders + solution->get_mesh()->get_max_element_id());
+        }
+
+        bool same = this->topology_recorded && mesh_seqs == this->frozen_mesh_seqs && elem_orders == this->frozen_elem_orders && this->vertex_merging == this->frozen_vertex_merging;
+        for (int k = 0; k < LinearizerDataDimensions::dimension; k++)
+          same = same && (item_[k] == this->frozen_item[k]);
+
+        if (!same)
+        {
+          this->frozen_mesh_seqs = mesh_seqs;
+          this->frozen_elem_orders = elem_orders;
+          this->frozen_vertex_merging = this->vertex_merging;
+          for (int k = 0; k < LinearizerDataDimensions::dimension; k++)
+            this->frozen_item[k] = item_[k];
+        }
+
+        return same;
       }
 
       template<typename LinearizerDataDimensions>
@@ -157,6 +373,7 @@ namespace Hermes
       template<typename LinearizerDataDimensions>
       void LinearizerMultidimensional<LinearizerDataDimensions>::process_solution(MeshFunctionSharedPtr<double>* sln, int* item_)
       {
+        HERMES_PROFILE_REGION("Linearizer::process_solution");
         // Init the caught parallel exception message.
         this->exceptionMessageCaughtInParallelBlock.clear();
 
@@ -166,12 +383,21 @@ namespace Hermes
         // Initialization of 'global' stuff.
         this->init(sln, item_);
 
+        // Frozen topology - only the values are re-evaluated.
+        this->topology_reused = this->frozen_topology && this->use_frozen_topology(sln, item_);
+        if (!this->topology_reused)
+        {
+          this->topology_recorded = false;
+          this->pvd_geometry.clear();
+        }
+
         // Parallelization.
         Traverse trav_master(ydisp == nullptr ? (xdisp == nullptr ? 1 : 2) : (xdisp == nullptr ? 2 : 3));
         states = trav_master.get_states(this->meshes, this->num_states);
 
 #pragma omp parallel shared(trav_master) num_threads(num_threads_used)
         {
+          HERMES_PROFILE_REGION("Linearizer::process_states");
           int thread_number = omp_get_thread_num();
           int start = (this->num_states / num_threads_used) * thread_number;
           int end = (this->num_states / num_threads_used) * (thread_number + 1);
@@ -180,26 +406,45 @@ namespace Hermes
 
           try
           {
-            double max_value_for_adaptive_refinements = 0.;
+            if (this->topology_reused)
+            {
+              this->threadLinearizerMultidimensional[thread_number]->init_processing(sln, this, true);
+              for (int state_i = start; state_i < end; state_i++)
+              {
+                // Exception already thrown -> exit the loop.
+                if (!this->exceptionMessageCaughtInParallelBlock.empty())
+                  break;
+
+                this->threadLinearizerMultidimensional[thread_number]->reprocess_state(states[state_i]);
+              }
+              this->threadLinearizerMultidimensional[thread_number]->deinit_processing();
+            }
+            else
+            {
+              double max_value_for_adaptive_refinements = 0.;
 
-            this->threadLinearizerMultidimensional[thread_number]->init_processing(sln, this);
+              this->threadLinearizerMultidimensional[thread_number]->record_topology = this->frozen_topology;
+              this->threadLinearizerMultidimensional[thread_number]->init_processing(sln, this);
 
-            for (int state_i = start; state_i < end; state_i++)
-              max_value_for_adaptive_refinements = std::max(max_value_for_adaptive_refinements, this->threadLinearizerMultidimensional[thread_number]->get_max_value(states[state_i]));
+              for (int state_i = start; state_i < end; state_i++)
+                max_value_for_adaptive_refinements = std::max(max_value_for_adaptive_refinements, this->threadLinearizerMultidimensional[thread_number]->get_max_value(states[state_i]));
 
-            this->threadLinearizerMultidimensional[thread_number]->max_value_approx = max_value_for_adaptive_refinements;
+              this->threadLinearizerMultidimensional[thread_number]->max_value_approx = max_value_for_adaptive_refinements;
 
-            for (int state_i = start; state_i < end; state_i++)
-            {
-              // Exception already thrown -> exit the loop.
-              if (!this->exceptionMessageCaughtInParallelBlock.empty())
-                break;
+              for (int state_i = start; state_i < end; state_i++)
+              {
+                // Exception already thrown -> exit the loop.
+                if (!this->exceptionMessageCaughtInParallelBlock.empty())
+                  break;
 
-              Traverse::State* current_state = states[state_i];
+                Traverse::State* current_state = states[state_i];
 
-              this->threadLinearizerMultidimensional[thread_number]->process_state(current_state);
+                this->threadLinearizerMultidimensional[thread_number]->process_state(current_state);
+              }
+              if (this->linearizerOutputType == FileExport && this->vertex_merging && this->num_threads_used > 1)
+                this->threadLinearizerMultidimensional[thread_number]->calc_vertex_keys();
+              this->threadLinearizerMultidimensional[thread_number]->deinit_processing();
             }
-            this->threadLinearizerMultidimensional[thread_number]->deinit_processing();
           }
           catch (Hermes::Exceptions::Exception& e)
           {
@@ -225,7 +470,13 @@ namespace Hermes
         }
 
         // Finish.
-        this->finish(sln);
+        {
+          HERMES_PROFILE_REGION("Linearizer::finish");
+          this->finish(sln);
+        }
+
+        // The recorded topology can be reused from now on.
+        this->topology_recorded = this->frozen_topology && this->exceptionMessageCaughtInParallelBlock.empty();
 
         if (!this->exceptionMessageCaughtInParallelBlock.empty())
           throw Hermes::Exceptions::Exception(this->exceptionMessageCaughtInParallelBlock.c_str());
@@ -270,8 +521,10 @@ namespace Hermes
         if (this->exceptionMessageCaughtInParallelBlock.empty())
         {
           find_min_max();
-          // Polish triangle vertex indices for FileExport case.
-          if (this->linearizerOutputType == FileExport)
+          // Polish triangle vertex indices for FileExport case (a reused topology already has them polished).
+          if (this->linearizerOutputType == FileExport && !this->topology_reused && this->vertex_merging && this->num_threads_used > 1)
+            this->merge_thread_vertices();
+          else if (this->linearizerOutputType == FileExport && !this->topology_reused)
           {
             int running_count = 0;
             for (int i = 0; i < this->num_threads_used; i++)
@@ -297,6 +550,153 @@ namespace Hermes
         this->unlock_data();
       }
 
+      template<typename LinearizerDataDimensions>
+      void LinearizerMultidimensional<LinearizerDataDimensions>::merge_thread_vertices()
+      {
+        ThreadLinearizerMultidimensional<LinearizerDataDimensions>** thread_linearizers = this->threadLinearizerMultidimensional;
+        int num_threads = this->num_threads_used;
+
+        // 1 - representatives: the first (thread, vertex) of the same key, position and values.
+        // The keys are distributed to the threads by their value, each thread sorts its share.
+#pragma omp parallel num_threads(num_threads)
+        {
+          int thread_number = omp_get_thread_num();
+          try
+          {
+            thread_linearizers[thread_number]->vertex_representatives.resize(thread_linearizers[thread_number]->vertex_count);
+          }
+          catch (std::exception& e)
+          {
+#pragma omp critical (exceptionMessageCaughtInParallelBlock)
+            this->exceptionMessageCaughtInParallelBlock = e.what();
+          }
+        }
+        if (!this->exceptionMessageCaughtInParallelBlock.empty())
+          return;
+
+#pragma omp parallel num_threads(num_threads)
+        {
+          int thread_number = omp_get_thread_num();
+          try
+          {
+            std::vector<LinearizerMergeEntry> entries;
+            for (int i = 0; i < num_threads; i++)
+            {
+              for (int j = 0; j < thread_linearizers[i]->vertex_count; j++)
+              {
+                if (thread_linearizers[i]->vertex_keys[j] % num_threads == thread_number)
+                  entries.push_back(LinearizerMergeEntry(thread_linearizers[i]->vertex_keys[j], i, j));
+              }
+            }
+            std::sort(entries.begin(), entries.end());
+
+            for (size_t group_start = 0, group_end; group_start < entries.size(); group_start = group_end)
+            {
+              for (group_end = group_start + 1; group_end < entries.size() && entries[group_end].key == entries[group_start].key; group_end++);
+
+              for (size_t i = group_start; i < group_end; i++)
+              {
+                LinearizerMergeEntry& entry = entries[i];
+                std::pair<int, int> representative(entry.thread, entry.index);
+
+                // Vertices of one thread with the same key are already distinct (discontinuities), see get_vertex().
+                for (size_t j = group_start; j < i; j++)
+                {
+                  LinearizerMergeEntry& candidate = entries[j];
+                  if (candidate.thread != entry.thread && thread_linearizers[candidate.thread]->vertex_representatives[candidate.index] == std::pair<int, int>(candidate.thread, candidate.index)
+                    && thread_linearizers[candidate.thread]->same_vertex(candidate.index, thread_linearizers[entry.thread]->vertices[entry.index]))
+                  {
+                    representative = std::pair<int, int>(candidate.thread, candidate.index);
+                    break;
+                  }
+                }
+                thread_linearizers[entry.thread]->vertex_representatives[entry.index] = representative;
+              }
+            }
+
+            thread_linearizers[thread_number]->merged_vertex_indices.resize(thread_linearizers[thread_number]->vertex_count);
+          }
+          catch (std::exception& e)
+          {
+#pragma omp critical (exceptionMessageCaughtInParallelBlock)
+            this->exceptionMessageCaughtInParallelBlock = e.what();
+          }
+        }
+        if (!this->exceptionMessageCaughtInParallelBlock.empty())
+          return;
+
+        // 2 - merged indices, compaction of the vertices of each thread & triangle indices.
+        std::vector<int> kept_counts(num_threads), kept_offsets(num_threads);
+#pragma omp parallel num_threads(num_threads)
+        {
+          int thread_number = omp_get_thread_num();
+          ThreadLinearizerMultidimensional<LinearizerDataDimensions>* thread_linearizer = thread_linearizers[thread_number];
+
+          int kept_count = 0;
+          for (int i = 0; i < thread_linearizer->vertex_count; i++)
+          {
+            if (thread_linearizer->vertex_representatives[i].first == thread_number)
+              kept_count++;
+          }
+          kept_counts[thread_number] = kept_count;
+
+#pragma omp barrier
+#pragma omp single
+          {
+            for (int i = 1; i < num_threads; i++)
+              kept_offsets[i] = kept_offsets[i - 1] + kept_counts[i - 1];
+          }
+
+          // Kept vertices first - the representatives of the others may come from any thread.
+          int kept_i = kept_offsets[thread_number];
+          for (int i = 0; i < thread_linearizer->vertex_count; i++)
+          {
+            if (thread_linearizer->vertex_representatives[i].first == thread_number)
+              thread_linearizer->merged_vertex_indices[i] = kept_i++;
+          }
+
+#pragma omp barrier
+          for (int i = 0; i < thread_linearizer->vertex_count; i++)
+          {
+            std::pair<int, int>& representative = thread_linearizer->vertex_representatives[i];
+            if (representative.first != thread_number)
+              thread_linearizer->merged_vertex_indices[i] = thread_linearizers[representative.first]->merged_vertex_indices[representative.second];
+          }
+
+          for (int i = 0; i < thread_linearizer->triangle_count; i++)
+          {
+            for (int k = 0; k < 3; k++)
+              thread_linearizer->triangle_indices[i][k] = thread_linearizer->merged_vertex_indices[thread_linearizer->triangle_indices[i][k]];
+          }
+
+          // Frozen topology - the local indices of the kept vertices, the merged ones are skipped.
+          for (size_t i = 0; i < thread_linearizer->frozen_vertices.size(); i++)
+          {
+            int vertex_index = thread_linearizer->frozen_vertices[i];
+            thread_linearizer->frozen_vertices[i] = thread_linearizer->vertex_representatives[vertex_index].first == thread_number ? thread_linearizer->merged_vertex_indices[vertex_index] - kept_offsets[thread_number] : -1;
+          }
+
+          // In place, the new index is never larger than the old one.
+          for (int i = 0; i < thread_linearizer->vertex_count; i++)
+          {
+            if (thread_linearizer->vertex_representatives[i].first == thread_number)
+            {
+              int new_index = thread_linearizer->merged_vertex_indices[i] - kept_offsets[thread_number];
+              if (new_index != i)
+                memcpy(thread_linearizer->vertices[new_index], thread_linearizer->vertices[i], sizeof(typename LinearizerDataDimensions::vertex_t));
+            }
+          }
+        }
+
+        for (int i = 0; i < num_threads; i++)
+        {
+          thread_linearizers[i]->vertex_count = kept_counts[i];
+          thread_linearizers[i]->vertex_keys.clear();
+          thread_linearizers[i]->vertex_representatives.clear();
+          thread_linearizers[i]->merged_vertex_indices.clear();
+        }
+      }
+
       template<typename LinearizerDataDimensions>
       void LinearizerMultidimensional<LinearizerDataDimensions>::find_min_max()
       {
@@ -330,6 +730,8 @@ namespace Hermes
       {
         for (int i = 0; i < this->num_threads_used; i++)
           this->threadLinearizerMultidimensional[i]->free();
+        this->topology_recorded = false;
+        this->pvd_geometry.clear();
       }
 
       template<typename LinearizerDataDimensions>
@@ -453,6 +855,316 @@ namespace Hermes
         LinearizerMultidimensional<LinearizerDataDimensions>::save_solution_vtk(slns, items, filename, quantity_name, mode_3D);
       }
 
+      template<typename LinearizerDataDimensions>
+      void LinearizerMultidimensional<LinearizerDataDimensions>::save_vtu_piece(const char* filename, const char* quantity_name, bool mode_3D, bool compress, int thread_from, int thread_to, bool use_pvd_geometry)
+      {
+        const int dimension = LinearizerDataDimensions::dimension;
+
+        // Counts & the shift of the (global) triangle indices to the vertices of this piece.
+        int vertex_count = 0, triangle_count = 0, index_shift = 0;
+        for (int i = 0; i < thread_from; i++)
+          index_shift += this->threadLinearizerMultidimensional[i]->vertex_count;
+        for (int i = thread_from; i < thread_to; i++)
+        {
+          vertex_count += this->threadLinearizerMultidimensional[i]->vertex_count;
+          triangle_count += this->threadLinearizerMultidimensional[i]->triangle_count;
+        }
+
+        // The geometry of the current topology has already been encoded.
+        bool geometry_cached = use_pvd_geometry && !this->pvd_geometry.empty() && this->pvd_geometry_compressed == compress;
+
+        // Values & points.
+        // In the 3D scalar case, the vertices already are the (x, y, value) points.
+        bool points_in_place = (dimension == 1 && mode_3D);
+        std::vector<LINEARIZER_DATA_TYPE> values(dimension * vertex_count);
+        std::vector<LINEARIZER_DATA_TYPE> points((points_in_place || geometry_cached) ? 0 : 3 * vertex_count);
+        int vertex_i = 0;
+        for (int i = thread_from; i < thread_to; i++)
+        {
+          ThreadLinearizerMultidimensional<LinearizerDataDimensions>* thread_linearizer = this->threadLinearizerMultidimensional[i];
+          for (int j = 0; j < thread_linearizer->vertex_count; j++, vertex_i++)
+          {
+            typename LinearizerDataDimensions::vertex_t& vertex = thread_linearizer->vertices[j];
+            memcpy(&values[dimension * vertex_i], &vertex[2], dimension * sizeof(LINEARIZER_DATA_TYPE));
+            if (!points.empty())
+            {
+              points[3 * vertex_i] = vertex[0];
+              points[3 * vertex_i + 1] = vertex[1];
+              points[3 * vertex_i + 2] = 0.;
+            }
+          }
+        }
+
+        // Cells - only the first piece can use the global triangle indices directly.
+        std::vector<int> connectivity((index_shift == 0 || geometry_cached) ? 0 : 3 * triangle_count);
+        std::vector<int> offsets(geometry_cached ? 0 : triangle_count);
+        // The "5" means triangle in VTK.
+        std::vector<unsigned char> types(geometry_cached ? 0 : triangle_count, 5);
+        if (!geometry_cached)
+        {
+          int triangle_i = 0;
+          for (int i = thread_from; i < thread_to; i++)
+          {
+            ThreadLinearizerMultidimensional<LinearizerDataDimensions>* thread_linearizer = this->threadLinearizerMultidimensional[i];
+            for (int j = 0; j < thread_linearizer->triangle_count; j++, triangle_i++)
+            {
+              offsets[triangle_i] = 3 * (triangle_i + 1);
+              if (index_shift != 0)
+              {
+                for (int k = 0; k < 3; k++)
+                  connectivity[3 * triangle_i + k] = thread_linearizer->triangle_indices[j][k] - index_shift;
+              }
+            }
+          }
+        }
+
+        // Arrays, in the order of the appended section.
+        VTUDataArray arrays[5] =
+        {
+          VTUDataArray(quantity_name, vtu_type_name((LINEARIZER_DATA_TYPE*)nullptr), dimension),
+          VTUDataArray("Points", vtu_type_name((LINEARIZER_DATA_TYPE*)nullptr), 3),
+          VTUDataArray("connectivity", "Int32", 1),
+          VTUDataArray("offsets", "Int32", 1),
+          VTUDataArray("types", "UInt8", 1)
+        };
+        arrays[0].add_part(values.data(), values.size() * sizeof(LINEARIZER_DATA_TYPE));
+        if (!geometry_cached)
+        {
+          for (int i = thread_from; i < thread_to; i++)
+          {
+            ThreadLinearizerMultidimensional<LinearizerDataDimensions>* thread_linearizer = this->threadLinearizerMultidimensional[i];
+            if (points_in_place)
+              arrays[1].add_part(thread_linearizer->vertices, thread_linearizer->vertex_count * sizeof(typename LinearizerDataDimensions::vertex_t));
+            if (index_shift == 0)
+              arrays[2].add_part(thread_linearizer->triangle_indices, thread_linearizer->triangle_count * sizeof(triangle_indices_t));
+          }
+          if (!points_in_place)
+            arrays[1].add_part(points.data(), points.size() * sizeof(LINEARIZER_DATA_TYPE));
+          if (index_shift != 0)
+            arrays[2].add_part(connectivity.data(), connectivity.size() * sizeof(int));
+          arrays[3].add_part(offsets.data(), offsets.size() * sizeof(int));
+          arrays[4].add_part(types.data(), types.size() * sizeof(unsigned char));
+        }
+
+        size_t array_offsets[5];
+        size_t appended_size = 0;
+        for (int i = 0; i < 5; i++)
+        {
+          array_offsets[i] = appended_size;
+          if (i > 0 && geometry_cached)
+            appended_size += this->pvd_geometry_sizes[i - 1];
+          else
+          {
+            if (compress)
+              vtu_compress(arrays[i]);
+            appended_size += vtu_appended_size(arrays[i], compress);
+          }
+        }
+
+        // Store the geometry for the following steps.
+        if (use_pvd_geometry && !geometry_cached)
+        {
+          this->pvd_geometry.clear();
+          for (int i = 1; i < 5; i++)
+          {
+            this->pvd_geometry_sizes[i - 1] = vtu_appended_size(arrays[i], compress);
+            vtu_append(this->pvd_geometry, arrays[i], compress);
+          }
+          this->pvd_geometry_compressed = compress;
+        }
+
+        FILE* f = fopen(filename, "wb");
+        if (f == nullptr) throw Hermes::Exceptions::Exception("Could not open %s for writing.", filename);
+
+        fprintf(f, "<?xml version=\"1.0\"?>\n");
+        fprintf(f, "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\"%s>\n", vtu_byte_order(), compress ? " compressor=\"vtkZLibDataCompressor\"" : "");
+        fprintf(f, "  <UnstructuredGrid>\n");
+        fprintf(f, "    <Piece NumberOfPoints=\"%d\" NumberOfCells=\"%d\">\n", vertex_count, triangle_count);
+        fprintf(f, "      <PointData %s=\"%s\">\n", dimension == 1 ? "Scalars" : "Vectors", quantity_name);
+        vtu_write_data_array_header(f, arrays[0], true, array_offsets[0]);
+        fprintf(f, "      </PointData>\n");
+        fprintf(f, "      <Points>\n");
+        vtu_write_data_array_header(f, arrays[1], false, array_offsets[1]);
+        fprintf(f, "      </Points>\n");
+        fprintf(f, "      <Cells>\n");
+        for (int i = 2; i < 5; i++)
+          vtu_write_data_array_header(f, arrays[i], true, array_offsets[i]);
+        fprintf(f, "      </Cells>\n");
+        fprintf(f, "    </Piece>\n");
+        fprintf(f, "  </UnstructuredGrid>\n");
+        fprintf(f, "  <AppendedData encoding=\"raw\">\n   _");
+        vtu_write_appended(f, arrays[0], compress);
+        if (use_pvd_geometry)
+          fwrite(&this->pvd_geometry[0], 1, this->pvd_geometry.size(), f);
+        else
+        {
+          for (int i = 1; i < 5; i++)
+            vtu_write_appended(f, arrays[i], compress);
+        }
+        fprintf(f, "\n  </AppendedData>\n");
+        fprintf(f, "</VTKFile>\n");
+
+        fclose(f);
+      }
+
+      template<typename LinearizerDataDimensions>
+      void LinearizerMultidimensional<LinearizerDataDimensions>::save_solution_vtu(std::vector<MeshFunctionSharedPtr<double> > slns, std::vector<int> items, const char* filename, const char* quantity_name, bool mode_3D, bool compress)
+      {
+        if (this->linearizerOutputType != FileExport)
+          throw Exceptions::Exception("This LinearizerMultidimensional is not meant to be used for file export, create a new one with appropriate linearizerOutputType.");
+
+        process_solution(&slns[0], &items[0]);
+
+        this->save_vtu_piece(filename, quantity_name, mode_3D, compress, 0, this->num_threads_used);
+      }
+
+      template<typename LinearizerDataDimensions>
+      void LinearizerMultidimensional<LinearizerDataDimensions>::save_solution_vtu(MeshFunctionSharedPtr<double> sln, const char* filename, const char* quantity_name, bool mode_3D, int item, bool compress)
+      {
+        std::vector<MeshFunctionSharedPtr<double> > slns;
+        std::vector<int> items;
+        slns.push_back(sln);
+        items.push_back(item);
+        LinearizerMultidimensional<LinearizerDataDimensions>::save_solution_vtu(slns, items, filename, quantity_name, mode_3D, compress);
+      }
+
+      template<typename LinearizerDataDimensions>
+      void LinearizerMultidimensional<LinearizerDataDimensions>::save_solution_pvtu(std::vector<MeshFunctionSharedPtr<double> > slns, std::vector<int> items, const char* filename, const char* quantity_name, bool mode_3D, bool compress)
+      {
+        if (this->linearizerOutputType != FileExport)
+          throw Exceptions::Exception("This LinearizerMultidimensional is not meant to be used for file export, create a new one with appropriate linearizerOutputType.");
+
+        // The pieces have to be independent.
+        bool vertex_merging = this->vertex_merging;
+        this->vertex_merging = false;
+        try
+        {
+          process_solution(&slns[0], &items[0]);
+        }
+        catch (...)
+        {
+          this->vertex_merging = vertex_merging;
+          throw;
+        }
+        this->vertex_merging = vertex_merging;
+
+        // Pieces: filename without the extension + "_<thread>.vtu", referenced relative to the directory of filename.
+        std::string base_name, base_name_relative;
+        vtu_base_names(filename, ".pvtu", base_name, base_name_relative);
+
+        std::vector<std::string> piece_names(this->num_threads_used), piece_names_relative(this->num_threads_used);
+        for (int i = 0; i < this->num_threads_used; i++)
+        {
+          std::stringstream ss;
+          ss << "_" << i << ".vtu";
+          piece_names[i] = base_name + ss.str();
+          piece_names_relative[i] = base_name_relative + ss.str();
+        }
+
+        this->exceptionMessageCaughtInParallelBlock.clear();
+#pragma omp parallel num_threads(this->num_threads_used)
+        {
+          int thread_number = omp_get_thread_num();
+          try
+          {
+            this->save_vtu_piece(piece_names[thread_number].c_str(), quantity_name, mode_3D, compress, thread_number, thread_number + 1);
+          }
+          catch (Hermes::Exceptions::Exception& e)
+          {
+#pragma omp critical (exceptionMessageCaughtInParallelBlock)
+            this->exceptionMessageCaughtInParallelBlock = e.info();
+          }
+          catch (std::exception& e)
+          {
+#pragma omp critical (exceptionMessageCaughtInParallelBlock)
+            this->exceptionMessageCaughtInParallelBlock = e.what();
+          }
+        }
+        if (!this->exceptionMessageCaughtInParallelBlock.empty())
+          throw Hermes::Exceptions::Exception(this->exceptionMessageCaughtInParallelBlock.c_str());
+
+        FILE* f = fopen(filename, "wb");
+        if (f == nullptr) throw Hermes::Exceptions::Exception("Could not open %s for writing.", filename);
+
+        const char* type_name = vtu_type_name((LINEARIZER_DATA_TYPE*)nullptr);
+        fprintf(f, "<?xml version=\"1.0\"?>\n");
+        fprintf(f, "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\">\n", vtu_byte_order());
+        fprintf(f, "  <PUnstructuredGrid GhostLevel=\"0\">\n");
+        fprintf(f, "    <PPointData %s=\"%s\">\n", LinearizerDataDimensions::dimension == 1 ? "Scalars" : "Vectors", quantity_name);
+        fprintf(f, "      <PDataArray type=\"%s\" Name=\"%s\" NumberOfComponents=\"%d\"/>\n", type_name, quantity_name, LinearizerDataDimensions::dimension);
+        fprintf(f, "    </PPointData>\n");
+        fprintf(f, "    <PPoints>\n");
+        fprintf(f, "      <PDataArray type=\"%s\" NumberOfComponents=\"3\"/>\n", type_name);
+        fprintf(f, "    </PPoints>\n");
+        for (int i = 0; i < this->num_threads_used; i++)
+          fprintf(f, "    <Piece Source=\"%s\"/>\n", piece_names_relative[i].c_str());
+        fprintf(f, "  </PUnstructuredGrid>\n");
+        fprintf(f, "</VTKFile>\n");
+
+        fclose(f);
+      }
+
+      template<typename LinearizerDataDimensions>
+      void LinearizerMultidimensional<LinearizerDataDimensions>::save_solution_pvtu(MeshFunctionSharedPtr<double> sln, const char* filename, const char* quantity_name, bool mode_3D, int item, bool compress)
+      {
+        std::vector<MeshFunctionSharedPtr<double> > slns;
+        std::vector<int> items;
+        slns.push_back(sln);
+        items.push_back(item);
+        LinearizerMultidimensional<LinearizerDataDimensions>::save_solution_pvtu(slns, items, filename, quantity_name, mode_3D, compress);
+      }
+
+      template<typename LinearizerDataDimensions>
+      void LinearizerMultidimensional<LinearizerDataDimensions>::save_solution_pvd_step(std::vector<MeshFunctionSharedPtr<double> > slns, std::vector<int> items, const char* filename, const char* quantity_name, double time, bool compress)
+      {
+        if (this->linearizerOutputType != FileExport)
+          throw Exceptions::Exception("This LinearizerMultidimensional is not meant to be used for file export, create a new one with appropriate linearizerOutputType.");
+
+        if (!this->frozen_topology)
+          this->set_frozen_topology(true);
+
+        // New series.
+        if (this->pvd_filename != filename)
+        {
+          this->pvd_filename = filename;
+          this->pvd_steps.clear();
+        }
+
+        process_solution(&slns[0], &items[0]);
+
+        std::string base_name, base_name_relative;
+        vtu_base_names(filename, ".pvd", base_name, base_name_relative);
+        std::stringstream ss;
+        ss << "_" << this->pvd_steps.size() << ".vtu";
+
+        this->save_vtu_piece((base_name + ss.str()).c_str(), quantity_name, false, compress, 0, this->num_threads_used, true);
+        this->pvd_steps.push_back(std::pair<double, std::string>(time, base_name_relative + ss.str()));
+
+        // The collection is rewritten with every step, so that it is complete even if the computation does not finish.
+        FILE* f = fopen(filename, "wb");
+        if (f == nullptr) throw Hermes::Exceptions::Exception("Could not open %s for writing.", filename);
+
+        fprintf(f, "<?xml version=\"1.0\"?>\n");
+        fprintf(f, "<VTKFile type=\"Collection\" version=\"1.0\" byte_order=\"%s\">\n", vtu_byte_order());
+        fprintf(f, "  <Collection>\n");
+        for (size_t i = 0; i < this->pvd_steps.size(); i++)
+          fprintf(f, "    <DataSet timestep=\"%.15g\" group=\"\" part=\"0\" file=\"%s\"/>\n", this->pvd_steps[i].first, this->pvd_steps[i].second.c_str());
+        fprintf(f, "  </Collection>\n");
+        fprintf(f, "</VTKFile>\n");
+
+        fclose(f);
+      }
+
+      template<typename LinearizerDataDimensions>
+      void LinearizerMultidimensional<LinearizerDataDimensions>::save_solution_pvd_step(MeshFunctionSharedPtr<double> sln, const char* filename, const char* quantity_name, double time, int item, bool compress)
+      {
+        std::vector<MeshFunctionSharedPtr<double> > slns;
+        std::vector<int> items;
+        slns.push_back(sln);
+        items.push_back(item);
+        LinearizerMultidimensional<LinearizerDataDimensions>::save_solution_pvd_step(slns, items, filename, quantity_name, time, compress);
+      }
+
       template<typename LinearizerDataDimensions>
       void LinearizerMultidimensional<LinearizerDataDimensions>::save_solution_tecplot(std::vector<MeshFunctionSharedPtr<double> > slns, std::vector<int> items, const char* filename, std::vector<std::string> quantity_names)
       {
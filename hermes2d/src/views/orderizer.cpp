@@ -96,6 +96,73 @@ namespace Hermes
         };
       } quad_ord_simple;
 
+      /// Reference tessellation of an element - the points of the Quad2DOrd(Simple) tables together with the values
+      /// of the vertex (lowest-order) shape functions in them, the triangles, and the edges.
+      /// The vertex shape functions give the physical points of elements with straight edges without a RefMap.
+      struct OrderizerTessellation
+      {
+        unsigned char np;
+        double3* points;
+        double vertex_fns[80][H2D_MAX_NUMBER_VERTICES];
+        unsigned short num_triangles;
+        int3* triangles;
+        unsigned short num_edges;
+        int3* edges;
+      };
+
+      /// [simple (0) / full (1)][mode].
+      static OrderizerTessellation orderizer_tessellations[2][2];
+
+      static bool init_orderizer_tessellations()
+      {
+        for (int full = 0; full < 2; full++)
+        {
+          for (int mode = 0; mode < 2; mode++)
+          {
+            OrderizerTessellation& tessellation = orderizer_tessellations[full][mode];
+            tessellation.np = full ? ord_np[mode][1] : ord_np_simple[mode][1];
+            tessellation.points = full ? ord_tables[mode][1] : ord_tables_simple[mode][1];
+            tessellation.num_triangles = full ? num_elem[mode][1] : num_elem_simple[mode][1];
+            tessellation.triangles = full ? ord_elem[mode][1] : ord_elem_simple[mode][1];
+            tessellation.num_edges = full ? num_edge[mode][1] : num_edge_simple[mode][1];
+            tessellation.edges = full ? ord_edge[mode][1] : ord_edge_simple[mode][1];
+            assert(tessellation.np <= 80);
+
+            for (int i = 0; i < tessellation.np; i++)
+            {
+              double xi1 = tessellation.points[i][0], xi2 = tessellation.points[i][1];
+              if (mode == HERMES_MODE_TRIANGLE)
+              {
+                tessellation.vertex_fns[i][0] = -(xi1 + xi2) / 2.;
+                tessellation.vertex_fns[i][1] = (1. + xi1) / 2.;
+                tessellation.vertex_fns[i][2] = (1. + xi2) / 2.;
+                tessellation.vertex_fns[i][3] = 0.;
+              }
+              else
+              {
+                tessellation.vertex_fns[i][0] = (1. - xi1) * (1. - xi2) / 4.;
+                tessellation.vertex_fns[i][1] = (1. + xi1) * (1. - xi2) / 4.;
+                tessellation.vertex_fns[i][2] = (1. + xi1) * (1. + xi2) / 4.;
+                tessellation.vertex_fns[i][3] = (1. - xi1) * (1. + xi2) / 4.;
+              }
+            }
+          }
+        }
+        return true;
+      }
+
+      static bool orderizer_tessellations_initialized = init_orderizer_tessellations();
+
+      /// Inner edges are only output from one side - the one where the edge goes upwards (or to the right, if horizontal).
+      static bool orderizer_output_edge(Element* e, int edge)
+      {
+        if (e->en[edge]->bnd)
+          return true;
+        Node* v1 = e->vn[edge];
+        Node* v2 = e->vn[e->next_vert(edge)];
+        return (v1->y < v2->y) || (v1->y == v2->y && v1->x < v2->x);
+      }
+
       Orderizer::Orderizer()
       {
         verts = nullptr;
@@ -136,62 +203,24 @@ namespace Hermes
 #endif
       }
 
-      int Orderizer::add_vertex()
-      {
-        if (this->vertex_count >= this->vertex_size)
-        {
-          this->vertex_size *= 2;
-          this->verts = (double3*)realloc(verts, sizeof(double3)* vertex_size);
-          if ((!this->verts))
-          {
-            free();
-            throw Exceptions::Exception("Orderizer out of memory!");
-          }
-        }
-        return this->vertex_count++;
-      }
-
-      void Orderizer::make_vert(int & index, double x, double y, double val)
-      {
-        index = add_vertex();
-        verts[index][0] = x;
-        verts[index][1] = y;
-        verts[index][2] = val;
-      }
-
-      static const int default_allocation_multiplier_vertices = 10;
-      static const int default_allocation_multiplier_triangles = 15;
-      static const int default_allocation_multiplier_edges = 10;
-
-      static const int default_allocation_minsize_vertices = 10000;
-      static const int default_allocation_minsize_triangles = 15000;
-      static const int default_allocation_minsize_edges = 10000;
-
-      void Orderizer::reallocate(MeshSharedPtr mesh)
+      void Orderizer::reallocate(int num_vertices, int num_triangles, int num_edges, int num_labels)
       {
-        int number_of_elements = mesh->get_num_elements();
-
-        this->vertex_size = std::max(default_allocation_multiplier_vertices * number_of_elements, std::max(this->vertex_size, default_allocation_minsize_vertices));
-        this->triangle_size = std::max(default_allocation_multiplier_triangles * number_of_elements, std::max(this->triangle_size, default_allocation_minsize_triangles));
-        this->edges_size = std::max(default_allocation_multiplier_edges * number_of_elements, std::max(this->edges_size, default_allocation_minsize_edges));
+        this->vertex_size = std::max(num_vertices, this->vertex_size);
+        this->triangle_size = std::max(num_triangles, this->triangle_size);
+        this->edges_size = std::max(num_edges, this->edges_size);
+        this->label_size = std::max(num_labels, this->label_size);
 
         // Set count.
         this->vertex_count = 0;
         this->triangle_count = 0;
         this->edges_count = 0;
-
-        this->tris = (int3*)realloc(this->tris, sizeof(int3)* this->triangle_size);
-        this->tri_markers = (int*)realloc(this->tri_markers, sizeof(int)* this->triangle_size);
-        this->edges = (int2*)realloc(this->edges, sizeof(int2)* this->edges_size);
-        this->edge_markers = (int*)realloc(this->edge_markers, sizeof(int)* this->edges_size);
-
-        if (!this->tris || !this->tri_markers || !this->edges || !this->edge_markers)
-          throw Exceptions::Exception("Orderizer out of memory!");
-
-        this->label_size = std::max(this->label_size, number_of_elements + 10);
         this->label_count = 0;
 
         this->verts = realloc_with_check<Orderizer, double3>(this->verts, this->vertex_size, this);
+        this->tris = realloc_with_check<Orderizer, int3>(this->tris, this->triangle_size, this);
+        this->tri_markers = realloc_with_check<Orderizer, int>(this->tri_markers, this->triangle_size, this);
+        this->edges = realloc_with_check<Orderizer, int2>(this->edges, this->edges_size, this);
+        this->edge_markers = realloc_with_check<Orderizer, int>(this->edge_markers, this->edges_size, this);
 
         this->lvert = realloc_with_check<Orderizer, int>(this->lvert, label_size, this);
 
@@ -233,152 +262,165 @@ namespace Hermes
 
         MeshSharedPtr mesh = space->get_mesh();
 
-        // Reallocate.
-        this->reallocate(mesh);
-
-        RefMap refmap;
-
-        int oo, o[6];
-
-        // make a mesh illustrating the distribution of polynomial orders over the space
+        std::vector<Element*> elements;
         Element* e;
         for_all_active_elements(e, mesh)
+          elements.push_back(e);
+        int num_elements = elements.size();
+
+        // Sizes of the output of the elements - the reference tessellations only depend on the element mode and on
+        // the curvature (edge orders), the output can then be filled in parallel.
+        std::vector<int> vertex_offsets(num_elements + 1, 0), triangle_offsets(num_elements + 1, 0), edge_offsets(num_elements + 1, 0);
+        for (int element_i = 0; element_i < num_elements; element_i++)
         {
-          oo = o[4] = o[5] = space->get_element_order(e->id);
-          if (show_edge_orders)
-            for (unsigned int k = 0; k < e->get_nvert(); k++)
-              o[k] = space->get_edge_order(e, k);
-          else if (e->is_curved())
+          e = elements[element_i];
+          bool full = show_edge_orders || e->is_curved();
+          OrderizerTessellation& tessellation = orderizer_tessellations[full ? 1 : 0][e->get_mode()];
+
+          int num_edges = tessellation.num_edges;
+          if (full)
           {
-            if (e->is_triangle())
-              for (unsigned int k = 0; k < e->get_nvert(); k++)
-                o[k] = oo;
-            else
-              for (unsigned int k = 0; k < e->get_nvert(); k++)
-                o[k] = H2D_GET_H_ORDER(oo);
+            num_edges = 0;
+            for (int i = 0; i < tessellation.num_edges; i++)
+              if (orderizer_output_edge(e, tessellation.edges[i][2]))
+                num_edges++;
           }
 
-          double3* pt;
-          int np;
-          double* x;
-          double* y;
-          if (show_edge_orders || e->is_curved())
+          vertex_offsets[element_i + 1] = vertex_offsets[element_i] + tessellation.np;
+          triangle_offsets[element_i + 1] = triangle_offsets[element_i] + tessellation.num_triangles;
+          edge_offsets[element_i + 1] = edge_offsets[element_i] + num_edges;
+        }
+
+        // Reallocate.
+        this->reallocate(vertex_offsets[num_elements], triangle_offsets[num_elements], edge_offsets[num_elements], num_elements);
+
+        this->exceptionMessageCaughtInParallelBlock.clear();
+#pragma omp parallel num_threads(this->num_threads_used)
+        {
+          int thread_number = omp_get_thread_num();
+          int start = (num_elements / this->num_threads_used) * thread_number;
+          int end = (num_elements / this->num_threads_used) * (thread_number + 1);
+          if (thread_number == this->num_threads_used - 1)
+            end = num_elements;
+
+          try
           {
+            RefMap refmap;
             refmap.set_quad_2d(&quad_ord);
-            refmap.set_active_element(e);
-            x = refmap.get_phys_x(1);
-            y = refmap.get_phys_y(1);
 
-            pt = quad_ord.get_points(1, e->get_mode());
-            np = quad_ord.get_num_points(1, e->get_mode());
-          }
-          else
-          {
-            refmap.set_quad_2d(&quad_ord_simple);
-            refmap.set_active_element(e);
-            x = refmap.get_phys_x(1);
-            y = refmap.get_phys_y(1);
+            int oo, o[6];
+            double x_straight[80], y_straight[80];
+            for (int element_i = start; element_i < end; element_i++)
+            {
+              Element* e = elements[element_i];
+
+              // make a mesh illustrating the distribution of polynomial orders over the space
+              oo = o[4] = o[5] = space->get_element_order(e->id);
+              if (show_edge_orders)
+                for (unsigned int k = 0; k < e->get_nvert(); k++)
+                  o[k] = space->get_edge_order(e, k);
+              else if (e->is_curved())
+              {
+                if (e->is_triangle())
+                  for (unsigned int k = 0; k < e->get_nvert(); k++)
+                    o[k] = oo;
+                else
+                  for (unsigned int k = 0; k < e->get_nvert(); k++)
+                    o[k] = H2D_GET_H_ORDER(oo);
+              }
+              if (e->is_quad())
+              {
+                o[4] = H2D_GET_H_ORDER(oo);
+                o[5] = H2D_GET_V_ORDER(oo);
+              }
 
-            pt = quad_ord_simple.get_points(1, e->get_mode());
-            np = quad_ord_simple.get_num_points(1, e->get_mode());
-          }
+              bool full = show_edge_orders || e->is_curved();
+              OrderizerTessellation& tessellation = orderizer_tessellations[full ? 1 : 0][e->get_mode()];
 
-          int id[80];
-          assert(np <= 80);
+              // Physical points.
+              double* x;
+              double* y;
+              if (e->is_curved())
+              {
+                refmap.set_active_element(e);
+                x = refmap.get_phys_x(1);
+                y = refmap.get_phys_y(1);
+              }
+              else
+              {
+                for (int i = 0; i < tessellation.np; i++)
+                {
+                  x_straight[i] = y_straight[i] = 0.;
+                  for (unsigned int k = 0; k < e->get_nvert(); k++)
+                  {
+                    x_straight[i] += tessellation.vertex_fns[i][k] * e->vn[k]->x;
+                    y_straight[i] += tessellation.vertex_fns[i][k] * e->vn[k]->y;
+                  }
+                }
+                x = x_straight;
+                y = y_straight;
+              }
 
-          int mode = e->get_mode();
-          if (e->is_quad())
-          {
-            o[4] = H2D_GET_H_ORDER(oo);
-            o[5] = H2D_GET_V_ORDER(oo);
-          }
-          if (show_edge_orders || e->is_curved())
-          {
-            make_vert(lvert[label_count], x[0], y[0], o[4]);
+              // The first point is the label one, the triangles and edges index the others.
+              int vertex_offset = vertex_offsets[element_i];
+              for (int i = 0; i < tessellation.np; i++)
+              {
+                this->verts[vertex_offset + i][0] = x[i];
+                this->verts[vertex_offset + i][1] = y[i];
+                this->verts[vertex_offset + i][2] = (i == 0) ? o[4] : o[(int)tessellation.points[i][2]];
+              }
 
-            for (int i = 1; i < np; i++)
-              make_vert(id[i - 1], x[i], y[i], o[(int)pt[i][2]]);
+              int triangle_i = triangle_offsets[element_i];
+              for (int i = 0; i < tessellation.num_triangles; i++, triangle_i++)
+              {
+                for (int k = 0; k < 3; k++)
+                  this->tris[triangle_i][k] = vertex_offset + 1 + tessellation.triangles[i][k];
+                this->tri_markers[triangle_i] = e->marker;
+              }
 
-            for (int i = 0; i < num_elem[mode][1]; i++)
-              this->add_triangle(id[ord_elem[mode][1][i][0]], id[ord_elem[mode][1][i][1]], id[ord_elem[mode][1][i][2]], e->marker);
+              int edge_i = edge_offsets[element_i];
+              for (int i = 0; i < tessellation.num_edges; i++)
+              {
+                if (full && !orderizer_output_edge(e, tessellation.edges[i][2]))
+                  continue;
+                this->edges[edge_i][0] = vertex_offset + 1 + tessellation.edges[i][0];
+                this->edges[edge_i][1] = vertex_offset + 1 + tessellation.edges[i][1];
+                this->edge_markers[edge_i++] = e->en[tessellation.edges[i][2]]->marker;
+              }
 
-            for (int i = 0; i < num_edge[mode][1]; i++)
-            {
-              if (e->en[ord_edge[mode][1][i][2]]->bnd || (y[ord_edge[mode][1][i][0] + 1] < y[ord_edge[mode][1][i][1] + 1]) ||
-                ((y[ord_edge[mode][1][i][0] + 1] == y[ord_edge[mode][1][i][1] + 1]) &&
-                (x[ord_edge[mode][1][i][0] + 1] < x[ord_edge[mode][1][i][1] + 1])))
+              double xmin = 1e100, ymin = 1e100, xmax = -1e100, ymax = -1e100;
+              for (unsigned int k = 0; k < e->get_nvert(); k++)
               {
-                add_edge(id[ord_edge[mode][1][i][0]], id[ord_edge[mode][1][i][1]], e->en[ord_edge[mode][1][i][2]]->marker);
+                if (e->vn[k]->x < xmin) xmin = e->vn[k]->x;
+                if (e->vn[k]->x > xmax) xmax = e->vn[k]->x;
+                if (e->vn[k]->y < ymin) ymin = e->vn[k]->y;
+                if (e->vn[k]->y > ymax) ymax = e->vn[k]->y;
               }
+              this->lvert[element_i] = vertex_offset;
+              this->lbox[element_i][0] = xmax - xmin;
+              this->lbox[element_i][1] = ymax - ymin;
+              this->ltext[element_i] = labels[o[4]][o[5]];
             }
           }
-          else
+          catch (Hermes::Exceptions::Exception& e)
           {
-            make_vert(lvert[label_count], x[0], y[0], o[4]);
-
-            for (int i = 1; i < np; i++)
-              make_vert(id[i - 1], x[i], y[i], o[(int)pt[i][2]]);
-
-            for (int i = 0; i < num_elem_simple[mode][1]; i++)
-              this->add_triangle(id[ord_elem_simple[mode][1][i][0]], id[ord_elem_simple[mode][1][i][1]], id[ord_elem_simple[mode][1][i][2]], e->marker);
-
-            for (int i = 0; i < num_edge_simple[mode][1]; i++)
-              add_edge(id[ord_edge_simple[mode][1][i][0]], id[ord_edge_simple[mode][1][i][1]], e->en[ord_edge_simple[mode][1][i][2]]->marker);
+#pragma omp critical (exceptionMessageCaughtInParallelBlock)
+            this->exceptionMessageCaughtInParallelBlock = e.info();
           }
-
-          double xmin = 1e100, ymin = 1e100, xmax = -1e100, ymax = -1e100;
-          for (unsigned int k = 0; k < e->get_nvert(); k++)
+          catch (std::exception& e)
           {
-            if (e->vn[k]->x < xmin) xmin = e->vn[k]->x;
-            if (e->vn[k]->x > xmax) xmax = e->vn[k]->x;
-            if (e->vn[k]->y < ymin) ymin = e->vn[k]->y;
-            if (e->vn[k]->y > ymax) ymax = e->vn[k]->y;
+#pragma omp critical (exceptionMessageCaughtInParallelBlock)
+            this->exceptionMessageCaughtInParallelBlock = e.what();
           }
-          lbox[label_count][0] = xmax - xmin;
-          lbox[label_count][1] = ymax - ymin;
-          ltext[label_count++] = labels[o[4]][o[5]];
         }
 
-        refmap.set_quad_2d(&g_quad_2d_std);
-      }
-
-      void Orderizer::add_edge(int iv1, int iv2, int marker)
-      {
-#pragma omp critical(realloc_edges)
-        {
-          if (edges_count >= edges_size)
-          {
-            edges = (int2*)realloc(edges, sizeof(int2)* (edges_size * 1.5));
-            edge_markers = (int*)realloc(edge_markers, sizeof(int)* (edges_size = edges_size * 1.5));
-          }
-          edges[edges_count][0] = iv1;
-          edges[edges_count][1] = iv2;
-          edge_markers[edges_count++] = marker;
-        }
-      }
+        if (!this->exceptionMessageCaughtInParallelBlock.empty())
+          throw Hermes::Exceptions::Exception(this->exceptionMessageCaughtInParallelBlock.c_str());
 
-      void Orderizer::add_triangle(int iv0, int iv1, int iv2, int marker)
-      {
-        int index;
-#pragma omp critical(realloc_triangles)
-        {
-          if (triangle_count >= triangle_size)
-          {
-            this->triangle_size *= 2;
-            tri_markers = (int*)realloc(tri_markers, sizeof(int)* triangle_size);
-            tris = (int3*)realloc(tris, sizeof(int3)* triangle_size);
-            if ((!tri_markers) || (!this->tris))
-            {
-              free();
-              throw Exceptions::Exception("Orderizer out of memory!");
-            }
-          }
-          index = triangle_count++;
-        }
-        tris[index][0] = iv0;
-        tris[index][1] = iv1;
-        tris[index][2] = iv2;
-        tri_markers[index] = marker;
+        this->vertex_count = vertex_offsets[num_elements];
+        this->triangle_count = triangle_offsets[num_elements];
+        this->edges_count = edge_offsets[num_elements];
+        this->label_count = num_elements;
       }
 
       void Orderizer::free()
@@ -61,6 +61,10 @@ namespace Hermes
         triangle_markers = nullptr;
         hash_table = nullptr;
         info = nullptr;
+
+        record_topology = false;
+        frozen_split_position = 0;
+        frozen_vertex_position = 0;
       }
 
       template<typename LinearizerDataDimensions>
@@ -104,7 +108,7 @@ namespace Hermes
       }
 
       template<typename LinearizerDataDimensions>
-      void ThreadLinearizerMultidimensional<LinearizerDataDimensions>::init_processing(MeshFunctionSharedPtr<double>* sln, LinearizerMultidimensional<LinearizerDataDimensions>* linearizer)
+      void ThreadLinearizerMultidimensional<LinearizerDataDimensions>::init_processing(MeshFunctionSharedPtr<double>* sln, LinearizerMultidimensional<LinearizerDataDimensions>* linearizer, bool reuse_topology)
       {
         this->init_linearizer_data(linearizer);
 
@@ -148,6 +152,17 @@ namespace Hermes
           fns[LinearizerDataDimensions::dimension + (user_xdisp ? 1 : 0)]->set_quad_2d(&g_quad_lin);
         }
 
+        // Reprocessing only writes values to the existing vertices.
+        if (reuse_topology)
+        {
+          this->frozen_split_position = 0;
+          this->frozen_vertex_position = 0;
+          return;
+        }
+
+        this->frozen_splits.clear();
+        this->frozen_vertices.clear();
+
         // Init storage data & counts.
         this->reallocate(sln[0]->get_mesh());
       }
@@ -257,6 +272,97 @@ namespace Hermes
 #endif
       }
 
+      template<typename LinearizerDataDimensions>
+      void ThreadLinearizerMultidimensional<LinearizerDataDimensions>::reprocess_state(Traverse::State* current_state)
+      {
+        this->rep_element = current_state->e[0];
+        for (int k = 0; k < LinearizerDataDimensions::dimension; k++)
+        {
+          fns[k]->set_active_element(current_state->e[k]);
+          fns[k]->set_transform(current_state->sub_idx[k]);
+          fns[k]->set_quad_order(0, this->item[k]);
+          val[k] = fns[k]->get_values(component[k], value_type[k]);
+        }
+
+        for (unsigned short i = 0; i < this->rep_element->get_nvert(); i++)
+          this->set_frozen_vertex_values(val, i);
+
+        if (current_state->e[0]->is_triangle())
+          reprocess_triangle(0);
+        else
+          reprocess_quad(0);
+      }
+
+      template<typename LinearizerDataDimensions>
+      void ThreadLinearizerMultidimensional<LinearizerDataDimensions>::reprocess_triangle(int level)
+      {
+        if (!this->frozen_splits[this->frozen_split_position++])
+          return;
+
+        const double* values[LinearizerDataDimensions::dimension];
+        for (int k = 0; k < LinearizerDataDimensions::dimension; k++)
+        {
+          fns[k]->set_quad_order(1, item[k]);
+          values[k] = fns[k]->get_values(component[k], value_type[k]);
+        }
+
+        // mid-edge vertices
+        for (int v = 0; v < 3; v++)
+          this->set_frozen_vertex_values(values, tri_indices[0][v]);
+
+        // recur to sub-elements
+        for (int i = 0; i < 4; i++)
+        {
+          this->push_transforms(i);
+          reprocess_triangle(level + 1);
+          this->pop_transforms();
+        }
+      }
+
+      template<typename LinearizerDataDimensions>
+      void ThreadLinearizerMultidimensional<LinearizerDataDimensions>::reprocess_quad(int level)
+      {
+        int split = this->frozen_splits[this->frozen_split_position++];
+        if (!split)
+          return;
+
+        const double* values[LinearizerDataDimensions::dimension];
+        for (int k = 0; k < LinearizerDataDimensions::dimension; k++)
+        {
+          fns[k]->set_quad_order(1, item[k]);
+          values[k] = fns[k]->get_values(component[k], value_type[k]);
+        }
+
+        // mid-edge and mid-element vertices - the same order as in process_quad().
+        unsigned short* vertex_indices = quad_indices[0];
+        if (split != 1) this->set_frozen_vertex_values(values, vertex_indices[0]);
+        if (split != 2) this->set_frozen_vertex_values(values, vertex_indices[1]);
+        if (split != 1) this->set_frozen_vertex_values(values, vertex_indices[2]);
+        if (split != 2) this->set_frozen_vertex_values(values, vertex_indices[3]);
+        if (split == 3) this->set_frozen_vertex_values(values, vertex_indices[4]);
+
+        // recur to sub-elements
+        int first_transform = (split == 3 ? 0 : (split == 1 ? 4 : 6));
+        int transform_count = (split == 3 ? 4 : 2);
+        for (int i = first_transform; i < first_transform + transform_count; i++)
+        {
+          this->push_transforms(i);
+          reprocess_quad(level + 1);
+          this->pop_transforms();
+        }
+      }
+
+      template<typename LinearizerDataDimensions>
+      void ThreadLinearizerMultidimensional<LinearizerDataDimensions>::set_frozen_vertex_values(const double** values, unsigned short point_index)
+      {
+        int vertex_index = this->frozen_vertices[this->frozen_vertex_position++];
+        // Merged to a vertex of another thread, that one sets the values.
+        if (vertex_index < 0)
+          return;
+        for (int k = 0; k < LinearizerDataDimensions::dimension; k++)
+          this->vertices[vertex_index][2 + k] = values[k][point_index];
+      }
+
       template<typename LinearizerDataDimensions>
       void ThreadLinearizerMultidimensional<LinearizerDataDimensions>::process_triangle(int iv0, int iv1, int iv2, int level)
       {
@@ -312,6 +418,8 @@ namespace Hermes
           else
             split = (level < this->criterion.refinement_level);
         }
+        if (this->record_topology)
+          this->frozen_splits.push_back(split);
 
         // split the triangle if the error is too large, otherwise produce a linear triangle
         if (split)
@@ -431,6 +539,8 @@ namespace Hermes
           else
             split = (level < this->criterion.refinement_level ? 3 : 0);
         }
+        if (this->record_topology)
+          this->frozen_splits.push_back(split);
 
         // split the quad if the error is too large, otherwise produce two linear triangles
         if (split)
@@ -720,7 +830,11 @@ namespace Hermes
                   check_value = false;
               }
               if (check_value)
+              {
+                if (this->record_topology)
+                  this->frozen_vertices.push_back(i);
                 return i;
+              }
             }
             // note that we won't return a vertex with a different value than the required one;
             // this takes care for discontinuities in the solution, where more vertices
@@ -740,9 +854,57 @@ namespace Hermes
         this->info[i][1] = p2;
         this->info[i][2] = hash_table[index];
         this->hash_table[index] = i;
+        if (this->record_topology)
+          this->frozen_vertices.push_back(i);
         return i;
       }
 
+      /// Mixing function for the vertex keys (the finalizer of splitmix64).
+      static unsigned long long mix_vertex_key(unsigned long long key)
+      {
+        key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+        return key ^ (key >> 31);
+      }
+
+      template<typename LinearizerDataDimensions>
+      void ThreadLinearizerMultidimensional<LinearizerDataDimensions>::calc_vertex_keys()
+      {
+        // Parents always precede their children.
+        this->vertex_keys.resize(this->vertex_count);
+        for (int i = 0; i < this->vertex_count; i++)
+        {
+          int p1 = this->info[i][0], p2 = this->info[i][1];
+          // Mesh vertex - both parents are -(node id).
+          if (p1 == p2)
+            this->vertex_keys[i] = mix_vertex_key((unsigned long long)(-p1));
+          // Midpoint - the keys of the parents, independent of their order.
+          else
+          {
+            unsigned long long key1 = this->vertex_keys[p1], key2 = this->vertex_keys[p2];
+            if (key1 > key2)
+              std::swap(key1, key2);
+            this->vertex_keys[i] = mix_vertex_key(key1 ^ mix_vertex_key(key2 + 0x9e3779b97f4a7c15ULL));
+          }
+        }
+      }
+
+      template<typename LinearizerDataDimensions>
+      bool ThreadLinearizerMultidimensional<LinearizerDataDimensions>::same_vertex(int vertex_index, const typename LinearizerDataDimensions::vertex_t& vertex) const
+      {
+        if (fabs(this->vertices[vertex_index][0] - vertex[0]) > Hermes::HermesEpsilon || fabs(this->vertices[vertex_index][1] - vertex[1]) > Hermes::HermesEpsilon)
+          return false;
+
+        // Discontinuities - the same tolerance as in get_vertex().
+        for (int k = 0; k < LinearizerDataDimensions::dimension; k++)
+        {
+          double value = this->vertices[vertex_index][2 + k], other_value = vertex[2 + k];
+          if (fabs(value - other_value) > vertex_relative_tolerance * std::max(fabs(value), fabs(other_value)))
+            return false;
+        }
+        return true;
+      }
+
       template<typename LinearizerDataDimensions>
       int ThreadLinearizerMultidimensional<LinearizerDataDimensions>::add_vertex()
       {
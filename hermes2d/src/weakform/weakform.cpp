@@ -272,6 +272,21 @@ namespace Hermes
           else
             throw Exceptions::Exception("Marker not valid in assembling: %s.", form->areas[marker_i].c_str());
         }
+
+        form->integration_order_controls_internal.clear();
+        for (typename std::map<std::string, typename Form<Scalar>::IntegrationOrderControl>::const_iterator it = form->integration_order_controls.begin(); it != form->integration_order_controls.end(); ++it)
+        {
+          Mesh::MarkersConversion::IntValid marker;
+          if (surface)
+            marker = spaces[form->i]->get_mesh()->get_boundary_markers_conversion().get_internal_marker(it->first);
+          else
+            marker = spaces[form->i]->get_mesh()->get_element_markers_conversion().get_internal_marker(it->first);
+
+          if (marker.valid)
+            form->integration_order_controls_internal[marker.marker] = it->second;
+          else
+            throw Exceptions::Exception("Marker not valid in the integration order control: %s.", it->first.c_str());
+        }
       }
     }
 
@@ -346,6 +361,66 @@ namespace Hermes
       this->scaling_factor = scalingFactor;
     }
 
+    template<typename Scalar>
+    Form<Scalar>::IntegrationOrderControl::IntegrationOrderControl() : order(-1), offset(0), cap(-1)
+    {
+    }
+
+    template<typename Scalar>
+    void Form<Scalar>::set_integration_order(int order, std::string area)
+    {
+      if (area == HERMES_ANY)
+        this->integration_order_control.order = order;
+      else
+        this->integration_order_controls[area].order = order;
+    }
+
+    template<typename Scalar>
+    void Form<Scalar>::set_integration_order_offset(int offset, std::string area)
+    {
+      if (area == HERMES_ANY)
+        this->integration_order_control.offset = offset;
+      else
+        this->integration_order_controls[area].offset = offset;
+    }
+
+    template<typename Scalar>
+    void Form<Scalar>::set_integration_order_cap(int cap, std::string area)
+    {
+      if (area == HERMES_ANY)
+        this->integration_order_control.cap = cap;
+      else
+        this->integration_order_controls[area].cap = cap;
+    }
+
+    template<typename Scalar>
+    void Form<Scalar>::reset_integration_order_control()
+    {
+      this->integration_order_control = IntegrationOrderControl();
+      this->integration_order_controls.clear();
+      this->integration_order_controls_internal.clear();
+    }
+
+    template<typename Scalar>
+    void Form<Scalar>::adjust_integration_order(int& order, int marker) const
+    {
+      const IntegrationOrderControl* control = &this->integration_order_control;
+      if (!this->integration_order_controls_internal.empty())
+      {
+        typename std::map<int, IntegrationOrderControl>::const_iterator it = this->integration_order_controls_internal.find(marker);
+        if (it != this->integration_order_controls_internal.end())
+          control = &it->second;
+      }
+
+      if (control->order >= 0)
+        order = control->order;
+      order += control->offset;
+      if (control->cap >= 0 && order > control->cap)
+        order = control->cap;
+      if (order < 0)
+        order = 0;
+    }
+
     template<typename Scalar>
     void Form<Scalar>::set_ext(MeshFunctionSharedPtr<Scalar> ext)
     {
@@ -385,6 +460,8 @@ namespace Hermes
       this->scaling_factor = other_form->scaling_factor;
       this->u_ext_offset = other_form->u_ext_offset;
       this->previous_iteration_space_index = other_form->previous_iteration_space_index;
+      this->integration_order_control = other_form->integration_order_control;
+      this->integration_order_controls = other_form->integration_order_controls;
     }
 
     template<typename Scalar>
@@ -445,6 +522,19 @@ namespace Hermes
       return nullptr;
     }
 
+    template<typename Scalar>
+    AssemblyKernelType MatrixFormVol<Scalar>::get_assembly_kernel(Scalar& coefficient) const
+    {
+      return HERMES_KERNEL_NONE;
+    }
+
+    template<typename Scalar>
+    bool MatrixFormVol<Scalar>::value_batch(int n, double *wt, Func<Scalar> **u_ext, Func<double> **u, unsigned int u_count, Func<double> **v, unsigned int v_count,
+      GeomVol<double> *e, Func<Scalar> **ext, const bool* pairs, Scalar* values, unsigned int stride) const
+    {
+      return false;
+    }
+
     template<typename Scalar>
     MatrixFormSurf<Scalar>::MatrixFormSurf(unsigned int i, unsigned int j) :
       MatrixForm<Scalar>(i, j)
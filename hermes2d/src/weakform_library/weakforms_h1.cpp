@@ -15,6 +15,7 @@
 
 #include "weakform_library/weakforms_h1.h"
 #include "weakform_library/integrals_h1.h"
+#include <typeinfo>
 
 namespace Hermes
 {
@@ -161,6 +162,15 @@ namespace Hermes
         return new DefaultMatrixFormVol<Scalar>(this->i, this->j, this->areas, this->coeff, this->sym, this->gt);
       }
 
+      template<typename Scalar>
+      AssemblyKernelType DefaultMatrixFormVol<Scalar>::get_assembly_kernel(Scalar& coefficient) const
+      {
+        if (typeid(*this) != typeid(DefaultMatrixFormVol<Scalar>) || gt != HERMES_PLANAR || !coeff->is_constant())
+          return HERMES_KERNEL_NONE;
+        coefficient = coeff->value(0., 0.);
+        return HERMES_KERNEL_MASS;
+      }
+
       template<typename Scalar>
       DefaultJacobianDiffusion<Scalar>::DefaultJacobianDiffusion(int i, int j, std::string area,
         Hermes1DFunction<Scalar>* coeff,
@@ -392,6 +402,16 @@ namespace Hermes
         return new DefaultMatrixFormDiffusion<Scalar>(this->i, this->j, this->areas, this->coeff, this->sym, this->gt);
       }
 
+      template<typename Scalar>
+      AssemblyKernelType DefaultMatrixFormDiffusion<Scalar>::get_assembly_kernel(Scalar& coefficient) const
+      {
+        // value() takes the coefficient at 0 regardless of is_constant().
+        if (typeid(*this) != typeid(DefaultMatrixFormDiffusion<Scalar>) || gt != HERMES_PLANAR)
+          return HERMES_KERNEL_NONE;
+        coefficient = this->coeff->value(0.);
+        return HERMES_KERNEL_DIFFUSION;
+      }
+
       template<typename Scalar>
       DefaultJacobianAdvection<Scalar>::DefaultJacobianAdvection(int i, int j, std::string area,
         Hermes1DFunction<Scalar>* coeff1,
@@ -897,6 +897,34 @@ namespace Hermes
               for (int i = 0; i < keff_iteration_forms.size(); i++)
                 keff_iteration_forms[i]->update_keff(new_keff);
             }
+
+            template<typename Scalar>
+            DefaultWeakFormLossOperator<Scalar>::DefaultWeakFormLossOperator(const MaterialPropertyMaps& matprop, MeshSharedPtr mesh,
+              GeomType geom_type) : WeakForm<Scalar>(matprop.get_G())
+            {
+              bool2 Ss_nnz = matprop.get_scattering_multigroup_structure();
+
+              for (unsigned int gto = 0; gto < matprop.get_G(); gto++)
+              {
+                this->add_matrix_form(new DiffusionReaction::Jacobian<Scalar>(gto, matprop, mesh, geom_type));
+
+                for (unsigned int gfrom = 0; gfrom < matprop.get_G(); gfrom++)
+                  if (Ss_nnz[gto][gfrom])
+                    this->add_matrix_form(new Scattering::Jacobian<Scalar>(gto, gfrom, matprop, mesh, geom_type));
+              }
+            }
+
+            template<typename Scalar>
+            DefaultWeakFormFissionOperator<Scalar>::DefaultWeakFormFissionOperator(const MaterialPropertyMaps& matprop, MeshSharedPtr mesh,
+              GeomType geom_type) : WeakForm<Scalar>(matprop.get_G())
+            {
+              bool1 chi_nnz = matprop.get_fission_multigroup_structure();
+
+              for (unsigned int gto = 0; gto < matprop.get_G(); gto++)
+                if (chi_nnz[gto])
+                  for (unsigned int gfrom = 0; gfrom < matprop.get_G(); gfrom++)
+                    this->add_matrix_form(new FissionYield::Production<Scalar>(gto, gfrom, matprop, mesh, geom_type));
+            }
           }
         }
 
@@ -929,6 +957,8 @@ namespace Hermes
           {
             template class HERMES_API FissionYield::Jacobian < double > ;
             template class HERMES_API FissionYield::Jacobian < std::complex<double> > ;
+            template class HERMES_API FissionYield::Production < double > ;
+            template class HERMES_API FissionYield::Production < std::complex<double> > ;
             template class HERMES_API FissionYield::OuterIterationForm < double > ;
             template class HERMES_API FissionYield::OuterIterationForm < std::complex<double> > ;
             template class HERMES_API FissionYield::Residual < double > ;
@@ -980,6 +1010,12 @@ namespace Hermes
 
             template class HERMES_API DefaultWeakFormSourceIteration < double > ;
             template class HERMES_API DefaultWeakFormSourceIteration < std::complex<double> > ;
+
+            template class HERMES_API DefaultWeakFormLossOperator < double > ;
+            template class HERMES_API DefaultWeakFormLossOperator < std::complex<double> > ;
+
+            template class HERMES_API DefaultWeakFormFissionOperator < double > ;
+            template class HERMES_API DefaultWeakFormFissionOperator < std::complex<double> > ;
           }
         }
       }
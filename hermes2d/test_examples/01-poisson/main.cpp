@@ -1,4 +1,5 @@
 #include "definitions.h"
+#include "performance_run.h"
 
 using namespace Hermes;
 using namespace Hermes::Hermes2D;
@@ -28,13 +29,13 @@ using namespace Hermes::Hermes2D;
 // The following parameters can be changed:
 
 // Set to "false" to suppress Hermes OpenGL visualization.
-const bool HERMES_VISUALIZATION = true;
+const bool HERMES_VISUALIZATION = performance_choice(true, false);
 // Set to "true" to enable VTK output.
 const bool VTK_VISUALIZATION = false;
 // Uniform polynomial degree of mesh elements.
 const int P_INIT = 10;
 // Number of initial uniform mesh refinements.
-const int INIT_REF_NUM = 4;
+const int INIT_REF_NUM = performance_choice(4, 5);
 
 // Problem parameters.
 // Thermal cond. of Al, Cu for temperatures around 20 deg Celsius.
@@ -46,6 +47,8 @@ const double FIXED_BDY_TEMP = 20;
 
 int main(int argc, char* argv[])
 {
+	PerformanceRun performance_run("01-poisson");
+
 	// Load the mesh.
 	MeshSharedPtr mesh(new Mesh);
 	Hermes::Hermes2D::MeshReaderH2DXML mloader;
@@ -62,6 +65,7 @@ int main(int argc, char* argv[])
 	// Initialize space.
 	SpaceSharedPtr<double> space(new Hermes::Hermes2D::H1Space<double>(mesh, &bcs, P_INIT));
 	std::cout << "Ndofs: " << space->get_num_dofs() << std::endl;
+	performance_run.record_dofs(space->get_num_dofs());
 
 	// Initialize the weak formulation.
 	WeakFormSharedPtr<double> wf(new CustomWeakFormPoisson("Aluminum", new Hermes::Hermes1DFunction<double>(LAMBDA_AL), "Copper",
@@ -80,11 +84,17 @@ int main(int argc, char* argv[])
 	Hermes::Hermes2D::Solution<double>::vector_to_solution(linear_solver.get_sln_vector(), space, sln);
 
 	// Visualize the solution.
-	Hermes::Hermes2D::Views::ScalarView viewS("Solution", new Hermes::Hermes2D::Views::WinGeom(750, 50, 600, 600));
-	viewS.get_linearizer()->set_criterion(Views::LinearizerCriterionFixed(3));
-	viewS.show(sln);
+	if (HERMES_VISUALIZATION)
+	{
+		Hermes::Hermes2D::Views::ScalarView viewS("Solution", new Hermes::Hermes2D::Views::WinGeom(750, 50, 600, 600));
+		viewS.get_linearizer()->set_criterion(Views::LinearizerCriterionFixed(3));
+		viewS.show(sln);
+
+		// Wait for view to be closed.
+		Views::View::wait();
+	}
+	else
+		performance_run.process_output(sln);
 
-	// Wait for view to be closed.
-	Views::View::wait();
-	return 0;
+	return performance_run.finish(0);
 }
\ No newline at end of file
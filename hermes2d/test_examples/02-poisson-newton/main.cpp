@@ -1,4 +1,5 @@
 #include "definitions.h"
+#include "performance_run.h"
 
 // This example shows how to use Newton (Robin) boundary conditions.
 // These conditions are used, for example, in heat transfer problems
@@ -16,13 +17,13 @@
 // The following parameters can be changed:
 
 // Set to "false" to suppress Hermes OpenGL visualization.
-const bool HERMES_VISUALIZATION = true;
+const bool HERMES_VISUALIZATION = performance_choice(true, false);
 // Set to "true" to enable VTK output.
-const bool VTK_VISUALIZATION = true;
+const bool VTK_VISUALIZATION = performance_choice(true, false);
 // Uniform polynomial degree of mesh elements.
 const int P_INIT = 5;
 // Number of initial uniform mesh refinements.
-const int INIT_REF_NUM = 0;
+const int INIT_REF_NUM = performance_choice(0, 5);
 
 // Problem parameters.
 // Thermal cond. of Al for temperatures around 20 deg Celsius.
@@ -41,6 +42,8 @@ const double BDY_C_PARAM = 20.0;
 
 int main(int argc, char* argv[])
 {
+  PerformanceRun performance_run("02-poisson-newton");
+
   // Load the mesh.
   MeshSharedPtr mesh(new Mesh);
   Hermes::Hermes2D::MeshReaderH2D mloader;
@@ -63,6 +66,7 @@ int main(int argc, char* argv[])
   // Create an H1 space with default shapeset.
   SpaceSharedPtr<double> space(new Hermes::Hermes2D::H1Space<double>(mesh, &bcs, P_INIT));
   int ndof = space->get_num_dofs();
+  performance_run.record_dofs(ndof);
 
   // Initialize the Newton solver.
   Hermes::Hermes2D::NewtonSolver<double> newton;
@@ -96,6 +100,8 @@ int main(int argc, char* argv[])
     view.show(sln);
     Hermes::Hermes2D::Views::View::wait();
   }
+  else
+    performance_run.process_output(sln);
 
-  return 0;
+  return performance_run.finish(0);
 }
\ No newline at end of file
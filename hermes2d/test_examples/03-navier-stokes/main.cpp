@@ -1,4 +1,5 @@
 #include "hermes2d.h"
+#include "performance_run.h"
 
 using namespace Hermes;
 using namespace Hermes::Hermes2D;
@@ -40,7 +41,7 @@ using namespace Hermes::Hermes2D;
 // tutorial for comparisons.
 const bool STOKES = false;
 
-const bool HERMES_VISUALIZATION = true;
+const bool HERMES_VISUALIZATION = performance_choice(true, false);
 
 #define PRESSURE_IN_L2
 
@@ -68,7 +69,9 @@ const double STARTUP_TIME = 1.0;
 // Time step.
 const double TAU = 0.1;
 // Time interval length.
-const double T_FINAL = 1000.0;
+const double T_FINAL = performance_choice(1000.0, 2.0);
+// Number of additional uniform mesh refinements.
+const int INIT_REF_NUM = performance_choice(0, 1);
 // Stopping criterion for the Newton's method.
 const double NEWTON_TOL = 1e-3;
 // Domain height (necessary to define the parabolic velocity profile at inlet).
@@ -86,6 +89,8 @@ const std::string BDY_OBSTACLE = "5";
 
 int main(int argc, char* argv[])
 {
+  PerformanceRun performance_run("03-navier-stokes");
+
   // Load the mesh.
   MeshSharedPtr mesh(new Mesh);
   MeshReaderH2D mloader;
@@ -97,6 +102,8 @@ int main(int argc, char* argv[])
   mesh->refine_towards_boundary(BDY_BOTTOM, 2, true);  // 'true' stands for anisotropic refinements.
   mesh->refine_all_elements();
   mesh->refine_all_elements();
+  for (int i = 0; i < INIT_REF_NUM; i++)
+    mesh->refine_all_elements();
 
   // Initialize boundary conditions.
   EssentialBCNonConst bc_left_vel_x(BDY_LEFT, VEL_INLET, H, STARTUP_TIME);
@@ -118,6 +125,7 @@ int main(int argc, char* argv[])
 
   // Calculate and report the number of degrees of freedom.
   int ndof = Space<double>::get_num_dofs(spaces);
+  performance_run.record_dofs(ndof);
 
   // Define projection norms.
   NormType vel_proj_norm = HERMES_H1_NORM;
@@ -184,16 +192,21 @@ int main(int argc, char* argv[])
     Hermes::Hermes2D::Solution<double>::vector_to_solutions(newton.get_sln_vector(), spaces, sln_prev_time);
 
     // Visualization.
-    vview.set_title("Velocity, time %g", current_time);
-    vview.show(xvel_prev_time, yvel_prev_time);
-    if(!(time_step % 100))
-      vview.save_numbered_screenshot("Velocity", (time_step / 100), true);
-
-    pview.set_title("Pressure, time %g", current_time);
-    pview.show(p_prev_time);
-    if (!(time_step % 100))
-      pview.save_numbered_screenshot("Pressure", (time_step / 100), true);
+    if (HERMES_VISUALIZATION)
+    {
+      vview.set_title("Velocity, time %g", current_time);
+      vview.show(xvel_prev_time, yvel_prev_time);
+      if (!(time_step % 100))
+        vview.save_numbered_screenshot("Velocity", (time_step / 100), true);
+
+      pview.set_title("Pressure, time %g", current_time);
+      pview.show(p_prev_time);
+      if (!(time_step % 100))
+        pview.save_numbered_screenshot("Pressure", (time_step / 100), true);
+    }
+    else
+      performance_run.process_output(p_prev_time);
   }
 
-  return 0;
+  return performance_run.finish(0);
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "definitions.h"
+#include "performance_run.h"
 
 typedef std::complex<double> complex;
 
@@ -15,8 +16,10 @@ typedef std::complex<double> complex;
 //  on the bottom.
 //
 //  The following parameters can be changed:
+// Set to "false" to suppress Hermes OpenGL visualization.
+const bool HERMES_VISUALIZATION = performance_choice(true, false);
 // Number of initial uniform mesh refinements.
-const int INIT_REF_NUM = 0;
+const int INIT_REF_NUM = performance_choice(0, 2);
 // Initial polynomial degree of all mesh elements.
 const int P_INIT = 1;
 // This is a quantitative parameter of Adaptivity.
@@ -43,6 +46,7 @@ const double OMEGA = 2 * M_PI * FREQ;
 
 int main(int argc, char* argv[])
 {
+  PerformanceRun performance_run("04-complex-adapt");
   Hermes::Mixins::TimeMeasurable m;
   m.tick();
 
@@ -101,6 +105,7 @@ int main(int argc, char* argv[])
     newton.set_space(ref_space);
 
     int ndof_ref = ref_space->get_num_dofs();
+    performance_run.record_dofs(ndof_ref);
 
     // Initialize reference problem.
 
@@ -119,11 +124,16 @@ int main(int argc, char* argv[])
     // View the coarse mesh solution and polynomial orders.
     MeshFunctionSharedPtr<double> real_filter(new RealFilter(sln));
     MeshFunctionSharedPtr<double> rreal_filter(new RealFilter(ref_sln));
-    sview.show(rreal_filter);
-    sview.save_numbered_screenshot("sln%02d.bmp", as, true);
+    if (HERMES_VISUALIZATION)
+    {
+      sview.show(rreal_filter);
+      sview.save_numbered_screenshot("sln%02d.bmp", as, true);
 
-    oview.show(ref_space);
-    oview.save_numbered_screenshot("refSpace%02d.bmp", as, true);
+      oview.show(ref_space);
+      oview.save_numbered_screenshot("refSpace%02d.bmp", as, true);
+    }
+    else
+      performance_run.process_output(rreal_filter);
 
     // Calculate element errors and total error estimate.
     errorCalculator.calculate_errors(sln, ref_sln);
@@ -131,8 +141,11 @@ int main(int argc, char* argv[])
 
     // Add entry to DOF and CPU convergence graphs.
     graph_dof_est.add_values(space->get_num_dofs(), errorCalculator.get_total_error_squared() * 100.);
-    sview_error.show(errorCalculator.get_errorMeshFunction());
-    sview_error.save_numbered_screenshot("errorView%02d.bmp", as, true);
+    if (HERMES_VISUALIZATION)
+    {
+      sview_error.show(errorCalculator.get_errorMeshFunction());
+      sview_error.save_numbered_screenshot("errorView%02d.bmp", as, true);
+    }
 
     // If err_est too large, adapt the mesh.
     if (errorCalculator.get_total_error_squared()  * 100. < TOTAL_ERROR_ESTIMATE_STOP)
@@ -156,12 +169,14 @@ int main(int argc, char* argv[])
   sview.set_title("Fine mesh solution");
 
   MeshFunctionSharedPtr<double> real_filter(new RealFilter(ref_sln));
-  sview.show(real_filter);
+  if (HERMES_VISUALIZATION)
+    sview.show(real_filter);
 
   m.tick();
   std::cout << m.accumulated();
 
   // Wait for all views to be closed.
-  Views::View::wait();
-  return 0;
+  if (HERMES_VISUALIZATION)
+    Views::View::wait();
+  return performance_run.finish(0);
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "hermes2d.h"
+#include "performance_run.h"
 
 using namespace Hermes;
 using namespace Hermes::Hermes2D;
@@ -25,7 +26,7 @@ typedef std::complex<double> complex;
 //  The following parameters can be changed:
 
 // Set to "false" to suppress Hermes OpenGL visualization.
-const bool HERMES_VISUALIZATION = true;
+const bool HERMES_VISUALIZATION = performance_choice(true, false);
 // Initial polynomial degree. NOTE: The meaning is different from
 // standard continuous elements in the space H1. Here, P_INIT refers
 // to the maximum poly order of the tangential component, and polynomials
@@ -33,7 +34,7 @@ const bool HERMES_VISUALIZATION = true;
 // is for Whitney elements.
 const int P_INIT = 2;
 // Number of initial uniform mesh refinements.
-const int INIT_REF_NUM = 1;
+const int INIT_REF_NUM = performance_choice(1, 3);
 
 // Error calculation & adaptivity.
 DefaultErrorCalculator<::complex, HERMES_HCURL_NORM> errorCalculator(RelativeErrorToGlobalNorm, 1);
@@ -56,6 +57,8 @@ const double LAMBDA = 1.0;
 
 int main(int argc, char* argv[])
 {
+  PerformanceRun performance_run("05-hcurl-adapt");
+
   // Load the mesh.
   MeshSharedPtr mesh(new Mesh);
   MeshReaderH2D mloader;
@@ -118,6 +121,7 @@ int main(int argc, char* argv[])
 
     newton.set_space(ref_space);
     int ndof_ref = ref_space->get_num_dofs();
+    performance_run.record_dofs(ndof_ref);
 
     // Initial coefficient vector for the Newton's method.
    ::complex* coeff_vec = new::complex[ndof_ref];
@@ -147,6 +151,8 @@ int main(int argc, char* argv[])
       ord.save_mesh_vtk(space, "mesh.vtk");
       lin.free();
     }
+    else
+      performance_run.process_output(MeshFunctionSharedPtr<double>(new RealFilter(sln)));
 
     // Calculate element errors and total error estimate.
     errorCalculator.calculate_errors(sln, sln_exact, false);
@@ -188,5 +194,5 @@ int main(int argc, char* argv[])
     // Wait for all views to be closed.
     Views::View::wait();
   }
-  return 0;
+  return performance_run.finish(0);
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "definitions.h"
+#include "performance_run.h"
 
 // This example explains how to use the multimesh adaptive hp-FEM,
 // where different physical fields (or solution components) can be
@@ -31,6 +32,8 @@
 // h-adaptivity via the CAND_LIST option, and compare the multi-mesh vs.
 // single-mesh using the MULTI parameter.
 
+// Set to "false" to suppress Hermes OpenGL visualization.
+const bool HERMES_VISUALIZATION = performance_choice(true, false);
 // Initial polynomial degree for u.
 const int P_INIT_U = 2;
 // Initial polynomial degree for v.
@@ -56,7 +59,7 @@ Adapt<double> adaptivity(&errorCalculator, &stoppingCriterion);
 // Predefined list of element refinement candidates.
 const CandList CAND_LIST = H2D_HP_ANISO;
 // Stopping criterion for adaptivity.
-const double ERR_STOP = 1e-3;
+const double ERR_STOP = performance_choice(1e-3, 2e-4);
 
 // Problem parameters.
 const double D_u = 1;
@@ -68,6 +71,8 @@ const double K = 100.;
 
 int main(int argc, char* argv[])
 {
+  PerformanceRun performance_run("06-system-adapt");
+
   // Time measurement.
   Hermes::Mixins::TimeMeasurable cpu_time;
   cpu_time.tick();
@@ -154,6 +159,7 @@ int main(int argc, char* argv[])
     newton.set_spaces(ref_spaces);
 
 	int ndof_ref = Space<double>::get_num_dofs(ref_spaces);
+    performance_run.record_dofs(ndof_ref);
 
     // Initialize reference problem.
     Hermes::Mixins::Loggable::Static::info("Solving on reference mesh.");
@@ -185,10 +191,18 @@ int main(int argc, char* argv[])
     cpu_time.tick();
 
     // View the coarse mesh solution and polynomial orders.
-    s_view_0.show(u_sln);
-    o_view_0.show(u_space);
-    s_view_1.show(v_sln);
-    o_view_1.show(v_space);
+    if (HERMES_VISUALIZATION)
+    {
+      s_view_0.show(u_sln);
+      o_view_0.show(u_space);
+      s_view_1.show(v_sln);
+      o_view_1.show(v_space);
+    }
+    else
+    {
+      performance_run.process_output(u_sln);
+      performance_run.process_output(v_sln);
+    }
 
     // Calculate element errors.
     Hermes::Mixins::Loggable::Static::info("Calculating error estimate and exact error.");
@@ -250,6 +264,7 @@ int main(int argc, char* argv[])
   Hermes::Mixins::Loggable::Static::info("Total running time: %g s", cpu_time.accumulated());
 
   // Wait for all views to be closed.
-  Views::View::wait();
-  return 0;
+  if (HERMES_VISUALIZATION)
+    Views::View::wait();
+  return performance_run.finish(0);
 }
\ No newline at end of file
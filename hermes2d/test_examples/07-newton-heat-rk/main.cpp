@@ -1,4 +1,5 @@
 #include "definitions.h"
+#include "performance_run.h"
 
 //  This example is a continuation of the example "09-timedep-basic" and it shows how
 //  to perform time integration with arbitrary Runge-Kutta methods, using Butcher's
@@ -30,10 +31,12 @@
 //
 
 //  The following parameters can be changed:
+// Set to "false" to suppress Hermes OpenGL visualization.
+const bool HERMES_VISUALIZATION = performance_choice(true, false);
 // Polynomial degree of all mesh elements.
 const int P_INIT = 1;
 // Number of initial uniform mesh refinements.
-const int INIT_REF_NUM = 3;
+const int INIT_REF_NUM = performance_choice(3, 4);
 // Number of initial uniform mesh refinements towards the boundary.
 const int INIT_REF_NUM_BDY = 2;
 // Time step in seconds.
@@ -64,9 +67,13 @@ const double HEATCAP = 1e2;
 const double RHO = 3000;
 // Length of time interval (24 hours) in seconds.
 const double T_FINAL = 86400;
+// End of the computation (the performance mode only computes the beginning of the day).
+const double T_STOP = performance_choice(T_FINAL, 1e4);
 
 int main(int argc, char* argv[])
 {
+  PerformanceRun performance_run("07-newton-heat-rk");
+
   // Choose a Butcher's table or define your own.
   ButcherTable bt(butcher_table_type);
 
@@ -85,6 +92,7 @@ int main(int argc, char* argv[])
   Hermes::Hermes2D::DefaultEssentialBCConst<double> bc_essential("Boundary_ground", TEMP_INIT);
   Hermes::Hermes2D::EssentialBCs<double> bcs(&bc_essential);
   SpaceSharedPtr<double> space(new H1Space<double>(mesh, &bcs, P_INIT));
+  performance_run.record_dofs(space->get_num_dofs());
 
   // Solution pointer.
   MeshFunctionSharedPtr<double> sln_time_prev(new ConstantSolution<double>(mesh, TEMP_INIT));
@@ -122,8 +130,13 @@ int main(int argc, char* argv[])
     // Show the new_ time level solution.
     char title[100];
     sprintf(title, "Time %3.2f s", current_time);
-    Tview.set_title(title);
-    Tview.show(sln_time_new);
+    if (HERMES_VISUALIZATION)
+    {
+      Tview.set_title(title);
+      Tview.show(sln_time_new);
+    }
+    else
+      performance_run.process_output(sln_time_new);
 
     // Copy solution for the new_ time step.
     sln_time_prev->copy(sln_time_new);
@@ -131,7 +144,8 @@ int main(int argc, char* argv[])
 	// Time error
 	if (bt.is_embedded())
 	{
-		Eview.show(time_error_fn);
+		if (HERMES_VISUALIZATION)
+			Eview.show(time_error_fn);
 		DefaultNormCalculator<double, HERMES_H1_NORM> normCalculator(1);
 		normCalculator.calculate_norm(time_error_fn);
 		double time_error_norm = normCalculator.get_total_norm_squared();
@@ -143,9 +157,10 @@ int main(int argc, char* argv[])
 
     // Increase current time and time step counter.
     current_time += time_step;
-  } while (current_time < T_FINAL);
+  } while (current_time < T_STOP);
 
   // Wait for the view to be closed.
-  Hermes::Hermes2D::Views::View::wait();
-  return 0;
+  if (HERMES_VISUALIZATION)
+    Hermes::Hermes2D::Views::View::wait();
+  return performance_run.finish(0);
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "definitions.h"
+#include "performance_run.h"
 
 //  This example solves the same nonlinear problem as the previous
 //  one but now using the Newton's method.
@@ -14,6 +15,8 @@
 //
 //  The following parameters can be changed:
 
+// Set to "false" to suppress Hermes OpenGL visualization.
+const bool HERMES_VISUALIZATION = performance_choice(true, false);
 // Initial polynomial degree.
 const int P_INIT = 2;
 // Stopping criterion for the Newton's method.
@@ -21,7 +24,7 @@ const double NEWTON_TOL = 1e-8;
 // Maximum allowed number of Newton iterations.
 const int NEWTON_MAX_ITER = 100;
 // Number of initial uniform mesh refinements.
-const int INIT_GLOB_REF_NUM = 3;
+const int INIT_GLOB_REF_NUM = performance_choice(3, 5);
 // Number of initial refinements towards boundary.
 const int INIT_BDY_REF_NUM = 4;
 
@@ -31,6 +34,8 @@ double alpha = 7.0;
 
 int main(int argc, char* argv[])
 {
+  PerformanceRun performance_run("08-nonlinearity");
+
   // Load the mesh.
   MeshSharedPtr mesh(new Mesh);
   MeshReaderH2D mloader;
@@ -48,6 +53,7 @@ int main(int argc, char* argv[])
   SpaceSharedPtr<double> space(new H1Space<double>(mesh, &bcs, P_INIT));
   int ndof = space->get_num_dofs();
   Hermes::Mixins::Loggable::Static::info("ndof: %d", ndof);
+  performance_run.record_dofs(ndof);
 
   // Initialize the weak formulation
   CustomNonlinearity lambda(alpha);
@@ -109,13 +115,19 @@ int main(int argc, char* argv[])
   delete[] coeff_vec;
 
   // Visualise the solution and mesh.
-  ScalarView s_view("Solution", new WinGeom(0, 0, 440, 350));
-  s_view.show_mesh(false);
-  s_view.show(sln);
-  OrderView o_view("Mesh", new WinGeom(450, 0, 400, 350));
-  o_view.show(space);
-
-  // Wait for all views to be closed.
-  View::wait();
-  return 0;
+  if (HERMES_VISUALIZATION)
+  {
+    ScalarView s_view("Solution", new WinGeom(0, 0, 440, 350));
+    s_view.show_mesh(false);
+    s_view.show(sln);
+    OrderView o_view("Mesh", new WinGeom(450, 0, 400, 350));
+    o_view.show(space);
+
+    // Wait for all views to be closed.
+    View::wait();
+  }
+  else
+    performance_run.process_output(sln);
+
+  return performance_run.finish(0);
 }
\ No newline at end of file
@@ -1,10 +1,14 @@
 #include "hermes2d.h"
+#include "performance_run.h"
 
 using namespace Hermes;
 using namespace Hermes::Hermes2D;
 using namespace Hermes::Hermes2D::Views;
 using namespace Hermes::Hermes2D::RefinementSelectors;
 
+// Set to "false" to suppress Hermes OpenGL visualization.
+const bool HERMES_VISUALIZATION = performance_choice(true, false);
+
 // Problem parameters.
 const double SRC = 1000.;
 const std::vector<std::string> SRC_BOUNDARY = { "0", "5" };
@@ -24,9 +28,13 @@ Adapt<double> adaptivity(&errorCalculator, &stoppingCriterion);
 H1ProjBasedSelector<double> selector(H2D_HP_ANISO);
 // Stopping criterion for adaptivity.
 const double ERR_STOP = 1e-8;
+// Maximum number of adaptivity steps (-1 for no limit) - the performance mode runs a fixed number of them.
+const int MAX_ADAPT_STEPS = performance_choice(-1, 8);
 
 int main(int argc, char* argv[])
 {
+	PerformanceRun performance_run("09b-sparkgap-adaptive");
+
 	// Load the mesh.
 	MeshSharedPtr mesh(new Mesh);
 	Hermes::Hermes2D::MeshReaderH2DXML mloader;
@@ -55,7 +63,7 @@ int main(int argc, char* argv[])
 	Hermes::Hermes2D::LinearSolver<double> linear_solver(wf, space);
 
 	adaptivity.set_space(space);
-	while (true)
+	for (int as = 1; MAX_ADAPT_STEPS == -1 || as <= MAX_ADAPT_STEPS; as++)
 	{
 		// Construct globally refined reference mesh and setup reference space.
 		Mesh::ReferenceMeshCreator ref_mesh_creator(mesh);
@@ -63,6 +71,7 @@ int main(int argc, char* argv[])
 		Space<double>::ReferenceSpaceCreator ref_space_creator(space, ref_mesh);
 		SpaceSharedPtr<double> ref_space = ref_space_creator.create_ref_space();
 		linear_solver.set_space(ref_space);
+		performance_run.record_dofs(ref_space->get_num_dofs());
 
 		// Solve the problem.
 		linear_solver.solve();
@@ -71,8 +80,13 @@ int main(int argc, char* argv[])
 		Hermes::Hermes2D::Solution<double>::vector_to_solution(linear_solver.get_sln_vector(), ref_space, ref_sln);
 
 		// Visualize the solution.
-		Oview.show(ref_space);
-		Sview.show(ref_sln);
+		if (HERMES_VISUALIZATION)
+		{
+			Oview.show(ref_space);
+			Sview.show(ref_sln);
+		}
+		else
+			performance_run.process_output(ref_sln);
 
 		// Project the reference solution to the coarse space in H1 norm for error calculation.
 		OGProjection<double>::project_global(space, ref_sln, sln);
@@ -90,6 +104,7 @@ int main(int argc, char* argv[])
 	}
 
 	// Wait for view to be closed.
-	Views::View::wait();
-	return 0;
+	if (HERMES_VISUALIZATION)
+		Views::View::wait();
+	return performance_run.finish(0);
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "definitions.h"
+#include "performance_run.h"
 
 //  This example solves a linear advection equation using Dicontinuous Galerkin (DG) method.
 //  It is intended to show how evalutation of surface matrix forms that take basis functions defined
@@ -12,8 +13,10 @@
 //
 //  The following parameters can be changed:
 
+// Set to "false" to suppress Hermes OpenGL visualization.
+const bool HERMES_VISUALIZATION = performance_choice(true, false);
 // Number of initial uniform mesh refinements.
-const int INIT_REF = 1;
+const int INIT_REF = performance_choice(1, 3);
 // Initial polynomial degrees of mesh elements in vertical and horizontal directions.
 int P_INIT = 1;
 // Use Taylor shapeset - which does not have order > 2 implemented.
@@ -37,6 +40,8 @@ const double ERR_STOP = 1e-2;
 
 int main(int argc, char* args[])
 {
+  PerformanceRun performance_run("10-linear-advection-dg-adapt");
+
   // Load the mesh.
   MeshSharedPtr mesh(new Mesh);
   MeshReaderH2D mloader;
@@ -80,6 +85,7 @@ int main(int argc, char* args[])
 
     // Solve the problem on the reference space.
     linear_solver.set_space(refspace);
+    performance_run.record_dofs(refspace->get_num_dofs());
     linear_solver.solve();
 
     // Get the Hermes2D Solution object from the solution vector.
@@ -92,7 +98,10 @@ int main(int argc, char* args[])
     errorCalculator.calculate_errors(sln, refsln);
     double total_error_estimate = errorCalculator.get_total_error_squared() * 100;
 
-	view1.show(refsln);
+    if (HERMES_VISUALIZATION)
+      view1.show(refsln);
+    else
+      performance_run.process_output(refsln);
 
     std::cout << "Elements: " << ref_mesh->get_num_active_elements() << ", Error: " << total_error_estimate << "%." << std::endl;
 
@@ -106,6 +115,7 @@ int main(int argc, char* args[])
   } while (done == false);
 
   // Wait for keyboard or mouse input.
-  View::wait();
-  return 0;
+  if (HERMES_VISUALIZATION)
+    View::wait();
+  return performance_run.finish(0);
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #define HERMES_REPORT_ALL
 #define HERMES_REPORT_FILE "application.log"
 #include "definitions.h"
+#include "performance_run.h"
 
 using namespace RefinementSelectors;
 using namespace Views;
@@ -26,7 +27,7 @@ using namespace Views;
 //  The following parameters can be changed:
 
 // Hermes visualization.
-const bool HERMES_VISUALIZATION = true;
+const bool HERMES_VISUALIZATION = performance_choice(true, false);
 
 // Number of initial uniform mesh refinements.
 const int INIT_REF_NUM = 3;
@@ -55,7 +56,7 @@ Adapt<double> adaptivity(&errorCalculator, &stoppingCriterion);
 // Predefined list of element refinement candidates.
 const CandList CAND_LIST = H2D_HP_ANISO;
 // Stopping criterion for adaptivity.
-const double ERR_STOP = 5e-2;
+const double ERR_STOP = performance_choice(5e-2, 2e-2);
 
 // Newton's method
 // Stopping criterion for Newton on fine mesh->
@@ -87,6 +88,8 @@ const double heat_src = 1.0;
 
 int main(int argc, char* argv[])
 {
+  PerformanceRun performance_run("11-transient-adapt");
+
   // Choose a Butcher's table or define your own.
   ButcherTable bt(butcher_table_type);
   if (bt.is_explicit()) Hermes::Mixins::Loggable::Static::info("Using a %d-stage explicit R-K method.", bt.get_size());
@@ -175,6 +178,7 @@ int main(int argc, char* argv[])
       Space<double>::ReferenceSpaceCreator ref_space_creator(space, ref_mesh);
       SpaceSharedPtr<double> ref_space = ref_space_creator.create_ref_space();
       int ndof_ref = Space<double>::get_num_dofs(ref_space);
+      performance_run.record_dofs(ndof_ref);
 
       // Perform one Runge-Kutta time step according to the selected Butcher's table.
       try
@@ -230,6 +234,8 @@ int main(int argc, char* argv[])
         ordview.set_title(title);
         ordview.show(space);
       }
+      else
+        performance_run.process_output(sln_time_new);
     } while (done == false);
 
     sln_time_prev->copy(sln_time_new);
@@ -242,5 +248,5 @@ int main(int argc, char* argv[])
   // Wait for all views to be closed.
   if (HERMES_VISUALIZATION)
     View::wait();
-  return 0;
+  return performance_run.finish(0);
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #define HERMES_REPORT_ALL
 #define HERMES_REPORT_FILE "application.log"
 #include "definitions.h"
+#include "performance_run.h"
 #include "function/function.h"
 
 using namespace RefinementSelectors;
@@ -22,10 +23,12 @@ using namespace RefinementSelectors;
 //
 //  The following parameters can be changed:
 
+// Set to "false" to suppress Hermes OpenGL visualization.
+const bool HERMES_VISUALIZATION = performance_choice(true, false);
 // Initial polynomial degree.
 const int P_INIT = 2;
 // Number of initial uniform mesh refinements.
-const int INIT_GLOB_REF_NUM = 3;
+const int INIT_GLOB_REF_NUM = performance_choice(3, 5);
 // Number of initial refinements towards boundary.
 const int INIT_BDY_REF_NUM = 5;
 // Value for custom constant initial condition.
@@ -52,6 +55,8 @@ double alpha = 4.0;
 
 int main(int argc, char* argv[])
 {
+  PerformanceRun performance_run("12-picard");
+
   // Load the mesh.
   MeshSharedPtr mesh(new Mesh);
   MeshReaderH2D mloader;
@@ -69,6 +74,7 @@ int main(int argc, char* argv[])
   // Create an H1 space with default shapeset.
   SpaceSharedPtr<double> space(new H1Space<double>(mesh, &bcs, P_INIT));
   int ndof = space->get_num_dofs();
+  performance_run.record_dofs(ndof);
 
   // Initialize previous iteration solution for the Picard's method.
   MeshFunctionSharedPtr<double> sln_prev_iter(new ConstantSolution<double>(mesh, INIT_COND_CONST));
@@ -105,13 +111,19 @@ int main(int argc, char* argv[])
   Solution<double>::vector_to_solution(picard.get_sln_vector(), space, sln);
 
   // Visualise the solution and mesh.
-  ScalarView s_view("Solution", new WinGeom(0, 0, 440, 350));
-  s_view.show_mesh(false);
-  s_view.show(sln);
-  OrderView o_view("Mesh", new WinGeom(450, 0, 420, 350));
-  o_view.show(space);
-
-  // Wait for all views to be closed.
-  View::wait();
-  return 0;
+  if (HERMES_VISUALIZATION)
+  {
+    ScalarView s_view("Solution", new WinGeom(0, 0, 440, 350));
+    s_view.show_mesh(false);
+    s_view.show(sln);
+    OrderView o_view("Mesh", new WinGeom(450, 0, 420, 350));
+    o_view.show(space);
+
+    // Wait for all views to be closed.
+    View::wait();
+  }
+  else
+    performance_run.process_output(sln);
+
+  return performance_run.finish(0);
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #define HERMES_REPORT_ALL
 #include "definitions.h"
+#include "performance_run.h"
 #include "lumped_projection.h"
 #include "hp_adapt.h"
 #include "highOrder.h"
@@ -35,6 +36,8 @@ const int P_MAX = 3;
 const double time_step = 1e-3;
 // Time interval length.
 const double T_FINAL = 2 * PI;
+// End of the computation (the performance mode only computes the beginning of the revolution).
+const double T_STOP = performance_choice(T_FINAL, 0.1);
 
 //constant for the smoothness indicator (a<b => a+eps<=b)
 const double EPS_smooth = 1e-5;
@@ -92,7 +95,7 @@ const int ADAPSTEP_MAX = 5;
 
 //Visualization
 // Set to "false" to suppress Hermes OpenGL visualization.
-const bool HERMES_VISUALIZATION = true;
+const bool HERMES_VISUALIZATION = performance_choice(true, false);
 // Set to "true" to enable VTK output.
 const bool VTK_VISUALIZATION = false;
 //Every VTK_FREQth time step the solution is saved as VTK output.
@@ -104,6 +107,8 @@ const std::string BDY_OUT = "no_bdry";
 
 int main(int argc, char* argv[])
 {
+  PerformanceRun performance_run("13-FCT");
+
   // Load the mesh.
   MeshSharedPtr mesh(new Mesh), basemesh(new Mesh);
   MeshReaderH2D mloader;
@@ -239,6 +244,7 @@ int main(int argc, char* argv[])
       delete[] coeff_vec_smooth;
 
       ref_ndof = ref_space->get_num_dofs();
+      performance_run.record_dofs(ref_ndof);
 
       Hermes::Mixins::Loggable::Static::info("Visualization...");
       if (HERMES_VISUALIZATION)
@@ -324,6 +330,8 @@ int main(int argc, char* argv[])
         mview.set_title(title);
         mview.show(space);
       }
+      else
+        performance_run.process_output(ref_sln);
 
       if ((VTK_VISUALIZATION) && ((done == true) && (ts  % VTK_FREQ == 0)))
       {
@@ -349,7 +357,7 @@ int main(int argc, char* argv[])
     current_time += time_step;
     // Increase time step counter
     ts++;
-  } while (current_time < T_FINAL);
+  } while (current_time < T_STOP);
 
   // Visualize the solution.
   if (VTK_VISUALIZATION) {
@@ -362,6 +370,7 @@ int main(int argc, char* argv[])
   delete conv_matrix;
 
   // Wait for the view to be closed.
-  View::wait();
-  return 0;
+  if (HERMES_VISUALIZATION)
+    View::wait();
+  return performance_run.finish(0);
 }
\ No newline at end of file
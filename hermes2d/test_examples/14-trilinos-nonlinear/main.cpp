@@ -1,4 +1,5 @@
 #include "definitions.h"
+#include "performance_run.h"
 
 using namespace Teuchos;
 
@@ -20,7 +21,8 @@ using namespace Teuchos;
 //
 //  The following parameters can be changed:
 
-const int INIT_REF_NUM = 4;                       // Number of initial uniform mesh refinements.
+const bool HERMES_VISUALIZATION = performance_choice(true, false);  // Set to "false" to suppress Hermes OpenGL visualization.
+const int INIT_REF_NUM = performance_choice(4, 6);  // Number of initial uniform mesh refinements.
 const int P_INIT = 4;                             // Initial polynomial degree of all mesh elements.
 
 const bool JFNK = true;                          // true = jacobian-free method,
@@ -54,6 +56,8 @@ DefaultErrorCalculator<double, HERMES_H1_NORM> errorCalculator(RelativeErrorToGl
 
 int main(int argc, char* argv[])
 {
+  PerformanceRun performance_run("14-trilinos-nonlinear");
+
   // Load the mesh.
   MeshSharedPtr mesh(new Mesh);
   MeshReaderH2D mloader;
@@ -69,6 +73,7 @@ int main(int argc, char* argv[])
 
   // Create an H1 space with default shapeset.
   SpaceSharedPtr<double> space(new H1Space<double>(mesh, &bcs, P_INIT));
+  performance_run.record_dofs(space->get_num_dofs());
 
   // Perform Newton's iteration and translate the resulting coefficient vector into a Solution.
   MeshFunctionSharedPtr<double> sln(new Hermes::Hermes2D::Solution<double>());
@@ -106,10 +111,16 @@ int main(int argc, char* argv[])
   Solution<double>::vector_to_solution(nox_solver.get_sln_vector(), space, sln);
 
   // Show NOX solution.
-  Views::ScalarView view("Solution 2", new Views::WinGeom(510, 0, 500, 400));
-  view.show(sln);
+  if (HERMES_VISUALIZATION)
+  {
+    Views::ScalarView view("Solution 2", new Views::WinGeom(510, 0, 500, 400));
+    view.show(sln);
+
+    // Wait for all views to be closed.
+    Views::View::wait();
+  }
+  else
+    performance_run.process_output(sln);
 
-  // Wait for all views to be closed.
-  Views::View::wait();
-  return 0;
+  return performance_run.finish(0);
 }
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "definitions.h"
+
+template<typename Scalar>
+ParameterStudyProblem<Scalar>::ParameterStudyProblem(MeshSharedPtr base_mesh, int problem_i)
+  : mesh(new Mesh), bc("Bdy", Scalar(1.0 + problem_i)), bcs(&bc)
+{
+  // Every problem has its own mesh - meshes must not be shared by concurrently assembled problems.
+  mesh->copy(base_mesh);
+  for (int i = 0; i < 2 + problem_i % 3; i++)
+    mesh->refine_all_elements();
+
+  space = SpaceSharedPtr<Scalar>(new H1Space<Scalar>(mesh, &bcs, 2 + problem_i % 4));
+  wf = WeakFormSharedPtr<Scalar>(new WeakFormsH1::DefaultWeakFormPoisson<Scalar>(HERMES_ANY,
+    new Hermes1DFunction<Scalar>(Scalar(1.0 + 0.5 * problem_i)), new Hermes2DFunction<Scalar>(Scalar(-10.0))));
+}
+
+template<typename Scalar>
+void ParameterStudyProblem<Scalar>::solve(int num_threads)
+{
+  LinearSolver<Scalar> linear_solver(wf, space);
+  linear_solver.set_verbose_output(false);
+  linear_solver.set_num_threads(num_threads);
+  linear_solver.solve();
+
+  Scalar* sln = linear_solver.get_sln_vector();
+  sln_vector.assign(sln, sln + space->get_num_dofs());
+}
+
+template<typename Scalar>
+double compare_sln_vectors(const std::vector<Scalar>& a, const std::vector<Scalar>& b)
+{
+  if (a.size() != b.size())
+    return -1.;
+
+  double max_difference = 0.;
+  for (unsigned int i = 0; i < a.size(); i++)
+    max_difference = std::max(max_difference, std::abs(a[i] - b[i]));
+  return max_difference;
+}
+
+template class ParameterStudyProblem < double > ;
+template class ParameterStudyProblem < std::complex<double> > ;
+template double compare_sln_vectors(const std::vector<double>& a, const std::vector<double>& b);
+template double compare_sln_vectors(const std::vector<std::complex<double> >& a, const std::vector<std::complex<double> >& b);
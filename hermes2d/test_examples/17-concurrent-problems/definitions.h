@@ -0,0 +1,30 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+
+/// One independent problem of the parameter study - its own mesh, space, weak form and solver.
+template<typename Scalar>
+class ParameterStudyProblem
+{
+public:
+  /// \param[in] problem_i Index of the problem, determines the refinement and the coefficients.
+  ParameterStudyProblem(MeshSharedPtr base_mesh, int problem_i);
+
+  /// Assembles and solves, stores the solution vector.
+  void solve(int num_threads);
+
+  /// The solution vector of the last solve().
+  std::vector<Scalar> sln_vector;
+
+protected:
+  MeshSharedPtr mesh;
+  DefaultEssentialBCConst<Scalar> bc;
+  EssentialBCs<Scalar> bcs;
+  SpaceSharedPtr<Scalar> space;
+  WeakFormSharedPtr<Scalar> wf;
+};
+
+/// Largest difference of the two solution vectors, -1 if the lengths differ.
+template<typename Scalar>
+double compare_sln_vectors(const std::vector<Scalar>& a, const std::vector<Scalar>& b);
@@ -0,0 +1,203 @@
+#include "definitions.h"
+#include <thread>
+#include <atomic>
+
+// This test solves a set of independent problems (own mesh, space, weak form, solver) first serially,
+// then concurrently from several user threads, and checks that the results are identical.
+// Both real and complex problems are solved, to cover both the real and the complex matrix / vector assembling.
+// Then two problems are solved concurrently under a (tiny) memory limit of the shared precalculated tables,
+// while another thread keeps calling enforce_memory_limits() - the eviction must not hit the running assembling
+// (the results have to be the same), and has to evict once no problem is assembling.
+//
+// The following parameters can be changed:
+
+// Number of independent problems.
+const int NUM_PROBLEMS = 8;
+// Number of user threads solving the problems concurrently.
+const int NUM_USER_THREADS = 4;
+// Number of assembling threads of every problem in the concurrent run.
+const int NUM_THREADS_PER_PROBLEM = 2;
+// Number of repetitions of the concurrent run.
+const int NUM_REPETITIONS = 3;
+// Tolerance for the comparison with the serial run.
+const double TOLERANCE = 1e-10;
+// Number of problems solved concurrently under the memory limit, and the limit [bytes].
+const int NUM_EVICTION_PROBLEMS = 2;
+const size_t PRECALC_MEMORY_LIMIT = 1024;
+
+template<typename Scalar>
+bool run_study(MeshSharedPtr base_mesh)
+{
+  std::vector<ParameterStudyProblem<Scalar>*> problems;
+  for (int i = 0; i < NUM_PROBLEMS; i++)
+    problems.push_back(new ParameterStudyProblem<Scalar>(base_mesh, i));
+
+  // Reference - serial run, one thread per problem.
+  std::vector<std::vector<Scalar> > reference(NUM_PROBLEMS);
+  for (int i = 0; i < NUM_PROBLEMS; i++)
+  {
+    problems[i]->solve(1);
+    reference[i] = problems[i]->sln_vector;
+  }
+
+  bool success = true;
+  for (int repetition = 0; repetition < NUM_REPETITIONS; repetition++)
+  {
+    // Every user thread takes every NUM_USER_THREADS-th problem.
+    std::vector<std::thread> threads;
+    std::vector<std::string> errors(NUM_USER_THREADS);
+    for (int thread_i = 0; thread_i < NUM_USER_THREADS; thread_i++)
+    {
+      threads.push_back(std::thread([&problems, &errors, thread_i]()
+      {
+        try
+        {
+          for (int i = thread_i; i < NUM_PROBLEMS; i += NUM_USER_THREADS)
+            problems[i]->solve(NUM_THREADS_PER_PROBLEM);
+        }
+        catch (std::exception& e)
+        {
+          errors[thread_i] = e.what();
+        }
+      }));
+    }
+    for (int thread_i = 0; thread_i < NUM_USER_THREADS; thread_i++)
+      threads[thread_i].join();
+
+    for (int thread_i = 0; thread_i < NUM_USER_THREADS; thread_i++)
+    {
+      if (!errors[thread_i].empty())
+      {
+        std::cout << "Thread " << thread_i << " failed: " << errors[thread_i] << std::endl;
+        success = false;
+      }
+    }
+
+    for (int i = 0; i < NUM_PROBLEMS; i++)
+    {
+      double difference = compare_sln_vectors(reference[i], problems[i]->sln_vector);
+      if (difference < 0. || difference > TOLERANCE)
+      {
+        std::cout << "Repetition " << repetition << ", problem " << i << ": difference from the serial run " << difference << std::endl;
+        success = false;
+      }
+    }
+  }
+
+  for (int i = 0; i < NUM_PROBLEMS; i++)
+    delete problems[i];
+
+  return success;
+}
+
+template<typename Scalar>
+bool run_eviction_study(MeshSharedPtr base_mesh)
+{
+  std::vector<ParameterStudyProblem<Scalar>*> problems;
+  std::vector<std::vector<Scalar> > reference(NUM_EVICTION_PROBLEMS);
+  for (int i = 0; i < NUM_EVICTION_PROBLEMS; i++)
+  {
+    problems.push_back(new ParameterStudyProblem<Scalar>(base_mesh, i));
+    problems[i]->solve(1);
+    reference[i] = problems[i]->sln_vector;
+  }
+
+  bool success = true;
+  HermesCommonApi.set_memory_limit(memoryPrecalcTables, PRECALC_MEMORY_LIMIT);
+  for (int repetition = 0; repetition < NUM_REPETITIONS; repetition++)
+  {
+    // Start over with the tables filled by the serial run (or the previous repetition), i.e. over the limit.
+    if (!HermesCommonApi.memory_limit_exceeded(memoryPrecalcTables))
+    {
+      for (int i = 0; i < NUM_EVICTION_PROBLEMS; i++)
+        problems[i]->solve(1);
+    }
+
+    std::atomic<bool> solving(true);
+    unsigned int evictions_during_solving = 0;
+    std::thread evicting_thread([&solving, &evictions_during_solving]()
+    {
+      while (solving)
+        evictions_during_solving += HermesCommonApi.enforce_memory_limits();
+    });
+
+    std::vector<std::thread> threads;
+    std::vector<std::string> errors(NUM_EVICTION_PROBLEMS);
+    for (int i = 0; i < NUM_EVICTION_PROBLEMS; i++)
+    {
+      threads.push_back(std::thread([&problems, &errors, i]()
+      {
+        try
+        {
+          problems[i]->solve(NUM_THREADS_PER_PROBLEM);
+        }
+        catch (std::exception& e)
+        {
+          errors[i] = e.what();
+        }
+      }));
+    }
+    for (int i = 0; i < NUM_EVICTION_PROBLEMS; i++)
+      threads[i].join();
+    solving = false;
+    evicting_thread.join();
+
+    for (int i = 0; i < NUM_EVICTION_PROBLEMS; i++)
+    {
+      if (!errors[i].empty())
+      {
+        std::cout << "Eviction run, problem " << i << " failed: " << errors[i] << std::endl;
+        success = false;
+      }
+      double difference = compare_sln_vectors(reference[i], problems[i]->sln_vector);
+      if (difference < 0. || difference > TOLERANCE)
+      {
+        std::cout << "Eviction run " << repetition << ", problem " << i << ": difference from the serial run " << difference << std::endl;
+        success = false;
+      }
+    }
+
+    // No problem is assembling now - the tables over the limit have to go.
+    unsigned int evictions_after_solving = 0;
+    if (HermesCommonApi.memory_limit_exceeded(memoryPrecalcTables))
+    {
+      evictions_after_solving = HermesCommonApi.enforce_memory_limits();
+      if (evictions_after_solving == 0 || HermesCommonApi.memory_limit_exceeded(memoryPrecalcTables))
+      {
+        std::cout << "Eviction run " << repetition << ": the tables were not evicted after the solving" << std::endl;
+        success = false;
+      }
+    }
+    std::cout << "Eviction run " << repetition << ": " << evictions_during_solving << " eviction(s) during the solving, "
+      << evictions_after_solving << " after it" << std::endl;
+  }
+  HermesCommonApi.set_memory_limit(memoryPrecalcTables, 0);
+
+  for (int i = 0; i < NUM_EVICTION_PROBLEMS; i++)
+    delete problems[i];
+
+  return success;
+}
+
+int main(int argc, char* argv[])
+{
+  // Load the mesh - the problems make their own (refined) copies.
+  MeshSharedPtr base_mesh(new Mesh);
+  MeshReaderH2D mloader;
+  mloader.load("square.mesh", base_mesh);
+
+  bool success = run_study<double>(base_mesh);
+  success = run_study<std::complex<double> >(base_mesh) && success;
+  success = run_eviction_study<double>(base_mesh) && success;
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
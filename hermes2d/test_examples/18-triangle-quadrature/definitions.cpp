@@ -0,0 +1,115 @@
+#include "definitions.h"
+
+static double factorial(int n)
+{
+  double result = 1.;
+  for (int i = 2; i <= n; i++)
+    result *= i;
+  return result;
+}
+
+double exact_monomial_integral(int i, int j)
+{
+  // Substitution u = (1 + x) / 2, v = (1 + y) / 2 to the unit triangle,
+  // where the integral of u^i * v^j is i! * j! / (i + j + 2)!.
+  return std::pow(2., i + j + 2) * factorial(i) * factorial(j) / factorial(i + j + 2);
+}
+
+double check_triangle_rule(Quad2D* quad, int order)
+{
+  unsigned char np = quad->get_num_points(order, HERMES_MODE_TRIANGLE);
+  double3* pt = quad->get_points(order, HERMES_MODE_TRIANGLE);
+
+  if (np > H2D_MAX_INTEGRATION_POINTS_COUNT)
+    return -1.;
+
+  for (unsigned char k = 0; k < np; k++)
+  {
+    if (pt[k][0] <= -1. || pt[k][1] <= -1. || pt[k][0] + pt[k][1] >= 0.)
+      return -1.;
+    if (pt[k][2] <= 0.)
+      return -1.;
+  }
+
+  double max_error = 0.;
+  for (int i = 0; i <= order; i++)
+  {
+    for (int j = 0; i + j <= order; j++)
+    {
+      double result = 0.;
+      for (unsigned char k = 0; k < np; k++)
+        result += pt[k][2] * std::pow(1. + pt[k][0], i) * std::pow(1. + pt[k][1], j);
+      double exact = exact_monomial_integral(i, j);
+      max_error = std::max(max_error, std::abs(result - exact) / exact);
+    }
+  }
+
+  return max_error;
+}
+
+double check_triangle_edge_rules(Quad2D* quad, int order)
+{
+  double max_error = 0.;
+  for (int edge = 0; edge < 3; edge++)
+  {
+    int eo = quad->get_edge_points(edge, order, HERMES_MODE_TRIANGLE);
+    unsigned char np = quad->get_num_points(eo, HERMES_MODE_TRIANGLE);
+    double3* pt = quad->get_points(eo, HERMES_MODE_TRIANGLE);
+
+    // The edge parameter t in [0, 1] from the first vertex of the edge.
+    double2* v1 = quad->get_ref_vertex(edge, HERMES_MODE_TRIANGLE);
+    double2* v2 = quad->get_ref_vertex((edge + 1) % 3, HERMES_MODE_TRIANGLE);
+    double length_x = (*v2)[0] - (*v1)[0], length_y = (*v2)[1] - (*v1)[1];
+    for (int i = 0; i <= order; i++)
+    {
+      // Weights are for the reference interval (-1, 1), where the integral of t^i is 2 / (i + 1).
+      double result = 0.;
+      for (unsigned char k = 0; k < np; k++)
+      {
+        double t = std::abs(length_x) > std::abs(length_y) ? (pt[k][0] - (*v1)[0]) / length_x : (pt[k][1] - (*v1)[1]) / length_y;
+        result += pt[k][2] * std::pow(t, i);
+      }
+      max_error = std::max(max_error, std::abs(result - 2. / (i + 1)) * (i + 1) / 2.);
+    }
+  }
+
+  return max_error;
+}
+
+double ExternalPolynomial::value(double x, double y) const
+{
+  return x * y + x;
+}
+
+void ExternalPolynomial::derivatives(double x, double y, double& dx, double& dy) const
+{
+  dx = y + 1.;
+  dy = x;
+}
+
+Ord ExternalPolynomial::ord(double x, double y) const
+{
+  return Ord(2);
+}
+
+double ExternalVectorForm::value(int n, double *wt, Func<double> *u_ext[], Func<double> *v, GeomVol<double> *e, Func<double> **ext) const
+{
+  double result = 0.;
+  for (int i = 0; i < n; i++)
+    result += wt[i] * ext[0]->val[i] * v->val[i];
+  return result;
+}
+
+Ord ExternalVectorForm::ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *v, GeomVol<Ord> *e, Func<Ord> **ext) const
+{
+  return ext[0]->val[0] * v->val[0];
+}
+
+QuadratureWeakForm::QuadratureWeakForm(MeshSharedPtr mesh) : WeakForm<double>(1)
+{
+  add_matrix_form(new WeakFormsH1::DefaultMatrixFormVol<double>(0, 0, HERMES_ANY, new Hermes2DFunction<double>(2.0)));
+  add_matrix_form(new WeakFormsH1::DefaultMatrixFormDiffusion<double>(0, 0, HERMES_ANY, new Hermes1DFunction<double>(3.0)));
+  add_matrix_form_surf(new WeakFormsH1::DefaultMatrixFormSurf<double>(0, 0, "Bdy", new Hermes2DFunction<double>(0.5)));
+  add_vector_form(new ExternalVectorForm(0));
+  set_ext(MeshFunctionSharedPtr<double>(new ExternalPolynomial(mesh)));
+}
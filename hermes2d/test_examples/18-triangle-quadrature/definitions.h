@@ -0,0 +1,53 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+
+/// Exact integral of (1 + x)^i * (1 + y)^j over the reference triangle (-1, -1), (1, -1), (-1, 1).
+double exact_monomial_integral(int i, int j);
+
+/// Checks the volumetric triangle rule of the given order of quad:
+/// - all points strictly inside the reference triangle, all weights positive,
+/// - exact integration of all polynomials of degree <= order.
+/// \return The maximum relative error, or a negative number if the points / weights are not admissible.
+double check_triangle_rule(Quad2D* quad, int order);
+
+/// Checks the rules of all edges of the reference triangle for the given order
+/// (exact integration of all polynomials of degree <= order along the edge).
+/// \return The maximum relative error.
+double check_triangle_edge_rules(Quad2D* quad, int order);
+
+/// External function x * y + x, exactly representable by the quadratures (the form v * ext is a polynomial).
+class ExternalPolynomial : public ExactSolutionScalar<double>
+{
+public:
+  ExternalPolynomial(MeshSharedPtr mesh) : ExactSolutionScalar<double>(mesh) {};
+
+  virtual double value(double x, double y) const;
+
+  virtual void derivatives(double x, double y, double& dx, double& dy) const;
+
+  virtual Ord ord(double x, double y) const;
+
+  MeshFunction<double>* clone() const { return new ExternalPolynomial(mesh); }
+};
+
+/// \int_{area} ext[0] * v d\bfx.
+class ExternalVectorForm : public VectorFormVol<double>
+{
+public:
+  ExternalVectorForm(int i) : VectorFormVol<double>(i) {};
+
+  virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *v, GeomVol<double> *e, Func<double> **ext) const;
+
+  virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *v, GeomVol<Ord> *e, Func<Ord> **ext) const;
+
+  virtual VectorFormVol<double>* clone() const { return new ExternalVectorForm(*this); }
+};
+
+/// Mass, diffusion and boundary mass matrix, the right-hand side with the external function.
+class QuadratureWeakForm : public WeakForm<double>
+{
+public:
+  QuadratureWeakForm(MeshSharedPtr mesh);
+};
@@ -0,0 +1,117 @@
+#include "definitions.h"
+
+// This test checks the fully symmetric triangle quadrature (g_quad_2d_symmetric):
+// - for every order, all points are inside the reference triangle, all weights are positive,
+//   and all polynomials up to the order are integrated exactly,
+// - the edge rules integrate polynomials up to the order exactly,
+// - limit_order() limits the order by the maximum order of the quadrature,
+// - assembling with DiscreteProblem::set_quadrature(&g_quad_2d_symmetric) (volumetric, surface forms and an external function,
+//   on a mesh of triangles and quads) gives the same matrix and right-hand side as with g_quad_2d_std, in fewer quadrature points.
+//
+// The following parameters can be changed:
+
+// Tolerance for the relative error of the integrals.
+const double TOLERANCE = 1e-12;
+// Polynomial degree of mesh elements for the assembling comparison.
+const int P_INIT = 4;
+// Number of initial uniform mesh refinements.
+const int INIT_REF_NUM = 1;
+
+// Assembles the problem with the quadrature, returns the number of quadrature points of all form evaluations.
+unsigned long long assemble(MeshSharedPtr mesh, SpaceSharedPtr<double> space, Quad2D* quad, CSCMatrix<double>* matrix, SimpleVector<double>* rhs)
+{
+  WeakFormSharedPtr<double> wf(new QuadratureWeakForm(mesh));
+  DiscreteProblem<double> dp(wf, space, true);
+  dp.set_quadrature(quad);
+  dp.assemble(matrix, rhs);
+  return dp.get_assembly_statistics().quadrature_points;
+}
+
+// Maximum relative difference of the arrays.
+double relative_difference(const double* values, const double* reference_values, unsigned int size)
+{
+  double max_difference = 0., max_value = 0.;
+  for (unsigned int i = 0; i < size; i++)
+  {
+    max_difference = std::max(max_difference, std::abs(values[i] - reference_values[i]));
+    max_value = std::max(max_value, std::abs(reference_values[i]));
+  }
+  return max_difference / max_value;
+}
+
+int main(int argc, char* argv[])
+{
+  bool success = true;
+  Quad2D* quad = &g_quad_2d_symmetric;
+
+  if (quad->get_max_order(HERMES_MODE_TRIANGLE) < 30)
+  {
+    std::cout << "Maximum order " << quad->get_max_order(HERMES_MODE_TRIANGLE) << " is less than 30" << std::endl;
+    success = false;
+  }
+
+  for (int order = 0; order <= quad->get_max_order(HERMES_MODE_TRIANGLE); order++)
+  {
+    double error = check_triangle_rule(quad, order);
+    if (error < 0. || error > TOLERANCE)
+    {
+      std::cout << "Order " << order << ": " << (error < 0. ? "points / weights not admissible" : "not exact") << ", error " << error << std::endl;
+      success = false;
+    }
+    else
+      std::cout << "Order " << order << ": " << (int)quad->get_num_points(order, HERMES_MODE_TRIANGLE) << " points, error " << error << std::endl;
+
+    double edge_error = check_triangle_edge_rules(quad, order);
+    if (edge_error > TOLERANCE)
+    {
+      std::cout << "Order " << order << ": edge rules not exact, error " << edge_error << std::endl;
+      success = false;
+    }
+  }
+
+  int order = 2 * quad->get_max_order(HERMES_MODE_TRIANGLE);
+  limit_order_nowarn(order, HERMES_MODE_TRIANGLE, quad);
+  if (order != quad->get_max_order(HERMES_MODE_TRIANGLE))
+  {
+    std::cout << "limit_order: " << order << " instead of " << quad->get_max_order(HERMES_MODE_TRIANGLE) << std::endl;
+    success = false;
+  }
+
+  MeshSharedPtr mesh(new Mesh);
+  MeshReaderH2D mloader;
+  mloader.load("domain.mesh", mesh);
+  for (int i = 0; i < INIT_REF_NUM; i++)
+    mesh->refine_all_elements();
+  SpaceSharedPtr<double> space(new H1Space<double>(mesh, P_INIT));
+
+  CSCMatrix<double> std_matrix, symmetric_matrix;
+  SimpleVector<double> std_rhs, symmetric_rhs;
+  unsigned long long std_points = assemble(mesh, space, &g_quad_2d_std, &std_matrix, &std_rhs);
+  unsigned long long symmetric_points = assemble(mesh, space, &g_quad_2d_symmetric, &symmetric_matrix, &symmetric_rhs);
+
+  if (std_matrix.get_nnz() != symmetric_matrix.get_nnz())
+  {
+    std::cout << "Assembling: the matrices are not comparable" << std::endl;
+    success = false;
+  }
+  else
+  {
+    double matrix_difference = relative_difference(symmetric_matrix.get_Ax(), std_matrix.get_Ax(), std_matrix.get_nnz());
+    double rhs_difference = relative_difference(symmetric_rhs.v, std_rhs.v, std_rhs.get_size());
+    std::cout << "Assembling: " << symmetric_points << " quadrature points instead of " << std_points << ", relative difference of the matrix "
+      << matrix_difference << ", of the right-hand side " << rhs_difference << std::endl;
+    if (matrix_difference > TOLERANCE || rhs_difference > TOLERANCE || symmetric_points >= std_points)
+      success = false;
+  }
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,116 @@
+#include "hermes2d.h"
+#include <mpi.h>
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+
+// This test solves a Poisson problem with the distributed assembling (DiscreteProblem::set_mesh_partition()) and MUMPS,
+// by the linear and the Newton solver, and compares the solutions with the ones of the replicated assembling.
+// Every rank assembles its part of the domain, the parts of the matrix are summed by MUMPS.
+//
+// Run by: mpirun -np 4 ./19-distributed-assembly
+//
+// The following parameters can be changed:
+
+// Uniform polynomial degree of mesh elements.
+const int P_INIT = 3;
+// Number of initial uniform mesh refinements.
+const int INIT_REF_NUM = 5;
+// Tolerance for the comparison with the replicated assembling.
+const double TOLERANCE = 1e-10;
+
+double compare_sln_vectors(double* a, double* b, int ndof)
+{
+  double max_difference = 0.;
+  for (int i = 0; i < ndof; i++)
+    max_difference = std::max(max_difference, std::abs(a[i] - b[i]));
+  return max_difference;
+}
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+  int rank = MpiCommunication::get_rank();
+  bool success = true;
+
+  try
+  {
+    HermesCommonApi.set_integral_param_value(matrixSolverType, SOLVER_MUMPS);
+
+    // Every rank loads the whole mesh.
+    MeshSharedPtr mesh(new Mesh);
+    MeshReaderH2D mloader;
+    mloader.load("square.mesh", mesh);
+    for (int i = 0; i < INIT_REF_NUM; i++)
+      mesh->refine_all_elements();
+
+    DefaultEssentialBCConst<double> bc("Bdy", 1.0);
+    EssentialBCs<double> bcs(&bc);
+    SpaceSharedPtr<double> space(new H1Space<double>(mesh, &bcs, P_INIT));
+    int ndof = space->get_num_dofs();
+    WeakFormSharedPtr<double> wf(new WeakFormsH1::DefaultWeakFormPoisson<double>(HERMES_ANY,
+      new Hermes1DFunction<double>(1.0), new Hermes2DFunction<double>(-10.0)));
+
+    // Reference - the replicated assembling.
+    LinearSolver<double> reference_solver(wf, space);
+    reference_solver.set_verbose_output(false);
+    reference_solver.solve();
+    double* reference = new double[ndof];
+    memcpy(reference, reference_solver.get_sln_vector(), ndof * sizeof(double));
+
+    // Linear, distributed.
+    DiscreteProblem<double> linear_dp(wf, space, true, true, true);
+    linear_dp.set_mesh_partition(mesh);
+    LinearSolver<double> linear_solver(&linear_dp);
+    linear_solver.set_verbose_output(false);
+    linear_solver.solve();
+
+    double difference = compare_sln_vectors(reference, linear_solver.get_sln_vector(), ndof);
+    if (difference > TOLERANCE)
+    {
+      std::cout << "Rank " << rank << ": linear solver, difference from the replicated assembling " << difference << std::endl;
+      success = false;
+    }
+
+    const std::vector<unsigned int>& part_sizes = linear_dp.get_mesh_partition()->get_part_sizes();
+    std::cout << "Rank " << rank << ": " << part_sizes[rank] << " elements, " << linear_dp.get_assembly_statistics().states << " states assembled." << std::endl;
+
+    // Newton, distributed.
+    DiscreteProblem<double> newton_dp(wf, space);
+    newton_dp.set_mesh_partition(mesh);
+    NewtonSolver<double> newton_solver(&newton_dp);
+    newton_solver.set_verbose_output(false);
+    newton_solver.solve();
+
+    difference = compare_sln_vectors(reference, newton_solver.get_sln_vector(), ndof);
+    if (difference > TOLERANCE)
+    {
+      std::cout << "Rank " << rank << ": Newton solver, difference from the replicated assembling " << difference << std::endl;
+      success = false;
+    }
+
+    delete[] reference;
+  }
+  catch (std::exception& e)
+  {
+    std::cout << "Rank " << rank << ": " << e.what() << std::endl;
+    success = false;
+  }
+
+  int local_success = success ? 1 : 0, global_success;
+  MPI_Allreduce(&local_success, &global_success, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  MPI_Finalize();
+
+  if (global_success)
+  {
+    if (rank == 0)
+      std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    if (rank == 0)
+      std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,95 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+
+// This test checks the specialized assembly kernels (AssemblyKernels, DiscreteProblem::set_specialized_kernels()):
+// the mass and diffusion matrices of H1 and L2 spaces of orders 1 - 6 on a mesh of triangles and quads
+// assembled with the kernels are the same as the ones assembled by the generic path (MatrixFormVol::value()),
+// and the kernels are actually used.
+//
+// The following parameters can be changed:
+
+// Highest polynomial degree of mesh elements.
+const int P_MAX = 6;
+// Number of initial uniform mesh refinements.
+const int INIT_REF_NUM = 1;
+// Tolerance for the relative difference of the matrix entries.
+const double TOLERANCE = 1e-12;
+
+class MassDiffusionWeakForm : public WeakForm<double>
+{
+public:
+  MassDiffusionWeakForm() : WeakForm<double>(1)
+  {
+    add_matrix_form(new WeakFormsH1::DefaultMatrixFormVol<double>(0, 0, HERMES_ANY, new Hermes2DFunction<double>(2.0)));
+    add_matrix_form(new WeakFormsH1::DefaultMatrixFormDiffusion<double>(0, 0, HERMES_ANY, new Hermes1DFunction<double>(3.0)));
+  }
+};
+
+// Assembles the matrix, returns the number of kernel evaluations.
+unsigned long long assemble(SpaceSharedPtr<double> space, bool specialized_kernels, CSCMatrix<double>* matrix)
+{
+  WeakFormSharedPtr<double> wf(new MassDiffusionWeakForm());
+  DiscreteProblem<double> dp(wf, space, true);
+  dp.set_specialized_kernels(specialized_kernels);
+  dp.assemble(matrix);
+  return dp.get_assembly_statistics().kernel_evaluations;
+}
+
+// Compares the matrices, returns false if they differ.
+bool compare(SpaceSharedPtr<double> space, const char* space_name, int p)
+{
+  CSCMatrix<double> generic_matrix, kernel_matrix;
+  unsigned long long generic_evaluations = assemble(space, false, &generic_matrix);
+  unsigned long long kernel_evaluations = assemble(space, true, &kernel_matrix);
+
+  if (generic_evaluations > 0 || kernel_matrix.get_nnz() != generic_matrix.get_nnz())
+  {
+    std::cout << space_name << ", p = " << p << ": the matrices are not comparable" << std::endl;
+    return false;
+  }
+
+  double max_difference = 0., max_entry = 0.;
+  for (unsigned int i = 0; i < generic_matrix.get_nnz(); i++)
+  {
+    max_difference = std::max(max_difference, std::abs(kernel_matrix.get_Ax()[i] - generic_matrix.get_Ax()[i]));
+    max_entry = std::max(max_entry, std::abs(generic_matrix.get_Ax()[i]));
+  }
+
+  std::cout << space_name << ", p = " << p << ": " << kernel_evaluations << " kernel evaluations, relative difference " << max_difference / max_entry << std::endl;
+  return max_difference <= TOLERANCE * max_entry && kernel_evaluations > 0;
+}
+
+int main(int argc, char* argv[])
+{
+  bool success = true;
+
+  MeshSharedPtr mesh(new Mesh);
+  MeshReaderH2D mloader;
+  mloader.load("domain.mesh", mesh);
+  for (int i = 0; i < INIT_REF_NUM; i++)
+    mesh->refine_all_elements();
+
+  for (int p = 1; p <= P_MAX; p++)
+  {
+    SpaceSharedPtr<double> h1_space(new H1Space<double>(mesh, p));
+    if (!compare(h1_space, "H1", p))
+      success = false;
+
+    SpaceSharedPtr<double> l2_space(new L2Space<double>(mesh, p));
+    if (!compare(l2_space, "L2", p))
+      success = false;
+  }
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,290 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+using namespace Hermes::Hermes2D::WeakFormsExpressions;
+
+// This test checks the weak forms written as expressions (weakforms_expressions.h):
+// the matrix and the right-hand side of grad(u) * grad(v) + k(x, y) u v = f(x, y) v, written as expressions,
+// are the same as the ones of the library forms (DefaultMatrixFormDiffusion, DefaultMatrixFormVol, DefaultVectorFormVol),
+// for H1 spaces of orders 1 - 5 on a mesh of triangles and quads.
+// Then the same for the surface and interface (DG) forms of the symmetric interior penalty discretization in L2 spaces
+// (written as expressions and by hand), with the boundary value f weakly imposed and an interface source term f grad(v) n.
+//
+// The following parameters can be changed:
+
+// Highest polynomial degree of mesh elements.
+const int P_MAX = 5;
+// Number of initial uniform mesh refinements.
+const int INIT_REF_NUM = 1;
+// Tolerance for the relative difference of the matrix and right-hand side entries.
+const double TOLERANCE = 1e-12;
+// Penalty of the interior penalty forms.
+const double SIGMA = 10.;
+
+// k(x, y) = 1 + x y.
+class Reaction : public Hermes2DFunction<double>
+{
+public:
+  virtual double value(double x, double y) const { return 1. + x * y; }
+  virtual Ord value(Ord x, Ord y) const { return x * y; }
+};
+
+// f(x, y) = x^2 - y.
+class Source : public Hermes2DFunction<double>
+{
+public:
+  virtual double value(double x, double y) const { return x * x - y; }
+  virtual Ord value(Ord x, Ord y) const { return x * x; }
+};
+
+class LibraryWeakForm : public WeakForm<double>
+{
+public:
+  LibraryWeakForm(Hermes2DFunction<double>* k, Hermes2DFunction<double>* f) : WeakForm<double>(1)
+  {
+    add_matrix_form(new WeakFormsH1::DefaultMatrixFormDiffusion<double>(0, 0));
+    add_matrix_form(new WeakFormsH1::DefaultMatrixFormVol<double>(0, 0, HERMES_ANY, k));
+    add_vector_form(new WeakFormsH1::DefaultVectorFormVol<double>(0, HERMES_ANY, f));
+  }
+};
+
+class ExpressionWeakForm : public WeakForm<double>
+{
+public:
+  ExpressionWeakForm(Hermes2DFunction<double>* k, Hermes2DFunction<double>* f) : WeakForm<double>(1)
+  {
+    TrialFunction u;
+    TestFunction v;
+    add_matrix_form(make_matrix_form_vol<double>(0, 0, grad(u) * grad(v) + coefficient(k) * u * v));
+    add_vector_form(make_vector_form_vol<double>(0, coefficient(f) * v));
+  }
+};
+
+// The interior penalty forms written by hand.
+// In the interface forms, u and v are the functions of one of the elements (fn_central or not).
+template<typename Real>
+Real jump_value(DiscontinuousFunc<Real>* f, int i)
+{
+  return f->fn_central ? f->val[i] : -f->val_neighbor[i];
+}
+
+template<typename Real>
+Real average_normal_derivative(DiscontinuousFunc<Real>* f, int i, InterfaceGeom<Real>* e)
+{
+  return f->fn_central ? 0.5 * (f->dx[i] * e->nx[i] + f->dy[i] * e->ny[i]) : 0.5 * (f->dx_neighbor[i] * e->nx[i] + f->dy_neighbor[i] * e->ny[i]);
+}
+
+class HandwrittenInteriorPenaltyWeakForm : public WeakForm<double>
+{
+public:
+  HandwrittenInteriorPenaltyWeakForm(Hermes2DFunction<double>* k, Hermes2DFunction<double>* f) : WeakForm<double>(1)
+  {
+    add_matrix_form(new WeakFormsH1::DefaultMatrixFormDiffusion<double>(0, 0));
+    add_matrix_form(new WeakFormsH1::DefaultMatrixFormVol<double>(0, 0, HERMES_ANY, k));
+    add_matrix_form_surf(new MatrixSurf());
+    add_vector_form_surf(new VectorSurf(f));
+    add_matrix_form_DG(new MatrixDG());
+    add_vector_form_DG(new VectorDG(f));
+  }
+
+private:
+  class MatrixSurf : public MatrixFormSurf<double>
+  {
+  public:
+    MatrixSurf() : MatrixFormSurf<double>(0, 0) { this->set_area("Bdy"); }
+
+    virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *u, Func<double> *v, GeomSurf<double> *e, Func<double> **ext) const
+    {
+      double result = 0.;
+      for (int i = 0; i < n; i++)
+        result += wt[i] * (SIGMA * u->val[i] * v->val[i] - (u->dx[i] * e->nx[i] + u->dy[i] * e->ny[i]) * v->val[i]
+        - (v->dx[i] * e->nx[i] + v->dy[i] * e->ny[i]) * u->val[i]);
+      return result;
+    }
+
+    virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *u, Func<Ord> *v, GeomSurf<Ord> *e, Func<Ord> **ext) const
+    {
+      return u->val[0] * v->val[0];
+    }
+
+    MatrixFormSurf<double>* clone() const { return new MatrixSurf(*this); }
+  };
+
+  class VectorSurf : public VectorFormSurf<double>
+  {
+  public:
+    VectorSurf(Hermes2DFunction<double>* f) : VectorFormSurf<double>(0), f(f) { this->set_area("Bdy"); }
+
+    virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *v, GeomSurf<double> *e, Func<double> **ext) const
+    {
+      double result = 0.;
+      for (int i = 0; i < n; i++)
+        result += wt[i] * f->value(e->x[i], e->y[i]) * (SIGMA * v->val[i] - (v->dx[i] * e->nx[i] + v->dy[i] * e->ny[i]));
+      return result;
+    }
+
+    virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *v, GeomSurf<Ord> *e, Func<Ord> **ext) const
+    {
+      return v->val[0] * f->value(e->x[0], e->y[0]);
+    }
+
+    VectorFormSurf<double>* clone() const { return new VectorSurf(*this); }
+
+    Hermes2DFunction<double>* f;
+  };
+
+  class MatrixDG : public MatrixFormDG<double>
+  {
+  public:
+    MatrixDG() : MatrixFormDG<double>(0, 0) {}
+
+    virtual double value(int n, double *wt, DiscontinuousFunc<double> **u_ext, DiscontinuousFunc<double> *u, DiscontinuousFunc<double> *v, InterfaceGeom<double> *e, DiscontinuousFunc<double> **ext) const
+    {
+      double result = 0.;
+      for (int i = 0; i < n; i++)
+        result += wt[i] * (-average_normal_derivative(u, i, e) * jump_value(v, i) - average_normal_derivative(v, i, e) * jump_value(u, i)
+        + SIGMA * jump_value(u, i) * jump_value(v, i));
+      return result;
+    }
+
+    virtual Ord ord(int n, double *wt, DiscontinuousFunc<Ord> **u_ext, DiscontinuousFunc<Ord> *u, DiscontinuousFunc<Ord> *v, InterfaceGeom<Ord> *e, DiscontinuousFunc<Ord> **ext) const
+    {
+      return jump_value(u, 0) * jump_value(v, 0);
+    }
+
+    MatrixFormDG<double>* clone() const { return new MatrixDG(*this); }
+  };
+
+  class VectorDG : public VectorFormDG<double>
+  {
+  public:
+    VectorDG(Hermes2DFunction<double>* f) : VectorFormDG<double>(0), f(f) {}
+
+    virtual double value(int n, double *wt, DiscontinuousFunc<double> **u_ext, Func<double> *v, InterfaceGeom<double> *e, DiscontinuousFunc<double> **ext) const
+    {
+      double result = 0.;
+      for (int i = 0; i < n; i++)
+        result += wt[i] * f->value(e->x[i], e->y[i]) * (v->dx[i] * e->nx[i] + v->dy[i] * e->ny[i]);
+      return result;
+    }
+
+    virtual Ord ord(int n, double *wt, DiscontinuousFunc<Ord> **u_ext, Func<Ord> *v, InterfaceGeom<Ord> *e, DiscontinuousFunc<Ord> **ext) const
+    {
+      return v->val[0] * f->value(e->x[0], e->y[0]);
+    }
+
+    VectorFormDG<double>* clone() const { return new VectorDG(*this); }
+
+    Hermes2DFunction<double>* f;
+  };
+};
+
+class ExpressionInteriorPenaltyWeakForm : public WeakForm<double>
+{
+public:
+  ExpressionInteriorPenaltyWeakForm(Hermes2DFunction<double>* k, Hermes2DFunction<double>* f) : WeakForm<double>(1)
+  {
+    TrialFunction u;
+    TestFunction v;
+    add_matrix_form(make_matrix_form_vol<double>(0, 0, grad(u) * grad(v) + coefficient(k) * u * v));
+    add_matrix_form_surf(make_matrix_form_surf<double>(0, 0, SIGMA * u * v - grad(u) * normal() * v - grad(v) * normal() * u, "Bdy"));
+    add_vector_form_surf(make_vector_form_surf<double>(0, coefficient(f) * (SIGMA * v - grad(v) * normal()), "Bdy"));
+    add_matrix_form_DG(make_matrix_form_DG<double>(0, 0, -avg(grad(u)) * normal() * jump(v) - avg(grad(v)) * normal() * jump(u) + SIGMA * jump(u) * jump(v)));
+    add_vector_form_DG(make_vector_form_DG<double>(0, coefficient(f) * grad(v) * normal()));
+  }
+};
+
+double relative_difference(double* a, double* b, unsigned int size)
+{
+  double max_difference = 0., max_entry = 0.;
+  for (unsigned int i = 0; i < size; i++)
+  {
+    max_difference = std::max(max_difference, std::abs(a[i] - b[i]));
+    max_entry = std::max(max_entry, std::abs(b[i]));
+  }
+  return max_entry > 0. ? max_difference / max_entry : max_difference;
+}
+
+int main(int argc, char* argv[])
+{
+  bool success = true;
+
+  MeshSharedPtr mesh(new Mesh);
+  MeshReaderH2D mloader;
+  mloader.load("domain.mesh", mesh);
+  for (int i = 0; i < INIT_REF_NUM; i++)
+    mesh->refine_all_elements();
+
+  Reaction k;
+  Source f;
+  WeakFormSharedPtr<double> library_wf(new LibraryWeakForm(&k, &f));
+  WeakFormSharedPtr<double> expression_wf(new ExpressionWeakForm(&k, &f));
+
+  for (int p = 1; p <= P_MAX; p++)
+  {
+    SpaceSharedPtr<double> space(new H1Space<double>(mesh, p));
+
+    CSCMatrix<double> library_matrix, expression_matrix;
+    SimpleVector<double> library_rhs, expression_rhs;
+    DiscreteProblem<double> library_dp(library_wf, space, true);
+    library_dp.assemble(&library_matrix, &library_rhs);
+    DiscreteProblem<double> expression_dp(expression_wf, space, true);
+    expression_dp.assemble(&expression_matrix, &expression_rhs);
+
+    if (library_matrix.get_nnz() != expression_matrix.get_nnz() || library_rhs.get_size() != expression_rhs.get_size())
+    {
+      std::cout << "p = " << p << ": the matrices are not comparable" << std::endl;
+      success = false;
+      continue;
+    }
+
+    double matrix_difference = relative_difference(expression_matrix.get_Ax(), library_matrix.get_Ax(), library_matrix.get_nnz());
+    double rhs_difference = relative_difference(expression_rhs.v, library_rhs.v, library_rhs.get_size());
+    std::cout << "p = " << p << ": relative difference of the matrices " << matrix_difference << ", of the right-hand sides " << rhs_difference << std::endl;
+    if (matrix_difference > TOLERANCE || rhs_difference > TOLERANCE)
+      success = false;
+  }
+
+  // The interior penalty forms - the same (global) integration order for both, the interface forms use the DG order anyway.
+  for (int p = 1; p <= P_MAX; p++)
+  {
+    WeakFormSharedPtr<double> handwritten_dg_wf(new HandwrittenInteriorPenaltyWeakForm(&k, &f));
+    WeakFormSharedPtr<double> expression_dg_wf(new ExpressionInteriorPenaltyWeakForm(&k, &f));
+    handwritten_dg_wf->set_global_integration_order(2 * p + 2);
+    expression_dg_wf->set_global_integration_order(2 * p + 2);
+
+    SpaceSharedPtr<double> space(new L2Space<double>(mesh, p));
+
+    CSCMatrix<double> handwritten_matrix, expression_matrix;
+    SimpleVector<double> handwritten_rhs, expression_rhs;
+    DiscreteProblem<double> handwritten_dp(handwritten_dg_wf, space, true);
+    handwritten_dp.assemble(&handwritten_matrix, &handwritten_rhs);
+    DiscreteProblem<double> expression_dp(expression_dg_wf, space, true);
+    expression_dp.assemble(&expression_matrix, &expression_rhs);
+
+    if (handwritten_matrix.get_nnz() != expression_matrix.get_nnz() || handwritten_rhs.get_size() != expression_rhs.get_size())
+    {
+      std::cout << "DG, p = " << p << ": the matrices are not comparable" << std::endl;
+      success = false;
+      continue;
+    }
+
+    double matrix_difference = relative_difference(expression_matrix.get_Ax(), handwritten_matrix.get_Ax(), handwritten_matrix.get_nnz());
+    double rhs_difference = relative_difference(expression_rhs.v, handwritten_rhs.v, handwritten_rhs.get_size());
+    std::cout << "DG, p = " << p << ": relative difference of the matrices " << matrix_difference << ", of the right-hand sides " << rhs_difference << std::endl;
+    if (matrix_difference > TOLERANCE || rhs_difference > TOLERANCE)
+      success = false;
+  }
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
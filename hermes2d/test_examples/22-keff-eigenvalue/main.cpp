@@ -0,0 +1,148 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+using namespace Hermes::Hermes2D::WeakFormsNeutronics::Multigroup;
+using namespace Hermes::Hermes2D::WeakFormsNeutronics::Multigroup::MaterialProperties::Definitions;
+
+// This test checks the k-eigenvalue solver (KeffEigenvalueSolver) on a two-group homogeneous square reactor
+// with zero flux on the boundary, where k_eff is known analytically:
+// k = (nuSigma_f1 + nuSigma_f2 Sigma_s21 / (D2 B^2 + Sigma_r2)) / (D1 B^2 + Sigma_r1), with B^2 = 2 pi^2 / a^2.
+// The plain power iteration, the Wielandt-shifted and the Chebyshev-extrapolated iterations have to converge to this value,
+// the shifted one in fewer iterations, and all of them with a single factorization - also when solving again.
+//
+// The following parameters can be changed:
+
+// Polynomial degree of mesh elements.
+const int P_INIT = 3;
+// Number of initial uniform mesh refinements.
+const int INIT_REF_NUM = 2;
+// Side of the square.
+const double SIDE = 100.;
+// Tolerances of the eigenvalue solver.
+const double KEFF_TOLERANCE = 1e-10;
+const double SOURCE_TOLERANCE = 1e-7;
+// Wielandt shift.
+const double KEFF_SHIFT = 1.0;
+// Allowed relative difference from the analytic eigenvalue (discretization error) and between the methods.
+const double DISCRETIZATION_TOLERANCE = 1e-4;
+const double METHOD_TOLERANCE = 1e-7;
+
+// Materials.
+const double D[2] = { 1.5, 0.4 };
+const double SIGMA_R[2] = { 0.03, 0.1 };
+const double SIGMA_S21 = 0.02;
+const double NU[2] = { 2.5, 2.5 };
+const double SIGMA_F[2] = { 0.002, 0.05 };
+
+// Solves the problem, returns false if the eigenvalue is wrong or the factorization was not reused.
+bool solve(const char* name, KeffEigenvalueSolver& solver, double reference_keff, double& keff, int& iterations)
+{
+  solver.set_tolerance(KEFF_TOLERANCE, SOURCE_TOLERANCE);
+  solver.solve();
+  keff = solver.get_keff();
+  iterations = solver.get_num_iters();
+
+  // Solving again from the converged eigenvector must reuse the factorization.
+  std::vector<double> eigenvector(solver.get_sln_vector(), solver.get_sln_vector() + solver.get_linear_matrix_solver()->get_matrix_size());
+  solver.solve(&eigenvector[0]);
+
+  unsigned int factorizations = solver.get_linear_matrix_solver()->get_statistics().factorizations;
+  double difference = std::abs(keff - reference_keff) / reference_keff;
+  std::cout << name << ": k_eff = " << keff << " in " << iterations << " iterations (" << solver.get_num_iters()
+    << " when solving again), " << factorizations << " factorization(s), relative difference from the analytic value " << difference << std::endl;
+
+  return difference < DISCRETIZATION_TOLERANCE && factorizations <= 1 && std::abs(solver.get_keff() - keff) < METHOD_TOLERANCE * keff;
+}
+
+int main(int argc, char* argv[])
+{
+  bool success = true;
+
+  MeshSharedPtr mesh(new Mesh);
+  MeshReaderH2D mloader;
+  mloader.load("domain.mesh", mesh);
+  for (int i = 0; i < INIT_REF_NUM; i++)
+    mesh->refine_all_elements();
+
+  std::set<std::string> materials;
+  materials.insert("core");
+  MaterialProperties::Diffusion::MaterialPropertyMaps matprop(2, materials);
+
+  MaterialPropertyMap1 D_map, Sigma_r_map, Sigma_f_map;
+  D_map["core"] = rank1(D, D + 2);
+  Sigma_r_map["core"] = rank1(SIGMA_R, SIGMA_R + 2);
+  Sigma_f_map["core"] = rank1(SIGMA_F, SIGMA_F + 2);
+  MaterialPropertyMap2 Sigma_s_map;
+  Sigma_s_map["core"] = rank2(2, rank1(2, 0.));
+  Sigma_s_map["core"][1][0] = SIGMA_S21;
+  bool2 Sigma_s_nnz(2, bool1(2, false));
+  Sigma_s_nnz[1][0] = true;
+  bool1 chi_nnz(2, false);
+  chi_nnz[0] = true;
+  rank1 chi(2, 0.);
+  chi[0] = 1.;
+
+  matprop.set_D(D_map);
+  matprop.set_Sigma_r(Sigma_r_map);
+  matprop.set_Sigma_s(Sigma_s_map);
+  matprop.set_scattering_multigroup_structure(Sigma_s_nnz);
+  matprop.set_nu(rank1(NU, NU + 2));
+  matprop.set_Sigma_f(Sigma_f_map);
+  matprop.set_chi(chi);
+  matprop.set_fission_multigroup_structure(chi_nnz);
+  matprop.validate();
+
+  double B2 = 2. * M_PI * M_PI / (SIDE * SIDE);
+  double reference_keff = (NU[0] * SIGMA_F[0] + NU[1] * SIGMA_F[1] * SIGMA_S21 / (D[1] * B2 + SIGMA_R[1])) / (D[0] * B2 + SIGMA_R[0]);
+
+  DefaultEssentialBCConst<double> bc_vacuum("vacuum", 0.);
+  EssentialBCs<double> bcs(&bc_vacuum);
+  std::vector<SpaceSharedPtr<double> > spaces;
+  spaces.push_back(SpaceSharedPtr<double>(new H1Space<double>(mesh, &bcs, P_INIT)));
+  spaces.push_back(SpaceSharedPtr<double>(new H1Space<double>(mesh, &bcs, P_INIT)));
+
+  WeakFormSharedPtr<double> loss_wf(new CompleteWeakForms::Diffusion::DefaultWeakFormLossOperator<double>(matprop, mesh));
+  WeakFormSharedPtr<double> fission_wf(new CompleteWeakForms::Diffusion::DefaultWeakFormFissionOperator<double>(matprop, mesh));
+
+  double plain_keff, shifted_keff, chebyshev_keff;
+  int plain_iterations, shifted_iterations, chebyshev_iterations;
+
+  KeffEigenvalueSolver plain_solver(loss_wf, fission_wf, spaces);
+  if (!solve("Power iteration", plain_solver, reference_keff, plain_keff, plain_iterations))
+    success = false;
+
+  KeffEigenvalueSolver shifted_solver(loss_wf, fission_wf, spaces);
+  shifted_solver.set_wielandt_shift(KEFF_SHIFT);
+  if (!solve("Wielandt shift", shifted_solver, reference_keff, shifted_keff, shifted_iterations))
+    success = false;
+
+  KeffEigenvalueSolver chebyshev_solver(loss_wf, fission_wf, spaces);
+  chebyshev_solver.set_chebyshev_acceleration(true);
+  if (!solve("Chebyshev extrapolation", chebyshev_solver, reference_keff, chebyshev_keff, chebyshev_iterations))
+    success = false;
+  std::cout << "Estimated dominance ratio: " << chebyshev_solver.get_dominance_ratio_estimate() << std::endl;
+
+  if (std::abs(shifted_keff - plain_keff) > METHOD_TOLERANCE * plain_keff || std::abs(chebyshev_keff - plain_keff) > METHOD_TOLERANCE * plain_keff)
+  {
+    std::cout << "The methods give different eigenvalues" << std::endl;
+    success = false;
+  }
+
+  if (shifted_iterations >= plain_iterations)
+  {
+    std::cout << "The Wielandt shift did not accelerate the iteration" << std::endl;
+    success = false;
+  }
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,88 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+
+// This test checks the collocated mode (DiscreteProblem::set_collocated_quadrature()): the mass matrix of L2ShapesetGLLNodal
+// of orders 1 - 6 on a mesh of (non-affine) quadrilaterals is diagonal in the collocated mode - also together with
+// a quadrature selected by DiscreteProblem::set_quadrature(), the Gauss-Lobatto rules replace its quadrilateral rules -
+// and it is not diagonal with the regular quadrature.
+//
+// The following parameters can be changed:
+
+// Highest polynomial degree of mesh elements.
+const int P_MAX = 6;
+// Number of initial uniform mesh refinements.
+const int INIT_REF_NUM = 1;
+// Tolerance for the off-diagonal entries (relative to the largest entry).
+const double TOLERANCE = 1e-12;
+
+class MassWeakForm : public WeakForm<double>
+{
+public:
+  MassWeakForm() : WeakForm<double>(1)
+  {
+    add_matrix_form(new WeakFormsH1::DefaultMatrixFormVol<double>(0, 0, HERMES_ANY, new Hermes2DFunction<double>(2.0)));
+  }
+};
+
+// Assembles the mass matrix, returns the largest off-diagonal entry relative to the largest entry.
+double assemble(SpaceSharedPtr<double> space, Quad2D* quad, bool collocated, CSCMatrix<double>* matrix)
+{
+  WeakFormSharedPtr<double> wf(new MassWeakForm());
+  DiscreteProblem<double> dp(wf, space, true);
+  dp.set_quadrature(quad);
+  dp.set_collocated_quadrature(collocated);
+  dp.assemble(matrix);
+
+  double max_off_diagonal = 0., max_entry = 0.;
+  for (unsigned int j = 0; j < matrix->get_size(); j++)
+  {
+    for (int k = matrix->get_Ap()[j]; k < matrix->get_Ap()[j + 1]; k++)
+    {
+      if ((unsigned int)matrix->get_Ai()[k] != j)
+        max_off_diagonal = std::max(max_off_diagonal, std::abs(matrix->get_Ax()[k]));
+      max_entry = std::max(max_entry, std::abs(matrix->get_Ax()[k]));
+    }
+  }
+  return max_off_diagonal / max_entry;
+}
+
+int main(int argc, char* argv[])
+{
+  bool success = true;
+
+  MeshSharedPtr mesh(new Mesh);
+  MeshReaderH2D mloader;
+  mloader.load("domain.mesh", mesh);
+  for (int i = 0; i < INIT_REF_NUM; i++)
+    mesh->refine_all_elements();
+
+  L2ShapesetGLLNodal shapeset;
+  for (int p = 1; p <= P_MAX; p++)
+  {
+    SpaceSharedPtr<double> space(new L2Space<double>(mesh, p, &shapeset));
+
+    CSCMatrix<double> regular_matrix, collocated_matrix, symmetric_collocated_matrix;
+    double regular_off_diagonal = assemble(space, &g_quad_2d_std, false, &regular_matrix);
+    double collocated_off_diagonal = assemble(space, &g_quad_2d_std, true, &collocated_matrix);
+    double symmetric_collocated_off_diagonal = assemble(space, &g_quad_2d_symmetric, true, &symmetric_collocated_matrix);
+
+    std::cout << "p = " << p << ": relative off-diagonal entries " << regular_off_diagonal << " (regular), " << collocated_off_diagonal
+      << " (collocated), " << symmetric_collocated_off_diagonal << " (collocated with g_quad_2d_symmetric)" << std::endl;
+
+    if (collocated_off_diagonal > TOLERANCE || symmetric_collocated_off_diagonal > TOLERANCE || regular_off_diagonal < 1e3 * TOLERANCE)
+      success = false;
+  }
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,98 @@
+#include "definitions.h"
+
+const double AdvectionWeakForm::BETA_X = 1.0;
+const double AdvectionWeakForm::BETA_Y = 0.3;
+const double AdvectionWeakForm::REACTION = 0.5;
+const double AdvectionWeakForm::INFLOW = 1.0;
+
+AdvectionWeakForm::AdvectionWeakForm() : WeakForm<double>(1)
+{
+  add_matrix_form(new JacobianVol());
+  add_vector_form(new ResidualVol());
+  add_matrix_form_surf(new JacobianSurf());
+  add_vector_form_surf(new ResidualSurf());
+  add_matrix_form_DG(new JacobianDG());
+  add_vector_form_DG(new ResidualDG());
+}
+
+double AdvectionWeakForm::JacobianVol::value(int n, double *wt, Func<double> *u_ext[], Func<double> *u, Func<double> *v, GeomVol<double> *e, Func<double> **ext) const
+{
+  double result = 0.;
+  for (int i = 0; i < n; i++)
+    result += wt[i] * u->val[i] * (REACTION * v->val[i] - BETA_X * v->dx[i] - BETA_Y * v->dy[i]);
+  return result;
+}
+
+Ord AdvectionWeakForm::JacobianVol::ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *u, Func<Ord> *v, GeomVol<Ord> *e, Func<Ord> **ext) const
+{
+  return u->val[0] * v->val[0];
+}
+
+double AdvectionWeakForm::ResidualVol::value(int n, double *wt, Func<double> *u_ext[], Func<double> *v, GeomVol<double> *e, Func<double> **ext) const
+{
+  double result = 0.;
+  for (int i = 0; i < n; i++)
+    result += wt[i] * u_ext[0]->val[i] * (REACTION * v->val[i] - BETA_X * v->dx[i] - BETA_Y * v->dy[i]);
+  return result;
+}
+
+Ord AdvectionWeakForm::ResidualVol::ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *v, GeomVol<Ord> *e, Func<Ord> **ext) const
+{
+  return u_ext[0]->val[0] * v->val[0];
+}
+
+double AdvectionWeakForm::JacobianSurf::value(int n, double *wt, Func<double> *u_ext[], Func<double> *u, Func<double> *v, GeomSurf<double> *e, Func<double> **ext) const
+{
+  double result = 0.;
+  for (int i = 0; i < n; i++)
+    result += wt[i] * upwind_flux(u->val[i], 0., BETA_X * e->nx[i] + BETA_Y * e->ny[i]) * v->val[i];
+  return result;
+}
+
+Ord AdvectionWeakForm::JacobianSurf::ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *u, Func<Ord> *v, GeomSurf<Ord> *e, Func<Ord> **ext) const
+{
+  return u->val[0] * v->val[0];
+}
+
+double AdvectionWeakForm::ResidualSurf::value(int n, double *wt, Func<double> *u_ext[], Func<double> *v, GeomSurf<double> *e, Func<double> **ext) const
+{
+  double result = 0.;
+  for (int i = 0; i < n; i++)
+    result += wt[i] * upwind_flux(u_ext[0]->val[i], INFLOW, BETA_X * e->nx[i] + BETA_Y * e->ny[i]) * v->val[i];
+  return result;
+}
+
+Ord AdvectionWeakForm::ResidualSurf::ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *v, GeomSurf<Ord> *e, Func<Ord> **ext) const
+{
+  return u_ext[0]->val[0] * v->val[0];
+}
+
+double AdvectionWeakForm::JacobianDG::value(int n, double *wt, DiscontinuousFunc<double> **u_ext, DiscontinuousFunc<double> *u, DiscontinuousFunc<double> *v, InterfaceGeom<double> *e, DiscontinuousFunc<double> **ext) const
+{
+  double result = 0.;
+  for (int i = 0; i < n; i++)
+  {
+    double a_dot_n = BETA_X * e->nx[i] + BETA_Y * e->ny[i];
+    double flux = u->fn_central ? upwind_flux(u->val[i], 0., a_dot_n) : upwind_flux(0., u->val_neighbor[i], a_dot_n);
+    result += wt[i] * flux * (v->fn_central ? v->val[i] : -v->val_neighbor[i]);
+  }
+  return result;
+}
+
+Ord AdvectionWeakForm::JacobianDG::ord(int n, double *wt, DiscontinuousFunc<Ord> **u_ext, DiscontinuousFunc<Ord> *u, DiscontinuousFunc<Ord> *v, InterfaceGeom<Ord> *e, DiscontinuousFunc<Ord> **ext) const
+{
+  return (u->fn_central ? u->val[0] : u->val_neighbor[0]) * (v->fn_central ? v->val[0] : v->val_neighbor[0]);
+}
+
+double AdvectionWeakForm::ResidualDG::value(int n, double *wt, DiscontinuousFunc<double> **u_ext, Func<double> *v, InterfaceGeom<double> *e, DiscontinuousFunc<double> **ext) const
+{
+  double result = 0.;
+  for (int i = 0; i < n; i++)
+    result += wt[i] * upwind_flux(u_ext[0]->val[i], u_ext[0]->val_neighbor[i], BETA_X * e->nx[i] + BETA_Y * e->ny[i]) * v->val[i];
+  return result;
+}
+
+Ord AdvectionWeakForm::ResidualDG::ord(int n, double *wt, DiscontinuousFunc<Ord> **u_ext, Func<Ord> *v, InterfaceGeom<Ord> *e, DiscontinuousFunc<Ord> **ext) const
+{
+  return u_ext[0]->val[0] * v->val[0];
+}
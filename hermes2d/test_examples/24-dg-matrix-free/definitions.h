@@ -0,0 +1,96 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+
+/// Steady advection with the constant velocity (BETA_X, BETA_Y) and a reaction term, upwind fluxes on the element edges
+/// and the inflow value one, in the Newton form (Jacobian & residual).
+/// All integrands are polynomials on affine elements (the upwind side is constant along an edge), so that all assemblers
+/// integrating them exactly give the same results.
+class AdvectionWeakForm : public WeakForm<double>
+{
+public:
+  AdvectionWeakForm();
+
+  static const double BETA_X, BETA_Y, REACTION, INFLOW;
+
+  /// Upwind flux of the values u_central, u_neighbor (the upwind side chosen by the sign of a_dot_n).
+  template<typename Scalar>
+  static Scalar upwind_flux(Scalar u_central, Scalar u_neighbor, double a_dot_n)
+  {
+    return a_dot_n * (a_dot_n >= 0. ? u_central : u_neighbor);
+  }
+
+private:
+  class JacobianVol : public MatrixFormVol<double>
+  {
+  public:
+    JacobianVol() : MatrixFormVol<double>(0, 0) {};
+
+    virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *u, Func<double> *v, GeomVol<double> *e, Func<double> **ext) const;
+
+    virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *u, Func<Ord> *v, GeomVol<Ord> *e, Func<Ord> **ext) const;
+
+    MatrixFormVol<double>* clone() const { return new JacobianVol(*this); }
+  };
+
+  class ResidualVol : public VectorFormVol<double>
+  {
+  public:
+    ResidualVol() : VectorFormVol<double>(0) {};
+
+    virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *v, GeomVol<double> *e, Func<double> **ext) const;
+
+    virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *v, GeomVol<Ord> *e, Func<Ord> **ext) const;
+
+    VectorFormVol<double>* clone() const { return new ResidualVol(*this); }
+  };
+
+  class JacobianSurf : public MatrixFormSurf<double>
+  {
+  public:
+    JacobianSurf() : MatrixFormSurf<double>(0, 0) {};
+
+    virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *u, Func<double> *v, GeomSurf<double> *e, Func<double> **ext) const;
+
+    virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *u, Func<Ord> *v, GeomSurf<Ord> *e, Func<Ord> **ext) const;
+
+    MatrixFormSurf<double>* clone() const { return new JacobianSurf(*this); }
+  };
+
+  class ResidualSurf : public VectorFormSurf<double>
+  {
+  public:
+    ResidualSurf() : VectorFormSurf<double>(0) {};
+
+    virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *v, GeomSurf<double> *e, Func<double> **ext) const;
+
+    virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *v, GeomSurf<Ord> *e, Func<Ord> **ext) const;
+
+    VectorFormSurf<double>* clone() const { return new ResidualSurf(*this); }
+  };
+
+  class JacobianDG : public MatrixFormDG<double>
+  {
+  public:
+    JacobianDG() : MatrixFormDG<double>(0, 0) {};
+
+    virtual double value(int n, double *wt, DiscontinuousFunc<double> **u_ext, DiscontinuousFunc<double> *u, DiscontinuousFunc<double> *v, InterfaceGeom<double> *e, DiscontinuousFunc<double> **ext) const;
+
+    virtual Ord ord(int n, double *wt, DiscontinuousFunc<Ord> **u_ext, DiscontinuousFunc<Ord> *u, DiscontinuousFunc<Ord> *v, InterfaceGeom<Ord> *e, DiscontinuousFunc<Ord> **ext) const;
+
+    MatrixFormDG<double>* clone() const { return new JacobianDG(*this); }
+  };
+
+  class ResidualDG : public VectorFormDG<double>
+  {
+  public:
+    ResidualDG() : VectorFormDG<double>(0) {};
+
+    virtual double value(int n, double *wt, DiscontinuousFunc<double> **u_ext, Func<double> *v, InterfaceGeom<double> *e, DiscontinuousFunc<double> **ext) const;
+
+    virtual Ord ord(int n, double *wt, DiscontinuousFunc<Ord> **u_ext, Func<Ord> *v, InterfaceGeom<Ord> *e, DiscontinuousFunc<Ord> **ext) const;
+
+    VectorFormDG<double>* clone() const { return new ResidualDG(*this); }
+  };
+};
@@ -0,0 +1,96 @@
+#include "definitions.h"
+
+// This test checks the matrix-free DG operator (DiscreteProblemDGMatrixFree) against DiscreteProblem::assemble():
+// for an upwind DG advection-reaction problem (volumetric, surface and DG matrix & vector forms) on L2 spaces of orders 0 - 3
+// on a mesh of triangles and quads, assemble_residual() has to give the residual vector and apply_jacobian() the product
+// of the Jacobian matrix with a vector - with g_quad_2d_std as well as with g_quad_2d_symmetric (set_quadrature()).
+//
+// The following parameters can be changed:
+
+// Highest polynomial degree of mesh elements.
+const int P_MAX = 3;
+// Number of initial uniform mesh refinements.
+const int INIT_REF_NUM = 2;
+// Tolerance for the relative difference of the vectors.
+const double TOLERANCE = 1e-12;
+
+// Maximum relative difference of the vectors.
+double relative_difference(const std::vector<double>& values, const std::vector<double>& reference_values)
+{
+  double max_difference = 0., max_value = 0.;
+  for (unsigned int i = 0; i < values.size(); i++)
+  {
+    max_difference = std::max(max_difference, std::abs(values[i] - reference_values[i]));
+    max_value = std::max(max_value, std::abs(reference_values[i]));
+  }
+  return max_difference / max_value;
+}
+
+// Compares the matrix-free evaluation with the assembled one, returns false if they differ.
+bool compare(SpaceSharedPtr<double> space, Quad2D* quad, const char* quad_name, int p)
+{
+  WeakFormSharedPtr<double> wf(new AdvectionWeakForm());
+  int ndof = space->get_num_dofs();
+
+  std::vector<double> coeff_vec(ndof), direction(ndof);
+  for (int i = 0; i < ndof; i++)
+  {
+    coeff_vec[i] = std::sin(1. + i);
+    direction[i] = std::cos(2. * i);
+  }
+
+  // Assembled.
+  DiscreteProblem<double> dp(wf, space);
+  dp.set_quadrature(quad);
+  CSCMatrix<double> jacobian;
+  SimpleVector<double> residual;
+  double* coeff_vec_ptr = &coeff_vec[0];
+  dp.assemble(coeff_vec_ptr, &jacobian, &residual);
+  std::vector<double> assembled_residual(residual.v, residual.v + ndof), assembled_product(ndof, 0.);
+  double* product = &assembled_product[0];
+  jacobian.multiply_with_vector(&direction[0], product, true);
+
+  // Matrix-free.
+  DiscreteProblemDGMatrixFree<double> matrix_free(wf, space);
+  matrix_free.set_quadrature(quad);
+  std::vector<double> matrix_free_residual(ndof), matrix_free_product(ndof);
+  matrix_free.assemble_residual(&coeff_vec[0], &matrix_free_residual[0]);
+  matrix_free.apply_jacobian(&coeff_vec[0], &direction[0], &matrix_free_product[0]);
+
+  double residual_difference = relative_difference(matrix_free_residual, assembled_residual);
+  double product_difference = relative_difference(matrix_free_product, assembled_product);
+  std::cout << quad_name << ", p = " << p << ": relative difference of the residual " << residual_difference
+    << ", of the Jacobian product " << product_difference << std::endl;
+  return residual_difference <= TOLERANCE && product_difference <= TOLERANCE;
+}
+
+int main(int argc, char* argv[])
+{
+  bool success = true;
+
+  MeshSharedPtr mesh(new Mesh);
+  MeshReaderH2D mloader;
+  mloader.load("domain.mesh", mesh);
+  for (int i = 0; i < INIT_REF_NUM; i++)
+    mesh->refine_all_elements();
+
+  for (int p = 0; p <= P_MAX; p++)
+  {
+    SpaceSharedPtr<double> space(new L2Space<double>(mesh, p));
+    if (!compare(space, &g_quad_2d_std, "g_quad_2d_std", p))
+      success = false;
+    if (!compare(space, &g_quad_2d_symmetric, "g_quad_2d_symmetric", p))
+      success = false;
+  }
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,116 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+using namespace Hermes::Hermes2D::WeakFormsH1;
+
+// This test checks the overlapped execution of the assembling and the factorization in the Newton's method
+// (NonlinearMatrixSolver::set_task_overlap()): the nonlinear heat transfer problem - div[lambda(u) grad u] + src = 0
+// with lambda(u) = 1 + u^2 is solved with and without the option, with the Jacobian recalculated in every step
+// (that is where the factorization is overlapped), and with the automatic damping.
+// The number of iterations and the solution have to be the same, and the overlapped run has to use the overlap
+// in every iteration not rejected by the damping (in at least one).
+//
+// The following parameters can be changed:
+
+// Initial polynomial degree.
+const int P_INIT = 3;
+// Number of initial uniform mesh refinements.
+const int INIT_REF_NUM = 3;
+// Stopping criterion and the maximum number of iterations of the Newton's method.
+const double NEWTON_TOL = 1e-8;
+const int NEWTON_MAX_ITER = 50;
+// Heat source and the boundary value.
+const double HEAT_SRC = 5.0;
+const double BDY_VALUE = 1.0;
+// Tolerance for the comparison of the solutions.
+const double TOLERANCE = 1e-12;
+
+// lambda(u) = 1 + u^2.
+class CustomNonlinearity : public Hermes1DFunction<double>
+{
+public:
+  CustomNonlinearity() : Hermes1DFunction<double>()
+  {
+    this->is_const = false;
+  }
+
+  virtual double value(double u) const { return 1. + u * u; }
+  virtual Ord value(Ord u) const { return u * u; }
+  virtual double derivative(double u) const { return 2. * u; }
+  virtual Ord derivative(Ord u) const { return u; }
+};
+
+// Solves the problem, returns the number of iterations (-1 on a failure).
+int solve(WeakFormSharedPtr<double> wf, SpaceSharedPtr<double> space, bool task_overlap, std::vector<double>& sln_vector, unsigned int& overlapped_iterations)
+{
+  NewtonSolver<double> newton(wf, space);
+  newton.set_tolerance(NEWTON_TOL, Hermes::Solvers::ResidualNormAbsolute);
+  newton.set_max_allowed_iterations(NEWTON_MAX_ITER);
+  newton.set_max_steps_with_reused_jacobian(0);
+  newton.set_task_overlap(task_overlap);
+
+  try
+  {
+    newton.solve();
+  }
+  catch (std::exception& e)
+  {
+    std::cout << (task_overlap ? "With" : "Without") << " the overlap: " << e.what() << std::endl;
+    return -1;
+  }
+
+  sln_vector.assign(newton.get_sln_vector(), newton.get_sln_vector() + space->get_num_dofs());
+  overlapped_iterations = newton.get_num_overlapped_iters();
+  return newton.get_num_iters();
+}
+
+int main(int argc, char* argv[])
+{
+  MeshSharedPtr mesh(new Mesh);
+  MeshReaderH2D mloader;
+  mloader.load("domain.mesh", mesh);
+  for (int i = 0; i < INIT_REF_NUM; i++)
+    mesh->refine_all_elements();
+
+  DefaultEssentialBCConst<double> bc_essential("Bdy", BDY_VALUE);
+  EssentialBCs<double> bcs(&bc_essential);
+  SpaceSharedPtr<double> space(new H1Space<double>(mesh, &bcs, P_INIT));
+
+  CustomNonlinearity lambda;
+  Hermes2DFunction<double> src(-HEAT_SRC);
+  WeakFormSharedPtr<double> wf(new DefaultWeakFormPoisson<double>(HERMES_ANY, &lambda, &src));
+
+  std::vector<double> sln_vector, sln_vector_overlapped;
+  unsigned int overlapped_iterations, overlapped_iterations_overlapped;
+  int iterations = solve(wf, space, false, sln_vector, overlapped_iterations);
+  int iterations_overlapped = solve(wf, space, true, sln_vector_overlapped, overlapped_iterations_overlapped);
+  std::cout << "Iterations without the overlap: " << iterations << " (overlapped " << overlapped_iterations << "), with the overlap: "
+    << iterations_overlapped << " (overlapped " << overlapped_iterations_overlapped << ")" << std::endl;
+
+  // The overlap has to actually run - it is switched off silently where the linear solver does not support it.
+  bool success = iterations > 0 && iterations == iterations_overlapped && overlapped_iterations == 0
+    && overlapped_iterations_overlapped > 0 && (int)overlapped_iterations_overlapped <= iterations_overlapped;
+  if (success)
+  {
+    double difference = 0., max_value = 0.;
+    for (unsigned int i = 0; i < sln_vector.size(); i++)
+    {
+      difference = std::max(difference, std::abs(sln_vector[i] - sln_vector_overlapped[i]));
+      max_value = std::max(max_value, std::abs(sln_vector[i]));
+    }
+    std::cout << "Relative difference of the solutions: " << difference / max_value << std::endl;
+    success = difference <= TOLERANCE * max_value;
+  }
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
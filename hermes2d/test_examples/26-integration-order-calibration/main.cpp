@@ -0,0 +1,145 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+
+// This test checks the integration order calibration (DiscreteProblem::calibrate_integration_orders()) together with
+// a user integration order offset: the mass matrix form has the offset ORDER_OFFSET (a safety margin), the elements
+// have two different polynomial degrees in one area. The calibration caps the order of the high degree elements,
+// whose calculated order (with the offset) is higher than needed, but the low degree elements still have to be integrated
+// with their calculated order including the offset - the calibration must not discard it.
+// The matrix has to stay the same (all integrals are exact).
+//
+// The following parameters can be changed:
+
+// Polynomial degrees of the elements.
+const int P_LOW = 2;
+const int P_HIGH = 5;
+// Number of initial uniform mesh refinements.
+const int INIT_REF_NUM = 2;
+// Offset of the integration order.
+const int ORDER_OFFSET = 3;
+// Tolerance of the calibration.
+const double CALIBRATION_TOLERANCE = 1e-10;
+// Tolerance for the relative difference of the matrices.
+const double TOLERANCE = 1e-10;
+
+class MassForm : public MatrixFormVol<double>
+{
+public:
+  MassForm() : MatrixFormVol<double>(0, 0) {}
+
+  virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *u, Func<double> *v, GeomVol<double> *e, Func<double> **ext) const
+  {
+    double result = 0.;
+    for (int i = 0; i < n; i++)
+      result += wt[i] * u->val[i] * v->val[i];
+    return result;
+  }
+
+  virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *u, Func<Ord> *v, GeomVol<Ord> *e, Func<Ord> **ext) const
+  {
+    return u->val[0] * v->val[0];
+  }
+
+  MatrixFormVol<double>* clone() const { return new MassForm(*this); }
+};
+
+class MassWeakForm : public WeakForm<double>
+{
+public:
+  MassWeakForm() : WeakForm<double>(1)
+  {
+    MassForm* form = new MassForm();
+    form->set_integration_order_offset(ORDER_OFFSET);
+    add_matrix_form(form);
+  }
+};
+
+// Lowest and highest integration order of the last assembling.
+void get_order_range(const AssemblyStatistics& statistics, int& lowest, int& highest)
+{
+  lowest = -1;
+  highest = -1;
+  for (unsigned int order = 0; order < statistics.states_per_order.size(); order++)
+  {
+    if (statistics.states_per_order[order] == 0)
+      continue;
+    if (lowest < 0)
+      lowest = order;
+    highest = order;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  MeshSharedPtr mesh(new Mesh);
+  MeshReaderH2D mloader;
+  mloader.load("domain.mesh", mesh);
+  for (int i = 0; i < INIT_REF_NUM; i++)
+    mesh->refine_all_elements();
+
+  SpaceSharedPtr<double> space(new L2Space<double>(mesh, P_LOW));
+  Element* e;
+  for_all_active_elements(e, mesh)
+  {
+    if (e->id % 2)
+      space->set_element_order(e->id, P_HIGH);
+  }
+  space->assign_dofs();
+
+  WeakFormSharedPtr<double> wf(new MassWeakForm());
+  DiscreteProblem<double> dp(wf, space, true);
+
+  CSCMatrix<double> matrix, calibrated_matrix;
+  SimpleVector<double> rhs, calibrated_rhs;
+  dp.assemble(&matrix, &rhs);
+  int lowest, highest;
+  get_order_range(dp.get_assembly_statistics(), lowest, highest);
+
+  // Sample all elements.
+  dp.calibrate_integration_orders(CALIBRATION_TOLERANCE, nullptr, mesh->get_num_active_elements());
+  dp.assemble(&calibrated_matrix, &calibrated_rhs);
+  int calibrated_lowest, calibrated_highest;
+  get_order_range(dp.get_assembly_statistics(), calibrated_lowest, calibrated_highest);
+
+  std::cout << "Integration orders " << lowest << " - " << highest << ", after the calibration " << calibrated_lowest << " - " << calibrated_highest << std::endl;
+
+  bool success = true;
+  if (calibrated_highest >= highest)
+  {
+    std::cout << "The calibration did not cap the order" << std::endl;
+    success = false;
+  }
+  if (calibrated_lowest != lowest)
+  {
+    std::cout << "The calibration discarded the order offset" << std::endl;
+    success = false;
+  }
+
+  if (matrix.get_nnz() != calibrated_matrix.get_nnz())
+    success = false;
+  else
+  {
+    double max_difference = 0., max_entry = 0.;
+    for (unsigned int i = 0; i < matrix.get_nnz(); i++)
+    {
+      max_difference = std::max(max_difference, std::abs(matrix.get_Ax()[i] - calibrated_matrix.get_Ax()[i]));
+      max_entry = std::max(max_entry, std::abs(matrix.get_Ax()[i]));
+    }
+    std::cout << "Relative difference of the matrices: " << max_difference / max_entry << std::endl;
+    if (max_difference > TOLERANCE * max_entry)
+      success = false;
+  }
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,225 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+
+// This test checks the parameter sweep assembling (DiscreteProblem::assemble() with weak formulation variants):
+// the problem - div[k grad u] = f g with the Robin condition k du/dn + h u = 0 (g an external function) is assembled
+// for several values of k, h, f in one traversal, and every variant has to give the same matrix and vector as
+// a separately assembled problem, with the sparse structure shared by all matrices.
+// Two sweeps are assembled - with the external function shared by all variants, and with a variant having its own.
+//
+// The following parameters can be changed:
+
+// Initial polynomial degree.
+const int P_INIT = 3;
+// Number of initial uniform mesh refinements.
+const int INIT_REF_NUM = 3;
+// Number of variants.
+const int NUM_VARIANTS = 3;
+// Parameters of the variants.
+const double K[NUM_VARIANTS] = { 1.0, 2.5, 0.1 };
+const double H[NUM_VARIANTS] = { 0.5, 3.0, 10.0 };
+const double F[NUM_VARIANTS] = { 1.0, -2.0, 7.0 };
+// Values of the external function g.
+const double G = 2.0;
+const double G_OWN = -3.0;
+// Tolerance for the relative difference of the matrices and vectors.
+const double TOLERANCE = 1e-12;
+
+class DiffusionForm : public MatrixFormVol<double>
+{
+public:
+  DiffusionForm(double k) : MatrixFormVol<double>(0, 0), k(k)
+  {
+    this->setSymFlag(HERMES_SYM);
+  }
+
+  virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *u, Func<double> *v, GeomVol<double> *e, Func<double> **ext) const
+  {
+    double result = 0.;
+    for (int i = 0; i < n; i++)
+      result += wt[i] * (u->dx[i] * v->dx[i] + u->dy[i] * v->dy[i]);
+    return k * result;
+  }
+
+  virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *u, Func<Ord> *v, GeomVol<Ord> *e, Func<Ord> **ext) const
+  {
+    return u->dx[0] * v->dx[0] + u->dy[0] * v->dy[0];
+  }
+
+  MatrixFormVol<double>* clone() const { return new DiffusionForm(*this); }
+
+  double k;
+};
+
+class RobinForm : public MatrixFormSurf<double>
+{
+public:
+  RobinForm(double h) : MatrixFormSurf<double>(0, 0), h(h)
+  {
+  }
+
+  virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *u, Func<double> *v, GeomSurf<double> *e, Func<double> **ext) const
+  {
+    double result = 0.;
+    for (int i = 0; i < n; i++)
+      result += wt[i] * u->val[i] * v->val[i];
+    return h * result;
+  }
+
+  virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *u, Func<Ord> *v, GeomSurf<Ord> *e, Func<Ord> **ext) const
+  {
+    return u->val[0] * v->val[0];
+  }
+
+  MatrixFormSurf<double>* clone() const { return new RobinForm(*this); }
+
+  double h;
+};
+
+class SourceForm : public VectorFormVol<double>
+{
+public:
+  SourceForm(double f) : VectorFormVol<double>(0), f(f)
+  {
+  }
+
+  virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *v, GeomVol<double> *e, Func<double> **ext) const
+  {
+    double result = 0.;
+    for (int i = 0; i < n; i++)
+      result += wt[i] * ext[0]->val[i] * v->val[i];
+    return f * result;
+  }
+
+  virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *v, GeomVol<Ord> *e, Func<Ord> **ext) const
+  {
+    return ext[0]->val[0] * v->val[0];
+  }
+
+  VectorFormVol<double>* clone() const { return new SourceForm(*this); }
+
+  double f;
+};
+
+class SweepWeakForm : public WeakForm<double>
+{
+public:
+  SweepWeakForm(double k, double h, double f, MeshFunctionSharedPtr<double> g) : WeakForm<double>(1)
+  {
+    add_matrix_form(new DiffusionForm(k));
+    add_matrix_form_surf(new RobinForm(h));
+    add_vector_form(new SourceForm(f));
+    set_ext(g);
+  }
+};
+
+// Relative difference of two arrays.
+double relative_difference(const double* values, const double* reference_values, unsigned int size)
+{
+  double difference = 0., max_value = 0.;
+  for (unsigned int i = 0; i < size; i++)
+  {
+    difference = std::max(difference, std::abs(values[i] - reference_values[i]));
+    max_value = std::max(max_value, std::abs(reference_values[i]));
+  }
+  return difference / max_value;
+}
+
+// Assembles the variants in one traversal, compares them with the separately assembled problems.
+bool check_sweep(const char* name, std::vector<WeakFormSharedPtr<double> > wfs, SpaceSharedPtr<double> space)
+{
+  bool success = true;
+
+  std::vector<CSCMatrix<double>*> matrices;
+  std::vector<SimpleVector<double>*> vectors;
+  std::vector<SparseMatrix<double>*> mats;
+  std::vector<Vector<double>*> rhss;
+  for (unsigned int variant_i = 0; variant_i < wfs.size(); variant_i++)
+  {
+    matrices.push_back(new CSCMatrix<double>());
+    vectors.push_back(new SimpleVector<double>());
+    mats.push_back(matrices.back());
+    rhss.push_back(vectors.back());
+  }
+
+  DiscreteProblem<double> dp(wfs[0], space, true);
+  dp.assemble(wfs, mats, rhss);
+
+  for (unsigned int variant_i = 0; variant_i < wfs.size(); variant_i++)
+  {
+    DiscreteProblem<double> separate_dp(wfs[variant_i], space, true);
+    CSCMatrix<double> matrix;
+    SimpleVector<double> rhs;
+    separate_dp.assemble(&matrix, &rhs);
+
+    if (matrix.get_nnz() != matrices[variant_i]->get_nnz() || rhs.get_size() != vectors[variant_i]->get_size())
+    {
+      std::cout << name << ", variant " << variant_i << ": different sizes" << std::endl;
+      success = false;
+      continue;
+    }
+    if (variant_i > 0 && (matrices[variant_i]->get_Ap() != matrices[0]->get_Ap() || matrices[variant_i]->get_Ai() != matrices[0]->get_Ai()))
+    {
+      std::cout << name << ", variant " << variant_i << ": the sparse structure is not shared" << std::endl;
+      success = false;
+    }
+
+    double matrix_difference = relative_difference(matrices[variant_i]->get_Ax(), matrix.get_Ax(), matrix.get_nnz());
+    double vector_difference = relative_difference(vectors[variant_i]->v, rhs.v, rhs.get_size());
+    std::cout << name << ", variant " << variant_i << ": relative difference of the matrices " << matrix_difference << ", of the vectors " << vector_difference << std::endl;
+    if (matrix_difference > TOLERANCE || vector_difference > TOLERANCE)
+      success = false;
+  }
+
+  // The structure stays valid with the other matrices.
+  delete matrices[0];
+  for (unsigned int variant_i = 1; variant_i < wfs.size(); variant_i++)
+  {
+    if (matrices[variant_i]->get_Ap()[matrices[variant_i]->get_size()] != matrices[variant_i]->get_nnz())
+      success = false;
+    delete matrices[variant_i];
+  }
+  for (unsigned int variant_i = 0; variant_i < wfs.size(); variant_i++)
+    delete vectors[variant_i];
+
+  return success;
+}
+
+int main(int argc, char* argv[])
+{
+  MeshSharedPtr mesh(new Mesh);
+  MeshReaderH2D mloader;
+  mloader.load("domain.mesh", mesh);
+  for (int i = 0; i < INIT_REF_NUM; i++)
+    mesh->refine_all_elements();
+
+  SpaceSharedPtr<double> space(new H1Space<double>(mesh, P_INIT));
+
+  MeshFunctionSharedPtr<double> g(new ConstantSolution<double>(mesh, G));
+  MeshFunctionSharedPtr<double> g_own(new ConstantSolution<double>(mesh, G_OWN));
+
+  bool success = true;
+
+  std::vector<WeakFormSharedPtr<double> > wfs;
+  for (int variant_i = 0; variant_i < NUM_VARIANTS; variant_i++)
+    wfs.push_back(WeakFormSharedPtr<double>(new SweepWeakForm(K[variant_i], H[variant_i], F[variant_i], g)));
+  if (!check_sweep("Shared external function", wfs, space))
+    success = false;
+
+  wfs.back() = WeakFormSharedPtr<double>(new SweepWeakForm(K[NUM_VARIANTS - 1], H[NUM_VARIANTS - 1], F[NUM_VARIANTS - 1], g_own));
+  if (!check_sweep("Own external function", wfs, space))
+    success = false;
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
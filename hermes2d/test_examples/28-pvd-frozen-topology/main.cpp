@@ -0,0 +1,135 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+using namespace Hermes::Hermes2D::Views;
+
+// This test checks the .pvd time series output (Linearizer::save_solution_pvd_step()) with the frozen topology:
+// the steps on the same mesh replay the recorded refinement and re-evaluate the values only, so they have to give
+// the same linearization as a linearizer without the frozen topology. A change of the criterion has to record
+// the topology again (not replay the one refined with the previous criterion).
+//
+// The following parameters can be changed:
+
+// Number of initial uniform mesh refinements.
+const int INIT_REF_NUM = 2;
+// Refinement levels of the fixed criterion - before and after the change.
+const int REFINEMENT_LEVEL = 1;
+const int REFINEMENT_LEVEL_CHANGED = 3;
+// Time steps.
+const int NUM_STEPS = 3;
+const double TIME_STEP = 0.5;
+// Tolerance for the values.
+const double TOLERANCE = 1e-5;
+
+// u(x, y, t) = sin(x + t) cos(y - t).
+class TimeDependentFunction : public ExactSolutionScalar<double>
+{
+public:
+  TimeDependentFunction(MeshSharedPtr mesh, double time) : ExactSolutionScalar<double>(mesh), time(time)
+  {
+  }
+
+  virtual double value(double x, double y) const
+  {
+    return std::sin(x + time) * std::cos(y - time);
+  }
+
+  virtual void derivatives(double x, double y, double& dx, double& dy) const
+  {
+    dx = std::cos(x + time) * std::cos(y - time);
+    dy = -std::sin(x + time) * std::sin(y - time);
+  }
+
+  virtual Ord ord(double x, double y) const
+  {
+    return Ord(10);
+  }
+
+  virtual MeshFunction<double>* clone() const
+  {
+    return new TimeDependentFunction(this->mesh, time);
+  }
+
+  double time;
+};
+
+// Compares the frozen linearization with the one of a linearizer without the frozen topology.
+bool check_step(const char* name, Linearizer& frozen_linearizer, MeshFunctionSharedPtr<double> function, int refinement_level)
+{
+  Linearizer linearizer(FileExport);
+  linearizer.set_criterion(LinearizerCriterionFixed(refinement_level));
+  linearizer.process_solution(function);
+
+  std::cout << name << ": " << frozen_linearizer.get_vertex_count() << " vertices, " << frozen_linearizer.get_triangle_count() << " triangles, values "
+    << frozen_linearizer.get_min_value() << " - " << frozen_linearizer.get_max_value() << " (reference: " << linearizer.get_vertex_count() << " vertices, "
+    << linearizer.get_triangle_count() << " triangles, values " << linearizer.get_min_value() << " - " << linearizer.get_max_value() << ")" << std::endl;
+
+  return frozen_linearizer.get_vertex_count() == linearizer.get_vertex_count()
+    && frozen_linearizer.get_triangle_count() == linearizer.get_triangle_count()
+    && std::abs(frozen_linearizer.get_min_value() - linearizer.get_min_value()) < TOLERANCE
+    && std::abs(frozen_linearizer.get_max_value() - linearizer.get_max_value()) < TOLERANCE;
+}
+
+int main(int argc, char* argv[])
+{
+  MeshSharedPtr mesh(new Mesh);
+  MeshReaderH2D mloader;
+  mloader.load("domain.mesh", mesh);
+  for (int i = 0; i < INIT_REF_NUM; i++)
+    mesh->refine_all_elements();
+
+  bool success = true;
+
+  Linearizer linearizer(FileExport);
+  linearizer.set_criterion(LinearizerCriterionFixed(REFINEMENT_LEVEL));
+
+  // The first step records the topology, the following ones replay it.
+  for (int step = 0; step < NUM_STEPS; step++)
+  {
+    MeshFunctionSharedPtr<double> function(new TimeDependentFunction(mesh, step * TIME_STEP));
+    linearizer.save_solution_pvd_step(function, "series.pvd", "u", step * TIME_STEP);
+    std::stringstream name;
+    name << "Step " << step;
+    if (!check_step(name.str().c_str(), linearizer, function, REFINEMENT_LEVEL))
+      success = false;
+  }
+
+  // The changed criterion on the same mesh.
+  linearizer.set_criterion(LinearizerCriterionFixed(REFINEMENT_LEVEL_CHANGED));
+  for (int step = NUM_STEPS; step < 2 * NUM_STEPS; step++)
+  {
+    MeshFunctionSharedPtr<double> function(new TimeDependentFunction(mesh, step * TIME_STEP));
+    linearizer.save_solution_pvd_step(function, "series.pvd", "u", step * TIME_STEP);
+    std::stringstream name;
+    name << "Step " << step << " (changed criterion)";
+    if (!check_step(name.str().c_str(), linearizer, function, REFINEMENT_LEVEL_CHANGED))
+      success = false;
+  }
+
+  // The series has to reference all steps.
+  std::ifstream series("series.pvd");
+  std::string line;
+  int num_datasets = 0;
+  while (std::getline(series, line))
+  {
+    if (line.find("<DataSet") != std::string::npos)
+      num_datasets++;
+  }
+  if (num_datasets != 2 * NUM_STEPS)
+  {
+    std::cout << "The series references " << num_datasets << " steps" << std::endl;
+    success = false;
+  }
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
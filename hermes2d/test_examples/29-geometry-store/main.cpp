@@ -0,0 +1,179 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+
+// This test checks the geometry store (DiscreteProblem::set_geometry_store()): a problem whose forms use
+// the physical coordinates and the normals is assembled repeatedly with the store - the first assembling fills
+// the store, the following ones take the geometry from it - and the results have to be the same as without the store.
+// After a mesh refinement (a new mesh seq), the store has to drop the records of the old mesh.
+//
+// The following parameters can be changed:
+
+// Initial polynomial degree.
+const int P_INIT = 3;
+// Number of initial uniform mesh refinements.
+const int INIT_REF_NUM = 2;
+// Number of assemblings with the store.
+const int NUM_ASSEMBLINGS = 3;
+// Tolerance for the relative difference of the matrices and vectors.
+const double TOLERANCE = 1e-13;
+
+// (1 + x^2) grad u . grad v
+class CoordinateDiffusionForm : public MatrixFormVol<double>
+{
+public:
+  CoordinateDiffusionForm() : MatrixFormVol<double>(0, 0) {}
+
+  virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *u, Func<double> *v, GeomVol<double> *e, Func<double> **ext) const
+  {
+    double result = 0.;
+    for (int i = 0; i < n; i++)
+      result += wt[i] * (1. + e->x[i] * e->x[i]) * (u->dx[i] * v->dx[i] + u->dy[i] * v->dy[i]);
+    return result;
+  }
+
+  virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *u, Func<Ord> *v, GeomVol<Ord> *e, Func<Ord> **ext) const
+  {
+    return e->x[0] * e->x[0] * (u->dx[0] * v->dx[0] + u->dy[0] * v->dy[0]);
+  }
+
+  MatrixFormVol<double>* clone() const { return new CoordinateDiffusionForm(*this); }
+};
+
+// (x nx + y ny) v on the boundary.
+class NormalFluxForm : public VectorFormSurf<double>
+{
+public:
+  NormalFluxForm() : VectorFormSurf<double>(0) {}
+
+  virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *v, GeomSurf<double> *e, Func<double> **ext) const
+  {
+    double result = 0.;
+    for (int i = 0; i < n; i++)
+      result += wt[i] * (e->x[i] * e->nx[i] + e->y[i] * e->ny[i]) * v->val[i];
+    return result;
+  }
+
+  virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *v, GeomSurf<Ord> *e, Func<Ord> **ext) const
+  {
+    return e->x[0] * v->val[0];
+  }
+
+  VectorFormSurf<double>* clone() const { return new NormalFluxForm(*this); }
+};
+
+class GeometryWeakForm : public WeakForm<double>
+{
+public:
+  GeometryWeakForm() : WeakForm<double>(1)
+  {
+    add_matrix_form(new CoordinateDiffusionForm());
+    add_vector_form_surf(new NormalFluxForm());
+  }
+};
+
+// Relative difference of the matrices and vectors.
+double relative_difference(CSCMatrix<double>& matrix, SimpleVector<double>& rhs, CSCMatrix<double>& reference_matrix, SimpleVector<double>& reference_rhs)
+{
+  if (matrix.get_nnz() != reference_matrix.get_nnz() || rhs.get_size() != reference_rhs.get_size())
+    return 1.;
+
+  double difference = 0., max_value = 0.;
+  for (unsigned int i = 0; i < matrix.get_nnz(); i++)
+  {
+    difference = std::max(difference, std::abs(matrix.get_Ax()[i] - reference_matrix.get_Ax()[i]));
+    max_value = std::max(max_value, std::abs(reference_matrix.get_Ax()[i]));
+  }
+  double vector_difference = 0., vector_max_value = 0.;
+  for (unsigned int i = 0; i < rhs.get_size(); i++)
+  {
+    vector_difference = std::max(vector_difference, std::abs(rhs.get(i) - reference_rhs.get(i)));
+    vector_max_value = std::max(vector_max_value, std::abs(reference_rhs.get(i)));
+  }
+  return std::max(difference / max_value, vector_difference / vector_max_value);
+}
+
+// Assembles the problem with the store repeatedly, compares with the assembling without the store.
+bool check_store(const char* name, DiscreteProblem<double>& dp, WeakFormSharedPtr<double> wf, SpaceSharedPtr<double> space)
+{
+  bool success = true;
+
+  DiscreteProblem<double> reference_dp(wf, space, true);
+  CSCMatrix<double> reference_matrix;
+  SimpleVector<double> reference_rhs;
+  reference_dp.assemble(&reference_matrix, &reference_rhs);
+
+  unsigned int num_records = 0;
+  for (int assembling_i = 0; assembling_i < NUM_ASSEMBLINGS; assembling_i++)
+  {
+    CSCMatrix<double> matrix;
+    SimpleVector<double> rhs;
+    dp.assemble(&matrix, &rhs);
+
+    double difference = relative_difference(matrix, rhs, reference_matrix, reference_rhs);
+    std::cout << name << ", assembling " << assembling_i << ": " << dp.get_geometry_store()->get_num_records() << " records, relative difference " << difference << std::endl;
+    if (difference > TOLERANCE)
+      success = false;
+
+    // The first assembling fills the store, the following ones only take the records.
+    if (assembling_i == 0)
+      num_records = dp.get_geometry_store()->get_num_records();
+    else if (dp.get_geometry_store()->get_num_records() != num_records)
+      success = false;
+  }
+
+  if (num_records == 0)
+    success = false;
+
+  return success;
+}
+
+int main(int argc, char* argv[])
+{
+  MeshSharedPtr mesh(new Mesh);
+  MeshReaderH2D mloader;
+  mloader.load("domain.mesh", mesh);
+  for (int i = 0; i < INIT_REF_NUM; i++)
+    mesh->refine_all_elements();
+
+  SpaceSharedPtr<double> space(new H1Space<double>(mesh, P_INIT));
+  WeakFormSharedPtr<double> wf(new GeometryWeakForm());
+
+  bool success = true;
+
+  DiscreteProblem<double> dp(wf, space, true);
+  dp.set_geometry_store(true);
+  if (!check_store("Initial mesh", dp, wf, space))
+    success = false;
+  unsigned int initial_mesh_records = dp.get_geometry_store()->get_num_records();
+
+  // The refined mesh - the records of the previous mesh have to be dropped, i.e. the store has
+  // the same number of records as a new store on the refined mesh.
+  mesh->refine_all_elements();
+  space->set_uniform_order(P_INIT);
+  space->assign_dofs();
+  if (!check_store("Refined mesh", dp, wf, space))
+    success = false;
+  unsigned int refined_mesh_records = dp.get_geometry_store()->get_num_records();
+
+  DiscreteProblem<double> new_dp(wf, space, true);
+  new_dp.set_geometry_store(true);
+  CSCMatrix<double> matrix;
+  SimpleVector<double> rhs;
+  new_dp.assemble(&matrix, &rhs);
+  std::cout << "Records: initial mesh " << initial_mesh_records << ", refined mesh " << refined_mesh_records << ", new store " << new_dp.get_geometry_store()->get_num_records() << std::endl;
+  if (refined_mesh_records != new_dp.get_geometry_store()->get_num_records())
+    success = false;
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,121 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+
+// This test checks the pool allocator (PoolAllocator) of the assembling objects:
+// - released blocks are reused by the following allocations, without new chunks from the heap,
+// - all blocks are returned (no blocks in use after the release), also the large ones served by the heap
+// and the ones released after switching the pooling off,
+// - the blocks are 16-byte aligned and callocate() zeroes the reused blocks.
+//
+// The following parameters can be changed:
+
+// Number of blocks and their size (a pooled size class).
+const int NUM_BLOCKS = 1000;
+const size_t BLOCK_SIZE = 100;
+// Size of a block served by the heap (over the largest size class).
+const size_t LARGE_BLOCK_SIZE = 512 * 1024;
+
+// All blocks released - the same numbers of blocks in use as initially.
+bool check_released(const char* name, const PoolAllocator::Statistics& statistics, const PoolAllocator::Statistics& initial_statistics)
+{
+  long long heap_blocks = (long long)(statistics.heap_allocations - statistics.heap_deallocations);
+  long long initial_heap_blocks = (long long)(initial_statistics.heap_allocations - initial_statistics.heap_deallocations);
+  if (statistics.blocks_in_use == initial_statistics.blocks_in_use && heap_blocks == initial_heap_blocks)
+    return true;
+  std::cout << name << ": " << statistics.blocks_in_use - initial_statistics.blocks_in_use << " pooled and "
+    << heap_blocks - initial_heap_blocks << " heap blocks not released" << std::endl;
+  return false;
+}
+
+int main(int argc, char* argv[])
+{
+  bool success = true;
+
+  PoolAllocator::Statistics initial_statistics = PoolAllocator::get_statistics();
+
+  // Allocation and release.
+  std::vector<char*> blocks;
+  for (int i = 0; i < NUM_BLOCKS; i++)
+  {
+    char* block = (char*)PoolAllocator::allocate(BLOCK_SIZE);
+    if (!block || ((size_t)block) % 16)
+    {
+      std::cout << "Allocation " << i << " failed or not aligned" << std::endl;
+      success = false;
+      break;
+    }
+    memset(block, 0xff, BLOCK_SIZE);
+    blocks.push_back(block);
+  }
+  PoolAllocator::Statistics allocated_statistics = PoolAllocator::get_statistics();
+  if (allocated_statistics.blocks_in_use != initial_statistics.blocks_in_use + (long long)blocks.size())
+    success = false;
+
+  std::set<char*> released_blocks(blocks.begin(), blocks.end());
+  for (unsigned int i = 0; i < blocks.size(); i++)
+    PoolAllocator::deallocate(blocks[i]);
+  if (!check_released("Release", PoolAllocator::get_statistics(), initial_statistics))
+    success = false;
+
+  // Reuse - the same blocks, no new chunks, zeroed by callocate().
+  int reused = 0;
+  bool zeroed = true;
+  for (unsigned int i = 0; i < blocks.size(); i++)
+  {
+    blocks[i] = (char*)PoolAllocator::callocate(BLOCK_SIZE);
+    if (released_blocks.find(blocks[i]) != released_blocks.end())
+      reused++;
+    for (size_t j = 0; j < BLOCK_SIZE; j++)
+      zeroed = zeroed && blocks[i][j] == 0;
+  }
+  PoolAllocator::Statistics reused_statistics = PoolAllocator::get_statistics();
+  std::cout << "Reused blocks: " << reused << " of " << blocks.size() << ", chunks: " << allocated_statistics.chunks << " / " << reused_statistics.chunks << std::endl;
+  if (reused != (int)blocks.size() || reused_statistics.chunks != allocated_statistics.chunks || !zeroed)
+    success = false;
+
+  // Release with the pooling switched off - the pooled blocks go back to the pool.
+  PoolAllocator::set_pooling(false);
+  for (unsigned int i = 0; i < blocks.size(); i++)
+    PoolAllocator::deallocate(blocks[i]);
+  if (!check_released("Release without pooling", PoolAllocator::get_statistics(), initial_statistics))
+    success = false;
+
+  // Without the pooling, the blocks come from the heap.
+  char* heap_block = (char*)PoolAllocator::allocate(BLOCK_SIZE);
+  PoolAllocator::Statistics heap_statistics = PoolAllocator::get_statistics();
+  if (heap_statistics.heap_allocations != reused_statistics.heap_allocations + 1)
+    success = false;
+  PoolAllocator::set_pooling(true);
+  PoolAllocator::deallocate(heap_block);
+
+  // Large blocks come from the heap, and go back there.
+  char* large_block = (char*)PoolAllocator::allocate(LARGE_BLOCK_SIZE);
+  memset(large_block, 0, LARGE_BLOCK_SIZE);
+  PoolAllocator::deallocate(large_block);
+  PoolAllocator::Statistics final_statistics = PoolAllocator::get_statistics();
+  if (final_statistics.heap_allocations != heap_statistics.heap_allocations + 1)
+    success = false;
+  if (!check_released("Heap blocks", final_statistics, initial_statistics))
+    success = false;
+
+  // The array counterparts.
+  double* array = pool_calloc_with_check<double>(NUM_BLOCKS);
+  array[NUM_BLOCKS - 1] = 1.;
+  pool_free_with_check(array);
+  if (array != nullptr || !check_released("Arrays", PoolAllocator::get_statistics(), initial_statistics))
+    success = false;
+
+  PoolAllocator::dump_statistics();
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
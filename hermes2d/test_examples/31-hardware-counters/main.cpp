@@ -0,0 +1,124 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+using namespace Hermes::Hermes2D::WeakFormsH1;
+
+// This test checks the hardware counters (HardwareCounters) and their use in the profiler: where perf_event is not
+// available (other platforms, builds without WITH_PERF_EVENT, virtual machines without a PMU, perf_event_paranoid),
+// or only some events are, everything has to keep working - the unavailable counters read as zero, the reason is reported,
+// and the assembling with the counters read at the region boundaries gives the same matrix as without them.
+// Where the counters are available, they have to count.
+//
+// The following parameters can be changed:
+
+// Initial polynomial degree.
+const int P_INIT = 3;
+// Number of initial uniform mesh refinements.
+const int INIT_REF_NUM = 3;
+// Tolerance for the relative difference of the matrices.
+const double TOLERANCE = 1e-12;
+
+// Assembles the Poisson problem.
+void assemble(SpaceSharedPtr<double> space, CSCMatrix<double>& matrix)
+{
+  WeakFormSharedPtr<double> wf(new DefaultWeakFormPoisson<double>());
+  DiscreteProblem<double> dp(wf, space, true);
+  dp.assemble(&matrix);
+}
+
+int main(int argc, char* argv[])
+{
+  bool success = true;
+
+  // The counters.
+  HardwareCounters counters;
+  std::cout << "Hardware counters " << (counters.is_available() ? "available" : "not available") << (counters.get_error().empty() ? "" : ": ") << counters.get_error() << std::endl;
+
+  long long values[HardwareCounterCount], values_after_work[HardwareCounterCount];
+  counters.read(values);
+
+  MeshSharedPtr mesh(new Mesh);
+  MeshReaderH2D mloader;
+  mloader.load("domain.mesh", mesh);
+  for (int i = 0; i < INIT_REF_NUM; i++)
+    mesh->refine_all_elements();
+  SpaceSharedPtr<double> space(new H1Space<double>(mesh, P_INIT));
+  CSCMatrix<double> matrix;
+  assemble(space, matrix);
+
+  counters.read(values_after_work);
+
+  bool all_available = true;
+  for (int counter = 0; counter < HardwareCounterCount; counter++)
+  {
+    std::cout << HardwareCounters::get_name((HardwareCounter)counter) << ": " << (counters.is_available((HardwareCounter)counter) ? "" : "not available, ") << values_after_work[counter] - values[counter] << std::endl;
+    if (!counters.is_available((HardwareCounter)counter))
+    {
+      all_available = false;
+      // Unavailable counters read as zero.
+      if (values[counter] != 0 || values_after_work[counter] != 0)
+        success = false;
+    }
+    else if (values_after_work[counter] < values[counter])
+      success = false;
+  }
+
+  // The reason is reported for whatever is not available.
+  if (all_available != counters.get_error().empty())
+  {
+    std::cout << "The error does not correspond to the availability of the counters" << std::endl;
+    success = false;
+  }
+  if (counters.is_available() != counters.is_available(HardwareCounterCycles))
+    success = false;
+  if (counters.is_available() && values_after_work[HardwareCounterCycles] <= values[HardwareCounterCycles])
+  {
+    std::cout << "The cycles are not counting" << std::endl;
+    success = false;
+  }
+
+  // The profiler with the hardware counters.
+  Profiler::set_enabled(true);
+  Profiler::set_hardware_counters(true);
+  CSCMatrix<double> profiled_matrix;
+  assemble(space, profiled_matrix);
+  std::string error = Profiler::get_hardware_counters_error();
+  std::string summary = Profiler::get_hardware_counter_summary();
+  Profiler::set_hardware_counters(false);
+  Profiler::set_enabled(false);
+  Profiler::reset();
+
+  std::cout << summary;
+  if (error.empty() != counters.get_error().empty() || (!error.empty() && summary.find("not available") == std::string::npos))
+  {
+    std::cout << "The profiler does not report the availability of the counters" << std::endl;
+    success = false;
+  }
+
+  if (matrix.get_nnz() != profiled_matrix.get_nnz())
+    success = false;
+  else
+  {
+    double max_difference = 0., max_entry = 0.;
+    for (unsigned int i = 0; i < matrix.get_nnz(); i++)
+    {
+      max_difference = std::max(max_difference, std::abs(matrix.get_Ax()[i] - profiled_matrix.get_Ax()[i]));
+      max_entry = std::max(max_entry, std::abs(matrix.get_Ax()[i]));
+    }
+    std::cout << "Relative difference of the matrices: " << max_difference / max_entry << std::endl;
+    if (max_difference > TOLERANCE * max_entry)
+      success = false;
+  }
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
@@ -0,0 +1,176 @@
+#include "hermes2d.h"
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+
+// This test checks the assembling statistics (DiscreteProblem::get_assembly_statistics()) on a problem with known totals:
+// linear elements on a triangulated square without Dirichlet conditions, a nonsymmetric and a symmetric matrix form and a vector form.
+// Every triangle is one state with 3 basis functions, i.e. 9 pairs of the nonsymmetric form, 6 of the symmetric one (the lower
+// triangle is copied) and 3 test functions of the vector form, and both matrix forms insert 9 entries. The matrix has
+// one entry per vertex and two per edge.
+//
+// The following parameters can be changed:
+
+// Number of initial uniform mesh refinements.
+const int INIT_REF_NUM = 2;
+
+// u v
+class NonsymmetricForm : public MatrixFormVol<double>
+{
+public:
+  NonsymmetricForm() : MatrixFormVol<double>(0, 0) {}
+
+  virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *u, Func<double> *v, GeomVol<double> *e, Func<double> **ext) const
+  {
+    double result = 0.;
+    for (int i = 0; i < n; i++)
+      result += wt[i] * u->val[i] * v->val[i];
+    return result;
+  }
+
+  virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *u, Func<Ord> *v, GeomVol<Ord> *e, Func<Ord> **ext) const
+  {
+    return u->val[0] * v->val[0];
+  }
+
+  MatrixFormVol<double>* clone() const { return new NonsymmetricForm(*this); }
+};
+
+// grad u . grad v
+class SymmetricForm : public MatrixFormVol<double>
+{
+public:
+  SymmetricForm() : MatrixFormVol<double>(0, 0)
+  {
+    this->setSymFlag(HERMES_SYM);
+  }
+
+  virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *u, Func<double> *v, GeomVol<double> *e, Func<double> **ext) const
+  {
+    double result = 0.;
+    for (int i = 0; i < n; i++)
+      result += wt[i] * (u->dx[i] * v->dx[i] + u->dy[i] * v->dy[i]);
+    return result;
+  }
+
+  virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *u, Func<Ord> *v, GeomVol<Ord> *e, Func<Ord> **ext) const
+  {
+    return u->dx[0] * v->dx[0] + u->dy[0] * v->dy[0];
+  }
+
+  MatrixFormVol<double>* clone() const { return new SymmetricForm(*this); }
+};
+
+// x v
+class SourceForm : public VectorFormVol<double>
+{
+public:
+  SourceForm() : VectorFormVol<double>(0) {}
+
+  virtual double value(int n, double *wt, Func<double> *u_ext[], Func<double> *v, GeomVol<double> *e, Func<double> **ext) const
+  {
+    double result = 0.;
+    for (int i = 0; i < n; i++)
+      result += wt[i] * e->x[i] * v->val[i];
+    return result;
+  }
+
+  virtual Ord ord(int n, double *wt, Func<Ord> *u_ext[], Func<Ord> *v, GeomVol<Ord> *e, Func<Ord> **ext) const
+  {
+    return e->x[0] * v->val[0];
+  }
+
+  VectorFormVol<double>* clone() const { return new SourceForm(*this); }
+};
+
+class StatisticsWeakForm : public WeakForm<double>
+{
+public:
+  StatisticsWeakForm() : WeakForm<double>(1)
+  {
+    add_matrix_form(new NonsymmetricForm());
+    add_matrix_form(new SymmetricForm());
+    add_vector_form(new SourceForm());
+  }
+};
+
+// Compares a counter with its expected value.
+bool check(const char* name, unsigned long long value, unsigned long long expected_value)
+{
+  std::cout << name << ": " << value << " (expected " << expected_value << ")" << std::endl;
+  return value == expected_value;
+}
+
+int main(int argc, char* argv[])
+{
+  MeshSharedPtr mesh(new Mesh);
+  MeshReaderH2D mloader;
+  mloader.load("domain.mesh", mesh);
+  for (int i = 0; i < INIT_REF_NUM; i++)
+    mesh->refine_all_elements();
+
+  SpaceSharedPtr<double> space(new H1Space<double>(mesh, 1));
+  WeakFormSharedPtr<double> wf(new StatisticsWeakForm());
+
+  DiscreteProblem<double> dp(wf, space, true);
+  CSCMatrix<double> matrix;
+  SimpleVector<double> rhs;
+  dp.assemble(&matrix, &rhs);
+  const AssemblyStatistics& statistics = dp.get_assembly_statistics();
+  statistics.dump();
+
+  // The expected totals - the vertices are the DOFs, the edges follow from the Euler formula.
+  unsigned long long num_elements = mesh->get_num_active_elements();
+  unsigned long long num_vertices = space->get_num_dofs();
+  unsigned long long num_edges = num_vertices + num_elements - 1;
+  const unsigned long long pairs_per_element = 9 + 6, functions_per_element = 3, inserted_per_element = 9 + 9;
+
+  bool success = true;
+
+  if (!check("States", statistics.states, num_elements))
+    success = false;
+  if (!check("Form evaluations", statistics.form_evaluations, (pairs_per_element + functions_per_element) * num_elements))
+    success = false;
+  if (!check("Kernel evaluations", statistics.kernel_evaluations, 0))
+    success = false;
+  if (!check("Inserted nonzeros", statistics.inserted_nonzeros, inserted_per_element * num_elements))
+    success = false;
+  if (!check("Structural nonzeros", statistics.structural_nonzeros, num_vertices + 2 * num_edges)
+    || statistics.structural_nonzeros != matrix.get_nnz())
+    success = false;
+
+  // All states are triangles, so the quadrature points follow from the histogram of the orders.
+  unsigned long long states_per_order = 0, quadrature_points = 0;
+  for (unsigned int order = 0; order < statistics.states_per_order.size(); order++)
+  {
+    states_per_order += statistics.states_per_order[order];
+    if (statistics.states_per_order[order] > 0)
+      quadrature_points += (unsigned long long)statistics.states_per_order[order] * g_quad_2d_std.get_num_points(order, HERMES_MODE_TRIANGLE);
+  }
+  if (!check("States in the histogram of the orders", states_per_order, num_elements))
+    success = false;
+  if (!check("Quadrature points", statistics.quadrature_points, (pairs_per_element + functions_per_element) * quadrature_points))
+    success = false;
+
+  // The totals are the sums over the threads.
+  AssemblyCounters thread_totals;
+  for (unsigned int thread_i = 0; thread_i < statistics.threads.size(); thread_i++)
+    thread_totals.add(statistics.threads[thread_i]);
+  if (statistics.threads.empty() || thread_totals.states != statistics.states || thread_totals.form_evaluations != statistics.form_evaluations
+    || thread_totals.quadrature_points != statistics.quadrature_points || thread_totals.inserted_nonzeros != statistics.inserted_nonzeros)
+  {
+    std::cout << "The totals are not the sums over the threads" << std::endl;
+    success = false;
+  }
+
+  if (success)
+  {
+    std::cout << "Success!" << std::endl;
+    return 0;
+  }
+  else
+  {
+    std::cout << "Failure!" << std::endl;
+    return -1;
+  }
+}
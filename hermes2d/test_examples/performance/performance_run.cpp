@@ -0,0 +1,97 @@
+#include "performance_run.h"
+#include <cstdlib>
+#include <fstream>
+
+using namespace Hermes;
+using namespace Hermes::Hermes2D;
+
+#ifdef WITH_PROFILER
+// The profiler regions making up the phases.
+static const char* assembly_regions[] = { "DiscreteProblem::assemble", nullptr };
+// The factorizations are nested in the solves.
+static const char* solve_regions[] = { "UMFPack::solve", "SuperLU::solve", "MUMPS::solve", "Paralution::solve", "PETSc::solve", "AztecOO::solve", "Amesos::solve", nullptr };
+static const char* adapt_regions[] = { "ErrorCalculator::calculate_errors", "Adapt::adapt", nullptr };
+static const char* output_regions[] = { "Linearizer::process_solution", nullptr };
+
+static double phase_time(const char** regions)
+{
+  double time = 0.;
+  for (int i = 0; regions[i]; i++)
+    time += Profiler::get_total_time(regions[i]);
+  return time;
+}
+#endif
+
+bool performance_mode()
+{
+  static const bool mode = (getenv("HERMES_PERFORMANCE_OUTPUT") != nullptr);
+  return mode;
+}
+
+PerformanceRun::PerformanceRun(const char* example) : example(example), last_ndofs(0), max_ndofs(0)
+{
+  if (performance_mode())
+  {
+    Profiler::set_tracing(false);
+    Profiler::reset();
+    Profiler::set_enabled(true);
+  }
+  this->wall_time.reset();
+}
+
+void PerformanceRun::record_dofs(int ndofs)
+{
+  this->last_ndofs = ndofs;
+  this->max_ndofs = std::max(this->max_ndofs, ndofs);
+}
+
+void PerformanceRun::process_output(MeshFunctionSharedPtr<double> sln)
+{
+  if (!performance_mode())
+    return;
+
+  Views::Linearizer linearizer(FileExport);
+  linearizer.process_solution(sln);
+}
+
+int PerformanceRun::finish(int return_code)
+{
+  if (!performance_mode())
+    return return_code;
+
+  this->wall_time.tick();
+  Profiler::set_enabled(false);
+
+  const char* filename = getenv("HERMES_PERFORMANCE_OUTPUT");
+  std::ofstream out(filename);
+  if (!out.good())
+  {
+    std::cerr << "Cannot write the performance record " << filename << std::endl;
+    return -1;
+  }
+
+  out.precision(9);
+  out << "{" << std::endl;
+  out << "  \"example\": \"" << this->example << "\"," << std::endl;
+  out << "  \"return_code\": " << return_code << "," << std::endl;
+  out << "  \"wall_time\": " << this->wall_time.accumulated() << "," << std::endl;
+#ifdef WITH_PROFILER
+  out << "  \"phases\": {" << std::endl;
+  out << "    \"assembly\": " << phase_time(assembly_regions) << "," << std::endl;
+  out << "    \"solve\": " << phase_time(solve_regions) << "," << std::endl;
+  out << "    \"adapt\": " << phase_time(adapt_regions) << "," << std::endl;
+  out << "    \"output\": " << phase_time(output_regions) << std::endl;
+  out << "  }," << std::endl;
+  out << "  \"nonlinear_iterations\": " << Profiler::get_total_calls("NonlinearSolver::linear_system") << "," << std::endl;
+#else
+  // Without the profiler regions, only the totals are available.
+  out << "  \"phases\": null," << std::endl;
+  out << "  \"nonlinear_iterations\": null," << std::endl;
+#endif
+  out << "  \"dofs\": " << this->last_ndofs << "," << std::endl;
+  out << "  \"max_dofs\": " << this->max_ndofs << "," << std::endl;
+  out << "  \"peak_rss\": " << HermesCommonApi.get_peak_resident_set_size() << std::endl;
+  out << "}" << std::endl;
+
+  return return_code;
+}
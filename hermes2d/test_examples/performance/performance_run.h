@@ -0,0 +1,53 @@
+#ifndef __H2D_TEST_EXAMPLES_PERFORMANCE_RUN_H
+#define __H2D_TEST_EXAMPLES_PERFORMANCE_RUN_H
+
+#include "hermes2d.h"
+
+// Performance mode of the test examples.
+//
+// When the environment variable HERMES_PERFORMANCE_OUTPUT is set (to a file name), the instrumented examples
+// run with larger fixed problem sizes and without the interactive visualization, and write a JSON record
+// of the run into that file:
+// - the per-phase times (assembly, solve, adapt, output) from the profiler regions (needs WITH_PROFILER),
+// - the (final and maximal) number of DOFs,
+// - the number of nonlinear (Newton, Picard) iterations,
+// - the total wall time and the peak resident set size of the process.
+// The records are collected and compared against a stored baseline by performance/run_performance.py.
+
+/// True if the examples run in the performance mode.
+bool performance_mode();
+
+/// Parameter value - normal, or the (larger) one for the performance mode.
+template<typename T>
+T performance_choice(T normal, T performance)
+{
+  return performance_mode() ? performance : normal;
+}
+
+/// Record of one run of an example.
+/// Create it at the beginning of main(), report the problem size by record_dofs() and return finish(code).
+class PerformanceRun
+{
+public:
+  /// Enables the profiler (in the performance mode) and starts the wall time measurement.
+  PerformanceRun(const char* example);
+
+  /// Reports the current number of DOFs.
+  void record_dofs(int ndofs);
+
+  /// The output phase - linearizes the solution (in the performance mode only, without writing any file).
+  /// Stands for the visualization, which is switched off in the performance mode.
+  void process_output(Hermes::Hermes2D::MeshFunctionSharedPtr<double> sln);
+
+  /// Writes the record (in the performance mode).
+  /// \return return_code - to be returned from main().
+  int finish(int return_code);
+
+private:
+  std::string example;
+  Hermes::Mixins::TimeMeasurable wall_time;
+  int last_ndofs;
+  int max_ndofs;
+};
+
+#endif
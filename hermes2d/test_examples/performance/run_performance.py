@@ -0,0 +1,196 @@
+#!/usr/bin/env python
+"""Performance regression check of the test examples.
+
+Runs the instrumented examples in the performance mode (see performance_run.h), collects their records
+(per-phase times, DOFs, nonlinear iterations, peak RSS) into one JSON file and compares them against
+a stored baseline. Exits with 1 if a time or the memory grew over the tolerance, or if an example failed.
+
+Usage:
+  run_performance.py --build-dir <build>/hermes2d/test_examples [--examples 01-poisson,08-nonlinearity]
+                     [--baseline baseline.json] [--output results.json]
+                     [--time-tolerance 0.15] [--memory-tolerance 0.10] [--min-time 0.05]
+                     [--update-baseline]
+
+The baseline is machine specific - create it by --update-baseline on the machine running the checks.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+EXAMPLES = [
+    "01-poisson",
+    "02-poisson-newton",
+    "03-navier-stokes",
+    "04-complex-adapt",
+    "05-hcurl-adapt",
+    "06-system-adapt",
+    "07-newton-heat-rk",
+    "08-nonlinearity",
+    "09-sparkgap",
+    "09b-sparkgap-adaptive",
+    "10-linear-advection-dg-adapt",
+    "11-transient-adapt",
+    "12-picard",
+    "13-FCT",
+]
+
+# Examples built only with an optional dependency - skipped if not built.
+OPTIONAL_EXAMPLES = [
+    "14-trilinos-nonlinear",
+]
+
+PHASES = ["assembly", "solve", "adapt", "output"]
+
+SOURCE_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def find_executable(build_dir, example):
+    name = example + (".exe" if os.name == "nt" else "")
+    for subdir in ["", "Release", "RelWithDebInfo", "Debug"]:
+        path = os.path.join(build_dir, example, subdir, name)
+        if os.path.isfile(path):
+            return os.path.abspath(path)
+    return None
+
+
+def run_example(build_dir, example):
+    executable = find_executable(build_dir, example)
+    if executable is None:
+        print("%s: executable not found in %s" % (example, build_dir))
+        return None
+
+    handle, record_file = tempfile.mkstemp(suffix=".json")
+    os.close(handle)
+    env = dict(os.environ)
+    env["HERMES_PERFORMANCE_OUTPUT"] = record_file
+    try:
+        # The examples load their meshes from the current directory.
+        with open(os.devnull, "w") as devnull:
+            return_code = subprocess.call([executable], cwd=os.path.join(SOURCE_DIR, example), env=env,
+                                          stdout=devnull, stderr=devnull)
+        if os.path.getsize(record_file) == 0:
+            print("%s: no performance record written (return code %d)" % (example, return_code))
+            return None
+        with open(record_file) as f:
+            record = json.load(f)
+        if return_code != 0:
+            record["return_code"] = return_code
+        return record
+    finally:
+        os.remove(record_file)
+
+
+def compare_value(name, current, baseline, tolerance, min_value):
+    """Returns a regression message, or None."""
+    if current is None or baseline is None:
+        return None
+    # Values under min_value are dominated by noise.
+    if max(current, baseline) < min_value:
+        return None
+    if current > baseline * (1. + tolerance):
+        return "%s: %g -> %g (+%.1f%%, tolerance %.1f%%)" % (name, baseline, current,
+                                                              100. * (current / baseline - 1.) if baseline > 0 else float("inf"),
+                                                              100. * tolerance)
+    return None
+
+
+def compare(record, baseline, args):
+    regressions = []
+    if record["return_code"] != 0:
+        regressions.append("return code %d" % record["return_code"])
+
+    message = compare_value("wall_time", record["wall_time"], baseline.get("wall_time"), args.time_tolerance, args.min_time)
+    if message:
+        regressions.append(message)
+
+    phases = record.get("phases") or {}
+    baseline_phases = baseline.get("phases") or {}
+    for phase in PHASES:
+        message = compare_value(phase, phases.get(phase), baseline_phases.get(phase), args.time_tolerance, args.min_time)
+        if message:
+            regressions.append(message)
+
+    message = compare_value("peak_rss", record["peak_rss"], baseline.get("peak_rss"), args.memory_tolerance, 0)
+    if message:
+        regressions.append(message)
+
+    # A change of the problem (DOFs, iterations) makes the times incomparable - reported, not failed.
+    notes = []
+    for key in ["dofs", "max_dofs", "nonlinear_iterations"]:
+        if record.get(key) != baseline.get(key):
+            notes.append("%s: %s -> %s" % (key, baseline.get(key), record.get(key)))
+
+    return regressions, notes
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Performance regression check of the test examples.")
+    parser.add_argument("--build-dir", required=True, help="build directory of the test examples")
+    parser.add_argument("--examples", default=",".join(EXAMPLES + OPTIONAL_EXAMPLES), help="comma-separated list of the examples")
+    parser.add_argument("--baseline", default=os.path.join(os.path.dirname(os.path.abspath(__file__)), "baseline.json"))
+    parser.add_argument("--output", help="file to write the records of this run to")
+    parser.add_argument("--time-tolerance", type=float, default=0.15, help="allowed relative growth of the times")
+    parser.add_argument("--memory-tolerance", type=float, default=0.10, help="allowed relative growth of the peak RSS")
+    parser.add_argument("--min-time", type=float, default=0.05, help="times [s] below this are not compared")
+    parser.add_argument("--update-baseline", action="store_true", help="store the records of this run as the baseline")
+    args = parser.parse_args()
+
+    records = {}
+    failed = False
+    for example in args.examples.split(","):
+        if example in OPTIONAL_EXAMPLES and find_executable(args.build_dir, example) is None:
+            print("Skipping %s (not built)." % example)
+            continue
+        print("Running %s..." % example)
+        sys.stdout.flush()
+        record = run_example(args.build_dir, example)
+        if record is None:
+            failed = True
+            continue
+        records[example] = record
+        print("  wall %.3f s, %d DOFs, peak RSS %.1f MB" % (record["wall_time"], record["dofs"], record["peak_rss"] / 1048576.))
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(records, f, indent=2, sort_keys=True)
+
+    if args.update_baseline:
+        baseline = {}
+        if os.path.isfile(args.baseline):
+            with open(args.baseline) as f:
+                baseline = json.load(f)
+        baseline.update(records)
+        with open(args.baseline, "w") as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+        print("Baseline %s updated." % args.baseline)
+        return 1 if failed else 0
+
+    if not os.path.isfile(args.baseline):
+        print("No baseline %s - run with --update-baseline to create it." % args.baseline)
+        return 1 if failed else 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+
+    for example in sorted(records):
+        if example not in baseline:
+            print("%s: not in the baseline" % example)
+            continue
+        regressions, notes = compare(records[example], baseline[example], args)
+        for note in notes:
+            print("%s: problem changed, %s" % (example, note))
+        for regression in regressions:
+            print("%s: REGRESSION %s" % (example, regression))
+        if regressions:
+            failed = True
+
+    print("Failure!" if failed else "Success!")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
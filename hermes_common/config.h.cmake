@@ -24,6 +24,9 @@
 #cmakedefine WITH_PJLIB
 #cmakedefine WITH_BSON
 #cmakedefine WITH_MATIO
+#cmakedefine WITH_ZLIB
+#cmakedefine WITH_PROFILER
+#cmakedefine WITH_PERF_EVENT
 #cmakedefine MONGO_STATIC_BUILD
 #cmakedefine UMFPACK_LONG_INT
 
@@ -43,6 +43,12 @@ namespace Hermes
       /// @param[in] ax values
       void create(unsigned int size, unsigned int nnz, int* ap, int* ai, Scalar* ax);
 
+      /// Allocates the matrix with the sparse structure (Ap, Ai) of another matrix, all entries are zero.
+      /// Cheap alternative to prealloc() - pre_add_ij() - alloc() for matrices known to share the structure.
+      /// The structure arrays are not copied, but shared - they are freed with the last matrix using them.
+      /// @param[in] other matrix of the same orientation (CSC / CSR) with allocated structure
+      void alloc_with_structure(CSMatrix<Scalar>* other);
+
       /// Finds the correct position to insert / retrieve elements.
       static int find_position(int *Ai, int Alen, unsigned int idx);
 
@@ -121,6 +127,15 @@ namespace Hermes
       int *Ap;
       /// Number of non-zero entries ( =  Ap[size]).
       unsigned int nnz;
+      /// Number of matrices sharing Ap, Ai (see alloc_with_structure()), nullptr if not shared.
+      int* structure_references;
+      /// Stops using Ap, Ai - frees them, unless they are still shared with another matrix.
+      void release_structure();
+      /// Bytes of Ap, Ai, Ax reported to the memory accounting (HermesCommonApi).
+      /// A shared structure is reported once, by alloc_with_structure() and by the last release_structure().
+      long long memory_accounted;
+      /// Reports the change of the size of Ap, Ai, Ax to the memory accounting.
+      void update_memory_accounting();
       template<typename T> friend SparseMatrix<T>*  create_matrix();
     };
 
@@ -40,6 +40,24 @@ namespace Hermes
     useAccelerators
   };
 
+  /// Enumeration of categories of the memory accounting (Api::account_memory()).
+  enum HermesMemoryCategory
+  {
+    /// Shared precalculated shape function values (PrecalcShapesetAssembling).
+    memoryPrecalcTables,
+    /// Coefficient tables of Solution instances.
+    memorySolutionTables,
+    /// Stored reference mapping geometry (GeometryStore).
+    memoryRefMapCaches,
+    /// Node tables of meshes (HashTable).
+    memoryMeshHashTables,
+    /// Storage of CSMatrix instances.
+    memoryMatrixStorage,
+    /// Per-thread clones of solutions made by Adapt.
+    memoryAdaptClones,
+    HermesMemoryCategoryCount
+  };
+
   /// API Class containing settings for the whole HermesCommon.
   class HERMES_API Api
   {
@@ -89,10 +107,64 @@ namespace Hermes
     /// Also used in destructor.
     std::map<std::pair<HermesCommonApiParam, int>, SetterHandler> change_handlers;
 
+    /// Memory accounting - current & peak bytes per category.
+    long long memory_usage[HermesMemoryCategoryCount];
+    long long memory_peak[HermesMemoryCategoryCount];
+    /// Soft limits, 0 means no limit.
+    size_t memory_limits[HermesMemoryCategoryCount];
+    /// Number of running uses of the evictable caches, see begin_cache_use().
+    int cache_users;
+
   public:
     int get_integral_param_value(HermesCommonApiParam);
     void set_integral_param_value(HermesCommonApiParam, int value);
 
+    /// Memory accounting.
+    /// Caches and large storages report the changes of their size here - thread-safe.
+    /// \param[in] bytes Positive when allocated, negative when freed.
+    void account_memory(HermesMemoryCategory category, long long bytes);
+    /// Currently accounted bytes in a category.
+    long long get_memory_usage(HermesMemoryCategory category) const;
+    /// Peak of the accounted bytes in a category.
+    long long get_memory_peak(HermesMemoryCategory category) const;
+    /// Text report of the current, peak and limit bytes per category.
+    std::string get_memory_report() const;
+    /// Peak resident set size of the process [bytes], as reported by the operating system (0 if not available).
+    /// Unlike the accounting above, it covers all the memory of the process.
+    size_t get_peak_resident_set_size() const;
+
+    /// Sets a soft limit of a category (0 - no limit, the default).
+    /// When a category is over its limit, its caches do not grow (they calculate the values instead of storing them),
+    /// and enforce_memory_limits() evicts them.
+    void set_memory_limit(HermesMemoryCategory category, size_t bytes);
+    size_t get_memory_limit(HermesMemoryCategory category) const;
+    /// True if a category is over its soft limit.
+    bool memory_limit_exceeded(HermesMemoryCategory category) const;
+
+    /// Evictor type - empties (the evictable part of) a cache identified by owner.
+    typedef void(*MemoryEvictor)(void* owner);
+    /// Registers an evictor of a cache.
+    void register_memory_evictor(HermesMemoryCategory category, MemoryEvictor evictor, void* owner);
+    /// Unregisters all evictors of owner.
+    void unregister_memory_evictor(HermesMemoryCategory category, void* owner);
+    /// Calls the evictors of the categories over their soft limits, until they are below.
+    /// The caches are shared by all problems, so Hermes never calls this itself - call it between the computations,
+    /// when no other thread uses Hermes (e.g. between time steps or adaptivity steps).
+    /// While any DiscreteProblem is assembling (see begin_cache_use()), it does nothing and returns 0.
+    /// \return The number of evictors called.
+    unsigned int enforce_memory_limits();
+
+    /// Marks the start / end of a use of the evictable caches (DiscreteProblem::assemble() does this around
+    /// the parallel assembling), enforce_memory_limits() waits for a running eviction and does not evict during a use.
+    void begin_cache_use();
+    void end_cache_use();
+
+  protected:
+    /// Registered evictors.
+    std::vector<std::pair<MemoryEvictor, void*> > memory_evictors[HermesMemoryCategoryCount];
+
+  public:
+
 #if defined __GNUC__ && defined HAVE_BFD
     struct sigaction act;
 #endif
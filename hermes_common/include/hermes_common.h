@@ -47,6 +47,9 @@
 #include "data_structures/range.h"
 #include "util/qsort.h"
 #include "util/memory_handling.h"
+#include "util/profiler.h"
+#include "util/hardware_counters.h"
+#include "util/mpi_communication.h"
 #include "ord.h"
 #include "mixins.h"
 #include "api.h"
@@ -101,6 +101,7 @@ namespace Hermes
       void multiply_with_Scalar(Scalar value);
 
       /// Applies the matrix to vector_in and saves result to vector_out.
+      /// With a distributed matrix (set_distributed()), the products of the parts are summed over the ranks - all ranks have to call this.
       void multiply_with_vector(Scalar* vector_in, Scalar*& vector_out, bool vector_out_initialized = false) const;
 
       /// Creates matrix using size, nnz, and the three arrays.
@@ -109,7 +110,16 @@ namespace Hermes
       /// Duplicates a matrix (including allocation).
       CSMatrix<Scalar>* duplicate() const;
 
+      /// Marks the matrix as the part assembled on this MPI rank (see MpiCommunication) - the matrix of the system
+      /// is the sum of the parts of all ranks, MumpsSolver passes the parts as the distributed assembled matrix (ICNTL(18) = 3).
+      /// Set by the distributed assembling (DiscreteProblem::set_mesh_partition()).
+      void set_distributed(bool to_set);
+      bool is_distributed() const;
+
     protected:
+      /// See set_distributed().
+      bool distributed;
+
       /// Row indices.
       int *irn;
       /// Column indices.
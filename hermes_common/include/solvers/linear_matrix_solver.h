@@ -91,6 +91,23 @@ namespace Hermes
     template <typename Scalar> class IterSolver;
     template <typename Scalar> class AMGSolver;
 
+    /// \brief Statistics of the solve() calls of a LinearMatrixSolver (since its creation, or reset_statistics()).
+    /// The factorizations are reported by the direct solvers (reused factorizations are not counted);
+    /// where the library does the factorization and the substitution in one call (MUMPS), the time of that call is the factorization time.
+    struct HERMES_API LinearMatrixSolverStatistics
+    {
+      LinearMatrixSolverStatistics();
+      /// Calls of solve() and their total time [s] (factorizations included).
+      unsigned int solves;
+      double solve_time;
+      /// Factorizations and their total time [s].
+      unsigned int factorizations;
+      double factorization_time;
+      /// Memory of the factors of the last factorization and the peak over all of them [bytes], 0 if the library does not tell.
+      size_t factorization_memory;
+      size_t peak_factorization_memory;
+    };
+
     /// \brief Abstract class for defining solver interface.
     ///
     ///\todo Adjust interface to support faster update of matrix and rhs
@@ -128,6 +145,10 @@ namespace Hermes
       /// Get size of matrix
       virtual int get_matrix_size() = 0;
 
+      /// Statistics of the solve() calls.
+      const LinearMatrixSolverStatistics& get_statistics() const;
+      void reset_statistics();
+
       /// Get factorization scheme.
       virtual MatrixStructureReuseScheme get_used_reuse_scheme() const;
 
@@ -161,6 +182,13 @@ namespace Hermes
       ///< Time spent on solving (in secs).
       double time;
 
+      /// See get_statistics().
+      LinearMatrixSolverStatistics statistics;
+      /// Adds a solve() call that took time seconds.
+      void record_solve(double time);
+      /// Adds a factorization that took time seconds, its factors take memory bytes (0 if unknown).
+      void record_factorization(double time, size_t memory);
+
       /// Number of equations in a system of PDEs.
       unsigned int n_eq;
 
@@ -150,6 +150,18 @@ namespace Hermes
       void set_max_steps_with_reused_jacobian(unsigned int steps);
 #pragma endregion
 
+      /// Turn on / off the overlapped execution of the assembling and the linear solver.
+      /// It applies to the iterations that recalculate the Jacobian (it is not reusable, or set_max_steps_with_reused_jacobian(0)), with a direct linear solver:
+      /// the Jacobian of the new iterate is assembled before the damping factor handling and factorized in a background thread,
+      /// while the residual for the damping factor handling is assembled. If the iterate is accepted without damping, only the substitution remains,
+      /// otherwise the factorization is thrown away and the damped iterates are handled as without this option.
+      /// The solver has to support assembling the residual into another vector (supports_task_overlap()), it is ignored otherwise.
+      /// Default: false.
+      void set_task_overlap(bool to_set);
+
+      /// Get the number of iterations of the last solve() whose Jacobian was factorized overlapped with the assembling, see set_task_overlap().
+      unsigned int get_num_overlapped_iters() const;
+
       /// Frees the instances.
       virtual void free();
 
@@ -192,6 +204,27 @@ namespace Hermes
       virtual bool assemble_jacobian(bool store_previous_jacobian) = 0;
       virtual bool assemble(bool store_previous_jacobian, bool store_previous_residual) = 0;
 
+#pragma region task_overlap-private
+      /// See set_task_overlap().
+      bool task_overlap;
+      /// See get_num_overlapped_iters().
+      unsigned int num_overlapped_iters;
+
+      /// Whether assemble_residual_into() is implemented.
+      virtual bool supports_task_overlap() const;
+      /// Assemble the residual as assemble_residual() does, only into the vector residual instead of the right-hand side of the linear solver.
+      virtual void assemble_residual_into(Vector<Scalar>* residual);
+      /// Whether the linear solver can factorize in a background thread - a direct solver, not with a distributed matrix
+      /// (its factorization is collective, as is the summing of the residual during the assembling),
+      /// and the MPI-based solvers (MUMPS, PETSc) only if MPI allows concurrent calls (MpiCommunication::supports_concurrent_calls()).
+      bool linear_solver_supports_task_overlap();
+      /// Assemble the Jacobian, factorize it in a background thread, and assemble the residual meanwhile.
+      /// Afterwards, the factorization is ready to be reused (HERMES_REUSE_MATRIX_STRUCTURE_COMPLETELY).
+      /// The thread is not profiled (the profiler keeps the data of every thread), the profiled regions on the calling thread
+      /// are the whole overlapped part and the wait for the factorization.
+      void assemble_with_overlapped_factorization();
+#pragma endregion
+
       /// \return Whether or not should the processing continue.
       virtual void on_damping_factor_updated();
       /// \return Whether or not should the processing continue.
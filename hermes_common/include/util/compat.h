@@ -72,6 +72,13 @@ FILE *fmemopen(void *buf, size_t size, const char *opentype);
 #define strcasecmp strcmp
 #endif
 
+// Thread-local storage of plain (POD) variables.
+#ifdef _MSC_VER
+#define HERMES_THREAD_LOCAL __declspec(thread)
+#else
+#define HERMES_THREAD_LOCAL __thread
+#endif
+
 #ifdef __GNUC__
 #define NORETURN __attribute__((noreturn))
 #else
@@ -0,0 +1,80 @@
+// This file is part of HermesCommon
+//
+// Copyright (c) 2009 hp-FEM group at the University of Nevada, Reno (UNR).
+// Email: hpfem-group@unr.edu, home page: http://www.hpfem.org/.
+//
+// Hermes2D is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation; either version 2 of the License,
+// or (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+/*! \file hardware_counters.h
+\brief Hardware performance counters (Linux perf_event).
+*/
+#ifndef __HERMES_COMMON_HARDWARE_COUNTERS_H_
+#define __HERMES_COMMON_HARDWARE_COUNTERS_H_
+
+#include "util/compat.h"
+#include <string>
+
+namespace Hermes
+{
+  /// Counted hardware events.
+  enum HardwareCounter
+  {
+    HardwareCounterCycles,
+    HardwareCounterInstructions,
+    HardwareCounterBranches,
+    HardwareCounterBranchMisses,
+    HardwareCounterL1DAccesses,
+    HardwareCounterL1DMisses,
+    HardwareCounterLLCAccesses,
+    HardwareCounterLLCMisses,
+    HardwareCounterCount
+  };
+
+  /// \brief Hardware performance counters of the calling thread.
+  /// Opened by perf_event_open (Linux, WITH_PERF_EVENT), user space only, in two groups - the core events
+  /// (cycles, instructions, branches) and the cache events - so that every group fits into the counters of the PMU.
+  /// When the kernel multiplexes the groups, the values are scaled by the enabled / running times.
+  ///
+  /// The counters count the thread that created the instance, read() is to be called by that thread.
+  /// When the counters can not be opened (other platforms, no PMU in a virtual machine, perf_event_paranoid,
+  /// a missing cache event), the affected values read as zero and get_error() tells why.
+  class HERMES_COMMON_API HardwareCounters
+  {
+  public:
+    HardwareCounters();
+    ~HardwareCounters();
+
+    /// True if (at least the core) counters are counting.
+    bool is_available() const;
+    /// True if the given counter is counting.
+    bool is_available(HardwareCounter counter) const;
+    /// Why some counters are not available (empty if all are).
+    const std::string& get_error() const;
+
+    /// Reads the current values of all counters.
+    /// \param[out] values HardwareCounterCount values, zero for the unavailable counters.
+    void read(long long* values) const;
+
+    static const char* get_name(HardwareCounter counter);
+
+  private:
+    static const int group_count = 2;
+    /// File descriptors of the events, -1 if not opened.
+    int fds[HardwareCounterCount];
+    /// Group leaders (indices into fds), -1 if the group is not available.
+    int group_leaders[group_count];
+    std::string error;
+  };
+}
+#endif
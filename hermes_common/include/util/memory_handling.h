@@ -26,6 +26,10 @@
 #include "exceptions.h"
 #include "api.h"
 #include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <vector>
 
 // If C++ 11 is not supported
 namespace std
@@ -47,6 +51,88 @@ namespace std
 }
 namespace Hermes
 {
+  /// \brief Allocator for the frequently allocated and freed objects of assembling (Func, AsmList, reversed neighbor values in DG).
+  /// Every thread has its own cache of free blocks in size classes (16-byte steps up to 256 bytes, then four classes per doubling
+  /// up to 256 kB, so that e.g. Func<double> / Func<std::complex<double> > objects waste at most a quarter), refilled from
+  /// 64 kB chunks taken from the heap. No locks are taken, except for the (one-time) registration of a new thread cache.
+  /// Blocks may be freed by any thread, they then go to the cache of the freeing thread. Larger requests go directly to the heap.
+  /// Chunks are never returned to the heap, a thread cache keeps the peak of its thread.
+  class HERMES_COMMON_API PoolAllocator
+  {
+  public:
+    /// Uninitialized memory, 16-byte aligned.
+    static void* allocate(size_t size);
+    /// Zeroed memory.
+    static void* callocate(size_t size);
+    /// Memory from allocate() / callocate(), nullptr is allowed.
+    static void deallocate(void* ptr);
+
+    /// Pooling (default: on). Off means every allocate() goes directly to the heap (for comparison, and for memory checkers).
+    /// Can be switched at any time, deallocate() handles both kinds of blocks.
+    static void set_pooling(bool to_set);
+
+    /// Totals over all threads.
+    struct HERMES_COMMON_API Statistics
+    {
+      Statistics();
+      /// Calls of allocate() / deallocate().
+      unsigned long long allocations, deallocations;
+      /// Of which served from / to the heap directly.
+      unsigned long long heap_allocations, heap_deallocations;
+      /// Chunks taken from the heap and their total size.
+      unsigned long long chunks, chunk_bytes;
+      /// Blocks currently in use (pooled).
+      long long blocks_in_use;
+      /// Thread caches.
+      unsigned int thread_caches;
+    };
+    /// Reads the per-thread counters without synchronization - exact only when no thread allocates.
+    static Statistics get_statistics();
+    /// Prints the totals and the per size class counts.
+    static void dump_statistics(FILE* out = stdout);
+  };
+
+  /// PoolAllocator array counterparts of malloc_with_check(), calloc_with_check() and free_with_check().
+  template<typename ArrayItem>
+  ArrayItem* pool_malloc_with_check(int size)
+  {
+    if (size == 0)
+      return nullptr;
+    ArrayItem* new_array = (ArrayItem*)PoolAllocator::allocate(size * sizeof(ArrayItem));
+    if (!new_array)
+      throw Hermes::Exceptions::Exception("Hermes::pool_malloc_with_check() failed to allocate %i bytes.", size * sizeof(ArrayItem));
+    return new_array;
+  }
+
+  template<typename ArrayItem>
+  ArrayItem* pool_calloc_with_check(int size)
+  {
+    if (size == 0)
+      return nullptr;
+    ArrayItem* new_array = (ArrayItem*)PoolAllocator::callocate(size * sizeof(ArrayItem));
+    if (!new_array)
+      throw Hermes::Exceptions::Exception("Hermes::pool_calloc_with_check() failed to allocate %i bytes.", size * sizeof(ArrayItem));
+    return new_array;
+  }
+
+  template<typename ArrayItem>
+  void pool_free_with_check(ArrayItem*& ptr)
+  {
+    if (ptr)
+    {
+      PoolAllocator::deallocate(ptr);
+      ptr = nullptr;
+    }
+  }
+
+/// Class-specific operators new / delete taking instances of a class from PoolAllocator.
+/// The placement forms are there so that the class can still be constructed in a MemoryArena.
+#define HERMES_POOL_ALLOCATED \
+    static void* operator new(size_t size) { void* ptr = Hermes::PoolAllocator::allocate(size); if (!ptr) throw std::bad_alloc(); return ptr; } \
+    static void operator delete(void* ptr) { Hermes::PoolAllocator::deallocate(ptr); } \
+    static void* operator new(size_t, void* place) { return place; } \
+    static void operator delete(void*, void*) {}
+
 #ifdef WITH_PJLIB
   HERMES_COMMON_API extern pj_caching_pool HermesCommonMemoryPoolCache;
   class GlobalPoolCache
@@ -290,5 +376,83 @@ namespace Hermes
       }
     }
   }
+
+  /// \brief Bump allocator for short-lived temporaries of one thread (e.g. everything allocated while assembling one state).
+  /// Memory is handed out from large blocks by advancing an offset, reset() releases all of it at once in O(1).
+  /// The blocks are kept, so once the arena has grown to the peak size, no more heap allocations happen.
+  /// Destructors of objects created in the arena are never called - use it only for data that do not own other memory.
+  /// Not thread-safe - one instance per thread.
+  class HERMES_COMMON_API MemoryArena
+  {
+  public:
+    /// \param[in] block_size Size of one block in bytes, larger requests get a block of their own size.
+    MemoryArena(size_t block_size = 256 * 1024);
+    ~MemoryArena();
+
+    /// Uninitialized, 16-byte aligned memory.
+    void* allocate(size_t size);
+
+    /// Uninitialized array.
+    template<typename ArrayItem>
+    ArrayItem* allocate_array(int count)
+    {
+      if (count == 0)
+        return nullptr;
+      return (ArrayItem*)this->allocate(count * sizeof(ArrayItem));
+    }
+
+    /// Zeroed array.
+    template<typename ArrayItem>
+    ArrayItem* calloc_array(int count)
+    {
+      ArrayItem* new_array = this->allocate_array<ArrayItem>(count);
+      if (new_array)
+        memset(new_array, 0, count * sizeof(ArrayItem));
+      return new_array;
+    }
+
+    /// Object constructed in the arena (placement new), never destructed.
+    template<typename T>
+    T* create()
+    {
+      return new (this->allocate(sizeof(T))) T();
+    }
+    template<typename T, typename Arg1>
+    T* create(Arg1 arg1)
+    {
+      return new (this->allocate(sizeof(T))) T(arg1);
+    }
+    template<typename T, typename Arg1, typename Arg2>
+    T* create(Arg1 arg1, Arg2 arg2)
+    {
+      return new (this->allocate(sizeof(T))) T(arg1, arg2);
+    }
+    template<typename T, typename Arg1, typename Arg2, typename Arg3>
+    T* create(Arg1 arg1, Arg2 arg2, Arg3 arg3)
+    {
+      return new (this->allocate(sizeof(T))) T(arg1, arg2, arg3);
+    }
+    template<typename T, typename Arg1, typename Arg2, typename Arg3, typename Arg4>
+    T* create(Arg1 arg1, Arg2 arg2, Arg3 arg3, Arg4 arg4)
+    {
+      return new (this->allocate(sizeof(T))) T(arg1, arg2, arg3, arg4);
+    }
+
+    /// Releases everything allocated since the last reset.
+    void reset();
+
+    /// Bytes handed out since the last reset.
+    size_t get_used_size() const;
+    /// Bytes held in the blocks.
+    size_t get_capacity() const;
+
+  private:
+    std::vector<char*> blocks;
+    std::vector<size_t> block_sizes;
+    size_t block_size;
+    unsigned int current_block;
+    size_t current_offset;
+    size_t used_size;
+  };
 }
 #endif
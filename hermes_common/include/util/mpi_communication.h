@@ -0,0 +1,60 @@
+// This file is part of HermesCommon
+//
+// Copyright (c) 2009 hp-FEM group at the University of Nevada, Reno (UNR).
+// Email: hpfem-group@unr.edu, home page: http://www.hpfem.org/.
+//
+// Hermes2D is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation; either version 2 of the License,
+// or (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+/*! \file mpi_communication.h
+\brief MPI environment of the distributed assembling and solving.
+*/
+#ifndef __HERMES_COMMON_MPI_COMMUNICATION_H_
+#define __HERMES_COMMON_MPI_COMMUNICATION_H_
+
+#include "util/compat.h"
+
+namespace Hermes
+{
+  /// \brief MPI environment of the distributed assembling and solving (WITH_MPI).
+  /// All ranks of MPI_COMM_WORLD take part, MPI_Init() / MPI_Finalize() are left to the application.
+  /// Without WITH_MPI, or when MPI is not initialized, there is a single rank 0 and the collective operations do nothing.
+  ///
+  /// The collective operations have to be called by all ranks, in the same order.
+  class HERMES_COMMON_API MpiCommunication
+  {
+  public:
+    /// Rank of this process.
+    static int get_rank();
+    /// Number of the ranks.
+    static int get_size();
+    /// True if there is more than one rank.
+    static bool is_distributed();
+    /// True if MPI may be called from several threads at once (MPI_THREAD_MULTIPLE), or if MPI is not used.
+    static bool supports_concurrent_calls();
+
+    /// Sums the values over all ranks, all ranks get the sums.
+    /// Instantiated for double and std::complex<double>.
+    template<typename Scalar>
+    static void sum(Scalar* values, int count);
+
+    /// All ranks get the values of the rank root.
+    /// Instantiated for double and std::complex<double>.
+    template<typename Scalar>
+    static void broadcast(Scalar* values, int count, int root = 0);
+
+    /// Waits for all ranks.
+    static void barrier();
+  };
+}
+#endif
@@ -0,0 +1,132 @@
+// This file is part of HermesCommon
+//
+// Copyright (c) 2009 hp-FEM group at the University of Nevada, Reno (UNR).
+// Email: hpfem-group@unr.edu, home page: http://www.hpfem.org/.
+//
+// Hermes2D is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation; either version 2 of the License,
+// or (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+/*! \file profiler.h
+\brief Hierarchical phase profiler.
+*/
+#ifndef __HERMES_COMMON_PROFILER_H_
+#define __HERMES_COMMON_PROFILER_H_
+
+#include "util/compat.h"
+#include <string>
+
+namespace Hermes
+{
+  /// \brief Hierarchical (scoped region) profiler.
+  /// Regions are opened and closed by ProfilerRegion instances (see HERMES_PROFILE_REGION). Nested regions form a tree
+  /// per thread, in whose nodes the calls and the inclusive / exclusive times are aggregated. Every region instance can
+  /// also be recorded as a trace event, for the export as Chrome trace-event JSON (chrome://tracing, Perfetto).
+  ///
+  /// Disabled by default - a region then costs a test of a flag. Without WITH_PROFILER, the regions are compiled out.
+  /// The data of a thread are only touched by that thread, set_enabled(), reset() and the exports are to be called
+  /// outside of parallel regions.
+  ///
+  /// Optionally, the hardware counters (HardwareCounters - cycles, instructions, branch & cache misses) of the threads
+  /// are read at the region boundaries, and aggregated in the regions as well. The regions can also be given an amount
+  /// of work (see HERMES_PROFILE_WORK, e.g. the quadrature points x basis function pairs evaluated in assembling),
+  /// from which FLOP estimates are derived.
+  ///
+  /// Usage:
+  /// Hermes::Profiler::set_enabled(true);
+  /// <-- solve, adapt, ... -->
+  /// std::cout << Hermes::Profiler::get_summary();
+  /// Hermes::Profiler::export_chrome_trace("trace.json");
+  class HERMES_COMMON_API Profiler
+  {
+  public:
+    /// Enables / disables profiling (default: disabled).
+    static void set_enabled(bool to_set);
+    static bool is_enabled();
+
+    /// Recording of the trace events besides the aggregated counters (default: on).
+    /// \param[in] max_events_per_thread Limit of the recorded events per thread, the following ones are only counted.
+    static void set_tracing(bool to_set, unsigned int max_events_per_thread = 1000000);
+
+    /// Resets the counters and drops the trace events of all threads.
+    static void reset();
+
+    /// Opens a region in the calling thread.
+    /// \param[in] name Region name with static storage (a string literal), only the pointer is kept.
+    static void begin(const char* name);
+    /// Closes the innermost open region of the calling thread.
+    static void end();
+
+    /// Writes the recorded trace events as Chrome trace-event JSON.
+    static void export_chrome_trace(const char* filename);
+
+    /// Text summary - region trees with calls, inclusive & exclusive times, for all threads together and per thread.
+    static std::string get_summary();
+
+    /// Total inclusive time [s] of the regions called name, over all threads and all places in the trees.
+    /// Occurrences nested in a region of the same name are not counted twice.
+    static double get_total_time(const char* name);
+    /// Total number of calls of the regions called name, over all threads and all places in the trees.
+    static unsigned long long get_total_calls(const char* name);
+
+    /// Reading of the hardware counters at the region boundaries (default: off).
+    /// Costs two reads (syscalls) per region boundary - suited for the regions of the phases, not the innermost loops.
+    /// The counters are opened per thread on its first region, where not available they read as zero.
+    static void set_hardware_counters(bool to_set);
+    static bool get_hardware_counters();
+    /// Empty if the hardware counters are available in the calling thread, otherwise the reason.
+    static std::string get_hardware_counters_error();
+
+    /// Adds work (operations, such as quadrature points x basis function pairs) to the innermost open region of the calling thread.
+    static void add_work(double operations);
+
+    /// Text summary of the hardware counters - per region (all threads together and per thread) IPC, L1 data cache
+    /// and last level cache miss rates, branch misprediction rate, work & the FLOP estimates.
+    /// \param[in] flops_per_work_unit FLOPs estimated per unit of the work (e.g. 2 - one multiply-add per point and basis pair).
+    static std::string get_hardware_counter_summary(double flops_per_work_unit = 2.);
+  };
+
+  /// \brief Profiled region - from construction to destruction.
+  class HERMES_COMMON_API ProfilerRegion
+  {
+  public:
+    ProfilerRegion(const char* name) : active(Profiler::is_enabled())
+    {
+      if (active)
+        Profiler::begin(name);
+    }
+
+    ~ProfilerRegion()
+    {
+      if (active)
+        Profiler::end();
+    }
+
+  private:
+    bool active;
+  };
+}
+
+#define HERMES_PROFILER_CONCAT_INNER(a, b) a##b
+#define HERMES_PROFILER_CONCAT(a, b) HERMES_PROFILER_CONCAT_INNER(a, b)
+
+#ifdef WITH_PROFILER
+/// Profiles the rest of the enclosing scope as a region called name (a string literal).
+#define HERMES_PROFILE_REGION(name) Hermes::ProfilerRegion HERMES_PROFILER_CONCAT(hermes_profiler_region_, __LINE__)(name)
+/// Adds work (operations) to the innermost open region.
+#define HERMES_PROFILE_WORK(operations) do { if (Hermes::Profiler::is_enabled()) Hermes::Profiler::add_work(operations); } while (false)
+#else
+#define HERMES_PROFILE_REGION(name)
+#define HERMES_PROFILE_WORK(operations) do { (void)(operations); } while (false)
+#endif
+
+#endif
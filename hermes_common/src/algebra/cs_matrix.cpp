@@ -21,6 +21,7 @@
 */
 #include "cs_matrix.h"
 #include "util/memory_handling.h"
+#include "api.h"
 
 namespace Hermes
 {
@@ -73,12 +74,12 @@ namespace Hermes
     }
 
     template<typename Scalar>
-    CSMatrix<Scalar>::CSMatrix() : SparseMatrix<Scalar>(), nnz(0), Ap(nullptr), Ai(nullptr), Ax(nullptr)
+    CSMatrix<Scalar>::CSMatrix() : SparseMatrix<Scalar>(), nnz(0), Ap(nullptr), Ai(nullptr), Ax(nullptr), structure_references(nullptr), memory_accounted(0)
     {
     }
 
     template<typename Scalar>
-    CSMatrix<Scalar>::CSMatrix(unsigned int size)
+    CSMatrix<Scalar>::CSMatrix(unsigned int size) : structure_references(nullptr), memory_accounted(0)
     {
       this->size = size;
       this->alloc();
@@ -127,15 +128,53 @@ namespace Hermes
     void CSMatrix<Scalar>::alloc_data()
     {
       Ax = calloc_with_check<CSMatrix<Scalar>, Scalar>(nnz, this);
+      this->update_memory_accounting();
     }
 
     template<typename Scalar>
     void CSMatrix<Scalar>::free()
     {
+      this->release_structure();
       nnz = 0;
+      free_with_check(Ax);
+      this->update_memory_accounting();
+    }
+
+    template<typename Scalar>
+    void CSMatrix<Scalar>::release_structure()
+    {
+      if (this->structure_references)
+      {
+        if (--(*this->structure_references) > 0)
+        {
+          this->Ap = nullptr;
+          this->Ai = nullptr;
+          this->structure_references = nullptr;
+          return;
+        }
+        if (this->Ap)
+          Hermes::HermesCommonApi.account_memory(Hermes::memoryMatrixStorage, -(long long)((this->size + 1 + this->nnz) * sizeof(int)));
+        free_with_check(this->structure_references);
+      }
       free_with_check(Ap);
       free_with_check(Ai);
-      free_with_check(Ax);
+    }
+
+    template<typename Scalar>
+    void CSMatrix<Scalar>::update_memory_accounting()
+    {
+      long long bytes = 0;
+      if (this->Ap && !this->structure_references)
+        bytes += (this->size + 1) * sizeof(int);
+      if (this->Ai && !this->structure_references)
+        bytes += this->nnz * sizeof(int);
+      if (this->Ax)
+        bytes += this->nnz * sizeof(Scalar);
+      if (bytes != this->memory_accounted)
+      {
+        Hermes::HermesCommonApi.account_memory(Hermes::memoryMatrixStorage, bytes - this->memory_accounted);
+        this->memory_accounted = bytes;
+      }
     }
 
     template<typename Scalar>
@@ -174,6 +213,32 @@ namespace Hermes
       memcpy(this->Ap, ap, (this->size + 1) * sizeof(int));
       memcpy(this->Ai, ai, this->nnz * sizeof(int));
       memcpy(this->Ax, ax, this->nnz * sizeof(Scalar));
+      this->update_memory_accounting();
+    }
+
+    template<typename Scalar>
+    void CSMatrix<Scalar>::alloc_with_structure(CSMatrix<Scalar>* other)
+    {
+      if (this == other)
+        return;
+      this->free();
+
+      // First sharing - from now on the structure is accounted once, not by the matrices using it.
+      if (!other->structure_references)
+      {
+        other->structure_references = malloc_with_check<CSMatrix<Scalar>, int>(1, other);
+        *other->structure_references = 1;
+        Hermes::HermesCommonApi.account_memory(Hermes::memoryMatrixStorage, (other->size + 1 + other->nnz) * sizeof(int));
+        other->update_memory_accounting();
+      }
+      (*other->structure_references)++;
+
+      this->structure_references = other->structure_references;
+      this->nnz = other->nnz;
+      this->size = other->size;
+      this->Ap = other->Ap;
+      this->Ai = other->Ai;
+      this->alloc_data();
     }
 
     template<typename Scalar>
@@ -203,11 +268,20 @@ namespace Hermes
       }
 
       tempAp[this->size] = this->nnz;
+      memcpy(this->Ax, tempAx, sizeof(Scalar)* nnz);
+      free_with_check(tempAx);
+      // A shared structure stays with the other matrices.
+      if (this->structure_references)
+      {
+        this->release_structure();
+        this->Ap = tempAp;
+        this->Ai = tempAi;
+        this->update_memory_accounting();
+        return;
+      }
       memcpy(this->Ai, tempAi, sizeof(int)* nnz);
       memcpy(this->Ap, tempAp, sizeof(int)* (this->size + 1));
-      memcpy(this->Ax, tempAx, sizeof(Scalar)* nnz);
       free_with_check(tempAi);
-      free_with_check(tempAx);
       free_with_check(tempAp);
     }
 
@@ -286,8 +360,12 @@ namespace Hermes
           throw Hermes::Exceptions::Exception("Sparse matrix entry not found: [%i, %i]", m, n);
         }
 
-#pragma omp critical (CSMatrixAdd)
-        Ax[Ap[n] + pos] += v;
+        // std::complex<double> is layout-compatible with double[2], both parts can be updated atomically.
+        double* target = reinterpret_cast<double*>(&Ax[Ap[n] + pos]);
+#pragma omp atomic
+        target[0] += v.real();
+#pragma omp atomic
+        target[1] += v.imag();
       }
     }
 
@@ -722,6 +800,8 @@ namespace Hermes
 #endif
         break;
       }
+
+      this->update_memory_accounting();
     }
 
     template<typename Scalar>
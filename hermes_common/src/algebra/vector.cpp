@@ -461,8 +461,12 @@ namespace Hermes
     template<>
     void SimpleVector<std::complex<double> >::add(unsigned int idx, std::complex<double> y)
     {
-#pragma omp critical (SimpleVector_add)
-      this->v[idx] += y;
+      // std::complex<double> is layout-compatible with double[2], both parts can be updated atomically.
+      double* target = reinterpret_cast<double*>(&this->v[idx]);
+#pragma omp atomic
+      target[0] += y.real();
+#pragma omp atomic
+      target[1] += y.imag();
     }
 
     template<typename Scalar>
@@ -25,6 +25,12 @@
 #include "exceptions.h"
 #include "matrix.h"
 #include "solvers/interfaces/paralution_solver.h"
+#if defined(WIN32) || defined(_WINDOWS)
+#include <Windows.h>
+#include <Psapi.h>
+#else
+#include <sys/resource.h>
+#endif
 #if defined __GNUC__ && defined HAVE_BFD
 #include <signal.h>
 #include "third_party/backtrace.c"
@@ -75,6 +81,14 @@ namespace Hermes
     this->parameters.insert(std::pair<HermesCommonApiParam, Parameter*>(Hermes::useAccelerators, new Parameter(1)));
     this->parameters.insert(std::pair<HermesCommonApiParam, Parameter*>(Hermes::checkMeshesOnLoad, new Parameter(1)));
 
+    // Memory accounting.
+    for (int i = 0; i < HermesMemoryCategoryCount; i++)
+    {
+      this->memory_usage[i] = this->memory_peak[i] = 0;
+      this->memory_limits[i] = 0;
+    }
+    this->cache_users = 0;
+
     // Set handlers.
 #ifdef WITH_PARALUTION
     this->setter_handlers.insert(std::pair<HermesCommonApiParam, typename Api::SetterHandler>(Hermes::numThreads, &ParalutionInitialization::set_threads_paralution));
@@ -152,6 +166,144 @@ namespace Hermes
     }
   }
 
+  void Api::account_memory(HermesMemoryCategory category, long long bytes)
+  {
+#pragma omp critical (memory_accounting)
+    {
+      this->memory_usage[category] += bytes;
+      if (this->memory_usage[category] > this->memory_peak[category])
+        this->memory_peak[category] = this->memory_usage[category];
+    }
+  }
+
+  long long Api::get_memory_usage(HermesMemoryCategory category) const
+  {
+    return this->memory_usage[category];
+  }
+
+  long long Api::get_memory_peak(HermesMemoryCategory category) const
+  {
+    return this->memory_peak[category];
+  }
+
+  std::string Api::get_memory_report() const
+  {
+    static const char* category_names[HermesMemoryCategoryCount] = { "PrecalcShapeset tables", "Solution tables", "RefMap caches", "Mesh hash tables", "Matrix storage", "Adapt clones" };
+
+    std::stringstream report;
+    char line[256];
+    sprintf(line, "%-24s %14s %14s %14s\n", "Memory [MB]", "current", "peak", "limit");
+    report << line;
+    long long total_usage = 0;
+    for (int i = 0; i < HermesMemoryCategoryCount; i++)
+    {
+      if (this->memory_limits[i] > 0)
+        sprintf(line, "%-24s %14.3f %14.3f %14.3f\n", category_names[i], this->memory_usage[i] / 1048576., this->memory_peak[i] / 1048576., this->memory_limits[i] / 1048576.);
+      else
+        sprintf(line, "%-24s %14.3f %14.3f %14s\n", category_names[i], this->memory_usage[i] / 1048576., this->memory_peak[i] / 1048576., "-");
+      report << line;
+      total_usage += this->memory_usage[i];
+    }
+    sprintf(line, "%-24s %14.3f\n", "Total", total_usage / 1048576.);
+    report << line;
+    return report.str();
+  }
+
+  size_t Api::get_peak_resident_set_size() const
+  {
+#if defined(WIN32) || defined(_WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+      return counters.PeakWorkingSetSize;
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage))
+      return 0;
+#ifdef __APPLE__
+    // Bytes on OS X.
+    return usage.ru_maxrss;
+#else
+    // Kilobytes on Linux.
+    return usage.ru_maxrss * 1024;
+#endif
+#endif
+  }
+
+  void Api::set_memory_limit(HermesMemoryCategory category, size_t bytes)
+  {
+    this->memory_limits[category] = bytes;
+  }
+
+  size_t Api::get_memory_limit(HermesMemoryCategory category) const
+  {
+    return this->memory_limits[category];
+  }
+
+  bool Api::memory_limit_exceeded(HermesMemoryCategory category) const
+  {
+    return this->memory_limits[category] > 0 && this->memory_usage[category] > (long long)this->memory_limits[category];
+  }
+
+  void Api::register_memory_evictor(HermesMemoryCategory category, MemoryEvictor evictor, void* owner)
+  {
+#pragma omp critical (memory_accounting)
+    this->memory_evictors[category].push_back(std::pair<MemoryEvictor, void*>(evictor, owner));
+  }
+
+  void Api::unregister_memory_evictor(HermesMemoryCategory category, void* owner)
+  {
+#pragma omp critical (memory_accounting)
+    {
+      std::vector<std::pair<MemoryEvictor, void*> >& evictors = this->memory_evictors[category];
+      for (unsigned int i = 0; i < evictors.size();)
+      {
+        if (evictors[i].second == owner)
+          evictors.erase(evictors.begin() + i);
+        else
+          i++;
+      }
+    }
+  }
+
+  unsigned int Api::enforce_memory_limits()
+  {
+    unsigned int evictions = 0;
+    // The same critical section as begin_cache_use() - no use can start during the eviction.
+#pragma omp critical (memory_eviction)
+    {
+      for (int i = 0; i < HermesMemoryCategoryCount && this->cache_users == 0; i++)
+      {
+        HermesMemoryCategory category = (HermesMemoryCategory)i;
+        if (!this->memory_limit_exceeded(category))
+          continue;
+
+        // A copy - evictors may unregister.
+        std::vector<std::pair<MemoryEvictor, void*> > evictors;
+#pragma omp critical (memory_accounting)
+        evictors = this->memory_evictors[category];
+        for (unsigned int j = 0; j < evictors.size() && this->memory_limit_exceeded(category); j++)
+        {
+          evictors[j].first(evictors[j].second);
+          evictions++;
+        }
+      }
+    }
+    return evictions;
+  }
+
+  void Api::begin_cache_use()
+  {
+#pragma omp critical (memory_eviction)
+    this->cache_users++;
+  }
+
+  void Api::end_cache_use()
+  {
+#pragma omp critical (memory_eviction)
+    this->cache_users--;
+  }
+
 #if defined(WIN32) || defined(_WINDOWS)
   __declspec(dllexport) Hermes::Api HermesCommonApi;
 #else
@@ -24,6 +24,7 @@
 #include "amesos_solver.h"
 #include "callstack.h"
 #include "Amesos_ConfigDefs.h"
+#include "util/profiler.h"
 
 namespace Hermes
 {
@@ -86,6 +87,7 @@ namespace Hermes
     template<>
     void AmesosSolver<double>::solve()
     {
+      HERMES_PROFILE_REGION("Amesos::solve");
       assert(m != nullptr);
       assert(rhs != nullptr);
 
@@ -96,6 +98,8 @@ namespace Hermes
       Epetra_Vector x(*rhs->std_map);
       problem.SetLHS(&x);
 
+      this->tick();
+
       if (!setup_factorization())
         this->warn("AmesosSolver: LU factorization could not be completed");
 
@@ -105,6 +109,7 @@ namespace Hermes
 
       this->tick();
       this->time = this->accumulated();
+      this->record_solve(this->last());
 
       free_with_check(this->sln);
       this->sln = malloc_with_check<AmesosSolver<double>, double>(m->size, this);
@@ -118,6 +123,7 @@ namespace Hermes
     template<>
     void AmesosSolver<std::complex<double> >::solve()
     {
+      HERMES_PROFILE_REGION("Amesos::solve");
       assert(m != nullptr);
       assert(rhs != nullptr);
 
@@ -134,6 +140,7 @@ namespace Hermes
 
       this->tick();
       this->time = this->accumulated();
+      this->record_solve(this->last());
 
       free_with_check(this->sln);
       this->sln = malloc_with_check<AmesosSolver<std::complex<double> >, std::complex<double>>(m->size, this);
@@ -144,6 +151,8 @@ namespace Hermes
     template<typename Scalar>
     bool AmesosSolver<Scalar>::setup_factorization()
     {
+      HERMES_PROFILE_REGION("Amesos::factorization");
+      Hermes::Mixins::TimeMeasurable factorization_time;
       // Perform both factorization phases for the first time.
       int eff_fact_scheme;
       if (this->reuse_scheme != HERMES_CREATE_STRUCTURE_FROM_SCRATCH &&
@@ -172,6 +181,7 @@ namespace Hermes
           this->warn("Numeric factorization failed.");
           return false;
         }
+        this->record_factorization(factorization_time.tick().last(), 0);
       }
 
       return true;
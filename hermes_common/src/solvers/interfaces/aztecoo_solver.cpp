@@ -23,6 +23,7 @@
 #ifdef HAVE_AZTECOO
 #include "aztecoo_solver.h"
 #include "callstack.h"
+#include "util/profiler.h"
 #ifdef HAVE_KOMPLEX
 #include "Komplex_LinearProblem.h"
 #endif
@@ -215,6 +216,7 @@ namespace Hermes
     template<>
     void AztecOOSolver<double>::solve()
     {
+      HERMES_PROFILE_REGION("AztecOO::solve");
       assert(m != nullptr);
       assert(rhs != nullptr);
       assert(m->size == rhs->size);
@@ -301,6 +303,7 @@ namespace Hermes
 
       this->tick();
       this->time = this->accumulated();
+      this->record_solve(this->last());
 
       free_with_check(this->sln);
       this->sln = malloc_with_check<AztecOOSolver<double>, double>(final_matrix->size, this);
@@ -317,6 +320,7 @@ namespace Hermes
     template<>
     void AztecOOSolver<double>::solve(double *initial_guess)
     {
+      HERMES_PROFILE_REGION("AztecOO::solve");
       assert(m != nullptr);
       assert(rhs != nullptr);
       assert(m->size == rhs->size);
@@ -417,6 +421,7 @@ namespace Hermes
 
       this->tick();
       this->time = this->accumulated();
+      this->record_solve(this->last());
 
       free_with_check(this->sln);
       this->sln = malloc_with_check<AztecOOSolver<double>, double>(final_matrix->size, this);
@@ -431,6 +436,7 @@ namespace Hermes
     template<>
     void AztecOOSolver<std::complex<double> >::solve()
     {
+      HERMES_PROFILE_REGION("AztecOO::solve");
 #ifdef HAVE_KOMPLEX
       assert(m != nullptr);
       assert(rhs != nullptr);
@@ -468,6 +474,7 @@ namespace Hermes
     template<>
     void AztecOOSolver<std::complex<double> >::solve(std::complex<double>* initial_guess)
     {
+      HERMES_PROFILE_REGION("AztecOO::solve");
 #ifdef HAVE_KOMPLEX
       assert(m != nullptr);
       assert(rhs != nullptr);
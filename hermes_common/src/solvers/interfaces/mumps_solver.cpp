@@ -24,6 +24,8 @@
 #include "mumps_solver.h"
 #include "callstack.h"
 #include "util/memory_handling.h"
+#include "util/profiler.h"
+#include "util/mpi_communication.h"
 
 namespace Hermes
 {
@@ -110,7 +112,7 @@ namespace Hermes
     }
 
     template<typename Scalar>
-    MumpsMatrix<Scalar>::MumpsMatrix() : CSCMatrix<Scalar>(), irn(nullptr), jcn(nullptr), Ax(nullptr)
+    MumpsMatrix<Scalar>::MumpsMatrix() : CSCMatrix<Scalar>(), distributed(false), irn(nullptr), jcn(nullptr), Ax(nullptr)
     {
     }
 
@@ -556,6 +558,10 @@ namespace Hermes
         a = mumps_to_Scalar(Ax[i]);
         vector_out[jcn[i] - 1] += vector_in[irn[i] - 1] * a;
       }
+
+      // A rank holds only its part of a distributed matrix - the products of the parts are summed (all ranks have to call this).
+      if (this->distributed)
+        MpiCommunication::sum(vector_out, this->size);
     }
 
     template<typename Scalar>
@@ -600,6 +606,7 @@ namespace Hermes
 
       nmat->nnz = this->nnz;
       nmat->size = this->size;
+      nmat->distributed = this->distributed;
       nmat->Ap = malloc_with_check<MumpsMatrix<Scalar>, int>(this->size + 1, nmat);
       nmat->Ai = malloc_with_check<MumpsMatrix<Scalar>, int>(this->nnz, nmat);
       nmat->Ax = malloc_with_check<MumpsMatrix<Scalar>, typename mumps_type<Scalar>::mumps_Scalar>(this->nnz, nmat);
@@ -619,6 +626,18 @@ namespace Hermes
       return nmat;
     }
 
+    template<typename Scalar>
+    void MumpsMatrix<Scalar>::set_distributed(bool to_set)
+    {
+      this->distributed = to_set;
+    }
+
+    template<typename Scalar>
+    bool MumpsMatrix<Scalar>::is_distributed() const
+    {
+      return this->distributed;
+    }
+
     template class HERMES_API MumpsMatrix < double > ;
     template class HERMES_API MumpsMatrix < std::complex<double> > ;
   }
@@ -735,8 +754,8 @@ namespace Hermes
 
         // =/ both centralized assembled matrix
         param.ICNTL(5) = 0;
-        // =\ both centralized assembled matrix
-        param.ICNTL(18) = 0;
+        // =\ both centralized assembled matrix, or distributed - the entries of the ranks are summed
+        param.ICNTL(18) = m->is_distributed() ? 3 : 0;
         // centralized dense RHS
         param.ICNTL(20) = 0;
         // centralized dense solution
@@ -753,10 +772,20 @@ namespace Hermes
 
         // Specify the matrix.
         param.n = m->size;
-        param.nz = m->nnz;
-        param.irn = m->irn;
-        param.jcn = m->jcn;
-        param.a = m->Ax;
+        if (m->is_distributed())
+        {
+          param.nz_loc = m->nnz;
+          param.irn_loc = m->irn;
+          param.jcn_loc = m->jcn;
+          param.a_loc = m->Ax;
+        }
+        else
+        {
+          param.nz = m->nnz;
+          param.irn = m->irn;
+          param.jcn = m->jcn;
+          param.a = m->Ax;
+        }
       }
 
       return inited;
@@ -771,6 +800,7 @@ namespace Hermes
     template<typename Scalar>
     void MumpsSolver<Scalar>::solve()
     {
+      HERMES_PROFILE_REGION("MUMPS::solve");
       assert(m != nullptr);
       assert(rhs != nullptr);
 
@@ -787,15 +817,24 @@ namespace Hermes
       memcpy(param.rhs, rhs->v, m->size * sizeof(typename mumps_type<Scalar>::mumps_Scalar));
 
       // Do the jobs specified in setup_factorization().
+      Hermes::Mixins::TimeMeasurable mumps_time;
       mumps_c(&param);
+      mumps_time.tick();
 
       // Throws appropriate exception.
       if (check_status())
       {
+        // INFOG(22) - memory used by the factorization, in millions of bytes.
+        if (param.job != JOB_SOLVE)
+          this->record_factorization(mumps_time.last(), (size_t)param.INFOG(22) * 1000000);
+
         free_with_check(this->sln);
         this->sln = malloc_with_check<MumpsSolver<Scalar>, Scalar>(m->size, this);
         for (unsigned int i = 0; i < rhs->get_size(); i++)
           this->sln[i] = mumps_to_Scalar(param.rhs[i]);
+
+        // With MPI, the (centralized) solution is on the host only.
+        MpiCommunication::broadcast(this->sln, m->size);
       }
       else
       {
@@ -824,6 +863,7 @@ namespace Hermes
 
       this->tick();
       this->time = this->accumulated();
+      this->record_solve(this->last());
 
       free_with_check(param.rhs);
       param.rhs = nullptr;
@@ -832,6 +872,7 @@ namespace Hermes
     template<typename Scalar>
     bool MumpsSolver<Scalar>::setup_factorization()
     {
+      HERMES_PROFILE_REGION("MUMPS::factorization");
       // When called for the first time, all three phases (analysis, factorization,
       // solution) must be performed.
       int eff_fact_scheme = this->reuse_scheme;
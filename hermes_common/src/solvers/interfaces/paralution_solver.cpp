@@ -23,6 +23,7 @@
 #ifdef WITH_PARALUTION
 #include "paralution_solver.h"
 #include "util/memory_handling.h"
+#include "util/profiler.h"
 
 namespace Hermes
 {
@@ -224,6 +225,7 @@ namespace Hermes
     template<typename Scalar>
     void AbstractParalutionLinearMatrixSolver<Scalar>::solve(Scalar* initial_guess)
     {
+      HERMES_PROFILE_REGION("Paralution::solve");
       // Handle sln.
       if (this->sln && this->sln != initial_guess)
         free_with_check(this->sln);
@@ -245,6 +247,8 @@ namespace Hermes
         return;
       }
 
+      this->tick();
+
       // (Re-)init.
       this->presolve_init();
 
@@ -268,6 +272,10 @@ namespace Hermes
 
       // Destroy the paralution vector, keeping the data in sln.
       x.LeaveDataPtr(&this->sln);
+
+      this->tick();
+      this->time = this->accumulated();
+      this->record_solve(this->last());
     }
 
     template<typename Scalar>
@@ -25,6 +25,7 @@
 #include "callstack.h"
 #include "common.h"
 #include "util/memory_handling.h"
+#include "util/profiler.h"
 
 /// \todo Check #ifdef WITH_MPI and use the parallel methods from PETSc accordingly.
 
@@ -466,6 +467,7 @@ namespace Hermes
     template<typename Scalar>
     void PetscLinearMatrixSolver<Scalar>::solve()
     {
+      HERMES_PROFILE_REGION("PETSc::solve");
       assert(m != nullptr);
       assert(rhs != nullptr);
 
@@ -486,6 +488,7 @@ namespace Hermes
 
       this->tick();
       this->time = this->accumulated();
+      this->record_solve(this->last());
 
       // allocate memory for solution vector
       free_with_check(this->sln);
@@ -24,6 +24,7 @@
 #include "superlu_solver.h"
 #include "callstack.h"
 #include "util/memory_handling.h"
+#include "util/profiler.h"
 
 namespace Hermes
 {
@@ -206,6 +207,7 @@ namespace Hermes
     template<typename Scalar>
     void SuperLUSolver<Scalar>::solve()
     {
+      HERMES_PROFILE_REGION("SuperLU::solve");
       assert(m != nullptr);
       assert(rhs != nullptr);
 
@@ -231,6 +233,7 @@ namespace Hermes
       // (unused unless iterative refinement is performed).
       // Record the memory usage statistics.
       slu_memusage_t memusage;
+      memset(&memusage, 0, sizeof(slu_memusage_t));
       // The reciprocal pivot growth factor.
       double rpivot_growth;
       // The estimate of the reciprocal condition number.
@@ -295,6 +298,11 @@ namespace Hermes
 
       // Solve the system.
       int info;
+#ifdef SLU_MT
+      bool factorizing = (options.fact != FACTORED);
+#else
+      bool factorizing = (options.Fact != FACTORED);
+#endif
 
 #ifdef SLU_MT
       if (options.refact == NO)
@@ -353,6 +361,9 @@ namespace Hermes
 
       bool factorized = check_status(info);
 
+      if (factorized && factorizing)
+        this->record_factorization(stat.utime[FACT], (size_t)memusage.for_lu);
+
       if (factorized)
       {
         free_with_check(this->sln);
@@ -376,6 +387,7 @@ namespace Hermes
 
       this->tick();
       this->time = this->accumulated();
+      this->record_solve(this->last());
 
       if (!factorized)
         throw Exceptions::LinearMatrixSolverException("SuperLU failed.");
@@ -384,6 +396,7 @@ namespace Hermes
     template<typename Scalar>
     bool SuperLUSolver<Scalar>::setup_factorization()
     {
+      HERMES_PROFILE_REGION("SuperLU::factorization");
       unsigned int A_size = A.nrow < 0 ? 0 : A.nrow;
       if (has_A && this->reuse_scheme != HERMES_CREATE_STRUCTURE_FROM_SCRATCH && A_size != m->get_size())
       {
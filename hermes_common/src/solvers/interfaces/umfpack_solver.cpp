@@ -24,6 +24,7 @@
 #include "umfpack_solver.h"
 #include "common.h"
 #include "util/memory_handling.h"
+#include "util/profiler.h"
 
 #define umfpack_real_symbolic umfpack_di_symbolic
 #define umfpack_real_numeric umfpack_di_numeric
@@ -71,6 +72,8 @@ namespace Hermes
     template<>
     bool UMFPackLinearMatrixSolver<double>::setup_factorization()
     {
+      HERMES_PROFILE_REGION("UMFPack::factorization");
+      Hermes::Mixins::TimeMeasurable factorization_time;
       // Perform both factorization phases for the first time.
       if (reuse_scheme != HERMES_CREATE_STRUCTURE_FROM_SCRATCH && symbolic == nullptr && numeric == nullptr)
         reuse_scheme = HERMES_CREATE_STRUCTURE_FROM_SCRATCH;
@@ -112,6 +115,7 @@ namespace Hermes
         }
         else
           umfpack_di_report_info(Control, Info);
+        this->record_factorization(factorization_time.tick().last(), (size_t)(Info[UMFPACK_NUMERIC_SIZE] * Info[UMFPACK_SIZE_OF_UNIT]));
       }
 
       return true;
@@ -120,6 +124,8 @@ namespace Hermes
     template<>
     bool UMFPackLinearMatrixSolver<std::complex<double> >::setup_factorization()
     {
+      HERMES_PROFILE_REGION("UMFPack::factorization");
+      Hermes::Mixins::TimeMeasurable factorization_time;
       // Perform both factorization phases for the first time.
       int eff_fact_scheme;
       if (reuse_scheme != HERMES_CREATE_STRUCTURE_FROM_SCRATCH && symbolic == nullptr && numeric == nullptr)
@@ -147,13 +153,15 @@ namespace Hermes
         if (numeric != nullptr)
           umfpack_zi_free_numeric(&numeric);
 
-        status = umfpack_complex_numeric(m->get_Ap(), m->get_Ai(), (double *)m->get_Ax(), nullptr, symbolic, &numeric, nullptr, nullptr);
+        // Info only for the statistics (default Control).
+        status = umfpack_complex_numeric(m->get_Ap(), m->get_Ai(), (double *)m->get_Ax(), nullptr, symbolic, &numeric, nullptr, Info);
         if (status != UMFPACK_OK)
         {
           if (numeric)
             umfpack_zi_free_numeric(&numeric);
           throw Exceptions::LinearMatrixSolverException(check_status("UMFPACK numeric factorization", status));
         }
+        this->record_factorization(factorization_time.tick().last(), (size_t)(Info[UMFPACK_NUMERIC_SIZE] * Info[UMFPACK_SIZE_OF_UNIT]));
       }
 
       return true;
@@ -180,6 +188,7 @@ namespace Hermes
     template<>
     void UMFPackLinearMatrixSolver<double>::solve()
     {
+      HERMES_PROFILE_REGION("UMFPack::solve");
       assert(m != nullptr);
       assert(rhs != nullptr);
       assert(m->get_size() == rhs->get_size());
@@ -200,11 +209,13 @@ namespace Hermes
       }
 
       this->tick();
+      this->record_solve(this->last());
     }
 
     template<>
     void UMFPackLinearMatrixSolver<std::complex<double> >::solve()
     {
+      HERMES_PROFILE_REGION("UMFPack::solve");
       assert(m != nullptr);
       assert(rhs != nullptr);
       assert(m->get_size() == rhs->get_size());
@@ -226,6 +237,7 @@ namespace Hermes
 
       this->tick();
       time = this->accumulated();
+      this->record_solve(this->last());
     }
 
     template<typename Scalar>
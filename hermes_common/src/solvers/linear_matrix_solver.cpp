@@ -37,6 +37,10 @@ namespace Hermes
 {
   namespace Solvers
   {
+    LinearMatrixSolverStatistics::LinearMatrixSolverStatistics() : solves(0), solve_time(0.), factorizations(0), factorization_time(0.), factorization_memory(0), peak_factorization_memory(0)
+    {
+    }
+
     template<typename Scalar>
     LinearMatrixSolver<Scalar>::LinearMatrixSolver(SparseMatrix<Scalar>* matrix, Vector<Scalar>* rhs) : reuse_scheme(HERMES_CREATE_STRUCTURE_FROM_SCRATCH), general_matrix(matrix), general_rhs(rhs)
     {
@@ -76,6 +80,34 @@ namespace Hermes
       return time;
     }
 
+    template<typename Scalar>
+    const LinearMatrixSolverStatistics& LinearMatrixSolver<Scalar>::get_statistics() const
+    {
+      return this->statistics;
+    }
+
+    template<typename Scalar>
+    void LinearMatrixSolver<Scalar>::reset_statistics()
+    {
+      this->statistics = LinearMatrixSolverStatistics();
+    }
+
+    template<typename Scalar>
+    void LinearMatrixSolver<Scalar>::record_solve(double time)
+    {
+      this->statistics.solves++;
+      this->statistics.solve_time += time;
+    }
+
+    template<typename Scalar>
+    void LinearMatrixSolver<Scalar>::record_factorization(double time, size_t memory)
+    {
+      this->statistics.factorizations++;
+      this->statistics.factorization_time += time;
+      this->statistics.factorization_memory = memory;
+      this->statistics.peak_factorization_memory = std::max(this->statistics.peak_factorization_memory, memory);
+    }
+
     template<typename Scalar>
     void LinearMatrixSolver<Scalar>::set_reuse_scheme()
     {
@@ -22,6 +22,12 @@
 #include "solvers/nonlinear_matrix_solver.h"
 #include "common.h"
 #include "util/memory_handling.h"
+#include "util/profiler.h"
+#include "solvers/interfaces/mumps_solver.h"
+#include "solvers/interfaces/petsc_solver.h"
+#include "util/mpi_communication.h"
+#include <thread>
+#include <exception>
 
 using namespace Hermes::Algebra;
 
@@ -44,6 +50,8 @@ namespace Hermes
       this->num_iters = 0;
       this->previous_sln_vector = nullptr;
       this->use_initial_guess_for_iterative_solvers = false;
+      this->task_overlap = false;
+      this->num_overlapped_iters = 0;
       this->clear_tolerances();
     }
 
@@ -219,6 +227,98 @@ namespace Hermes
       this->max_steps_with_reused_jacobian = steps;
     }
 
+    template<typename Scalar>
+    void NonlinearMatrixSolver<Scalar>::set_task_overlap(bool to_set)
+    {
+      this->task_overlap = to_set;
+    }
+
+    template<typename Scalar>
+    unsigned int NonlinearMatrixSolver<Scalar>::get_num_overlapped_iters() const
+    {
+      return this->num_overlapped_iters;
+    }
+
+    template<typename Scalar>
+    bool NonlinearMatrixSolver<Scalar>::supports_task_overlap() const
+    {
+      return false;
+    }
+
+    template<typename Scalar>
+    void NonlinearMatrixSolver<Scalar>::assemble_residual_into(Vector<Scalar>* residual)
+    {
+      throw Exceptions::MethodNotOverridenException("NonlinearMatrixSolver<Scalar>::assemble_residual_into");
+    }
+
+    template<typename Scalar>
+    bool NonlinearMatrixSolver<Scalar>::linear_solver_supports_task_overlap()
+    {
+      if (dynamic_cast<DirectSolver<Scalar>*>(this->linear_matrix_solver) == nullptr)
+        return false;
+
+#ifdef WITH_MUMPS
+      MumpsMatrix<Scalar>* mumps_matrix = dynamic_cast<MumpsMatrix<Scalar>*>(this->get_jacobian());
+      if (mumps_matrix && mumps_matrix->is_distributed())
+        return false;
+      if (dynamic_cast<MumpsSolver<Scalar>*>(this->linear_matrix_solver) && !MpiCommunication::supports_concurrent_calls())
+        return false;
+#endif
+
+#ifdef WITH_PETSC
+      if (dynamic_cast<PetscLinearMatrixSolver<Scalar>*>(this->linear_matrix_solver) && !MpiCommunication::supports_concurrent_calls())
+        return false;
+#endif
+
+      return true;
+    }
+
+    template<typename Scalar>
+    void NonlinearMatrixSolver<Scalar>::assemble_with_overlapped_factorization()
+    {
+      HERMES_PROFILE_REGION("NonlinearSolver::overlapped_assembling");
+
+      // The Jacobian first, the factorization can not start without it.
+      this->assemble_jacobian(true);
+      this->linear_matrix_solver->set_reuse_scheme(HERMES_CREATE_STRUCTURE_FROM_SCRATCH);
+
+      // The right-hand side is still the residual of the previous iterate - the substitution is thrown away, only the factorization is kept.
+      // Nothing touches the Jacobian or the right-hand side until the thread is joined, the residual goes to residual_back.
+      LinearMatrixSolver<Scalar>* linear_matrix_solver = this->linear_matrix_solver;
+      std::exception_ptr factorization_exception;
+      std::thread factorization([linear_matrix_solver, &factorization_exception]()
+      {
+        try
+        {
+          linear_matrix_solver->solve();
+        }
+        catch (...)
+        {
+          factorization_exception = std::current_exception();
+        }
+      });
+
+      try
+      {
+        this->assemble_residual_into(this->residual_back);
+      }
+      catch (...)
+      {
+        factorization.join();
+        throw;
+      }
+      {
+        HERMES_PROFILE_REGION("NonlinearSolver::overlapped_factorization_wait");
+        factorization.join();
+      }
+
+      if (factorization_exception)
+        std::rethrow_exception(factorization_exception);
+
+      this->get_residual()->set_vector(this->residual_back);
+      this->linear_matrix_solver->set_reuse_scheme(HERMES_REUSE_MATRIX_STRUCTURE_COMPLETELY);
+    }
+
     template<typename Scalar>
     void NonlinearMatrixSolver<Scalar>::set_min_allowed_damping_coeff(double min_allowed_damping_coeff_to_set)
     {
@@ -446,6 +546,7 @@ namespace Hermes
     template<typename Scalar>
     void NonlinearMatrixSolver<Scalar>::solve_linear_system()
     {
+      HERMES_PROFILE_REGION("NonlinearSolver::linear_system");
       // store the previous solution to previous_sln_vector.
       memcpy(this->previous_sln_vector, this->sln_vector, sizeof(Scalar)*this->problem_size);
 
@@ -482,6 +583,7 @@ namespace Hermes
     {
       // Initialization.
       this->init_solving(coeff_vec);
+      this->num_overlapped_iters = 0;
 
 #pragma region parameter_setup
       // Initialize parameters.
@@ -525,13 +627,21 @@ namespace Hermes
           return;
         }
 
+        // Overlapped execution - the Jacobian of this iterate will be recalculated unless the damping factor handling rejects the iterate,
+        // so it is assembled and factorized already now, see set_task_overlap().
+        bool overlapped_factorization = this->task_overlap && this->supports_task_overlap() && this->linear_solver_supports_task_overlap()
+          && !(this->jacobian_reusable && (this->constant_jacobian || successful_steps_jacobian < this->max_steps_with_reused_jacobian));
+
 #pragma region damping_factor_loop
         this->info("\n\tNonlinearSolver: Damping factor handling:");
         // Loop searching for the damping factor.
         do
         {
-          // Assemble just the residual.
-          this->assemble_residual(false);
+          if (overlapped_factorization)
+            this->assemble_with_overlapped_factorization();
+          else
+            // Assemble just the residual.
+            this->assemble_residual(false);
           // Current residual norm.
           this->get_parameter_value(this->p_residual_norms).push_back(this->calculate_residual_norm());
 
@@ -556,6 +666,9 @@ namespace Hermes
 
           if (!residual_norm_drop)
           {
+            // The factorization belongs to the rejected iterate.
+            overlapped_factorization = false;
+
             // Delete the previous residual and solution norm.
             residual_norms.pop_back();
             solution_norms.pop_back();
@@ -636,9 +749,14 @@ namespace Hermes
         // Reassemble the jacobian once not reusable anymore.
         this->info("\tNonlinearSolver: Re-calculating Jacobian.");
 
-        // Set factorization scheme.
-        this->assemble_jacobian(true);
-        this->linear_matrix_solver->set_reuse_scheme(HERMES_CREATE_STRUCTURE_FROM_SCRATCH);
+        // Set factorization scheme (with the overlapped execution the Jacobian is factorized already).
+        if (!overlapped_factorization)
+        {
+          this->assemble_jacobian(true);
+          this->linear_matrix_solver->set_reuse_scheme(HERMES_CREATE_STRUCTURE_FROM_SCRATCH);
+        }
+        else
+          this->num_overlapped_iters++;
 
         // Solve the system, state that the jacobian is reusable should it be desirable.
         this->solve_linear_system();
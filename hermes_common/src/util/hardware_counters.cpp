@@ -0,0 +1,193 @@
+// This file is part of HermesCommon
+//
+// Copyright (c) 2009 hp-FEM group at the University of Nevada, Reno (UNR).
+// Email: hpfem-group@unr.edu, home page: http://www.hpfem.org/.
+//
+// Hermes2D is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation; either version 2 of the License,
+// or (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+/*! \file hardware_counters.cpp
+\brief Hardware performance counters (Linux perf_event).
+*/
+#include "hardware_counters.h"
+#include "config.h"
+#include <cstring>
+
+#if defined(WITH_PERF_EVENT) && defined(__linux__)
+#include <cerrno>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#define HERMES_HARDWARE_COUNTERS_PERF_EVENT
+#endif
+
+namespace Hermes
+{
+  namespace
+  {
+    /// Counters [begin, end) of the groups, the first one is the leader.
+    const int hardware_counter_groups[2][2] = { { HardwareCounterCycles, HardwareCounterL1DAccesses }, { HardwareCounterL1DAccesses, HardwareCounterCount } };
+
+#ifdef HERMES_HARDWARE_COUNTERS_PERF_EVENT
+    void hardware_counter_event(HardwareCounter counter, unsigned int& type, unsigned long long& config)
+    {
+      type = PERF_TYPE_HARDWARE;
+      switch (counter)
+      {
+      case HardwareCounterCycles:
+        config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+      case HardwareCounterInstructions:
+        config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+      case HardwareCounterBranches:
+        config = PERF_COUNT_HW_BRANCH_INSTRUCTIONS;
+        break;
+      case HardwareCounterBranchMisses:
+        config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+      case HardwareCounterL1DAccesses:
+        type = PERF_TYPE_HW_CACHE;
+        config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16);
+        break;
+      case HardwareCounterL1DMisses:
+        type = PERF_TYPE_HW_CACHE;
+        config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+      // The generic cache references / misses are the last level cache ones.
+      case HardwareCounterLLCAccesses:
+        config = PERF_COUNT_HW_CACHE_REFERENCES;
+        break;
+      case HardwareCounterLLCMisses:
+        config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+      default:
+        config = 0;
+      }
+    }
+
+    int hardware_counter_open(HardwareCounter counter, int group_fd)
+    {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      hardware_counter_event(counter, attr.type, attr.config);
+      attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      // User space only - allowed with the default perf_event_paranoid.
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.disabled = (group_fd == -1) ? 1 : 0;
+
+      // This thread, any CPU.
+      return syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+    }
+#endif
+  }
+
+  HardwareCounters::HardwareCounters()
+  {
+    for (int i = 0; i < HardwareCounterCount; i++)
+      this->fds[i] = -1;
+    for (int group_i = 0; group_i < group_count; group_i++)
+      this->group_leaders[group_i] = -1;
+
+#ifdef HERMES_HARDWARE_COUNTERS_PERF_EVENT
+    for (int group_i = 0; group_i < group_count; group_i++)
+    {
+      int leader = hardware_counter_groups[group_i][0];
+      this->fds[leader] = hardware_counter_open((HardwareCounter)leader, -1);
+      if (this->fds[leader] == -1)
+      {
+        this->error += std::string(this->error.empty() ? "" : " ") + get_name((HardwareCounter)leader) + ": " + strerror(errno) + ".";
+        continue;
+      }
+      this->group_leaders[group_i] = leader;
+
+      for (int i = leader + 1; i < hardware_counter_groups[group_i][1]; i++)
+      {
+        this->fds[i] = hardware_counter_open((HardwareCounter)i, this->fds[leader]);
+        if (this->fds[i] == -1)
+          this->error += std::string(this->error.empty() ? "" : " ") + get_name((HardwareCounter)i) + ": " + strerror(errno) + ".";
+      }
+
+      ioctl(this->fds[leader], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(this->fds[leader], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    if (this->fds[HardwareCounterCycles] == -1)
+      this->error += " (Check /proc/sys/kernel/perf_event_paranoid, and that the machine exposes a PMU.)";
+#else
+    this->error = "Built without perf_event support (WITH_PERF_EVENT, Linux only).";
+#endif
+  }
+
+  HardwareCounters::~HardwareCounters()
+  {
+#ifdef HERMES_HARDWARE_COUNTERS_PERF_EVENT
+    for (int i = 0; i < HardwareCounterCount; i++)
+    {
+      if (this->fds[i] != -1)
+        close(this->fds[i]);
+    }
+#endif
+  }
+
+  bool HardwareCounters::is_available() const
+  {
+    return this->fds[HardwareCounterCycles] != -1;
+  }
+
+  bool HardwareCounters::is_available(HardwareCounter counter) const
+  {
+    return this->fds[counter] != -1;
+  }
+
+  const std::string& HardwareCounters::get_error() const
+  {
+    return this->error;
+  }
+
+  void HardwareCounters::read(long long* values) const
+  {
+    memset(values, 0, HardwareCounterCount * sizeof(long long));
+
+#ifdef HERMES_HARDWARE_COUNTERS_PERF_EVENT
+    for (int group_i = 0; group_i < group_count; group_i++)
+    {
+      if (this->group_leaders[group_i] == -1)
+        continue;
+
+      // nr, time_enabled, time_running, values of the opened events in the order of opening.
+      unsigned long long buffer[3 + HardwareCounterCount];
+      if (::read(this->fds[this->group_leaders[group_i]], buffer, sizeof(buffer)) < (ssize_t)(3 * sizeof(unsigned long long)))
+        continue;
+
+      // Scaling of the multiplexed groups.
+      double scale = (buffer[2] > 0 && buffer[2] < buffer[1]) ? (double)buffer[1] / (double)buffer[2] : 1.;
+      unsigned long long value_i = 0;
+      for (int i = hardware_counter_groups[group_i][0]; i < hardware_counter_groups[group_i][1] && value_i < buffer[0]; i++)
+      {
+        if (this->fds[i] != -1)
+          values[i] = (long long)(buffer[3 + value_i++] * scale);
+      }
+    }
+#endif
+  }
+
+  const char* HardwareCounters::get_name(HardwareCounter counter)
+  {
+    static const char* names[HardwareCounterCount] = { "cycles", "instructions", "branches", "branch-misses", "L1-dcache-loads", "L1-dcache-load-misses", "LLC-references", "LLC-misses" };
+    return names[counter];
+  }
+}
@@ -20,10 +20,287 @@
 \brief File containing global PJLIB functionality.
 */
 #include "memory_handling.h"
+#include <algorithm>
 namespace Hermes
 {
 #ifdef WITH_PJLIB
   HERMES_COMMON_API pj_caching_pool HermesCommonMemoryPoolCache;
   HERMES_COMMON_API GlobalPoolCache hermesCommonGlobalPoolCache;
 #endif
-}
\ No newline at end of file
+
+  MemoryArena::MemoryArena(size_t block_size) : block_size(block_size), current_block(0), current_offset(0), used_size(0)
+  {
+  }
+
+  MemoryArena::~MemoryArena()
+  {
+    for (unsigned int i = 0; i < this->blocks.size(); i++)
+      ::free(this->blocks[i]);
+  }
+
+  void* MemoryArena::allocate(size_t size)
+  {
+    // Keep everything 16-byte aligned (doubles, complex numbers).
+    size = (size + 15) & ~((size_t)15);
+
+    // Move on to the next block that is large enough.
+    while (this->current_block < this->blocks.size() && this->current_offset + size > this->block_sizes[this->current_block])
+    {
+      this->current_block++;
+      this->current_offset = 0;
+    }
+
+    // None left - grow.
+    if (this->current_block == this->blocks.size())
+    {
+      size_t new_block_size = std::max(this->block_size, size);
+      char* new_block = (char*)malloc(new_block_size);
+      if (!new_block)
+        throw Hermes::Exceptions::Exception("Hermes::MemoryArena failed to allocate %i bytes.", (int)new_block_size);
+      this->blocks.push_back(new_block);
+      this->block_sizes.push_back(new_block_size);
+      this->current_offset = 0;
+    }
+
+    void* result = this->blocks[this->current_block] + this->current_offset;
+    this->current_offset += size;
+    this->used_size += size;
+    return result;
+  }
+
+  void MemoryArena::reset()
+  {
+    this->current_block = 0;
+    this->current_offset = 0;
+    this->used_size = 0;
+  }
+
+  size_t MemoryArena::get_used_size() const
+  {
+    return this->used_size;
+  }
+
+  size_t MemoryArena::get_capacity() const
+  {
+    size_t capacity = 0;
+    for (unsigned int i = 0; i < this->block_sizes.size(); i++)
+      capacity += this->block_sizes[i];
+    return capacity;
+  }
+
+  namespace
+  {
+    /// Size classes - 16-byte steps up to 256 bytes, then four per doubling up to 256 kB.
+    const unsigned short pool_small_class_count = 16;
+    const size_t pool_small_limit = 256;
+    const unsigned short pool_class_count = pool_small_class_count + 4 * 10;
+    const size_t pool_max_size = 256 * 1024;
+    const size_t pool_chunk_size = 64 * 1024;
+    /// Marks blocks taken directly from the heap.
+    const size_t pool_heap_class = pool_class_count;
+
+    /// Precedes every block, keeps the blocks 16-byte aligned.
+    struct PoolBlockHeader
+    {
+      size_t size_class;
+      size_t size;
+    };
+
+    struct PoolFreeBlock
+    {
+      PoolFreeBlock* next;
+    };
+
+    struct PoolThreadCache
+    {
+      PoolFreeBlock* free_blocks[pool_class_count];
+      unsigned long long allocations[pool_class_count];
+      unsigned long long deallocations[pool_class_count];
+      unsigned long long chunks[pool_class_count];
+      unsigned long long heap_allocations, heap_deallocations;
+      PoolThreadCache* next;
+    };
+
+    HERMES_THREAD_LOCAL PoolThreadCache* pool_thread_cache = nullptr;
+    /// All thread caches (for statistics).
+    PoolThreadCache* pool_thread_caches = nullptr;
+    bool pool_pooling = true;
+
+    unsigned short pool_size_class(size_t size)
+    {
+      if (size <= pool_small_limit)
+        return (unsigned short)((size + 15) / 16 - 1);
+      size_t base = pool_small_limit;
+      unsigned short doubling = 0;
+      while (base * 2 < size)
+      {
+        base *= 2;
+        doubling++;
+      }
+      return (unsigned short)(pool_small_class_count + 4 * doubling + (size - 1 - base) / (base / 4));
+    }
+
+    size_t pool_class_size(unsigned short size_class)
+    {
+      if (size_class < pool_small_class_count)
+        return 16 * (size_class + 1);
+      size_t base = pool_small_limit << ((size_class - pool_small_class_count) / 4);
+      return base + ((size_class - pool_small_class_count) % 4 + 1) * (base / 4);
+    }
+
+    PoolThreadCache* pool_get_thread_cache()
+    {
+      if (!pool_thread_cache)
+      {
+        PoolThreadCache* cache = (PoolThreadCache*)calloc(1, sizeof(PoolThreadCache));
+        if (!cache)
+          throw Hermes::Exceptions::Exception("Hermes::PoolAllocator failed to allocate a thread cache.");
+#pragma omp critical (pool_allocator_thread_caches)
+        {
+          cache->next = pool_thread_caches;
+          pool_thread_caches = cache;
+        }
+        pool_thread_cache = cache;
+      }
+      return pool_thread_cache;
+    }
+
+    void pool_refill(PoolThreadCache* cache, unsigned short size_class)
+    {
+      size_t block_size = pool_class_size(size_class);
+      size_t block_count = std::max<size_t>(1, pool_chunk_size / block_size);
+      char* chunk = (char*)malloc(block_count * block_size);
+      if (!chunk)
+        return;
+      for (size_t i = 0; i < block_count; i++)
+      {
+        PoolFreeBlock* block = (PoolFreeBlock*)(chunk + i * block_size);
+        block->next = cache->free_blocks[size_class];
+        cache->free_blocks[size_class] = block;
+      }
+      cache->chunks[size_class]++;
+    }
+  }
+
+  void* PoolAllocator::allocate(size_t size)
+  {
+    PoolThreadCache* cache = pool_get_thread_cache();
+    size_t total_size = size + sizeof(PoolBlockHeader);
+
+    PoolBlockHeader* header;
+    if (!pool_pooling || total_size > pool_max_size)
+    {
+      header = (PoolBlockHeader*)malloc(total_size);
+      if (!header)
+        return nullptr;
+      header->size_class = pool_heap_class;
+      cache->heap_allocations++;
+    }
+    else
+    {
+      unsigned short size_class = pool_size_class(total_size);
+      if (!cache->free_blocks[size_class])
+      {
+        pool_refill(cache, size_class);
+        if (!cache->free_blocks[size_class])
+          return nullptr;
+      }
+      PoolFreeBlock* block = cache->free_blocks[size_class];
+      cache->free_blocks[size_class] = block->next;
+      header = (PoolBlockHeader*)block;
+      header->size_class = size_class;
+      cache->allocations[size_class]++;
+    }
+    header->size = size;
+
+    return header + 1;
+  }
+
+  void* PoolAllocator::callocate(size_t size)
+  {
+    void* ptr = allocate(size);
+    if (ptr)
+      memset(ptr, 0, size);
+    return ptr;
+  }
+
+  void PoolAllocator::deallocate(void* ptr)
+  {
+    if (!ptr)
+      return;
+
+    PoolThreadCache* cache = pool_get_thread_cache();
+    PoolBlockHeader* header = ((PoolBlockHeader*)ptr) - 1;
+    if (header->size_class == pool_heap_class)
+    {
+      cache->heap_deallocations++;
+      ::free(header);
+    }
+    else
+    {
+      unsigned short size_class = (unsigned short)header->size_class;
+      PoolFreeBlock* block = (PoolFreeBlock*)header;
+      block->next = cache->free_blocks[size_class];
+      cache->free_blocks[size_class] = block;
+      cache->deallocations[size_class]++;
+    }
+  }
+
+  void PoolAllocator::set_pooling(bool to_set)
+  {
+    pool_pooling = to_set;
+  }
+
+  PoolAllocator::Statistics::Statistics() : allocations(0), deallocations(0), heap_allocations(0), heap_deallocations(0), chunks(0), chunk_bytes(0), blocks_in_use(0), thread_caches(0)
+  {
+  }
+
+  PoolAllocator::Statistics PoolAllocator::get_statistics()
+  {
+    Statistics statistics;
+#pragma omp critical (pool_allocator_thread_caches)
+    {
+      for (PoolThreadCache* cache = pool_thread_caches; cache; cache = cache->next)
+      {
+        statistics.thread_caches++;
+        statistics.heap_allocations += cache->heap_allocations;
+        statistics.heap_deallocations += cache->heap_deallocations;
+        for (unsigned short size_class = 0; size_class < pool_class_count; size_class++)
+        {
+          statistics.allocations += cache->allocations[size_class];
+          statistics.deallocations += cache->deallocations[size_class];
+          statistics.chunks += cache->chunks[size_class];
+          statistics.chunk_bytes += cache->chunks[size_class] * std::max<size_t>(1, pool_chunk_size / pool_class_size(size_class)) * pool_class_size(size_class);
+          statistics.blocks_in_use += (long long)cache->allocations[size_class] - (long long)cache->deallocations[size_class];
+        }
+      }
+    }
+    statistics.allocations += statistics.heap_allocations;
+    statistics.deallocations += statistics.heap_deallocations;
+    return statistics;
+  }
+
+  void PoolAllocator::dump_statistics(FILE* out)
+  {
+    Statistics statistics = get_statistics();
+    fprintf(out, "PoolAllocator: %u thread caches, %llu allocations, %llu deallocations (heap: %llu / %llu), %llu chunks (%llu bytes), %lld blocks in use.\n",
+      statistics.thread_caches, statistics.allocations, statistics.deallocations, statistics.heap_allocations, statistics.heap_deallocations,
+      statistics.chunks, statistics.chunk_bytes, statistics.blocks_in_use);
+
+#pragma omp critical (pool_allocator_thread_caches)
+    {
+      for (unsigned short size_class = 0; size_class < pool_class_count; size_class++)
+      {
+        unsigned long long allocations = 0, deallocations = 0, chunks = 0;
+        for (PoolThreadCache* cache = pool_thread_caches; cache; cache = cache->next)
+        {
+          allocations += cache->allocations[size_class];
+          deallocations += cache->deallocations[size_class];
+          chunks += cache->chunks[size_class];
+        }
+        if (allocations > 0)
+          fprintf(out, "\tclass %6u bytes: %llu allocations, %llu deallocations, %llu chunks.\n", (unsigned int)pool_class_size(size_class), allocations, deallocations, chunks);
+      }
+    }
+  }
+}
@@ -0,0 +1,120 @@
+// This file is part of HermesCommon
+//
+// Copyright (c) 2009 hp-FEM group at the University of Nevada, Reno (UNR).
+// Email: hpfem-group@unr.edu, home page: http://www.hpfem.org/.
+//
+// Hermes2D is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation; either version 2 of the License,
+// or (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+/*! \file mpi_communication.cpp
+\brief MPI environment of the distributed assembling and solving.
+*/
+#include "mpi_communication.h"
+#include "config.h"
+#include <complex>
+
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+
+namespace Hermes
+{
+#ifdef WITH_MPI
+  namespace
+  {
+    bool mpi_running()
+    {
+      int initialized, finalized;
+      MPI_Initialized(&initialized);
+      MPI_Finalized(&finalized);
+      return initialized && !finalized;
+    }
+  }
+#endif
+
+  int MpiCommunication::get_rank()
+  {
+#ifdef WITH_MPI
+    if (mpi_running())
+    {
+      int rank;
+      MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+      return rank;
+    }
+#endif
+    return 0;
+  }
+
+  int MpiCommunication::get_size()
+  {
+#ifdef WITH_MPI
+    if (mpi_running())
+    {
+      int size;
+      MPI_Comm_size(MPI_COMM_WORLD, &size);
+      return size;
+    }
+#endif
+    return 1;
+  }
+
+  bool MpiCommunication::is_distributed()
+  {
+    return get_size() > 1;
+  }
+
+  bool MpiCommunication::supports_concurrent_calls()
+  {
+#ifdef WITH_MPI
+    if (mpi_running())
+    {
+      int provided;
+      MPI_Query_thread(&provided);
+      return provided == MPI_THREAD_MULTIPLE;
+    }
+#endif
+    return true;
+  }
+
+  // Both instantiations are arrays of doubles for MPI (std::complex<double> is two doubles).
+  template<typename Scalar>
+  void MpiCommunication::sum(Scalar* values, int count)
+  {
+#ifdef WITH_MPI
+    if (is_distributed())
+      MPI_Allreduce(MPI_IN_PLACE, values, count * (int)(sizeof(Scalar) / sizeof(double)), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+#endif
+  }
+
+  template<typename Scalar>
+  void MpiCommunication::broadcast(Scalar* values, int count, int root)
+  {
+#ifdef WITH_MPI
+    if (is_distributed())
+      MPI_Bcast(values, count * (int)(sizeof(Scalar) / sizeof(double)), MPI_DOUBLE, root, MPI_COMM_WORLD);
+#endif
+  }
+
+  void MpiCommunication::barrier()
+  {
+#ifdef WITH_MPI
+    if (is_distributed())
+      MPI_Barrier(MPI_COMM_WORLD);
+#endif
+  }
+
+  template HERMES_COMMON_API void MpiCommunication::sum<double>(double* values, int count);
+  template HERMES_COMMON_API void MpiCommunication::sum<std::complex<double> >(std::complex<double>* values, int count);
+  template HERMES_COMMON_API void MpiCommunication::broadcast<double>(double* values, int count, int root);
+  template HERMES_COMMON_API void MpiCommunication::broadcast<std::complex<double> >(std::complex<double>* values, int count, int root);
+}
@@ -0,0 +1,467 @@
+// This file is part of HermesCommon
+//
+// Copyright (c) 2009 hp-FEM group at the University of Nevada, Reno (UNR).
+// Email: hpfem-group@unr.edu, home page: http://www.hpfem.org/.
+//
+// Hermes2D is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published
+// by the Free Software Foundation; either version 2 of the License,
+// or (at your option) any later version.
+//
+// Hermes2D is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Hermes2D; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+/*! \file profiler.cpp
+\brief Hierarchical phase profiler.
+*/
+#include "profiler.h"
+#include "hardware_counters.h"
+#include "common.h"
+#include "exceptions.h"
+#include <chrono>
+
+namespace Hermes
+{
+  namespace
+  {
+    typedef std::chrono::steady_clock ProfilerClock;
+
+    /// Node of the region tree of a thread.
+    struct ProfilerNode
+    {
+      ProfilerNode(const char* name, int parent) : name(name), parent(parent), calls(0), inclusive(0), children_time(0), work(0)
+      {
+        memset(counters, 0, sizeof(counters));
+      }
+
+      const char* name;
+      int parent;
+      unsigned long long calls;
+      /// Nanoseconds.
+      long long inclusive, children_time;
+      /// Inclusive hardware counter values.
+      long long counters[HardwareCounterCount];
+      /// Work added directly in this region (not in the children).
+      double work;
+      std::vector<int> children;
+    };
+
+    /// Open region.
+    struct ProfilerOpenRegion
+    {
+      int node;
+      long long start;
+      /// Hardware counter values at the start, if read.
+      bool counted;
+      long long counters[HardwareCounterCount];
+    };
+
+    struct ProfilerEvent
+    {
+      const char* name;
+      /// Nanoseconds since the profiler epoch.
+      long long start, duration;
+    };
+
+    struct ProfilerThreadData
+    {
+      unsigned int thread_index;
+      /// nodes[0] is the root.
+      std::vector<ProfilerNode> nodes;
+      /// Open regions.
+      std::vector<ProfilerOpenRegion> stack;
+      std::vector<ProfilerEvent> events;
+      unsigned long long dropped_events;
+      /// Hardware counters of the thread, opened on demand.
+      HardwareCounters* counters;
+    };
+
+    HERMES_THREAD_LOCAL ProfilerThreadData* profiler_thread_data = nullptr;
+    std::vector<ProfilerThreadData*> profiler_threads;
+    bool profiler_enabled = false;
+    bool profiler_tracing = true;
+    bool profiler_hardware_counters = false;
+    unsigned int profiler_max_events = 1000000;
+    const ProfilerClock::time_point profiler_epoch = ProfilerClock::now();
+
+    long long profiler_now()
+    {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(ProfilerClock::now() - profiler_epoch).count();
+    }
+
+    ProfilerThreadData* profiler_get_thread_data()
+    {
+      if (!profiler_thread_data)
+      {
+        ProfilerThreadData* data = new ProfilerThreadData;
+        data->nodes.push_back(ProfilerNode("", -1));
+        data->dropped_events = 0;
+        data->counters = nullptr;
+#pragma omp critical (profiler_threads)
+        {
+          data->thread_index = profiler_threads.size();
+          profiler_threads.push_back(data);
+        }
+        profiler_thread_data = data;
+      }
+      return profiler_thread_data;
+    }
+
+    int profiler_find_child(const std::vector<ProfilerNode>& nodes, int parent, const char* name)
+    {
+      const std::vector<int>& children = nodes[parent].children;
+      for (unsigned int i = 0; i < children.size(); i++)
+      {
+        // The same literal may have different addresses in different translation units.
+        if (nodes[children[i]].name == name || !strcmp(nodes[children[i]].name, name))
+          return children[i];
+      }
+      return -1;
+    }
+
+    /// Merges the subtree of source_node into the subtree of target_node.
+    void profiler_merge(std::vector<ProfilerNode>& target, int target_node, const std::vector<ProfilerNode>& source, int source_node)
+    {
+      for (unsigned int i = 0; i < source[source_node].children.size(); i++)
+      {
+        const ProfilerNode& source_child = source[source[source_node].children[i]];
+        int target_child = profiler_find_child(target, target_node, source_child.name);
+        if (target_child == -1)
+        {
+          target_child = target.size();
+          target.push_back(ProfilerNode(source_child.name, target_node));
+          target[target_node].children.push_back(target_child);
+        }
+        target[target_child].calls += source_child.calls;
+        target[target_child].inclusive += source_child.inclusive;
+        target[target_child].children_time += source_child.children_time;
+        for (int counter_i = 0; counter_i < HardwareCounterCount; counter_i++)
+          target[target_child].counters[counter_i] += source_child.counters[counter_i];
+        target[target_child].work += source_child.work;
+        profiler_merge(target, target_child, source, source[source_node].children[i]);
+      }
+    }
+
+    void profiler_print(std::stringstream& summary, const std::vector<ProfilerNode>& nodes, int node, unsigned int depth)
+    {
+      char line[256];
+      for (unsigned int i = 0; i < nodes[node].children.size(); i++)
+      {
+        const ProfilerNode& child = nodes[nodes[node].children[i]];
+        std::string name = std::string(2 * depth, ' ') + child.name;
+        double parent_time = (node == 0) ? 0. : (double)nodes[node].inclusive;
+        if (parent_time > 0.)
+          sprintf(line, "%-56s %10llu %14.6f %14.6f %8.1f\n", name.c_str(), child.calls, child.inclusive * 1e-9, (child.inclusive - child.children_time) * 1e-9, 100. * child.inclusive / parent_time);
+        else
+          sprintf(line, "%-56s %10llu %14.6f %14.6f %8s\n", name.c_str(), child.calls, child.inclusive * 1e-9, (child.inclusive - child.children_time) * 1e-9, "-");
+        summary << line;
+        profiler_print(summary, nodes, nodes[node].children[i], depth + 1);
+      }
+    }
+
+    /// Sums the calls & the inclusive times of the outermost nodes called name in the subtree of node.
+    void profiler_sum(const std::vector<ProfilerNode>& nodes, int node, const char* name, unsigned long long& calls, long long& inclusive)
+    {
+      for (unsigned int i = 0; i < nodes[node].children.size(); i++)
+      {
+        const ProfilerNode& child = nodes[nodes[node].children[i]];
+        if (child.name == name || !strcmp(child.name, name))
+        {
+          calls += child.calls;
+          inclusive += child.inclusive;
+          // Nested calls of the same region still count as calls.
+          unsigned long long nested_calls = 0;
+          long long nested_inclusive = 0;
+          profiler_sum(nodes, nodes[node].children[i], name, nested_calls, nested_inclusive);
+          calls += nested_calls;
+        }
+        else
+          profiler_sum(nodes, nodes[node].children[i], name, calls, inclusive);
+      }
+    }
+
+    /// Work of the subtree of node.
+    double profiler_inclusive_work(const std::vector<ProfilerNode>& nodes, int node)
+    {
+      double work = nodes[node].work;
+      for (unsigned int i = 0; i < nodes[node].children.size(); i++)
+        work += profiler_inclusive_work(nodes, nodes[node].children[i]);
+      return work;
+    }
+
+    /// Formats numerator / denominator * multiplier, "-" if the denominator is zero.
+    std::string profiler_ratio(double numerator, double denominator, double multiplier)
+    {
+      if (denominator <= 0.)
+        return "-";
+      char ratio[32];
+      sprintf(ratio, "%.3f", multiplier * numerator / denominator);
+      return ratio;
+    }
+
+    void profiler_print_counters(std::stringstream& summary, const std::vector<ProfilerNode>& nodes, int node, unsigned int depth, double flops_per_work_unit)
+    {
+      char line[512];
+      for (unsigned int i = 0; i < nodes[node].children.size(); i++)
+      {
+        const ProfilerNode& child = nodes[nodes[node].children[i]];
+        const long long* c = child.counters;
+        std::string name = std::string(2 * depth, ' ') + child.name;
+        double work = profiler_inclusive_work(nodes, nodes[node].children[i]);
+        sprintf(line, "%-56s %10llu %8s %10s %10s %10s %14.4g %12.4g %10s\n", name.c_str(), child.calls,
+          profiler_ratio(c[HardwareCounterInstructions], c[HardwareCounterCycles], 1.).c_str(),
+          profiler_ratio(c[HardwareCounterL1DMisses], c[HardwareCounterL1DAccesses], 100.).c_str(),
+          profiler_ratio(c[HardwareCounterLLCMisses], c[HardwareCounterLLCAccesses], 100.).c_str(),
+          profiler_ratio(c[HardwareCounterBranchMisses], c[HardwareCounterBranches], 100.).c_str(),
+          work, work * flops_per_work_unit * 1e-9,
+          profiler_ratio(work * flops_per_work_unit, c[HardwareCounterCycles], 1.).c_str());
+        summary << line;
+        profiler_print_counters(summary, nodes, nodes[node].children[i], depth + 1, flops_per_work_unit);
+      }
+    }
+
+    void profiler_write_escaped(FILE* file, const char* name)
+    {
+      for (const char* c = name; *c; c++)
+      {
+        if (*c == '"' || *c == '\\')
+          fputc('\\', file);
+        fputc(*c, file);
+      }
+    }
+  }
+
+  void Profiler::set_enabled(bool to_set)
+  {
+    profiler_enabled = to_set;
+  }
+
+  bool Profiler::is_enabled()
+  {
+    return profiler_enabled;
+  }
+
+  void Profiler::set_tracing(bool to_set, unsigned int max_events_per_thread)
+  {
+    profiler_tracing = to_set;
+    profiler_max_events = max_events_per_thread;
+  }
+
+  void Profiler::reset()
+  {
+    // The trees are kept (regions may be open), only the counters are reset.
+    for (unsigned int i = 0; i < profiler_threads.size(); i++)
+    {
+      ProfilerThreadData* data = profiler_threads[i];
+      for (unsigned int j = 0; j < data->nodes.size(); j++)
+      {
+        data->nodes[j].calls = 0;
+        data->nodes[j].inclusive = data->nodes[j].children_time = 0;
+        memset(data->nodes[j].counters, 0, sizeof(data->nodes[j].counters));
+        data->nodes[j].work = 0;
+      }
+      data->events.clear();
+      data->dropped_events = 0;
+    }
+  }
+
+  void Profiler::begin(const char* name)
+  {
+    ProfilerThreadData* data = profiler_get_thread_data();
+    int parent = data->stack.empty() ? 0 : data->stack.back().node;
+
+    int node = profiler_find_child(data->nodes, parent, name);
+    if (node == -1)
+    {
+      node = data->nodes.size();
+      data->nodes.push_back(ProfilerNode(name, parent));
+      data->nodes[parent].children.push_back(node);
+    }
+
+    ProfilerOpenRegion open_region;
+    open_region.node = node;
+    open_region.counted = false;
+    if (profiler_hardware_counters)
+    {
+      if (!data->counters)
+        data->counters = new HardwareCounters;
+      if (data->counters->is_available())
+      {
+        data->counters->read(open_region.counters);
+        open_region.counted = true;
+      }
+    }
+    open_region.start = profiler_now();
+    data->stack.push_back(open_region);
+  }
+
+  void Profiler::end()
+  {
+    long long now = profiler_now();
+    ProfilerThreadData* data = profiler_get_thread_data();
+    if (data->stack.empty())
+      return;
+
+    const ProfilerOpenRegion& open_region = data->stack.back();
+    int node = open_region.node;
+    long long start = open_region.start;
+
+    ProfilerNode& profiler_node = data->nodes[node];
+    if (open_region.counted)
+    {
+      long long counters[HardwareCounterCount];
+      data->counters->read(counters);
+      for (int counter_i = 0; counter_i < HardwareCounterCount; counter_i++)
+        profiler_node.counters[counter_i] += counters[counter_i] - open_region.counters[counter_i];
+    }
+    data->stack.pop_back();
+
+    profiler_node.calls++;
+    profiler_node.inclusive += now - start;
+    data->nodes[profiler_node.parent].children_time += now - start;
+
+    if (profiler_tracing)
+    {
+      if (data->events.size() < profiler_max_events)
+      {
+        ProfilerEvent event = { profiler_node.name, start, now - start };
+        data->events.push_back(event);
+      }
+      else
+        data->dropped_events++;
+    }
+  }
+
+  void Profiler::export_chrome_trace(const char* filename)
+  {
+    FILE* file = fopen(filename, "w");
+    if (!file)
+      throw Exceptions::IOException(Exceptions::IOException::Write, filename);
+
+    fprintf(file, "{\"traceEvents\":[\n");
+    bool first = true;
+    for (unsigned int i = 0; i < profiler_threads.size(); i++)
+    {
+      ProfilerThreadData* data = profiler_threads[i];
+      fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}", first ? "" : ",\n", data->thread_index, data->thread_index);
+      first = false;
+      for (unsigned int j = 0; j < data->events.size(); j++)
+      {
+        const ProfilerEvent& event = data->events[j];
+        fprintf(file, ",\n{\"name\":\"");
+        profiler_write_escaped(file, event.name);
+        fprintf(file, "\",\"cat\":\"hermes\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u}", event.start * 1e-3, event.duration * 1e-3, data->thread_index);
+      }
+    }
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(file);
+  }
+
+  std::string Profiler::get_summary()
+  {
+    std::stringstream summary;
+    char line[256];
+    sprintf(line, "%-56s %10s %14s %14s %8s\n", "Region", "calls", "total [s]", "self [s]", "% parent");
+
+    if (profiler_threads.size() > 1)
+    {
+      std::vector<ProfilerNode> merged;
+      merged.push_back(ProfilerNode("", -1));
+      for (unsigned int i = 0; i < profiler_threads.size(); i++)
+        profiler_merge(merged, 0, profiler_threads[i]->nodes, 0);
+
+      summary << "Profiler summary - all threads:\n" << line;
+      profiler_print(summary, merged, 0, 0);
+    }
+
+    for (unsigned int i = 0; i < profiler_threads.size(); i++)
+    {
+      ProfilerThreadData* data = profiler_threads[i];
+      summary << "Profiler summary - thread " << data->thread_index << ":\n" << line;
+      profiler_print(summary, data->nodes, 0, 0);
+      if (data->dropped_events > 0)
+        summary << "(" << data->dropped_events << " trace events over the limit not recorded)\n";
+    }
+
+    return summary.str();
+  }
+
+  double Profiler::get_total_time(const char* name)
+  {
+    unsigned long long calls = 0;
+    long long inclusive = 0;
+    for (unsigned int i = 0; i < profiler_threads.size(); i++)
+      profiler_sum(profiler_threads[i]->nodes, 0, name, calls, inclusive);
+    return inclusive * 1e-9;
+  }
+
+  unsigned long long Profiler::get_total_calls(const char* name)
+  {
+    unsigned long long calls = 0;
+    long long inclusive = 0;
+    for (unsigned int i = 0; i < profiler_threads.size(); i++)
+      profiler_sum(profiler_threads[i]->nodes, 0, name, calls, inclusive);
+    return calls;
+  }
+
+  void Profiler::set_hardware_counters(bool to_set)
+  {
+    profiler_hardware_counters = to_set;
+  }
+
+  bool Profiler::get_hardware_counters()
+  {
+    return profiler_hardware_counters;
+  }
+
+  std::string Profiler::get_hardware_counters_error()
+  {
+    ProfilerThreadData* data = profiler_get_thread_data();
+    if (!data->counters)
+      data->counters = new HardwareCounters;
+    return data->counters->get_error();
+  }
+
+  void Profiler::add_work(double operations)
+  {
+    ProfilerThreadData* data = profiler_get_thread_data();
+    int node = data->stack.empty() ? 0 : data->stack.back().node;
+    data->nodes[node].work += operations;
+  }
+
+  std::string Profiler::get_hardware_counter_summary(double flops_per_work_unit)
+  {
+    std::stringstream summary;
+    char line[512];
+    sprintf(line, "%-56s %10s %8s %10s %10s %10s %14s %12s %10s\n", "Region", "calls", "IPC", "L1D miss%", "LLC miss%", "br. miss%", "work", "est. GFLOP", "FLOP/cycle");
+
+    std::string error = get_hardware_counters_error();
+    if (!error.empty())
+      summary << "Hardware counters (partially) not available: " << error << "\n";
+
+    if (profiler_threads.size() > 1)
+    {
+      std::vector<ProfilerNode> merged;
+      merged.push_back(ProfilerNode("", -1));
+      for (unsigned int i = 0; i < profiler_threads.size(); i++)
+        profiler_merge(merged, 0, profiler_threads[i]->nodes, 0);
+
+      summary << "Hardware counters - all threads:\n" << line;
+      profiler_print_counters(summary, merged, 0, 0, flops_per_work_unit);
+    }
+
+    for (unsigned int i = 0; i < profiler_threads.size(); i++)
+    {
+      ProfilerThreadData* data = profiler_threads[i];
+      summary << "Hardware counters - thread " << data->thread_index << ":\n" << line;
+      profiler_print_counters(summary, data->nodes, 0, 0, flops_per_work_unit);
+    }
+
+    return summary.str();
+  }
+}